@@ -0,0 +1,989 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+
+#include "SFML/System.hpp"
+#include "SFML/Graphics.hpp"
+#include "SFML/Graphics/ImageLoader.hpp"
+#include "SFML/Graphics/RenderPipeline.hpp"
+#include "SFML/glad.h"
+
+
+//
+//  usage: SFML_GRAPHICS_BENCH [--headless] [--json out.json] [--label name] [font.ttf] [samples]
+//
+//  every benchmark runs its body a fixed number of times per sample, the
+//  reported numbers are the median and the 99th percentile of the samples,
+//  in microseconds per iteration. Font and text benchmarks are skipped when
+//  no font is given on the command line (all loadFromFile are erased).
+//
+//  --headless renders the GL benchmarks into a sf::RenderTexture instead of
+//  the default framebuffer, the window is never shown nor swapped, so that
+//  no display pacing ends up in the numbers (CI GPUs, servers).
+//
+//  the texture upload benchmarks report the time of each upload, with and
+//  without waiting for the GPU, and the resulting MB/s per strategy and size.
+//
+//  --json also writes every result, with the OpenGL calls counted per iteration,
+//  to a JSON file that can be compared between commits. --label names the run
+//  in that file (commit, browser, device...).
+//
+//  the emscripten build (build/emscripten, make SFML_GRAPHICS_BENCH) always runs
+//  headless, bench/shell.html passes the arguments from the query string of the
+//  page and shows the JSON when the run is over, see that file.
+//
+
+
+static int g_Samples = 200;
+
+
+//
+//  every result also lands here, for --json
+//
+struct Result
+{
+    std::string group;
+    std::string name;
+    std::vector<std::pair<const char*, double> > values;
+};
+
+static std::vector<Result> g_Results;
+static std::string         g_Group;
+
+
+void Section(const char* group, const char* details = "")
+{
+    g_Group = group;
+    printf("\n-- %s%s --\n", group, details);
+}
+
+
+Result& Record(const char* name)
+{
+    g_Results.push_back(Result());
+    g_Results.back().group = g_Group;
+    g_Results.back().name  = name;
+    return g_Results.back();
+}
+
+
+template<typename Func>
+void Bench(const char* name, int iterations, Func func)
+{
+    std::vector<double> samples;
+    samples.reserve(g_Samples);
+
+    func(); // warm up caches and lazy allocations
+
+    sf::priv::getRenderStats() = sf::RenderStats();
+
+    sf::Clock clock;
+    for (int i = 0; i < g_Samples; ++i)
+    {
+        clock.restart();
+        for (int j = 0; j < iterations; ++j)
+            func();
+
+        samples.push_back(static_cast<double>(clock.getElapsedTime().asMicroseconds()) / iterations);
+    };
+
+    std::sort(samples.begin(), samples.end());
+
+    double median = samples[samples.size() / 2];
+    double p99    = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+
+    printf("%-40s median %10.3f us   p99 %10.3f us\n", name, median, p99);
+
+    // OpenGL work per iteration, what batching and the state cache are supposed to cut down
+    const sf::RenderStats& stats = sf::priv::getRenderStats();
+    const double calls = static_cast<double>(g_Samples) * iterations;
+
+    Result& result = Record(name);
+    result.values.push_back(std::make_pair("median_us", median));
+    result.values.push_back(std::make_pair("p99_us", p99));
+    result.values.push_back(std::make_pair("draw_calls", stats.drawCalls / calls));
+    result.values.push_back(std::make_pair("texture_binds", stats.textureBinds / calls));
+    result.values.push_back(std::make_pair("program_switches", stats.programSwitches / calls));
+    result.values.push_back(std::make_pair("blend_changes", stats.blendChanges / calls));
+    result.values.push_back(std::make_pair("bytes_uploaded", stats.bytesUploaded / calls));
+}
+
+
+//
+//  uncompressed 32 bits TGA, so that the decode benchmark doesn't need any asset
+//
+std::vector<sf::Uint8> GenTga(const sf::Image& image)
+{
+    const sf::Vector2u size = image.getSize();
+    const sf::Uint8* pixels = image.getPixelsPtr();
+
+    std::vector<sf::Uint8> tga(18 + size.x * size.y * 4, 0);
+    tga[2]  = 2; // uncompressed true color
+    tga[12] = static_cast<sf::Uint8>(size.x & 0xFF);
+    tga[13] = static_cast<sf::Uint8>(size.x >> 8);
+    tga[14] = static_cast<sf::Uint8>(size.y & 0xFF);
+    tga[15] = static_cast<sf::Uint8>(size.y >> 8);
+    tga[16] = 32;
+    tga[17] = 0x28; // top-left origin, 8 bits alpha
+
+    for (std::size_t i = 0; i < size.x * size.y; ++i)
+    {
+        tga[18 + i * 4 + 0] = pixels[i * 4 + 2];
+        tga[18 + i * 4 + 1] = pixels[i * 4 + 1];
+        tga[18 + i * 4 + 2] = pixels[i * 4 + 0];
+        tga[18 + i * 4 + 3] = pixels[i * 4 + 3];
+    };
+
+    return tga;
+}
+
+
+sf::Image GenImageNoise(unsigned int width, unsigned int height)
+{
+    std::vector<sf::Uint8> pixels(width * height * 4);
+    sf::Uint32 seed = 0x12345678;
+    for (std::size_t i = 0; i < pixels.size(); ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        pixels[i] = static_cast<sf::Uint8>(seed >> 24);
+    };
+
+    sf::Image image;
+    image.create(width, height, &pixels[0]);
+    return image;
+}
+
+
+std::string GenLongString(std::size_t length)
+{
+    static const char words[] = "The quick brown fox jumps over the lazy dog\n";
+
+    std::string str;
+    str.reserve(length);
+    while (str.size() < length)
+        str += words;
+    str.resize(length);
+    return str;
+}
+
+
+void BenchCpu(sf::Font* font)
+{
+    Section("CPU");
+
+    //
+    //  transform
+    //
+    {
+        sf::Transform a;
+        a.translate(10.0f, 20.0f).rotate(30.0f).scale(2.0f, 0.5f);
+        sf::Transform b = a.getInverse();
+        sf::Transform acc;
+        Bench("Transform::combine", 10000, [&]() { acc.combine(a).combine(b); });
+
+        sf::FloatRect rect(1.0f, 2.0f, 30.0f, 40.0f);
+        float sink = 0.0f;
+        Bench("Transform::transformRect", 10000, [&]() { sink += a.transformRect(rect).width; });
+        if (sink < 0.0f)
+            printf("%f\n", sink);
+    }
+
+    //
+    //  shape geometry
+    //
+    {
+        const std::size_t count = 10000;
+        sf::ConvexShape convex(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float angle = 6.2831853f * i / count;
+            convex.setPoint(i, sf::Vector2f(std::cos(angle) * 100.0f, std::sin(angle) * 100.0f));
+        };
+        convex.setOutlineThickness(2.0f);
+
+        float radius = 100.0f;
+        Bench("Shape::update (10000 points convex)", 1, [&]()
+        {
+            radius = (radius == 100.0f) ? 101.0f : 100.0f;
+            convex.setPoint(0, sf::Vector2f(radius, 0.0f)); // setPoint calls update
+        });
+    }
+
+    {
+        const std::size_t shapeCount = 200;
+        const std::size_t pointCount = 2000;
+        std::vector<sf::Vector2f> points(pointCount);
+        for (std::size_t i = 0; i < pointCount; ++i)
+        {
+            float angle = 6.2831853f * i / pointCount;
+            points[i] = sf::Vector2f(std::cos(angle) * 100.0f, std::sin(angle) * 100.0f);
+        };
+
+        std::vector<sf::ConvexShape> convexes(shapeCount);
+        std::vector<sf::Shape*> shapes(shapeCount);
+        for (std::size_t i = 0; i < shapeCount; ++i)
+        {
+            convexes[i].setOutlineThickness(2.0f);
+            convexes[i].setPoints(&points[0], pointCount, false);
+            shapes[i] = &convexes[i];
+        }
+
+        Bench("Shape::update (200 shapes of 2000 points)", 1, [&]()
+        {
+            for (std::size_t i = 0; i < shapeCount; ++i)
+                convexes[i].setPoints(&points[0], pointCount);
+        });
+        Bench("Shape::updateMany (200 shapes of 2000 points)", 1, [&]()
+        {
+            sf::Shape::updateMany(&shapes[0], shapeCount);
+        });
+    }
+
+    //
+    //  image
+    //
+    {
+        sf::Image dst = GenImageNoise(1024, 1024);
+        sf::Image src = GenImageNoise(256, 256);
+
+        Bench("Image::copy (256x256)", 10, [&]() { dst.copy(src, 100, 100); });
+        Bench("Image::copy (256x256, alpha)", 10, [&]() { dst.copy(src, 100, 100, sf::IntRect(0, 0, 0, 0), true); });
+        Bench("Image::flipVertically (1024x1024)", 1, [&]() { dst.flipVertically(); });
+        Bench("Image::createMaskFromColor (1024x1024)", 1, [&]() { dst.createMaskFromColor(sf::Color::Black); });
+
+        std::vector<sf::Uint8> tga = GenTga(src);
+        std::vector<sf::Uint8> pixels;
+        sf::Vector2u size;
+        Bench("ImageLoader decode (256x256 tga)", 1, [&]()
+        {
+            sf::priv::ImageLoader::getInstance().loadImageFromMemory(&tga[0], tga.size(), pixels, size);
+        });
+    }
+
+    //
+    //  strings
+    //
+    {
+        std::string ansi = GenLongString(4096);
+        std::string utf8;
+        for (std::size_t i = 0; i < 1024; ++i)
+            utf8 += "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"; // 1, 2, 3 and 4 bytes sequences
+
+        sf::Uint32 sink = 0;
+        Bench("Utf8::decode (10 KB)", 1, [&]()
+        {
+            std::string::const_iterator it = utf8.begin(), end = utf8.end();
+            while (it != end)
+            {
+                sf::Uint32 codePoint;
+                it = sf::Utf8::decode(it, end, codePoint);
+                sink += codePoint;
+            };
+        });
+        if (sink == 1)
+            printf("%u\n", sink);
+
+        sf::String str32;
+        Bench("sf::String from ANSI (4 KB)", 1, [&]() { str32 = sf::String(ansi); });
+        Bench("sf::String::fromUtf8 (10 KB)", 1, [&]() { str32 = sf::String::fromUtf8(utf8.begin(), utf8.end()); });
+
+        std::string out;
+        Bench("sf::String::toAnsiString (4 KB)", 1, [&]() { out = sf::String(ansi).toAnsiString(); });
+        Bench("sf::String::toUtf8 (10 KB)", 1, [&]() { sf::String::fromUtf8(utf8.begin(), utf8.end()).toUtf8(); });
+    }
+
+    //
+    //  font & text
+    //
+    if (font)
+    {
+        Bench("Font::getGlyph (hit)", 10000, [&]() { font->getGlyph('A', 24, false); });
+
+        unsigned int characterSize = 8;
+        Bench("Font::getGlyph (miss, 95 glyphs)", 1, [&]()
+        {
+            ++characterSize; // a new character size is never cached
+            for (sf::Uint32 c = 0x20; c < 0x7F; ++c)
+                font->getGlyph(c, characterSize, false);
+        });
+
+        sf::Text text;
+        text.setFont(*font);
+        text.setCharacterSize(16);
+
+        sf::String strings[2] = { GenLongString(4096), GenLongString(4095) };
+        int index = 0;
+        Bench("Text::ensureGeometryUpdate (4 KB)", 1, [&]()
+        {
+            text.setString(strings[index ^= 1]);
+            text.getLocalBounds(); // forces the geometry update
+        });
+
+        text.setOutlineThickness(1.0f);
+        Bench("Text::ensureGeometryUpdate (4 KB, outline)", 1, [&]()
+        {
+            text.setString(strings[index ^= 1]);
+            text.getLocalBounds();
+        });
+    }
+}
+
+
+//
+//  presents a frame: swaps the hidden window, or only resolves the render texture when headless
+//
+struct Target
+{
+    sf::RenderTarget*  target;
+    sf::RenderTexture* texture;
+    SDL_Window*        window;
+
+    void present()
+    {
+        target->flush();
+        if (texture)
+            texture->display();
+        else
+            SDL_GL_SwapWindow(window);
+    }
+};
+
+
+//
+//  correctness checks, run before the GL benchmarks: a failure stops the bench
+//
+
+//  a 4-vertex strip is batched as a quad, it must cover the same triangles as
+//  the strip: a gradient on a non-parallelogram shows a wrong diagonal
+bool CheckStripBatching()
+{
+    sf::RenderTexture rtex;
+    if (!rtex.create(64, 64))
+        return false;
+
+    sf::Vertex strip[4] =
+    {
+        sf::Vertex(sf::Vector2f( 4.0f,  4.0f), sf::Color::Red),
+        sf::Vertex(sf::Vector2f(60.0f, 10.0f), sf::Color::Green),
+        sf::Vertex(sf::Vector2f(10.0f, 50.0f), sf::Color::Blue),
+        sf::Vertex(sf::Vector2f(58.0f, 62.0f), sf::Color::White)
+    };
+
+    sf::Image images[2];
+    for (int batching = 0; batching < 2; ++batching)
+    {
+        rtex.setBatchingEnabled(batching != 0);
+        rtex.clear(sf::Color::Black);
+        rtex.draw(strip, 4, sf::TriangleStrip);
+        rtex.display();
+        images[batching] = rtex.getTexture().copyToImage();
+    };
+
+    for (unsigned int y = 0; y < 64; ++y)
+    {
+        for (unsigned int x = 0; x < 64; ++x)
+        {
+            const sf::Color a = images[0].getPixel(x, y);
+            const sf::Color b = images[1].getPixel(x, y);
+            if ((std::abs(a.r - b.r) > 2) || (std::abs(a.g - b.g) > 2) || (std::abs(a.b - b.b) > 2))
+            {
+                printf("Batched triangle strip differs from the unbatched one at (%u, %u)\n", x, y);
+                return false;
+            };
+        };
+    };
+
+    return true;
+}
+
+
+//  a shader still linking in the background (KHR_parallel_shader_compile)
+//  isn't ready yet, but it isn't a failure: waiting for it must give a program
+bool CheckAsyncShader()
+{
+    const char* vertexShaderSource =
+        "#version 100                                                   \n"
+        "precision mediump float;                                       \n"
+        "attribute vec2 aPos;                                           \n"
+        "void main()                                                    \n"
+        "{                                                              \n"
+        "   gl_Position = vec4(aPos, 0.0, 1.0);                         \n"
+        "}\n";
+
+    // a different source on each run, so that the shader cache doesn't return
+    // a linked program right away
+    char fragmentShaderSource[256];
+    std::snprintf(fragmentShaderSource, sizeof(fragmentShaderSource),
+        "#version 100\n"
+        "precision mediump float;\n"
+        "void main()\n"
+        "{\n"
+        "   gl_FragColor = vec4(%d.0 / 65536.0, 0.0, 0.0, 1.0);\n"
+        "}\n", static_cast<int>(std::time(NULL) % 65536));
+
+    sf::Shader shader;
+    shader.setAttributes({ "aPos" });
+    if (!shader.loadFromMemoryAsync(vertexShaderSource, fragmentShaderSource))
+    {
+        printf("Failed to start the asynchronous shader compilation\n");
+        return false;
+    };
+
+    const bool ready = shader.isReady();
+    if (!shader.waitUntilReady() || !shader.getNativeHandle())
+    {
+        printf("Asynchronous shader failed to link (%s when first polled)\n", ready ? "ready" : "pending");
+        return false;
+    };
+
+    return true;
+}
+
+
+void BenchGpu(Target& out, sf::Font* font)
+{
+    Section("GL submission", out.texture ? " (headless)" : "");
+
+    sf::RenderTarget& rt = *out.target;
+
+    sf::Texture texture;
+    texture.loadFromImage(GenImageNoise(64, 64));
+
+    const int counts[] = { 100, 1000, 10000 };
+
+    for (int batching = 0; batching < 2; ++batching)
+    {
+        rt.setBatchingEnabled(batching != 0);
+
+        for (std::size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+        {
+            const int count = counts[c];
+
+            std::vector<sf::Sprite> sprites(count, sf::Sprite(texture));
+            for (int i = 0; i < count; ++i)
+                sprites[i].setPosition(static_cast<float>(i * 7 % 736), static_cast<float>(i * 13 % 536));
+
+            char name[64];
+            std::snprintf(name, sizeof(name), "%d sprites%s", count, batching ? " (batched)" : "");
+            Bench(name, 1, [&]()
+            {
+                rt.clear(sf::Color::Black);
+                for (int i = 0; i < count; ++i)
+                    rt.draw(sprites[i]);
+                out.present();
+            });
+        };
+
+        {
+            const int count = 1000;
+
+            std::vector<sf::RectangleShape> rectangles(count, sf::RectangleShape(sf::Vector2f(24.0f, 16.0f)));
+            std::vector<sf::CircleShape> circles(count, sf::CircleShape(12.0f));
+            for (int i = 0; i < count; ++i)
+            {
+                rectangles[i].setPosition(static_cast<float>(i * 7 % 776), static_cast<float>(i * 13 % 584));
+                rectangles[i].setFillColor(sf::Color(i * 5 % 256, i * 11 % 256, 200));
+                circles[i].setPosition(static_cast<float>(i * 11 % 776), static_cast<float>(i * 17 % 576));
+                circles[i].setOutlineThickness(1.0f);
+            };
+
+            Bench(batching ? "1000 rectangles (batched)" : "1000 rectangles", 1, [&]()
+            {
+                rt.clear(sf::Color::Black);
+                for (int i = 0; i < count; ++i)
+                    rt.draw(rectangles[i]);
+                out.present();
+            });
+
+            Bench(batching ? "1000 outlined circles (batched)" : "1000 outlined circles", 1, [&]()
+            {
+                rt.clear(sf::Color::Black);
+                for (int i = 0; i < count; ++i)
+                    rt.draw(circles[i]);
+                out.present();
+            });
+        }
+
+        if (font)
+        {
+            const int count = 100;
+
+            std::vector<sf::Text> texts(count, sf::Text("Hello SFML graphics 0123456789", *font, 16));
+            for (int i = 0; i < count; ++i)
+                texts[i].setPosition(static_cast<float>(i * 7 % 600), static_cast<float>(i * 13 % 580));
+
+            Bench(batching ? "100 texts (batched)" : "100 texts", 1, [&]()
+            {
+                rt.clear(sf::Color::Black);
+                for (int i = 0; i < count; ++i)
+                    rt.draw(texts[i]);
+                out.present();
+            });
+        };
+    };
+}
+
+
+//
+//  raw throughput: renders frames as fast as possible for a few seconds, then
+//  reads one frame back so that the GPU work is included in the measure
+//
+void BenchThroughput(Target& out, float seconds)
+{
+    Section("throughput", out.texture ? " (headless)" : "");
+
+    sf::RenderTarget& rt = *out.target;
+    rt.setBatchingEnabled(true);
+
+    sf::Texture texture;
+    texture.loadFromImage(GenImageNoise(64, 64));
+
+    const int count = 10000;
+    std::vector<sf::Sprite> sprites(count, sf::Sprite(texture));
+    for (int i = 0; i < count; ++i)
+        sprites[i].setPosition(static_cast<float>(i * 7 % 736), static_cast<float>(i * 13 % 536));
+
+    int frames = 0;
+    sf::Clock clock;
+    while (clock.getElapsedTime().asSeconds() < seconds)
+    {
+        rt.clear(sf::Color::Black);
+        for (int i = 0; i < count; ++i)
+            rt.draw(sprites[i]);
+        out.present();
+        ++frames;
+    };
+
+    if (out.texture)
+        out.texture->getTexture().copyToImage();
+
+    float elapsed = clock.getElapsedTime().asSeconds();
+    printf("%-40s %10.1f fps   %10.3f ms/frame\n", "10000 sprites (batched)", frames / elapsed, elapsed * 1000.0f / frames);
+
+    Result& result = Record("10000 sprites (batched)");
+    result.values.push_back(std::make_pair("fps", frames / elapsed));
+    result.values.push_back(std::make_pair("ms_per_frame", elapsed * 1000.0 / frames));
+}
+
+
+//
+//  compressed files of random blocks, so that the upload benchmark doesn't need any asset
+//
+void PutUint32(std::vector<sf::Uint8>& data, std::size_t offset, sf::Uint32 value)
+{
+    data[offset + 0] = static_cast<sf::Uint8>(value & 0xFF);
+    data[offset + 1] = static_cast<sf::Uint8>((value >> 8) & 0xFF);
+    data[offset + 2] = static_cast<sf::Uint8>((value >> 16) & 0xFF);
+    data[offset + 3] = static_cast<sf::Uint8>(value >> 24);
+}
+
+
+void FillNoise(sf::Uint8* data, std::size_t size)
+{
+    sf::Uint32 seed = 0x87654321;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        data[i] = static_cast<sf::Uint8>(seed >> 24);
+    };
+}
+
+
+std::vector<sf::Uint8> GenDdsBc1(unsigned int width, unsigned int height)
+{
+    const std::size_t blocks = (width / 4) * (height / 4) * 8;
+
+    std::vector<sf::Uint8> dds(128 + blocks, 0);
+    std::memcpy(&dds[0], "DDS ", 4);
+    PutUint32(dds, 4, 124);
+    PutUint32(dds, 8, 0x81007); // caps, height, width, pixel format, linear size
+    PutUint32(dds, 12, height);
+    PutUint32(dds, 16, width);
+    PutUint32(dds, 20, static_cast<sf::Uint32>(blocks));
+    PutUint32(dds, 28, 1);
+    PutUint32(dds, 76, 32);
+    PutUint32(dds, 80, 0x4); // DDPF_FOURCC
+    std::memcpy(&dds[84], "DXT1", 4);
+    PutUint32(dds, 108, 0x1000); // DDSCAPS_TEXTURE
+
+    FillNoise(&dds[128], blocks);
+    return dds;
+}
+
+
+std::vector<sf::Uint8> GenKtxEtc1(unsigned int width, unsigned int height)
+{
+    static const sf::Uint8 identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+    const std::size_t blocks = (width / 4) * (height / 4) * 8;
+
+    std::vector<sf::Uint8> ktx(64 + 4 + blocks, 0);
+    std::memcpy(&ktx[0], identifier, 12);
+    PutUint32(ktx, 12, 0x04030201);
+    PutUint32(ktx, 20, 1);      // glTypeSize
+    PutUint32(ktx, 28, 0x8D64); // GL_ETC1_RGB8_OES
+    PutUint32(ktx, 32, 0x1907); // GL_RGB
+    PutUint32(ktx, 36, width);
+    PutUint32(ktx, 40, height);
+    PutUint32(ktx, 52, 1);
+    PutUint32(ktx, 56, 1);
+    PutUint32(ktx, 64, static_cast<sf::Uint32>(blocks));
+
+    FillNoise(&ktx[68], blocks);
+    return ktx;
+}
+
+
+//
+//  every upload is timed alone: "submit" is the time spent in the call, "total"
+//  also waits for the GPU to consume it (glFinish), which is what the upload adds
+//  to the frame it happens in. MB/s is computed from the total. The number of
+//  samples shrinks with the size so that the 4096 uploads don't take minutes.
+//
+template<typename Func>
+void BenchUpload(const char* name, std::size_t bytes, Func func)
+{
+    const std::size_t budget = 256 * 1024 * 1024;
+    const int count = static_cast<int>(std::max<std::size_t>(5, std::min<std::size_t>(g_Samples, budget / bytes)));
+
+    std::vector<double> submit;
+    std::vector<double> total;
+    submit.reserve(count);
+    total.reserve(count);
+
+    func(); // warm up the pools and the driver paths
+    glFinish();
+
+    sf::Clock clock;
+    for (int i = 0; i < count; ++i)
+    {
+        clock.restart();
+        func();
+        submit.push_back(static_cast<double>(clock.getElapsedTime().asMicroseconds()));
+        glFinish();
+        total.push_back(static_cast<double>(clock.getElapsedTime().asMicroseconds()));
+    };
+
+    std::sort(submit.begin(), submit.end());
+    std::sort(total.begin(), total.end());
+
+    double median = std::max(total[total.size() / 2], 1.0);
+    double p99    = total[std::min(total.size() - 1, total.size() * 99 / 100)];
+
+    printf("%-40s submit %10.1f us   total %10.1f us   p99 %10.1f us   %8.1f MB/s\n",
+           name, submit[submit.size() / 2], median, p99, static_cast<double>(bytes) / median);
+
+    Result& result = Record(name);
+    result.values.push_back(std::make_pair("submit_us", submit[submit.size() / 2]));
+    result.values.push_back(std::make_pair("total_us", median));
+    result.values.push_back(std::make_pair("p99_us", p99));
+    result.values.push_back(std::make_pair("mb_per_s", static_cast<double>(bytes) / median));
+}
+
+
+//
+//  texture upload strategies, from 64x64 to 4096x4096 (or the maximum texture size)
+//
+void BenchUploads(Target& out)
+{
+    const sf::GraphicsCaps& caps = out.target->getGraphicsCaps();
+    char details[64];
+    std::snprintf(details, sizeof(details), " (%s sub-rectangles, %s pixel buffers)",
+                  caps.unpackRowLength ? "direct" : "gathered", caps.mapBufferRange && caps.fenceSync ? "async" : "no");
+    Section("texture uploads", details);
+
+    const unsigned int sizes[] = { 64, 256, 1024, 4096 };
+
+    for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+    {
+        const unsigned int size = sizes[s];
+        if (size > sf::Texture::getMaximumSize())
+        {
+            printf("%ux%u skipped, the maximum texture size is %u\n", size, size, sf::Texture::getMaximumSize());
+            continue;
+        };
+
+        const sf::Image image = GenImageNoise(size, size);
+        const sf::Uint8* pixels = image.getPixelsPtr();
+        const std::size_t bytes = static_cast<std::size_t>(size) * size * 4;
+        char name[64];
+
+        sf::Texture texture;
+        texture.create(size, size);
+
+        std::snprintf(name, sizeof(name), "%u update(pixels)", size);
+        BenchUpload(name, bytes, [&]()
+        {
+            texture.update(pixels);
+        });
+
+        std::snprintf(name, sizeof(name), "%u updateAsync", size);
+        BenchUpload(name, bytes, [&]()
+        {
+            texture.updateAsync(pixels, size, size, 0, 0);
+        });
+
+        // the centered half of the image, which rows aren't contiguous in client memory
+        const unsigned int half = size / 2;
+        const unsigned int left = size / 4;
+
+        std::snprintf(name, sizeof(name), "%u sub-rect, row by row", size);
+        BenchUpload(name, bytes / 4, [&]()
+        {
+            for (unsigned int y = 0; y < half; ++y)
+                texture.update(pixels + 4 * (left + size * (left + y)), half, 1, left, left + y);
+        });
+
+        sf::Texture region;
+        std::snprintf(name, sizeof(name), "%u sub-rect, single call", size);
+        BenchUpload(name, bytes / 4, [&]()
+        {
+            region.loadFromImage(image, sf::IntRect(left, left, half, half));
+        });
+
+        sf::Texture source;
+        source.loadFromImage(image);
+
+        std::snprintf(name, sizeof(name), "%u update(texture)", size);
+        BenchUpload(name, bytes, [&]()
+        {
+            texture.update(source);
+        });
+
+        sf::StreamingTexture streaming;
+        if (streaming.create(size, size))
+        {
+            std::snprintf(name, sizeof(name), "%u StreamingTexture lock/unlock", size);
+            BenchUpload(name, bytes, [&]()
+            {
+                if (sf::Uint8* locked = streaming.lock())
+                {
+                    std::memcpy(locked, pixels, bytes);
+                    streaming.unlock();
+                };
+            });
+        };
+
+        // compressed files that the driver can't take are decompressed on the CPU instead
+        const std::vector<sf::Uint8> dds = GenDdsBc1(size, size);
+        const std::vector<sf::Uint8> ktx = GenKtxEtc1(size, size);
+
+        sf::Texture compressed;
+        if (compressed.loadCompressedFromMemory(&dds[0], dds.size()))
+        {
+            std::snprintf(name, sizeof(name), "%u BC1%s", size, compressed.getMemoryUsage() < bytes ? "" : " (decompressed)");
+            BenchUpload(name, dds.size() - 128, [&]()
+            {
+                compressed.loadCompressedFromMemory(&dds[0], dds.size());
+            });
+        };
+
+        if (compressed.loadCompressedFromMemory(&ktx[0], ktx.size()))
+        {
+            std::snprintf(name, sizeof(name), "%u ETC1%s", size, compressed.getMemoryUsage() < bytes ? "" : " (decompressed)");
+            BenchUpload(name, ktx.size() - 68, [&]()
+            {
+                compressed.loadCompressedFromMemory(&ktx[0], ktx.size());
+            });
+        };
+    };
+}
+
+
+void PutJsonString(FILE* file, const std::string& str)
+{
+    fputc('"', file);
+    for (std::size_t i = 0; i < str.size(); ++i)
+    {
+        const unsigned char c = static_cast<unsigned char>(str[i]);
+        if ((c == '"') || (c == '\\'))
+            fprintf(file, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(file, "\\u%04x", c);
+        else
+            fputc(c, file);
+    };
+    fputc('"', file);
+}
+
+
+//
+//  one object per result, the values are keyed by name so that a script can
+//  match the results of two runs by group and name
+//
+bool WriteJson(const char* path, const std::string& label, const std::string& renderer, bool headless)
+{
+    FILE* file = std::fopen(path, "w");
+    if (!file)
+    {
+        printf("Failed to write %s\n", path);
+        return false;
+    };
+
+    fprintf(file, "{\n  \"label\": ");
+    PutJsonString(file, label);
+    fprintf(file, ",\n  \"renderer\": ");
+    PutJsonString(file, renderer);
+#ifdef __EMSCRIPTEN__
+    fprintf(file, ",\n  \"platform\": \"emscripten\"");
+#else
+    fprintf(file, ",\n  \"platform\": \"native\"");
+#endif
+    fprintf(file, ",\n  \"headless\": %s,\n  \"samples\": %d,\n  \"results\": [", headless ? "true" : "false", g_Samples);
+
+    for (std::size_t i = 0; i < g_Results.size(); ++i)
+    {
+        const Result& result = g_Results[i];
+
+        fprintf(file, "%s\n    { \"group\": ", i ? "," : "");
+        PutJsonString(file, result.group);
+        fprintf(file, ", \"name\": ");
+        PutJsonString(file, result.name);
+        for (std::size_t j = 0; j < result.values.size(); ++j)
+            fprintf(file, ", \"%s\": %.3f", result.values[j].first, result.values[j].second);
+        fprintf(file, " }");
+    };
+
+    fprintf(file, "\n  ]\n}\n");
+    std::fclose(file);
+    return true;
+}
+
+
+int main(int argc, char** argv)
+{
+    bool headless = false;
+    const char* json = NULL;
+    std::string label;
+    std::vector<const char*> args;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--headless") == 0)
+            headless = true;
+        else if ((std::strcmp(argv[i], "--json") == 0) && (i + 1 < argc))
+            json = argv[++i];
+        else if ((std::strcmp(argv[i], "--label") == 0) && (i + 1 < argc))
+            label = argv[++i];
+        else
+            args.push_back(argv[i]);
+    };
+
+#ifdef __EMSCRIPTEN__
+    headless = true; // the canvas is never presented while main runs
+#endif
+
+    if (args.size() > 1)
+        g_Samples = std::max(1, std::atoi(args[1]));
+
+    //
+    //  the CPU benchmarks don't need any GL context, except the glyph
+    //  cache (textures), so everything runs with the context current
+    //
+    if (SDL_Init(SDL_INIT_EVENTS | SDL_INIT_VIDEO) < 0)
+    {
+        printf("Init SDL failed! %s\n", SDL_GetError());
+        return -1;
+    };
+
+    SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 2);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 1);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_ES);
+
+    SDL_Window* window = SDL_CreateWindow("SFML GRAPHICS BENCH",
+                                          SDL_WINDOWPOS_UNDEFINED,
+                                          SDL_WINDOWPOS_UNDEFINED,
+                                          800,
+                                          600,
+                                          SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+    if (!window)
+    {
+        printf("Init SDL window failed! %s\n", SDL_GetError());
+        return -1;
+    };
+
+    SDL_GLContext glctx = SDL_GL_CreateContext(window);
+    if (!glctx)
+    {
+        printf("Init SDL OPENGL context failed! %s\n", SDL_GetError());
+        return -1;
+    };
+
+    SDL_GL_MakeCurrent(window, glctx);
+    SDL_GL_SetSwapInterval(0); // don't measure vsync
+
+    printf("%d samples per benchmark\n", g_Samples);
+
+    std::string context;
+
+    {
+        // Font::loadFromStream only accepts contiguous streams: the file is read
+        // at once, and the buffer must outlive the font
+        std::vector<char> fontData;
+        sf::Font fontStorage;
+        sf::Font* font = NULL;
+        if (!args.empty())
+        {
+            sf::FileInputStream fontStream;
+            if (fontStream.open(args[0]) && (fontStream.getSize() > 0))
+            {
+                fontData.resize(static_cast<std::size_t>(fontStream.getSize()));
+                if (fontStream.read(&fontData[0], fontStream.getSize()) != fontStream.getSize())
+                    fontData.clear();
+            };
+
+            if (!fontData.empty() && fontStorage.loadFromMemory(&fontData[0], fontData.size()))
+                font = &fontStorage;
+            else
+                printf("Failed to load font %s, font & text benchmarks are skipped\n", args[0]);
+        };
+
+        BenchCpu(font);
+
+        sf::RenderWindow rw(800, 600);
+        rw.onCreate();
+
+        sf::RenderTexture rtex;
+        if (headless && !rtex.create(800, 600))
+        {
+            printf("Failed to create the offscreen render texture\n");
+            return -1;
+        };
+
+        // the OpenGL functions are loaded by the first render target
+        const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+        const char* version  = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+        context = std::string(renderer ? renderer : "unknown") + ", " + (version ? version : "unknown");
+        printf("\n%s\n", context.c_str());
+
+        if (!CheckStripBatching() || !CheckAsyncShader())
+            return -1;
+
+        Target out = { headless ? static_cast<sf::RenderTarget*>(&rtex) : &rw, headless ? &rtex : NULL, window };
+        BenchGpu(out, font);
+        BenchThroughput(out, 3.0f);
+        BenchUploads(out);
+    } // release the GL resources while the context is still alive
+
+    if (json && !WriteJson(json, label, context, headless))
+        return -1;
+
+    SDL_GL_DeleteContext(glctx);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+
+    return 0;
+};
@@ -0,0 +1,6 @@
+@ECHO OFF
+PUSHD "%~dp0"
+rmdir /q /s "obj/Release/SFML_GRAPHICS_BENCH"
+make config=release SFML_GRAPHICS_BENCH
+pause
+POPD
\ No newline at end of file
@@ -102,6 +102,7 @@ int main(int argc, char** argv)
     //
     sf::RenderWindow rw(800, 600);
     rw.onCreate(); // WARNING: required to update initial view from render window size
+    rw.setBatchingEnabled(true);
 
     sf::Image imgChecker = GenImageChecked(800, 600, 32, 32, sf::Color(90, 90, 90, 255), sf::Color(130, 130, 130, 255));
     sf::Texture texChecker;
@@ -225,8 +226,12 @@ int main(int argc, char** argv)
 
         rw.draw(text);
         rw.draw(convex);
+        rw.flush(); // WARNING: required with batching before swapping buffers
 
         SDL_GL_SwapWindow(window);
+
+        // The buffers are swapped here rather than by rw.display(), which would start the next frame
+        rw.resetFrameStats();
     };
 
     SDL_Quit();
@@ -133,6 +133,12 @@
 
 #endif
 
+////////////////////////////////////////////////////////////
+// Define this macro to compile the trace scopes of the
+// render path (see SFML/System/Trace.hpp)
+////////////////////////////////////////////////////////////
+//#define SFML_ENABLE_TRACING
+
 #define SFML_STATIC
 
 ////////////////////////////////////////////////////////////
@@ -29,32 +29,82 @@
 // Headers
 ////////////////////////////////////////////////////////////
 
+#include <SFML/Graphics/Allocator.hpp>
+#include <SFML/Graphics/AnimatedSpriteBatch.hpp>
+#include <SFML/Graphics/AssetBundle.hpp>
+#include <SFML/Graphics/AssetBundleWriter.hpp>
+#include <SFML/Graphics/AsyncQueue.hpp>
+#include <SFML/Graphics/Awaitable.hpp>
 #include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/CachedLayer.hpp>
+#include <SFML/Graphics/Canvas.hpp>
 #include <SFML/Graphics/CircleShape.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/ContextRestore.hpp>
 #include <SFML/Graphics/ConvexShape.hpp>
+#include <SFML/Graphics/DirtyRegion.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/DrawCapture.hpp>
+#include <SFML/Graphics/DrawList.hpp>
+#include <SFML/Graphics/DrawReplay.hpp>
+#include <SFML/Graphics/DynamicResolution.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/FontCollection.hpp>
+#include <SFML/Graphics/FrameArena.hpp>
 #include <SFML/Graphics/Glyph.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/Graphics/GpuProfiler.hpp>
+#include <SFML/Graphics/GraphicsCaps.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/MemoryStats.hpp>
+#include <SFML/Graphics/NineSliceSprite.hpp>
+#include <SFML/Graphics/Node.hpp>
+#include <SFML/Graphics/NumericText.hpp>
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/Graphics/Polyline.hpp>
+#include <SFML/Graphics/PostProcess.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RectBatch.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderStats.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RenderTexturePool.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/ResourceLoader.hpp>
+#include <SFML/Graphics/SceneGrid.hpp>
 #include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/ShaderCache.hpp>
+#include <SFML/Graphics/ShaderLibrary.hpp>
 #include <SFML/Graphics/Shape.hpp>
 #include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/StartupStats.hpp>
+#include <SFML/Graphics/StatsOverlay.hpp>
+#include <SFML/Graphics/StreamingTexture.hpp>
 #include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/TextBatch.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <SFML/Graphics/TexturePool.hpp>
+#include <SFML/Graphics/TileMap.hpp>
+#include <SFML/Graphics/TiledTexture.hpp>
 #include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/TransformBuffer.hpp>
 #include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/UniformBuffer.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/VertexBufferArena.hpp>
 #include <SFML/Graphics/View.hpp>
+#include <SFML/Graphics/YuvSprite.hpp>
+#include <SFML/Graphics/YuvTexture.hpp>
 
 
 #endif // SFML_GRAPHICS_HPP
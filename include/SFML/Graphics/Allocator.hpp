@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ALLOCATOR_HPP
+#define SFML_ALLOCATOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/MemoryStats.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Hooks for the memory blocks allocated by the
+///        graphics module
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API Allocator
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function allocating a block
+    ///
+    /// \param size     Size of the block, in bytes
+    /// \param tag      Subsystem requesting the block
+    /// \param userData Pointer given to setCallbacks
+    ///
+    /// \return Pointer to the block, suitably aligned for any type, or NULL on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void* (*AllocateCallback)(std::size_t size, MemoryStats::Tag tag, void* userData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function freeing a block
+    ///
+    /// \param block    Block returned by the allocation function
+    /// \param size     Size of the block, as requested at its allocation
+    /// \param tag      Subsystem that requested the block
+    /// \param userData Pointer given to setCallbacks
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void (*DeallocateCallback)(void* block, std::size_t size, MemoryStats::Tag tag, void* userData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Route the allocations to custom functions
+    ///
+    /// The blocks are allocated with the C heap by default.
+    /// The callbacks must be set before the graphics module
+    /// allocates anything, since the blocks must be freed by
+    /// the allocator that created them. They are called from
+    /// the loading threads too, so they must be thread-safe.
+    ///
+    /// \param allocate   Function allocating a block, or NULL to restore the C heap
+    /// \param deallocate Function freeing a block allocated by \a allocate
+    /// \param userData   User pointer passed to the callbacks
+    ///
+    /// \return True if the callbacks were set, false if blocks are still allocated
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setCallbacks(AllocateCallback allocate, DeallocateCallback deallocate, void* userData = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate a block
+    ///
+    /// The block is accounted to \a tag in sf::MemoryStats.
+    ///
+    /// \param size Size of the block, in bytes
+    /// \param tag  Subsystem requesting the block
+    ///
+    /// \return Pointer to the block, or NULL on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static void* allocate(std::size_t size, MemoryStats::Tag tag);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Free a block allocated by allocate
+    ///
+    /// \param block Block to free (NULL is ignored)
+    /// \param size  Size of the block, as requested at its allocation
+    /// \param tag   Subsystem that requested the block
+    ///
+    ////////////////////////////////////////////////////////////
+    static void deallocate(void* block, std::size_t size, MemoryStats::Tag tag);
+};
+
+} // namespace sf
+
+
+#endif // SFML_ALLOCATOR_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Allocator
+/// \ingroup graphics
+///
+/// sf::Allocator is the single place where the graphics module
+/// allocates raw memory blocks, such as the internals of the
+/// FreeType library shared by the fonts. Every block is tagged
+/// with the subsystem that requested it and accounted in
+/// sf::MemoryStats, whatever the allocator.
+///
+/// Applications with their own memory manager, or that need
+/// to attribute the memory of the library in their own tools,
+/// can replace the C heap with their functions. Font::setAllocator
+/// still takes precedence for the blocks of FreeType.
+///
+/// Usage example:
+/// \code
+/// void* allocate(std::size_t size, sf::MemoryStats::Tag tag, void* userData)
+/// {
+///     return static_cast<Heap*>(userData)->allocate(size, tagNames[tag]);
+/// }
+///
+/// void deallocate(void* block, std::size_t size, sf::MemoryStats::Tag, void* userData)
+/// {
+///     static_cast<Heap*>(userData)->free(block, size);
+/// }
+///
+/// // Before loading any font
+/// sf::Allocator::setCallbacks(&allocate, &deallocate, &heap);
+/// \endcode
+///
+/// \see sf::MemoryStats, sf::Font::setAllocator
+///
+////////////////////////////////////////////////////////////
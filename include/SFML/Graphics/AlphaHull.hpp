@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ALPHAHULL_HPP
+#define SFML_ALPHAHULL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Compute a convex outline of the visible pixels of an image area
+///
+/// The outline encloses every pixel of \a area whose alpha is
+/// not zero. When the convex hull of these pixels has more
+/// than \a maxVertices vertices, its shortest edges are
+/// removed by extending their neighbour edges until they
+/// meet, which only makes the outline larger, and never
+/// beyond \a area.
+///
+/// The outline is not computed when \a area has no visible
+/// pixel, when it can't be reduced to \a maxVertices
+/// vertices, or when it would cover nearly all of \a area
+/// anyway: a plain quad is then the cheaper mesh.
+///
+/// \param image       Source image
+/// \param area        Area of the image to outline, in pixels
+/// \param maxVertices Maximum number of vertices of the outline (at least 3)
+/// \param outline     Receives the vertices of the outline, relative to
+///                    the top-left corner of \a area, in order
+///
+/// \return True if the outline was computed
+///
+////////////////////////////////////////////////////////////
+bool computeAlphaHull(const Image& image, const IntRect& area, std::size_t maxVertices, std::vector<Vector2f>& outline);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_ALPHAHULL_HPP
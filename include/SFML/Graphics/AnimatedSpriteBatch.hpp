@@ -0,0 +1,335 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ANIMATEDSPRITEBATCH_HPP
+#define SFML_ANIMATEDSPRITEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Many sprites playing sprite sheet animations,
+///        animated on the GPU
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API AnimatedSpriteBatch : public Drawable, NonCopyable
+{
+public:
+
+    enum
+    {
+        MaxFrames = 64 ///< Maximum number of frames in the frame table
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch with no texture and no frames.
+    ///
+    ////////////////////////////////////////////////////////////
+    AnimatedSpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~AnimatedSpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sprite sheet of the batch
+    ///
+    /// The texture must exist as long as the batch uses it.
+    ///
+    /// \param texture Sprite sheet, or NULL to draw plain quads
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sprite sheet of the batch
+    ///
+    /// \return Sprite sheet, or NULL if the sprites are untextured
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append frames to the frame table
+    ///
+    /// Each frame is an area of the sprite sheet, in pixels;
+    /// its size is also the size of the sprites that display
+    /// it. The frames of an animation are consecutive entries
+    /// of the table.
+    ///
+    /// \param frames Array of frames
+    /// \param count  Number of frames in the array
+    ///
+    /// \return Index of the first frame in the table, or MaxFrames if the table is full
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addFrames(const IntRect* frames, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a frame of the frame table
+    ///
+    /// All the sprites that display the frame are affected.
+    ///
+    /// \param index Index of the frame
+    /// \param frame New area of the frame in the sprite sheet, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFrame(std::size_t index, const IntRect& frame);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames in the frame table
+    ///
+    /// \return Number of frames
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFrameCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an animated sprite to the batch
+    ///
+    /// The sprite loops over the frames [firstFrame, firstFrame
+    /// + frameCount) of the frame table, starting with the
+    /// first one at the current time of the batch.
+    ///
+    /// \param transform  Transform of the sprite, the top-left corner of the frames is its local origin
+    /// \param firstFrame Index of the first frame of the animation
+    /// \param frameCount Number of frames of the animation
+    /// \param frameRate  Frames displayed per second
+    /// \param color      Color of the sprite
+    ///
+    /// \return Index of the sprite in the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Transform& transform, std::size_t firstFrame, std::size_t frameCount, float frameRate,
+                    const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change an animated sprite of the batch
+    ///
+    /// The animation goes on from the time it was started.
+    ///
+    /// \param index      Index of the sprite, as returned by add
+    /// \param transform  Transform of the sprite, the top-left corner of the frames is its local origin
+    /// \param firstFrame Index of the first frame of the animation
+    /// \param frameCount Number of frames of the animation
+    /// \param frameRate  Frames displayed per second
+    /// \param color      Color of the sprite
+    ///
+    /// \see restart
+    ///
+    ////////////////////////////////////////////////////////////
+    void set(std::size_t index, const Transform& transform, std::size_t firstFrame, std::size_t frameCount,
+             float frameRate, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restart the animation of a sprite from its first frame
+    ///
+    /// \param index Index of the sprite, as returned by add
+    ///
+    ////////////////////////////////////////////////////////////
+    void restart(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sprites in the batch
+    ///
+    /// \return Number of sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSpriteCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the sprites
+    ///
+    /// The frame table is kept.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Advance the animations
+    ///
+    /// This only advances the clock of the batch: the frames
+    /// of the sprites are picked by the GPU when they are drawn.
+    ///
+    /// \param elapsed Time elapsed since the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time elapsed);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time of the batch
+    ///
+    /// \return Time accumulated by update
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the sprites can be animated on the GPU
+    ///
+    /// The GPU path requires instanced rendering. When it is
+    /// not available, or when the batch is drawn with a custom
+    /// shader, the frames are picked on the CPU each time the
+    /// batch is drawn, with the same results.
+    ///
+    /// \return True if the sprites are animated on the GPU
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isGpuAnimationAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the sprites to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the sprites changed since the last draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadSprites() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Build the quads of the current frames into m_vertices, on the CPU
+    ///
+    ////////////////////////////////////////////////////////////
+    void animateSprites() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a sprite as changed since the last upload
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sprite as passed by the user
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Item
+    {
+        Transform transform;
+        Color     color;
+        float     firstFrame;
+        float     frameCount;
+        float     frameRate;
+        float     startTime;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Texture*              m_texture;    ///< Sprite sheet of the batch
+    std::vector<float>          m_frames;     ///< Frame table, as (left, top, width, height) in pixels
+    Uint64                      m_framesId;   ///< Unique number that identifies the content of the frame table
+    std::vector<Item>           m_items;      ///< Sprites of the batch
+    float                       m_time;       ///< Current time of the animations, in seconds
+    mutable unsigned int        m_buffer;     ///< Instance buffer handle
+    mutable std::size_t         m_bufferSize; ///< Size in instances of the allocated instance buffer
+    mutable std::size_t         m_dirtyBegin; ///< First sprite changed since the last upload
+    mutable std::size_t         m_dirtyEnd;   ///< One past the last sprite changed since the last upload
+    mutable std::vector<Vertex> m_vertices;   ///< Animated quads, when the GPU path is not used
+};
+
+} // namespace sf
+
+
+#endif // SFML_ANIMATEDSPRITEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AnimatedSpriteBatch
+/// \ingroup graphics
+///
+/// sf::AnimatedSpriteBatch draws many sprites that play
+/// animations from the same sprite sheet, without any work
+/// on the CPU once they are added. Animating sf::Sprite means
+/// calling setTextureRect on every sprite at every frame;
+/// here each sprite is instead described once by its
+/// transform, the range of its animation in a frame table
+/// and its frame rate, and the vertex shader picks the
+/// current frame from the time of the batch.
+///
+/// The sprites are stored in a GPU buffer that is only
+/// uploaded when they are added or changed, and the frame
+/// table (up to MaxFrames areas of the sprite sheet) is only
+/// uploaded when it changes. Drawing the batch is a single
+/// instanced draw call regardless of the number of sprites;
+/// advancing the animations with update only changes the
+/// time given to the shader.
+///
+/// The time is kept as seconds in single precision, so the
+/// frames of sprites added after many hours of uninterrupted
+/// animation become imprecise; clear the batch and add the
+/// sprites again to start over.
+///
+/// Usage example:
+/// \code
+/// sf::AnimatedSpriteBatch coins;
+/// coins.setTexture(&sheet);
+///
+/// // 8 frames of 16x16 on the first row of the sheet
+/// sf::IntRect frames[8];
+/// for (int i = 0; i < 8; ++i)
+///     frames[i] = sf::IntRect(i * 16, 0, 16, 16);
+/// std::size_t spin = coins.addFrames(frames, 8);
+///
+/// for (const Coin& coin : level.coins)
+///     coins.add(coin.getTransform(), spin, 8, 12.f);
+///
+/// // Each frame
+/// coins.update(clock.restart());
+/// window.draw(coins);
+/// \endcode
+///
+/// \see sf::SpriteBatch, sf::ParticleSystem
+///
+////////////////////////////////////////////////////////////
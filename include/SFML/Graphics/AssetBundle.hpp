@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ASSETBUNDLE_HPP
+#define SFML_ASSETBUNDLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Read-only pack of assets baked in their final GPU format
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API AssetBundle : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Kinds of bundled assets
+    ///
+    ////////////////////////////////////////////////////////////
+    enum EntryType
+    {
+        EntryData,      ///< Raw bytes (font files, sounds, any other file)
+        EntryTexture,   ///< Texels with their mipmaps, see Texture::loadFromBundle
+        EntryAtlas,     ///< Named regions of a bundled texture
+        EntryGlyphCache ///< Pre-rasterized glyph pages, see Font::loadGlyphCache
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Named area of an atlas texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Region
+    {
+        std::string name; ///< Name of the region, unique in its atlas
+        IntRect     rect; ///< Area of the region in the texture, in pixels
+    };
+
+    static const std::size_t NotFound; ///< Index returned by find for missing entries
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The bundle is empty until it is opened.
+    ///
+    ////////////////////////////////////////////////////////////
+    AssetBundle();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a bundle file
+    ///
+    /// The file is mapped in memory on the systems that support
+    /// it, so that opening it reads nothing but the index, and
+    /// each payload is paged in when it is used. Elsewhere, the
+    /// file is read at once.
+    ///
+    /// \param filename Path of the bundle file
+    ///
+    /// \return True if the bundle was opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a bundle in memory
+    ///
+    /// The data is not copied, it must stay alive as long as the
+    /// bundle and the assets that refer to it (see getData) are
+    /// used.
+    ///
+    /// \param data Pointer to the bundle in memory
+    /// \param size Size of the bundle, in bytes
+    ///
+    /// \return True if the bundle was opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFromMemory(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a bundle from a stream
+    ///
+    /// Streams that expose their contents in memory (see
+    /// InputStream::getContiguousData), such as MemoryInputStream
+    /// and MappedFileInputStream, are used in place and must
+    /// stay alive as long as the bundle. Other streams are read
+    /// at once into the bundle.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if the bundle was opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFromStream(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the bundle
+    ///
+    /// All the pointers returned by getData become invalid.
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of entries of the bundle
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getEntryCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find an entry by name
+    ///
+    /// The index is sorted, the lookup is a binary search that
+    /// doesn't allocate.
+    ///
+    /// \param name Name of the entry
+    ///
+    /// \return Index of the entry, or NotFound
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t find(const std::string& name) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of an entry
+    ///
+    /// \param index Index of the entry, in [0, getEntryCount())
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string getName(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the type of an entry
+    ///
+    /// \param index Index of the entry, in [0, getEntryCount())
+    ///
+    ////////////////////////////////////////////////////////////
+    EntryType getType(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the payload of an entry
+    ///
+    /// The pointer refers to the bundle contents (the mapping of
+    /// the file, when it is mapped), it stays valid until the
+    /// bundle is closed. It is aligned to a memory page.
+    ///
+    /// \param index Index of the entry, in [0, getEntryCount())
+    /// \param size  Receives the size of the payload, in bytes
+    ///
+    /// \return Pointer to the payload
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData(std::size_t index, std::size_t& size) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the regions of an atlas entry
+    ///
+    /// \param index   Index of the atlas entry
+    /// \param texture Receives the index of the texture entry of the atlas
+    /// \param regions Receives the regions of the atlas
+    ///
+    /// \return True if the entry is a valid atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getAtlas(std::size_t index, std::size_t& texture, std::vector<Region>& regions) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check and adopt the bundle contents
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index record of an entry
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* getIndexEntry(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Uint8*          m_data;       ///< Contents of the bundle
+    std::size_t           m_size;       ///< Size of the contents, in bytes
+    std::size_t           m_entryCount; ///< Number of entries
+    const char*           m_names;      ///< Bytes of the names
+    std::size_t           m_namesSize;  ///< Size of the names, in bytes
+    MappedFileInputStream m_file;       ///< Bundle file, when opened with openFromFile
+    std::vector<Uint8>    m_buffer;     ///< Contents of the bundle, when they were read from a stream
+};
+
+} // namespace sf
+
+
+#endif // SFML_ASSETBUNDLE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AssetBundle
+/// \ingroup graphics
+///
+/// Loading an asset the usual way decodes it on the CPU
+/// (PNG inflate, RGBA conversion, mipmap generation, glyph
+/// rasterization) before uploading it, which makes the cold
+/// start of a game with many assets take seconds on mobile
+/// devices. sf::AssetBundle packs the assets once, at build
+/// time, in the exact layout that OpenGL consumes: at
+/// runtime they are uploaded straight from the mapped file,
+/// with nothing left to decode.
+///
+/// A bundle is an index of named entries followed by their
+/// payloads, each aligned to a memory page:
+/// \li textures, raw (RGBA or single channel) or compressed,
+///     with their whole mip chain
+/// \li atlases, the named regions of a bundled texture
+/// \li glyph caches, the pages of a font rasterized in advance
+/// \li raw data, for any other file
+///
+/// Bundles are made with sf::AssetBundleWriter, typically by a
+/// build tool.
+///
+/// Usage example:
+/// \code
+/// sf::AssetBundle bundle;
+/// if (!bundle.openFromFile("assets.bundle"))
+///     return -1;
+///
+/// sf::Texture tiles;
+/// tiles.loadFromBundle(bundle, "tiles");
+///
+/// std::size_t fontData = 0;
+/// const void* font = bundle.getData(bundle.find("ui.ttf"), fontData);
+/// sf::Font uiFont;
+/// uiFont.loadFromMemory(font, fontData);
+///
+/// std::size_t glyphSize = 0;
+/// const void* glyphs = bundle.getData(bundle.find("ui.glyphs"), glyphSize);
+/// uiFont.loadGlyphCache(glyphs, glyphSize);
+/// \endcode
+///
+/// \see sf::AssetBundleWriter, sf::Texture::loadFromBundle
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ASSETBUNDLEFORMAT_HPP
+#define SFML_ASSETBUNDLEFORMAT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompressedImage.hpp>
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+// Layout of an asset bundle (all the values are little endian)
+//
+// Header, 32 bytes:
+//     Uint32 magic, Uint32 version, Uint32 entry count, Uint32 payload alignment,
+//     Uint64 offset of the names, Uint64 size of the names
+// Index, 32 bytes per entry, sorted by name:
+//     Uint32 type, Uint32 name offset, Uint32 name length, Uint32 reserved,
+//     Uint64 payload offset, Uint64 payload size
+// Names: the bytes of all the names, not terminated
+// Payloads: each one starts at a multiple of the payload alignment
+//
+// Texture payload:
+//     Uint32 pixel format, Uint32 GL internal format (compressed only), Uint32 flags,
+//     Uint32 width, Uint32 height, Uint32 level count,
+//     level count times: Uint64 offset in the payload, Uint64 size
+//     then the texels of each level, in the GPU format, each level 16 bytes aligned
+//
+// Atlas payload:
+//     Uint32 index of the texture entry, Uint32 region count,
+//     region count times: Uint32 name offset, Uint32 name length, Int32 left, top, width, height
+////////////////////////////////////////////////////////////
+const Uint32      bundleMagic             = 0x42414653; // "SFAB"
+const Uint32      bundleVersion           = 1;
+const std::size_t bundleHeaderSize        = 32;
+const std::size_t bundleIndexEntrySize    = 32;
+const std::size_t bundleAlignment         = 4096;       // page size, so that payloads can be mapped on their own
+const std::size_t bundleLevelAlignment    = 16;
+const std::size_t bundleTextureHeaderSize = 24;
+const std::size_t bundleLevelEntrySize    = 16;
+const std::size_t bundleAtlasHeaderSize   = 8;
+const std::size_t bundleRegionSize        = 24;
+const Uint32      bundleTextureSRgb       = 1 << 0;
+
+////////////////////////////////////////////////////////////
+/// \brief Formats of the texels of a bundled texture
+///
+////////////////////////////////////////////////////////////
+enum BundlePixelFormat
+{
+    BundleRGBA8,     ///< 8 bits per channel, RGBA
+    BundleR8,        ///< 8 bits of red only
+    BundleCompressed ///< Compressed blocks, the GL internal format is stored with them
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Texels of a bundled texture, ready to be uploaded
+///
+////////////////////////////////////////////////////////////
+struct BundleTexture
+{
+    BundlePixelFormat pixelFormat; ///< Format of the texels
+    CompressedImage   image;       ///< Size, sRGB flag and levels (format is only set for compressed texels)
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Parse the payload of a texture entry
+///
+/// The levels point into \a data, nothing is copied.
+///
+/// \param data     Payload of the entry
+/// \param dataSize Size of the payload, in bytes
+/// \param texture  Receives the texels
+///
+/// \return True if the payload is a valid texture
+///
+////////////////////////////////////////////////////////////
+bool parseBundleTexture(const void* data, std::size_t dataSize, BundleTexture& texture);
+
+////////////////////////////////////////////////////////////
+/// \brief Read a little endian 32-bit value
+///
+////////////////////////////////////////////////////////////
+inline Uint32 readBundleUint32(const Uint8* bytes)
+{
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<Uint32>(bytes[3]) << 24);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Read a little endian 64-bit value
+///
+////////////////////////////////////////////////////////////
+inline Uint64 readBundleUint64(const Uint8* bytes)
+{
+    return readBundleUint32(bytes) | (static_cast<Uint64>(readBundleUint32(bytes + 4)) << 32);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Write a little endian 32-bit value
+///
+////////////////////////////////////////////////////////////
+inline void writeBundleUint32(Uint8* bytes, Uint32 value)
+{
+    for (int i = 0; i < 4; ++i)
+        bytes[i] = static_cast<Uint8>(value >> (i * 8));
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Write a little endian 64-bit value
+///
+////////////////////////////////////////////////////////////
+inline void writeBundleUint64(Uint8* bytes, Uint64 value)
+{
+    writeBundleUint32(bytes, static_cast<Uint32>(value));
+    writeBundleUint32(bytes + 4, static_cast<Uint32>(value >> 32));
+}
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_ASSETBUNDLEFORMAT_HPP
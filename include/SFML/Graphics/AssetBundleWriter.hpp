@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ASSETBUNDLEWRITER_HPP
+#define SFML_ASSETBUNDLEWRITER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/AssetBundle.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Font;
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Bakes assets into a bundle readable by sf::AssetBundle
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API AssetBundleWriter
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add raw bytes
+    ///
+    /// \param name Name of the entry, unique in the bundle
+    /// \param data Pointer to the bytes
+    /// \param size Number of bytes
+    ///
+    /// \return True if the entry was added
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addData(const std::string& name, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image as an uncompressed texture
+    ///
+    /// With \a mipmaps, the whole mip chain is generated now
+    /// (see Image::generateMipChain) and stored with the image,
+    /// so that loading the texture doesn't have to.
+    ///
+    /// \param name    Name of the entry, unique in the bundle
+    /// \param image   Pixels of the texture
+    /// \param format  Texture::RGBA8, or Texture::R8 to keep only the red channel
+    /// \param mipmaps Store the mip chain too?
+    /// \param sRgb    Are the pixels sRGB encoded?
+    ///
+    /// \return True if the entry was added
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addTexture(const std::string& name, const Image& image, Texture::Format format = Texture::RGBA8, bool mipmaps = false, bool sRgb = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a compressed texture
+    ///
+    /// The blocks of all the levels of the file are stored as
+    /// is. The file formats are the ones of
+    /// Texture::loadCompressedFromMemory.
+    ///
+    /// \param name Name of the entry, unique in the bundle
+    /// \param data Pointer to the compressed file in memory
+    /// \param size Size of the file, in bytes
+    ///
+    /// \return True if the entry was added
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addCompressedTexture(const std::string& name, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the regions of an atlas texture
+    ///
+    /// \param name    Name of the entry, unique in the bundle
+    /// \param texture Name of the texture entry of the atlas, which must be added too
+    /// \param regions Named areas of the texture
+    ///
+    /// \return True if the entry was added
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addAtlas(const std::string& name, const std::string& texture, const std::vector<AssetBundle::Region>& regions);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the glyphs loaded so far by a font
+    ///
+    /// The font must have been loaded from memory, see
+    /// Font::saveGlyphCache.
+    ///
+    /// \param name Name of the entry, unique in the bundle
+    /// \param font Font whose glyphs are saved
+    ///
+    /// \return True if the entry was added
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addGlyphCache(const std::string& name, const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the bundle to a buffer in memory
+    ///
+    /// \param data Receives the bundle
+    ///
+    /// \return True if the bundle was written
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToMemory(std::vector<Uint8>& data) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the bundle to a file
+    ///
+    /// \param filename Path of the file to write
+    ///
+    /// \return True if the bundle was written
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToFile(const std::string& filename) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the entries
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry waiting to be written
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        std::string                      name;    ///< Name of the entry
+        AssetBundle::EntryType           type;    ///< Type of the entry
+        std::vector<Uint8>               payload; ///< Payload (atlases are encoded when saving)
+        std::string                      texture; ///< Name of the texture entry, for atlases
+        std::vector<AssetBundle::Region> regions; ///< Regions, for atlases
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a new entry, if its name is not taken yet
+    ///
+    /// \return The new entry, or NULL if the name is taken
+    ///
+    ////////////////////////////////////////////////////////////
+    Entry* addEntry(const std::string& name, AssetBundle::EntryType type);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Entry> m_entries; ///< Entries, in the order they were added
+};
+
+} // namespace sf
+
+
+#endif // SFML_ASSETBUNDLEWRITER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AssetBundleWriter
+/// \ingroup graphics
+///
+/// sf::AssetBundleWriter does, once and usually in a build
+/// tool, all the work that loading the assets would do at
+/// each launch: decoding, mipmap generation, glyph
+/// rasterization. The resulting bundle is read with
+/// sf::AssetBundle.
+///
+/// Usage example:
+/// \code
+/// sf::Image tiles;
+/// tiles.loadFromFile("tiles.png");
+///
+/// std::vector<sf::AssetBundle::Region> regions(2);
+/// regions[0].name = "grass"; regions[0].rect = sf::IntRect(0, 0, 32, 32);
+/// regions[1].name = "water"; regions[1].rect = sf::IntRect(32, 0, 32, 32);
+///
+/// sf::AssetBundleWriter writer;
+/// writer.addTexture("tiles", tiles, sf::Texture::RGBA8, true);
+/// writer.addAtlas("tiles.atlas", "tiles", regions);
+/// writer.addGlyphCache("ui.glyphs", uiFont);
+/// writer.saveToFile("assets.bundle");
+/// \endcode
+///
+/// \see sf::AssetBundle
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ASYNCQUEUE_HPP
+#define SFML_ASYNCQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/Time.hpp>
+#include <cstddef>
+#include <functional>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Queue of the continuations of asynchronous
+///        operations, resumed on the render thread
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API AsyncQueue
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function telling whether an operation is complete
+    ///
+    /// It is called by pump, on the render thread, until it
+    /// returns true.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::function<bool()> Poll;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called by pump once its operation is complete
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::function<void()> Continuation;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run a function at the next pump
+    ///
+    /// This function can be called from any thread, for example
+    /// to come back to the render thread after a job.
+    ///
+    /// \param continuation Function to call from pump
+    ///
+    ////////////////////////////////////////////////////////////
+    static void post(const Continuation& continuation);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run a function once an operation is complete
+    ///
+    /// \a poll is called by each pump until it returns true,
+    /// then \a continuation is called by the same pump or, if
+    /// its time budget is spent, by the next one. This function
+    /// can be called from any thread.
+    ///
+    /// \param poll         Function telling whether the operation is complete
+    /// \param continuation Function to call from pump once it is
+    ///
+    ////////////////////////////////////////////////////////////
+    static void post(const Poll& poll, const Continuation& continuation);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resume the continuations of the complete operations
+    ///
+    /// Call this function once per frame on the render thread,
+    /// with its OpenGL context active, at the point of the
+    /// frame where the results of the asynchronous operations
+    /// can be used. The operations are polled and resumed in
+    /// the order they were posted, until \a budget is spent;
+    /// the others wait for the next call. The continuations
+    /// posted while pumping run at the next call.
+    ///
+    /// \param budget Time that can be spent in the continuations,
+    ///               at least one is resumed per call
+    ///
+    /// \return Number of continuations that were called
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t pump(Time budget = milliseconds(2));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of continuations waiting to be resumed
+    ///
+    /// \return Number of pending continuations
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getPendingCount();
+};
+
+} // namespace sf
+
+
+#endif // SFML_ASYNCQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AsyncQueue
+/// \ingroup graphics
+///
+/// The asynchronous operations of SFML (texture uploads,
+/// shader compilations, pixel readbacks, resource loads) are
+/// identified by tokens that must be polled. sf::AsyncQueue
+/// gathers the polling in a single place: the application
+/// posts what to do when an operation is done, and calls pump
+/// once per frame where the results can be used. pump spends
+/// at most its time budget in the continuations, so that many
+/// completions in the same frame don't cause a spike.
+///
+/// With C++20, the awaitables of SFML/Graphics/Awaitable.hpp
+/// are built on top of it, so that coroutines are resumed by
+/// pump too.
+///
+/// Usage example:
+/// \code
+/// sf::Uint64 token = window.readPixelsAsync(sf::IntRect(0, 0, 256, 256));
+/// sf::AsyncQueue::post([token]() {return sf::RenderTarget::collectPixels(token, screenshot);},
+///                      []() {screenshot.saveToFile("screenshot.png");});
+///
+/// // once per frame
+/// sf::AsyncQueue::pump(sf::milliseconds(2));
+/// \endcode
+///
+/// \see sf::ResourceLoader
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_AWAITABLE_HPP
+#define SFML_AWAITABLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/AsyncQueue.hpp>
+
+// The awaitables need the C++20 coroutines, the rest of SFML only needs C++11
+#if defined(__cpp_impl_coroutine) && (__cpp_impl_coroutine >= 201902L)
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/ResourceLoader.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Coroutine started right away and never awaited
+///
+/// A function returning sf::AsyncTask can use co_await on the
+/// awaitables of this header. Its frame is destroyed when it
+/// returns.
+///
+////////////////////////////////////////////////////////////
+class AsyncTask
+{
+public:
+
+    struct promise_type
+    {
+        AsyncTask get_return_object() {return AsyncTask();}
+        std::suspend_never initial_suspend() noexcept {return std::suspend_never();}
+        std::suspend_never final_suspend() noexcept {return std::suspend_never();}
+        void return_void() {}
+        void unhandled_exception() {std::terminate();}
+    };
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Awaitable resumed by AsyncQueue::pump once a poll function returns true
+///
+////////////////////////////////////////////////////////////
+class PollAwaitable
+{
+public:
+
+    explicit PollAwaitable(AsyncQueue::Poll poll) : m_poll(std::move(poll)) {}
+
+    bool await_ready() const noexcept {return false;}
+    void await_suspend(std::coroutine_handle<> handle) {AsyncQueue::post(m_poll, [handle]() {handle.resume();});}
+    void await_resume() const noexcept {}
+
+private:
+
+    AsyncQueue::Poll m_poll; ///< Function telling whether the operation is complete
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Awaitable resumed by AsyncQueue::pump with the pixels of a readback
+///
+////////////////////////////////////////////////////////////
+class PixelsAwaitable
+{
+public:
+
+    explicit PixelsAwaitable(Uint64 token) : m_token(token), m_image(), m_success(false) {}
+
+    bool await_ready() const noexcept {return m_token == 0;}
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        AsyncQueue::post([this]() {return m_success = RenderTarget::collectPixels(m_token, m_image);}, [handle]() {handle.resume();});
+    }
+    Image await_resume() {return std::move(m_image);}
+
+private:
+
+    Uint64 m_token;   ///< Token of the readback
+    Image  m_image;   ///< Pixels of the readback
+    bool   m_success; ///< Were the pixels retrieved?
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Awaitable resumed by AsyncQueue::pump once a texture is loaded
+///
+////////////////////////////////////////////////////////////
+class TextureLoadAwaitable
+{
+public:
+
+    TextureLoadAwaitable(Texture& texture, const void* data, std::size_t size) : m_texture(texture), m_data(data), m_size(size), m_handle(), m_success(false) {}
+
+    bool await_ready() const noexcept {return false;}
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        m_handle = handle;
+        m_texture.loadFromMemoryAsync(m_data, m_size, &TextureLoadAwaitable::loaded, this);
+    }
+    bool await_resume() const noexcept {return m_success;}
+
+private:
+
+    // The callback may be called before loadFromMemoryAsync returns, the coroutine is resumed by the next pump
+    static void loaded(Texture&, bool success, void* userData)
+    {
+        TextureLoadAwaitable* awaitable = static_cast<TextureLoadAwaitable*>(userData);
+        awaitable->m_success = success;
+
+        std::coroutine_handle<> handle = awaitable->m_handle;
+        AsyncQueue::post([handle]() {handle.resume();});
+    }
+
+    Texture&                m_texture; ///< Texture to load
+    const void*             m_data;    ///< File data in memory
+    std::size_t             m_size;    ///< Size of the file data, in bytes
+    std::coroutine_handle<> m_handle;  ///< Coroutine waiting for the texture
+    bool                    m_success; ///< Was the texture loaded?
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Wait until the next AsyncQueue::pump
+///
+/// Resuming the rest of a coroutine at the next pump moves it
+/// to the render thread, for example after a job.
+///
+////////////////////////////////////////////////////////////
+inline PollAwaitable nextPump()
+{
+    return PollAwaitable(AsyncQueue::Poll());
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Wait until an asynchronous texture update has completed on the GPU
+///
+/// \param token Token returned by Texture::updateAsync
+///
+////////////////////////////////////////////////////////////
+inline PollAwaitable awaitUpload(Uint64 token)
+{
+    return PollAwaitable([token]() {return Texture::isUploadComplete(token);});
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Wait until a shader compiled asynchronously is ready
+///
+/// \param shader Shader loaded with loadFromMemoryAsync, which must outlive the wait
+///
+////////////////////////////////////////////////////////////
+inline PollAwaitable awaitShader(const Shader& shader)
+{
+    return PollAwaitable([&shader]() {return shader.isReady();});
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Wait until a load of a resource loader is finished
+///
+/// ResourceLoader::update must still be called each frame.
+/// The awaited expression doesn't give the status, call
+/// ResourceLoader::getStatus after it.
+///
+/// \param loader Loader of the resource, which must outlive the wait
+/// \param token  Token returned by one of the load functions
+///
+////////////////////////////////////////////////////////////
+inline PollAwaitable awaitLoad(const ResourceLoader& loader, Uint64 token)
+{
+    return PollAwaitable([&loader, token]() {return loader.getStatus(token) != ResourceLoader::Pending;});
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Wait for the pixels of an asynchronous readback
+///
+/// The awaited expression gives the pixels, or an empty image
+/// if \a token is 0.
+///
+/// \param token Token returned by RenderTarget::readPixelsAsync
+///
+////////////////////////////////////////////////////////////
+inline PixelsAwaitable awaitPixels(Uint64 token)
+{
+    return PixelsAwaitable(token);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Load a texture without blocking and wait for it
+///
+/// The awaited expression tells whether the texture was
+/// loaded. See Texture::loadFromMemoryAsync.
+///
+/// \param texture Texture to load, which must outlive the wait
+/// \param data    File data in memory, valid until the wait is over
+/// \param size    Size of the file data, in bytes
+///
+////////////////////////////////////////////////////////////
+inline TextureLoadAwaitable loadTextureAsync(Texture& texture, const void* data, std::size_t size)
+{
+    return TextureLoadAwaitable(texture, data, size);
+}
+
+} // namespace sf
+
+#endif // __cpp_impl_coroutine
+
+
+#endif // SFML_AWAITABLE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \file Awaitable.hpp
+/// \ingroup graphics
+///
+/// Awaitables for the asynchronous operations of SFML, for
+/// the applications built with C++20 coroutines. A coroutine
+/// suspended on one of them is resumed by sf::AsyncQueue::pump,
+/// on the render thread, at the point of the frame where pump
+/// is called and within its time budget.
+///
+/// Usage example:
+/// \code
+/// sf::AsyncTask loadLevel(sf::Texture& background, const std::vector<char>& file)
+/// {
+///     if (!co_await sf::loadTextureAsync(background, file.data(), file.size()))
+///         co_return;
+///
+///     sf::Image pixels = co_await sf::awaitPixels(renderTexture.readPixelsAsync(area));
+///     ...
+/// }
+///
+/// // once per frame
+/// sf::AsyncQueue::pump(sf::milliseconds(2));
+/// \endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_BITMAPFONTFORMAT_HPP
+#define SFML_BITMAPFONTFORMAT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Contents of a BMFont (AngelCode) descriptor
+///
+////////////////////////////////////////////////////////////
+struct BitmapFontDescriptor
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Glyph of the font, drawn on one of the pages
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Char
+    {
+        Uint32       id;       ///< Unicode code point
+        int          x;        ///< Left of the glyph on its page, in pixels
+        int          y;        ///< Top of the glyph on its page, in pixels
+        int          width;    ///< Width of the glyph, in pixels
+        int          height;   ///< Height of the glyph, in pixels
+        int          xOffset;  ///< Offset from the pen to the left of the glyph
+        int          yOffset;  ///< Offset from the top of the line to the top of the glyph
+        int          xAdvance; ///< Distance to the pen position of the next glyph
+        unsigned int page;     ///< Index of the page holding the glyph
+        unsigned int channels; ///< Channels holding the glyph (1 blue, 2 green, 4 red, 8 alpha, 15 all)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extra offset between two glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    struct KerningPair
+    {
+        Uint32 first;  ///< Code point of the first character
+        Uint32 second; ///< Code point of the second character
+        int    amount; ///< Offset of the second character, in pixels
+    };
+
+    std::string              face;         ///< Name of the font face
+    int                      size;         ///< Character size the font was drawn at, in pixels
+    int                      lineHeight;   ///< Distance between two lines, in pixels
+    int                      base;         ///< Distance from the top of a line to the baseline
+    unsigned int             alphaChannel; ///< Contents of the alpha channel (0 glyph, 1 outline, 2 both, 3 zero, 4 one)
+    std::vector<std::string> pages;        ///< File names of the pages, by index
+    std::vector<Char>        chars;        ///< Glyphs of the font
+    std::vector<KerningPair> kerning;      ///< Kerning pairs of the font
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Parse a BMFont descriptor
+///
+/// Both the text and the binary (version 3) formats are
+/// supported.
+///
+/// \param data       Pointer to the descriptor data
+/// \param dataSize   Size of the data, in bytes
+/// \param descriptor Receives the contents of the descriptor
+/// \param error      Receives the failure reason
+///
+/// \return True if the descriptor was parsed
+///
+////////////////////////////////////////////////////////////
+bool parseBitmapFont(const void* data, std::size_t dataSize, BitmapFontDescriptor& descriptor, const char*& error);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_BITMAPFONTFORMAT_HPP
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
+#include <SFML/Config.hpp>
 
 
 namespace sf
@@ -111,6 +112,18 @@ struct SFML_GRAPHICS_API BlendMode
               Equation colorBlendEquation, Factor alphaSourceFactor,
               Factor alphaDestinationFactor, Equation alphaBlendEquation);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pack the factors and equations in a single integer
+    ///
+    /// Each factor takes 4 bits and each equation 3 bits, so
+    /// the key fits in the 22 low bits. Two blend modes are
+    /// equal if and only if their keys are equal.
+    ///
+    /// \return Packed blend mode
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getKey() const;
+
     ////////////////////////////////////////////////////////////
     // Member Data
     ////////////////////////////////////////////////////////////
@@ -149,10 +162,11 @@ SFML_GRAPHICS_API bool operator !=(const BlendMode& left, const BlendMode& right
 ////////////////////////////////////////////////////////////
 // Commonly used blending modes
 ////////////////////////////////////////////////////////////
-SFML_GRAPHICS_API extern const BlendMode BlendAlpha;    ///< Blend source and dest according to dest alpha
-SFML_GRAPHICS_API extern const BlendMode BlendAdd;      ///< Add source to dest
-SFML_GRAPHICS_API extern const BlendMode BlendMultiply; ///< Multiply source and dest
-SFML_GRAPHICS_API extern const BlendMode BlendNone;     ///< Overwrite dest with source
+SFML_GRAPHICS_API extern const BlendMode BlendAlpha;              ///< Blend source and dest according to dest alpha
+SFML_GRAPHICS_API extern const BlendMode BlendAdd;                ///< Add source to dest
+SFML_GRAPHICS_API extern const BlendMode BlendMultiply;           ///< Multiply source and dest
+SFML_GRAPHICS_API extern const BlendMode BlendNone;               ///< Overwrite dest with source
+SFML_GRAPHICS_API extern const BlendMode BlendPremultipliedAlpha; ///< Blend a source whose colors are already multiplied by its alpha
 
 } // namespace sf
 
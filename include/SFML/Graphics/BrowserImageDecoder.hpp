@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_BROWSERIMAGEDECODER_HPP
+#define SFML_BROWSERIMAGEDECODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Function preparing the texture of a decoded image
+///
+/// It must create a texture of at least \a width x \a height
+/// pixels and bind it (through the OpenGL state cache) to the
+/// active texture unit; the pixels are then uploaded to its
+/// top-left corner.
+///
+/// \param width    Width of the decoded image
+/// \param height   Height of the decoded image
+/// \param userData User data given to decodeImageInBrowser
+///
+/// \return False to cancel the upload
+///
+////////////////////////////////////////////////////////////
+typedef bool (*BrowserImageStorage)(unsigned int width, unsigned int height, void* userData);
+
+////////////////////////////////////////////////////////////
+/// \brief Function called when a browser decode is finished
+///
+/// \param success  True if the pixels were uploaded
+/// \param userData User data given to decodeImageInBrowser
+///
+////////////////////////////////////////////////////////////
+typedef void (*BrowserImageDone)(bool success, void* userData);
+
+////////////////////////////////////////////////////////////
+/// \brief Decode an image file with the decoders of the browser
+///
+/// The encoded bytes are copied and given to createImageBitmap,
+/// which decodes them off the main thread. When the bitmap is
+/// ready, in a later iteration of the browser event loop,
+/// \a storage is called and the bitmap is uploaded with
+/// texSubImage2D, then \a done is called. \a done is also
+/// called, with false, if the browser can't decode the file.
+///
+/// The OpenGL context must be current when the callbacks run.
+///
+/// \param data        Pointer to the file data in memory
+/// \param size        Size of the data, in bytes
+/// \param premultiply Premultiply the colors by their alpha?
+/// \param storage     Function preparing the texture
+/// \param done        Function called at the end of the decode
+/// \param userData    User data passed to the callbacks
+///
+/// \return False if the decode couldn't be started (not a
+///         browser, or no createImageBitmap): no callback is
+///         called then
+///
+////////////////////////////////////////////////////////////
+bool decodeImageInBrowser(const void* data, std::size_t size, bool premultiply,
+                          BrowserImageStorage storage, BrowserImageDone done, void* userData);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_BROWSERIMAGEDECODER_HPP
@@ -0,0 +1,278 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CACHEDLAYER_HPP
+#define SFML_CACHEDLAYER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Drawables rendered once to a texture, then drawn as a single sprite
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API CachedLayer : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty layer, create must be called before
+    /// it can be drawn.
+    ///
+    ////////////////////////////////////////////////////////////
+    CachedLayer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture of the layer
+    ///
+    /// The layer covers the area (0, 0, width, height) of its
+    /// local coordinates, the drawables outside of it are cut.
+    /// The texture has \a resolutionScale pixels per unit, use
+    /// the scale factor of the display on HiDPI screens (the
+    /// texture is smoothed when the scale isn't 1).
+    ///
+    /// \param width           Width of the layer, in local units
+    /// \param height          Height of the layer, in local units
+    /// \param resolutionScale Number of pixels of the texture per local unit
+    ///
+    /// \return True if the texture was created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, float resolutionScale = 1.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the layer, in local units
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of pixels of the texture per local unit
+    ///
+    ////////////////////////////////////////////////////////////
+    float getResolutionScale() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a drawable to the layer
+    ///
+    /// The drawables are rendered in the order they are added,
+    /// with their own render states in the local coordinates of
+    /// the layer. They are not copied, they must remain alive
+    /// as long as the layer uses them.
+    ///
+    /// \param drawable Drawable to add
+    /// \param states   Render states to draw it with
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Drawable& drawable, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a drawable to the layer, and watch its transform
+    ///
+    /// Same as the overload above, and the drawables are
+    /// rendered again whenever the transform of \a transformable
+    /// changes. It is usually the drawable itself, for example
+    /// a sf::Text or a sf::Shape.
+    ///
+    /// \param drawable      Drawable to add
+    /// \param transformable Transform to watch
+    /// \param states        Render states to draw it with
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Drawable& drawable, const Transformable& transformable, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the drawables of the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of drawables of the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getDrawableCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the color the texture is cleared with before rendering
+    ///
+    /// The default color is transparent.
+    ///
+    ////////////////////////////////////////////////////////////
+    void setClearColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color the texture is cleared with before rendering
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getClearColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the drawables again at the next draw
+    ///
+    /// Call this after changing a drawable in a way the layer
+    /// can't observe (see isOutdated), such as the string of a
+    /// sf::Text or the color of a shape.
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the next draw renders the drawables again
+    ///
+    /// Besides explicit invalidations and changes of the
+    /// drawables of the layer, the layer watches the transforms
+    /// given to add, and the contents of the textures of the
+    /// render states of the drawables.
+    ///
+    /// \return True if the texture is outdated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isOutdated() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of the layer
+    ///
+    /// The texture holds the drawables as of the last draw,
+    /// with colors premultiplied by their alpha.
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of times the drawables were rendered
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getRenderCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Drawable of the layer, and what it was rendered from
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Child
+    {
+        const Drawable*      drawable;         ///< Drawable to render
+        RenderStates         states;           ///< Render states to render it with
+        const Transformable* transformable;    ///< Transform to watch (NULL for none)
+        Uint32               transformVersion; ///< Version of the transform when it was last rendered
+        Uint64               textureContent;   ///< Content id of the texture when it was last rendered
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the drawables to the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void render() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the layer to a render target
+    ///
+    /// The drawables are rendered first if the texture is
+    /// outdated.
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable RenderTexture      m_renderTexture; ///< Texture the drawables are rendered to
+    Vector2u                   m_size;          ///< Size of the layer, in local units
+    float                      m_scale;         ///< Number of pixels per local unit
+    Color                      m_clearColor;    ///< Color of the background of the texture
+    mutable std::vector<Child> m_children;      ///< Drawables of the layer
+    mutable bool               m_invalidated;   ///< Must the drawables be rendered again?
+    mutable Uint64             m_renderCount;   ///< Number of renders of the drawables
+};
+
+} // namespace sf
+
+
+#endif // SFML_CACHEDLAYER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CachedLayer
+/// \ingroup graphics
+///
+/// Panels of a user interface are made of many texts with
+/// outlines, shapes and nine-slice sprites, which cost
+/// hundreds of vertices and dozens of draw calls every frame
+/// even though they rarely change. sf::CachedLayer renders
+/// such a group of drawables once to a texture, and then
+/// draws it as a single textured quad until it is outdated.
+///
+/// The layer re-renders its drawables when it is explicitly
+/// invalidated, when drawables are added or removed, when
+/// a transform it watches changes and when the texture of the
+/// render states of one of its drawables is modified. Other
+/// changes, such as a new string of a sf::Text, must be
+/// followed by a call to invalidate.
+///
+/// The layer itself is transformable: moving it doesn't
+/// render its drawables again. Colors are rendered
+/// premultiplied by their alpha, so that semi-transparent
+/// drawables and anti-aliased edges are composited like they
+/// would be drawn directly; the layer is drawn with
+/// sf::BlendPremultipliedAlpha when it is drawn with
+/// sf::BlendAlpha. The storage of the texture comes from the
+/// pool of texture storages, like other render textures.
+///
+/// Usage example:
+/// \code
+/// sf::CachedLayer panel;
+/// panel.create(300, 200, 2.f); // two pixels per unit on a HiDPI screen
+/// panel.add(background);
+/// panel.add(title, title); // re-rendered when the title moves
+/// panel.add(okButton);
+/// panel.setPosition(20, 20);
+///
+/// // each frame: a single quad, unless something changed
+/// title.setString("Score: " + score);
+/// panel.invalidate();
+/// window.draw(panel);
+/// \endcode
+///
+/// \see sf::RenderTexture, sf::Sprite
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CANVAS_HPP
+#define SFML_CANVAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/String.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Font;
+class RenderTarget;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Immediate-mode drawing of simple primitives
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API Canvas : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a canvas drawing to a render target
+    ///
+    /// \param target Render target to draw to
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Canvas(RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The pending primitives are submitted to the target.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Canvas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the blend mode of the next primitives
+    ///
+    /// The blend mode is sf::BlendAlpha by default.
+    ///
+    /// \param blendMode New blend mode
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBlendMode(const BlendMode& blendMode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a filled rectangle
+    ///
+    /// \param rectangle Rectangle to fill, in world coordinates
+    /// \param color     Color of the rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    void fillRect(const FloatRect& rectangle, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a line segment
+    ///
+    /// \param start     First end of the segment, in world coordinates
+    /// \param end       Second end of the segment, in world coordinates
+    /// \param color     Color of the line
+    /// \param thickness Width of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    void line(const Vector2f& start, const Vector2f& end, const Color& color, float thickness = 1.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a filled circle
+    ///
+    /// The unit circle of each point count is computed once and
+    /// then only scaled and moved.
+    ///
+    /// \param center     Center of the circle, in world coordinates
+    /// \param radius     Radius of the circle
+    /// \param color      Color of the circle
+    /// \param pointCount Number of points of the outline (at least 3)
+    ///
+    ////////////////////////////////////////////////////////////
+    void circle(const Vector2f& center, float radius, const Color& color, std::size_t pointCount = 30);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a part of a texture into a rectangle
+    ///
+    /// \param texture     Texture to draw
+    /// \param rectangle   Rectangle to draw to, in world coordinates
+    /// \param textureRect Area of the texture to draw, in pixels
+    /// \param color       Color modulating the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void texturedQuad(const Texture& texture, const FloatRect& rectangle, const IntRect& textureRect, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a line of text
+    ///
+    /// The text is laid out like a regular sf::Text placed at
+    /// \a position: kerning and line breaks are applied, styles
+    /// and text shaping are not.
+    ///
+    /// \param font          Font of the text
+    /// \param string        Text to draw
+    /// \param position      Top-left corner of the text, in world coordinates
+    /// \param characterSize Character size, in pixels
+    /// \param color         Color of the text
+    ///
+    ////////////////////////////////////////////////////////////
+    void text(const Font& font, const String& string, const Vector2f& position, unsigned int characterSize = 30, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit the pending primitives to the target
+    ///
+    /// This must be called before anything else is drawn to the
+    /// target, to keep the drawing order; the destructor calls
+    /// it as well.
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve vertices for primitives using a texture
+    ///
+    /// The pending primitives are submitted first if they use
+    /// another texture.
+    ///
+    /// \param texture     Texture of the primitives (NULL for none)
+    /// \param vertexCount Number of vertices to reserve
+    ///
+    /// \return Pointer to the reserved vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    Vertex* allocate(const Texture* texture, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    RenderTarget&         m_target;     ///< Render target to draw to
+    std::vector<Vertex>   m_vertices;   ///< Pending triangles, in world coordinates
+    const Texture*        m_texture;    ///< Texture of the pending triangles
+    BlendMode             m_blendMode;  ///< Blend mode of the pending triangles
+    std::vector<Vector2f> m_unitCircle; ///< Outline of the unit circle of the last point count
+};
+
+} // namespace sf
+
+
+#endif // SFML_CANVAS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Canvas
+/// \ingroup graphics
+///
+/// Debug overlays and procedural interfaces often draw
+/// thousands of short-lived rectangles, lines, circles and
+/// labels every frame. Creating a sf::RectangleShape or a
+/// sf::Text for each of them costs allocations, tessellations
+/// and virtual calls; sf::Canvas writes their triangles
+/// directly, in world coordinates, into a vertex array that
+/// is reused from one frame to the next.
+///
+/// The triangles are submitted to the target as a single draw
+/// per run of primitives with the same texture and blend mode,
+/// so that an overlay of solid primitives costs a single draw
+/// call. Texts use the page texture of their font, mixing them
+/// with solid primitives splits the runs.
+///
+/// The primitives are drawn with the current view of the
+/// target, and are only submitted when the canvas is flushed
+/// or destroyed: flush it before drawing anything else to the
+/// target.
+///
+/// Usage example:
+/// \code
+/// sf::Canvas canvas(window);
+/// for (const NavNode& node : nodes)
+/// {
+///     canvas.circle(node.position, 4.f, sf::Color::Green, 8);
+///     for (const NavNode* link : node.links)
+///         canvas.line(node.position, link->position, sf::Color::White);
+/// }
+/// canvas.text(font, "10000 nodes", sf::Vector2f(10.f, 10.f), 14);
+/// canvas.flush();
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::DrawList
+///
+////////////////////////////////////////////////////////////
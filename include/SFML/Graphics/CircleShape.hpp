@@ -106,13 +106,22 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Vector2f getPoint(std::size_t index) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get all the points of the circle
+    ///
+    /// \param points Array that receives the getPointCount() points
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void getPoints(Vector2f* points) const;
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    float       m_radius;     ///< Radius of the circle
-    std::size_t m_pointCount; ///< Number of points composing the circle
+    float           m_radius;     ///< Radius of the circle
+    std::size_t     m_pointCount; ///< Number of points composing the circle
+    const Vector2f* m_unitCircle; ///< Shared table of the points of the unit circle, for m_pointCount
 };
 
 } // namespace sf
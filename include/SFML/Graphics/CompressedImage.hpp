@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_COMPRESSEDIMAGE_HPP
+#define SFML_COMPRESSEDIMAGE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Block-compressed image parsed from a KTX, KTX2 or DDS container
+///
+/// The levels point into the container data, which must stay
+/// alive as long as the levels are used.
+///
+////////////////////////////////////////////////////////////
+struct CompressedImage
+{
+    struct Level
+    {
+        const Uint8* data;     ///< Compressed blocks of the level
+        std::size_t  dataSize; ///< Size of the blocks, in bytes
+        Vector2u     size;     ///< Size of the level, in pixels
+    };
+
+    unsigned int       format; ///< GL_COMPRESSED_* internal format
+    bool               sRgb;   ///< Is the format an sRGB one?
+    Vector2u           size;   ///< Size of the first level, in pixels
+    std::vector<Level> levels; ///< Mip chain, from the largest level to the smallest
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Parse a KTX, KTX2 or DDS container
+///
+/// Only single 2D images (no arrays, cube maps nor volumes)
+/// with a block-compressed format are accepted: S3TC (BC1 to
+/// BC3), ETC1, ETC2/EAC and ASTC LDR. Supercompressed KTX2
+/// files (Basis Universal, zstd) are rejected.
+///
+/// \param data     Pointer to the file data in memory
+/// \param dataSize Size of the data, in bytes
+/// \param image    Receives the parsed image
+///
+/// \return True if the container was parsed successfully
+///
+////////////////////////////////////////////////////////////
+bool parseCompressedImage(const void* data, std::size_t dataSize, CompressedImage& image);
+
+////////////////////////////////////////////////////////////
+/// \brief Check whether a container starts with a KTX, KTX2 or DDS signature
+///
+////////////////////////////////////////////////////////////
+bool isCompressedImage(const void* data, std::size_t dataSize);
+
+////////////////////////////////////////////////////////////
+/// \brief Decompress a level to 32-bit RGBA pixels on the CPU
+///
+/// This is the fallback used when the driver doesn't support
+/// the format. S3TC, ETC1 and ETC2 RGB/RGBA (not the
+/// punch-through alpha variant) can be decompressed; ASTC
+/// can't.
+///
+/// \param format GL_COMPRESSED_* internal format of the level
+/// \param level  Level to decompress
+/// \param pixels Receives size.x * size.y RGBA pixels
+///
+/// \return True if the format could be decompressed
+///
+////////////////////////////////////////////////////////////
+bool decompressImage(unsigned int format, const CompressedImage::Level& level, std::vector<Uint8>& pixels);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDIMAGE_HPP
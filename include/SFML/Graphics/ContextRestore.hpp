@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CONTEXTRESTORE_HPP
+#define SFML_CONTEXTRESTORE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Recreation of the OpenGL objects after a context loss
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ContextRestore
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the tracking of the resources
+    ///
+    /// Only the resources created while the tracking is
+    /// enabled can be restored, so enable it before loading
+    /// anything. The tracking is disabled by default.
+    ///
+    /// \param enabled True to track the resources
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the resources are tracked
+    ///
+    /// \return True if the tracking is enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isEnabled();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Keep CPU-side copies of what the context would lose
+    ///
+    /// Call this function with the context that is about to be
+    /// lost still current, typically when the application
+    /// receives SDL_APP_WILLENTERBACKGROUND. The previous
+    /// copies are replaced.
+    ///
+    /// \return Size of the copies, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 retain();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recreate all the tracked objects in the current context
+    ///
+    /// Call this function with the new context current, before
+    /// anything else uses it: the names of the lost objects are
+    /// forgotten and the objects are recreated from the copies
+    /// made by retain, in one pass. The copies are released
+    /// afterwards.
+    ///
+    /// \return True if all the objects were restored
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool restore();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the copies made by retain
+    ///
+    /// Call this function when the context survived after all
+    /// (EGL_CONTEXT_LOST was not reported on resume).
+    ///
+    ////////////////////////////////////////////////////////////
+    static void discard();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the copies made by retain
+    ///
+    /// \return Size of the copies, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getRetainedSize();
+};
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Kinds of resources tracked for a context restore
+///
+////////////////////////////////////////////////////////////
+enum RestorableKind
+{
+    RestorableTexture,           ///< sf::Texture
+    RestorableFont,              ///< sf::Font
+    RestorableShader,            ///< sf::Shader
+    RestorableVertexBuffer,      ///< sf::VertexBuffer
+    RestorableVertexBufferArena, ///< sf::VertexBufferArena
+
+    RestorableKindCount          ///< Keep last -- the total number of kinds
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Track a resource, if the tracking is enabled
+///
+/// Called by the constructors of the tracked classes.
+///
+////////////////////////////////////////////////////////////
+void registerRestorable(RestorableKind kind, void* object);
+
+////////////////////////////////////////////////////////////
+/// \brief Stop tracking a resource and drop its copy
+///
+/// Called by the destructors of the tracked classes.
+///
+////////////////////////////////////////////////////////////
+void unregisterRestorable(RestorableKind kind, void* object);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_CONTEXTRESTORE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ContextRestore
+/// \ingroup graphics
+///
+/// Android destroys the EGL context of an application that
+/// goes to the background more often than not, and all the
+/// OpenGL objects with it. Reloading every asset from the
+/// APK on resume takes seconds; sf::ContextRestore keeps
+/// compact CPU-side copies of what would be lost instead,
+/// and recreates all the objects at once in the new context.
+///
+/// What retain keeps:
+/// \li the pixels of the textures, QOI-compressed; lazy
+///     textures keep their source and are uploaded again on
+///     their next draw, the glyph pages of the fonts are
+///     rebuilt from the coverage the fonts already keep
+/// \li the binaries of the linked shader programs
+///     (see Shader::setCache for the driver support)
+/// \li the vertices of the vertex buffers that have no
+///     shadow copy (see VertexBuffer::setShadowed)
+///
+/// The uniform values, texture bindings and sampling
+/// settings of the resources stay in their sf:: objects and
+/// are applied again on their next use.
+///
+/// Render textures, index buffers, uniform buffers, texture
+/// arrays, streaming and YUV textures are not tracked:
+/// destroy them before calling restore (before the new
+/// context has any object, so that deleting their dead
+/// names is harmless) and create them again afterwards.
+/// Floating-point textures come back with 8 bits per
+/// channel, compressed textures come back uncompressed.
+/// Shaders can't be restored where program binaries are
+/// not supported (WebGL), neither can the vertex buffers
+/// without a shadow copy on OpenGL ES 2 and WebGL, which
+/// can't be read back: they are reported by restore and
+/// must be loaded again.
+///
+/// Usage example:
+/// \code
+/// sf::ContextRestore::setEnabled(true);
+/// // ... load the resources ...
+///
+/// // In the SDL event filter
+/// case SDL_APP_WILLENTERBACKGROUND:
+///     sf::ContextRestore::retain();
+///     break;
+///
+/// // After creating the new context on resume
+/// if (!sf::ContextRestore::restore())
+///     reloadMissingResources();
+/// \endcode
+///
+/// \see sf::Texture, sf::Shader, sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
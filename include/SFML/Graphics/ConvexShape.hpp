@@ -90,6 +90,24 @@ public:
     ////////////////////////////////////////////////////////////
     void setPoint(std::size_t index, const Vector2f& point);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace all the points of the polygon
+    ///
+    /// Unlike calling setPoint for each point, the geometry is
+    /// rebuilt once at most. If \a updateGeometry is false, it
+    /// is not rebuilt at all and the shape must be passed to
+    /// Shape::updateMany before it is drawn; this allows to
+    /// tessellate many polygons in parallel.
+    ///
+    /// \param points         Array of \a count points
+    /// \param count          New number of points of the polygon
+    /// \param updateGeometry Rebuild the geometry of the shape now?
+    ///
+    /// \see setPoint, Shape::updateMany
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPoints(const Vector2f* points, std::size_t count, bool updateGeometry = true);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the position of a point
     ///
@@ -107,6 +125,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Vector2f getPoint(std::size_t index) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get all the points of the polygon
+    ///
+    /// \param points Array that receives the getPointCount() points
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void getPoints(Vector2f* points) const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DIRTYREGION_HPP
+#define SFML_DIRTYREGION_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+
+namespace sf
+{
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief Accumulator of the areas of a render target that must be redrawn
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API DirtyRegion
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty region.
+    ///
+    ////////////////////////////////////////////////////////////
+    DirtyRegion();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a rectangle of pixels as changed
+    ///
+    /// \param area Rectangle to add, in pixels of the target
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a rectangle of world coordinates as changed
+    ///
+    /// The rectangle is mapped to pixels with the current view
+    /// of \a target, and grown by a pixel on each side to cover
+    /// the antialiased edges.
+    ///
+    /// \param area   Rectangle to add, in world coordinates
+    /// \param target Render target that the area is drawn to
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const FloatRect& area, const RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the whole target as changed
+    ///
+    /// \param target Render target to redraw completely
+    ///
+    ////////////////////////////////////////////////////////////
+    void addAll(const RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether nothing was marked since the last clear
+    ///
+    /// \return True if the region is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isEmpty() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the marked areas
+    ///
+    /// The result can be given directly to RenderTarget::setScissor.
+    ///
+    /// \return Union of the marked rectangles, in pixels (empty if nothing was marked)
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Empty the region
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    IntRect m_bounds; ///< Union of the marked rectangles
+};
+
+} // namespace sf
+
+
+#endif // SFML_DIRTYREGION_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DirtyRegion
+/// \ingroup graphics
+///
+/// sf::DirtyRegion collects the rectangles that changed in a
+/// render target whose contents are kept from one frame to
+/// the next, like a layer of static UI in a sf::RenderTexture.
+/// Instead of redrawing the whole layer when a single widget
+/// changes, the layer is redrawn with its scissor rectangle
+/// set to the union of the changes: the clear and the draws
+/// only touch those pixels, and with culling enabled the
+/// drawables outside of it are not even submitted.
+///
+/// The region keeps a single bounding rectangle, so changes
+/// far apart from each other are cheaper to redraw in
+/// separate passes.
+///
+/// Usage example:
+/// \code
+/// sf::DirtyRegion dirty;
+/// dirty.addAll(layer);
+///
+/// // when a widget changes
+/// dirty.add(button.getGlobalBounds(), layer);
+///
+/// // once per frame
+/// if (!dirty.isEmpty())
+/// {
+///     layer.setCullingEnabled(true);
+///     layer.setScissor(dirty.getBounds());
+///     layer.clear(sf::Color::Transparent);
+///     drawWidgets(layer);
+///     layer.display();
+///     layer.setScissor(sf::IntRect());
+///     dirty.clear();
+/// }
+///
+/// window.draw(sf::Sprite(layer.getTexture()));
+/// \endcode
+///
+/// \see sf::RenderTarget::setScissor
+///
+////////////////////////////////////////////////////////////
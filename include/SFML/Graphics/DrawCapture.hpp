@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_DRAWCAPTURE_HPP
+#define SFML_DRAWCAPTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+class Shader;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Recorder of the draws submitted to a render target,
+///        for offline replay
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API DrawCapture : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The capture is closed, see openFromFile.
+    ///
+    ////////////////////////////////////////////////////////////
+    DrawCapture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The file is closed, with the pending records.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~DrawCapture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start capturing into a file
+    ///
+    /// The file is created (or overwritten) and the records are
+    /// written at the end of each frame. If \a embedTextures
+    /// is false, only the size and a hash of the textures are
+    /// recorded: the capture is much smaller and doesn't carry
+    /// the content, the replay draws with placeholder pixels.
+    ///
+    /// \param filename      Path of the file to write
+    /// \param embedTextures Store the pixels of the textures?
+    ///
+    /// \return True if the file was created
+    ///
+    /// \see close, RenderTarget::setCapture
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFromFile(const std::string& filename, bool embedTextures = true);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the pending records and close the file
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the capture is writing to a file
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isOpen() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames captured since the file was opened
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFrameCount() const;
+
+private:
+
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a clear of the target
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordClear(const RenderTarget& target, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a draw of vertices, optionally indexed
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordDraw(const RenderTarget& target, const Vertex* vertices, std::size_t vertexCount,
+                    const Uint16* indices, std::size_t indexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a draw whose vertices live in GPU buffers
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordBufferDraw(std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the end of a frame and write it to the file
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the view of the target if it changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordView(const RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the content of a texture if it changed, and get its id
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 recordTexture(const Texture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a shader if it is new, and get its id
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 recordShader(const Shader* shader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a record header, and get a pointer to its payload
+    ///
+    /// The pointer is valid until the next record is added.
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* addRecord(Uint32 type, std::size_t payloadSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief A texture known by the capture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct TextureEntry
+    {
+        Uint32 id;        ///< Id of the texture in the capture
+        Uint64 contentId; ///< Content id of the texture when it was last recorded
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief A shader known by the capture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ShaderEntry
+    {
+        Uint32 id;  ///< Id of the shader in the capture
+        Uint64 key; ///< Hash of the sources of the shader when it was recorded
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::FILE*                             m_file;          ///< File being written, NULL if closed
+    bool                                   m_embedTextures; ///< Store the pixels of the textures?
+    std::vector<Uint8>                     m_buffer;        ///< Records of the current frame
+    std::map<const Texture*, TextureEntry> m_textures;      ///< Textures recorded so far
+    std::map<const Shader*, ShaderEntry>   m_shaders;       ///< Shaders recorded so far
+    Uint32                                 m_nextId;        ///< Next texture or shader id
+    float                                  m_view[11];      ///< Last recorded view (target size, center, size, rotation, viewport)
+    bool                                   m_viewValid;     ///< Was a view recorded already?
+    std::size_t                            m_frameCount;    ///< Number of frames captured
+    Clock                                  m_frameClock;    ///< Measures the duration of the captured frames
+};
+
+} // namespace sf
+
+
+#endif // SFML_DRAWCAPTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DrawCapture
+/// \ingroup graphics
+///
+/// Performance problems often depend on the content: how many
+/// draws a scene issues, how they break batches, how big the
+/// textures are. sf::DrawCapture records the stream of draws
+/// submitted to a render target, so that it can be replayed
+/// and profiled offline, on other GPUs, without the content
+/// itself (see sf::DrawReplay and the SFML_GRAPHICS_REPLAY
+/// tool).
+///
+/// Each draw is recorded with its vertices, primitive type,
+/// transform, blend mode, texture and shader; the view is
+/// recorded when it changes, and a frame ends with each
+/// RenderTarget::endPass (thus with each display). Textures
+/// are identified by a hash of their pixels, which are read
+/// back and optionally stored when the texture is first used
+/// or its content changes. Shaders are identified by a hash
+/// of their sources, which are not stored: shaded draws are
+/// replayed with the default pipeline. Draws from vertex
+/// buffers and instanced draws are only counted.
+///
+/// Capturing reads textures back and writes every vertex, it
+/// is only meant for short recordings.
+///
+/// Usage example:
+/// \code
+/// sf::DrawCapture capture;
+/// if (capture.openFromFile("frames.sfdc"))
+///     window.setCapture(&capture);
+///
+/// // ... render some frames ...
+///
+/// window.setCapture(NULL);
+/// capture.close();
+/// \endcode
+///
+/// \see sf::DrawReplay, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_DRAWCAPTUREFORMAT_HPP
+#define SFML_DRAWCAPTUREFORMAT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/AssetBundleFormat.hpp>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <cstring>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+// Layout of a draw capture (all the values are little endian)
+//
+// Header, 8 bytes:
+//     Uint32 magic, Uint32 version
+// Then records until the end of the file, each one:
+//     Uint32 type, Uint32 payload size, payload
+// Readers skip the records whose type they don't know.
+//
+// Texture payload (the content of a texture changed or was first used):
+//     Uint32 id, Uint32 width, Uint32 height, Uint32 flags, Uint64 content hash,
+//     then width * height RGBA pixels if the pixels flag is set
+//
+// Shader payload:
+//     Uint32 id, Uint64 hash of the sources
+//
+// View payload (the view of the target changed):
+//     Uint32 target width, Uint32 target height,
+//     float center x, y, size x, y, rotation, viewport left, top, width, height
+//
+// Clear payload:
+//     Uint8 r, g, b, a
+//
+// Draw payload:
+//     Uint32 primitive type, Uint32 blend mode key, Uint32 texture id, Uint32 shader id,
+//     float transform a, b, tx, c, d, ty, Uint32 vertex count, Uint32 index count,
+//     vertex count times: float x, y, Uint8 r, g, b, a, float u, v
+//     then index count Uint16 indices
+//
+// Buffer payload (draw from GPU buffers, whose vertices can't be captured):
+//     Uint32 vertex count
+//
+// Frame payload (end of a frame, see RenderTarget::endPass):
+//     Uint64 duration of the captured frame, in microseconds
+//
+// Texture and shader ids start at 1, 0 means none.
+////////////////////////////////////////////////////////////
+const Uint32      captureMagic          = 0x43444653; // "SFDC"
+const Uint32      captureVersion        = 1;
+const std::size_t captureHeaderSize     = 8;
+const std::size_t captureRecordSize     = 8;
+const std::size_t captureTextureSize    = 24;
+const std::size_t captureShaderSize     = 12;
+const std::size_t captureViewSize       = 44;
+const std::size_t captureClearSize      = 4;
+const std::size_t captureDrawSize       = 48;
+const std::size_t captureVertexSize     = 20;
+const std::size_t captureBufferSize     = 4;
+const std::size_t captureFrameSize      = 8;
+const Uint32      captureTextureSmooth  = 1 << 0;
+const Uint32      captureTextureRepeat  = 1 << 1;
+const Uint32      captureTextureTexels  = 1 << 2; // texture coordinates in pixels, as font pages
+const Uint32      captureTextureSingle  = 1 << 3; // single channel, the pixels hold the red channel
+const Uint32      captureTexturePixels  = 1 << 4;
+
+////////////////////////////////////////////////////////////
+/// \brief Types of the records of a draw capture
+///
+////////////////////////////////////////////////////////////
+enum CaptureRecord
+{
+    CaptureTexture = 1, ///< Content of a texture
+    CaptureShader,      ///< Identity of a shader
+    CaptureView,        ///< View of the target
+    CaptureClear,       ///< Clear of the target
+    CaptureDraw,        ///< Draw of vertices, optionally indexed
+    CaptureBuffer,      ///< Draw that couldn't be captured
+    CaptureFrame        ///< End of a frame
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Read a little endian float
+///
+////////////////////////////////////////////////////////////
+inline float readCaptureFloat(const Uint8* bytes)
+{
+    Uint32 bits = readBundleUint32(bytes);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Write a little endian float
+///
+////////////////////////////////////////////////////////////
+inline void writeCaptureFloat(Uint8* bytes, float value)
+{
+    Uint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeBundleUint32(bytes, bits);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Rebuild a blend mode from its key
+///
+/// \see BlendMode::getKey
+///
+////////////////////////////////////////////////////////////
+inline BlendMode unpackBlendMode(Uint32 key)
+{
+    return BlendMode(static_cast<BlendMode::Factor>((key >> 18) & 0xF),
+                     static_cast<BlendMode::Factor>((key >> 14) & 0xF),
+                     static_cast<BlendMode::Equation>((key >> 11) & 0x7),
+                     static_cast<BlendMode::Factor>((key >> 7) & 0xF),
+                     static_cast<BlendMode::Factor>((key >> 3) & 0xF),
+                     static_cast<BlendMode::Equation>(key & 0x7));
+}
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_DRAWCAPTUREFORMAT_HPP
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_DRAWLIST_HPP
+#define SFML_DRAWLIST_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief List of draw commands that can be recorded
+///        without an OpenGL context
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API DrawList
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty draw list.
+    ///
+    ////////////////////////////////////////////////////////////
+    DrawList();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by an array of vertices
+    ///
+    /// The vertices are copied and transformed by
+    /// \a states.transform right away, so the source array
+    /// can be reused as soon as the function returns.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const Vertex* vertices, std::size_t vertexCount,
+                PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the layer of the next recorded commands
+    ///
+    /// The layer is forwarded to RenderTarget::setDrawLayer
+    /// when the list is submitted, and is used by sort.
+    ///
+    /// \param layer New layer
+    ///
+    /// \see getLayer, sort
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLayer(Uint8 layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layer of the next recorded commands
+    ///
+    /// \return Current layer
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8 getLayer() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sort the commands to minimize the state changes
+    ///
+    /// Commands are ordered by layer, then shader and texture.
+    /// The order of commands that share the same layer, shader
+    /// and texture is preserved. This function can be
+    /// called from the recording thread, so that the render
+    /// thread only has to submit the list.
+    ///
+    ////////////////////////////////////////////////////////////
+    void sort();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the commands, keeping the allocated memory
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve memory for a number of vertices
+    ///
+    /// \param vertexCount Number of vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of recorded commands
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCommandCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total number of recorded vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVertexCount() const;
+
+private:
+
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recorded draw command
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        Uint64              key;         ///< Sort key: layer, shader, texture
+        Uint8               layer;       ///< Layer of the command
+        std::size_t         firstVertex; ///< First vertex in the arena
+        std::size_t         vertexCount; ///< Number of vertices
+        PrimitiveType       type;        ///< Type of primitives
+        BlendMode           blendMode;   ///< Blending mode
+        const Texture*      texture;     ///< Texture
+        const Shader*       shader;      ///< Shader
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Command> m_commands; ///< Recorded commands
+    std::vector<Vertex>  m_vertices; ///< Arena of pre-transformed vertices
+    Uint8                m_layer;    ///< Layer of the next commands
+};
+
+} // namespace sf
+
+
+#endif // SFML_DRAWLIST_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DrawList
+/// \ingroup graphics
+///
+/// sf::DrawList records draw commands in memory without
+/// touching OpenGL, so that the geometry of a scene can be
+/// built by worker threads. A draw list is not shared: each
+/// thread fills its own list, which owns its vertex arena, so
+/// no lock is ever taken. The lists are then submitted by the
+/// rendering thread with RenderTarget::draw.
+///
+/// The vertices are transformed when they are recorded, so
+/// the submission only copies them to the batcher. Shaders
+/// and textures are only referenced: they must still exist,
+/// and shader uniforms are the ones set at submission time.
+///
+/// Usage example:
+/// \code
+/// // worker thread
+/// list.clear();
+/// for (const Entity& entity : entities)
+///     list.append(entity.vertices, 4, sf::TriangleStrip, entity.states);
+/// list.sort();
+///
+/// // render thread, once the worker is done
+/// window.draw(list);
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
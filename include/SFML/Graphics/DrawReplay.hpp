@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_DRAWREPLAY_HPP
+#define SFML_DRAWREPLAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Player of the draws recorded by sf::DrawCapture
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API DrawReplay : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Counters of a captured frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct FrameInfo
+    {
+        Time        capturedTime;   ///< Duration of the frame when it was captured
+        std::size_t draws;          ///< Number of replayed draws
+        std::size_t vertices;       ///< Number of replayed vertices
+        std::size_t shadedDraws;    ///< Number of draws that used a custom shader, replayed without it
+        std::size_t skippedDraws;   ///< Number of draws from GPU buffers, which can't be replayed
+        std::size_t textureUploads; ///< Number of textures created or updated by the frame
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty replay.
+    ///
+    ////////////////////////////////////////////////////////////
+    DrawReplay();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~DrawReplay();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a capture written by sf::DrawCapture
+    ///
+    /// The whole file is loaded and split into frames; the
+    /// textures are created when the frames are replayed.
+    ///
+    /// \param filename Path of the capture to load
+    ///
+    /// \return True if the file is a valid capture
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of complete frames in the capture
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFrameCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the target the capture was made on
+    ///
+    /// \return Size of the target when the first view was recorded
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getTargetSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counters of a frame
+    ///
+    /// \param frame Index of the frame
+    ///
+    ////////////////////////////////////////////////////////////
+    const FrameInfo& getFrameInfo(std::size_t frame) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replay the draws of a frame on a target
+    ///
+    /// The views, clears, texture updates and draws of the
+    /// frame are issued in their captured order; the frame
+    /// isn't displayed. Textures are created by the first
+    /// frame that uses them, so the frames must be replayed
+    /// in order at least once.
+    ///
+    /// \param frame  Index of the frame
+    /// \param target Target to draw to
+    ///
+    /// \return True if the frame was replayed, false if it is out of range or corrupt
+    ///
+    ////////////////////////////////////////////////////////////
+    bool replayFrame(std::size_t frame, RenderTarget& target);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Records of a frame in the capture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Frame
+    {
+        std::size_t begin; ///< Offset of the first record of the frame
+        std::size_t end;   ///< Offset past the frame record
+        FrameInfo   info;  ///< Counters of the frame
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create or update a texture from its record
+    ///
+    ////////////////////////////////////////////////////////////
+    bool replayTexture(const Uint8* payload, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Issue a draw from its record
+    ///
+    ////////////////////////////////////////////////////////////
+    bool replayDraw(const Uint8* payload, std::size_t size, RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Uint8>         m_data;       ///< Contents of the capture file
+    std::vector<Frame>         m_frames;     ///< Complete frames of the capture
+    Vector2u                   m_targetSize; ///< Size of the captured target
+    std::map<Uint32, Texture*> m_textures;   ///< Textures created by the replay, by id
+    std::vector<Vertex>        m_vertices;   ///< Decoded vertices of the current draw
+    std::vector<Uint16>        m_indices;    ///< Decoded indices of the current draw
+};
+
+} // namespace sf
+
+
+#endif // SFML_DRAWREPLAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DrawReplay
+/// \ingroup graphics
+///
+/// sf::DrawReplay reads a capture written by sf::DrawCapture
+/// and issues its draws again, on any render target, so that
+/// the frames of an application can be profiled without the
+/// application or its content. The SFML_GRAPHICS_REPLAY tool
+/// times the frames of a capture with it.
+///
+/// Textures whose pixels weren't stored in the capture are
+/// replaced by placeholders of the same size; draws with a
+/// custom shader are replayed with the default pipeline, and
+/// draws from vertex buffers or instanced draws are counted
+/// but not replayed (see FrameInfo).
+///
+/// Usage example:
+/// \code
+/// sf::DrawReplay replay;
+/// if (!replay.loadFromFile("frames.sfdc"))
+///     return -1;
+///
+/// for (std::size_t i = 0; i < replay.getFrameCount(); ++i)
+/// {
+///     replay.replayFrame(i, window);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::DrawCapture
+///
+////////////////////////////////////////////////////////////
@@ -29,12 +29,14 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
 
 
 namespace sf
 {
 class RenderTarget;
+class SceneGrid;
 
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for objects that can be drawn
@@ -54,6 +56,7 @@ public:
 protected:
 
     friend class RenderTarget;
+    friend class SceneGrid;
 
     ////////////////////////////////////////////////////////////
     /// \brief Draw the object to a render target
@@ -67,6 +70,27 @@ protected:
     ///
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the object
+    ///
+    /// Render targets with culling enabled skip the objects
+    /// whose bounds, transformed by the render states, are
+    /// entirely outside the current view. The default
+    /// implementation returns false, so that the object is
+    /// never culled.
+    ///
+    /// \param bounds Receives the bounding rectangle of what draw renders,
+    ///               in the coordinate system of the render states
+    ///
+    /// \return True if the bounds are known, false if the object must always be drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const
+    {
+        (void)bounds;
+        return false;
+    }
 };
 
 } // namespace sf
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DYNAMICATLAS_HPP
+#define SFML_DYNAMICATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+
+namespace sf
+{
+class Texture;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Forget the copy of a texture in the dynamic atlas
+///
+/// Called when the texture is destroyed; the room of its copy
+/// is reused once all the copies of its page are released.
+/// It doesn't make any OpenGL call.
+///
+/// \see getAtlasPage
+///
+////////////////////////////////////////////////////////////
+void releaseAtlasEntry(const Texture& texture);
+
+////////////////////////////////////////////////////////////
+/// \brief Destroy the pages of the dynamic atlas
+///
+/// The textures that are drawn again are copied to new pages.
+///
+/// \see Texture::setDynamicAtlasThreshold
+///
+////////////////////////////////////////////////////////////
+void releaseAtlasPages();
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_DYNAMICATLAS_HPP
@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DYNAMICRESOLUTION_HPP
+#define SFML_DYNAMICRESOLUTION_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+class RenderTarget;
+class RenderTexture;
+class RenderTexturePool;
+class View;
+
+////////////////////////////////////////////////////////////
+/// \brief Offscreen rendering at a resolution that follows the GPU load
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API DynamicResolution : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the helper on top of a render texture pool
+    ///
+    /// The scale range is [0.5 .. 1] in 6 levels, and the
+    /// target frame time is 1/60 second.
+    ///
+    /// \param pool Pool of the offscreen render textures, which must exist as long as the helper uses it
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit DynamicResolution(RenderTexturePool& pool);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the GPU time the scale is adjusted for
+    ///
+    /// \param time GPU time of the frame to stay below
+    ///
+    /// \see update
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTargetFrameTime(Time time);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the range and the quantization of the scale
+    ///
+    /// The scale only takes \a levels evenly spaced values
+    /// between \a minimum and \a maximum, so that the offscreen
+    /// targets only come in a few sizes that the pool keeps
+    /// around, instead of creating a new frame buffer object
+    /// each time the scale changes. The scale is reset to
+    /// \a maximum.
+    ///
+    /// \param minimum Smallest scale, in (0 .. 1]
+    /// \param maximum Largest scale, in [minimum .. 1]
+    /// \param levels  Number of scales, at least 2
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScaleRange(float minimum, float maximum, unsigned int levels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Adjust the scale from the GPU time of a frame
+    ///
+    /// Call this function once per frame, with the GPU time of
+    /// the work rendered at the dynamic resolution (typically a
+    /// result of sf::GpuProfiler). The time is smoothed over a
+    /// few frames. The scale goes down as soon as the average
+    /// is above the target, by as many levels as the fill rate
+    /// requires, and goes up one level at a time when the
+    /// predicted time of the next level fits the target with
+    /// some headroom.
+    ///
+    /// \param gpuTime GPU time of the last measured frame
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time gpuTime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current scale of the resolution
+    ///
+    /// \return Ratio between the offscreen size and the native size
+    ///
+    ////////////////////////////////////////////////////////////
+    float getScale() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Begin rendering at the dynamic resolution
+    ///
+    /// A render texture of the current scale of the viewport
+    /// of \a view in \a output is acquired from the pool. Its
+    /// view is \a view, with a viewport covering the whole
+    /// render texture, so the scene is drawn with the same
+    /// coordinates as it would be in \a output. The contents
+    /// of the render texture are undefined: clear it, or begin
+    /// a pass that draws over all of it.
+    ///
+    /// \param output Target the frame is finally displayed on
+    /// \param view   View of the scene in \a output
+    ///
+    /// \return Render texture to draw the scene to, or NULL if it couldn't be created
+    ///
+    /// \see end
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexture* begin(const RenderTarget& output, const View& view);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upscale the scene to its viewport in the output target
+    ///
+    /// The render texture returned by begin is displayed and
+    /// drawn, smoothed, over the viewport of the view given to
+    /// begin. The view of \a output is preserved, so that the
+    /// user interface can be drawn at the native resolution
+    /// afterwards.
+    ///
+    /// \param output Target given to begin
+    ///
+    /// \see begin
+    ///
+    ////////////////////////////////////////////////////////////
+    void end(RenderTarget& output);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the scale of a level
+    ///
+    ////////////////////////////////////////////////////////////
+    float getLevelScale(unsigned int level) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    RenderTexturePool* m_pool;            ///< Pool of the offscreen render textures
+    RenderTexture*     m_target;          ///< Render texture acquired by begin
+    IntRect            m_area;            ///< Viewport of the scene in the output target, in pixels
+    Time               m_targetTime;      ///< GPU time to stay below
+    float              m_minScale;        ///< Smallest scale
+    float              m_maxScale;        ///< Largest scale
+    unsigned int       m_levelCount;      ///< Number of scales
+    unsigned int       m_level;           ///< Current scale level (m_levelCount - 1 is the largest)
+    float              m_averageTime;     ///< Smoothed GPU time, in seconds (negative if unknown)
+    unsigned int       m_stableFrames;    ///< Number of updates since the last change of scale
+};
+
+} // namespace sf
+
+
+#endif // SFML_DYNAMICRESOLUTION_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DynamicResolution
+/// \ingroup graphics
+///
+/// Fill-rate bound scenes get slower with the size of the
+/// screen, not with their contents, so a constant frame rate
+/// on weak GPUs means lowering the resolution. Doing it for
+/// the whole window blurs the user interface as well, and
+/// most of the time the GPU can afford the native resolution.
+///
+/// sf::DynamicResolution renders the scene to an offscreen
+/// render texture whose size follows the measured GPU time,
+/// in a few quantized steps, then upscales it to the window.
+/// The render textures come from a sf::RenderTexturePool, so
+/// changing the scale back and forth reuses the same frame
+/// buffer objects.
+///
+/// Usage example:
+/// \code
+/// sf::RenderTexturePool pool;
+/// sf::DynamicResolution resolution(pool);
+/// sf::GpuProfiler profiler;
+/// profiler.setActive(true);
+///
+/// // Every frame
+/// sf::RenderTexture* scene = resolution.begin(window, worldView);
+/// if (scene)
+/// {
+///     sf::GpuProfiler::Scope scope("world");
+///     scene->clear();
+///     drawWorld(*scene);
+/// }
+/// resolution.end(window);
+///
+/// drawUi(window); // native resolution
+/// window.display();
+///
+/// profiler.frame();
+/// for (const sf::GpuProfiler::Result& result : profiler.getResults())
+///     if (result.name == "world")
+///         resolution.update(result.time);
+///
+/// pool.endFrame();
+/// \endcode
+///
+/// \see sf::RenderTexturePool, sf::GpuProfiler
+///
+////////////////////////////////////////////////////////////
@@ -30,18 +30,34 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Glyph.hpp>
+#include <SFML/Graphics/GlyphTable.hpp>
+#include <SFML/Graphics/MemoryStats.hpp>
+#include <SFML/Graphics/SkylinePacker.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/ShapedRun.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Time.hpp>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 
 namespace sf
 {
 class InputStream;
+class Image;
+class FontCollection;
+
+namespace priv
+{
+    class FontMetrics;
+    class GlyphRasterizer;
+    struct GlyphBitmap;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Class for loading and manipulating character fonts
@@ -60,6 +76,46 @@ public:
         std::string family; ///< The font family
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Counters of the work done by a font to lay out and render text
+    ///
+    /// The counters accumulate from the loading of the font
+    /// until resetStats is called. The page fields describe
+    /// the current state of the glyph pages instead.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Stats
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// All the counters are set to 0.
+        ///
+        ////////////////////////////////////////////////////////////
+        Stats();
+
+        Uint64       glyphCacheHits;    ///< Number of glyph lookups found in the cache
+        Uint64       glyphCacheMisses;  ///< Number of glyph lookups that had to load the glyph (or request it from the background loader)
+        Uint64       glyphsRasterized;  ///< Number of glyphs rasterized by FreeType on the calling threads
+        Time         rasterizationTime; ///< Time spent by FreeType rasterizing these glyphs
+        Uint64       kerningLookups;    ///< Number of calls to getKerning
+        Uint64       kerningLoads;      ///< Number of kerning pairs that had to be read from the face
+        Uint32       pageGrowths;       ///< Number of times a page texture was enlarged to make room for new glyphs
+        Uint32       pageRepacks;       ///< Number of times a full page was rebuilt without its unused glyphs
+        unsigned int pageCount;         ///< Current number of glyph pages (textures)
+        Uint64       pagePixels;        ///< Current total area of the pages, in pixels
+        Uint64       glyphPixels;       ///< Current area of the pages covered by the loaded glyphs, in pixels
+        Uint64       textRebuilds;      ///< Number of times a text rebuilt its geometry because its string or style changed
+        Uint64       textRelayouts;     ///< Number of times a text rebuilt its geometry because its glyphs changed in the font (background loads, repacks)
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef void* (*AllocateCallback)(std::size_t size, void* userData);                                     ///< Allocate a block of memory
+    typedef void* (*ReallocateCallback)(void* block, std::size_t oldSize, std::size_t newSize, void* userData); ///< Resize a block of memory
+    typedef void  (*DeallocateCallback)(void* block, void* userData);                                        ///< Free a block of memory
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -78,6 +134,18 @@ public:
     ////////////////////////////////////////////////////////////
     Font(const Font& copy);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The FreeType face, the glyph pages and the background
+    /// loader are taken over from \a right, which is left empty.
+    /// Unlike the copy constructor, no texture is duplicated.
+    ///
+    /// \param right Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    Font(Font&& right) noexcept;
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -142,6 +210,11 @@ public:
     /// function, so the stream has to remain accessible until
     /// the sf::Font object loads a new font or is destroyed.
     ///
+    /// The face is opened directly on the contents of the
+    /// stream, which must therefore be contiguous in memory
+    /// (see InputStream::getContiguousData), as with
+    /// sf::MemoryInputStream and sf::MappedFileInputStream.
+    ///
     /// \param stream Source stream to read from
     ///
     /// \return True if loading succeeded, false if it failed
@@ -151,6 +224,61 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromStream(InputStream& stream);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a bitmap font made of pre-rendered glyphs
+    ///
+    /// The descriptor is a BMFont (AngelCode) file, in the text
+    /// or the binary format; the XML format is not supported.
+    /// Its glyphs are copied from the page images to the font
+    /// texture once, and FreeType is not involved at all: no
+    /// glyph is ever rasterized, so this is a cheap way to get
+    /// text on devices where rasterization is too slow.
+    ///
+    /// A bitmap font has a single character size and style:
+    /// the glyphs are returned whatever size is requested (use
+    /// the text scale to resize them), bold is ignored and no
+    /// outline is available. Colored glyphs are reduced to
+    /// their coverage, and drawn with the color of the text.
+    ///
+    /// \param descriptor  Pointer to the descriptor file data in memory
+    /// \param sizeInBytes Size of the descriptor data, in bytes
+    /// \param pages       Images of the pages, in the order of the descriptor
+    /// \param pageCount   Number of images in \a pages
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see getBitmapFontPages, isBitmapFont
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromBitmapFont(const void* descriptor, std::size_t sizeInBytes, const Image* pages, std::size_t pageCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page files referenced by a bitmap font descriptor
+    ///
+    /// The file names are relative to the descriptor; loading
+    /// the corresponding images is left to the caller.
+    ///
+    /// \param descriptor  Pointer to the descriptor file data in memory
+    /// \param sizeInBytes Size of the descriptor data, in bytes
+    /// \param files       Filled with the file names, in page order
+    ///
+    /// \return True if the descriptor is valid, false otherwise
+    ///
+    /// \see loadFromBitmapFont
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getBitmapFontPages(const void* descriptor, std::size_t sizeInBytes, std::vector<std::string>& files);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the font was loaded with loadFromBitmapFont
+    ///
+    /// \return True if the glyphs of the font are pre-rendered
+    ///
+    /// \see loadFromBitmapFont
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBitmapFont() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the font information
     ///
@@ -159,6 +287,31 @@ public:
     ////////////////////////////////////////////////////////////
     const Info& getInfo() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counters of the work done by the font
+    ///
+    /// The glyph cache hit rate, the rasterization time and the
+    /// occupancy of the pages (glyphPixels / pagePixels) help to
+    /// choose the glyphs to preload and the size of the pages.
+    /// The lookups, rasterizations and text rebuilds made on the
+    /// rendering thread are also counted in the RenderStats of
+    /// the graphics module.
+    ///
+    /// \return Counters of the font
+    ///
+    /// \see resetStats, preloadGlyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    Stats getStats() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the counters of the font to 0
+    ///
+    /// \see getStats
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStats();
+
     ////////////////////////////////////////////////////////////
     /// \brief Retrieve a glyph of the font
     ///
@@ -179,6 +332,63 @@ public:
     ////////////////////////////////////////////////////////////
     const Glyph& getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness = 0) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of the glyph of a character in the font face
+    ///
+    /// \param codePoint Unicode code point of the character
+    ///
+    /// \return Index of the glyph, or 0 (the missing glyph) if the
+    ///         font has no glyph for \a codePoint
+    ///
+    /// \see getGlyphByIndex
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getGlyphIndex(Uint32 codePoint) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve a glyph of the font from its index
+    ///
+    /// The loaded glyphs are identified by their index in the
+    /// font face, so that the glyphs produced by text shaping
+    /// (ligatures, contextual forms) which have no code point
+    /// can be loaded too. getGlyph is the same as this function
+    /// with the index of the glyph of the character.
+    ///
+    /// \param index            Index of the glyph in the font face
+    /// \param characterSize    Reference character size
+    /// \param bold             Retrieve the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
+    ///
+    /// \return The glyph corresponding to \a index and \a characterSize
+    ///
+    /// \see getGlyphIndex, getGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& getGlyphByIndex(Uint32 index, unsigned int characterSize, bool bold, float outlineThickness = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs ahead of time
+    ///
+    /// Loading a glyph the first time it is requested rasterizes
+    /// it and uploads it to the page texture, which may cause a
+    /// visible hitch when a text with many new characters is
+    /// displayed. This function loads all the characters of
+    /// \a characters at once and uploads them to the texture in
+    /// a single update per page, typically during a loading screen.
+    ///
+    /// Call it once for each combination of character size,
+    /// boldness and outline thickness that will be displayed.
+    ///
+    /// \param characters       Characters to load
+    /// \param characterSize    Reference character size
+    /// \param bold             Load the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline
+    ///
+    /// \see getGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    void preloadGlyphs(const String& characters, unsigned int characterSize, bool bold = false, float outlineThickness = 0) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the kerning offset of two glyphs
     ///
@@ -197,6 +407,35 @@ public:
     ////////////////////////////////////////////////////////////
     float getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the bounds of a string without rendering it
+    ///
+    /// The result is the local bounds of a sf::Text showing
+    /// \a string with this font, the same character size and
+    /// style, and the default letter and line spacing.
+    ///
+    /// Unlike the bounds of a sf::Text, this function loads
+    /// the metrics of the glyphs only: it never rasterizes
+    /// them nor touches the graphics card, so it needs no
+    /// OpenGL context. It uses a face and caches of its own,
+    /// and can be called from any thread, concurrently with
+    /// the other functions of the font.
+    ///
+    /// Glyphs of distance field fonts are measured without
+    /// the spread of their distance field. The combined font
+    /// of a sf::FontCollection is the exception: it loads the
+    /// glyphs to measure them, so it must only be used from
+    /// the thread that draws with it.
+    ///
+    /// \param string        String to measure
+    /// \param characterSize Reference character size
+    /// \param style         Combination of sf::Text::Style flags (only Bold and Italic change the bounds)
+    ///
+    /// \return Bounds of the string, in local coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect measure(const String& string, unsigned int characterSize, Uint32 style = 0) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the line spacing
     ///
@@ -246,6 +485,16 @@ public:
     /// are requested, thus it is not very relevant. It is mainly
     /// used internally by sf::Text.
     ///
+    /// When supported, the texture stores only the coverage of
+    /// the glyphs, in its red channel (see Texture::isSingleChannel).
+    ///
+    /// When the texture has reached the maximum size and a new
+    /// glyph doesn't fit, the glyphs that weren't requested for
+    /// the last 60 frames (as counted by RenderTarget::resetFrameStats)
+    /// are dropped and the remaining ones are packed again, which
+    /// moves them in the texture. Glyphs retrieved before that must
+    /// be retrieved again.
+    ///
     /// \param characterSize Reference character size
     ///
     /// \return Texture containing the glyphs of the requested size
@@ -253,6 +502,241 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the shared glyph atlas
+    ///
+    /// By default, each character size gets its own texture.
+    /// When the atlas is shared, the glyphs of all the sizes,
+    /// styles and outlines are packed into a single texture,
+    /// so that texts of different sizes can be drawn together
+    /// in a single batch. getTexture then returns the same
+    /// texture for every size.
+    ///
+    /// Changing this option discards the glyphs that were
+    /// already loaded.
+    ///
+    /// \param shared True to share a single atlas between all the sizes
+    ///
+    /// \see isAtlasShared
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAtlasShared(bool shared);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the glyph atlas is shared between sizes
+    ///
+    /// \return True if all the sizes use a single atlas
+    ///
+    /// \see setAtlasShared
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAtlasShared() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the video memory used by the glyph pages
+    ///
+    /// This is the sum of the memory usage of the textures
+    /// returned by getTexture, for all the character sizes
+    /// loaded so far.
+    ///
+    /// \return Estimated memory usage of the glyph pages, in bytes
+    ///
+    /// \see Texture::getMemoryUsage
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getAtlasMemoryUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable signed distance field glyphs
+    ///
+    /// When enabled, the glyphs of scalable fonts are rendered
+    /// once as a signed distance field at a base size, into a
+    /// single atlas shared by all the character sizes. Other
+    /// sizes only scale the metrics of the base glyph, and the
+    /// render pipeline thresholds the distance when drawing,
+    /// which keeps the edges sharp at any scale.
+    ///
+    /// Outlined glyphs are still stroked by FreeType, at the
+    /// base size, before their distance field is computed.
+    ///
+    /// Changing this option discards the glyphs that were
+    /// already loaded.
+    ///
+    /// \param enabled True to render glyphs as distance fields
+    ///
+    /// \see isDistanceFieldEnabled, setAtlasShared
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDistanceFieldEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether glyphs are rendered as distance fields
+    ///
+    /// \return True if signed distance field glyphs are enabled
+    ///
+    /// \see setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDistanceFieldEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the empty space kept around each glyph in the font texture
+    ///
+    /// Shader outlines (see sf::Text::setOutlineMode) grow the
+    /// glyphs into this space, which limits their thickness to
+    /// \a padding pixels. Distance field glyphs don't need it,
+    /// their field already spreads around them.
+    ///
+    /// Changing this option discards the glyphs that were
+    /// already loaded; bitmap fonts keep their glyphs, and use
+    /// the new padding the next time they are loaded.
+    ///
+    /// \param padding Number of empty pixels around each glyph (0 by default)
+    ///
+    /// \see getGlyphPadding
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGlyphPadding(unsigned int padding);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the empty space kept around each glyph in the font texture
+    ///
+    /// \return Number of empty pixels around each glyph
+    ///
+    /// \see setGlyphPadding
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getGlyphPadding() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the background loading of glyphs
+    ///
+    /// By default, a glyph is rasterized by the thread that
+    /// requests it the first time. When asynchronous loading is
+    /// enabled, getGlyph returns a placeholder for a new glyph
+    /// right away (with its advance but no texture rectangle)
+    /// and the glyph is rasterized by a background thread,
+    /// which uses its own copy of the font face. The finished
+    /// glyphs are added to the texture at the next draw of a
+    /// sf::Text, which also updates the texts that use them.
+    ///
+    /// preloadGlyphs always loads the glyphs immediately. Bitmap
+    /// fonts are not loaded in the background.
+    ///
+    /// \param enabled True to load the glyphs in the background
+    ///
+    /// \see isAsyncLoadingEnabled, preloadGlyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAsyncLoadingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether glyphs are loaded in the background
+    ///
+    /// \return True if asynchronous glyph loading is enabled
+    ///
+    /// \see setAsyncLoadingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAsyncLoadingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the layout of texts from several threads
+    ///
+    /// By default, a font and the texts using it can only be
+    /// used by one thread at a time. When concurrent layout is
+    /// enabled, the glyph, kerning and metrics lookups of the
+    /// font are serialized by a lock, so that worker threads can
+    /// lay out texts using the font in parallel (getLocalBounds,
+    /// findCharacterPos, ...). Lookups hitting the cache only
+    /// hold the lock briefly, and the metrics of each character
+    /// size are cached, so that they don't resize the face.
+    ///
+    /// The thread that enables concurrent layout becomes the
+    /// render thread of the font: it is the only one that draws
+    /// the texts, rasterizes glyphs and uploads them to the font
+    /// textures. A glyph missing on another thread is laid out
+    /// with a placeholder (with its advance but nothing to draw)
+    /// until the next draw of a text on the render thread, which
+    /// loads it and updates the texts that use it. With
+    /// asynchronous loading, the placeholders are rasterized by
+    /// the background thread instead.
+    ///
+    /// The layout of the texts must not overlap their draws, and
+    /// only the texts of a single copy of the font can be laid
+    /// out in parallel, since the copies share the font face.
+    ///
+    /// \param enabled True to allow laying out texts from several threads
+    ///
+    /// \see isConcurrentLayoutEnabled, setAsyncLoadingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setConcurrentLayoutEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether texts can be laid out from several threads
+    ///
+    /// \return True if concurrent layout is enabled
+    ///
+    /// \see setConcurrentLayoutEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isConcurrentLayoutEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the loaded glyphs and their textures
+    ///
+    /// The glyph cache contains the coverage of the pages, the
+    /// metrics of the glyphs and their position in the pages.
+    /// Loading it back with loadGlyphCache restores all these
+    /// glyphs without rendering them with FreeType, which saves
+    /// a lot of time at startup on slow devices. A typical use
+    /// is to preload the glyphs of the user interface at the
+    /// first launch, and save the cache for the next ones.
+    ///
+    /// The font must have been loaded from memory.
+    ///
+    /// \param data Receives the glyph cache
+    ///
+    /// \return True if saving succeeded, false if it failed
+    ///
+    /// \see loadGlyphCache, preloadGlyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveGlyphCache(std::vector<Uint8>& data) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restore the glyphs saved with saveGlyphCache
+    ///
+    /// The cache is only accepted if it was saved for the same
+    /// font data, with the same version of FreeType and the
+    /// same glyph options (setAtlasShared, setDistanceFieldEnabled,
+    /// setGlyphPadding).
+    /// On success, it replaces all the glyphs loaded so far.
+    /// On failure, the font is left unchanged.
+    ///
+    /// \param data        Pointer to the glyph cache data in memory
+    /// \param sizeInBytes Size of the data, in bytes
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see saveGlyphCache
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadGlyphCache(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restore the glyphs saved with saveGlyphCache from a stream
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see saveGlyphCache
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadGlyphCache(InputStream& stream);
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -263,25 +747,80 @@ public:
     ////////////////////////////////////////////////////////////
     Font& operator =(const Font& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of move assignment operator
+    ///
+    /// \param right Instance to move
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Font& operator =(Font&& right) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this font with those of another
+    ///
+    /// The texts using either font rebuild their geometry the
+    /// next time they are drawn.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Font& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the allocator used by FreeType
+    ///
+    /// All the fonts share a single FreeType library, which
+    /// allocates its faces, glyph slots and strokers with
+    /// sf::Allocator by default. This function routes these allocations
+    /// to a custom allocator instead, for example a pool or an
+    /// arena that tracks the memory used by text.
+    ///
+    /// It must be called while no font is loaded, since the
+    /// allocator of an existing library cannot be changed.
+    /// The callbacks are called from the background glyph
+    /// loaders too, so they must be thread-safe.
+    ///
+    /// \param allocate   Function allocating a block, or NULL to restore the default allocator
+    /// \param reallocate Function resizing a block; if NULL it is emulated with \a allocate and \a deallocate
+    /// \param deallocate Function freeing a block allocated by \a allocate or \a reallocate
+    /// \param userData   User pointer passed to the callbacks
+    ///
+    /// \return True if the allocator was set, false if fonts are still loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setAllocator(AllocateCallback allocate, ReallocateCallback reallocate, DeallocateCallback deallocate, void* userData = NULL);
+
 private:
 
+    friend class Text;
+    friend class Canvas;
+    friend class ContextRestore;
+    friend class FontCollection;
+    friend class TextBatch;
+    friend class NumericText;
+
     ////////////////////////////////////////////////////////////
-    /// \brief Structure defining a row of glyphs
+    /// \brief Structure caching the kerning of a character size
     ///
     ////////////////////////////////////////////////////////////
-    struct Row
+    struct KerningTable
     {
-        Row(unsigned int rowTop, unsigned int rowHeight) : width(0), top(rowTop), height(rowHeight) {}
-
-        unsigned int width;  ///< Current width of the row
-        unsigned int top;    ///< Y position of the row into the texture
-        unsigned int height; ///< Height of the row
+        std::vector<Int16>      latin1; ///< Kerning of the Latin-1 pairs, in 1/64 pixels (allocated on first use)
+        std::map<Uint64, float> others; ///< Kerning of the other pairs, which are rare
     };
 
     ////////////////////////////////////////////////////////////
-    // Types
+    /// \brief Structure caching the metrics of a character size
+    ///
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint64, Glyph> GlyphTable; ///< Table mapping a codepoint to its glyph
+    struct SizeMetrics
+    {
+        float lineSpacing;        ///< Vertical distance between two lines, in pixels
+        float underlinePosition;  ///< Position of the underline, in pixels
+        float underlineThickness; ///< Thickness of the underline, in pixels
+    };
 
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a page of glyphs
@@ -289,12 +828,10 @@ private:
     ////////////////////////////////////////////////////////////
     struct Page
     {
-        Page();
-
-        GlyphTable       glyphs;  ///< Table mapping code points to their corresponding glyph
-        Texture          texture; ///< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; ///< Y position of the next new row in the texture
-        std::vector<Row> rows;    ///< List containing the position of all the existing rows
+        Texture             texture;  ///< Texture containing the pixels of the glyphs
+        priv::SkylinePacker packer;   ///< Allocator of the rectangles of the texture
+        std::vector<Uint8>  coverage; ///< CPU copy of the coverage of the texture, one byte per pixel
+        IntRect             dirty;    ///< Region of the copy that hasn't been uploaded yet
     };
 
     ////////////////////////////////////////////////////////////
@@ -304,17 +841,125 @@ private:
     void cleanup();
 
     ////////////////////////////////////////////////////////////
-    /// \brief Load a new glyph and store it in the cache
+    /// \brief Build a glyph by scaling its distance field at the base size
     ///
-    /// \param codePoint        Unicode code point of the character to load
+    /// \param index            Index of the glyph in the font face
     /// \param characterSize    Reference character size
     /// \param bold             Retrieve the bold version or the regular one?
     /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
     ///
-    /// \return The glyph corresponding to \a codePoint and \a characterSize
+    /// \return The glyph corresponding to \a index and \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph scaleGlyph(Uint32 index, unsigned int characterSize, bool bold, float outlineThickness) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the glyphs of a whole string, shaped once and cached
+    ///
+    /// \param string        String to shape
+    /// \param characterSize Reference character size
+    /// \param bold          Shape the bold version or the regular one?
+    ///
+    /// \return The glyphs of the string, valid until the next call
+    ///
+    ////////////////////////////////////////////////////////////
+    const priv::ShapedRun& getShapedRun(const String& string, unsigned int characterSize, bool bold) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a glyph into its page
+    ///
+    /// \param index            Index of the glyph in the font face
+    /// \param characterSize    Reference character size
+    /// \param bold             Retrieve the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
+    ///
+    /// \return The glyph corresponding to \a index and \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph loadGlyph(Uint32 index, unsigned int characterSize, bool bold, float outlineThickness) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a glyph of a fallback font into a page of the combined font
+    ///
+    /// \param index            Index of the fallback font (high bits) and of the glyph in its face
+    /// \param characterSize    Reference character size
+    /// \param bold             Retrieve the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
+    ///
+    /// \return The glyph corresponding to \a index and \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph loadFallbackGlyph(Uint32 index, unsigned int characterSize, bool bold, float outlineThickness) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a rasterized glyph to its page
+    ///
+    /// \param bitmap        The rasterized glyph
+    /// \param characterSize Reference character size
+    ///
+    /// \return The glyph, with its texture rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph commitGlyph(const priv::GlyphBitmap& bitmap, unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the glyph to use until a glyph is rasterized
+    ///
+    /// \param index         Index of the glyph in the font face
+    /// \param characterSize Reference character size
+    /// \param bold          Retrieve the bold version or the regular one?
+    ///
+    /// \return Glyph with the advance of the glyph, and nothing to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph getPlaceholderGlyph(Uint32 index, unsigned int characterSize, bool bold) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a new glyph must be loaded in the background
+    ///
+    ////////////////////////////////////////////////////////////
+    bool useAsyncLoading() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start the rasterizer thread for the current font
+    ///
+    ////////////////////////////////////////////////////////////
+    void startRasterizer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the face used by measure for the current font
+    ///
+    ////////////////////////////////////////////////////////////
+    void openMetrics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the glyphs rasterized in the background to their page
+    ///
+    /// This function is called by sf::Text before it checks
+    /// whether its geometry must be updated.
+    ///
+    /// \param wait Wait for all the queued glyphs?
+    ///
+    ////////////////////////////////////////////////////////////
+    void commitGlyphs(bool wait) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the placeholders immediately
+    ///
+    ////////////////////////////////////////////////////////////
+    void loadPendingGlyphs() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Query FreeType for the kerning of a pair of characters
+    ///
+    /// \param first         Unicode code point of the first character
+    /// \param second        Unicode code point of the second character
+    /// \param characterSize Reference character size
+    ///
+    /// \return Kerning value, in 1/64 pixels
     ///
     ////////////////////////////////////////////////////////////
-    Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
+    long loadKerning(Uint32 first, Uint32 second, unsigned int characterSize) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Find a suitable rectangle within the texture for a glyph
@@ -328,6 +973,150 @@ private:
     ////////////////////////////////////////////////////////////
     IntRect findGlyphRect(Page& page, unsigned int width, unsigned int height) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Drop the unused glyphs of a full page and load the others again
+    ///
+    /// The glyphs that weren't requested for a while are removed
+    /// from the cache, and the remaining glyphs of the page are
+    /// rasterized again into a new, tightly packed texture.
+    ///
+    /// \param page Page to repack
+    ///
+    /// \return True if some room was made, false if no glyph could be dropped
+    ///
+    ////////////////////////////////////////////////////////////
+    bool repackPage(Page& page) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page that stores the glyphs of a character size
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Page of the size, or the shared page
+    ///
+    ////////////////////////////////////////////////////////////
+    Page& getPage(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the key of the page that stores a character size
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Key of the page in the page table
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPageKey(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset a page to an empty texture of the initial size
+    ///
+    /// \param page Page to initialize
+    ///
+    ////////////////////////////////////////////////////////////
+    void initializePage(Page& page) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the glyphs are loaded as distance fields
+    ///
+    /// Distance fields are only available for scalable fonts.
+    ///
+    /// \return True if the distance field mode applies to this font
+    ///
+    ////////////////////////////////////////////////////////////
+    bool useDistanceField() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write coverage to a page
+    ///
+    /// The coverage, one byte per pixel, is copied to the CPU
+    /// copy of the page, which is uploaded right away unless
+    /// uploads are deferred.
+    ///
+    /// \param page   Page to write to
+    /// \param pixels Coverage of the region
+    /// \param width  Width of the region
+    /// \param height Height of the region
+    /// \param x      Left of the region in the page texture
+    /// \param y      Top of the region in the page texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeCoverage(Page& page, const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the modified region of a page to its texture
+    ///
+    /// The coverage is expanded to white RGBA pixels if the
+    /// page texture has more than one channel.
+    ///
+    /// \param page Page to upload
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadCoverage(Page& page) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the textures of the glyph pages
+    ///
+    /// \param textures Vector to append the textures to
+    ///
+    ////////////////////////////////////////////////////////////
+    void getPageTextures(std::vector<const Texture*>& textures) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the whole coverage of the pages again
+    ///
+    /// Called after the page textures were recreated by a
+    /// context restore.
+    ///
+    ////////////////////////////////////////////////////////////
+    void restorePages() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Measure a string with the loaded glyphs
+    ///
+    /// Used by the fonts that FontMetrics can't measure: bitmap
+    /// fonts and combined fonts.
+    ///
+    /// \param string        String to measure
+    /// \param characterSize Reference character size
+    /// \param bold          Measure the bold version or the regular one?
+    /// \param italicShear   Horizontal shear of the italic style
+    ///
+    /// \return Bounding rectangle of the string
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect measureGlyphs(const String& string, unsigned int characterSize, bool bold, float italicShear) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the width of a shader outline in the units of the font texture
+    ///
+    /// \param thickness     Thickness of the outline, in pixels
+    /// \param characterSize Reference character size
+    ///
+    /// \return Distance from the edge for distance field glyphs,
+    ///         radius in texels (limited by the glyph padding) otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    float getShaderOutlineWidth(float thickness, unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the metrics of a character size, loaded on first use
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Metrics of the size (zero if the size is not available)
+    ///
+    ////////////////////////////////////////////////////////////
+    const SizeMetrics& getSizeMetrics(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the calling thread can use OpenGL for the font
+    ///
+    /// \return True if concurrent layout is disabled, or if the
+    ///         calling thread is the render thread of the font
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isRenderThread() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Make sure that the given size is the current one
     ///
@@ -338,10 +1127,35 @@ private:
     ////////////////////////////////////////////////////////////
     bool setCurrentSize(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Account the current size of the glyph tables and coverage buffers
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateMemoryUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Account a glyph rasterized by FreeType
+    ///
+    /// \param time Time spent rasterizing it
+    ///
+    ////////////////////////////////////////////////////////////
+    void countRasterization(Time time) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Account a rebuild of the geometry of a text
+    ///
+    /// \param glyphsMoved Was it caused by a change of the glyphs, rather than of the text?
+    ///
+    ////////////////////////////////////////////////////////////
+    void countTextRebuild(bool glyphsMoved) const;
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
     typedef std::map<unsigned int, Page> PageTable; ///< Table mapping a character size to its page (texture)
+    typedef std::map<unsigned int, priv::GlyphTable> GlyphTables; ///< Table mapping a character size to its glyphs
+    typedef std::map<unsigned int, KerningTable> KerningTables; ///< Table mapping a character size to its kerning
+    typedef std::map<unsigned int, SizeMetrics> MetricsTables; ///< Table mapping a character size to its metrics
 
     ////////////////////////////////////////////////////////////
     // Member data
@@ -353,7 +1167,31 @@ private:
     int*                       m_refCount;    ///< Reference counter used by implicit sharing
     Info                       m_info;        ///< Information about the font
     mutable PageTable          m_pages;       ///< Table containing the glyphs pages by character size
-    mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    mutable GlyphTables        m_glyphs;      ///< Table containing the loaded glyphs by character size
+    mutable KerningTables      m_kerning;     ///< Table containing the loaded kerning pairs by character size
+    mutable MetricsTables      m_sizeMetrics; ///< Table containing the loaded metrics by character size
+    mutable priv::ShapedRunCache m_shapedRuns; ///< Strings shaped with the font, shared by the texts
+    bool                       m_atlasShared; ///< Do all the character sizes share a single page?
+    bool                       m_distanceField; ///< Are the glyphs rendered as signed distance fields?
+    unsigned int               m_glyphPadding; ///< Empty pixels kept around each glyph in its page
+    mutable bool               m_repacking;   ///< Is a page being repacked?
+    mutable bool               m_uploadDeferred; ///< Are the page uploads postponed by preloadGlyphs?
+    bool                       m_asyncLoading; ///< Are new glyphs loaded in the background?
+    priv::GlyphRasterizer*     m_rasterizer;  ///< Thread loading the glyphs in the background
+    priv::FontMetrics*         m_metrics;     ///< Face measuring strings from any thread
+    mutable Uint64             m_generation;  ///< Incremented when the loaded glyphs are cleared or moved, to discard outdated requests
+    mutable Uint64             m_revision;    ///< Incremented when the loaded glyphs change (including the rasterized placeholders), to discard outdated geometry
+    const void*                m_fontData;    ///< Data of the font file, shared with the rasterizer thread
+    std::size_t                m_fontDataSize; ///< Size of the font file data, in bytes
+    mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's coverage before being written to the texture
+    unsigned int               m_bitmapSize;  ///< Character size of the pre-rendered glyphs (0 if the font is not a bitmap font)
+    float                      m_bitmapLineSpacing; ///< Line spacing of the bitmap font, in pixels
+    const FontCollection*      m_collection;  ///< Collection whose fonts this font combines (NULL for a regular font)
+    std::recursive_mutex*      m_layoutMutex; ///< Lock of the lookups, when texts are laid out from several threads (NULL otherwise)
+    std::thread::id            m_renderThread; ///< Thread drawing the texts, when texts are laid out from several threads
+    mutable bool               m_pendingLoads; ///< Were placeholders inserted by other threads than the render thread?
+    mutable priv::MemoryCounter m_memory;     ///< Accounted size of the glyph tables and coverage buffers
+    mutable Stats              m_stats;       ///< Counters of the work done by the font
 };
 
 } // namespace sf
@@ -431,6 +1269,10 @@ private:
 /// If you need to display text of a certain size, make sure the
 /// corresponding bitmap font that supports that size is used.
 ///
+/// All the fonts share the same FreeType library, whose memory
+/// allocations can be redirected with sf::Font::setAllocator
+/// before the first font is loaded.
+///
 /// \see sf::Text
 ///
 ////////////////////////////////////////////////////////////
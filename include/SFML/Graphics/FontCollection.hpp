@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FONTCOLLECTION_HPP
+#define SFML_FONTCOLLECTION_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Ordered list of fonts, each one used for the
+///        characters missing from the previous ones
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API FontCollection : NonCopyable
+{
+public:
+
+    enum
+    {
+        MaxFontCount = 64 ///< Maximum number of fonts in a collection
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty collection.
+    ///
+    ////////////////////////////////////////////////////////////
+    FontCollection();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a font at the end of the fallback list
+    ///
+    /// The collection keeps a pointer to \a font, which must
+    /// stay alive and loaded as long as the collection uses it.
+    /// Adding a font drops the glyphs loaded by the collection.
+    ///
+    /// \param font Font to add
+    ///
+    /// \return True if the font was added, false if the collection is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addFont(const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the fonts
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of fonts of the fallback list
+    ///
+    /// \return Number of fonts
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFontCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a font of the fallback list
+    ///
+    /// \param index Index of the font, in fallback order
+    ///
+    /// \return Font at \a index
+    ///
+    ////////////////////////////////////////////////////////////
+    const Font& getFont(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the font that draws a character
+    ///
+    /// The first font of the list that has a glyph for the
+    /// character is chosen, or the first font if none has one.
+    /// The result is cached, so that each character is only
+    /// looked up once in the fonts.
+    ///
+    /// \param codePoint Unicode code point of the character
+    ///
+    /// \return Index of the font in the fallback list
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findFont(Uint32 codePoint) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the font drawing with the whole fallback list
+    ///
+    /// This font can be given to sf::Text like any other font:
+    /// each character is drawn with the font found by findFont,
+    /// and the glyphs of all the fonts go to the same texture,
+    /// so that a string mixing several scripts is still drawn
+    /// in a single batch. The global metrics (line spacing,
+    /// underline) are the ones of the first font.
+    ///
+    /// \return Font combining the fonts of the collection
+    ///
+    ////////////////////////////////////////////////////////////
+    const Font& getCombinedFont() const;
+
+private:
+
+    friend class Font;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the resolved characters and the loaded glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<const Font*>              m_fonts;  ///< Fonts of the fallback list
+    Font                                  m_font;   ///< Font combining the fonts of the list
+    mutable std::vector<Uint8>            m_basic;  ///< Index + 1 of the font of each character of the Basic Multilingual Plane (0 if not resolved yet, allocated on first use)
+    mutable std::map<Uint32, std::size_t> m_others; ///< Index of the font of the other resolved characters
+};
+
+} // namespace sf
+
+
+#endif // SFML_FONTCOLLECTION_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FontCollection
+/// \ingroup graphics
+///
+/// A single font rarely covers every script: chat messages
+/// mixing Latin, CJK and emoji need several of them. An
+/// sf::FontCollection holds the fonts in fallback order, and
+/// picks for each character the first font that has a glyph
+/// for it. The choice is made once per character and cached,
+/// in a dense table for the Basic Multilingual Plane.
+///
+/// The collection doesn't copy its fonts, they must outlive it.
+/// The combined font rasterizes the glyphs of the fallback
+/// fonts itself, into its own texture: distance fields and
+/// background loading are not used for it. Bitmap fonts can
+/// be part of the list, their pre-rendered glyphs are copied.
+///
+/// Usage example:
+/// \code
+/// sf::FontCollection fonts;
+/// fonts.addFont(latin);
+/// fonts.addFont(cjk);
+/// fonts.addFont(emoji);
+///
+/// sf::Text text(sf::String::fromUtf8(message.begin(), message.end()), fonts.getCombinedFont(), 24);
+/// window.draw(text);
+/// \endcode
+///
+/// \see sf::Font, sf::Text
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_FONTMETRICS_HPP
+#define SFML_FONTMETRICS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Glyph.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/String.hpp>
+#include <map>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Thread-safe measurement of strings from the metrics of a font
+///
+/// The metrics are read from a FreeType face of its own, so
+/// that measuring never waits for nor disturbs the face used
+/// to rasterize the glyphs. Glyphs are loaded but never
+/// rendered, and their advance, bounds and kerning are cached
+/// per character size. All the functions can be called from
+/// any thread.
+///
+////////////////////////////////////////////////////////////
+class FontMetrics : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FontMetrics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~FontMetrics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the face of the font data
+    ///
+    /// \param data        Pointer to the file data in memory, which must stay alive
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return True if successful, false if the face couldn't be opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the bounds of a string laid out like a sf::Text
+    ///
+    /// \param string        String to measure
+    /// \param characterSize Reference character size
+    /// \param bold          Measure the bold version or the regular one?
+    /// \param italicShear   Horizontal shear of the italic style (0 if not italic)
+    ///
+    /// \return Bounds of the string, in local coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect measure(const String& string, unsigned int characterSize, bool bold, float italicShear);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the advance and bounds of a glyph
+    ///
+    /// The mutex must be locked, and the face set to the size.
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the kerning offset of two characters, in pixels
+    ///
+    /// The mutex must be locked, and the face set to the size.
+    ///
+    ////////////////////////////////////////////////////////////
+    float getKerning(Uint32 first, Uint32 second, unsigned int characterSize);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex                   m_mutex;   ///< Mutex protecting the face and the caches
+    void*                   m_library; ///< FreeType library of the face (it is typeless to avoid exposing implementation details)
+    void*                   m_face;    ///< Font face of the metrics (it is typeless to avoid exposing implementation details)
+    std::map<Uint64, Glyph> m_glyphs;  ///< Metrics of the loaded glyphs, by character size, boldness and code point (no texture rectangle)
+    std::map<Uint64, float> m_kerning; ///< Kerning of the loaded pairs, by character size and code points
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_FONTMETRICS_HPP
@@ -0,0 +1,359 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FRAMEARENA_HPP
+#define SFML_FRAMEARENA_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Bump allocator for memory that only lives during a frame
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API FrameArena : NonCopyable
+{
+public:
+
+    enum
+    {
+        DefaultAlignment = 16 ///< Alignment of the allocations when none is specified
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Position in the arena, to rewind to
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Marker
+    {
+        std::size_t block;  ///< Index of the current block
+        std::size_t offset; ///< Number of bytes used in the current block
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rewind an arena to its current position when leaving a scope
+    ///
+    /// Temporaries allocated within the scope are released when
+    /// it ends, so that functions called many times per frame
+    /// don't make the arena grow.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API Scope : NonCopyable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Remember the current position of \a arena
+        ///
+        /// \param arena Arena to rewind at the end of the scope
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Scope(FrameArena& arena);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Rewind the arena to the remembered position
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Scope();
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        FrameArena& m_arena;  ///< Arena to rewind
+        Marker      m_marker; ///< Position of the arena when the scope started
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// No memory is allocated until the first allocation.
+    ///
+    /// \param blockSize Minimum size of the blocks requested to the heap, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit FrameArena(std::size_t blockSize = 64 * 1024);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the memory of the arena is returned to the heap.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~FrameArena();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate raw memory
+    ///
+    /// The memory stays valid until the arena is reset, or
+    /// rewound to a marker taken before this allocation.
+    /// The heap is only used when the free room of the arena
+    /// is too small, which stops happening after a few frames.
+    ///
+    /// \param size      Number of bytes to allocate
+    /// \param alignment Alignment of the returned address, must be a power of two
+    ///
+    /// \return Pointer to the allocated memory
+    ///
+    ////////////////////////////////////////////////////////////
+    void* allocate(std::size_t size, std::size_t alignment = DefaultAlignment);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate an array of objects
+    ///
+    /// The objects are not constructed, and are never
+    /// destroyed: \a T should be a trivial type, such as
+    /// sf::Vertex or a built-in type.
+    ///
+    /// \param count Number of objects to allocate
+    ///
+    /// \return Pointer to the first object
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    T* allocate(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current position in the arena
+    ///
+    /// \return Marker to pass to rewind
+    ///
+    /// \see rewind
+    ///
+    ////////////////////////////////////////////////////////////
+    Marker getMarker() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the allocations made since a marker was taken
+    ///
+    /// \param marker Marker returned by getMarker, since the last reset
+    ///
+    /// \see getMarker
+    ///
+    ////////////////////////////////////////////////////////////
+    void rewind(const Marker& marker);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release all the allocations
+    ///
+    /// If the last frame needed more than one block, the blocks
+    /// are merged into a single one as large as all of them,
+    /// so that the next frames fit without touching the heap.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes currently allocated
+    ///
+    /// \return Used size, including the alignment padding
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getUsedSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes requested to the heap
+    ///
+    /// \return Total size of the blocks of the arena
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the frame arena of the calling thread
+    ///
+    /// The arena of the rendering thread is reset by
+    /// RenderTarget::resetFrameStats (called by
+    /// RenderWindow::display), once per frame. The
+    /// arenas of other threads are never reset automatically,
+    /// they are meant to be used with FrameArena::Scope.
+    ///
+    /// \return Arena of the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    static FrameArena& getDefault();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Chunk of memory requested to the heap
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Block
+    {
+        char*       data; ///< Memory of the block
+        std::size_t size; ///< Size of the block, in bytes
+        std::size_t used; ///< Number of bytes allocated in the block
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Block> m_blocks;    ///< Blocks of the arena, the ones after the current one are unused
+    std::size_t        m_current;   ///< Index of the block that allocations are taken from
+    std::size_t        m_blockSize; ///< Minimum size of the blocks
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Standard allocator drawing its memory from a frame arena
+///
+/// Deallocation does nothing, the memory is reclaimed when
+/// the arena is reset. Containers using this allocator must
+/// not outlive the frame (or the scope) they were filled in.
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class FrameAllocator
+{
+public:
+
+    typedef T value_type;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Allocates from the frame arena of the calling thread.
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameAllocator();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the allocator from an arena
+    ///
+    /// \param arena Arena to allocate from
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit FrameAllocator(FrameArena& arena);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the allocator from another type of allocator
+    ///
+    /// \param other Allocator to share the arena of
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate storage for \a count objects
+    ///
+    ////////////////////////////////////////////////////////////
+    T* allocate(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release storage (does nothing)
+    ///
+    ////////////////////////////////////////////////////////////
+    void deallocate(T* pointer, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the arena the allocator draws from
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameArena& getArena() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    FrameArena* m_arena; ///< Arena to allocate from
+};
+
+////////////////////////////////////////////////////////////
+/// \relates FrameAllocator
+/// \brief Overload of == operator to compare two allocators
+///
+/// \return True if both allocators draw from the same arena
+///
+////////////////////////////////////////////////////////////
+template <typename T, typename U>
+bool operator ==(const FrameAllocator<T>& left, const FrameAllocator<U>& right);
+
+////////////////////////////////////////////////////////////
+/// \relates FrameAllocator
+/// \brief Overload of != operator to compare two allocators
+///
+/// \return True if the allocators draw from different arenas
+///
+////////////////////////////////////////////////////////////
+template <typename T, typename U>
+bool operator !=(const FrameAllocator<T>& left, const FrameAllocator<U>& right);
+
+#include <SFML/Graphics/FrameArena.inl>
+
+} // namespace sf
+
+
+#endif // SFML_FRAMEARENA_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FrameArena
+/// \ingroup graphics
+///
+/// sf::FrameArena hands out memory by moving a pointer
+/// forward in large blocks, and takes it all back at once.
+/// It is meant for the temporaries that are rebuilt every
+/// frame, such as the vertices of an immediate mode draw:
+/// once the arena has grown to the size of a frame, these
+/// temporaries cost no heap allocation at all.
+///
+/// The default arena of the rendering thread is reset by
+/// RenderTarget::resetFrameStats (called by RenderWindow::display), so nothing allocated from
+/// it may be kept across frames. Within a frame, a
+/// sf::FrameArena::Scope releases the temporaries of a
+/// function when it returns.
+///
+/// sf::FrameAllocator plugs an arena into the standard
+/// containers, for example to build vertices that are
+/// drawn right away:
+///
+/// Usage example:
+/// \code
+/// typedef std::vector<sf::Vertex, sf::FrameAllocator<sf::Vertex> > FrameVertices;
+///
+/// // Every frame
+/// FrameVertices vertices;
+/// vertices.reserve(particles.size() * 6);
+/// for (std::size_t i = 0; i < particles.size(); ++i)
+///     appendQuad(vertices, particles[i]);
+///
+/// window.draw(vertices.data(), vertices.size(), sf::Triangles);
+///
+/// window.display(); // the vertices are released here
+/// \endcode
+///
+/// \see sf::VertexArray
+///
+////////////////////////////////////////////////////////////
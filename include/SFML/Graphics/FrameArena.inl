@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+template <typename T>
+T* FrameArena::allocate(std::size_t count)
+{
+    return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+FrameAllocator<T>::FrameAllocator() :
+m_arena(&FrameArena::getDefault())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+FrameAllocator<T>::FrameAllocator(FrameArena& arena) :
+m_arena(&arena)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+template <typename U>
+FrameAllocator<T>::FrameAllocator(const FrameAllocator<U>& other) :
+m_arena(&other.getArena())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+T* FrameAllocator<T>::allocate(std::size_t count)
+{
+    return m_arena->template allocate<T>(count);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void FrameAllocator<T>::deallocate(T*, std::size_t)
+{
+    // The memory is reclaimed when the arena is reset
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+FrameArena& FrameAllocator<T>::getArena() const
+{
+    return *m_arena;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename U>
+bool operator ==(const FrameAllocator<T>& left, const FrameAllocator<U>& right)
+{
+    return &left.getArena() == &right.getArena();
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename U>
+bool operator !=(const FrameAllocator<T>& left, const FrameAllocator<U>& right)
+{
+    return !(left == right);
+}
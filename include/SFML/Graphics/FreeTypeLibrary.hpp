@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FREETYPELIBRARY_HPP
+#define SFML_FREETYPELIBRARY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/System/Mutex.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Get a reference to the FreeType library shared by all the fonts
+///
+/// The library is created by the first call, and destroyed
+/// when the last reference is released. Every successful
+/// call must be balanced with releaseFreeTypeLibrary.
+///
+/// \return The FT_Library, or NULL if it couldn't be created
+///
+////////////////////////////////////////////////////////////
+void* acquireFreeTypeLibrary();
+
+////////////////////////////////////////////////////////////
+/// \brief Release a reference to the shared FreeType library
+///
+////////////////////////////////////////////////////////////
+void releaseFreeTypeLibrary();
+
+////////////////////////////////////////////////////////////
+/// \brief Get the mutex that protects the shared FreeType library
+///
+/// FreeType requires the creation and destruction of faces
+/// and strokers to be serialized when they share a library.
+/// Using a face is safe as long as each face is used by a
+/// single thread at a time.
+///
+////////////////////////////////////////////////////////////
+Mutex& getFreeTypeLibraryMutex();
+
+////////////////////////////////////////////////////////////
+/// \brief Set the allocator of the shared FreeType library
+///
+/// \see Font::setAllocator
+///
+////////////////////////////////////////////////////////////
+bool setFreeTypeAllocator(Font::AllocateCallback allocate, Font::ReallocateCallback reallocate, Font::DeallocateCallback deallocate, void* userData);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_FREETYPELIBRARY_HPP
@@ -41,9 +41,9 @@ namespace priv
 ////////////////////////////////////////////////////////////
 #ifdef SFML_DEBUG
 
-    // In debug mode, perform a test on every OpenGL call
+    // In debug mode, test the OpenGL calls as configured by setGLCheckMode
     // The do-while loop is needed so that glCheck can be used as a single statement in if/else branches
-    #define glCheck(expr) do { expr; sf::priv::glCheckError(__FILE__, __LINE__, #expr); } while (false)
+    #define glCheck(expr) do { expr; if (sf::priv::isGLCheckDue()) sf::priv::glCheckError(__FILE__, __LINE__, #expr); } while (false)
 
 #else
 
@@ -52,6 +52,77 @@ namespace priv
 
 #endif
 
+////////////////////////////////////////////////////////////
+/// \brief Ways of detecting the OpenGL errors in debug builds
+///
+////////////////////////////////////////////////////////////
+enum GLCheckMode
+{
+    GLCheckEveryCall,   ///< Call glGetError after every call (default, exact location but slow)
+    GLCheckSampled,     ///< Call glGetError after one call out of N (cheaper, the location is approximate)
+    GLCheckDebugOutput  ///< Let the driver report the errors through KHR_debug, without any per-call work
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Select how glCheck detects the OpenGL errors
+///
+/// glGetError synchronizes with the driver on many
+/// implementations, which makes the debug builds much
+/// slower than the release ones. With GLCheckDebugOutput,
+/// the driver calls back whenever it detects an error
+/// instead, see installGLDebugOutput; without KHR_debug
+/// (GL 4.3, ES 3.2, never in WebGL), glCheck falls back
+/// to sampled polling.
+///
+/// This function must be called before any other thread
+/// starts using OpenGL. It has no effect in release builds,
+/// where glCheck doesn't test anything.
+///
+/// \param mode     How to detect the errors
+/// \param interval Number of calls between two polls in sampled mode
+///
+////////////////////////////////////////////////////////////
+void setGLCheckMode(GLCheckMode mode, unsigned int interval = 64);
+
+////////////////////////////////////////////////////////////
+/// \brief Enable the debug output in the current context
+///
+/// The debug output is a state of each OpenGL context; this
+/// function is called when SFML renders with a context for
+/// the first time, and does nothing unless the mode is
+/// GLCheckDebugOutput. The errors are reported as the
+/// driver detects them, asynchronously: create the context
+/// with the debug flag (SDL_GL_CONTEXT_DEBUG_FLAG) so that
+/// the driver doesn't skip them.
+///
+/// \return True if the debug output is enabled
+///
+////////////////////////////////////////////////////////////
+bool installGLDebugOutput();
+
+////////////////////////////////////////////////////////////
+/// Number of calls between two glGetError polls (0 to never poll)
+////////////////////////////////////////////////////////////
+extern unsigned int glCheckInterval;
+
+////////////////////////////////////////////////////////////
+/// Calls made by this thread since its last poll
+////////////////////////////////////////////////////////////
+extern thread_local unsigned int glCheckCounter;
+
+////////////////////////////////////////////////////////////
+/// \brief Tell whether glCheck must poll glGetError after this call
+///
+////////////////////////////////////////////////////////////
+inline bool isGLCheckDue()
+{
+    if ((glCheckInterval == 0) || (++glCheckCounter < glCheckInterval))
+        return false;
+
+    glCheckCounter = 0;
+    return true;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Check the last OpenGL error
 ///
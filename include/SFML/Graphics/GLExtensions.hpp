@@ -29,6 +29,8 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Config.hpp>
+#include <SFML/Graphics/GraphicsCaps.hpp>
+#include <SFML/Graphics/StartupStats.hpp>
 #include <SFML/glad.h>
 
 
@@ -36,10 +38,22 @@
 #define SFML_GL_EXT_glGenVertexArrays       glGenVertexArraysOES
 #define SFML_GL_EXT_glBindVertexArray       glBindVertexArrayOES
 #define SFML_GL_EXT_glDeleteVertexArrays    glDeleteVertexArraysOES
+#define SFML_GL_EXT_glGenQueries            glGenQueriesEXT
+#define SFML_GL_EXT_glDeleteQueries         glDeleteQueriesEXT
+#define SFML_GL_EXT_glBeginQuery            glBeginQueryEXT
+#define SFML_GL_EXT_glEndQuery              glEndQueryEXT
+#define SFML_GL_EXT_glGetQueryObjectuiv     glGetQueryObjectuivEXT
+#define SFML_GL_EXT_glGetQueryObjectui64v   glGetQueryObjectui64vEXT
 #else
 #define SFML_GL_EXT_glGenVertexArrays       glGenVertexArrays
 #define SFML_GL_EXT_glBindVertexArray       glBindVertexArray
 #define SFML_GL_EXT_glDeleteVertexArrays    glDeleteVertexArrays
+#define SFML_GL_EXT_glGenQueries            glGenQueries
+#define SFML_GL_EXT_glDeleteQueries         glDeleteQueries
+#define SFML_GL_EXT_glBeginQuery            glBeginQuery
+#define SFML_GL_EXT_glEndQuery              glEndQuery
+#define SFML_GL_EXT_glGetQueryObjectuiv     glGetQueryObjectuiv
+#define SFML_GL_EXT_glGetQueryObjectui64v   glGetQueryObjectui64v
 #endif
 
 
@@ -51,9 +65,188 @@ namespace priv
 ////////////////////////////////////////////////////////////
 /// \brief Make sure that extensions are initialized
 ///
+/// The functions are loaded and the features detected once,
+/// by the first call, which must be made with a context
+/// current on the calling thread. That thread doesn't have to
+/// be the main thread: the entry points are valid for all the
+/// contexts and threads, and concurrent calls wait for the
+/// first one to finish.
+///
 ////////////////////////////////////////////////////////////
 void ensureExtensionsInit();
 
+////////////////////////////////////////////////////////////
+/// \brief Load only the OpenGL functions that SFML calls
+///
+/// Must be called before the extensions are initialized to
+/// take effect. The other entry points are left NULL.
+///
+/// \see RenderTarget::setMinimalGLLoading
+///
+////////////////////////////////////////////////////////////
+void setMinimalGLLoading(bool enabled);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the breakdown of the initialization time
+///
+/// The loader and capability durations are filled by
+/// ensureExtensionsInit, the others by the render pipeline
+/// and the first RenderWindow::display.
+///
+////////////////////////////////////////////////////////////
+StartupStats& getStartupStats();
+
+////////////////////////////////////////////////////////////
+/// \brief Get the time elapsed since the extensions were initialized
+///
+////////////////////////////////////////////////////////////
+Time getTimeSinceStartup();
+
+////////////////////////////////////////////////////////////
+/// \brief Get the features of the OpenGL context
+///
+/// The features are detected once, when the extensions are
+/// initialized. Fast paths should be selected from them
+/// rather than from versions and extensions.
+///
+////////////////////////////////////////////////////////////
+const GraphicsCaps& getGraphicsCaps();
+
+////////////////////////////////////////////////////////////
+/// \brief Get the OpenGL context current on the calling thread
+///
+/// In the browser, this is the html5 WebGL context handle,
+/// which also identifies the contexts created by SDL and works
+/// on web workers, where SDL can't be used.
+///
+/// \return Handle of the SDL (or WebGL) context, or NULL if none
+///
+////////////////////////////////////////////////////////////
+void* getCurrentContext();
+
+////////////////////////////////////////////////////////////
+/// \brief Check whether instanced drawing is supported
+///
+/// Instancing is core in GL 3.3 and GLES 3.0 (WebGL 2), and
+/// available through the ARB, EXT or ANGLE instanced_arrays
+/// extensions on older contexts.
+///
+////////////////////////////////////////////////////////////
+bool isInstancingAvailable();
+
+////////////////////////////////////////////////////////////
+/// \brief glVertexAttribDivisor, from the core or an extension
+///
+////////////////////////////////////////////////////////////
+void vertexAttribDivisor(GLuint index, GLuint divisor);
+
+////////////////////////////////////////////////////////////
+/// \brief glDrawElementsInstanced, from the core or an extension
+///
+////////////////////////////////////////////////////////////
+void drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instanceCount);
+
+////////////////////////////////////////////////////////////
+/// \brief Check whether several ranges of vertices can be drawn with one call
+///
+/// glMultiDrawArrays is core in OpenGL 1.4, and available
+/// through EXT_multi_draw_arrays on OpenGL ES and through
+/// WEBGL_multi_draw in the browser.
+///
+////////////////////////////////////////////////////////////
+bool isMultiDrawAvailable();
+
+////////////////////////////////////////////////////////////
+/// \brief glMultiDrawArrays, from the core or an extension
+///
+////////////////////////////////////////////////////////////
+void multiDrawArrays(GLenum mode, const GLint* first, const GLsizei* count, GLsizei drawCount);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the internal format to upload compressed data with
+///
+/// The format is accepted if the driver lists it in
+/// GL_COMPRESSED_TEXTURE_FORMATS, or if the extension (or
+/// core version) that defines it is reported. The list is
+/// queried once, the first time a format is checked. ETC1
+/// data is uploaded as ETC2 RGB8 where only ETC2 is
+/// supported, since ETC2 decoders accept ETC1 blocks.
+///
+/// \param format GL_COMPRESSED_* internal format of the data
+///
+/// \return Internal format to pass to glCompressedTexImage2D, 0 if unsupported
+///
+////////////////////////////////////////////////////////////
+GLenum getCompressedUploadFormat(GLenum format);
+
+////////////////////////////////////////////////////////////
+/// \brief Check whether a compressed internal format can be uploaded
+///
+/// The format is accepted if the driver lists it in
+/// GL_COMPRESSED_TEXTURE_FORMATS, or if the extension (or
+/// core version) that defines it is reported. The list is
+/// queried once, the first time a format is checked.
+///
+/// \param format GL_COMPRESSED_* internal format
+///
+////////////////////////////////////////////////////////////
+bool isCompressedFormatAvailable(GLenum format);
+
+////////////////////////////////////////////////////////////
+/// \brief Tell whether 32-bit indices can be drawn
+///
+/// Always true with desktop OpenGL; needs OpenGL ES 3 or
+/// OES_element_index_uint (WebGL 2 or the WebGL 1 extension).
+///
+////////////////////////////////////////////////////////////
+bool isElementIndexUintAvailable();
+
+////////////////////////////////////////////////////////////
+/// \brief Tell the driver that framebuffer contents can be dropped
+///
+/// Applies to the frame buffer bound to GL_FRAMEBUFFER, with
+/// glInvalidateFramebuffer (OpenGL 4.3, OpenGL ES 3, WebGL 2)
+/// or glDiscardFramebufferEXT. Tiled GPUs then neither load
+/// nor store these attachments. Does nothing if neither
+/// function is available, attachments that the frame buffer
+/// doesn't have are ignored.
+///
+/// \param color        Drop the color contents?
+/// \param depthStencil Drop the depth and stencil contents?
+///
+////////////////////////////////////////////////////////////
+void discardFramebuffer(bool color, bool depthStencil);
+
+////////////////////////////////////////////////////////////
+/// \brief Tell whether GL_COMPLETION_STATUS_KHR can be queried
+///
+/// Needs KHR_parallel_shader_compile or ARB_parallel_shader_compile.
+///
+////////////////////////////////////////////////////////////
+bool isParallelShaderCompileAvailable();
+
+////////////////////////////////////////////////////////////
+/// \brief Tell whether linked programs can be saved and reloaded as binaries
+///
+/// Needs OpenGL 4.1 (or ARB_get_program_binary), OpenGL ES 3
+/// or OES_get_program_binary, and at least one binary format
+/// reported by the driver. Always false with WebGL.
+///
+////////////////////////////////////////////////////////////
+bool isProgramBinaryAvailable();
+
+////////////////////////////////////////////////////////////
+/// \brief glGetProgramBinary, from the core or an extension
+///
+////////////////////////////////////////////////////////////
+void getProgramBinary(GLuint program, GLsizei bufferSize, GLsizei* length, GLenum* format, void* binary);
+
+////////////////////////////////////////////////////////////
+/// \brief glProgramBinary, from the core or an extension
+///
+////////////////////////////////////////////////////////////
+void programBinary(GLuint program, GLenum format, const void* binary, GLsizei length);
+
 } // namespace priv
 
 } // namespace sf
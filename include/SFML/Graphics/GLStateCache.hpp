@@ -0,0 +1,350 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GLSTATECACHE_HPP
+#define SFML_GLSTATECACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLCheck.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief CPU-side shadow of the OpenGL state used by SFML
+///
+/// All the bindings made by the graphics module go through
+/// this object, so that redundant calls are skipped without
+/// ever querying the driver with glGet. The shadow is only
+/// valid as long as nobody else changes the OpenGL state;
+/// call invalidate after mixing in raw OpenGL code.
+///
+////////////////////////////////////////////////////////////
+class GLStateCache
+{
+public:
+
+    enum
+    {
+        MaxTextureUnits = 16 ///< Number of texture units tracked by the shadow
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// All the states are initially unknown.
+    ///
+    ////////////////////////////////////////////////////////////
+    GLStateCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget all the shadowed states
+    ///
+    /// The next binding of each state is issued to the driver
+    /// unconditionally, and the next query reads the driver.
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a shader program (glUseProgram)
+    ///
+    ////////////////////////////////////////////////////////////
+    void useProgram(GLuint program);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a vertex array object
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindVertexArray(GLuint vertexArray);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a buffer object to the given target
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindBuffer(GLenum target, GLuint buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a buffer object to an indexed binding point (glBindBufferBase)
+    ///
+    /// The indexed binding is always forwarded to the driver,
+    /// only its side effect on the generic binding of \a target
+    /// is shadowed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Select the active texture unit (glActiveTexture)
+    ///
+    /// \param unit Index of the unit, starting at 0
+    ///
+    ////////////////////////////////////////////////////////////
+    void activeTexture(unsigned int unit);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a 2D texture to the active texture unit
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindTexture(GLuint texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a 2D texture to the given texture unit
+    ///
+    /// The active texture unit is changed to \a unit.
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindTexture(unsigned int unit, GLuint texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a sampler object to the given texture unit
+    ///
+    /// Does nothing if sampler objects are not supported
+    /// (see GraphicsCaps::samplerObjects). 0 restores the
+    /// sampling settings of the textures themselves.
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindSampler(unsigned int unit, GLuint sampler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shared sampler object of a combination of settings
+    ///
+    /// The sampler objects are created on first use and shared
+    /// by all the textures of the context that have the same
+    /// settings; they are destroyed with the context.
+    ///
+    /// \param smooth    Linear filtering?
+    /// \param repeated  Repeat mode instead of clamping to the edges?
+    /// \param mipmapped Sample the mip levels when minifying?
+    ///
+    /// \return Sampler object, or 0 if they are not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    GLuint getSampler(bool smooth, bool repeated, bool mipmapped);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a frame buffer object
+    ///
+    /// \param target GL_FRAMEBUFFER, GL_READ_FRAMEBUFFER or GL_DRAW_FRAMEBUFFER
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindFramebuffer(GLenum target, GLuint frameBuffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable a server-side capability
+    ///
+    /// Only GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_SCISSOR_TEST
+    /// and GL_STENCIL_TEST are shadowed, other capabilities are
+    /// always forwarded to the driver.
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEnabled(GLenum capability, bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the viewport (glViewport)
+    ///
+    ////////////////////////////////////////////////////////////
+    void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the scissor box (glScissor)
+    ///
+    ////////////////////////////////////////////////////////////
+    void scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the blend factors (glBlendFuncSeparate)
+    ///
+    ////////////////////////////////////////////////////////////
+    void blendFunc(GLenum colorSrc, GLenum colorDst, GLenum alphaSrc, GLenum alphaDst);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the blend equations (glBlendEquationSeparate)
+    ///
+    ////////////////////////////////////////////////////////////
+    void blendEquation(GLenum color, GLenum alpha);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bound shader program
+    ///
+    ////////////////////////////////////////////////////////////
+    GLuint getProgram();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bound vertex array object
+    ///
+    ////////////////////////////////////////////////////////////
+    GLuint getVertexArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the buffer object bound to the given target
+    ///
+    ////////////////////////////////////////////////////////////
+    GLuint getBuffer(GLenum target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the active texture unit
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getActiveTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the 2D texture bound to the active texture unit
+    ///
+    ////////////////////////////////////////////////////////////
+    GLuint getTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a server-side capability is enabled
+    ///
+    /// Capabilities that are not shadowed always query the driver.
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isEnabled(GLenum capability);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the frame buffer object bound to the given target
+    ///
+    /// \param target GL_FRAMEBUFFER (same as GL_DRAW_FRAMEBUFFER),
+    ///               GL_READ_FRAMEBUFFER or GL_DRAW_FRAMEBUFFER
+    ///
+    ////////////////////////////////////////////////////////////
+    GLuint getFramebuffer(GLenum target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delete a shader program and forget its binding
+    ///
+    ////////////////////////////////////////////////////////////
+    void deleteProgram(GLuint program);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delete a vertex array object and forget its binding
+    ///
+    ////////////////////////////////////////////////////////////
+    void deleteVertexArray(GLuint vertexArray);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delete a buffer object and forget its bindings
+    ///
+    ////////////////////////////////////////////////////////////
+    void deleteBuffer(GLuint buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delete a texture and forget its bindings
+    ///
+    ////////////////////////////////////////////////////////////
+    void deleteTexture(GLuint texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delete a frame buffer object and forget its bindings
+    ///
+    ////////////////////////////////////////////////////////////
+    void deleteFramebuffer(GLuint frameBuffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delete the shared sampler objects
+    ///
+    /// \see getSampler, releaseGLStateCache
+    ///
+    ////////////////////////////////////////////////////////////
+    void deleteSamplers();
+
+private:
+
+    enum
+    {
+        BufferTargetCount     = 7, ///< Number of shadowed buffer targets
+        CapabilityCount       = 5, ///< Number of shadowed capabilities
+        SamplerCount          = 8  ///< Number of combinations of sampling settings
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map a buffer target to its slot in m_buffers (-1 if not shadowed)
+    ///
+    ////////////////////////////////////////////////////////////
+    static int bufferSlot(GLenum target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map a capability to its slot in m_capabilities (-1 if not shadowed)
+    ///
+    ////////////////////////////////////////////////////////////
+    static int capabilitySlot(GLenum capability);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    GLuint       m_program;                     ///< Bound shader program
+    GLuint       m_vertexArray;                 ///< Bound vertex array object
+    GLuint       m_buffers[BufferTargetCount];  ///< Bound buffer objects, per target
+    unsigned int m_activeTexture;               ///< Active texture unit
+    GLuint       m_textures[MaxTextureUnits];   ///< Bound 2D textures, per unit
+    GLuint       m_samplers[MaxTextureUnits];   ///< Bound sampler objects, per unit
+    GLuint       m_sharedSamplers[SamplerCount]; ///< Sampler objects created by getSampler (0 if not created yet)
+    GLuint       m_readFramebuffer;             ///< Frame buffer bound for reading
+    GLuint       m_drawFramebuffer;             ///< Frame buffer bound for drawing
+    int          m_capabilities[CapabilityCount]; ///< Enabled capabilities (-1 if unknown)
+    GLenum       m_blendFunc[4];                ///< Blend factors
+    GLenum       m_blendEquation[2];            ///< Blend equations
+    GLint        m_viewport[4];                 ///< Viewport (x, y, width, height), width is -1 if unknown
+    GLint        m_scissor[4];                  ///< Scissor box (x, y, width, height), width is -1 if unknown
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Get the OpenGL state shadow of the current context
+///
+/// Each OpenGL context has its own shadow, created the first
+/// time it is requested with the context current.
+///
+////////////////////////////////////////////////////////////
+GLStateCache& getGLStateCache();
+
+////////////////////////////////////////////////////////////
+/// \brief Destroy the OpenGL state shadow of the current context
+///
+/// \see RenderTarget::releaseContext
+///
+////////////////////////////////////////////////////////////
+void releaseGLStateCache();
+
+////////////////////////////////////////////////////////////
+/// \brief Forget the OpenGL state shadows of all the contexts
+///
+/// The contexts are lost, so the shared sampler objects are
+/// not deleted.
+///
+/// \see ContextRestore::restore
+///
+////////////////////////////////////////////////////////////
+void forgetGLStateCaches();
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GLSTATECACHE_HPP
@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GLYPHRASTERIZER_HPP
+#define SFML_GLYPHRASTERIZER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Glyph.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Coverage and metrics of a rasterized glyph
+///
+/// The bitmap is padded by one transparent pixel on each
+/// side, so that filtering doesn't pollute the glyph with
+/// the pixels of its neighbors in the atlas.
+///
+////////////////////////////////////////////////////////////
+struct GlyphBitmap
+{
+    GlyphBitmap() : width(0), height(0) {}
+
+    Glyph              glyph;  ///< Advance and bounds of the glyph (the texture rectangle is left empty)
+    unsigned int       width;  ///< Width of the bitmap, padding included
+    unsigned int       height; ///< Height of the bitmap, padding included
+    std::vector<Uint8> pixels; ///< Coverage of the bitmap, one byte per pixel
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Background thread rendering glyphs with FreeType
+///
+/// FreeType faces can't be used by several threads, so the
+/// rasterizer opens its own library and face on the font
+/// data. Requests are executed in order, and their results
+/// are collected by the owner whenever it is convenient.
+///
+////////////////////////////////////////////////////////////
+class GlyphRasterizer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Glyph to rasterize
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Request
+    {
+        Uint64       key;              ///< Key of the glyph in its table
+        Uint64       generation;       ///< Generation of the tables the request was made for
+        Uint32       index;            ///< Index of the glyph in the font face
+        unsigned int characterSize;    ///< Reference character size
+        bool         bold;             ///< Rasterize the bold version?
+        float        outlineThickness; ///< Thickness of outline
+        bool         distanceField;    ///< Rasterize as a signed distance field?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterized glyph
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        Request     request; ///< The request
+        GlyphBitmap bitmap;  ///< The rasterized glyph
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    GlyphRasterizer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The pending requests are discarded.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GlyphRasterizer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the font and start the thread
+    ///
+    /// \param data        Pointer to the file data in memory, which must stay valid
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return True if the font could be opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool start(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a glyph for rasterization
+    ///
+    ////////////////////////////////////////////////////////////
+    void push(const Request& request);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the results that are ready
+    ///
+    /// \param results Receives the results, in request order
+    /// \param wait    Wait until all the queued requests are done?
+    ///
+    ////////////////////////////////////////////////////////////
+    void collect(std::vector<Result>& results, bool wait);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a glyph with FreeType
+    ///
+    /// The size of the face must already be set.
+    ///
+    /// \param library          FreeType library of the face (FT_Library)
+    /// \param face             FreeType face (FT_Face)
+    /// \param stroker          FreeType stroker of the library (FT_Stroker)
+    /// \param index            Index of the glyph in the font face
+    /// \param bold             Rasterize the bold version?
+    /// \param outlineThickness Thickness of outline
+    /// \param distanceField    Rasterize as a signed distance field?
+    /// \param bitmap           Receives the rasterized glyph
+    ///
+    /// \return True on success, false if the glyph couldn't be loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool rasterize(void* library, void* face, void* stroker, Uint32 index, bool bold, float outlineThickness, bool distanceField, GlyphBitmap& bitmap);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    void*                        m_library;   ///< FreeType library of the thread (FT_Library)
+    void*                        m_face;      ///< FreeType face of the thread (FT_Face)
+    void*                        m_stroker;   ///< FreeType stroker of the thread (FT_Stroker)
+    std::thread                  m_thread;    ///< The thread
+    Mutex                        m_mutex;     ///< Protects the queues and the flags
+    std::condition_variable_any  m_condition; ///< Signals new requests, new results and the stop
+    std::deque<Request>          m_requests;  ///< Requests not started yet
+    std::vector<Result>          m_results;   ///< Results not collected yet
+    bool                         m_busy;      ///< Is the thread rasterizing a request?
+    bool                         m_stop;      ///< Must the thread exit?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GLYPHRASTERIZER_HPP
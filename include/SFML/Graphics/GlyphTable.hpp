@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GLYPHTABLE_HPP
+#define SFML_GLYPHTABLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Glyph.hpp>
+#include <SFML/Config.hpp>
+#include <deque>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Hash table of the glyphs loaded for a character size
+///
+/// The glyphs are stored in insertion order and indexed by an
+/// open-addressing table with linear probing, so that a lookup
+/// touches a couple of contiguous slots instead of walking a
+/// tree. A small direct-mapped cache in front of it catches
+/// the repeated lookups of the same characters, which is what
+/// most texts (and all the ASCII ones) consist of.
+///
+/// References to the entries stay valid until removeOlderThan
+/// is called.
+///
+////////////////////////////////////////////////////////////
+class GlyphTable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Glyph stored in the table
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Entry(Uint64 entryKey, Uint32 glyphIndex, const Glyph& loaded, Uint64 frame) : key(entryKey), index(glyphIndex), glyph(loaded), lastUsedFrame(frame), pending(false) {}
+
+        Uint64 key;           ///< Key of the glyph (glyph index, bold and outline)
+        Uint32 index;         ///< Index of the glyph in the font face
+        Glyph  glyph;         ///< The glyph
+        Uint64 lastUsedFrame; ///< Frame of the last request of the glyph
+        bool   pending;       ///< Is the glyph a placeholder waiting for its rasterization?
+    };
+
+    typedef std::deque<Entry>::iterator Iterator; ///< Iterator over the entries
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    GlyphTable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Search a glyph
+    ///
+    /// \param key Key of the glyph
+    ///
+    /// \return Pointer to the entry, or NULL if the glyph isn't in the table
+    ///
+    ////////////////////////////////////////////////////////////
+    Entry* find(Uint64 key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a glyph that isn't in the table yet
+    ///
+    /// \param key   Key of the glyph
+    /// \param index Index of the glyph in the font face
+    /// \param glyph The glyph
+    /// \param frame Frame of the request
+    ///
+    /// \return The new entry
+    ///
+    ////////////////////////////////////////////////////////////
+    Entry& insert(Uint64 key, Uint32 index, const Glyph& glyph, Uint64 frame);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the glyphs that were last requested before a frame
+    ///
+    /// \param frame First frame of the glyphs to keep
+    ///
+    /// \return True if at least one glyph was removed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool removeOlderThan(Uint64 frame);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an iterator to the first entry
+    ///
+    ////////////////////////////////////////////////////////////
+    Iterator begin();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an iterator past the last entry
+    ///
+    ////////////////////////////////////////////////////////////
+    Iterator end();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory used by the entries and the slots
+    ///
+    /// \return Size of the table, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getMemoryUsage() const;
+
+private:
+
+    enum
+    {
+        RecentCount = 128 ///< Number of slots of the direct-mapped cache
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the slots for the current entries
+    ///
+    /// \param slotCount Number of slots, a power of two
+    ///
+    ////////////////////////////////////////////////////////////
+    void rehash(std::size_t slotCount);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::deque<Entry>   m_entries;             ///< Glyphs, in insertion order
+    std::vector<Uint32> m_slots;               ///< Hash slots: entry index + 1, or 0 if empty
+    Uint32              m_recent[RecentCount]; ///< Last entry found for each low bits of the key (index + 1)
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GLYPHTABLE_HPP
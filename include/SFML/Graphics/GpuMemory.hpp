@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GPUMEMORY_HPP
+#define SFML_GPUMEMORY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Estimate of the video memory used by the graphics module
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API GpuMemory
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Kinds of OpenGL objects that are accounted
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Category
+    {
+        Textures,       ///< Texture storage, including the mipmap levels
+        Renderbuffers,  ///< Depth, stencil and multisample buffers of render textures
+        VertexBuffers,  ///< Storage of sf::VertexBuffer and sf::IndexBuffer objects
+        UniformBuffers, ///< Storage of sf::UniformBuffer objects
+
+        CategoryCount   ///< Keep last -- the total number of categories
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called when the budget is exceeded
+    ///
+    /// \param usage    Total estimated usage, in bytes
+    /// \param budget   Budget that was exceeded, in bytes
+    /// \param userData Pointer given to setBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void (*BudgetCallback)(Uint64 usage, Uint64 budget, void* userData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the estimated usage of a category
+    ///
+    /// \param category Category to query
+    ///
+    /// \return Estimated usage, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getUsage(Category category);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the estimated usage of all the categories
+    ///
+    /// \return Estimated usage, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getTotalUsage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the memory budget
+    ///
+    /// The callback is called after every allocation that
+    /// leaves the total usage above the budget, until enough
+    /// resources are released. It may destroy resources, but
+    /// allocations made from inside the callback don't call
+    /// it again.
+    ///
+    /// \param budget   Budget, in bytes (0 to disable)
+    /// \param callback Function to call when the budget is exceeded
+    /// \param userData Pointer passed back to the callback
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBudget(Uint64 budget, BudgetCallback callback, void* userData = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory budget
+    ///
+    /// \return Budget, in bytes (0 if disabled)
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getBudget();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of the current frame
+    ///
+    /// The index starts at 0 and is incremented by
+    /// RenderTarget::resetFrameStats. Compare it with
+    /// Texture::getLastUsedFrame to find textures that
+    /// haven't been drawn for a while.
+    ///
+    /// \return Index of the current frame
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getCurrentFrame();
+};
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Replace the accounted size of an OpenGL object
+///
+/// \param category Category of the object
+/// \param oldSize  Size previously accounted for the object, in bytes
+/// \param newSize  New size of the object, in bytes (0 when destroyed)
+///
+////////////////////////////////////////////////////////////
+void trackGpuMemory(GpuMemory::Category category, Uint64 oldSize, Uint64 newSize);
+
+////////////////////////////////////////////////////////////
+/// \brief Start a new frame for the last-use stamps
+///
+////////////////////////////////////////////////////////////
+void advanceGpuMemoryFrame();
+
+////////////////////////////////////////////////////////////
+/// \brief Stamp a texture with the current frame
+///
+/// Called by the render pipeline for every textured draw.
+///
+////////////////////////////////////////////////////////////
+void markTextureUsed(const Texture& texture);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GPUMEMORY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GpuMemory
+/// \ingroup graphics
+///
+/// sf::GpuMemory keeps an estimate of the video memory held
+/// by textures, render texture buffers and vertex buffers.
+/// The sizes are computed from the dimensions and formats
+/// requested to OpenGL; drivers may add padding or
+/// compression of their own, so treat the figures as a
+/// lower bound rather than an exact measure.
+///
+/// A budget can be set together with a callback, which is
+/// the place to release resources that haven't been used
+/// recently. Every texture remembers the last frame it was
+/// drawn in (see Texture::getLastUsedFrame), which gives a
+/// simple least-recently-used order.
+///
+/// Usage example:
+/// \code
+/// void onBudgetExceeded(sf::Uint64 usage, sf::Uint64 budget, void* userData)
+/// {
+///     TextureCache& cache = *static_cast<TextureCache*>(userData);
+///     cache.evictOlderThan(sf::GpuMemory::getCurrentFrame() - 60);
+/// }
+///
+/// sf::GpuMemory::setBudget(256 * 1024 * 1024, &onBudgetExceeded, &cache);
+/// \endcode
+///
+/// \see sf::Texture, sf::RenderStats
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GPUPROFILER_HPP
+#define SFML_GPUPROFILER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Measure the GPU time spent in named scopes
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API GpuProfiler : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief GPU time measured for a scope
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        std::string  name;  ///< Name of the scope
+        unsigned int depth; ///< Nesting depth, 0 for top-level scopes
+        Time         time;  ///< GPU time, including the nested scopes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief RAII helper measuring the enclosing block
+    ///
+    /// The scope is measured by the active profiler (see
+    /// setActive), and costs nothing if there is none.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API Scope : NonCopyable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Begin a scope in the active profiler
+        ///
+        /// \param name Name of the scope
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Scope(const char* name);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief End the scope
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Scope();
+
+    private:
+
+        GpuProfiler* m_profiler; ///< Profiler measuring the scope
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    GpuProfiler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GpuProfiler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the system supports GPU timer queries
+    ///
+    /// Timer queries require GL 3.3 or GL_ARB_timer_query on
+    /// desktop, and GL_EXT_disjoint_timer_query on GLES/WebGL.
+    /// Without them, scopes are ignored and no result is ever
+    /// produced.
+    ///
+    /// \return True if GPU timing is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make this profiler the one measuring the scopes
+    ///
+    /// The active profiler also measures the scopes placed by
+    /// SFML itself (batch flushes, RenderTexture::display).
+    /// Only one profiler can be active at a time.
+    ///
+    /// \param active True to activate, false to deactivate
+    ///
+    ////////////////////////////////////////////////////////////
+    void setActive(bool active);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the active profiler
+    ///
+    /// \return Pointer to the active profiler, or NULL if none
+    ///
+    ////////////////////////////////////////////////////////////
+    static GpuProfiler* getActive();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Begin a named scope
+    ///
+    /// Scopes can be nested, each begin must be matched by a
+    /// call to end within the same frame.
+    ///
+    /// \param name Name of the scope
+    ///
+    ////////////////////////////////////////////////////////////
+    void begin(const char* name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End the last scope that was begun
+    ///
+    ////////////////////////////////////////////////////////////
+    void end();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the end of a frame
+    ///
+    /// This function collects the results of the frames whose
+    /// queries are available, without waiting for the GPU. The
+    /// results are therefore a few frames late.
+    ///
+    ////////////////////////////////////////////////////////////
+    void frame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the results of the last frame measured
+    ///
+    /// Results are listed in the order their scopes began.
+    ///
+    /// \return Results of the last measured frame
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<Result>& getResults() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scope recorded during a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Record
+    {
+        std::string  name;   ///< Name of the scope
+        std::size_t  parent; ///< Index of the enclosing scope
+        unsigned int depth;  ///< Nesting depth
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Timer query measuring a part of a scope
+    ///
+    /// Elapsed time queries can't be nested, so the query of a
+    /// scope is interrupted while its nested scopes run.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Segment
+    {
+        unsigned int query;  ///< Timer query
+        std::size_t  record; ///< Index of the scope
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scopes and queries of a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Frame
+    {
+        std::vector<Record>  records;  ///< Scopes of the frame
+        std::vector<Segment> segments; ///< Queries of the frame
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a timer query for the given scope
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginSegment(std::size_t record);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the queries of a frame to the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    void recycle(Frame& frame);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Frame                     m_current;  ///< Frame being recorded
+    std::vector<Frame>        m_pending;  ///< Frames waiting for their results, oldest first
+    std::vector<std::size_t>  m_stack;    ///< Scopes currently open
+    std::vector<unsigned int> m_queries;  ///< Pool of unused queries
+    std::vector<Result>       m_results;  ///< Results of the last measured frame
+};
+
+} // namespace sf
+
+
+#endif // SFML_GPUPROFILER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GpuProfiler
+/// \ingroup graphics
+///
+/// CPU timing tells little about the time the GPU spends on
+/// each part of a frame, since OpenGL commands run
+/// asynchronously. sf::GpuProfiler measures named scopes with
+/// OpenGL timer queries, and delivers their results a few
+/// frames later, once the GPU is done, without stalling.
+///
+/// When a profiler is active, SFML also measures its own batch
+/// flushes and RenderTexture::display calls.
+///
+/// Usage example:
+/// \code
+/// sf::GpuProfiler profiler;
+/// profiler.setActive(true);
+///
+/// while (running)
+/// {
+///     {
+///         sf::GpuProfiler::Scope scope("world");
+///         drawWorld(window);
+///     }
+///     {
+///         sf::GpuProfiler::Scope scope("ui");
+///         drawUi(window);
+///     }
+///     window.flush();
+///     swapBuffers();
+///     profiler.frame();
+///
+///     for (const sf::GpuProfiler::Result& result : profiler.getResults())
+///         overlay.show(result.name, result.depth, result.time);
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
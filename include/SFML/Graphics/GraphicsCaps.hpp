@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GRAPHICSCAPS_HPP
+#define SFML_GRAPHICSCAPS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Features of the OpenGL context used by the graphics module
+///
+////////////////////////////////////////////////////////////
+struct SFML_GRAPHICS_API GraphicsCaps
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Capability tiers of the supported contexts
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Tier
+    {
+        TierES2,  ///< OpenGL ES 2 or WebGL 1, features come from extensions only
+        TierES3,  ///< OpenGL ES 3 or WebGL 2
+        TierGL2,  ///< Desktop OpenGL older than 3.3
+        TierGL33, ///< Desktop OpenGL 3.3
+        TierGL4   ///< Desktop OpenGL 4.0 or newer
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The tier is set to TierES2, and all the features to false.
+    ///
+    ////////////////////////////////////////////////////////////
+    GraphicsCaps();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Tier tier;                  ///< Capability tier of the context
+    int  majorVersion;          ///< Major version of the context
+    int  minorVersion;          ///< Minor version of the context
+    bool instancing;            ///< Instanced drawing, from the core or an extension
+    bool multiDraw;             ///< Several vertex ranges drawn with one call (glMultiDrawArrays)
+    bool mapBufferRange;        ///< Buffers can be mapped (glMapBufferRange), never in WebGL
+    bool fenceSync;             ///< Sync objects can be waited for (glFenceSync)
+    bool drawBaseVertex;        ///< Indices can be offset by a base vertex
+    bool textureStorage;        ///< Immutable texture storage (glTexStorage2D)
+    bool invalidateFramebuffer; ///< Framebuffer contents can be dropped (glInvalidateFramebuffer or glDiscardFramebufferEXT)
+    bool unpackRowLength;       ///< Sub-rectangles of client memory can be uploaded (GL_UNPACK_ROW_LENGTH)
+    bool elementIndexUint;      ///< 32-bit indices can be drawn
+    bool uniformBuffers;        ///< Uniform buffer objects
+    bool textureArrays;         ///< 2D texture arrays
+    bool timerQueries;          ///< GPU timestamps (GL_TIME_ELAPSED queries)
+    bool samplerObjects;        ///< Sampling settings separate from the textures (glGenSamplers)
+};
+
+} // namespace sf
+
+
+#endif // SFML_GRAPHICSCAPS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GraphicsCaps
+/// \ingroup graphics
+///
+/// sf::GraphicsCaps describes what the OpenGL context can do.
+/// It is filled once, when the graphics module loads the
+/// OpenGL functions, and the graphics module then picks its
+/// fast paths (instanced sprites, unsynchronized buffer
+/// mapping, direct sub-rectangle uploads, framebuffer
+/// invalidation...) from it rather than checking versions
+/// and extensions at each call.
+///
+/// The tier gives a quick summary: TierES2 covers the
+/// contexts where every feature needs an extension, TierES3
+/// the WebGL 2 and OpenGL ES 3 contexts, and the desktop
+/// tiers follow the OpenGL version. Each feature flag already
+/// takes the extensions of lower tiers into account, so it
+/// should be preferred over the tier to select a code path.
+///
+/// Usage example:
+/// \code
+/// const sf::GraphicsCaps& caps = window.getGraphicsCaps();
+/// if (caps.instancing)
+///     useSpriteBatches();
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/MemoryStats.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <string>
 #include <vector>
@@ -37,6 +38,7 @@
 
 namespace sf
 {
+class ImageView;
 class InputStream;
 
 ////////////////////////////////////////////////////////////
@@ -47,6 +49,36 @@ class SFML_GRAPHICS_API Image
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters used to resample an image
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ResampleFilter
+    {
+        BoxFilter,      ///< Average of the covered pixels (nearest pixel when enlarging), fast but slightly blurry
+        KaiserFilter,   ///< Kaiser-windowed sinc, sharper results at a higher cost
+        BilinearFilter, ///< Linear interpolation, widened when shrinking so that no pixel is skipped
+        LanczosFilter   ///< Lanczos-windowed sinc (3 lobes), the sharpest and most expensive
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters used to compute the levels of a mip chain
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef ResampleFilter MipmapFilter;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Storage formats of the pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    enum PixelFormat
+    {
+        RGBA8,    ///< 8 bits per channel, red, green, blue and alpha (default)
+        RGB565,   ///< 16 bits per pixel, 5 bits of red, 6 of green and 5 of blue, always opaque
+        RGBA4444, ///< 16 bits per pixel, 4 bits per channel
+        R8        ///< 8 bits of red only, read as white with the red channel as alpha (masks)
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -55,12 +87,51 @@ public:
     ////////////////////////////////////////////////////////////
     Image();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Image(const Image& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The pixels are taken from \a right without being copied,
+    /// \a right is left empty.
+    ///
+    /// \param right Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    Image(Image&& right) noexcept;
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
     ////////////////////////////////////////////////////////////
     ~Image();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Image& operator =(const Image& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of move assignment operator
+    ///
+    /// \param right Instance to move, left empty
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Image& operator =(Image&& right) noexcept;
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the image and fill it with a unique color
     ///
@@ -86,11 +157,23 @@ public:
     ////////////////////////////////////////////////////////////
     void create(unsigned int width, unsigned int height, const Uint8* pixels);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the image from a view of pixels
+    ///
+    /// The rows of the view are copied one after the other,
+    /// the view may point to a rectangle of this image.
+    /// If \a source is empty, an empty image is created.
+    ///
+    /// \param source View of the pixels to copy to the image
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(const ImageView& source);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file in memory
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
+    /// psd, hdr, pic and qoi. Some format options are not supported,
     /// like progressive jpeg.
     /// If this function fails, the image is left unchanged.
     ///
@@ -108,7 +191,7 @@ public:
     /// \brief Load the image from a custom stream
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
+    /// psd, hdr, pic and qoi. Some format options are not supported,
     /// like progressive jpeg.
     /// If this function fails, the image is left unchanged.
     ///
@@ -126,7 +209,7 @@ public:
     ///
     /// The format of the image is automatically deduced from
     /// the extension. The supported image formats are bmp, png,
-    /// tga and jpg. The destination file is overwritten
+    /// tga, jpg and qoi. The destination file is overwritten
     /// if it already exists. This function fails if the image is empty.
     ///
     /// \param filename Path of the file to save
@@ -138,6 +221,24 @@ public:
     ////////////////////////////////////////////////////////////
     bool saveToFile(const std::string& filename) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the image to a buffer in memory
+    ///
+    /// The format of the image must be specified.
+    /// The supported image formats are bmp, png, tga, jpg and qoi.
+    /// This function fails if the image is empty, or if
+    /// the format was invalid.
+    ///
+    /// \param output Buffer to fill with encoded data
+    /// \param format Encoding format to use
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see create, loadFromFile, loadFromMemory, saveToFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToMemory(std::vector<Uint8>& output, const std::string& format) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size (width and height) of the image
     ///
@@ -181,12 +282,29 @@ public:
     ////////////////////////////////////////////////////////////
     void copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect = IntRect(0, 0, 0, 0), bool applyAlpha = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the pixels of a view onto this image
+    ///
+    /// This is the same as the overload taking a source image
+    /// and rectangle, for pixels that are not owned by an
+    /// image (or only by a part of it). The view must not
+    /// overlap the destination area of this image.
+    ///
+    /// \param source     View of the pixels to copy
+    /// \param destX      X coordinate of the destination position
+    /// \param destY      Y coordinate of the destination position
+    /// \param applyAlpha Should the copy take into account the source transparency?
+    ///
+    ////////////////////////////////////////////////////////////
+    void copy(const ImageView& source, unsigned int destX, unsigned int destY, bool applyAlpha = false);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the color of a pixel
     ///
     /// This function doesn't check the validity of the pixel
     /// coordinates, using out-of-range values will result in
-    /// an undefined behavior.
+    /// an undefined behavior. The color is truncated to the
+    /// precision of the storage format of the image.
     ///
     /// \param x     X coordinate of pixel to change
     /// \param y     Y coordinate of pixel to change
@@ -202,7 +320,8 @@ public:
     ///
     /// This function doesn't check the validity of the pixel
     /// coordinates, using out-of-range values will result in
-    /// an undefined behavior.
+    /// an undefined behavior. Pixels of the reduced formats
+    /// are expanded to 8 bits per channel.
     ///
     /// \param x X coordinate of pixel to get
     /// \param y Y coordinate of pixel to get
@@ -220,6 +339,9 @@ public:
     /// The returned value points to an array of RGBA pixels made of
     /// 8 bits integers components. The size of the array is
     /// width * height * 4 (getSize().x * getSize().y * 4).
+    /// Images converted to another format (see convert) return
+    /// width * height pixels of that format instead, 16-bit
+    /// pixels being stored in the native byte order.
     /// Warning: the returned pointer may become invalid if you
     /// modify the image, so you should never store it for too long.
     /// If the image is empty, a null pointer is returned.
@@ -229,6 +351,66 @@ public:
     ////////////////////////////////////////////////////////////
     const Uint8* getPixelsPtr() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the pixels to another storage format
+    ///
+    /// RGB565 and RGBA4444 halve the memory of the image, R8
+    /// quarters it; they are meant for opaque backgrounds and
+    /// masks, and are uploaded as is to textures of the same
+    /// format (see Texture::loadFromImage). Reducing the
+    /// precision of the pixels bands smooth gradients, unless
+    /// \a dither is true: a 4x4 ordered dither pattern is then
+    /// added to the pixels before their low bits are dropped.
+    ///
+    /// The functions that modify the pixels other than
+    /// setPixel and the flips (copy, resize, createMaskFromColor,
+    /// premultiplyAlpha...) convert the image back to RGBA8
+    /// first; so does loading or creating the image. The other
+    /// classes of SFML that read the pixels of an image, except
+    /// sf::Texture, expect RGBA8 images.
+    ///
+    /// This function doesn't use OpenGL, it can be called from
+    /// any thread.
+    ///
+    /// \param format New storage format of the pixels
+    /// \param dither Dither the pixels when reducing their precision?
+    ///
+    /// \see getPixelFormat
+    ///
+    ////////////////////////////////////////////////////////////
+    void convert(PixelFormat format, bool dither = true);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the storage format of the pixels
+    ///
+    /// \return Format of the array returned by getPixelsPtr
+    ///
+    /// \see convert
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelFormat getPixelFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a pixel in a given storage format
+    ///
+    /// \param format Storage format
+    ///
+    /// \return Size of a pixel, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getBytesPerPixel(PixelFormat format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether all the pixels of the image are opaque
+    ///
+    /// The pixels are scanned on each call, with SIMD
+    /// instructions when they are available.
+    ///
+    /// \return True if the alpha of every pixel is 255 (false if the image is empty)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isOpaque() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Flip the image horizontally (left <-> right)
     ///
@@ -241,13 +423,91 @@ public:
     ////////////////////////////////////////////////////////////
     void flipVertically();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply the color components of each pixel by its alpha
+    ///
+    /// Premultiplied pixels are meant to be drawn with the
+    /// sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha)
+    /// blend mode. The color of fully transparent pixels is lost.
+    ///
+    /// \see unpremultiplyAlpha
+    ///
+    ////////////////////////////////////////////////////////////
+    void premultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Divide the color components of each pixel by its alpha
+    ///
+    /// This is the inverse of premultiplyAlpha, up to rounding.
+    ///
+    /// \see premultiplyAlpha
+    ///
+    ////////////////////////////////////////////////////////////
+    void unpremultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resample the image to a new size
+    ///
+    /// The filter is separable (rows then columns) and uses the
+    /// SIMD instructions of the target when they are available.
+    /// Like generateMipChain, the colors are weighted by their
+    /// alpha while filtering, and filtered in linear space when
+    /// \a sRgb is true.
+    ///
+    /// Large images can be split across \a threadCount threads
+    /// of the scheduler of sf::JobSystem (0 to use all of them),
+    /// the calling thread being one of them. This function doesn't use
+    /// OpenGL, it can be called from any thread.
+    ///
+    /// If \a size is empty the image is emptied.
+    ///
+    /// \param size        New size of the image, in pixels
+    /// \param filter      Filter used to compute the new pixels
+    /// \param sRgb        True if the pixels are sRGB encoded
+    /// \param threadCount Maximum number of threads to use
+    ///
+    /// \see generateMipChain
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(const Vector2u& size, ResampleFilter filter = BilinearFilter, bool sRgb = false, unsigned int threadCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the mip chain of the image on the CPU
+    ///
+    /// Each level halves the dimensions of the previous one
+    /// (rounding down, never below 1), down to 1x1. \a levels
+    /// receives the levels below the image itself, ready to be
+    /// passed to Texture::loadFromImageWithMips.
+    ///
+    /// The colors are weighted by their alpha while filtering,
+    /// so that transparent pixels don't bleed into their
+    /// neighbours. When \a sRgb is true, the colors are filtered
+    /// in linear space, which keeps the levels of sRGB textures
+    /// from getting darker.
+    ///
+    /// This function doesn't use OpenGL, it can be called from
+    /// any thread (typically a worker thread, after decoding).
+    ///
+    /// \param levels Vector to fill with the levels of the chain
+    /// \param filter Filter used to compute the levels
+    /// \param sRgb   True if the pixels are sRGB encoded
+    ///
+    /// \see Texture::loadFromImageWithMips, resize
+    ///
+    ////////////////////////////////////////////////////////////
+    void generateMipChain(std::vector<Image>& levels, MipmapFilter filter = BoxFilter, bool sRgb = false) const;
+
 private:
 
+    friend class Texture;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u           m_size;   ///< Image size
-    std::vector<Uint8> m_pixels; ///< Pixels of the image
+    Vector2u            m_size;   ///< Image size
+    std::vector<Uint8>  m_pixels; ///< Pixels of the image
+    PixelFormat         m_format; ///< Storage format of the pixels
+    priv::MemoryCounter m_memory; ///< Accounted size of the pixels
 };
 
 } // namespace sf
@@ -265,14 +525,15 @@ private:
 /// functions to load, read, write and save pixels, as well
 /// as many other useful functions.
 ///
-/// sf::Image can handle a unique internal representation of
-/// pixels, which is RGBA 32 bits. This means that a pixel
-/// must be composed of 8 bits red, green, blue and alpha
-/// channels -- just like a sf::Color.
+/// The internal representation of the pixels is RGBA 32 bits.
+/// This means that a pixel must be composed of 8 bits red,
+/// green, blue and alpha channels -- just like a sf::Color.
 /// All the functions that return an array of pixels follow
 /// this rule, and all parameters that you pass to sf::Image
 /// functions (such as loadFromMemory) must use this
-/// representation as well.
+/// representation as well. To save memory, an image can then
+/// be converted to 16 bits (RGB565, RGBA4444) or single
+/// channel (R8) pixels, see convert.
 ///
 /// A sf::Image can be copied, but it is a heavy resource and
 /// if possible you should always use [const] references to
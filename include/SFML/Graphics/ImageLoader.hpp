@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Config.hpp>
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <string>
@@ -37,6 +38,7 @@
 
 namespace sf
 {
+class ImageView;
 class InputStream;
 
 namespace priv
@@ -49,6 +51,26 @@ class ImageLoader : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Image of a batch loaded by loadBatch
+    ///
+    /// Each item is decoded either from memory or, when
+    /// \a stream is not NULL, from a stream. A stream must not
+    /// be shared by several items of the same batch.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct BatchItem
+    {
+        BatchItem() : data(NULL), dataSize(0), stream(NULL), success(false) {}
+
+        const void*        data;     ///< Pointer to the file data in memory
+        std::size_t        dataSize; ///< Size of the data to load, in bytes
+        InputStream*       stream;   ///< Source stream to read from, instead of the data in memory
+        std::vector<Uint8> pixels;   ///< Receives the loaded pixels
+        Vector2u           size;     ///< Receives the size of the loaded image, in pixels
+        bool               success;  ///< Receives whether loading was successful
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the unique instance of the class
     ///
@@ -82,6 +104,73 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode an image from a file in memory, without copying it
+    ///
+    /// The returned RGBA pixels are owned by the decoder, they
+    /// must be released with freeDecodedPixels. This avoids the
+    /// extra copy (and peak memory) of loadImageFromMemory for
+    /// pixels that are only uploaded to a texture.
+    ///
+    /// \param data     Pointer to the file data in memory
+    /// \param dataSize Size of the data to load, in bytes
+    /// \param size     Size of loaded image, in pixels
+    ///
+    /// \return Pointer to the decoded pixels, or NULL on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* decodeImageFromMemory(const void* data, std::size_t dataSize, Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode an image from a custom stream, without copying it
+    ///
+    /// \param stream Source stream to read from
+    /// \param size   Size of loaded image, in pixels
+    ///
+    /// \return Pointer to the decoded pixels, or NULL on failure
+    ///
+    /// \see decodeImageFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* decodeImageFromStream(InputStream& stream, Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release pixels returned by one of the decode functions
+    ///
+    /// The decoded pixels are accounted to MemoryStats::Loaders
+    /// until they are released.
+    ///
+    /// \param pixels Pixels to release (NULL is allowed)
+    /// \param size   Size of the image, as returned by the decode function
+    ///
+    ////////////////////////////////////////////////////////////
+    void freeDecodedPixels(Uint8* pixels, const Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load several images in parallel
+    ///
+    /// The items are decoded by the jobs of the scheduler of
+    /// sf::JobSystem, the calling thread included, and the
+    /// function returns when all of them are done. Failures are reported to sf::err()
+    /// by the calling thread, in the order of the items.
+    ///
+    /// \param items       Images to load
+    /// \param threadCount Maximum number of threads decoding at the same time (0 to use all the threads of the scheduler)
+    ///
+    /// \return Number of images that were successfully loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t loadBatch(std::vector<BatchItem>& items, unsigned int threadCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply the color components of RGBA pixels by their alpha
+    ///
+    /// \param pixels     Array of pixels to convert in place
+    /// \param pixelCount Number of pixels in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    static void premultiplyAlpha(Uint8* pixels, std::size_t pixelCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an image file
     ///
@@ -94,6 +183,19 @@ public:
     ////////////////////////////////////////////////////////////
     bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Save an array of pixels as an encoded image buffer
+    ///
+    /// \param format Must be "bmp", "png", "tga" or "jpg"/"jpeg".
+    /// \param output Buffer to fill with encoded data
+    /// \param pixels Array of pixels to save to image
+    /// \param size   Size of image to save, in pixels
+    ///
+    /// \return True if saving was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveImageToMemory(const std::string& format, std::vector<Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -109,6 +211,54 @@ private:
     ~ImageLoader();
 };
 
+////////////////////////////////////////////////////////////
+/// \brief Tell whether all the pixels of an array have an alpha of 255
+///
+/// \param pixels Pointer to the RGBA pixels
+/// \param count  Number of pixels
+///
+/// \return True if every pixel is opaque
+///
+////////////////////////////////////////////////////////////
+bool arePixelsOpaque(const Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Tell whether all the pixels of a view have an alpha of 255
+///
+/// \param pixels View of the RGBA pixels
+///
+/// \return True if every pixel is opaque
+///
+////////////////////////////////////////////////////////////
+bool arePixelsOpaque(const ImageView& pixels);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert a row of RGBA8 pixels to another storage format
+///
+/// The 16-bit formats are rounded down, after an ordered
+/// dither pattern is added to the pixels if \a dither is true.
+///
+/// \param source RGBA8 pixels of the row
+/// \param width  Number of pixels of the row
+/// \param y      Index of the row, selects the line of the dither pattern
+/// \param format Format of the converted pixels
+/// \param dither Dither the pixels when reducing their precision?
+/// \param dest   Array receiving the width converted pixels
+///
+////////////////////////////////////////////////////////////
+void packPixels(const Uint8* source, unsigned int width, unsigned int y, Image::PixelFormat format, bool dither, Uint8* dest);
+
+////////////////////////////////////////////////////////////
+/// \brief Expand pixels of a given storage format to RGBA8
+///
+/// \param source Pixels to expand
+/// \param count  Number of pixels
+/// \param format Format of the source pixels
+/// \param dest   Array receiving the count RGBA8 pixels
+///
+////////////////////////////////////////////////////////////
+void unpackPixels(const Uint8* source, std::size_t count, Image::PixelFormat format, Uint8* dest);
+
 } // namespace priv
 
 } // namespace sf
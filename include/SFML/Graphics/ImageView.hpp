@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAGEVIEW_HPP
+#define SFML_IMAGEVIEW_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Non-owning view of a rectangle of RGBA pixels
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageView
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty view.
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a view of a whole image
+    ///
+    /// Views are made of RGBA8 pixels: the view of an image
+    /// converted to another format is empty.
+    ///
+    /// \param image Image to view
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a view of a rectangle of an image
+    ///
+    /// The rectangle is clamped to the bounds of the image.
+    /// If its width or height is 0, the whole image is viewed.
+    ///
+    /// \param image Image to view
+    /// \param area  Rectangle of the image to view
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Image& image, const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a view of an array of RGBA pixels
+    ///
+    /// \param pixels Pointer to the first pixel of the view
+    /// \param width  Width of the view, in pixels
+    /// \param height Height of the view, in pixels
+    /// \param stride Distance between the starts of two rows,
+    ///               in bytes (0 means width * 4, tightly packed)
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Uint8* pixels, unsigned int width, unsigned int height, std::size_t stride = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a view of a rectangle of this view
+    ///
+    /// The rectangle is clamped to the bounds of the view.
+    /// If its width or height is 0, the whole view is returned.
+    ///
+    /// \param area Rectangle to view, relative to this view
+    ///
+    /// \return View of the rectangle, sharing the same pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView subView(const IntRect& area) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the first pixel of the view
+    ///
+    /// \return Pointer to the pixels, or NULL if the view is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* getPixelsPtr() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the first pixel of a row
+    ///
+    /// The row index is not checked.
+    ///
+    /// \param y Index of the row
+    ///
+    /// \return Pointer to the \a width pixels of the row
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* getRow(unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the view
+    ///
+    /// \return Size of the view, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the distance between the starts of two rows
+    ///
+    /// \return Stride of the rows, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getStride() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the rows of the view are tightly packed
+    ///
+    /// Contiguous views can be processed as a single array
+    /// of width * height pixels.
+    ///
+    /// \return True if the stride is width * 4
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isContiguous() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the view contains no pixel
+    ///
+    /// \return True if the width or the height is 0
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isEmpty() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Uint8* m_pixels; ///< First pixel of the view
+    Vector2u     m_size;   ///< Size of the view, in pixels
+    std::size_t  m_stride; ///< Distance between the starts of two rows, in bytes
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEVIEW_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageView
+/// \ingroup graphics
+///
+/// sf::ImageView points to a rectangle of RGBA pixels owned
+/// by someone else: a sf::Image, a decoder buffer, a mapped
+/// file... Its rows don't have to be contiguous, so a sprite
+/// of a sheet, or a tile of a larger picture, can be copied
+/// or uploaded without extracting it to a new image first.
+///
+/// The view doesn't copy anything: the pixels must stay
+/// valid, and the image unmodified, as long as the view is
+/// used. Views are cheap to copy and are meant to be passed
+/// by value or const reference, then thrown away.
+///
+/// sf::Image::copy, sf::Image::create, sf::Texture::loadFromImage
+/// and sf::Texture::update accept views. sf::Image converts
+/// implicitly to a view of all its pixels.
+///
+/// Usage example:
+/// \code
+/// sf::Image sheet;
+/// sheet.loadFromFile("sheet.png");
+///
+/// // Upload the second frame of the sheet, without copying it on the CPU
+/// sf::ImageView frame(sheet, sf::IntRect(32, 0, 32, 32));
+/// sf::Texture texture;
+/// texture.loadFromImage(frame);
+///
+/// // Then replace it by the third one
+/// texture.update(sf::ImageView(sheet, sf::IntRect(64, 0, 32, 32)), 0, 0);
+/// \endcode
+///
+/// \see sf::Image, sf::Texture
+///
+////////////////////////////////////////////////////////////
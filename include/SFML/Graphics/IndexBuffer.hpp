@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_INDEXBUFFER_HPP
+#define SFML_INDEXBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Buffer of vertex indices stored in graphics memory
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API IndexBuffer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Types of the indices
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Type
+    {
+        UnsignedShort, ///< 16-bit indices, to address up to 65536 vertices
+        UnsignedInt    ///< 32-bit indices, see isAvailable
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty buffer of 16-bit indices.
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the buffer with a type of index and a usage
+    ///
+    /// \param type  Type of the indices
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit IndexBuffer(Type type, VertexBuffer::Usage usage = VertexBuffer::Static);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~IndexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the index buffer
+    ///
+    /// Allocates enough graphics memory to hold \a indexCount
+    /// indices. The contents of the buffer are undefined.
+    ///
+    /// \param indexCount Number of indices worth of memory to allocate
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t indexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the index count
+    ///
+    /// \return Number of indices in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getIndexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a buffer of 16-bit indices
+    ///
+    /// The rules on \a offset and \a indexCount are the same as
+    /// sf::VertexBuffer::update: with \a offset 0, the buffer
+    /// grows to \a indexCount if needed.
+    ///
+    /// \param indices    Array of indices to copy to the buffer
+    /// \param indexCount Number of indices to copy
+    /// \param offset     Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint16* indices, std::size_t indexCount, unsigned int offset = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a buffer of 32-bit indices
+    ///
+    /// \param indices    Array of indices to copy to the buffer
+    /// \param indexCount Number of indices to copy
+    /// \param offset     Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint32* indices, std::size_t indexCount, unsigned int offset = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the type of the indices
+    ///
+    /// \return Type of the indices
+    ///
+    ////////////////////////////////////////////////////////////
+    Type getType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the usage specifier of the buffer
+    ///
+    /// \return Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexBuffer::Usage getUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the buffer
+    ///
+    /// \return OpenGL handle of the buffer or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a type of index is supported
+    ///
+    /// 16-bit indices are always supported. 32-bit indices
+    /// need OpenGL ES 3, WebGL 2 or OES_element_index_uint;
+    /// they are always supported by desktop OpenGL.
+    ///
+    /// \param type Type of index
+    ///
+    /// \return True if the indices can be drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable(Type type);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload indices of the type of the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    bool upload(const void* indices, std::size_t indexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size in bytes of an index
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getStride() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int        m_buffer; ///< Element buffer handle
+    std::size_t         m_size;   ///< Size in indices of the currently allocated buffer
+    Type                m_type;   ///< Type of the indices
+    VertexBuffer::Usage m_usage;  ///< How the buffer is to be used
+};
+
+} // namespace sf
+
+
+#endif // SFML_INDEXBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::IndexBuffer
+/// \ingroup graphics
+///
+/// sf::IndexBuffer stores indices into the vertices of a
+/// sf::VertexBuffer, in graphics memory. Drawing both with
+/// RenderTarget::draw(const VertexBuffer&, const IndexBuffer&)
+/// lets the primitives share their vertices instead of
+/// duplicating them: a grid of quads drawn as sf::Triangles
+/// needs 4 vertices per quad and 6 indices, instead of 6
+/// full vertices, and neighbouring quads can share their
+/// corners too.
+///
+/// The primitive type of the vertex buffer tells how the
+/// indexed vertices are assembled; sf::Quads is not supported
+/// by indexed draws, use sf::Triangles instead.
+///
+/// Usage example:
+/// \code
+/// sf::VertexBuffer vertices(sf::Triangles, sf::VertexBuffer::Static);
+/// vertices.create(4);
+/// vertices.update(corners);
+///
+/// const sf::Uint16 quad[] = {0, 1, 2, 0, 2, 3};
+/// sf::IndexBuffer indices;
+/// indices.create(6);
+/// indices.update(quad, 6);
+///
+/// window.draw(vertices, indices, &texture);
+/// \endcode
+///
+/// \see sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_MEMORYSTATS_HPP
+#define SFML_MEMORYSTATS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Accounting of the CPU memory used by the graphics
+///        module, per subsystem
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API MemoryStats
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Subsystems whose memory is accounted
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Tag
+    {
+        Images,       ///< Pixels of sf::Image objects
+        Fonts,        ///< Glyph tables, coverage buffers and FreeType internals of sf::Font objects
+        TextGeometry, ///< Vertices and layout data of sf::Text objects
+        Shaders,      ///< Uniform and texture tables of sf::Shader objects
+        Loaders,      ///< Pixels decoded by the image loaders, until they are uploaded or copied
+        TagCount      ///< Keep last -- the total number of tags
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Live and peak usage of a tag
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Usage
+    {
+        Uint64 live; ///< Bytes currently in use
+        Uint64 peak; ///< Largest usage since the start, or since the last call to resetPeaks
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Usage of all the tags at a given time
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Snapshot
+    {
+        Usage tags[TagCount]; ///< Usage of each tag
+        Usage total;          ///< Usage of all the tags together
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the usage of a tag
+    ///
+    /// \param tag Tag to query
+    ///
+    /// \return Live and peak usage of the tag, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static Usage getUsage(Tag tag);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the usage of all the tags
+    ///
+    /// The counters are updated by several threads, so the
+    /// figures of a snapshot may be a few allocations apart.
+    ///
+    /// \return Current usage of every tag and their total
+    ///
+    ////////////////////////////////////////////////////////////
+    static Snapshot getSnapshot();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the peaks to the live usage
+    ///
+    /// Call it at the start of a level or a scene to measure
+    /// the peaks of that part of the application only.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void resetPeaks();
+};
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Replace the accounted size of a memory block
+///
+/// \param tag     Subsystem owning the block
+/// \param oldSize Size previously accounted for the block, in bytes
+/// \param newSize New size of the block, in bytes (0 when freed)
+///
+////////////////////////////////////////////////////////////
+void trackMemory(MemoryStats::Tag tag, Uint64 oldSize, Uint64 newSize);
+
+////////////////////////////////////////////////////////////
+/// \brief Accounted size of the containers of an object
+///
+/// The counter is a member of the objects owning memory: it
+/// releases its size when the object is destroyed, and is
+/// counted again when the object is copied. The owner calls
+/// update with the capacity of its containers after they
+/// grow or shrink.
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API MemoryCounter
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an empty counter
+    ///
+    /// \param tag Subsystem of the owner
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit MemoryCounter(MemoryStats::Tag tag);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// The copy accounts the same size as the original, until
+    /// its owner updates it.
+    ///
+    ////////////////////////////////////////////////////////////
+    MemoryCounter(const MemoryCounter& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The size moves with the containers of the owner.
+    ///
+    ////////////////////////////////////////////////////////////
+    MemoryCounter(MemoryCounter&& right) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~MemoryCounter();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    MemoryCounter& operator =(const MemoryCounter& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    MemoryCounter& operator =(MemoryCounter&& right) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the accounted size
+    ///
+    /// \param bytes New size of the containers of the owner, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Uint64 bytes);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    MemoryStats::Tag m_tag;   ///< Subsystem of the owner
+    Uint64           m_bytes; ///< Accounted size, in bytes
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_MEMORYSTATS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::MemoryStats
+/// \ingroup graphics
+///
+/// sf::MemoryStats tells how much CPU memory each part of the
+/// graphics module holds, and the largest amount it held, to
+/// find which one grows when the memory of the process is
+/// limited (browser tabs, mobile devices).
+///
+/// The memory of the containers owned by the objects (pixels
+/// of images, glyph tables, text vertices, uniform tables) is
+/// accounted from their capacity, every time they grow or
+/// shrink. The blocks allocated by FreeType go through
+/// sf::Allocator and are accounted to the Fonts tag, and the
+/// pixels decoded by stb_image are accounted to the Loaders
+/// tag until they are released. Allocator overheads are not
+/// included, so treat the figures as a lower bound.
+///
+/// Usage example:
+/// \code
+/// sf::MemoryStats::Snapshot snapshot = sf::MemoryStats::getSnapshot();
+/// for (int i = 0; i < sf::MemoryStats::TagCount; ++i)
+///     log("tag %d: %llu bytes (peak %llu)", i, snapshot.tags[i].live, snapshot.tags[i].peak);
+/// \endcode
+///
+/// \see sf::Allocator, sf::GpuMemory
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,278 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_NINESLICESPRITE_HPP
+#define SFML_NINESLICESPRITE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Sprite split into a 3x3 grid, whose borders keep
+///        their size when it is resized
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API NineSliceSprite : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty nine-slice sprite with no source texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    NineSliceSprite();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the nine-slice sprite from a sub-rectangle of a texture
+    ///
+    /// The size of the sprite is initially the size of the
+    /// texture rectangle.
+    ///
+    /// \param texture     Source texture
+    /// \param textureRect Sub-rectangle of the texture to display, in pixels
+    /// \param centerRect  Stretched area of the texture rectangle, relative to it
+    ///
+    /// \see setTexture, setTextureRect, setCenterRect
+    ///
+    ////////////////////////////////////////////////////////////
+    NineSliceSprite(const Texture& texture, const IntRect& textureRect, const IntRect& centerRect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the source texture
+    ///
+    /// The texture must exist as long as the sprite uses it.
+    ///
+    /// \param texture New texture
+    ///
+    /// \see getTexture, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sub-rectangle of the texture that the sprite displays
+    ///
+    /// \param rectangle Rectangle defining the region of the texture to display, in pixels
+    ///
+    /// \see getTextureRect, setCenterRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(const IntRect& rectangle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the stretched area of the texture rectangle
+    ///
+    /// The rectangle splits the texture rectangle into 9 slices:
+    /// the 4 corners are never stretched, the top and bottom
+    /// edges are only stretched horizontally, the left and
+    /// right edges only vertically, and the center in both
+    /// directions.
+    ///
+    /// \param rectangle Center area, relative to the top-left corner of the texture rectangle
+    ///
+    /// \see getCenterRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCenterRect(const IntRect& rectangle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the sprite
+    ///
+    /// Only the positions of the vertices are updated. If the
+    /// size is smaller than the fixed borders, the borders are
+    /// shrunk proportionally.
+    ///
+    /// \param size New size, in local units
+    ///
+    /// \see getSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSize(const Vector2f& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the global color of the sprite
+    ///
+    /// \param color New color of the sprite
+    ///
+    /// \see getColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the source texture
+    ///
+    /// \return Pointer to the texture, or NULL if there is none
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sub-rectangle of the texture displayed by the sprite
+    ///
+    /// \return Texture rectangle of the sprite
+    ///
+    /// \see setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the stretched area of the texture rectangle
+    ///
+    /// \return Center area, relative to the texture rectangle
+    ///
+    /// \see setCenterRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getCenterRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the sprite
+    ///
+    /// \return Size of the sprite, in local units
+    ///
+    /// \see setSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global color of the sprite
+    ///
+    /// \return Global color of the sprite
+    ///
+    /// \see setColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the entity
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the entity
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the sprite to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the sprite
+    ///
+    /// \param bounds Receives the global bounds of the sprite
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the vertices' positions
+    ///
+    ////////////////////////////////////////////////////////////
+    void updatePositions();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the vertices' texture coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateTexCoords();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vertex         m_vertices[54]; ///< Vertices of the 9 slices, as a triangle list
+    const Texture* m_texture;      ///< Texture of the sprite
+    IntRect        m_textureRect;  ///< Rectangle defining the area of the source texture to display
+    IntRect        m_centerRect;   ///< Stretched area of the texture rectangle
+    Vector2f       m_size;         ///< Size of the sprite
+    Color          m_color;        ///< Global color of the sprite
+};
+
+} // namespace sf
+
+
+#endif // SFML_NINESLICESPRITE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::NineSliceSprite
+/// \ingroup graphics
+///
+/// sf::NineSliceSprite displays a texture rectangle that can
+/// be resized without distorting its borders, which makes it
+/// the usual building block of UI panels and buttons.
+///
+/// The whole sprite is a single 54-vertex triangle list, drawn
+/// with one call: panels that share a texture are merged by
+/// the batcher of the render target, instead of costing 9
+/// sprites each. Resizing only recomputes the positions of the
+/// vertices.
+///
+/// Usage example:
+/// \code
+/// // A 48x48 panel with 16 pixel borders
+/// sf::NineSliceSprite panel(atlas, sf::IntRect(0, 0, 48, 48), sf::IntRect(16, 16, 16, 16));
+/// panel.setSize(sf::Vector2f(300.f, 200.f));
+/// panel.setPosition(20.f, 20.f);
+///
+/// window.draw(panel);
+/// \endcode
+///
+/// \see sf::Sprite
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_NODE_HPP
+#define SFML_NODE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Element of a hierarchy of transformable objects
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API Node : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a node without parent, children nor drawable.
+    ///
+    ////////////////////////////////////////////////////////////
+    Node();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The node is detached from its parent, and its children
+    /// become roots of their own hierarchies.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Node();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a child to the node
+    ///
+    /// The child is detached from its previous parent first.
+    /// A node can't be attached to one of its descendants,
+    /// nor to itself.
+    ///
+    /// \param child Node to attach; it is not owned by this node
+    ///
+    /// \return True if the child was attached
+    ///
+    ////////////////////////////////////////////////////////////
+    bool attachChild(Node& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a child from the node
+    ///
+    /// Does nothing if \a child is not a child of this node.
+    ///
+    /// \param child Node to detach
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachChild(Node& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the parent of the node
+    ///
+    /// \return Parent node, or NULL if the node is a root
+    ///
+    ////////////////////////////////////////////////////////////
+    Node* getParent() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the children of the node
+    ///
+    /// \return Children, in the order they are drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<Node*>& getChildren() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the drawable rendered by the node
+    ///
+    /// The drawable is rendered with the world transform of
+    /// the node, before the children. It is not copied, it
+    /// must remain alive as long as the node uses it.
+    ///
+    /// \param drawable Drawable to render, or NULL for none
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDrawable(const Drawable* drawable);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the drawable rendered by the node
+    ///
+    /// \return Drawable of the node, or NULL if none
+    ///
+    ////////////////////////////////////////////////////////////
+    const Drawable* getDrawable() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the transform from the node to the root of its hierarchy
+    ///
+    /// The world transform is the combination of the transforms
+    /// of all the ancestors of the node and of its own one. It
+    /// is only recomputed when the node or one of its ancestors
+    /// changed since the last call.
+    ///
+    /// \return World transform of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    const Transform& getWorldTransform() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the inverse of the world transform
+    ///
+    /// This transform converts a point of the world (a mouse
+    /// position, for hit-testing) to the local coordinates of
+    /// the node.
+    ///
+    /// \return Inverse of the world transform of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    const Transform& getInverseWorldTransform() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the drawable of the node, then its children
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the world transform if it's outdated
+    ///
+    /// \return Version of the world transform
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 updateWorldTransform() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Node*              m_parent;                ///< Parent node
+    std::vector<Node*> m_children;              ///< Child nodes
+    const Drawable*    m_drawable;              ///< Drawable rendered by the node
+    mutable Transform  m_worldTransform;        ///< Combined transform of the ancestors and the node
+    mutable Transform  m_inverseWorldTransform; ///< Inverse of m_worldTransform
+    mutable Uint32     m_worldVersion;          ///< Incremented each time m_worldTransform is recomputed
+    mutable Uint32     m_localVersion;          ///< Version of the local transform used for m_worldTransform
+    mutable Uint32     m_parentVersion;         ///< Version of the parent world transform used for m_worldTransform
+    mutable Uint32     m_inverseVersion;        ///< Version of m_worldTransform used for m_inverseWorldTransform
+    mutable bool       m_worldValid;            ///< Has m_worldTransform been computed for the current parent?
+};
+
+} // namespace sf
+
+
+#endif // SFML_NODE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Node
+/// \ingroup graphics
+///
+/// sf::Node builds hierarchies of transformable objects, such
+/// as the widgets of a user interface or the parts of a
+/// character: each node is positioned relatively to its
+/// parent, and drawing a node draws its drawable and all its
+/// children with the combined transforms.
+///
+/// The world transform of each node is cached. Instead of
+/// pushing dirty flags down the hierarchy when a node moves,
+/// each node remembers the versions of its own transform and
+/// of its parent world transform it was computed from; a query
+/// only recomputes what changed on the path to the root, and
+/// nothing at all when the hierarchy is still.
+///
+/// Nodes don't own their children nor their drawable.
+///
+/// Usage example:
+/// \code
+/// sf::Node panel;
+/// sf::Node button;
+/// sf::RectangleShape background(sf::Vector2f(80, 20));
+///
+/// panel.setPosition(100, 50);
+/// button.setPosition(10, 10);
+/// button.setDrawable(&background);
+/// panel.attachChild(button);
+///
+/// // hit-testing
+/// sf::Vector2f local = button.getInverseWorldTransform().transformPoint(mouse);
+/// if (background.getLocalBounds().contains(local))
+///     click();
+///
+/// window.draw(panel);
+/// \endcode
+///
+/// \see sf::Transformable, sf::Drawable
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,296 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_NUMERICTEXT_HPP
+#define SFML_NUMERICTEXT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Font;
+
+////////////////////////////////////////////////////////////
+/// \brief Number displayed in fixed character slots, for
+///        values that change every frame
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API NumericText : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Alignment of the number in its slots
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Alignment
+    {
+        Left, ///< The first character is in the first slot
+        Right ///< The last character is in the last slot
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty number with 8 slots and no font.
+    ///
+    ////////////////////////////////////////////////////////////
+    NumericText();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the number from a font and a character size
+    ///
+    /// \param font          Font used to draw the number
+    /// \param characterSize Base size of characters, in pixels
+    /// \param slotCount     Maximum number of characters of the number
+    ///
+    ////////////////////////////////////////////////////////////
+    NumericText(const Font& font, unsigned int characterSize = 30, std::size_t slotCount = 8);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the font of the number
+    ///
+    /// The font must exist as long as the number uses it.
+    ///
+    /// \param font New font
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFont(const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the font of the number
+    ///
+    /// \return Pointer to the font, or NULL if none
+    ///
+    ////////////////////////////////////////////////////////////
+    const Font* getFont() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the character size
+    ///
+    /// \param size New character size, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCharacterSize(unsigned int size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the character size
+    ///
+    /// \return Size of the characters, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getCharacterSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of character slots
+    ///
+    /// The characters of a number that don't fit in the slots
+    /// (the last ones) are not displayed.
+    ///
+    /// \param count Maximum number of characters of the number
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSlotCount(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of character slots
+    ///
+    /// \return Maximum number of characters of the number
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSlotCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the alignment of the number in its slots
+    ///
+    /// \param alignment New alignment
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAlignment(Alignment alignment);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the alignment of the number in its slots
+    ///
+    /// \return Alignment of the number
+    ///
+    ////////////////////////////////////////////////////////////
+    Alignment getAlignment() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the color of the number
+    ///
+    /// \param color New color
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFillColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color of the number
+    ///
+    /// \return Color of the number
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getFillColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Display an integer
+    ///
+    /// \param value Value to display
+    ///
+    ////////////////////////////////////////////////////////////
+    void setValue(Int64 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Display a decimal number with a fixed number of decimals
+    ///
+    /// \param value    Value to display
+    /// \param decimals Number of digits after the decimal point (up to 9)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setValue(double value, unsigned int decimals);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the slots
+    ///
+    /// The bounds cover all the slots, whatever the value, so
+    /// that they don't change when the value does.
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the slots
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the number to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the number
+    ///
+    /// \param bounds Receives the global bounds of the slots
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the glyphs of the characters of numbers
+    ///
+    /// The glyphs are loaded again when the font, the character
+    /// size, or the glyphs of the font change.
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGlyphsUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rewrite the vertices of the slots whose character changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate() const;
+
+    enum
+    {
+        CharacterCount = 12 ///< Number of characters of numbers: 10 digits, minus sign and decimal point
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Font*                m_font;                     ///< Font used to display the number
+    unsigned int               m_characterSize;            ///< Base size of characters, in pixels
+    Alignment                  m_alignment;                ///< Alignment of the number in its slots
+    Color                      m_fillColor;                ///< Color of the number
+    std::vector<Uint8>         m_characters;               ///< Characters of the value (indices in the glyph cache)
+    mutable std::vector<Uint8> m_slots;                    ///< Characters currently written in the vertices of each slot
+    mutable VertexArray        m_vertices;                 ///< Quads of the slots
+    mutable Vertex             m_quads[CharacterCount][6]; ///< Quad of each character, at the origin of its slot
+    mutable float              m_slotWidth;                ///< Width of a slot (the largest advance of the characters)
+    mutable float              m_top;                      ///< Top of the highest character
+    mutable float              m_bottom;                   ///< Bottom of the lowest character
+    mutable Uint64             m_fontRevision;             ///< Revision of the font glyphs the quads were built with
+    mutable bool               m_glyphsNeedUpdate;         ///< Do the quads of the characters need to be built again?
+};
+
+} // namespace sf
+
+
+#endif // SFML_NUMERICTEXT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::NumericText
+/// \ingroup graphics
+///
+/// sf::NumericText displays integers and decimal numbers
+/// that change often, such as scores, timers or frame rates.
+/// Unlike sf::Text, it involves no sf::String and no layout:
+/// the glyphs of the digits, of the minus sign and of the
+/// decimal point are loaded once for the font and character
+/// size, and each character of the number goes in a fixed
+/// slot as wide as the widest of them, so that the digits
+/// don't move when the value changes. Changing the value
+/// formats it in place and only rewrites the quads of the
+/// slots whose character changed.
+///
+/// Kerning and styles are not applied.
+///
+/// Usage example:
+/// \code
+/// sf::NumericText fps(font, 16, 6);
+/// fps.setAlignment(sf::NumericText::Right);
+/// fps.setPosition(10, 10);
+///
+/// // each frame
+/// fps.setValue(1.0 / frameTime.asSeconds(), 1);
+/// window.draw(fps);
+/// \endcode
+///
+/// \see sf::Text
+///
+////////////////////////////////////////////////////////////
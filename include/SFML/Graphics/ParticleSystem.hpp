@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PARTICLESYSTEM_HPP
+#define SFML_PARTICLESYSTEM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Particles animated on the GPU, from their
+///        emission parameters
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ParticleSystem : public Drawable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Emission parameters of a particle
+    ///
+    /// The particle moves from \a position with a constant
+    /// velocity plus the gravity of the system, while its size,
+    /// rotation and color are interpolated over its lifetime.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Particle
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates a white, untextured particle of size 1, living
+        /// for one second.
+        ///
+        ////////////////////////////////////////////////////////////
+        Particle();
+
+        Vector2f position;        ///< Position at emission
+        Vector2f velocity;        ///< Initial velocity, in units per second
+        Time     lifetime;        ///< Time before the particle dies
+        float    startSize;       ///< Width and height at emission
+        float    endSize;         ///< Width and height at death
+        float    rotation;        ///< Rotation at emission, in degrees
+        float    angularVelocity; ///< Rotation speed, in degrees per second
+        Color    startColor;      ///< Color at emission
+        Color    endColor;        ///< Color at death
+        IntRect  textureRect;     ///< Area of the texture to display, in pixels
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a system that can hold 1024 particles.
+    ///
+    ////////////////////////////////////////////////////////////
+    ParticleSystem();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ParticleSystem();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of particles alive at once
+    ///
+    /// When the system is full, new particles replace the
+    /// oldest ones. Changing the capacity kills all the
+    /// particles.
+    ///
+    /// \param capacity Maximum number of particles
+    ///
+    /// \see getCapacity
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCapacity(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of particles alive at once
+    ///
+    /// \return Maximum number of particles
+    ///
+    /// \see setCapacity
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the texture of the particles
+    ///
+    /// The texture must exist as long as the system uses it.
+    ///
+    /// \param texture Texture of the particles, or NULL to draw plain quads
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of the particles
+    ///
+    /// \return Texture of the particles, or NULL if they are untextured
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the acceleration applied to all the particles
+    ///
+    /// The gravity applies to the whole life of the particles,
+    /// including the particles already emitted.
+    ///
+    /// \param gravity Acceleration, in units per second squared
+    ///
+    /// \see getGravity
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGravity(const Vector2f& gravity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the acceleration applied to all the particles
+    ///
+    /// \return Acceleration, in units per second squared
+    ///
+    /// \see setGravity
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getGravity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Emit a particle
+    ///
+    /// Particles with a null or negative lifetime are ignored.
+    ///
+    /// \param particle Emission parameters of the particle
+    ///
+    ////////////////////////////////////////////////////////////
+    void emit(const Particle& particle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Emit a burst of particles
+    ///
+    /// \param particles Array of emission parameters
+    /// \param count     Number of particles in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void emit(const Particle* particles, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Advance the simulation
+    ///
+    /// This only advances the clock of the system: the
+    /// particles are animated by the GPU when they are drawn.
+    ///
+    /// \param elapsed Time elapsed since the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time elapsed);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Kill all the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the particles can be animated on the GPU
+    ///
+    /// The GPU path requires instanced rendering. When it is
+    /// not available, or when the system is drawn with a custom
+    /// shader, the particles are animated on the CPU each time
+    /// they are drawn, with the same results.
+    ///
+    /// \return True if the particles are animated on the GPU
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isGpuSimulationAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the particles to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the particles emitted since the last draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadParticles() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Animate the particles into m_vertices, on the CPU
+    ///
+    ////////////////////////////////////////////////////////////
+    void simulateParticles() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Particle>       m_particles;   ///< Ring of emitted particles
+    std::vector<float>          m_spawnTimes;  ///< Emission time of each particle, in seconds
+    std::size_t                 m_capacity;    ///< Size of the ring
+    std::size_t                 m_next;        ///< Slot of the next emitted particle
+    const Texture*              m_texture;     ///< Texture of the particles
+    Vector2f                    m_gravity;     ///< Acceleration of all the particles
+    float                       m_time;        ///< Current time of the simulation, in seconds
+    float                       m_deathTime;   ///< Time at which all the particles are dead
+    mutable unsigned int        m_buffer;      ///< Instance buffer handle
+    mutable std::size_t         m_bufferSize;  ///< Size in instances of the allocated instance buffer
+    mutable std::size_t         m_dirtyBegin;  ///< First slot emitted since the last upload
+    mutable std::size_t         m_dirtyCount;  ///< Number of slots emitted since the last upload
+    mutable std::vector<Vertex> m_vertices;    ///< Animated quads, when the GPU path is not used
+};
+
+} // namespace sf
+
+
+#endif // SFML_PARTICLESYSTEM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ParticleSystem
+/// \ingroup graphics
+///
+/// sf::ParticleSystem renders large amounts of particles
+/// without updating them on the CPU. Each particle is
+/// described once, when it is emitted, by its initial
+/// position, velocity, size, rotation and color, as well as
+/// their final values; the vertex shader evaluates where it
+/// is at the current time, and discards it when it is dead.
+///
+/// The CPU is therefore only involved for emissions: the
+/// parameters of the new particles are uploaded to a ring
+/// buffer of instances, and drawing the system is a single
+/// instanced draw call regardless of the number of particles.
+///
+/// The motion of the particles is ballistic (constant velocity
+/// plus a global gravity), which covers most emitter effects
+/// (sparks, smoke, debris, ...). Effects that need particles
+/// to interact with the world must be simulated on the CPU.
+///
+/// Particles are positioned in the local coordinates of the
+/// system, which are transformed by the transform of the
+/// render states.
+///
+/// Usage example:
+/// \code
+/// sf::ParticleSystem sparks;
+/// sparks.setCapacity(100000);
+/// sparks.setTexture(&sparkTexture);
+/// sparks.setGravity(sf::Vector2f(0.f, 200.f));
+///
+/// // On an explosion
+/// sf::ParticleSystem::Particle particle;
+/// particle.position = explosionCenter;
+/// particle.lifetime = sf::seconds(1.5f);
+/// particle.startColor = sf::Color::Yellow;
+/// particle.endColor = sf::Color(255, 0, 0, 0);
+/// particle.textureRect = sf::IntRect(0, 0, 16, 16);
+/// for (int i = 0; i < 500; ++i)
+/// {
+///     particle.velocity = randomDirection() * 300.f;
+///     sparks.emit(particle);
+/// }
+///
+/// // Each frame
+/// sparks.update(clock.restart());
+/// window.draw(sparks);
+/// \endcode
+///
+/// \see sf::SpriteBatch
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,347 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_POLYLINE_HPP
+#define SFML_POLYLINE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Thick line going through a sequence of points
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API Polyline : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shapes of the corners between two segments
+    ///
+    ////////////////////////////////////////////////////////////
+    enum JoinStyle
+    {
+        MiterJoin, ///< Sharp corners, beveled when they are too long (default)
+        BevelJoin  ///< Corners cut flat
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shapes of the two ends of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    enum CapStyle
+    {
+        ButtCap,  ///< The line stops at its end points (default)
+        SquareCap ///< The line extends by half its thickness past its end points
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty polyline, one unit thick.
+    ///
+    ////////////////////////////////////////////////////////////
+    Polyline();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a point at the end of the line
+    ///
+    /// Only the new segment and the geometry around the previous
+    /// end point are tessellated again, so that lines growing
+    /// point by point (like real-time graphs) stay cheap to
+    /// update.
+    ///
+    /// \param point Position of the new point, in local coordinates
+    ///
+    /// \see setPoint, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void addPoint(const Vector2f& point);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the position of an existing point
+    ///
+    /// The result is undefined if \a index is out of the valid range.
+    ///
+    /// \param index Index of the point to change, in range [0 .. getPointCount() - 1]
+    /// \param point New position of the point, in local coordinates
+    ///
+    /// \see getPoint, addPoint
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPoint(std::size_t index, const Vector2f& point);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a point
+    ///
+    /// The result is undefined if \a index is out of the valid range.
+    ///
+    /// \param index Index of the point to get, in range [0 .. getPointCount() - 1]
+    ///
+    /// \return Position of the index-th point, in local coordinates
+    ///
+    /// \see setPoint
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getPoint(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of points of the line
+    ///
+    /// \return Number of points
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPointCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the points
+    ///
+    /// The allocated memory is kept, to be reused by the next
+    /// points.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate the memory for a given number of points
+    ///
+    /// \param pointCount Number of points to make room for
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t pointCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the thickness of the line
+    ///
+    /// \param thickness New thickness, in local units
+    ///
+    /// \see getThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThickness(float thickness);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the thickness of the line
+    ///
+    /// \return Thickness of the line
+    ///
+    /// \see setThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    float getThickness() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the color of the line
+    ///
+    /// \param color New color of the line
+    ///
+    /// \see getColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color of the line
+    ///
+    /// \return Color of the line
+    ///
+    /// \see setColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the shape of the corners between segments
+    ///
+    /// \param style New join style
+    ///
+    /// \see getJoinStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setJoinStyle(JoinStyle style);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shape of the corners between segments
+    ///
+    /// \return Join style
+    ///
+    /// \see setJoinStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    JoinStyle getJoinStyle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the shape of the ends of the line
+    ///
+    /// \param style New cap style
+    ///
+    /// \see getCapStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCapStyle(CapStyle style);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shape of the ends of the line
+    ///
+    /// \return Cap style
+    ///
+    /// \see setCapStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    CapStyle getCapStyle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the line
+    ///
+    /// The returned rectangle is in local coordinates, which means
+    /// that it ignores the transformations (translation, rotation,
+    /// scale, ...) that are applied to the entity. It includes
+    /// the thickness, joins and caps of the line.
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global (non-minimal) bounding rectangle of the line
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the line to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the line
+    ///
+    /// \param bounds Receives the global bounds of the line
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the geometry of a range of segments as outdated
+    ///
+    /// \param first Index of the first segment
+    /// \param last  Index of the last segment (included)
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate(std::size_t first, std::size_t last);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tessellate the outdated segments, joins and caps
+    ///
+    ////////////////////////////////////////////////////////////
+    void update() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tessellate a segment and the join at its first point
+    ///
+    /// \param index Index of the segment
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateSegment(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tessellate the two caps of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateCaps() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Vector2f>       m_points;       ///< Points of the line
+    mutable std::vector<Vertex> m_vertices;     ///< Tessellated geometry: two caps, then a join and a quad per segment
+    float                       m_thickness;    ///< Thickness of the line
+    Color                       m_color;        ///< Color of the line
+    JoinStyle                   m_joinStyle;    ///< Shape of the corners
+    CapStyle                    m_capStyle;     ///< Shape of the ends
+    mutable std::size_t         m_dirtyBegin;   ///< First segment to tessellate again
+    mutable std::size_t         m_dirtyEnd;     ///< Segment following the last one to tessellate again
+    mutable bool                m_boundsValid;  ///< Is m_bounds up-to-date with the whole geometry?
+    mutable FloatRect           m_bounds;       ///< Bounding rectangle of the tessellated geometry
+};
+
+} // namespace sf
+
+
+#endif // SFML_POLYLINE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Polyline
+/// \ingroup graphics
+///
+/// sf::Polyline draws a line of a given thickness through a
+/// sequence of points, with configurable joins and caps. The
+/// whole line is tessellated into a single triangle list and
+/// drawn with one draw call (or batched with its neighbours,
+/// if it is small enough).
+///
+/// The geometry is cached, and only the parts affected by a
+/// modification are tessellated again: adding a point at the
+/// end only costs the new segment, which makes sf::Polyline
+/// suitable for graphs that grow in real-time.
+///
+/// Like the other drawables, it inherits the transform
+/// functions of sf::Transformable.
+///
+/// Usage example:
+/// \code
+/// sf::Polyline graph;
+/// graph.setThickness(2.f);
+/// graph.setColor(sf::Color::Green);
+///
+/// // Each frame
+/// graph.addPoint(sf::Vector2f(time * 10.f, 300.f - value));
+/// window.draw(graph);
+/// \endcode
+///
+/// \see sf::VertexArray, sf::Shape
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_POSTPROCESS_HPP
+#define SFML_POSTPROCESS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+class RenderTexture;
+class RenderTexturePool;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Built-in full-screen filters running on pooled render textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API PostProcess : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the filters on top of a render texture pool
+    ///
+    /// The intermediate targets are acquired from \a pool, so
+    /// they are recycled by RenderTexturePool::endFrame. The
+    /// pool must exist as long as the filters use it.
+    ///
+    /// \param pool Pool of the intermediate render textures
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PostProcess(RenderTexturePool& pool);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Blur a texture
+    ///
+    /// The blur is a dual filter (dual Kawase): \a iterations
+    /// passes halve the resolution of the image, then as many
+    /// passes bring it back to the size of \a source. Every tap
+    /// of the kernels samples between texels, so that the
+    /// bilinear filter averages four texels at once: the
+    /// downsample reads 5 taps and the upsample 8, and most of
+    /// the passes run at a fraction of the full resolution. The
+    /// radius of the blur roughly doubles with each iteration.
+    ///
+    /// The source should be smooth: without bilinear filtering
+    /// the taps read a single texel and the blur is blocky.
+    ///
+    /// The returned texture belongs to a render texture of the
+    /// pool, so it is valid until the end of the frame.
+    ///
+    /// \param source     Texture to blur
+    /// \param iterations Number of downsample (and upsample) passes, at least 1
+    /// \param offset     Spread of the taps, in texels of each pass (1 is the reference kernel)
+    ///
+    /// \return Blurred texture, or NULL if the filter couldn't run
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* blur(const Texture& source, unsigned int iterations, float offset = 1.f);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compile the shaders of the blur, if not done yet
+    ///
+    /// \return True if the shaders are ready
+    ///
+    ////////////////////////////////////////////////////////////
+    bool createBlurShaders();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render a full-target pass reading a texture
+    ///
+    /// \param source Texture read by the pass
+    /// \param target Render texture written by the pass
+    /// \param shader Shader of the pass
+    /// \param offset Spread of the taps, in texels of \a source
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawPass(const Texture& source, RenderTexture& target, Shader& shader, float offset);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    RenderTexturePool* m_pool;          ///< Pool of the intermediate render textures
+    Shader             m_downsample;    ///< Downsample pass of the blur
+    Shader             m_upsample;      ///< Upsample pass of the blur
+    bool               m_shadersReady;  ///< Are the shaders compiled?
+    bool               m_shadersFailed; ///< Did the compilation of the shaders fail?
+};
+
+} // namespace sf
+
+
+#endif // SFML_POSTPROCESS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PostProcess
+/// \ingroup graphics
+///
+/// A Gaussian blur written with two render textures and a
+/// shader usually runs at full resolution and reads one
+/// texel per tap, so a wide blur costs dozens of taps per
+/// pixel. sf::PostProcess implements the blur as a chain of
+/// downsample and upsample passes instead: the kernel stays
+/// small while the resolution drops, the taps are placed to
+/// use the bilinear filter, and the intermediate targets
+/// come from a sf::RenderTexturePool, so the chain creates
+/// no render texture after the first frame.
+///
+/// Usage example:
+/// \code
+/// sf::RenderTexturePool pool;
+/// sf::PostProcess post(pool);
+///
+/// // Every frame
+/// scene.setSmooth(true);
+/// scene.display();
+///
+/// const sf::Texture* blurred = post.blur(scene.getTexture(), 4);
+/// if (blurred)
+///     window.draw(sf::Sprite(*blurred));
+///
+/// pool.endFrame();
+/// window.display();
+/// \endcode
+///
+/// \see sf::RenderTexturePool, sf::RenderTexture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_QOICODEC_HPP
+#define SFML_QOICODEC_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Tell whether a file in memory is a QOI image
+///
+/// Only the 4 bytes signature is checked.
+///
+/// \param data     Pointer to the file data
+/// \param dataSize Size of the data, in bytes
+///
+////////////////////////////////////////////////////////////
+bool isQoiImage(const void* data, std::size_t dataSize);
+
+////////////////////////////////////////////////////////////
+/// \brief Decode a QOI image to RGBA pixels
+///
+/// The pixels are allocated with std::malloc, like the ones
+/// of stb_image, so that ImageLoader::freeDecodedPixels can
+/// release both.
+///
+/// \param data     Pointer to the file data
+/// \param dataSize Size of the data, in bytes
+/// \param size     Receives the size of the image, in pixels
+/// \param error    Receives the failure reason
+///
+/// \return Pointer to the pixels, or NULL on failure
+///
+////////////////////////////////////////////////////////////
+Uint8* decodeQoiImage(const void* data, std::size_t dataSize, Vector2u& size, const char*& error);
+
+////////////////////////////////////////////////////////////
+/// \brief Encode RGBA pixels to a QOI image
+///
+/// \param output Receives the encoded file
+/// \param pixels Array of RGBA pixels
+/// \param size   Size of the image, in pixels
+///
+////////////////////////////////////////////////////////////
+void encodeQoiImage(std::vector<Uint8>& output, const Uint8* pixels, const Vector2u& size);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_QOICODEC_HPP
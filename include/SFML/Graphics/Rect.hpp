@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Vector2.hpp>
 #include <algorithm>
+#include <cstddef>
 
 
 namespace sf
@@ -50,7 +51,7 @@ public:
     /// Rect(0, 0, 0, 0)).
     ///
     ////////////////////////////////////////////////////////////
-    Rect();
+    constexpr Rect();
 
     ////////////////////////////////////////////////////////////
     /// \brief Construct the rectangle from its coordinates
@@ -64,7 +65,7 @@ public:
     /// \param rectHeight Height of the rectangle
     ///
     ////////////////////////////////////////////////////////////
-    Rect(T rectLeft, T rectTop, T rectWidth, T rectHeight);
+    constexpr Rect(T rectLeft, T rectTop, T rectWidth, T rectHeight);
 
     ////////////////////////////////////////////////////////////
     /// \brief Construct the rectangle from position and size
@@ -76,7 +77,7 @@ public:
     /// \param size     Size of the rectangle
     ///
     ////////////////////////////////////////////////////////////
-    Rect(const Vector2<T>& position, const Vector2<T>& size);
+    constexpr Rect(const Vector2<T>& position, const Vector2<T>& size);
 
     ////////////////////////////////////////////////////////////
     /// \brief Construct the rectangle from another type of rectangle
@@ -90,7 +91,7 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     template <typename U>
-    explicit Rect(const Rect<U>& rectangle);
+    constexpr explicit Rect(const Rect<U>& rectangle);
 
     ////////////////////////////////////////////////////////////
     /// \brief Check if a point is inside the rectangle's area
@@ -123,6 +124,24 @@ public:
     ////////////////////////////////////////////////////////////
     bool contains(const Vector2<T>& point) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Check which points of an array are inside the rectangle's area
+    ///
+    /// The bounds of the rectangle are computed once for the
+    /// whole array, which is faster than testing the points one
+    /// by one for culling and hit-testing loops.
+    ///
+    /// \param points  Points to test
+    /// \param count   Number of points
+    /// \param results Receives, for each point, whether it is inside
+    ///
+    /// \return Number of points inside the rectangle
+    ///
+    /// \see intersects
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t contains(const Vector2<T>* points, std::size_t count, bool* results) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Check the intersection between two rectangles
     ///
@@ -173,7 +192,7 @@ public:
 ///
 ////////////////////////////////////////////////////////////
 template <typename T>
-bool operator ==(const Rect<T>& left, const Rect<T>& right);
+constexpr bool operator ==(const Rect<T>& left, const Rect<T>& right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Rect
@@ -188,7 +207,7 @@ bool operator ==(const Rect<T>& left, const Rect<T>& right);
 ///
 ////////////////////////////////////////////////////////////
 template <typename T>
-bool operator !=(const Rect<T>& left, const Rect<T>& right);
+constexpr bool operator !=(const Rect<T>& left, const Rect<T>& right);
 
 #include <SFML/Graphics/Rect.inl>
 
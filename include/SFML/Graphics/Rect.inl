@@ -25,7 +25,7 @@
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-Rect<T>::Rect() :
+constexpr Rect<T>::Rect() :
 left  (0),
 top   (0),
 width (0),
@@ -37,7 +37,7 @@ height(0)
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-Rect<T>::Rect(T rectLeft, T rectTop, T rectWidth, T rectHeight) :
+constexpr Rect<T>::Rect(T rectLeft, T rectTop, T rectWidth, T rectHeight) :
 left  (rectLeft),
 top   (rectTop),
 width (rectWidth),
@@ -49,7 +49,7 @@ height(rectHeight)
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-Rect<T>::Rect(const Vector2<T>& position, const Vector2<T>& size) :
+constexpr Rect<T>::Rect(const Vector2<T>& position, const Vector2<T>& size) :
 left  (position.x),
 top   (position.y),
 width (size.x),
@@ -62,7 +62,7 @@ height(size.y)
 ////////////////////////////////////////////////////////////
 template <typename T>
 template <typename U>
-Rect<T>::Rect(const Rect<U>& rectangle) :
+constexpr Rect<T>::Rect(const Rect<U>& rectangle) :
 left  (static_cast<T>(rectangle.left)),
 top   (static_cast<T>(rectangle.top)),
 width (static_cast<T>(rectangle.width)),
@@ -95,12 +95,43 @@ bool Rect<T>::contains(const Vector2<T>& point) const
 }
 
 
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t Rect<T>::contains(const Vector2<T>* points, std::size_t count, bool* results) const
+{
+    T minX = std::min(left, static_cast<T>(left + width));
+    T maxX = std::max(left, static_cast<T>(left + width));
+    T minY = std::min(top, static_cast<T>(top + height));
+    T maxY = std::max(top, static_cast<T>(top + height));
+
+    std::size_t inside = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        results[i] = (points[i].x >= minX) && (points[i].x < maxX) && (points[i].y >= minY) && (points[i].y < maxY);
+        inside += results[i] ? 1 : 0;
+    }
+
+    return inside;
+}
+
+
 ////////////////////////////////////////////////////////////
 template <typename T>
 bool Rect<T>::intersects(const Rect<T>& rectangle) const
 {
-    Rect<T> intersection;
-    return intersects(rectangle, intersection);
+    // Same test as the other overload, without building the intersection
+    T r1MinX = std::min(left, static_cast<T>(left + width));
+    T r1MaxX = std::max(left, static_cast<T>(left + width));
+    T r1MinY = std::min(top, static_cast<T>(top + height));
+    T r1MaxY = std::max(top, static_cast<T>(top + height));
+
+    T r2MinX = std::min(rectangle.left, static_cast<T>(rectangle.left + rectangle.width));
+    T r2MaxX = std::max(rectangle.left, static_cast<T>(rectangle.left + rectangle.width));
+    T r2MinY = std::min(rectangle.top, static_cast<T>(rectangle.top + rectangle.height));
+    T r2MaxY = std::max(rectangle.top, static_cast<T>(rectangle.top + rectangle.height));
+
+    return (std::max(r1MinX, r2MinX) < std::min(r1MaxX, r2MaxX)) &&
+           (std::max(r1MinY, r2MinY) < std::min(r1MaxY, r2MaxY));
 }
 
 
@@ -144,7 +175,7 @@ bool Rect<T>::intersects(const Rect<T>& rectangle, Rect<T>& intersection) const
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-inline bool operator ==(const Rect<T>& left, const Rect<T>& right)
+constexpr bool operator ==(const Rect<T>& left, const Rect<T>& right)
 {
     return (left.left == right.left) && (left.width == right.width) &&
            (left.top == right.top) && (left.height == right.height);
@@ -153,7 +184,7 @@ inline bool operator ==(const Rect<T>& left, const Rect<T>& right)
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-inline bool operator !=(const Rect<T>& left, const Rect<T>& right)
+constexpr bool operator !=(const Rect<T>& left, const Rect<T>& right)
 {
     return !(left == right);
 }
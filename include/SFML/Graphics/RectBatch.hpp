@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RECTBATCH_HPP
+#define SFML_RECTBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class Transformable;
+
+////////////////////////////////////////////////////////////
+/// \brief Array of rectangles tested all at once against a point or a rectangle
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RectBatch
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch.
+    ///
+    ////////////////////////////////////////////////////////////
+    RectBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the rectangles
+    ///
+    /// The memory is kept for the next rectangles.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve memory for a number of rectangles
+    ///
+    /// \param count Number of rectangles to reserve memory for
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a rectangle at the end of the batch
+    ///
+    /// Rectangles with negative dimensions are allowed, as with
+    /// FloatRect::contains and FloatRect::intersects.
+    ///
+    /// \param rectangle Rectangle to add
+    ///
+    /// \return Index of the rectangle in the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const FloatRect& rectangle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace a rectangle of the batch
+    ///
+    /// \param index     Index of the rectangle, as returned by add
+    /// \param rectangle New rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    void set(std::size_t index, const FloatRect& rectangle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of rectangles in the batch
+    ///
+    /// \return Number of rectangles
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the rectangles that contain a point
+    ///
+    /// Gives the same results as calling FloatRect::contains
+    /// on each rectangle, but four rectangles are tested at
+    /// once when SIMD instructions are available (SSE, NEON or
+    /// WebAssembly SIMD).
+    ///
+    /// \param point   Point to test
+    /// \param indices Receives the indices of the rectangles, in increasing order
+    ///
+    /// \return Number of rectangles that contain the point
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findContaining(const Vector2f& point, std::vector<std::size_t>& indices) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the rectangles that intersect a rectangle
+    ///
+    /// Gives the same results as calling FloatRect::intersects
+    /// on each rectangle, four rectangles at a time when SIMD
+    /// instructions are available.
+    ///
+    /// \param rectangle Rectangle to test
+    /// \param indices   Receives the indices of the rectangles, in increasing order
+    ///
+    /// \return Number of rectangles that intersect \a rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findIntersecting(const FloatRect& rectangle, std::vector<std::size_t>& indices) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the transformable objects under a point
+    ///
+    /// The point is brought into the local space of each
+    /// object with its inverse transform (which the object
+    /// keeps cached), and tested against the object's local
+    /// bounds. Rotated and scaled objects are therefore
+    /// picked exactly, not by their bounding rectangle.
+    ///
+    /// \param point       Point to test, in world coordinates
+    /// \param objects     Objects to test
+    /// \param localBounds Local bounds of each object (for example from getLocalBounds)
+    /// \param count       Number of objects
+    /// \param indices     Receives the indices of the objects under the point, in increasing order
+    ///
+    /// \return Number of objects under the point
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t pick(const Vector2f& point, const Transformable* const* objects, const FloatRect* localBounds,
+                            std::size_t count, std::vector<std::size_t>& indices);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<float> m_minX;  ///< Left sides of the rectangles, padded to a multiple of 4
+    std::vector<float> m_minY;  ///< Top sides of the rectangles, padded to a multiple of 4
+    std::vector<float> m_maxX;  ///< Right sides of the rectangles, padded to a multiple of 4
+    std::vector<float> m_maxY;  ///< Bottom sides of the rectangles, padded to a multiple of 4
+    std::size_t        m_count; ///< Number of rectangles
+};
+
+} // namespace sf
+
+
+#endif // SFML_RECTBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RectBatch
+/// \ingroup graphics
+///
+/// sf::RectBatch stores its rectangles as separate arrays of
+/// sides (structure of arrays), so that a point or a
+/// rectangle can be tested against several of them with a
+/// single SIMD instruction. It is meant for the hot paths that
+/// test many rectangles every frame: hit-testing of user
+/// interfaces, broadphase of collisions, culling.
+///
+/// Usage example:
+/// \code
+/// sf::RectBatch buttons;
+/// for (std::size_t i = 0; i < widgets.size(); ++i)
+///     buttons.add(widgets[i].getGlobalBounds());
+///
+/// std::vector<std::size_t> hovered;
+/// if (buttons.findContaining(mousePosition, hovered) > 0)
+///     widgets[hovered.back()].highlight();
+/// \endcode
+///
+/// \see sf::Rect, sf::Transformable
+///
+////////////////////////////////////////////////////////////
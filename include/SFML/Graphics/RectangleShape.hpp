@@ -94,6 +94,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Vector2f getPoint(std::size_t index) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the 4 points of the rectangle
+    ///
+    /// \param points Array that receives the 4 points
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void getPoints(Vector2f* points) const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RENDERPIPELINE_HPP
+#define SFML_RENDERPIPELINE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/RenderStats.hpp>
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+class Texture;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Submit the geometry batched by the render pipeline
+///
+/// Resources that are modified or destroyed while their
+/// draws are still pending in the pipeline batch must call
+/// this function first, so that the pending draws are
+/// rendered with the state they were issued with.
+///
+/// \param texture Flush only if the pending batch uses this
+///                texture, or unconditionally if NULL
+///
+////////////////////////////////////////////////////////////
+void flushPendingDraws(const Texture* texture = NULL);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the counters of the work submitted to OpenGL
+///
+/// The counters are shared by the whole graphics module and
+/// reset by RenderTarget::resetFrameStats.
+///
+////////////////////////////////////////////////////////////
+RenderStats& getRenderStats();
+
+////////////////////////////////////////////////////////////
+/// \brief Destroy the pipelines of all the contexts after they were lost
+///
+/// The pending draws are dropped. The shader programs of the
+/// pipelines must be forgotten first, deleting the buffers
+/// and vertex arrays of a lost context is harmless as long
+/// as the current context has no object yet.
+///
+/// \see ContextRestore::restore
+///
+////////////////////////////////////////////////////////////
+void forgetRenderPipelines();
+
+////////////////////////////////////////////////////////////
+/// \brief Per-instance data of the instanced quad renderer
+///
+/// The instanced pipeline shader expands a unit quad with
+/// the 2x3 affine transform (which includes the size of the
+/// quad), and maps it to the normalized texture rectangle.
+///
+////////////////////////////////////////////////////////////
+struct QuadInstance
+{
+    float row0[3];    ///< First row of the transform (a, b, tx)
+    float row1[3];    ///< Second row of the transform (c, d, ty)
+    float texRect[4]; ///< Normalized texture rectangle (left, top, width, height)
+    Uint8 color[4];   ///< Color (r, g, b, a)
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Per-instance data of the instanced particle renderer
+///
+/// The particle pipeline shader evaluates the motion of the
+/// particle from its age, so that it doesn't need to be
+/// updated after it has been emitted. Particles whose age is
+/// outside [0 .. lifetime] are discarded by the shader.
+///
+////////////////////////////////////////////////////////////
+struct ParticleInstance
+{
+    float motion[4];     ///< Initial position (x, y) and velocity (x, y), per second
+    float life[4];       ///< Spawn time, lifetime (seconds), initial size, final size
+    float spin[2];       ///< Initial rotation and angular velocity (radians, per second)
+    float texRect[4];    ///< Normalized texture rectangle (left, top, width, height)
+    Uint8 startColor[4]; ///< Color at birth (r, g, b, a)
+    Uint8 endColor[4];   ///< Color at death (r, g, b, a)
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Per-instance data of the instanced animated sprite renderer
+///
+/// The animation pipeline shader picks the frame of the
+/// sprite from the time elapsed since the start of its
+/// animation, then expands a unit quad to the size of the
+/// frame with the 2x3 affine transform.
+///
+////////////////////////////////////////////////////////////
+struct AnimatedInstance
+{
+    float row0[3];      ///< First row of the transform (a, b, tx)
+    float row1[3];      ///< Second row of the transform (c, d, ty)
+    float animation[4]; ///< First frame, frame count, frames per second, start time (seconds)
+    Uint8 color[4];     ///< Color (r, g, b, a)
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_RENDERPIPELINE_HPP
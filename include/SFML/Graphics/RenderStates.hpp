@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Transform.hpp>
 
 
@@ -104,6 +105,29 @@ public:
     RenderStates(const BlendMode& theBlendMode, const Transform& theTransform,
                  const Texture* theTexture, const Shader* theShader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pack the states that break batches in a single integer
+    ///
+    /// From the most to the least significant bits: the shader
+    /// program (16 bits), the blend mode (22 bits, see
+    /// BlendMode::getKey), the texture storage (23 bits) and
+    /// the primitive type (3 bits). Sorting draws by key groups
+    /// them by shader first, then by blend mode and texture;
+    /// two draws with the same key can be batched together as
+    /// far as the states are concerned.
+    ///
+    /// The transform is not part of the key, the pipeline
+    /// applies it to the vertices. Programs and textures are
+    /// identified by the low bits of their identifiers, which
+    /// only wrap around after millions of textures were created.
+    ///
+    /// \param type Type of primitives drawn with the states
+    ///
+    /// \return Packed render states
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getKey(PrimitiveType type) const;
+
     ////////////////////////////////////////////////////////////
     // Static member data
     ////////////////////////////////////////////////////////////
@@ -169,6 +193,10 @@ public:
 /// current transform with its own transform. A sprite will
 /// set its texture. Etc.
 ///
+/// Custom batchers and draw queues can compare or sort the
+/// states with getKey, which packs everything but the
+/// transform in a single 64-bit integer.
+///
 /// \see sf::RenderTarget, sf::Drawable
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERSTATS_HPP
+#define SFML_RENDERSTATS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Counters of the work submitted to OpenGL
+///
+////////////////////////////////////////////////////////////
+struct SFML_GRAPHICS_API RenderStats
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Reasons for submitting a pending batch
+    ///
+    ////////////////////////////////////////////////////////////
+    enum FlushReason
+    {
+        FlushTexture,      ///< The next draw uses another texture, and no texture slot of the batch was left
+        FlushPrimitive,    ///< The next draw uses another primitive type
+        FlushFull,         ///< The batch was full
+        FlushView,         ///< The view changed
+        FlushBlendMode,    ///< The blend mode changed
+        FlushScissor,      ///< The scissor rectangle changed
+        FlushUnbatchable,  ///< The next draw can't be batched (shader, vertex buffer, large array)
+        FlushResource,     ///< A texture or render target used by the batch was modified
+        FlushClear,        ///< The render target was cleared
+        FlushExplicit,     ///< RenderTarget::flush was called
+        FlushDepthLayer,   ///< The depth of the next draws changed, in the depth pre-pass
+        FlushClip,         ///< A clip mask was pushed or popped
+        FlushBudgetScope,  ///< A budget scope was pushed or popped
+
+        FlushReasonCount   ///< Keep last -- the total number of flush reasons
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// All the counters are set to 0.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderStats();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint32 drawCalls;                      ///< Number of OpenGL draw calls
+    Uint64 vertices;                       ///< Number of vertices submitted
+    Uint64 bytesUploaded;                  ///< Bytes uploaded to buffers and textures
+    Uint32 programSwitches;                ///< Number of glUseProgram calls
+    Uint32 textureBinds;                   ///< Number of glBindTexture calls
+    Uint32 blendChanges;                   ///< Number of blend function or equation changes
+    Uint32 batchesFlushed;                 ///< Number of batches submitted
+    Uint32 batchesReused;                  ///< Number of batches drawn again from the copy of an identical previous batch, without upload
+    Uint32 drawablesCulled;                ///< Number of drawables skipped because they were outside the view or scissor rectangle
+    Uint32 glyphCacheHits;                 ///< Number of glyph lookups found in the cache of their font
+    Uint32 glyphCacheMisses;               ///< Number of glyph lookups that had to load the glyph
+    Uint32 glyphsRasterized;               ///< Number of glyphs rasterized by FreeType
+    Uint32 textRebuilds;                   ///< Number of texts whose geometry was rebuilt
+    Uint32 flushReasons[FlushReasonCount]; ///< Number of batches submitted, per reason
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Limits on the work submitted by a scope of the frame
+///
+/// A limit of 0 means that the counter is not limited.
+///
+////////////////////////////////////////////////////////////
+struct SFML_GRAPHICS_API RenderBudget
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// No counter is limited.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderBudget();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the budget from its limits
+    ///
+    /// \param drawCalls        Maximum number of OpenGL draw calls (0 for no limit)
+    /// \param bytesUploaded    Maximum number of bytes uploaded (0 for no limit)
+    /// \param glyphCacheMisses Maximum number of glyph cache misses (0 for no limit)
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderBudget(Uint32 drawCalls, Uint64 bytesUploaded, Uint32 glyphCacheMisses);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether counters exceed the budget
+    ///
+    /// \param stats Counters of the scope
+    ///
+    /// \return True if at least one limited counter is over its limit
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isExceeded(const RenderStats& stats) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint32 drawCalls;        ///< Maximum number of OpenGL draw calls
+    Uint64 bytesUploaded;    ///< Maximum number of bytes uploaded to buffers and textures
+    Uint32 glyphCacheMisses; ///< Maximum number of glyph lookups that had to load the glyph
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERSTATS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderStats
+/// \ingroup graphics
+///
+/// sf::RenderStats gathers the counters of what the graphics
+/// module sent to OpenGL: draw calls, vertices, uploads, and
+/// state changes that actually reached the driver (redundant
+/// ones are filtered out before). When batching is enabled,
+/// it also tells how many batches were submitted, and why.
+/// The glyph lookups, rasterizations and text rebuilds made
+/// on the rendering thread are counted as well, to follow
+/// the hit rate of the glyph caches (see Font::getStats for
+/// the counters of each font).
+///
+/// The counters are shared by all the render targets, and
+/// accumulate until RenderTarget::resetFrameStats is called,
+/// which RenderWindow::display does at the end of each frame.
+///
+/// Usage example:
+/// \code
+/// const sf::RenderStats& stats = window.getFrameStats();
+/// if (stats.drawCalls > budget)
+///     reportBudgetOverflow(stats);
+///
+/// window.display(); // resets the counters
+/// \endcode
+///
+/// To catch regressions as they happen, scopes of the frame
+/// can be given a budget with RenderTarget::pushBudgetScope
+/// (see sf::RenderBudget).
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
@@ -34,16 +34,30 @@
 #include <SFML/Graphics/View.hpp>
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/GraphicsCaps.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderStats.hpp>
+#include <SFML/Graphics/StartupStats.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <functional>
+#include <string>
+#include <vector>
 
 
 namespace sf
 {
 class Drawable;
+class DrawCapture;
+class DrawList;
+class Image;
+class IndexBuffer;
+class LayeredVertex;
+class Sprite;
+class TextureArray;
 class VertexBuffer;
+class YuvTexture;
 
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
@@ -53,6 +67,46 @@ class SFML_GRAPHICS_API RenderTarget : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief What happens to the previous contents of the target when a pass begins
+    ///
+    ////////////////////////////////////////////////////////////
+    enum LoadAction
+    {
+        LoadContents,   ///< Keep the previous contents, the pass draws over them
+        ClearContents,  ///< Clear the color, depth and stencil buffers
+        DiscardContents ///< Drop the previous contents, the pass must draw over the whole target
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief What happens to the contents of the target when a pass ends
+    ///
+    ////////////////////////////////////////////////////////////
+    enum StoreAction
+    {
+        StoreAll,  ///< Keep the color, depth and stencil contents
+        StoreColor ///< Keep the color only, the depth and stencil contents are dropped
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Report of a budget scope whose counters exceeded its budget
+    ///
+    ////////////////////////////////////////////////////////////
+    struct BudgetViolation
+    {
+        std::string  scope;  ///< Name of the scope
+        RenderBudget budget; ///< Budget of the scope
+        RenderStats  usage;  ///< Counters of the work submitted within the scope
+        const char*  file;   ///< Source file where the scope was pushed, NULL if unknown
+        unsigned int line;   ///< Line where the scope was pushed, 0 if unknown
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called when a budget scope exceeds its budget
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::function<void(const BudgetViolation& violation)> BudgetCallback;
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -70,6 +124,49 @@ public:
     ////////////////////////////////////////////////////////////
     void clear(const Color& color = Color(0, 0, 0, 255));
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Begin a render pass on the target
+    ///
+    /// A pass tells the driver which contents of the target
+    /// matter. Tiled GPUs (most mobile GPUs) render the target
+    /// tile by tile in on-chip memory: the contents that are
+    /// cleared or discarded are not loaded from video memory
+    /// at the start of the pass, and the contents that are not
+    /// stored are not written back at its end, which saves a
+    /// lot of memory bandwidth.
+    ///
+    /// The store action stays in effect until the next call to
+    /// beginPass. It is applied by endPass, and automatically
+    /// by RenderTexture::display. The default store action is
+    /// StoreColor: SFML doesn't read the depth and stencil
+    /// buffers across passes. Use StoreAll if you do.
+    ///
+    /// Discarding requires OpenGL 4.3, OpenGL ES 3, WebGL 2 or
+    /// EXT_discard_framebuffer. Without them DiscardContents
+    /// and StoreColor do nothing, which is always correct.
+    ///
+    /// \param load       What to do with the previous contents
+    /// \param store      What to do with the contents when the pass ends
+    /// \param clearColor Color to clear the target with, if \a load is ClearContents
+    ///
+    /// \see endPass, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginPass(LoadAction load, StoreAction store = StoreColor, const Color& clearColor = Color(0, 0, 0, 255));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End the current render pass on the target
+    ///
+    /// The pending draws are submitted, then the contents that
+    /// the store action doesn't keep are discarded. Call this
+    /// before presenting a window; render textures call it
+    /// in RenderTexture::display.
+    ///
+    /// \see beginPass
+    ///
+    ////////////////////////////////////////////////////////////
+    void endPass();
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the current active view
     ///
@@ -129,6 +226,142 @@ public:
     ////////////////////////////////////////////////////////////
     IntRect getViewport(const View& view) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Restrict the rendering to a rectangle of the target
+    ///
+    /// Pixels outside \a area are left untouched by the next
+    /// draws and clears, so that a target whose contents are
+    /// kept between frames can be updated only where something
+    /// changed (see sf::DirtyRegion). When culling is enabled,
+    /// drawables entirely outside the area are skipped as well.
+    ///
+    /// Unlike the viewport, the scissor rectangle doesn't change
+    /// the mapping of the coordinates: it only clips. It is
+    /// expressed in pixels, with the origin at the top-left corner
+    /// of the target. An empty rectangle disables the scissor test,
+    /// which is the default.
+    ///
+    /// A DiscardContents pass (see beginPass) keeps the contents
+    /// when the scissor test is enabled.
+    ///
+    /// \param area Rectangle to render to, in pixels
+    ///
+    /// \see getScissor, setCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScissor(const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the scissor rectangle of the target
+    ///
+    /// \return Scissor rectangle in pixels, empty if disabled
+    ///
+    /// \see setScissor
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getScissor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restrict the next draws to a rectangle, until popClip
+    ///
+    /// The rectangle is expressed in world coordinates, mapped
+    /// to pixels with the current view (with a rotated view, the
+    /// clip is the bounding rectangle of the mapped corners). It
+    /// is intersected with the current clip, and applied as the
+    /// scissor rectangle: clipping a rectangle costs no more than
+    /// a flush of the batch, and no render texture.
+    ///
+    /// \param rectangle Area to draw to, in world coordinates
+    ///
+    /// \see pushClipMask, popClip, setScissor
+    ///
+    ////////////////////////////////////////////////////////////
+    void pushClipRect(const FloatRect& rectangle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restrict the next draws to the pixels covered by a drawable, until popClip
+    ///
+    /// The mask is drawn into the stencil buffer only (the
+    /// colours are left untouched) with the current view, and
+    /// the next draws are only rendered where the mask, and the
+    /// enclosing masks, were drawn. Textured masks only count
+    /// the pixels whose alpha is at least 0.5, so that a sprite
+    /// masks with its shape rather than its rectangle; masks
+    /// drawn with a custom shader count all their pixels.
+    ///
+    /// The render target needs a stencil buffer (see
+    /// ContextSettings::stencilBits), whose contents must not be
+    /// cleared while masks are pushed (see beginPass). Up to
+    /// 255 masks can be nested; clear ignores the masks.
+    ///
+    /// \param mask   Drawable whose pixels define the clip area
+    /// \param states Render states to draw the mask with
+    ///
+    /// \see pushClipRect, popClip
+    ///
+    ////////////////////////////////////////////////////////////
+    void pushClipMask(const Drawable& mask, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restore the clip that was active before the last pushClipRect or pushClipMask
+    ///
+    /// \see pushClipRect, pushClipMask
+    ///
+    ////////////////////////////////////////////////////////////
+    void popClip();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start counting the work of the next draws against a budget, until popBudgetScope
+    ///
+    /// The draws batched so far are submitted first, so that
+    /// the counters of the scope only include its own draws.
+    /// Scopes can be nested; the counters of a scope include
+    /// those of its nested scopes. The counters are shared by
+    /// all the render targets (see getFrameStats), so the work
+    /// submitted to other targets within the scope is counted
+    /// too, and resetFrameStats must not be called while a
+    /// scope is open.
+    ///
+    /// Flushing the batch at each scope boundary costs draw
+    /// calls, so budgets are meant for test and QA builds.
+    ///
+    /// \param name   Name of the scope, reported with violations
+    /// \param budget Limits of the counters of the scope
+    /// \param file   Source file pushing the scope (typically __FILE__), or NULL
+    /// \param line   Line pushing the scope (typically __LINE__), or 0
+    ///
+    /// \see popBudgetScope, setBudgetCallback
+    ///
+    ////////////////////////////////////////////////////////////
+    void pushBudgetScope(const std::string& name, const RenderBudget& budget, const char* file = NULL, unsigned int line = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End the last budget scope and check its counters
+    ///
+    /// The draws batched within the scope are submitted, then
+    /// its counters are compared with its budget. If a limit is
+    /// exceeded, the budget callback is called, or the violation
+    /// is written to sf::err() if there is no callback.
+    ///
+    /// \see pushBudgetScope, setBudgetCallback
+    ///
+    ////////////////////////////////////////////////////////////
+    void popBudgetScope();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the function called when a budget scope exceeds its budget
+    ///
+    /// The callback is called by popBudgetScope, on the thread
+    /// that draws to the target. By default there is none, and
+    /// violations are written to sf::err().
+    ///
+    /// \param callback Function to call, or an empty function to write to sf::err()
+    ///
+    /// \see pushBudgetScope
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBudgetCallback(const BudgetCallback& callback);
+
     ////////////////////////////////////////////////////////////
     /// \brief Convert a point from target coordinates to world
     ///        coordinates, using the current view
@@ -227,6 +460,67 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2i mapCoordsToPixel(const Vector2f& point, const View& view) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert an array of points from target coordinates
+    ///        to world coordinates, using the current view
+    ///
+    /// \param points Pixels to convert
+    /// \param coords Array receiving the converted points, in "world" units
+    /// \param count  Number of points
+    ///
+    /// \see mapPixelToCoords
+    ///
+    ////////////////////////////////////////////////////////////
+    void mapPixelsToCoords(const Vector2i* points, Vector2f* coords, std::size_t count) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert an array of points from target coordinates to world coordinates
+    ///
+    /// This is the same as calling mapPixelToCoords for each
+    /// point, but the viewport and the matrix are looked up
+    /// once, and the points are transformed with SIMD
+    /// instructions when they are available (see
+    /// Transform::transformPoints).
+    ///
+    /// \param points Pixels to convert
+    /// \param coords Array receiving the converted points, in "world" units
+    /// \param count  Number of points
+    /// \param view   The view to use for converting the points
+    ///
+    /// \see mapPixelToCoords, mapCoordsToPixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void mapPixelsToCoords(const Vector2i* points, Vector2f* coords, std::size_t count, const View& view) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert an array of points from world coordinates
+    ///        to target coordinates, using the current view
+    ///
+    /// \param points Points to convert
+    /// \param pixels Array receiving the converted points, in target coordinates (pixels)
+    /// \param count  Number of points
+    ///
+    /// \see mapCoordsToPixel
+    ///
+    ////////////////////////////////////////////////////////////
+    void mapCoordsToPixels(const Vector2f* points, Vector2i* pixels, std::size_t count) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert an array of points from world coordinates to target coordinates
+    ///
+    /// This is the same as calling mapCoordsToPixel for each
+    /// point, with the optimizations of mapPixelsToCoords.
+    ///
+    /// \param points Points to convert
+    /// \param pixels Array receiving the converted points, in target coordinates (pixels)
+    /// \param count  Number of points
+    /// \param view   The view to use for converting the points
+    ///
+    /// \see mapCoordsToPixel, mapPixelsToCoords
+    ///
+    ////////////////////////////////////////////////////////////
+    void mapCoordsToPixels(const Vector2f* points, Vector2i* pixels, std::size_t count, const View& view) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw a drawable object to the render target
     ///
@@ -236,6 +530,25 @@ public:
     ////////////////////////////////////////////////////////////
     void draw(const Drawable& drawable, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a sprite to the render target
+    ///
+    /// This overload is a fast path for the most common drawable:
+    /// it skips the virtual call and the copy of the render
+    /// states, and the transform of the sprite is only combined
+    /// with \a states.transform if the latter is not the
+    /// identity. The sprite is culled with its own transform.
+    ///
+    /// Classes derived from sf::Sprite are drawn as plain sprites
+    /// by this overload; draw them as a sf::Drawable to call
+    /// their own draw function.
+    ///
+    /// \param sprite Sprite to draw
+    /// \param states Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Sprite& sprite, const RenderStates& states = RenderStates::Default);
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw primitives defined by an array of vertices
     ///
@@ -248,6 +561,29 @@ public:
     void draw(const Vertex* vertices, std::size_t vertexCount,
               PrimitiveType type, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by an array of vertices
+    ///
+    /// The primitives are assembled from the vertices in the
+    /// order of \a indices, which must all be lower than
+    /// \a vertexCount. Both arrays are streamed to graphics
+    /// memory and drawn with a single call. The vertices of a
+    /// sf::VertexArray can be passed with &array[0].
+    ///
+    /// sf::Quads is not supported, use sf::Triangles instead.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array, at most 65536
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount,
+              const Uint16* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw primitives defined by a vertex buffer
     ///
@@ -268,6 +604,138 @@ public:
     ////////////////////////////////////////////////////////////
     void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw several ranges of an array of vertices at once
+    ///
+    /// Each range is a separate primitive, so that strips and
+    /// fans restart at the beginning of each range. The ranges
+    /// are submitted with a single multi-draw call when the
+    /// driver supports it (glMultiDrawArrays, WEBGL_multi_draw),
+    /// instead of one draw call each. These draws are never
+    /// batched or deferred.
+    ///
+    /// \param vertices      Pointer to the vertices
+    /// \param firstVertices Index of the first vertex of each range
+    /// \param vertexCounts  Number of vertices of each range
+    /// \param rangeCount    Number of ranges
+    /// \param type          Type of primitives to draw
+    /// \param states        Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, const std::size_t* firstVertices, const std::size_t* vertexCounts,
+              std::size_t rangeCount, PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw several ranges of a vertex buffer at once
+    ///
+    /// Same as the overload above, with the primitive type
+    /// of the vertex buffer. The ranges are clamped to the
+    /// vertex buffer, like a single range.
+    ///
+    /// \param vertexBuffer  Vertex buffer
+    /// \param firstVertices Index of the first vertex of each range
+    /// \param vertexCounts  Number of vertices of each range
+    /// \param rangeCount    Number of ranges
+    /// \param states        Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const std::size_t* firstVertices, const std::size_t* vertexCounts,
+              std::size_t rangeCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw several vertex buffers with the same render states
+    ///
+    /// Consecutive vertex buffers that share the same graphics
+    /// buffer (see sf::VertexBufferArena) and primitive type are
+    /// drawn without rebinding anything, with a single
+    /// multi-draw call when the driver supports it. Sort the
+    /// buffers by arena block to get the fewest calls. Null
+    /// pointers and empty buffers are skipped.
+    ///
+    /// \param vertexBuffers Pointers to the vertex buffers
+    /// \param count         Number of vertex buffers
+    /// \param states        Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer* const* vertexBuffers, std::size_t count, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by a vertex buffer
+    ///
+    /// The primitive type of the vertex buffer is used; sf::Quads
+    /// is not supported, use sf::Triangles instead.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Indices of the vertices to assemble
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by a vertex buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Indices of the vertices to assemble
+    /// \param firstIndex   Index of the first index to render
+    /// \param indexCount   Number of indices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives textured with the layers of a texture array
+    ///
+    /// Each vertex selects its layer, so geometry using any
+    /// number of layers is drawn in a single call. The texture
+    /// of \a states is ignored. Pending batched draws are
+    /// submitted first; these draws are never batched or
+    /// deferred themselves.
+    ///
+    /// \param vertices     Pointer to the vertices
+    /// \param vertexCount  Number of vertices in the array
+    /// \param type         Type of primitives to draw
+    /// \param textureArray Texture array to sample
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const LayeredVertex* vertices, std::size_t vertexCount, PrimitiveType type,
+              const TextureArray& textureArray, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives textured with the planes of a YUV texture
+    ///
+    /// The planes are converted to RGB by a built-in shader,
+    /// with the color space and range of \a texture. The texture
+    /// coordinates are in pixels of the luma plane, and the
+    /// texture of \a states is ignored. With a custom shader,
+    /// the planes are bound to the texture units 0, 1 and 2.
+    /// These draws are never batched.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param texture     YUV texture to sample
+    /// \param states      Render states to use for drawing
+    ///
+    /// \see YuvSprite
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+              const YuvTexture& texture, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit the commands recorded in a draw list
+    ///
+    /// The commands are drawn in the order of the list, like
+    /// separate calls to draw, with their recorded layer.
+    ///
+    /// \param drawList Draw list to submit
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const DrawList& drawList);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -352,6 +820,12 @@ public:
     /// states needed by SFML are set, so that subsequent draw()
     /// calls will work as expected.
     ///
+    /// SFML keeps a CPU-side copy of the OpenGL bindings it makes
+    /// (program, buffers, textures, frame buffer, blending) so
+    /// that it never has to query the driver. This function
+    /// discards that copy, so it must be called after any raw
+    /// OpenGL code that changes these states.
+    ///
     /// Example:
     /// \code
     /// // OpenGL code here...
@@ -366,6 +840,424 @@ public:
     ////////////////////////////////////////////////////////////
     void resetGLStates();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic batching of draws
+    ///
+    /// When batching is enabled, consecutive draws of vertices
+    /// that use the same blend mode and no shader
+    /// are pre-transformed on the CPU and accumulated, then
+    /// rendered with a single draw call. The pending geometry
+    /// is submitted when the render states change, when the
+    /// batch is full, or when flush is called.
+    ///
+    /// A batch can mix up to 8 textures (fewer if the GPU has
+    /// less texture units), each bound to its own unit; only
+    /// single channel and distance field textures break the
+    /// batch at each texture change.
+    ///
+    /// Batching is disabled by default.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic batching of draws is enabled
+    ///
+    /// \return True if batching is enabled, false otherwise
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable culling of the drawables outside the view
+    ///
+    /// When culling is enabled, draw(const Drawable&, const RenderStates&)
+    /// skips the drawables whose bounds (see Drawable::getCullingBounds),
+    /// transformed by the render states, don't intersect the
+    /// area of the current view, and the scissor rectangle if
+    /// any (see setScissor). Sprites, shapes, texts, tiled
+    /// textures and vertex arrays provide their bounds, other
+    /// drawables are always drawn.
+    ///
+    /// The bounds only cover the geometry given to the target:
+    /// disable culling for drawables rendered with a vertex
+    /// shader that moves their vertices.
+    ///
+    /// Culling is disabled by default.
+    ///
+    /// \param enabled True to enable culling, false to disable it
+    ///
+    /// \see isCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCullingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether culling of the drawables outside the view is enabled
+    ///
+    /// \return True if culling is enabled, false otherwise
+    ///
+    /// \see setCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCullingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit all the pending batched draws
+    ///
+    /// This function must be called at the end of the frame
+    /// (before the window buffers are swapped) when batching
+    /// or deferred rendering is enabled, or before issuing
+    /// direct OpenGL commands. sf::RenderTexture::display
+    /// calls it automatically.
+    ///
+    /// The draws recorded in deferred mode are replayed first.
+    ///
+    /// \see setBatchingEnabled, setDeferredEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counters of the work submitted to OpenGL
+    ///
+    /// The counters (draw calls, uploads, state changes, batch
+    /// flushes) are shared by all the render targets, and keep
+    /// accumulating until resetFrameStats is called, which
+    /// RenderWindow::display does at the end of each frame.
+    ///
+    /// \return Counters since the last call to resetFrameStats
+    ///
+    /// \see resetFrameStats
+    ///
+    ////////////////////////////////////////////////////////////
+    const RenderStats& getFrameStats() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the features of the OpenGL context
+    ///
+    /// The features are detected once, the first time the
+    /// graphics module uses OpenGL, and are shared by all the
+    /// render targets.
+    ///
+    /// \return Capability tier and available features
+    ///
+    ////////////////////////////////////////////////////////////
+    const GraphicsCaps& getGraphicsCaps() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start reading back pixels without waiting for the GPU
+    ///
+    /// The copy of the area includes all the draws issued so far.
+    /// It is recorded in a pixel buffer object and performed by
+    /// the GPU in the background, so that the call doesn't drain
+    /// the rendering pipeline. The pixels are retrieved later,
+    /// typically a few frames after, with collectPixels.
+    ///
+    /// Pixel buffers and sync objects need GL 3.2 or GLES 3.0.
+    /// On older contexts and WebGL, the pixels are read right
+    /// away, and collectPixels returns them immediately.
+    ///
+    /// Multisampled render textures can't be read directly,
+    /// read the contents of their texture instead.
+    ///
+    /// \param area Area to read, in pixels, from the top-left corner of the target
+    ///
+    /// \return Token identifying the readback, 0 on failure
+    ///
+    /// \see collectPixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 readPixelsAsync(const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the pixels of an asynchronous readback
+    ///
+    /// If the GPU has not finished the copy yet, this function
+    /// returns false and the readback stays pending, unless
+    /// \a wait is true. Once retrieved, the readback is
+    /// released and its token becomes invalid.
+    ///
+    /// \param token Token returned by readPixelsAsync
+    /// \param image Receives the pixels, top row first
+    /// \param wait  Block until the copy is done?
+    ///
+    /// \return True if the pixels were retrieved
+    ///
+    /// \see readPixelsAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool collectPixels(Uint64 token, Image& image, bool wait = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the overdraw heatmap
+    ///
+    /// This is a debug mode that shows where the fill rate goes.
+    /// While it is enabled, the built-in pipeline shaders and
+    /// the custom shaders are replaced by a shader that outputs
+    /// a constant increment, added to the target whatever the
+    /// blend mode, and clear fills the target with black. Each
+    /// pixel then counts the fragments drawn to it, as a heat
+    /// colour: dark red for a single layer, bright red around
+    /// 8 layers, orange around 16, yellow from 32 layers.
+    ///
+    /// Instanced quads, particles and texture arrays keep their
+    /// own shaders, and are only added up with the real colours.
+    ///
+    /// The heatmap is disabled by default.
+    ///
+    /// \param enabled True to draw the overdraw heatmap, false to draw normally
+    ///
+    /// \see isOverdrawHeatmapEnabled, readOverdrawAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOverdrawHeatmapEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the overdraw heatmap is enabled
+    ///
+    /// \return True if the overdraw heatmap is drawn
+    ///
+    /// \see setOverdrawHeatmapEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isOverdrawHeatmapEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start reading back the overdraw heatmap without waiting for the GPU
+    ///
+    /// This reads the whole target with readPixelsAsync; call it
+    /// once the frame is drawn with the overdraw heatmap enabled,
+    /// before it is displayed.
+    ///
+    /// \return Token identifying the readback, 0 on failure
+    ///
+    /// \see collectOverdraw, setOverdrawHeatmapEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 readOverdrawAsync();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the average overdraw of an asynchronous heatmap readback
+    ///
+    /// The overdraw factor is the average number of fragments
+    /// drawn per pixel of the target: 1 means that every pixel
+    /// was drawn once, 3 that the GPU filled the target three
+    /// times. The count of a pixel saturates at 127 fragments.
+    ///
+    /// \param token  Token returned by readOverdrawAsync
+    /// \param factor Receives the average number of fragments per pixel
+    /// \param wait   Block until the copy is done?
+    ///
+    /// \return True if the readback was done and \a factor was written
+    ///
+    /// \see readOverdrawAsync, collectPixels
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool collectOverdraw(Uint64 token, float& factor, bool wait = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the counters of the work submitted to OpenGL
+    ///
+    /// This function is called once per frame, after the
+    /// buffers are swapped, by RenderWindow::display.
+    /// Applications that present their frames without calling
+    /// RenderWindow::display must call it themselves. It also
+    /// starts a new frame for the last-use stamps of the
+    /// textures (see GpuMemory), and resets the frame arena of
+    /// the calling thread (see FrameArena::getDefault).
+    ///
+    /// \see getFrameStats
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetFrameStats();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy what SFML created for the current OpenGL context
+    ///
+    /// Vertex arrays and frame buffer objects are not shared
+    /// between OpenGL contexts, so the render targets keep a
+    /// pipeline (buffers, vertex arrays, built-in shaders) and
+    /// a shadow of the OpenGL states per context, created the
+    /// first time a context is used. Each context, typically
+    /// one per window and thread, therefore renders with its
+    /// own submission stream.
+    ///
+    /// Call this function with the context current, before
+    /// deleting a context that SFML rendered with (with
+    /// SDL_GL_DeleteContext). The pipeline of the last context
+    /// is also destroyed with the last render target.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void releaseContext();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the draws of the target into a capture
+    ///
+    /// Every clear and draw submitted to the target is written
+    /// to the capture until it is detached, and each endPass
+    /// (thus each display) ends a frame. The capture must stay
+    /// alive as long as it is attached.
+    ///
+    /// \param capture Capture to write to, NULL to stop capturing
+    ///
+    /// \see getCapture, DrawCapture, DrawReplay
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCapture(DrawCapture* capture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the capture the draws are recorded into
+    ///
+    /// \return Attached capture, NULL if not capturing
+    ///
+    /// \see setCapture
+    ///
+    ////////////////////////////////////////////////////////////
+    DrawCapture* getCapture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Look up only the OpenGL functions that SFML calls
+    ///
+    /// The OpenGL loader normally fetches the address of each
+    /// function of each version and extension it knows (over a
+    /// thousand, and each lookup is slow in the browser). With
+    /// minimal loading, which is enabled by default, only the
+    /// functions used by the graphics module are looked up.
+    ///
+    /// Disable it if the application calls OpenGL directly
+    /// through the functions declared in SFML/glad.h. It must
+    /// be called before the first render target is created.
+    ///
+    /// \param enabled True to load only the functions SFML calls
+    ///
+    /// \see getStartupStats
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setMinimalGLLoading(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the breakdown of the initialization time
+    ///
+    /// The OpenGL loader, the detection of the features and
+    /// the creation of the pipeline are timed when the first
+    /// render target is created; the wait for the built-in
+    /// shaders and the time to the first frame are completed
+    /// by the first RenderWindow::display.
+    ///
+    /// \return Durations of the initialization steps
+    ///
+    /// \see setMinimalGLLoading
+    ///
+    ////////////////////////////////////////////////////////////
+    static const StartupStats& getStartupStats();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable deferred rendering
+    ///
+    /// In deferred mode, the draws of vertices that use no shader
+    /// are recorded instead of being rendered. They are replayed
+    /// through the batcher when flush is called, or when an
+    /// operation that depends on them happens (clear, shader or
+    /// vertex buffer draws, texture updates, target switch).
+    ///
+    /// Before replay, the draws are sorted by layer (see
+    /// setDrawLayer), then by texture and blend mode, so that
+    /// the fewest possible state changes happen. The order of
+    /// draws sharing the same layer and states is preserved,
+    /// but draws of a same layer may be reordered: only group in
+    /// a layer the draws that do not overlap, or whose order
+    /// doesn't matter.
+    ///
+    /// Deferred rendering is disabled by default.
+    ///
+    /// \param enabled True to enable deferred rendering, false to disable it
+    ///
+    /// \see isDeferredEnabled, setDrawLayer, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDeferredEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether deferred rendering is enabled
+    ///
+    /// \return True if deferred rendering is enabled, false otherwise
+    ///
+    /// \see setDeferredEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDeferredEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the layer of the next deferred draws
+    ///
+    /// Layers are replayed in increasing order, and the draws
+    /// of a layer are only sorted against each other. Layer 0
+    /// is the default one.
+    ///
+    /// \param layer New draw layer
+    ///
+    /// \see getDrawLayer, setDeferredEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDrawLayer(Uint8 layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layer of the next deferred draws
+    ///
+    /// \return Current draw layer
+    ///
+    /// \see setDrawLayer
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8 getDrawLayer() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the depth pre-pass of deferred draws
+    ///
+    /// When enabled, the opaque deferred draws are replayed
+    /// first, from the front layer to the back one, with depth
+    /// test and depth writes on and blending off; each layer
+    /// gets its own depth. The other draws are replayed next,
+    /// in the usual order, with the depth test on. The GPU
+    /// then skips the pixels of back layers that are hidden by
+    /// opaque draws of front layers, which saves a lot of fill
+    /// rate with layered full screen backgrounds.
+    ///
+    /// A draw is opaque if all its vertices have an alpha of
+    /// 255, if its texture is opaque (see Texture::isOpaque)
+    /// or if it has no texture, and if its blend mode is
+    /// sf::BlendAlpha, sf::BlendNone or equivalent. Within a
+    /// layer, the opaque draws end up below the other ones.
+    ///
+    /// The render target must have a depth buffer, which is
+    /// cleared by clear while the pre-pass is enabled. It has
+    /// no effect if deferred rendering is disabled, and it is
+    /// disabled by default.
+    ///
+    /// \param enabled True to enable the depth pre-pass, false to disable it
+    ///
+    /// \see isDepthPrePassEnabled, setDeferredEnabled, setDrawLayer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDepthPrePassEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the depth pre-pass of deferred draws is enabled
+    ///
+    /// \return True if the depth pre-pass is enabled, false otherwise
+    ///
+    /// \see setDepthPrePassEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDepthPrePassEnabled() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -383,14 +1275,112 @@ protected:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the tracking of the drawn area
+    ///
+    /// When enabled, the target accumulates the bounding rectangle
+    /// of everything drawn to it, so that derived classes can
+    /// restrict the work done on their contents (like resolving
+    /// a multisample buffer) to the pixels that actually changed.
+    /// Tracking is disabled by default.
+    ///
+    /// \param enabled True to enable tracking, false to disable it
+    ///
+    /// \see takeDirtyArea
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDirtyTracking(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area drawn since the previous call, and reset it
+    ///
+    /// The area is in target pixels, with the origin at the top-left
+    /// corner (like mapCoordsToPixel), clamped to the target size.
+    /// Draws whose extent is not known on the CPU (vertex buffers,
+    /// instances, clears) mark the whole target.
+    ///
+    /// \return Drawn area, empty if nothing was drawn or tracking is disabled
+    ///
+    /// \see setDirtyTracking
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect takeDirtyArea();
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the whole target as drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    void markDirty();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the area covered by vertices as drawn
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param states      Render states used for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void markDirty(const Vertex* vertices, std::size_t vertexCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a rectangle to the drawn area
+    ///
+    /// \param area Rectangle to add, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void mergeDirtyArea(const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a drawable is outside the area of the current view
+    ///
+    /// Culled drawables are counted in the render stats.
+    ///
+    /// \param bounds Bounds of the drawable, in world coordinates
+    ///
+    /// \return True if the drawable can be skipped
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCulled(const FloatRect& bounds);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
     ////////////////////////////////////////////////////////////
     void applyCurrentView();
 
+    struct ViewMapping;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the pixel viewport and the mapping matrices of a view
+    ///
+    /// The mappings of the last few views are cached, keyed by
+    /// the generation of the view and the size of the target.
+    ///
+    ////////////////////////////////////////////////////////////
+    const ViewMapping& getViewMapping(const View& view) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the scissor rectangle and the stencil test of the clip masks
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyScissor();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the stencil state of the clip masks
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyStencil();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area of the target that draws can modify
+    ///
+    /// \return Bounds of the target, clipped by the scissor rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getDrawableArea() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new blending mode
     ///
@@ -424,6 +1414,95 @@ private:
     ////////////////////////////////////////////////////////////
     void cleanupDraw(const RenderStates& states);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw instanced quads from a buffer of priv::QuadInstance
+    ///
+    /// Used by SpriteBatch, requires priv::isInstancingAvailable().
+    ///
+    /// \param instanceBuffer OpenGL buffer holding the instances
+    /// \param instanceCount  Number of instances to draw
+    /// \param states         Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawQuadInstances(unsigned int instanceBuffer, std::size_t instanceCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw instanced particles from a buffer of priv::ParticleInstance
+    ///
+    /// Used by ParticleSystem, requires priv::isInstancingAvailable().
+    /// Custom shaders are not supported, states.shader is ignored.
+    ///
+    /// \param instanceBuffer OpenGL buffer holding the instances
+    /// \param instanceCount  Number of instances to draw
+    /// \param time           Current time of the simulation, in seconds
+    /// \param gravity        Acceleration applied to all the particles, per second squared
+    /// \param states         Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawParticleInstances(unsigned int instanceBuffer, std::size_t instanceCount, float time,
+                               const Vector2f& gravity, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw instanced animated sprites from a buffer of priv::AnimatedInstance
+    ///
+    /// Used by AnimatedSpriteBatch, requires priv::isInstancingAvailable().
+    /// Custom shaders are not supported, states.shader is ignored.
+    ///
+    /// \param instanceBuffer OpenGL buffer holding the instances
+    /// \param instanceCount  Number of instances to draw
+    /// \param time           Current time of the animations, in seconds
+    /// \param frames         Frame table, as (left, top, width, height) rectangles in pixels
+    /// \param frameCount     Number of frames in the table
+    /// \param framesId       Unique number that identifies the content of the frame table
+    /// \param states         Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawAnimatedInstances(unsigned int instanceBuffer, std::size_t instanceCount, float time,
+                               const float* frames, std::size_t frameCount, Uint64 framesId,
+                               const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw glyph quads with an outline computed by the fragment shader
+    ///
+    /// Used by Text in the ShaderOutline mode. The glyphs are
+    /// drawn as triangles with the font texture of \a states.
+    /// Custom shaders replace the outline shader, the glyphs
+    /// are then drawn without outline.
+    ///
+    /// \param vertices     Pointer to the vertices
+    /// \param vertexCount  Number of vertices in the array
+    /// \param outlineColor Color of the outline
+    /// \param outlineWidth Width of the outline, in the units of the font texture (see Font::getShaderOutlineWidth)
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawOutlinedGlyphs(const Vertex* vertices, std::size_t vertexCount, const Color& outlineColor,
+                            float outlineWidth, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw vertices right away, bypassing the deferred queue
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawImmediate(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a draw in the deferred queue
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordDeferred(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sort and replay the deferred queue
+    ///
+    ////////////////////////////////////////////////////////////
+    void replayDeferred();
+
+    friend class AnimatedSpriteBatch;
+    friend class SpriteBatch;
+    friend class ParticleSystem;
+    friend class Text;
+    friend class TextBatch;
+
     ////////////////////////////////////////////////////////////
     /// \brief Render states cache
     ///
@@ -435,18 +1514,118 @@ private:
         bool      enable;         ///< Is the cache enabled?
         bool      glStatesSet;    ///< Are our internal GL states set yet?
         bool      viewChanged;    ///< Has the current view changed since last draw?
-        BlendMode lastBlendMode;  ///< Cached blending mode
+        bool      scissorChanged; ///< Has the scissor rectangle changed since last draw?
         Uint64    lastTextureId;  ///< Cached texture
         Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief What the draws do to the stencil buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    enum StencilMode
+    {
+        StencilTest,      ///< Draw where the stencil is the depth of the clip masks
+        StencilIncrement, ///< Draw a mask: increment the stencil where it is the depth of the clip masks
+        StencilClamp      ///< Leave a mask: lower the stencil to the depth of the clip masks
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Saved state of a clip
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ClipEntry
+    {
+        IntRect scissor; ///< Scissor rectangle before the clip was pushed
+        bool    mask;    ///< Is it a stencil mask (else a rectangle)?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open budget scope
+    ///
+    ////////////////////////////////////////////////////////////
+    struct BudgetEntry
+    {
+        std::string  name;   ///< Name of the scope
+        RenderBudget budget; ///< Budget of the scope
+        RenderStats  start;  ///< Counters when the scope was pushed
+        const char*  file;   ///< Source file where the scope was pushed
+        unsigned int line;   ///< Line where the scope was pushed
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw recorded in deferred mode
+    ///
+    ////////////////////////////////////////////////////////////
+    struct DeferredDraw
+    {
+        Uint64         key;         ///< Sort key: layer, blend mode, texture, view
+        const Texture* texture;     ///< Texture of the draw
+        std::size_t    blendMode;   ///< Index of the blend mode in the frame table
+        std::size_t    view;        ///< Index of the view in the frame table
+        std::size_t    firstVertex; ///< First pre-transformed vertex in the frame arena
+        std::size_t    vertexCount; ///< Number of vertices
+        PrimitiveType  type;        ///< Type of primitives
+        bool           opaque;      ///< Is the draw replayed in the depth pre-pass?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deferred draws of the current frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct DeferredQueue
+    {
+        std::vector<DeferredDraw> draws;       ///< Recorded draws
+        std::vector<Vertex>       vertices;    ///< Frame arena of pre-transformed vertices
+        std::vector<View>         views;       ///< Views used by the draws
+        std::vector<BlendMode>    blendModes;  ///< Blend modes used by the draws
+        std::vector<Uint32>       blendKeys;   ///< Keys of the blend modes, in the same order
+        bool                      viewChanged; ///< Has the view changed since the last recorded draw?
+        Uint8                     layer;       ///< Layer of the next draws
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Viewport and coordinate mappings of a view, for the current size of the target
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ViewMapping
+    {
+        enum {CacheSize = 4};
+
+        Uint64    generation;    ///< Generation of the view (0 if the entry is unused)
+        Vector2u  size;          ///< Size of the target
+        IntRect   viewport;      ///< Viewport, in pixels
+        Transform pixelToCoords; ///< Pixels to world coordinates
+        Transform coordsToPixel; ///< World coordinates to pixels
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; ///< Default view
-    View        m_view;        ///< Current view
-    StatesCache m_cache;       ///< Render states cache
-    Uint64      m_id;          ///< Unique number that identifies the RenderTarget
+    View          m_defaultView;   ///< Default view
+    View          m_view;          ///< Current view
+    StatesCache   m_cache;         ///< Render states cache
+    Uint64        m_id;            ///< Unique number that identifies the RenderTarget
+    bool          m_batching;      ///< Are draws batched?
+    bool          m_culling;       ///< Are drawables outside the view skipped?
+    bool          m_cullAreaValid; ///< Is m_cullArea up to date with the current view?
+    FloatRect     m_cullArea;      ///< Bounding rectangle of the area of the current view
+    bool          m_deferred;      ///< Are draws deferred?
+    DeferredQueue m_queue;         ///< Deferred draws of the current frame
+    bool          m_depthPrePass;  ///< Are opaque deferred draws replayed front to back, with depth testing?
+    bool          m_overdraw;      ///< Is the overdraw heatmap drawn instead of the real colours?
+    StoreAction   m_storeAction;   ///< What to keep of the contents at the end of a pass
+    bool          m_dirtyTracking; ///< Is the drawn area tracked?
+    IntRect       m_dirtyArea;     ///< Area drawn since the last call to takeDirtyArea, in pixels
+    IntRect       m_scissor;       ///< Scissor rectangle, in pixels (disabled if empty)
+    std::vector<ClipEntry> m_clipStack; ///< Clips pushed with pushClipRect and pushClipMask
+    unsigned int  m_clipDepth;     ///< Number of clip masks in the stack, i.e. stencil value of the visible pixels
+    std::vector<BudgetEntry> m_budgetStack; ///< Scopes pushed with pushBudgetScope
+    BudgetCallback m_budgetCallback; ///< Function called when a scope exceeds its budget
+    StencilMode   m_stencilMode;   ///< What the draws do to the stencil buffer
+    DrawCapture*  m_capture;       ///< Recorder of the draws, NULL if not capturing
+    mutable ViewMapping  m_viewMappings[ViewMapping::CacheSize]; ///< Mappings of the last views used
+    mutable unsigned int m_nextViewMapping; ///< Entry of m_viewMappings replaced by the next miss
 };
 
 } // namespace sf
@@ -32,6 +32,7 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Window/ContextSettings.hpp>
+#include <vector>
 
 
 namespace sf
@@ -108,6 +109,41 @@ public:
     ////////////////////////////////////////////////////////////
     bool create(unsigned int width, unsigned int height, const ContextSettings& settings = ContextSettings());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the render-texture with several color attachments
+    ///
+    /// Everything drawn to the render-texture is written to
+    /// \a attachmentCount textures at once, so that a single
+    /// geometry pass can output several images (albedo, normals,
+    /// emission...). A fragment shader selects what goes to each
+    /// texture by writing to gl_FragData[i], the built-in shaders
+    /// (draws without a custom shader) only define the first one.
+    /// On OpenGL ES 2.0 the shader must enable the
+    /// GL_EXT_draw_buffers extension.
+    ///
+    /// All the attachments share the same pixel \a format:
+    /// Texture::R8 for masks and Texture::RGBA16F for HDR or
+    /// accumulation buffers, whose values are not clamped to
+    /// [0 .. 1] by blending. Check Texture::isFormatAvailable
+    /// first, formats other than Texture::RGBA8 are not
+    /// supported everywhere.
+    ///
+    /// Multiple attachments and formats other than Texture::RGBA8
+    /// can't be combined with anti-aliasing.
+    ///
+    /// \param width           Width of the render-texture
+    /// \param height          Height of the render-texture
+    /// \param settings        Additional settings for the underlying OpenGL texture and context
+    /// \param attachmentCount Number of color textures, between 1 and getMaximumAttachmentCount()
+    /// \param format          Pixel format of the color textures
+    ///
+    /// \return True if creation has been successful
+    ///
+    /// \see getTexture(unsigned int) const, getAttachmentCount
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, const ContextSettings& settings, unsigned int attachmentCount, Texture::Format format = Texture::RGBA8);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the maximum anti-aliasing level supported by the system
     ///
@@ -116,10 +152,19 @@ public:
     ////////////////////////////////////////////////////////////
     static unsigned int getMaximumAntialiasingLevel();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of color attachments supported by the system
+    ///
+    /// \return The maximum number of textures rendered to at once, at least 1
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAttachmentCount();
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable texture smoothing
     ///
-    /// This function is similar to Texture::setSmooth.
+    /// This function is similar to Texture::setSmooth, and
+    /// applies to all the color attachments.
     /// This parameter is disabled by default.
     ///
     /// \param smooth True to enable smoothing, false to disable it
@@ -142,7 +187,8 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable texture repeating
     ///
-    /// This function is similar to Texture::setRepeated.
+    /// This function is similar to Texture::setRepeated, and
+    /// applies to all the color attachments.
     /// This parameter is disabled by default.
     ///
     /// \param repeated True to enable repeating, false to disable it
@@ -166,7 +212,7 @@ public:
     /// \brief Generate a mipmap using the current texture data
     ///
     /// This function is similar to Texture::generateMipmap and operates
-    /// on the texture used as the target for drawing.
+    /// on the textures used as the target for drawing.
     /// Be aware that any draw operation may modify the base level image data.
     /// For this reason, calling this function only makes sense after all
     /// drawing is completed and display has been called. Not calling display
@@ -203,6 +249,13 @@ public:
     /// function is mandatory at the end of rendering. Not calling
     /// it may leave the texture in an undefined state.
     ///
+    /// With anti-aliasing, the multisampled pixels are copied to
+    /// the texture only when it is first used afterwards (drawn,
+    /// bound, copied or read back), and only in the area drawn
+    /// since the previous copy. If the texture is used directly
+    /// through OpenGL with its native handle, call
+    /// Texture::bind before to make sure that it is up to date.
+    ///
     ////////////////////////////////////////////////////////////
     void display();
 
@@ -233,13 +286,36 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only reference to a color attachment
+    ///
+    /// The texture at index 0 is the one returned by getTexture().
+    ///
+    /// \param index Index of the attachment, less than getAttachmentCount()
+    ///
+    /// \return Const reference to the texture
+    ///
+    /// \see create(unsigned int, unsigned int, const ContextSettings&, unsigned int)
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(unsigned int index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of color attachments
+    ///
+    /// \return Number of textures rendered to at once
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getAttachmentCount() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    priv::RenderTextureImpl* m_impl;    ///< Platform/hardware specific implementation
-    Texture                  m_texture; ///< Target texture to draw on
+    priv::RenderTextureImpl* m_impl;        ///< Platform/hardware specific implementation
+    Texture                  m_texture;     ///< Target texture to draw on
+    std::vector<Texture>     m_attachments; ///< Additional color attachments, after m_texture
 };
 
 } // namespace sf
@@ -28,7 +28,9 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
@@ -57,13 +59,13 @@ public:
     ///
     /// \param width      Width of the texture to render to
     /// \param height     Height of the texture to render to
-    /// \param textureId  OpenGL identifier of the target texture
+    /// \param textureIds OpenGL identifiers of the target textures, one per color attachment
     /// \param settings   Context settings to create render-texture with
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, const ContextSettings& settings) = 0;
+    virtual bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const ContextSettings& settings) = 0;
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
@@ -78,10 +80,32 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Update the pixels of the target texture
     ///
+    /// Implementations that render to an intermediate buffer may
+    /// only record \a area here, and copy it to the texture in
+    /// resolve when the texture is actually used.
+    ///
     /// \param textureId OpenGL identifier of the target texture
+    /// \param area      Area drawn since the previous update, in pixels
+    ///                  with the origin at the top-left corner
+    ///
+    /// \return True if resolve must be called before the texture is used
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool updateTexture(unsigned int textureId, const IntRect& area) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the pending pixels to the target texture
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void resolve() = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether updateTexture needs the drawn area
+    ///
+    /// \return True if the drawn area must be tracked
     ///
     ////////////////////////////////////////////////////////////
-    virtual void updateTexture(unsigned int textureId) = 0;
+    virtual bool needsDirtyArea() const = 0;
 };
 
 } // namespace priv
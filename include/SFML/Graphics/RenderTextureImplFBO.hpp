@@ -31,6 +31,7 @@
 #include <SFML/Graphics/RenderTextureImpl.hpp>
 #include <SFML/Window/ContextSettings.hpp>
 #include <map>
+#include <vector>
 
 
 namespace sf
@@ -66,6 +67,14 @@ public:
     ////////////////////////////////////////////////////////////
     static unsigned int getMaximumAntialiasingLevel();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of color attachments supported by the system
+    ///
+    /// \return The maximum number of textures rendered to at once, at least 1
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAttachmentCount();
+
     ////////////////////////////////////////////////////////////
     /// \brief Unbind the currently bound FBO
     ///
@@ -79,13 +88,13 @@ private:
     ///
     /// \param width      Width of the texture to render to
     /// \param height     Height of the texture to render to
-    /// \param textureId  OpenGL identifier of the target texture
+    /// \param textureIds OpenGL identifiers of the target textures, one per color attachment
     /// \param settings   Context settings to create render-texture with
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, const ContextSettings& settings);
+    virtual bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const ContextSettings& settings);
 
     ////////////////////////////////////////////////////////////
     /// \brief Create an FBO in the current context
@@ -108,23 +117,48 @@ private:
     ////////////////////////////////////////////////////////////
     /// \brief Update the pixels of the target texture
     ///
+    /// With a multisample frame buffer, \a area is only added to
+    /// the pending resolve area, resolve copies it.
+    ///
     /// \param textureId OpenGL identifier of the target texture
+    /// \param area      Area drawn since the previous update, in pixels
+    ///
+    /// \return True if resolve must be called before the texture is used
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool updateTexture(unsigned textureId, const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Blit the pending area of the multisample frame buffer to the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void resolve();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether updateTexture needs the drawn area
+    ///
+    /// \return True if there is a multisample frame buffer to resolve
     ///
     ////////////////////////////////////////////////////////////
-    virtual void updateTexture(unsigned textureId);
+    virtual bool needsDirtyArea() const;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int                   m_frameBufferId;
-    unsigned int                   m_multisampleFrameBufferId;
+    unsigned int                   m_frameBufferId;           ///< Frame buffer with the target texture attached
+    unsigned int                   m_multisampleFrameBufferId; ///< Optional multisample frame buffer, resolved to m_frameBufferId
     unsigned int                   m_depthStencilBuffer;      ///< Optional depth/stencil buffer attached to the frame buffer
     unsigned int                   m_colorBuffer;             ///< Optional multisample color buffer attached to the frame buffer
     unsigned int                   m_width;                   ///< Width of the attachments
     unsigned int                   m_height;                  ///< Height of the attachments
     unsigned int                   m_textureId;               ///< The ID of the texture to attach to the FBO
+    std::vector<unsigned int>      m_textureIds;              ///< The IDs of all the color attachments, m_textureId first
     bool                           m_multisample;             ///< Whether we have to create a multisample frame buffer as well
     bool                           m_stencil;                 ///< Whether we have stencil attachment
+    bool                           m_implicitResolve;         ///< Whether the texture is attached as multisampled (EXT_multisampled_render_to_texture)
+    unsigned int                   m_samples;                 ///< Sample count of the implicitly resolved attachments
+    IntRect                        m_resolveArea;             ///< Area of the multisample frame buffer not yet copied to the texture
+    Uint64                         m_memoryUsage;             ///< Estimated size of the render buffers, in bytes
 };
 
 } // namespace priv
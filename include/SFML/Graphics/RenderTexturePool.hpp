@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RENDERTEXTUREPOOL_HPP
+#define SFML_RENDERTEXTUREPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/ContextSettings.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTexture;
+
+////////////////////////////////////////////////////////////
+/// \brief Recycler of the render textures used as temporary targets
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderTexturePool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty pool.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Destroys all the render textures of the pool, so an
+    /// OpenGL context must be active.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a temporary render texture
+    ///
+    /// A render texture of the pool with the same size, depth,
+    /// stencil, anti-aliasing and sRGB settings is returned if
+    /// one is available, otherwise a new one is created. The
+    /// render texture stays in use until it is released, or
+    /// until the end of the frame.
+    ///
+    /// The view is reset to the default one, the scissor test,
+    /// smoothing and repeating are disabled, but the contents are left from
+    /// the previous user: begin with RenderTarget::beginPass
+    /// (DiscardContents or ClearContents) or RenderTarget::clear.
+    ///
+    /// \param width    Width of the render texture
+    /// \param height   Height of the render texture
+    /// \param settings Settings of the render texture (only the depth, stencil, anti-aliasing and sRGB settings matter)
+    ///
+    /// \return Render texture owned by the pool, or NULL if it couldn't be created
+    ///
+    /// \see release, endFrame
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexture* acquire(unsigned int width, unsigned int height, const ContextSettings& settings = ContextSettings());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return a render texture to the pool before the end of the frame
+    ///
+    /// Once the last pass reading a temporary target is drawn,
+    /// the target can be released, so that the passes acquired
+    /// after it in the same frame reuse it: targets whose
+    /// lifetimes don't overlap then share the same video memory.
+    ///
+    /// \param texture Render texture returned by acquire
+    ///
+    /// \see acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(RenderTexture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recycle all the render textures acquired during the frame
+    ///
+    /// This function is typically called once per frame, next
+    /// to RenderTarget::resetFrameStats. The render textures
+    /// that have not been acquired for more frames than the
+    /// idle limit are destroyed (so an OpenGL context must be
+    /// active), which frees the targets of sizes that are not
+    /// used anymore, for example after the window is resized.
+    ///
+    /// \see setIdleLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    void endFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of frames an unused render texture is kept for
+    ///
+    /// The default limit is 4 frames.
+    ///
+    /// \param frames Number of frames without being acquired before a render texture is destroyed
+    ///
+    ////////////////////////////////////////////////////////////
+    void setIdleLimit(unsigned int frames);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames an unused render texture is kept for
+    ///
+    /// \return Idle limit, in frames
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getIdleLimit() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of render textures owned by the pool
+    ///
+    /// \return Number of render textures, in use or not
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of render textures currently in use
+    ///
+    /// \return Number of render textures acquired and not released yet
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getUsedCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy all the render textures of the pool
+    ///
+    /// The render textures in use must not be used anymore.
+    /// An OpenGL context must be active.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    struct Entry;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Entry*> m_entries;   ///< Render textures of the pool
+    Uint64              m_frame;     ///< Number of frames ended so far
+    unsigned int        m_idleLimit; ///< Number of frames an unused render texture is kept for
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERTEXTUREPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderTexturePool
+/// \ingroup graphics
+///
+/// Post-processing chains render to intermediate targets
+/// that only live for a few passes. Creating them every
+/// frame costs a texture, a frame buffer object, render
+/// buffers and a completeness check each time; keeping one
+/// render texture per pass wastes video memory on targets
+/// that are never needed at the same time.
+///
+/// sf::RenderTexturePool hands out render textures matched
+/// on their size and settings. A target released in the
+/// middle of a frame is handed to the next pass that asks
+/// for the same size, so the lifetimes of the passes decide
+/// how many targets exist, and all the targets are recycled
+/// when the frame ends. After the first frame, a chain with
+/// a stable structure creates no render texture at all.
+///
+/// The render textures belong to the pool: don't delete
+/// them, and don't keep them after the end of the frame.
+///
+/// Usage example:
+/// \code
+/// sf::RenderTexturePool pool;
+///
+/// // Every frame: bright pass, then a separable blur
+/// sf::RenderTexture* bright = pool.acquire(width / 2, height / 2);
+/// bright->beginPass(sf::RenderTarget::DiscardContents);
+/// bright->draw(sf::Sprite(scene.getTexture()), &brightPassShader);
+/// bright->display();
+///
+/// sf::RenderTexture* blurX = pool.acquire(width / 2, height / 2);
+/// blurX->beginPass(sf::RenderTarget::DiscardContents);
+/// blurX->draw(sf::Sprite(bright->getTexture()), &blurXShader);
+/// blurX->display();
+/// pool.release(*bright); // not needed anymore
+///
+/// sf::RenderTexture* blurY = pool.acquire(width / 2, height / 2); // reuses bright
+/// blurY->beginPass(sf::RenderTarget::DiscardContents);
+/// blurY->draw(sf::Sprite(blurX->getTexture()), &blurYShader);
+/// blurY->display();
+///
+/// window.draw(sf::Sprite(blurY->getTexture()), sf::BlendAdd);
+///
+/// pool.endFrame();
+/// window.display();
+/// \endcode
+///
+/// \see sf::RenderTexture, sf::TexturePool
+///
+////////////////////////////////////////////////////////////
@@ -31,6 +31,8 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
 #include <string>
 
 
@@ -46,6 +48,20 @@ class SFML_GRAPHICS_API RenderWindow : public RenderTarget
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function presenting the back-buffer of the window
+    ///
+    /// The window is created by the application, so the swap
+    /// (typically SDL_GL_SwapWindow) is provided by it.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void (*SwapCallback)(void* userData);
+
+    enum
+    {
+        MaxFramesInFlight = 4 ///< Maximum value accepted by setMaxFramesInFlight
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -65,6 +81,108 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual ~RenderWindow();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Display on screen what has been rendered to the window so far
+    ///
+    /// This function is typically called once every frame,
+    /// after everything has been drawn. In order:
+    /// \li the current pass is ended (see RenderTarget::endPass)
+    /// \li the CPU waits for the GPU to finish the frame issued
+    ///     the maximum number of frames in flight ago
+    /// \li the frame limiter waits until the frame has lasted
+    ///     long enough
+    /// \li the swap callback presents the back-buffer
+    /// \li the next frame starts (see RenderTarget::resetFrameStats)
+    ///
+    /// The counters of the frame (see RenderTarget::getFrameStats)
+    /// must therefore be read before calling display.
+    ///
+    /// Without a swap callback, the application must swap the
+    /// buffers itself right after calling display.
+    ///
+    /// \see setSwapCallback, setFramerateLimit, setMaxFramesInFlight
+    ///
+    ////////////////////////////////////////////////////////////
+    void display();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the function that presents the back-buffer
+    ///
+    /// \param callback Function called by display to swap the buffers, or NULL to swap outside of display
+    /// \param userData Pointer passed back to \a callback
+    ///
+    /// \see display
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSwapCallback(SwapCallback callback, void* userData = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Limit the framerate to a maximum fixed frequency
+    ///
+    /// display waits so that at least 1 / \a limit seconds
+    /// separate two swaps. The wait sleeps while the deadline
+    /// is far, then spins, so that the frames are evenly paced
+    /// even though the operating system wakes up threads late.
+    /// The limiter is independent of vertical synchronization;
+    /// combining both doesn't make sense.
+    ///
+    /// The limiter does nothing on the main thread of the
+    /// browser, where the browser paces the frames; it works on
+    /// web workers, which are allowed to block.
+    ///
+    /// \param limit Framerate limit, in frames per seconds (use 0 to disable limit)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFramerateLimit(unsigned int limit);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Limit the number of frames the CPU can run ahead of the GPU
+    ///
+    /// Drivers let the CPU queue several frames before blocking
+    /// in the swap. Each queued frame adds a frame of latency
+    /// between the input read by the application and its result
+    /// on screen. With a limit of \a frames, display waits for
+    /// the GPU to finish the frame issued \a frames frames
+    /// before, using fences (OpenGL 3.2, ARB_sync or OpenGL ES 3).
+    /// Without fences the commands are only flushed, so that
+    /// the GPU starts on them before the swap.
+    ///
+    /// 1 gives the lowest latency, at the cost of the overlap
+    /// between the CPU and GPU work. The limit is disabled by
+    /// default, and with Emscripten.
+    ///
+    /// \param frames Maximum number of frames in flight, between 1 and MaxFramesInFlight (0 to disable the limit)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxFramesInFlight(unsigned int frames);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the time between the two last swaps
+    ///
+    /// \return Duration of the last frame, as seen by display
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getPresentInterval() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the time spent in the last swap
+    ///
+    /// A long swap means that the driver blocked, waiting for
+    /// the vertical synchronization or for queued frames.
+    ///
+    /// \return Duration of the last call to the swap callback
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getSwapDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the time spent waiting in the last display
+    ///
+    /// \return Time spent in the frame limiter and waiting for frames in flight
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getWaitDuration() const;
     
     ////////////////////////////////////////////////////////////
     /// \brief Get the size of the rendering region of the window
@@ -95,19 +213,24 @@ public:
     ////////////////////////////////////////////////////////////
     bool setActive(bool active = true);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the current contents of the window into an image
+    ///
+    /// The pixels are read back from the window directly, without
+    /// going through a temporary texture. This is still a slow
+    /// operation, that waits for the GPU to finish rendering;
+    /// its main purpose is to make screenshots of the application.
+    ///
+    /// \return Image containing the captured contents
+    ///
+    ////////////////////////////////////////////////////////////
+    Image capture();
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the current contents of the window to an image
     ///
     /// \deprecated
-    /// Use a sf::Texture and its sf::Texture::update(const Window&)
-    /// function and copy its contents into an sf::Image instead.
-    /// \code
-    /// sf::Vector2u windowSize = window.getSize();
-    /// sf::Texture texture;
-    /// texture.create(windowSize.x, windowSize.y);
-    /// texture.update(window);
-    /// sf::Image screenshot = texture.copyToImage();
-    /// \endcode
+    /// Use capture instead.
     ///
     /// This is a slow operation, whose main purpose is to make
     /// screenshots of the application. If you want to update an
@@ -184,7 +307,33 @@ public:
     void onResize(int w, int h);
 
 private:
-    Vector2i m_screenSize;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the frame limit allows the next swap
+    ///
+    ////////////////////////////////////////////////////////////
+    void waitFrameLimit();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the fences of the frames in flight
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearFences();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2i     m_screenSize;                 ///< Size of the window
+    SwapCallback m_swapCallback;               ///< Function presenting the back-buffer
+    void*        m_swapUserData;               ///< Pointer passed to the swap callback
+    Time         m_frameTimeLimit;             ///< Minimum time between two swaps
+    unsigned int m_maxFramesInFlight;          ///< Maximum number of frames queued (0 for no limit)
+    void*        m_fences[MaxFramesInFlight];  ///< Fences inserted after the last swaps (GLsync)
+    unsigned int m_fenceIndex;                 ///< Slot of the fence of the next swap
+    Clock        m_presentClock;               ///< Time since the last swap
+    Time         m_presentInterval;            ///< Time between the last two swaps
+    Time         m_swapDuration;               ///< Time spent in the last swap
+    Time         m_waitDuration;               ///< Time spent waiting in the last display
 };
 
 } // namespace sf
@@ -243,6 +392,62 @@ private:
 /// }
 /// \endcode
 ///
+/// The window itself belongs to the application, so display
+/// presents it through a swap callback:
+///
+/// \code
+/// void swap(void* userData)
+/// {
+///     SDL_GL_SwapWindow(static_cast<SDL_Window*>(userData));
+/// }
+///
+/// window.setSwapCallback(&swap, sdlWindow);
+/// window.setMaxFramesInFlight(1); // lowest input latency
+/// \endcode
+///
+/// In the browser, the whole rendering can run on a web worker,
+/// so that input handling, DOM updates and garbage collection
+/// on the main thread don't delay the frames. SDL stays on the
+/// main thread for the events; the worker creates its WebGL
+/// context on the canvas with the html5 API, which SFML uses
+/// to load the functions and identify the contexts. Link with
+/// -pthread and -sOFFSCREENCANVAS_SUPPORT (the canvas is moved
+/// to the worker, see -sOFFSCREENCANVASES_TO_PTHREAD), and add
+/// -sOFFSCREEN_FRAMEBUFFER for the browsers without
+/// OffscreenCanvas. The worker loops at its own pace and commits
+/// each frame from the swap callback:
+///
+/// \code
+/// void commit(void*)
+/// {
+///     emscripten_webgl_commit_frame();
+/// }
+///
+/// void* render(void*) // runs on the worker
+/// {
+///     EmscriptenWebGLContextAttributes attributes;
+///     emscripten_webgl_init_context_attributes(&attributes);
+///     attributes.explicitSwapControl = EM_TRUE;
+///     attributes.renderViaOffscreenBackBuffer = EM_TRUE; // OFFSCREEN_FRAMEBUFFER fallback
+///
+///     EMSCRIPTEN_WEBGL_CONTEXT_HANDLE context = emscripten_webgl_create_context("#canvas", &attributes);
+///     emscripten_webgl_make_context_current(context);
+///
+///     sf::RenderWindow window(800, 600);
+///     window.onCreate();
+///     window.setSwapCallback(&commit);
+///     window.setFramerateLimit(60);
+///
+///     while (running)
+///     {
+///         window.clear();
+///         ...
+///         window.display();
+///     }
+///     return NULL;
+/// }
+/// \endcode
+///
 /// Like sf::Window, sf::RenderWindow is still able to render direct
 /// OpenGL stuff. It is even possible to mix together OpenGL calls
 /// and regular SFML drawing commands.
@@ -0,0 +1,341 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RESOURCELOADER_HPP
+#define SFML_RESOURCELOADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace sf
+{
+class Font;
+class Shader;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Load textures, fonts and shaders in the background
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ResourceLoader : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Progress of a load
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Status
+    {
+        Pending, ///< The resource is still being loaded, it must not be used yet
+        Ready,   ///< The resource is loaded and can be used
+        Failed   ///< The resource couldn't be loaded
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function activating the upload context
+    ///
+    /// \param active   True to make the context current on the
+    ///                 calling thread, false to release it
+    /// \param userData User data given to setUploadContext
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void (*ContextCallback)(bool active, void* userData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the loader and start its worker threads
+    ///
+    /// \param threadCount Number of decoding threads, 0 to use
+    ///                    one less than the number of cores
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ResourceLoader(unsigned int threadCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The loads that are not finished are abandoned: their
+    /// resources are left in an unspecified state. The OpenGL
+    /// context of the render thread must be active.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ResourceLoader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the textures on a dedicated thread
+    ///
+    /// The window is owned by the application, so the loader
+    /// can't create the shared OpenGL context by itself: the
+    /// callback is called on the upload thread when it starts
+    /// (to make a context that shares its objects with the
+    /// render context current, for example with
+    /// SDL_GL_MakeCurrent) and when it exits.
+    ///
+    /// The render thread learns that an upload is complete
+    /// through a fence, so it never waits for the upload
+    /// thread. Without an upload context, the textures are
+    /// uploaded by update, within its time budget.
+    ///
+    /// This function can only be called once, before any load
+    /// is started. Dedicated upload threads are not available
+    /// with WebGL.
+    ///
+    /// \param callback Function activating the upload context
+    /// \param userData User data passed to the callback
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUploadContext(ContextCallback callback, void* userData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a texture from an image file in memory
+    ///
+    /// The image is decoded by a worker thread, and the pixels
+    /// are premultiplied if the texture is configured so.
+    ///
+    /// \param texture     Texture to load, it must stay alive and
+    ///                    unused until the load is finished
+    /// \param data        Pointer to the file data, it must stay
+    ///                    valid until the load is finished
+    /// \param sizeInBytes Size of the data, in bytes
+    ///
+    /// \return Token identifying the load
+    ///
+    /// \see getStatus
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 loadTexture(Texture& texture, const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a font from a file in memory
+    ///
+    /// The font is opened by a worker thread, see
+    /// Font::loadFromMemory. It doesn't need any OpenGL work.
+    ///
+    /// \param font        Font to load, it must stay alive and
+    ///                    unused until the load is finished
+    /// \param data        Pointer to the file data, it must stay
+    ///                    valid as long as the font is used
+    /// \param sizeInBytes Size of the data, in bytes
+    ///
+    /// \return Token identifying the load
+    ///
+    /// \see getStatus
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 loadFont(Font& font, const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a vertex and fragment shader from source code
+    ///
+    /// The sources are copied. The shader is compiled by update
+    /// on the render thread with Shader::loadFromMemoryAsync,
+    /// so that the driver can compile it in the background
+    /// when it supports KHR_parallel_shader_compile.
+    ///
+    /// \param shader         Shader to load, it must stay alive
+    ///                       and unused until the load is finished
+    /// \param vertexShader   Source code of the vertex shader
+    /// \param fragmentShader Source code of the fragment shader
+    ///
+    /// \return Token identifying the load
+    ///
+    /// \see getStatus
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 loadShader(Shader& shader, const std::string& vertexShader, const std::string& fragmentShader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Advance the loads that need the render thread
+    ///
+    /// This function must be called regularly (typically once
+    /// per frame) on the render thread, with its OpenGL context
+    /// active. It completes the uploads whose fence is
+    /// signaled, starts and polls the shader compilations, and
+    /// uploads the decoded textures when there's no upload
+    /// thread.
+    ///
+    /// \param budget Time that can be spent uploading textures,
+    ///               at least one texture is uploaded per call
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time budget = milliseconds(2));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the progress of a load
+    ///
+    /// \param token Token returned by one of the load functions
+    ///
+    /// \return Status of the load, Failed if the token is unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    Status getStatus(Uint64 token) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of loads that are not finished
+    ///
+    /// \return Number of pending loads
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Kind of resource loaded by a job
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Type
+    {
+        TextureJob,
+        FontJob,
+        ShaderJob
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load in progress
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Job
+    {
+        Uint64      token;          ///< Token of the load
+        Type        type;           ///< Kind of resource
+        void*       resource;       ///< The resource (Texture, Font or Shader)
+        const void* data;           ///< File data of textures and fonts
+        std::size_t dataSize;       ///< Size of the file data, in bytes
+        std::string vertexShader;   ///< Source of the vertex shader
+        std::string fragmentShader; ///< Source of the fragment shader
+        Uint8*      pixels;         ///< Decoded pixels of textures
+        Vector2u    size;           ///< Size of the decoded pixels
+        void*       fence;          ///< Fence signaled when the upload is done (GLsync)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a job and queue it for the workers
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 push(Job* job);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the end of a job and destroy it
+    ///
+    /// The mutex must be locked.
+    ///
+    ////////////////////////////////////////////////////////////
+    void finish(Job* job, bool success);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a texture and upload its decoded pixels
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool upload(Job& job);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void runWorker();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the upload thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void runUploader();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<std::thread>    m_workers;         ///< Decoding threads
+    std::thread                 m_uploader;        ///< Upload thread, if any
+    ContextCallback             m_contextCallback; ///< Function activating the upload context
+    void*                       m_contextUserData; ///< User data of the context callback
+    mutable Mutex               m_mutex;           ///< Protects the queues, the statuses and the flag
+    std::condition_variable_any m_condition;       ///< Signals new jobs and the stop
+    std::deque<Job*>            m_decodeQueue;     ///< Jobs waiting for a worker
+    std::deque<Job*>            m_uploadQueue;     ///< Decoded textures waiting for their upload
+    std::deque<Job*>            m_fenceQueue;      ///< Uploaded textures waiting for their fence
+    std::deque<Job*>            m_compileQueue;    ///< Shaders waiting for their compilation
+    std::vector<Job*>           m_compiling;       ///< Shaders being compiled
+    std::map<Uint64, Status>    m_statuses;        ///< Status of every load
+    std::size_t                 m_pendingCount;    ///< Number of loads not finished
+    Uint64                      m_nextToken;       ///< Token of the next load
+    bool                        m_stop;            ///< Must the threads exit?
+};
+
+} // namespace sf
+
+
+#endif // SFML_RESOURCELOADER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ResourceLoader
+/// \ingroup graphics
+///
+/// sf::ResourceLoader streams resources while the main loop
+/// keeps rendering, for loading screens or open worlds.
+/// Decoding (images with stb_image, fonts with FreeType) runs
+/// on worker threads; the OpenGL work runs either on a
+/// dedicated upload thread with a shared context, or on the
+/// render thread in small time slices.
+///
+/// Each load returns a token; the resource must not be used
+/// until getStatus returns Ready for it.
+///
+/// Usage example:
+/// \code
+/// sf::ResourceLoader loader;
+/// loader.setUploadContext(&makeUploadContextCurrent, &uploadContext);
+///
+/// sf::Texture background;
+/// sf::Uint64 backgroundToken = loader.loadTexture(background, file.data(), file.size());
+///
+/// while (loader.getPendingCount() > 0)
+/// {
+///     loader.update();
+///     drawLoadingScreen(window);
+///     window.display();
+/// }
+///
+/// if (loader.getStatus(backgroundToken) == sf::ResourceLoader::Ready)
+///     window.draw(sf::Sprite(background));
+/// \endcode
+///
+/// \see sf::Texture, sf::Font, sf::Shader, sf::priv::ImageLoader
+///
+////////////////////////////////////////////////////////////
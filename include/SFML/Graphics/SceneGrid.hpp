@@ -0,0 +1,280 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SCENEGRID_HPP
+#define SFML_SCENEGRID_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Container of drawables indexed by a uniform grid,
+///        which only draws the ones that are visible
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SceneGrid : public Drawable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of an item of the grid
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::size_t ItemId;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an empty grid
+    ///
+    /// \param cellSize Size of the square cells, in world units
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SceneGrid(float cellSize = 256.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a drawable to the grid
+    ///
+    /// The bounds of the drawable are read from
+    /// Drawable::getCullingBounds; drawables that don't provide
+    /// them are always drawn. The drawable is not copied, it
+    /// must remain alive as long as it is in the grid.
+    ///
+    /// \param drawable Drawable to add
+    /// \param layer    Layer of the drawable, lower layers are drawn first
+    ///
+    /// \return Identifier of the new item
+    ///
+    ////////////////////////////////////////////////////////////
+    ItemId insert(const Drawable& drawable, int layer = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a drawable to the grid with explicit bounds
+    ///
+    /// \param drawable Drawable to add
+    /// \param bounds   Bounds of the drawable, in the coordinate system of the grid
+    /// \param layer    Layer of the drawable, lower layers are drawn first
+    ///
+    /// \return Identifier of the new item
+    ///
+    ////////////////////////////////////////////////////////////
+    ItemId insert(const Drawable& drawable, const FloatRect& bounds, int layer = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the bounds of an item again after it moved
+    ///
+    /// Only the cells that the item entered or left are updated.
+    ///
+    /// \param item Identifier of the item
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(ItemId item);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the bounds of an item
+    ///
+    /// \param item   Identifier of the item
+    /// \param bounds New bounds of the item
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(ItemId item, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an item from the grid
+    ///
+    /// Its identifier may be reused by the next insertions.
+    ///
+    /// \param item Identifier of the item
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(ItemId item);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the items
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of items in the grid
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getItemCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the items that intersect an area
+    ///
+    /// The items are sorted by layer, then by insertion order.
+    /// The time taken is proportional to the number of cells
+    /// covered by \a area and to the number of items found.
+    ///
+    /// \param area   Area to search, in the coordinate system of the grid
+    /// \param result Receives the drawables of the items found
+    ///
+    ////////////////////////////////////////////////////////////
+    void query(const FloatRect& area, std::vector<const Drawable*>& result) const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the items that are visible in the view of the target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Range of cells covered by an item
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CellRange
+    {
+        int left;   ///< First column
+        int top;    ///< First row
+        int right;  ///< Last column (included)
+        int bottom; ///< Last row (included)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Item of the grid
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Item
+    {
+        const Drawable* drawable; ///< Drawable of the item (NULL if the slot is free)
+        FloatRect       bounds;   ///< Bounds of the item
+        bool            bounded;  ///< Are the bounds known?
+        int             layer;    ///< Drawing layer
+        Uint64          sequence; ///< Insertion order
+        CellRange       cells;    ///< Cells containing the item, if it's stored in the grid
+        bool            inGrid;   ///< Is the item stored in the cells (otherwise in m_unsorted)?
+        mutable Uint32  mark;     ///< Last query that found the item, to report it only once
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate an item and store it
+    ///
+    ////////////////////////////////////////////////////////////
+    ItemId add(const Drawable& drawable, const FloatRect& bounds, bool bounded, int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store an item in the cells covering its bounds
+    ///
+    ////////////////////////////////////////////////////////////
+    void link(ItemId item);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an item from the cells it's stored in
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlink(ItemId item);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the range of cells covering a rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    CellRange getCellRange(const FloatRect& rectangle) const;
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<Uint64, std::vector<ItemId> > CellTable;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    float                                 m_cellSize;     ///< Size of the cells
+    std::vector<Item>                     m_items;        ///< Items, indexed by their identifier
+    std::vector<ItemId>                   m_freeItems;    ///< Identifiers of the free slots of m_items
+    CellTable                             m_cells;        ///< Non-empty cells, mapped to their row and column
+    std::vector<ItemId>                   m_unsorted;     ///< Items that are not stored in the cells (unbounded or too large)
+    Uint64                                m_nextSequence; ///< Insertion order of the next item
+    mutable Uint32                        m_queryMark;    ///< Identifier of the last query
+    mutable std::vector<ItemId>           m_found;        ///< Items found by the last query
+    mutable std::vector<const Drawable*>  m_visible;      ///< Drawables found by the last draw
+};
+
+} // namespace sf
+
+
+#endif // SFML_SCENEGRID_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SceneGrid
+/// \ingroup graphics
+///
+/// Culling with RenderTarget::setCullingEnabled still has to
+/// look at every object of the scene, every frame. Worlds with
+/// many more objects than what's visible can store them in a
+/// sf::SceneGrid instead: the items are indexed, by their
+/// bounds, in square cells of a sparse uniform grid, and
+/// drawing the grid only visits the cells covered by the view
+/// of the target.
+///
+/// The visible items are drawn by layer, then in insertion
+/// order, with the render states given to the grid; consecutive
+/// items with the same texture are therefore merged by the
+/// batcher when batching is enabled.
+///
+/// The grid doesn't know when its drawables move: call update
+/// after changing the position, rotation, scale or size of an
+/// item. Items larger than a few cells, and drawables that
+/// don't provide bounds, are kept aside and tested at each
+/// query. The cell size should be close to the size of the
+/// typical items.
+///
+/// Usage example:
+/// \code
+/// sf::SceneGrid grid(128.f);
+///
+/// std::vector<sf::SceneGrid::ItemId> ids;
+/// for (std::size_t i = 0; i < enemies.size(); ++i)
+///     ids.push_back(grid.insert(enemies[i].sprite, 1));
+///
+/// // each frame
+/// for (std::size_t i = 0; i < enemies.size(); ++i)
+/// {
+///     if (enemies[i].move())
+///         grid.update(ids[i]);
+/// }
+///
+/// window.draw(grid);
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::Drawable
+///
+////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Glsl.hpp>
+#include <SFML/Graphics/MemoryStats.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Vector3.hpp>
@@ -42,6 +43,7 @@ namespace sf
 {
 class Color;
 class InputStream;
+class ShaderCache;
 class Texture;
 class Transform;
 
@@ -81,6 +83,20 @@ public:
     ////////////////////////////////////////////////////////////
     static CurrentTextureType CurrentTexture;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Resolved location of a uniform, for fast updates
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    struct UniformHandle
+    {
+        UniformHandle() : location(-1) {}
+        explicit UniformHandle(int uniformLocation) : location(uniformLocation) {}
+
+        int location; ///< Location of the uniform in the program, -1 if not found
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -91,12 +107,41 @@ public:
     ////////////////////////////////////////////////////////////
     Shader();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The program, the uniform caches and the pending values
+    /// are taken over from \a right, which is left invalid.
+    ///
+    /// \param right Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    Shader(Shader&& right) noexcept;
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
     ////////////////////////////////////////////////////////////
     ~Shader();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of move assignment operator
+    ///
+    /// \param right Instance to move
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Shader& operator =(Shader&& right) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this shader with those of another
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Shader& right);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the vertex, geometry or fragment shader from a file
     ///
@@ -224,6 +269,77 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromMemory(const char* vertexShader, const char* geometryShader, const char* fragmentShader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the vertex and fragment shaders from source codes in memory
+    ///
+    /// This function works like loadFromMemory, but it doesn't
+    /// wait for the compilation and the link to finish. Submit
+    /// all the shaders of a level first, then poll isReady:
+    /// drivers that support KHR_parallel_shader_compile compile
+    /// them in the background, in parallel. Without it, the
+    /// driver still works while the application goes on, and
+    /// isReady waits for the result the first time it is called.
+    ///
+    /// Using the shader before isReady returned true (setting
+    /// a uniform, drawing with it) waits for the compilation.
+    /// Compilation errors are written to sf::err() when the
+    /// result is known.
+    ///
+    /// \param vertexShader   String containing the source code of the vertex shader
+    /// \param fragmentShader String containing the source code of the fragment shader
+    ///
+    /// \return False if the compilation could not be started
+    ///
+    /// \see isReady, loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemoryAsync(const char* vertexShader, const char* fragmentShader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the vertex, geometry and fragment shaders from source codes in memory
+    ///
+    /// See loadFromMemoryAsync(const char*, const char*).
+    ///
+    /// \param vertexShader   String containing the source code of the vertex shader
+    /// \param geometryShader String containing the source code of the geometry shader
+    /// \param fragmentShader String containing the source code of the fragment shader
+    ///
+    /// \return False if the compilation could not be started
+    ///
+    /// \see isReady, loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemoryAsync(const char* vertexShader, const char* geometryShader, const char* fragmentShader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the compilation started by loadFromMemoryAsync is finished
+    ///
+    /// This function never waits for the driver when it supports
+    /// KHR_parallel_shader_compile. Once it returns true, the
+    /// shader is either usable or empty if the compilation failed
+    /// (getNativeHandle returns 0).
+    ///
+    /// \return True if the shader is not being compiled anymore
+    ///
+    /// \see waitUntilReady, loadFromMemoryAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for the compilation started by loadFromMemoryAsync
+    ///
+    /// Unlike isReady, this function blocks until the driver
+    /// has linked the program, even with KHR_parallel_shader_compile.
+    /// It returns immediately if nothing is being compiled.
+    ///
+    /// \return True if the shader is usable, false if the compilation failed or nothing was loaded
+    ///
+    /// \see isReady, loadFromMemoryAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool waitUntilReady() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the vertex, geometry or fragment shader from a custom stream
     ///
@@ -287,6 +403,27 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromStream(InputStream& vertexShaderStream, InputStream& geometryShaderStream, InputStream& fragmentShaderStream);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the handle of a uniform
+    ///
+    /// Setting a uniform from its handle skips the lookup of
+    /// its name, which is worth it for uniforms that are
+    /// updated for every draw. Handles stay valid until the
+    /// shader is loaded again.
+    ///
+    /// \code
+    /// sf::Shader::UniformHandle tint = shader.getUniformHandle("tint");
+    /// ...
+    /// shader.setUniform(tint, sf::Glsl::Vec4(color));
+    /// \endcode
+    ///
+    /// \param name Name of the uniform variable in GLSL
+    ///
+    /// \return Handle of the uniform; setting an invalid handle does nothing
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformHandle getUniformHandle(const char* name);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p float uniform
     ///
@@ -296,6 +433,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, float x);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p float uniform from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param x      Value of the float scalar
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, float x);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p vec2 uniform
     ///
@@ -305,6 +453,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, const Glsl::Vec2& vector);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec2 uniform from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param vector Value of the vec2 vector
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec2& vector);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p vec3 uniform
     ///
@@ -314,6 +473,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, const Glsl::Vec3& vector);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec3 uniform from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param vector Value of the vec3 vector
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec3& vector);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p vec4 uniform
     ///
@@ -332,6 +502,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, const Glsl::Vec4& vector);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec4 uniform from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param vector Value of the vec4 vector
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec4& vector);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p int uniform
     ///
@@ -341,6 +522,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, int x);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p int uniform from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param x      Value of the int scalar
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, int x);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p ivec2 uniform
     ///
@@ -350,6 +542,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, const Glsl::Ivec2& vector);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec2 uniform from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param vector Value of the ivec2 vector
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec2& vector);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p ivec3 uniform
     ///
@@ -359,6 +562,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, const Glsl::Ivec3& vector);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec3 uniform from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param vector Value of the ivec3 vector
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec3& vector);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p ivec4 uniform
     ///
@@ -376,6 +590,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, const Glsl::Ivec4& vector);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec4 uniform from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param vector Value of the ivec4 vector
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec4& vector);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p bool uniform
     ///
@@ -385,6 +610,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, bool x);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bool uniform from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param x      Value of the bool scalar
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, bool x);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p bvec2 uniform
     ///
@@ -394,6 +630,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, const Glsl::Bvec2& vector);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec2 uniform from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param vector Value of the bvec2 vector
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec2& vector);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p bvec3 uniform
     ///
@@ -403,6 +650,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, const Glsl::Bvec3& vector);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec3 uniform from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param vector Value of the bvec3 vector
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec3& vector);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p bvec4 uniform
     ///
@@ -412,6 +670,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, const Glsl::Bvec4& vector);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec4 uniform from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param vector Value of the bvec4 vector
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec4& vector);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p mat3 matrix
     ///
@@ -421,6 +690,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, const Glsl::Mat3& matrix);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat3 matrix from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param matrix Value of the mat3 matrix
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Mat3& matrix);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify value for \p mat4 matrix
     ///
@@ -430,6 +710,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, const Glsl::Mat4& matrix);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat4 matrix from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    /// \param matrix Value of the mat4 matrix
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Mat4& matrix);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify a texture as \p sampler2D uniform
     ///
@@ -462,6 +753,17 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, const Texture& texture);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify a texture as \p sampler2D uniform from its handle
+    ///
+    /// \param handle  Handle of the uniform, from getUniformHandle
+    /// \param texture Texture to assign
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Texture& texture);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify current texture as \p sampler2D uniform
     ///
@@ -485,6 +787,31 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const char* name, CurrentTextureType);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify current texture as \p sampler2D uniform from its handle
+    ///
+    /// \param handle Handle of the uniform, from getUniformHandle
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, CurrentTextureType);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Assign a uniform block to a binding point
+    ///
+    /// The block reads the sf::UniformBuffer bound to the same
+    /// point. The built-in sf_Frame block is assigned to
+    /// UniformBuffer::FrameBinding automatically.
+    ///
+    /// \param name         Name of the uniform block in GLSL
+    /// \param bindingPoint Index of the binding point
+    ///
+    /// \see sf::UniformBuffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformBlock(const char* name, unsigned int bindingPoint);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify values for \p float[] array uniform
     ///
@@ -664,6 +991,11 @@ public:
     /// // draw OpenGL stuff that use no shader...
     /// \endcode
     ///
+    /// The values given to setUniform and setUniformArray are
+    /// stored and only sent to OpenGL by this function, so a
+    /// program bound with glUseProgram and getNativeHandle
+    /// doesn't see the changes made since the last bind.
+    ///
     /// \param shader Shader to bind, can be null to use no shader
     ///
     ////////////////////////////////////////////////////////////
@@ -688,8 +1020,42 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isGeometryAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the cache of compiled shader programs
+    ///
+    /// When a cache is set and the driver supports program
+    /// binaries, shaders that were already linked once are
+    /// loaded from their binary instead of being compiled
+    /// again. This also applies to the shaders used internally
+    /// by render targets, which are created with the first
+    /// render target: set the cache before that to make them
+    /// benefit from it.
+    ///
+    /// The cache is not owned by SFML, it must remain alive
+    /// as long as shaders are loaded.
+    ///
+    /// \param cache Cache to use, or NULL to disable caching
+    ///
+    /// \see getCache
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCache(ShaderCache* cache);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the cache of compiled shader programs
+    ///
+    /// \return Current cache, or NULL if none is set
+    ///
+    /// \see setCache
+    ///
+    ////////////////////////////////////////////////////////////
+    static ShaderCache* getCache();
+
 private:
 
+    friend class ContextRestore;
+    friend class DrawCapture;
+
     ////////////////////////////////////////////////////////////
     /// \brief Compile the shader(s) and create the program
     ///
@@ -705,11 +1071,97 @@ private:
     ////////////////////////////////////////////////////////////
     bool compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit the shader(s) to the driver and start linking the program
+    ///
+    /// The result is checked by finishCompile, unless the program
+    /// was restored from the cache.
+    ///
+    /// \return False if the program could not be submitted
+    ///
+    ////////////////////////////////////////////////////////////
+    bool submit(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for the link started by submit and check its result
+    ///
+    /// Does nothing if no link is pending.
+    ///
+    /// \return True if the shader holds a valid program
+    ///
+    ////////////////////////////////////////////////////////////
+    bool finishCompile() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delete the shaders of a pending link
+    ///
+    ////////////////////////////////////////////////////////////
+    void discardPending() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forward declaration of the programs shared between shaders
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SharedProgram;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Use the linked program of another shader with the same key
+    ///
+    /// \return True if such a program exists
+    ///
+    ////////////////////////////////////////////////////////////
+    bool acquireSharedProgram();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the linked program available to the other shaders
+    ///
+    ////////////////////////////////////////////////////////////
+    void shareProgram() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the program, delete it if it's not used anymore
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseProgram() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the binary of the linked program, for a context restore
+    ///
+    /// \param binary Receives the program binary
+    ///
+    /// \return True if the driver could provide the binary
+    ///
+    ////////////////////////////////////////////////////////////
+    bool retainProgram(std::vector<Uint8>& binary) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the program of the lost context, without deleting it
+    ///
+    /// \return Identifier of the lost program (0 if none)
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int forgetProgram() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Use a program recreated from its binary after a context restore
+    ///
+    /// The uniform values are uploaded again on the next use.
+    ///
+    /// \param binary  Binary kept by retainProgram
+    /// \param program Program already recreated from the same
+    ///                binary (0 to create it, then receives it)
+    ///
+    /// \return True if the program could be recreated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool restoreProgram(const std::vector<Uint8>& binary, unsigned int& program) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Bind all the textures used by the shader
     ///
-    /// This function each texture to a different unit, and
-    /// updates the corresponding variables in the shader accordingly.
+    /// Each sampler is assigned its own unit once, when its
+    /// texture is first set; this function only rebinds the
+    /// units whose texture changed since the last bind.
     ///
     ////////////////////////////////////////////////////////////
     void bindTextures() const;
@@ -725,28 +1177,139 @@ private:
     int getUniformLocation(const char* name);
 
     ////////////////////////////////////////////////////////////
-    /// \brief RAII object to save and restore the program
-    ///        binding while uniforms are being set
+    /// \brief Forward declaration of the uniform location cache entries
+    ///
+    ////////////////////////////////////////////////////////////
+    struct UniformEntry;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert an entry in the uniform location cache
     ///
-    /// Implementation is private in the .cpp file.
+    /// The table must have a free slot. The name of \a entry is
+    /// moved into the table.
     ///
     ////////////////////////////////////////////////////////////
-    struct UniformBinder;
+    void insertUniform(UniformEntry& entry);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Hash the name of a uniform for the location cache
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 hashUniformName(const char* name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Account the current size of the uniform and texture tables
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateMemoryUsage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Types of the values in the uniform shadow storage
+    ///
+    ////////////////////////////////////////////////////////////
+    enum UniformType
+    {
+        UniformFloat,
+        UniformVec2,
+        UniformVec3,
+        UniformVec4,
+        UniformInt,
+        UniformIvec2,
+        UniformIvec3,
+        UniformIvec4,
+        UniformMat3,
+        UniformMat4
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the value of a uniform until the shader is bound
+    ///
+    /// Does nothing if the value is the same as the stored one.
+    ///
+    /// \param handle     Handle of the uniform
+    /// \param type       Type of the uniform
+    /// \param values     Values (32-bit floats or ints)
+    /// \param components Number of components of each element
+    /// \param count      Number of elements (more than 1 for arrays)
+    ///
+    ////////////////////////////////////////////////////////////
+    void storeUniform(UniformHandle handle, UniformType type, const void* values, std::size_t components, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the uniforms that changed since the last bind
+    ///
+    /// The program must be bound.
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadUniforms() const;
+
+    enum
+    {
+        PendingShaderCount = 3,  ///< Vertex, geometry and fragment
+        UnusedSlot         = -2  ///< Location of the free slots in the uniform location cache
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry of the uniform location cache
+    ///
+    ////////////////////////////////////////////////////////////
+    struct UniformEntry
+    {
+        UniformEntry() : hash(0), location(UnusedSlot) {}
+
+        Uint64      hash;     ///< Hash of the name
+        std::string name;     ///< Name of the uniform
+        int         location; ///< Location of the uniform, or UnusedSlot
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Value of a uniform in the shadow storage
+    ///
+    ////////////////////////////////////////////////////////////
+    struct UniformValue
+    {
+        UniformValue() : type(UniformFloat), count(0), dirty(false) {}
+
+        UniformType         type;  ///< Type of the uniform
+        std::size_t         count; ///< Number of elements
+        std::vector<Uint32> data;  ///< Bit patterns of the components
+        bool                dirty; ///< Has the value changed since the last upload?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Texture assigned to a sampler uniform
+    ///
+    ////////////////////////////////////////////////////////////
+    struct TextureSlot
+    {
+        const Texture* texture; ///< Texture to bind
+        int            unit;    ///< Texture unit the sampler was assigned to
+    };
 
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<int, const Texture*> TextureTable;
-    typedef std::map<std::string, int> UniformTable;
+    typedef std::map<int, TextureSlot> TextureTable;
+    typedef std::vector<UniformEntry> UniformTable;
+    typedef std::map<int, UniformValue> UniformValueTable;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int                m_shaderProgram;  ///< OpenGL identifier for the program
+    mutable unsigned int        m_shaderProgram;  ///< OpenGL identifier for the program
+    mutable SharedProgram*      m_sharedProgram;  ///< Entry of the program in the shared programs, if any
     int                         m_currentTexture; ///< Location of the current texture in the shader
     TextureTable                m_textures;       ///< Texture variables in the shader, mapped to their location
-    UniformTable                m_uniforms;       ///< Parameters location cache
+    UniformTable                m_uniforms;       ///< Parameters location cache (open addressing, power of two size)
+    std::size_t                 m_uniformCount;   ///< Number of used slots in m_uniforms
+    mutable UniformValueTable   m_uniformValues;  ///< Uniform values waiting to be uploaded, mapped to their location
+    mutable std::size_t         m_dirtyUniforms;  ///< Number of values in m_uniformValues to upload
     std::vector<std::string>    m_attributes;     ///< Shader attribute location in order to bind before link
+    mutable unsigned int        m_pendingShaders[PendingShaderCount]; ///< Shaders of the pending link, kept for their logs
+    mutable bool                m_linkPending;    ///< Is the result of the link still unchecked?
+    bool                        m_storeBinary;    ///< Store the program in the cache once linked?
+    Uint64                      m_programKey;     ///< Hash of the sources, identifies the program for sharing and caching
+    priv::MemoryCounter         m_memory;         ///< Accounted size of the uniform and texture tables
 };
 
 } // namespace sf
@@ -859,6 +1422,15 @@ private:
 /// second one doesn't impact the rendering process and can be
 /// easily inserted anywhere without impacting all the code.
 ///
+/// Shaders loaded from the same sources (with the same attributes)
+/// share a single OpenGL program, which is compiled only once and
+/// destroyed with the last shader that uses it. Each sf::Shader
+/// keeps its own uniform values and textures, and restores them
+/// when it's bound after another one; however, uniforms that a
+/// shader never set keep whatever value the other shaders gave
+/// them, and setUniformBlock applies to all the shaders that share
+/// the program.
+///
 /// Like sf::Texture that can be used as a raw OpenGL texture,
 /// sf::Shader can also be used directly as a raw shader for
 /// custom OpenGL geometry.
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SHADERCACHE_HPP
+#define SFML_SHADERCACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Config.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract class for storage of compiled shader programs
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ShaderCache
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~ShaderCache() {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve a program binary stored earlier
+    ///
+    /// \param key  Key of the program
+    /// \param data Receives the data given to store for this key
+    ///
+    /// \return True if the key was found, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool load(Uint64 key, std::vector<Uint8>& data) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store a program binary
+    ///
+    /// If the key already exists, its data must be replaced.
+    ///
+    /// \param key  Key of the program
+    /// \param data Data to store, opaque to the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void store(Uint64 key, const std::vector<Uint8>& data) = 0;
+};
+
+} // namespace sf
+
+
+#endif // SFML_SHADERCACHE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ShaderCache
+/// \ingroup graphics
+///
+/// Compiling and linking shaders can take tens of milliseconds
+/// per program on mobile drivers. When a cache is given to
+/// sf::Shader::setCache, linked programs are saved as driver
+/// binaries (glGetProgramBinary) and loaded back instead of
+/// being compiled from their sources the next time.
+///
+/// The keys are hashes of the sources, of the attribute
+/// bindings and of the renderer and version strings of the
+/// driver, so entries made by another driver are never found;
+/// old entries can simply be discarded once in a while. The
+/// data is checked again when loaded, and programs are
+/// compiled from source if the driver rejects a binary.
+///
+/// The cache is only used when the driver supports program
+/// binaries (OpenGL 4.1, OpenGL ES 3 or OES_get_program_binary,
+/// never with WebGL).
+///
+/// Usage example:
+/// \code
+/// class DirectoryCache : public sf::ShaderCache
+/// {
+/// public:
+///
+///     virtual bool load(sf::Uint64 key, std::vector<sf::Uint8>& data)
+///     {
+///         std::ifstream file(getPath(key).c_str(), std::ios_base::binary);
+///         data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+///         return !data.empty();
+///     }
+///
+///     virtual void store(sf::Uint64 key, const std::vector<sf::Uint8>& data)
+///     {
+///         std::ofstream file(getPath(key).c_str(), std::ios_base::binary);
+///         file.write(reinterpret_cast<const char*>(&data[0]), data.size());
+///     }
+///
+///     ...
+/// };
+///
+/// DirectoryCache cache;
+/// sf::Shader::setCache(&cache); // before creating the window, for the built-in shaders
+/// \endcode
+///
+/// \see sf::Shader
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,238 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SHADERLIBRARY_HPP
+#define SFML_SHADERLIBRARY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Shader;
+
+////////////////////////////////////////////////////////////
+/// \brief Named shader sources compiled on demand into cached variants
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ShaderLibrary : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set of preprocessor definitions, mapped to their value
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::map<std::string, std::string> Defines;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ShaderLibrary();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the variants created by the library are destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ShaderLibrary();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add or replace a named source
+    ///
+    /// Variants that were already compiled are not affected,
+    /// call clear to rebuild them from the new sources.
+    ///
+    /// \param name   Name of the source, as used by getShader and #include
+    /// \param source GLSL code of the source
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSource(const char* name, const char* source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add or replace a named source loaded from a file
+    ///
+    /// \param name     Name of the source, as used by getShader and #include
+    /// \param filename Path of the file to read
+    ///
+    /// \return True if the file could be read
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadSourceFromFile(const char* name, const char* filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a named source was added
+    ///
+    ////////////////////////////////////////////////////////////
+    bool hasSource(const char* name) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Expand the includes of a source and insert definitions
+    ///
+    /// Lines of the form `#include "name"` are replaced by the
+    /// named source, recursively. The definitions are inserted
+    /// after the `#version` directive if there is one, at the
+    /// beginning of the code otherwise.
+    ///
+    /// \param name    Name of the source
+    /// \param defines Definitions to insert
+    /// \param result  Receives the preprocessed code
+    ///
+    /// \return True if the source and all its includes were found
+    ///
+    ////////////////////////////////////////////////////////////
+    bool preprocess(const char* name, const Defines& defines, std::string& result) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the variant of a vertex + fragment program
+    ///
+    /// The variant is compiled and linked the first time it
+    /// is requested, and the same shader is returned by all
+    /// the later calls with the same sources and definitions.
+    /// Programs that fail to build are remembered as well, so
+    /// that they are not compiled again.
+    ///
+    /// \param vertexName   Name of the vertex source
+    /// \param fragmentName Name of the fragment source
+    /// \param defines      Definitions of the variant
+    ///
+    /// \return Shader of the variant, or NULL if it failed to build
+    ///
+    ////////////////////////////////////////////////////////////
+    Shader* getShader(const char* vertexName, const char* fragmentName, const Defines& defines = Defines());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the variant of a vertex + geometry + fragment program
+    ///
+    /// See getShader(const char*, const char*, const Defines&).
+    ///
+    /// \param vertexName   Name of the vertex source
+    /// \param geometryName Name of the geometry source
+    /// \param fragmentName Name of the fragment source
+    /// \param defines      Definitions of the variant
+    ///
+    /// \return Shader of the variant, or NULL if it failed to build
+    ///
+    ////////////////////////////////////////////////////////////
+    Shader* getShader(const char* vertexName, const char* geometryName, const char* fragmentName, const Defines& defines = Defines());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of variants built so far
+    ///
+    /// Failed variants are included.
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVariantCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy all the variants
+    ///
+    /// The sources are kept. Shaders returned by getShader
+    /// must not be used anymore after this call.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Expand the includes of a source into \a result
+    ///
+    /// \param name  Name of the source
+    /// \param stack Names of the sources being expanded, to detect cycles
+    /// \param result String to append the code to
+    ///
+    ////////////////////////////////////////////////////////////
+    bool expand(const std::string& name, std::vector<std::string>& stack, std::string& result) const;
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<std::string, std::string> SourceTable;
+    typedef std::map<std::string, Shader*> VariantTable;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SourceTable  m_sources;  ///< Named sources
+    VariantTable m_variants; ///< Built variants, mapped to their sources and definitions
+};
+
+} // namespace sf
+
+
+#endif // SFML_SHADERLIBRARY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ShaderLibrary
+/// \ingroup graphics
+///
+/// Effects often come in many permutations of the same code
+/// (with or without a texture, a number of lights, a quality
+/// level...). Instead of duplicating the sources, they can be
+/// split into named pieces that #include each other, and
+/// selected with preprocessor definitions.
+///
+/// sf::ShaderLibrary keeps the named sources, and builds each
+/// requested permutation exactly once: getShader returns the
+/// same sf::Shader for the same sources and definitions, so
+/// all the users of a variant share a single program. The
+/// preprocessed code is what sf::Shader compiles, so the
+/// variants are also stored in the program binary cache when
+/// one is given to sf::Shader::setCache.
+///
+/// Only `#include` is handled by the library; all the other
+/// directives, including `#define`, `#if` and `#ifdef`, are
+/// left to the GLSL compiler. A source can be included several
+/// times, but not by itself (directly or not).
+///
+/// Usage example:
+/// \code
+/// sf::ShaderLibrary library;
+/// library.setSource("lighting", lightingCode);
+/// library.setSource("sprite.vert", vertexCode);
+/// library.setSource("sprite.frag", fragmentCode); // #include "lighting"
+///
+/// sf::ShaderLibrary::Defines defines;
+/// defines["LIGHT_COUNT"] = "4";
+/// defines["USE_NORMAL_MAP"] = "";
+///
+/// sf::Shader* shader = library.getShader("sprite.vert", "sprite.frag", defines);
+/// if (shader)
+///     window.draw(sprite, shader);
+/// \endcode
+///
+/// \see sf::Shader, sf::ShaderCache
+///
+////////////////////////////////////////////////////////////
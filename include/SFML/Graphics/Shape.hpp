@@ -51,6 +51,45 @@ public:
     ////////////////////////////////////////////////////////////
     virtual ~Shape();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Shape(const Shape& copy) = default;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The vertex arrays are taken over from \a right without
+    /// being copied.
+    ///
+    /// \param right Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    Shape(Shape&& right) = default;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Shape& operator =(const Shape& right) = default;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of move assignment operator
+    ///
+    /// \param right Instance to move
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Shape& operator =(Shape&& right) = default;
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the source texture of the shape
     ///
@@ -87,6 +126,26 @@ public:
     ////////////////////////////////////////////////////////////
     void setTextureRect(const IntRect& rect);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the area of the texture used to draw the outline
+    ///
+    /// The outline is not textured, so by default a textured
+    /// shape is drawn with two draw calls (the fill with the
+    /// texture, the outline without), which breaks batching.
+    /// If the texture contains an opaque white area, like the
+    /// white square reserved in font pages, the outline can
+    /// instead sample it and the whole shape is drawn at once.
+    /// This rectangle is ignored if the shape has no texture.
+    /// By default it is empty, meaning that the texture has no
+    /// white area.
+    ///
+    /// \param rect Rectangle of opaque white pixels in the texture, in pixels
+    ///
+    /// \see getOutlineTextureRect, setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutlineTextureRect(const IntRect& rect);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the fill color of the shape
     ///
@@ -155,6 +214,16 @@ public:
     ////////////////////////////////////////////////////////////
     const IntRect& getTextureRect() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area of the texture used to draw the outline
+    ///
+    /// \return White area of the texture, empty if there is none
+    ///
+    /// \see setOutlineTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getOutlineTextureRect() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the fill color of the shape
     ///
@@ -185,6 +254,36 @@ public:
     ////////////////////////////////////////////////////////////
     float getOutlineThickness() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the anti-aliasing of the edges
+    ///
+    /// When enabled, the shape is surrounded by a fringe one
+    /// pixel wide, which fades from the color of its edge to
+    /// full transparency. This smooths the edges at a fraction
+    /// of the cost of rendering into a multisampled target.
+    /// The width of the fringe is derived from the view and the
+    /// transform of each draw, so that it stays one pixel wide
+    /// on screen whatever the zoom level. The fringe is not
+    /// taken into account by the bounds of the shape.
+    /// Anti-aliasing is disabled by default.
+    ///
+    /// \param enabled True to smooth the edges, false to disable it
+    ///
+    /// \see isAntialiasingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAntialiasingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the edges are anti-aliased or not
+    ///
+    /// \return True if the edges are anti-aliased, false if not
+    ///
+    /// \see setAntialiasingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAntialiasingEnabled() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the total number of points of the shape
     ///
@@ -212,6 +311,21 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Vector2f getPoint(std::size_t index) const = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get all the points of the shape
+    ///
+    /// This is what update() uses to build the geometry. The
+    /// default implementation calls getPoint for each point;
+    /// derived classes can override it to produce all the
+    /// points in a single call.
+    ///
+    /// \param points Array that receives the getPointCount() points, in local coordinates
+    ///
+    /// \see getPoint
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void getPoints(Vector2f* points) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the local bounding rectangle of the entity
     ///
@@ -247,6 +361,26 @@ public:
     ////////////////////////////////////////////////////////////
     FloatRect getGlobalBounds() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the geometry of several shapes in parallel
+    ///
+    /// The shapes are tessellated by the jobs of the scheduler
+    /// of sf::JobSystem, the calling thread included, and the
+    /// function returns when all of them are done. Only the
+    /// CPU-side geometry is rebuilt: nothing is sent to the
+    /// graphics card, which happens when the shapes are drawn.
+    /// This is useful after changing the points of many shapes
+    /// without updating them (see ConvexShape::setPoints).
+    /// A shape must not appear twice in the array, and the
+    /// getPoints function of the shapes must be safe to call
+    /// concurrently on different shapes.
+    ///
+    /// \param shapes Array of pointers to the shapes to update
+    /// \param count  Number of shapes in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    static void updateMany(Shape* const* shapes, std::size_t count);
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -276,6 +410,16 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the shape
+    ///
+    /// \param bounds Receives the global bounds of the shape
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the fill vertices' color
     ///
@@ -302,18 +446,40 @@ private:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the triangle list from the fill and outline geometry
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateTriangles() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append the anti-aliasing fringe to the triangle list
+    ///
+    /// \param out Index of the first vertex to write
+    ///
+    /// \return Index following the last written vertex
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t appendFringe(std::size_t out) const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const Texture* m_texture;          ///< Texture of the shape
-    IntRect        m_textureRect;      ///< Rectangle defining the area of the source texture to display
-    Color          m_fillColor;        ///< Fill color
-    Color          m_outlineColor;     ///< Outline color
-    float          m_outlineThickness; ///< Thickness of the shape's outline
-    VertexArray    m_vertices;         ///< Vertex array containing the fill geometry
-    VertexArray    m_outlineVertices;  ///< Vertex array containing the outline geometry
-    FloatRect      m_insideBounds;     ///< Bounding rectangle of the inside (fill)
-    FloatRect      m_bounds;           ///< Bounding rectangle of the whole shape (outline + fill)
+    const Texture*      m_texture;             ///< Texture of the shape
+    IntRect             m_textureRect;         ///< Rectangle defining the area of the source texture to display
+    IntRect             m_outlineTextureRect;  ///< White area of the texture, sampled by the outline
+    Color               m_fillColor;           ///< Fill color
+    Color               m_outlineColor;        ///< Outline color
+    float               m_outlineThickness;    ///< Thickness of the shape's outline
+    bool                m_antialiasing;        ///< Are the edges anti-aliased with a fringe?
+    VertexArray         m_vertices;            ///< Vertex array containing the fill geometry
+    VertexArray         m_outlineVertices;     ///< Vertex array containing the outline geometry
+    mutable VertexArray m_triangles;           ///< Fill then outline geometry, as a single triangle list
+    mutable bool        m_trianglesNeedUpdate; ///< Does m_triangles need to be rebuilt?
+    mutable std::size_t m_texturedCount;       ///< Number of vertices in m_triangles that use the shape's texture
+    mutable float       m_fringeWidth;         ///< Width of the anti-aliasing fringe, in local units (0 if none)
+    FloatRect           m_insideBounds;        ///< Bounding rectangle of the inside (fill)
+    FloatRect           m_bounds;              ///< Bounding rectangle of the whole shape (outline + fill)
 };
 
 } // namespace sf
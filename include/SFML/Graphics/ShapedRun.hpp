@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SHAPEDRUN_HPP
+#define SFML_SHAPEDRUN_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/String.hpp>
+#include <SFML/Config.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Font;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Glyph of a shaped string
+///
+////////////////////////////////////////////////////////////
+struct ShapedGlyph
+{
+    Uint32 cluster; ///< Index of the character of the string the glyph comes from
+    Uint32 index;   ///< Index of the glyph in the font face
+    float  offset;  ///< Horizontal offset of the pen before the glyph (kerning with the previous character)
+    float  advance; ///< Horizontal offset of the pen after the glyph
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Glyphs and positions of a string, in logical order
+///
+////////////////////////////////////////////////////////////
+struct ShapedRun
+{
+    std::vector<ShapedGlyph> glyphs; ///< Glyphs of the string ('\r' has none)
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Convert the characters of a string to glyphs
+///
+/// The characters before \a first are only used as context,
+/// so that appending characters to a string only shapes the
+/// new ones. The glyphs are appended to \a run.
+///
+/// \param font          Font of the glyphs
+/// \param string        String to shape
+/// \param first         Index of the first character to shape
+/// \param characterSize Reference character size
+/// \param bold          Shape the bold version or the regular one?
+/// \param run           Run to append the glyphs to
+///
+////////////////////////////////////////////////////////////
+void shapeString(const Font& font, const String& string, std::size_t first, unsigned int characterSize, bool bold, ShapedRun& run);
+
+////////////////////////////////////////////////////////////
+/// \brief Cache of the strings shaped with a font
+///
+/// Shaping is done once per string, character size and
+/// boldness, and the result is reused by all the texts that
+/// show the same string, across frames. Runs that are not
+/// used for a frame are dropped when the cache is full.
+///
+////////////////////////////////////////////////////////////
+class ShapedRunCache
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ShapedRunCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shaped run of a string, shaping it if needed
+    ///
+    /// The returned reference stays valid until the next call.
+    ///
+    /// \param font          Font of the glyphs
+    /// \param string        String to shape
+    /// \param characterSize Reference character size
+    /// \param bold          Shape the bold version or the regular one?
+    /// \param revision      Revision of the glyphs of the font, runs shaped with another one are shaped again
+    ///
+    /// \return The glyphs of the string
+    ///
+    ////////////////////////////////////////////////////////////
+    const ShapedRun& get(const Font& font, const String& string, unsigned int characterSize, bool bold, Uint64 revision);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the runs
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run stored in the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Entry() : string(), characterSize(0), bold(false), revision(0), lastUsedFrame(0), run() {}
+
+        String       string;        ///< Shaped string
+        unsigned int characterSize; ///< Character size of the run
+        bool         bold;          ///< Boldness of the run
+        Uint64       revision;      ///< Revision of the font glyphs the run was shaped with
+        Uint64       lastUsedFrame; ///< Frame of the last request of the run
+        ShapedRun    run;           ///< Glyphs of the string
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::map<Uint64, Entry> m_runs; ///< Runs, by hash of their string, size and boldness
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SHAPEDRUN_HPP
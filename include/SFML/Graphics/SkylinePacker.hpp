@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SKYLINEPACKER_HPP
+#define SFML_SKYLINEPACKER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Rectangle packer with the bottom-left skyline heuristic
+///
+/// The packer only tracks the top of the used area of each
+/// column range (the skyline); the free space below it is
+/// never reused, which keeps insertion cheap and the waste
+/// low for rectangles of similar heights such as glyphs.
+///
+////////////////////////////////////////////////////////////
+class SkylinePacker
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The packer is empty (0x0) until reset is called.
+    ///
+    ////////////////////////////////////////////////////////////
+    SkylinePacker();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget all the rectangles and set the packing area
+    ///
+    /// \param width  Width of the area
+    /// \param height Height of the area
+    /// \param margin Rows and columns reserved at the left and top
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset(unsigned int width, unsigned int height, unsigned int margin = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enlarge the packing area, keeping the rectangles
+    ///
+    /// \param width  New width of the area (not smaller than the current one)
+    /// \param height New height of the area (not smaller than the current one)
+    ///
+    ////////////////////////////////////////////////////////////
+    void grow(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find room for a rectangle and reserve it
+    ///
+    /// \param width  Width of the rectangle
+    /// \param height Height of the rectangle
+    /// \param rect   Receives the position of the rectangle
+    ///
+    /// \return True if the rectangle fits into the area
+    ///
+    ////////////////////////////////////////////////////////////
+    bool insert(unsigned int width, unsigned int height, IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve a rectangle at a known position
+    ///
+    /// This is used to restore the state of a packer from the
+    /// rectangles it returned: the skyline is raised to the
+    /// bottom of \a rect over its columns.
+    ///
+    /// \param rect Rectangle to reserve
+    ///
+    ////////////////////////////////////////////////////////////
+    void occupy(const IntRect& rect);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Segment of the skyline
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Node
+    {
+        Node(unsigned int nodeX, unsigned int nodeY, unsigned int nodeWidth) : x(nodeX), y(nodeY), width(nodeWidth) {}
+
+        unsigned int x;     ///< Left of the segment
+        unsigned int y;     ///< Height of the skyline along the segment
+        unsigned int width; ///< Width of the segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Merge the neighbour segments that have the same height
+    ///
+    ////////////////////////////////////////////////////////////
+    void merge();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Split the segment that spans a column, so that a segment starts at it
+    ///
+    ////////////////////////////////////////////////////////////
+    void splitAt(unsigned int x);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int      m_width;   ///< Width of the packing area
+    unsigned int      m_height;  ///< Height of the packing area
+    unsigned int      m_margin;  ///< Rows and columns reserved at the left and top
+    std::vector<Node> m_skyline; ///< Top of the used area, from left to right
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SKYLINEPACKER_HPP
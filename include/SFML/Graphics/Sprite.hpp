@@ -33,6 +33,8 @@
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <vector>
 
 
 namespace sf
@@ -77,6 +79,20 @@ public:
     ////////////////////////////////////////////////////////////
     Sprite(const Texture& texture, const IntRect& rectangle);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the sprite from a region of a texture atlas
+    ///
+    /// The sprite uses the page texture of the region, so that
+    /// all the sprites of the same atlas page can be batched.
+    /// An invalid region produces an empty sprite.
+    ///
+    /// \param region Region returned by TextureAtlas::getRegion
+    ///
+    /// \see setTexture, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Sprite(const TextureAtlas::Region& region);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the source texture of the sprite
     ///
@@ -127,6 +143,39 @@ public:
     ////////////////////////////////////////////////////////////
     void setColor(const Color& color);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set a tight mesh to draw instead of the whole texture rect
+    ///
+    /// The mesh is a convex polygon, usually the outline of the
+    /// visible pixels of the texture rect computed by
+    /// sf::TextureAtlas (see TextureAtlas::setMeshVertexBudget).
+    /// Drawing it instead of the rectangle skips the fully
+    /// transparent pixels around the image, at the cost of a
+    /// few more vertices.
+    ///
+    /// The points are in local coordinates, i.e. inside
+    /// getLocalBounds(), and are mapped to the texture rect
+    /// the same way as the corners of the rectangle. The mesh
+    /// is removed when the texture rect changes.
+    ///
+    /// \param outline Vertices of the convex polygon, in order;
+    ///                fewer than 3 points remove the mesh
+    ///
+    /// \see hasMesh, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMesh(const std::vector<Vector2f>& outline);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the sprite draws a tight mesh instead of its rectangle
+    ///
+    /// \return True if the sprite has a mesh
+    ///
+    /// \see setMesh
+    ///
+    ////////////////////////////////////////////////////////////
+    bool hasMesh() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the source texture of the sprite
     ///
@@ -191,6 +240,8 @@ public:
 
 private:
 
+    friend class RenderTarget;
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the sprite to a render target
     ///
@@ -200,6 +251,26 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the sprite
+    ///
+    /// \param bounds Receives the global bounds of the sprite
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the vertices of the sprite
+    ///
+    /// \param target Render target to draw to
+    /// \param states Render states, with the transform of the
+    ///               sprite and its texture already applied
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawTransformed(RenderTarget& target, const RenderStates& states) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the vertices' positions
     ///
@@ -215,9 +286,10 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vertex         m_vertices[4]; ///< Vertices defining the sprite's geometry
-    const Texture* m_texture;     ///< Texture of the sprite
-    IntRect        m_textureRect; ///< Rectangle defining the area of the source texture to display
+    Vertex              m_vertices[4]; ///< Vertices defining the sprite's geometry
+    std::vector<Vertex> m_mesh;        ///< Vertices of the tight mesh drawn instead of the quad, as a triangle fan (empty if none)
+    const Texture*      m_texture;     ///< Texture of the sprite
+    IntRect             m_textureRect; ///< Rectangle defining the area of the source texture to display
 };
 
 } // namespace sf
@@ -0,0 +1,277 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SPRITEBATCH_HPP
+#define SFML_SPRITEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+class Sprite;
+class TransformBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Many textured quads sharing a texture, rendered
+///        with a single instanced draw call
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpriteBatch : public Drawable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch with no source texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the batch from a source texture
+    ///
+    /// \param texture Source texture shared by all the sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpriteBatch(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the source texture of the batch
+    ///
+    /// The texture must exist as long as the batch uses it.
+    ///
+    /// \param texture New texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the source texture of the batch
+    ///
+    /// \return Pointer to the texture, or NULL if none
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sprite to the batch
+    ///
+    /// The sprite is a quad of the size of \a textureRect,
+    /// placed with \a transform like sf::Sprite does.
+    ///
+    /// \param transform   Transform of the sprite
+    /// \param textureRect Sub-rectangle of the texture to display
+    /// \param color       Global color of the sprite
+    ///
+    /// \return Index of the new sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Transform& transform, const IntRect& textureRect, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a copy of an existing sprite to the batch
+    ///
+    /// Only the transform, texture rectangle and color of the
+    /// sprite are used, its texture is ignored.
+    ///
+    /// \param sprite Sprite to copy
+    ///
+    /// \return Index of the new sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Sprite& sprite);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sprite placed by the transform buffer
+    ///
+    /// The sprite takes the transform of the same index in the
+    /// buffer set with setTransformBuffer.
+    ///
+    /// \param textureRect Sub-rectangle of the texture to display
+    /// \param color       Global color of the sprite
+    ///
+    /// \return Index of the new sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const IntRect& textureRect, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a sprite of the batch
+    ///
+    /// \param index       Index of the sprite to change
+    /// \param transform   New transform of the sprite
+    /// \param textureRect New sub-rectangle of the texture to display
+    /// \param color       New global color of the sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    void set(std::size_t index, const Transform& transform, const IntRect& textureRect, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the sprites of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve room for a number of sprites
+    ///
+    /// \param count Number of sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sprites in the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether hardware instancing is used
+    ///
+    /// If the system doesn't support instanced drawing (GLES 2
+    /// without EXT/ANGLE_instanced_arrays), the sprites are
+    /// expanded to quads on the CPU instead.
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isInstancingAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the transforms of the sprites from a buffer
+    ///
+    /// When a buffer is set, the sprite of index \a i is placed
+    /// with the transform of index \a i of the buffer, combined
+    /// with its own transform. Sprites beyond the size of the
+    /// buffer only use their own transform. The batch is rebuilt
+    /// automatically when the buffer changes.
+    ///
+    /// The buffer must exist as long as the batch uses it.
+    ///
+    /// \param buffer Transform buffer, or NULL to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTransformBuffer(const TransformBuffer* buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the transform buffer of the batch
+    ///
+    /// \return Pointer to the transform buffer, or NULL if none
+    ///
+    ////////////////////////////////////////////////////////////
+    const TransformBuffer* getTransformBuffer() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sprite as passed by the user
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Item
+    {
+        Transform transform;
+        IntRect   textureRect;
+        Color     color;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Texture*              m_texture;           ///< Texture shared by the sprites
+    std::vector<Item>           m_items;             ///< Sprites of the batch
+    mutable unsigned int        m_buffer;            ///< Instance buffer handle
+    mutable std::size_t         m_bufferSize;        ///< Size in instances of the allocated instance buffer
+    mutable std::vector<Vertex> m_vertices;          ///< Expanded quads, when instancing is unavailable
+    mutable bool                m_needUpdate;        ///< Do the instances or vertices need to be rebuilt?
+    mutable Vector2u            m_textureSize;       ///< Texture size the instances were built for
+    const TransformBuffer*      m_transforms;        ///< Buffer of transforms to read by index
+    mutable Uint32              m_transformsVersion; ///< Version of the transform buffer the instances were built for
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpriteBatch
+/// \ingroup graphics
+///
+/// sf::SpriteBatch draws many sprites that share the same
+/// texture with one draw call. Each sprite is stored as a
+/// compact instance (transform, texture rectangle, color) in
+/// a GPU buffer, which is only re-uploaded when the batch
+/// changes, and expanded to a quad by the vertex shader.
+///
+/// This is much cheaper than drawing as many sf::Sprite,
+/// which each cost their own draw. On systems without
+/// instancing, the sprites are expanded to quads on the CPU
+/// and drawn as a single vertex array.
+///
+/// Usage example:
+/// \code
+/// sf::SpriteBatch bullets(texture);
+///
+/// for (const Bullet& bullet : bullets)
+///     bullets.add(bullet.getTransform(), sf::IntRect(0, 0, 8, 8));
+///
+/// window.draw(bullets);
+/// \endcode
+///
+/// The transforms can also be taken by index from a
+/// sf::TransformBuffer, for very large numbers of sprites
+/// that move every frame.
+///
+/// \see sf::Sprite, sf::Texture, sf::TransformBuffer
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_STARTUPSTATS_HPP
+#define SFML_STARTUPSTATS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Breakdown of the time spent initializing the graphics module
+///
+////////////////////////////////////////////////////////////
+struct SFML_GRAPHICS_API StartupStats
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// All the durations and counters are set to 0.
+    ///
+    ////////////////////////////////////////////////////////////
+    StartupStats();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Time   loaderTime;         ///< Time spent looking up the OpenGL entry points
+    Uint32 entryPointsLoaded;  ///< Number of entry points looked up
+    Uint32 entryPointsSkipped; ///< Number of entry points skipped because the graphics module doesn't call them
+    Time   capsTime;           ///< Time spent detecting the features of the context
+    Time   pipelineTime;       ///< Time spent creating the pipeline of the first context (buffers, submission of the built-in shaders)
+    Time   shaderWaitTime;     ///< Time spent waiting for the built-in shaders to be compiled and linked, until the first frame
+    Time   firstFrameTime;     ///< Time between the start of the initialization and the end of the first RenderWindow::display
+};
+
+} // namespace sf
+
+
+#endif // SFML_STARTUPSTATS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::StartupStats
+/// \ingroup graphics
+///
+/// sf::StartupStats tells where the time goes between the
+/// creation of the first render target and the first frame
+/// on screen. The OpenGL entry points are looked up first
+/// (see RenderTarget::setMinimalGLLoading), then the features
+/// of the context are detected and the pipeline is created.
+/// The built-in shaders of the pipeline are compiled in the
+/// background where the driver allows it, and waited for when
+/// they are first drawn with; a program restored from the
+/// shader cache (see Shader::setCache) is almost free.
+///
+/// The durations are measured once, on the first context,
+/// and don't change afterwards.
+///
+/// Usage example:
+/// \code
+/// window.display();
+///
+/// const sf::StartupStats& stats = sf::RenderTarget::getStartupStats();
+/// std::printf("loader %.1f ms (%u functions), pipeline %.1f ms, shaders %.1f ms, first frame %.1f ms\n",
+///             stats.loaderTime.asSeconds() * 1000.f, stats.entryPointsLoaded,
+///             stats.pipelineTime.asSeconds() * 1000.f, stats.shaderWaitTime.asSeconds() * 1000.f,
+///             stats.firstFrameTime.asSeconds() * 1000.f);
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::RenderStats
+///
+////////////////////////////////////////////////////////////
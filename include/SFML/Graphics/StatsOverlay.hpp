@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_STATSOVERLAY_HPP
+#define SFML_STATSOVERLAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/NumericText.hpp>
+#include <SFML/Graphics/TextBatch.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Font;
+
+////////////////////////////////////////////////////////////
+/// \brief Ready-made display of the frame times and of the
+///        render statistics
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API StatsOverlay : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the overlay
+    ///
+    /// \param font          Font of the overlay, which must exist as long as the overlay uses it
+    /// \param characterSize Character size of the overlay, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit StatsOverlay(const Font& font, unsigned int characterSize = 12);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a font to the atlas memory counter
+    ///
+    /// The glyph pages of the font of the overlay are always
+    /// counted. The font must exist as long as the overlay
+    /// uses it.
+    ///
+    /// \param font Font whose glyph pages are counted
+    ///
+    ////////////////////////////////////////////////////////////
+    void watchFont(const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the frame time budget
+    ///
+    /// The budget is marked by a line at mid-height of the
+    /// graphs, and the frames over it are drawn in red. The
+    /// default budget is 1/60 second.
+    ///
+    /// \param budget Frame time budget
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFrameBudget(Time budget);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set how often the figures are refreshed
+    ///
+    /// The figures are averaged over the frames of each
+    /// interval; the graphs are updated every frame. The
+    /// default interval is 250 milliseconds.
+    ///
+    /// \param interval Time between two refreshes of the figures
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRefreshInterval(Time interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the counters of the current frame
+    ///
+    /// This function must be called once per frame, after the
+    /// frame is drawn and before RenderWindow::display, which
+    /// resets the counters (see RenderTarget::resetFrameStats).
+    /// The GPU time is the total time of the top-level scopes
+    /// of the active sf::GpuProfiler, if any.
+    ///
+    /// \param cpuTime CPU time spent on the frame
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time cpuTime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the overlay
+    ///
+    /// \return Local bounding rectangle of the overlay
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the overlay to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the bar of a frame into a graph
+    ///
+    /// \param graph Index of the graph (0 for the CPU, 1 for the GPU)
+    /// \param index Index of the bar in the graph
+    /// \param time  Time of the frame (negative for no bar)
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeBar(std::size_t graph, std::size_t index, float time);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the budget lines over the graphs
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeBudgetLines();
+
+    enum Row
+    {
+        CpuTime,    ///< Average CPU frame time (ms)
+        GpuTime,    ///< Average GPU frame time (ms)
+        DrawCalls,  ///< Draw calls per frame
+        Batches,    ///< Batches per frame
+        Vertices,   ///< Vertices per frame
+        Uploads,    ///< Bytes uploaded per frame (KB)
+        Textures,   ///< Texture memory (MB)
+        Atlases,    ///< Glyph atlas memory (MB)
+        GlyphHits,  ///< Glyph cache hit rate (%)
+        RowCount    ///< Keep last -- the number of rows
+    };
+
+    enum
+    {
+        HistorySize = 120 ///< Number of frames in the graphs
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Font*              m_font;               ///< Font of the overlay
+    std::vector<const Font*> m_watchedFonts;       ///< Fonts whose glyph pages are counted
+    TextBatch                m_labels;             ///< Labels of the rows
+    NumericText              m_values[RowCount];   ///< Figures of the rows
+    std::vector<Vertex>      m_vertices;           ///< Triangles of the background, graph bars and budget lines
+    float                    m_graphTop;           ///< Top of the first graph
+    float                    m_graphHeight;        ///< Height of a graph
+    float                    m_graphSpacing;       ///< Vertical distance between the tops of the graphs
+    float                    m_width;              ///< Width of the overlay
+    float                    m_budget;             ///< Frame time budget, in milliseconds
+    std::size_t              m_head;               ///< Index of the next bar to write
+    Time                     m_refreshInterval;    ///< Time between two refreshes of the figures
+    Clock                    m_refreshClock;       ///< Time since the last refresh of the figures
+    double                   m_sums[RowCount];     ///< Sums of the per-frame counters since the last refresh
+    Uint64                   m_glyphLookups;       ///< Glyph lookups since the last refresh
+    unsigned int             m_frames;             ///< Frames since the last refresh
+    unsigned int             m_gpuFrames;          ///< Frames with a GPU time since the last refresh
+    bool                     m_gpuShown;           ///< Is the GPU figure displayed?
+};
+
+} // namespace sf
+
+
+#endif // SFML_STATSOVERLAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::StatsOverlay
+/// \ingroup graphics
+///
+/// sf::StatsOverlay shows a compact panel with the CPU and
+/// GPU frame times of the last 120 frames as bar graphs, and
+/// the average draw calls, batches, vertices, uploads, texture
+/// and glyph atlas memory, and glyph cache hit rate of the
+/// frames, read from sf::RenderStats, sf::GpuMemory and the
+/// active sf::GpuProfiler.
+///
+/// The overlay is meant to stay enabled in test builds, so it
+/// keeps its own cost close to nothing: the labels are laid
+/// out once into a sf::TextBatch, the figures are sf::NumericText
+/// objects refreshed a few times per second, and the graphs
+/// are swept like an oscilloscope, so that each frame only
+/// rewrites the two bars of the new frame. When batching is
+/// enabled, the whole overlay usually costs one or two draw
+/// calls, which are included in the figures of the next frame.
+///
+/// The overlay is drawn with the current view of the target:
+/// set a view matching the target size before drawing it.
+///
+/// Usage example:
+/// \code
+/// sf::StatsOverlay overlay(font);
+/// overlay.setPosition(8, 8);
+/// overlay.watchFont(uiFont);
+///
+/// sf::GpuProfiler profiler;
+/// profiler.setActive(true);
+///
+/// sf::Clock clock;
+/// while (running)
+/// {
+///     clock.restart();
+///     drawScene(window);
+///     window.setView(window.getDefaultView());
+///     window.draw(overlay);
+///     overlay.update(clock.getElapsedTime());
+///
+///     profiler.frame();
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::RenderStats, sf::GpuProfiler, sf::GpuMemory
+///
+////////////////////////////////////////////////////////////
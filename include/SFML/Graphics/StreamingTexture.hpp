@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_STREAMINGTEXTURE_HPP
+#define SFML_STREAMINGTEXTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Texture rewritten by the CPU every frame, without
+///        waiting for the GPU
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API StreamingTexture : NonCopyable
+{
+public:
+
+    enum
+    {
+        MaxBufferCount = 3 ///< Maximum number of textures the streaming texture rotates through
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty streaming texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    StreamingTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~StreamingTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the streaming texture
+    ///
+    /// Each buffer is a full RGBA texture of the given size, so
+    /// the video memory used is \a bufferCount times the memory
+    /// of a single texture. Any previous contents are lost.
+    ///
+    /// \param width       Width of the texture
+    /// \param height      Height of the texture
+    /// \param bufferCount Number of textures to rotate through (2 or 3)
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int bufferCount = 3);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start writing the next frame of pixels
+    ///
+    /// The returned array holds width * height * 4 bytes of RGBA
+    /// pixels, row after row. Its previous contents are undefined,
+    /// every pixel must be written before calling unlock. The
+    /// pointer is valid until unlock is called, and it may point
+    /// to driver memory that is slow to read from.
+    ///
+    /// \return Pointer to the pixels to write, or NULL on failure
+    ///
+    /// \see unlock
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* lock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish writing the pixels and send them to the GPU
+    ///
+    /// The transfer is queued without waiting for the GPU; the
+    /// new pixels are returned by getTexture once the transfer
+    /// has completed.
+    ///
+    /// \see lock
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the most recent pixels that finished uploading
+    ///
+    /// The returned texture changes as new frames complete, so
+    /// it must be requested again for every draw instead of
+    /// being kept in a sprite.
+    ///
+    /// \return Texture to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the texture
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter of all the buffers
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see Texture::setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the pixel buffers and their fences
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseBuffers();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Promote the newest completed transfer to the displayed texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void pollTransfers() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Texture              m_textures[MaxBufferCount]; ///< Textures rotated through
+    unsigned int         m_buffers[MaxBufferCount];  ///< Pixel unpack buffer of each texture (0 without pixel buffer support)
+    mutable void*        m_fences[MaxBufferCount];   ///< Fence of the pending transfer of each texture (GLsync), NULL if none
+    Uint64               m_serials[MaxBufferCount];  ///< Submission order of the last transfer of each texture
+    unsigned int         m_bufferCount;              ///< Number of textures in use
+    unsigned int         m_writeIndex;               ///< Texture written between lock and unlock
+    mutable unsigned int m_displayIndex;             ///< Texture returned by getTexture
+    Uint64               m_serial;                   ///< Submission order of the last transfer
+    Uint8*               m_lockedPixels;             ///< Pixels returned by lock, NULL if not locked
+    std::vector<Uint8>   m_staging;                  ///< CPU copy of the pixels, used when no buffer can be mapped
+};
+
+} // namespace sf
+
+
+#endif // SFML_STREAMINGTEXTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::StreamingTexture
+/// \ingroup graphics
+///
+/// Updating a texture that the GPU is still drawing with makes
+/// the driver wait for the draw to finish. sf::StreamingTexture
+/// rotates through 2 or 3 textures instead: new pixels are
+/// written into a mapped pixel buffer, transferred to a texture
+/// that isn't displayed, and shown once the transfer is done.
+/// It suits contents regenerated by the CPU every frame, such
+/// as video frames or software-rendered canvases.
+///
+/// Without pixel buffers and fences (OpenGL ES 2, WebGL 1),
+/// lock returns a CPU array and unlock updates the texture
+/// directly, which may wait for the GPU.
+///
+/// Usage example:
+/// \code
+/// sf::StreamingTexture video;
+/// video.create(1280, 720);
+///
+/// while (window.isOpen())
+/// {
+///     if (sf::Uint8* pixels = video.lock())
+///     {
+///         decoder.decodeNextFrame(pixels);
+///         video.unlock();
+///     }
+///
+///     window.clear();
+///     window.draw(sf::Sprite(video.getTexture()));
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::Texture
+///
+////////////////////////////////////////////////////////////
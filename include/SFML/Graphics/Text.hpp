@@ -32,8 +32,10 @@
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/MemoryStats.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
 #include <SFML/System/String.hpp>
 #include <string>
 #include <vector>
@@ -62,6 +64,16 @@ public:
         StrikeThrough = 1 << 3  ///< Strike through characters
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enumeration of the ways of drawing the outline
+    ///
+    ////////////////////////////////////////////////////////////
+    enum OutlineMode
+    {
+        StrokedOutline, ///< Glyphs stroked by FreeType, drawn under the fill glyphs (default)
+        ShaderOutline   ///< Outline computed by the fragment shader around the fill glyphs
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -87,6 +99,46 @@ public:
     ////////////////////////////////////////////////////////////
     Text(const String& string, const Font& font, unsigned int characterSize = 30);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Text(const Text& copy) = default;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The string and the geometry (including the vertex buffer
+    /// of a static text) are taken over from \a right, nothing
+    /// is copied or uploaded again.
+    ///
+    /// \param right Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    Text(Text&& right) = default;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Text& operator =(const Text& right) = default;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of move assignment operator
+    ///
+    /// \param right Instance to move
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Text& operator =(Text&& right) = default;
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the text's string
     ///
@@ -108,6 +160,54 @@ public:
     ////////////////////////////////////////////////////////////
     void setString(const String& string);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the text's string, taking its characters
+    ///
+    /// Same as the other overload, but the characters of
+    /// \a string are moved into the text instead of copied.
+    /// This is the overload used for temporary strings, such
+    /// as the ones converted from a std::string.
+    ///
+    /// \param string New string, left empty
+    ///
+    /// \see getString
+    ///
+    ////////////////////////////////////////////////////////////
+    void setString(String&& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the text's string from UTF-8 characters
+    ///
+    /// The characters are decoded straight into the string of
+    /// the text. Unlike the std::string conversion of sf::String,
+    /// which uses the ANSI encoding of a locale, the data is
+    /// always interpreted as UTF-8.
+    ///
+    /// \param data Pointer to the UTF-8 characters
+    /// \param size Number of bytes of \a data
+    ///
+    /// \see setString
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUtf8String(const char* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append characters to the text's string
+    ///
+    /// Unlike setString with a different string, appending
+    /// keeps the geometry of the current characters and only
+    /// lays out the new ones the next time the text is drawn,
+    /// which makes texts that grow continuously (logs, chat)
+    /// cheap to update. setString does the same when the new
+    /// string starts with the current one.
+    ///
+    /// \param string Characters to append
+    ///
+    /// \see setString
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendString(const String& string);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the text's font
     ///
@@ -245,11 +345,78 @@ public:
     ///
     /// \param thickness New outline thickness, in pixels
     ///
-    /// \see getOutlineThickness
+    /// \see getOutlineThickness, setOutlineMode
     ///
     ////////////////////////////////////////////////////////////
     void setOutlineThickness(float thickness);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set how the text's outline is drawn
+    ///
+    /// In the StrokedOutline mode, each character has a second
+    /// glyph stroked by FreeType for the outline thickness,
+    /// drawn before the fill glyphs.
+    ///
+    /// In the ShaderOutline mode, the fill glyphs are drawn
+    /// once, on quads grown by the outline thickness, and the
+    /// fragment shader computes the outline around them: the
+    /// text is a single draw with a single set of glyphs, and
+    /// changing the thickness rasterizes nothing. The outline
+    /// is a second threshold of distance field glyphs, limited
+    /// by the spread of the field, or dilates the coverage of
+    /// the other glyphs, limited by the glyph padding of the
+    /// font (see Font::setGlyphPadding). The outlines of the
+    /// underline and strike through lines are still drawn
+    /// separately, and static texts are drawn from client memory
+    /// in this mode. A custom shader replaces the outline shader.
+    ///
+    /// By default, the outline mode is StrokedOutline.
+    ///
+    /// \param mode New outline mode
+    ///
+    /// \see getOutlineMode, setOutlineThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutlineMode(OutlineMode mode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the width at which the lines are wrapped
+    ///
+    /// The lines longer than \a width are broken at the
+    /// whitespace before the first word that doesn't fit, the
+    /// whitespace itself is not displayed. Words longer than
+    /// \a width are not broken and overflow their line.
+    /// The words are measured once, so changing the width only
+    /// computes the line breaks again.
+    ///
+    /// By default, the wrap width is 0 (lines are not wrapped).
+    ///
+    /// \param width Maximum width of the lines, in local coordinates (0 to disable wrapping)
+    ///
+    /// \see getWrapWidth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setWrapWidth(float width);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Keep the geometry of the text in video memory
+    ///
+    /// By default, the vertices of a text are sent to the
+    /// graphics card every time it is drawn. A static text
+    /// stores them in a sf::VertexBuffer instead, which is only
+    /// uploaded again when the geometry or the colors change.
+    /// This is best for texts that rarely change, such as the
+    /// labels of menus; texts that change every frame should
+    /// stay dynamic, as they also lose the batching with the
+    /// other drawables.
+    ///
+    /// \param isStatic True to keep the geometry in video memory
+    ///
+    /// \see isStatic
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStatic(bool isStatic);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the text's string
     ///
@@ -367,6 +534,36 @@ public:
     ////////////////////////////////////////////////////////////
     float getOutlineThickness() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get how the text's outline is drawn
+    ///
+    /// \return Outline mode of the text
+    ///
+    /// \see setOutlineMode
+    ///
+    ////////////////////////////////////////////////////////////
+    OutlineMode getOutlineMode() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the width at which the lines are wrapped
+    ///
+    /// \return Maximum width of the lines (0 if wrapping is disabled)
+    ///
+    /// \see setWrapWidth
+    ///
+    ////////////////////////////////////////////////////////////
+    float getWrapWidth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the geometry is kept in video memory
+    ///
+    /// \return True if the text is static
+    ///
+    /// \see setStatic
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isStatic() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the position of the \a index-th character
     ///
@@ -377,13 +574,40 @@ public:
     /// If \a index is out of range, the position of the end of
     /// the string is returned.
     ///
+    /// The positions of all the characters are recorded when
+    /// the geometry is laid out, so this function is cheap as
+    /// long as the text doesn't change between the calls.
+    ///
     /// \param index Index of the character
     ///
     /// \return Position of the character
     ///
+    /// \see findCharacterAt
+    ///
     ////////////////////////////////////////////////////////////
     Vector2f findCharacterPos(std::size_t index) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the character closest to a point
+    ///
+    /// This function is the inverse of findCharacterPos: it
+    /// returns the index of the character whose position is
+    /// the closest to \a point, on the line that contains the
+    /// point, which is where a caret would go when clicking
+    /// there. The index of the end of the string is returned
+    /// for a point past the end of the last line.
+    /// \a point is in global coordinates, and the search is
+    /// logarithmic in the size of the string.
+    ///
+    /// \param point Point to test, in global coordinates
+    ///
+    /// \return Index of the character (0 if the text has no font)
+    ///
+    /// \see findCharacterPos
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findCharacterAt(Vector2f point) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the local bounding rectangle of the entity
     ///
@@ -423,6 +647,37 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the text
+    ///
+    /// \param bounds Receives the global bounds of the text
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Word of the string, with the whitespace after it
+    ///
+    ////////////////////////////////////////////////////////////
+    struct WordSegment
+    {
+        Uint32 whitespace; ///< Index of the first whitespace character after the word (size of the string if none)
+        float  width;      ///< Width of the word
+        float  spacing;    ///< Width of the whitespace after the word
+        bool   newLine;    ///< Does the whitespace end with a new line?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute where the lines are wrapped
+    ///
+    /// The words are only measured again if the string or its
+    /// metrics changed since the last call.
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateLineBreaks() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Make sure the text's geometry is updated
     ///
@@ -432,6 +687,21 @@ public:
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Account the current size of the geometry and layout data
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateMemoryUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the geometry of the characters not laid out yet
+    ///
+    /// The layout continues from the state saved by the previous
+    /// call, and the state is saved again for the next one.
+    ///
+    ////////////////////////////////////////////////////////////
+    void layoutCharacters() const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -444,11 +714,27 @@ public:
     Color               m_fillColor;           ///< Text fill color
     Color               m_outlineColor;        ///< Text outline color
     float               m_outlineThickness;    ///< Thickness of the text's outline
+    OutlineMode         m_outlineMode;         ///< How the outline is drawn
     mutable VertexArray m_vertices;            ///< Vertex array containing the fill geometry
     mutable VertexArray m_outlineVertices;     ///< Vertex array containing the outline geometry
     mutable FloatRect   m_bounds;              ///< Bounding rectangle of the text (in local coordinates)
     mutable bool        m_geometryNeedUpdate;  ///< Does the geometry need to be recomputed?
-    mutable Uint64      m_fontTextureId;       ///< The font texture id
+    mutable bool        m_colorNeedUpdate;     ///< Do the vertex colors need to be rewritten?
+    mutable std::size_t m_layoutEnd;           ///< Number of characters of the string that are laid out
+    mutable Vector2f    m_pen;                 ///< Position of the next character to lay out
+    mutable Uint32      m_prevChar;            ///< Last character laid out, for kerning
+    mutable Vector2f    m_boundsMin;           ///< Top-left corner of the bounds of the laid out characters
+    mutable Vector2f    m_boundsMax;           ///< Bottom-right corner of the bounds of the laid out characters
+    mutable Uint64      m_fontRevision;        ///< Revision of the font glyphs the geometry was built with
+    bool                m_static;              ///< Is the geometry kept in video memory?
+    mutable VertexBuffer m_vertexBuffer;       ///< Outline then fill geometry of a static text, in video memory
+    mutable bool        m_bufferNeedUpdate;    ///< Does the vertex buffer need to be uploaded again?
+    float               m_wrapWidth;           ///< Maximum width of the lines (0 if not wrapped)
+    mutable std::vector<WordSegment> m_wordSegments; ///< Measured words of the string, for wrapping
+    mutable std::vector<Uint32> m_lineBreaks;  ///< Indices of the whitespace characters where the lines are wrapped
+    mutable bool        m_segmentsNeedUpdate;  ///< Do the words need to be measured again?
+    mutable std::vector<Vector2f> m_caretPositions; ///< Local position of each laid out character, and of the end of the string
+    mutable priv::MemoryCounter m_memory;      ///< Accounted size of the geometry and layout data
 };
 
 } // namespace sf
@@ -0,0 +1,323 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTBATCH_HPP
+#define SFML_TEXTBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Font;
+
+////////////////////////////////////////////////////////////
+/// \brief Many strings sharing a font and a character size,
+///        rendered from a single vertex buffer
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextBatch : public Drawable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch with no font.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the batch from a font and a character size
+    ///
+    /// \param font          Font shared by the strings
+    /// \param characterSize Character size shared by the strings, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextBatch(const Font& font, unsigned int characterSize = 30);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the font shared by the strings
+    ///
+    /// The font must exist as long as the batch uses it.
+    ///
+    /// \param font New font
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFont(const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the font shared by the strings
+    ///
+    /// \return Pointer to the font, or NULL if none
+    ///
+    ////////////////////////////////////////////////////////////
+    const Font* getFont() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the character size shared by the strings
+    ///
+    /// \param size New character size, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCharacterSize(unsigned int size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the character size shared by the strings
+    ///
+    /// \return Character size, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getCharacterSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the style shared by the strings
+    ///
+    /// \param style New style, a combination of sf::Text::Style flags
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStyle(Uint32 style);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the style shared by the strings
+    ///
+    /// \return Style of the strings
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getStyle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the outline shared by the strings
+    ///
+    /// \param color     Color of the outline
+    /// \param thickness Thickness of the outline, in pixels (0 for no outline)
+    /// \param mode      How the outline is drawn (see sf::Text::setOutlineMode)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutline(const Color& color, float thickness, Text::OutlineMode mode = Text::StrokedOutline);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the outline color shared by the strings
+    ///
+    /// \return Outline color
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getOutlineColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the outline thickness shared by the strings
+    ///
+    /// \return Outline thickness, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    float getOutlineThickness() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get how the outline of the strings is drawn
+    ///
+    /// \return Outline mode
+    ///
+    ////////////////////////////////////////////////////////////
+    Text::OutlineMode getOutlineMode() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a string to the batch
+    ///
+    /// The string is laid out like a sf::Text with the settings
+    /// of the batch, and placed with \a transform.
+    ///
+    /// \param string    String to display
+    /// \param transform Transform of the string
+    /// \param color     Fill color of the string
+    ///
+    /// \return Index of the new string
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const String& string, const Transform& transform, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a string of the batch
+    ///
+    /// Only the strings that changed are laid out again.
+    ///
+    /// \param index     Index of the string to change
+    /// \param string    New string to display
+    /// \param transform New transform of the string
+    /// \param color     New fill color of the string
+    ///
+    ////////////////////////////////////////////////////////////
+    void set(std::size_t index, const String& string, const Transform& transform, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move a string of the batch
+    ///
+    /// The layout of the string is kept, only its vertices are
+    /// transformed again.
+    ///
+    /// \param index     Index of the string to move
+    /// \param transform New transform of the string
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTransform(std::size_t index, const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds of a string of the batch
+    ///
+    /// \param index Index of the string
+    ///
+    /// \return Bounds of the string, in the coordinates of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getBounds(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the strings of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve room for a number of strings
+    ///
+    /// \param count Number of strings
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of strings in the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the settings of the batch to a string
+    ///
+    ////////////////////////////////////////////////////////////
+    void configure(Text& text) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark all the strings as changed, after a setting of the batch changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void configureAll();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lay out the changed strings and update the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void update() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief String of the batch, with its transformed vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Text                text;          ///< Layout of the string, in local coordinates
+        Transform           transform;     ///< Transform of the string
+        std::vector<Vertex> fill;          ///< Transformed fill vertices
+        std::vector<Vertex> outline;       ///< Transformed outline vertices
+        std::size_t         fillOffset;    ///< Offset of the fill vertices in the batch
+        std::size_t         outlineOffset; ///< Offset of the outline vertices in the batch
+        Uint64              revision;      ///< Revision of the font glyphs the vertices were built with
+        bool                needUpdate;    ///< Do the vertices need to be built again?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Font*                  m_font;             ///< Font shared by the strings
+    unsigned int                 m_characterSize;    ///< Character size shared by the strings
+    Uint32                       m_style;            ///< Style shared by the strings
+    Color                        m_outlineColor;     ///< Outline color shared by the strings
+    float                        m_outlineThickness; ///< Outline thickness shared by the strings
+    Text::OutlineMode            m_outlineMode;      ///< How the outline is drawn
+    mutable std::vector<Entry>   m_entries;          ///< Strings of the batch
+    mutable std::vector<Vertex>  m_fill;             ///< Fill vertices of all the strings
+    mutable std::vector<Vertex>  m_outline;          ///< Outline vertices of all the strings
+    mutable VertexBuffer         m_buffer;           ///< Outline then fill vertices, in video memory
+    mutable bool                 m_bufferValid;      ///< Does the vertex buffer hold the current vertices?
+    mutable bool                 m_needUpdate;       ///< Has any string changed since the last update?
+    mutable Uint64               m_revision;         ///< Revision of the font glyphs at the last update
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextBatch
+/// \ingroup graphics
+///
+/// Drawing hundreds of sf::Text instances (labels, nameplates,
+/// damage numbers) costs two draws each, whose vertices are
+/// transformed again by the CPU every frame to be batched.
+/// sf::TextBatch lays out many strings with the same font,
+/// character size, style and outline into a single vertex
+/// buffer, each string with its own transform and fill color.
+/// The vertices are only rebuilt for the strings that changed,
+/// and the whole batch is drawn with one draw for the outlines
+/// and one for the fills.
+///
+/// Usage example:
+/// \code
+/// sf::TextBatch names(font, 14);
+/// names.setOutline(sf::Color::Black, 1.f);
+/// for (std::size_t i = 0; i < players.size(); ++i)
+///     names.add(players[i].name, sf::Transform().translate(players[i].position));
+///
+/// // each frame
+/// for (std::size_t i = 0; i < players.size(); ++i)
+///     names.setTransform(i, sf::Transform().translate(players[i].position));
+/// window.draw(names);
+/// \endcode
+///
+/// \see sf::Text, sf::SpriteBatch
+///
+////////////////////////////////////////////////////////////
@@ -30,14 +30,109 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
 
 
 namespace sf
 {
+class AssetBundle;
 class InputStream;
 class RenderTarget;
 class RenderTexture;
 class Text;
+class Texture;
+
+namespace priv
+{
+class RenderTextureImpl;
+struct CompressedImage;
+
+////////////////////////////////////////////////////////////
+/// \brief Copy the pending pixels of a render-texture to its texture
+///
+/// Called before a texture is sampled or read back. It does
+/// nothing unless the texture belongs to a multisampled
+/// RenderTexture that was displayed since the last resolve.
+///
+////////////////////////////////////////////////////////////
+void resolveTexture(const Texture& texture);
+
+////////////////////////////////////////////////////////////
+/// \brief Delete the frame buffers that the texture copies created in the current context
+///
+/// Frame buffers are not shared between contexts: called
+/// before the objects of the current context are released.
+///
+////////////////////////////////////////////////////////////
+void releaseCopyFramebuffers();
+
+////////////////////////////////////////////////////////////
+/// \brief Get the OpenGL texture to sample when drawing a texture
+///
+/// This is the native handle of the texture, except for lazy
+/// textures whose upload was deferred by the per-frame budget:
+/// a shared transparent texture is sampled instead, so that
+/// they don't show until their pixels are uploaded.
+///
+/// \see Texture::setLazyUploadBudget
+///
+////////////////////////////////////////////////////////////
+unsigned int getSampledTexture(const Texture& texture);
+
+////////////////////////////////////////////////////////////
+/// \brief Bind the texture to sample to a texture unit
+///
+/// Binds getSampledTexture(texture) and, when sampler objects
+/// are supported, the sampler shared by the textures with the
+/// same smooth, repeat and mipmap settings.
+///
+/// \param unit    Index of the texture unit, starting at 0
+/// \param texture Texture to bind
+///
+////////////////////////////////////////////////////////////
+void bindSampledTexture(unsigned int unit, const Texture& texture);
+
+////////////////////////////////////////////////////////////
+/// \brief Tell whether a texture streams its mip levels
+///
+/// \see Texture::loadFromBundleLazily
+///
+////////////////////////////////////////////////////////////
+bool isTextureStreamed(const Texture& texture);
+
+////////////////////////////////////////////////////////////
+/// \brief Report the detail a draw displays a streamed texture with
+///
+/// The largest mip level requested by the draws of a frame is
+/// uploaded at the next frame, larger footprints first, within
+/// the lazy upload budget. It does nothing for textures that
+/// are not streamed.
+///
+/// \param texture        Texture being drawn
+/// \param texelsPerPixel Texels of the largest level covered by each screen pixel
+/// \param footprint      On-screen area of the draw, in pixels
+///
+////////////////////////////////////////////////////////////
+void requestTextureDetail(const Texture& texture, float texelsPerPixel, float footprint);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the dynamic atlas page that holds a copy of a texture
+///
+/// Small textures (see Texture::setDynamicAtlasThreshold) are
+/// copied to a shared page the first time this is called for
+/// them, and copied again whenever their pixels change, so
+/// that the render pipeline can batch them together.
+///
+/// \param texture Texture being drawn
+/// \param offset  Receives the position of the copy in the page, in pixels
+///
+/// \return Page texture, or NULL if the texture has no copy
+///
+////////////////////////////////////////////////////////////
+const Texture* getAtlasPage(const Texture& texture, Vector2f& offset);
+
+} // namespace priv
 
 ////////////////////////////////////////////////////////////
 /// \brief Image living on the graphics card that can be used for drawing
@@ -57,6 +152,29 @@ public:
         Pixels      ///< Texture coordinates in range [0 .. size]
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Storage formats of the pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Format
+    {
+        RGBA8,   ///< 8 bits per channel, red, green, blue and alpha (default)
+        R8,      ///< 8 bits of red only, for masks and distance fields
+        RGBA16F, ///< 16 bits floating point per channel, for high dynamic range rendering
+        RGB565,  ///< 16 bits per pixel, 5 bits of red, 6 of green and 5 of blue, for opaque backgrounds
+        RGBA4444 ///< 16 bits per pixel, 4 bits per channel
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called when an asynchronous load is finished
+    ///
+    /// \param texture  Texture that was loaded
+    /// \param success  True if the texture was loaded
+    /// \param userData User data given to loadFromMemoryAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void (*LoadCallback)(Texture& texture, bool success, void* userData);
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -75,6 +193,17 @@ public:
     ////////////////////////////////////////////////////////////
     Texture(const Texture& copy);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The OpenGL texture is taken over from \a right, which
+    /// is left empty. No pixel is copied.
+    ///
+    /// \param right Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    Texture(Texture&& right) noexcept;
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -94,10 +223,37 @@ public:
     ////////////////////////////////////////////////////////////
     bool create(unsigned int width, unsigned int height);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture with a given storage format
+    ///
+    /// R8 textures are drawn by the built-in shaders as white
+    /// with the red channel as alpha (see isSingleChannel), and
+    /// the pixels given to update keep only their red channel.
+    /// RGBA16F textures store values outside [0 .. 1], which
+    /// makes them suitable to accumulate light in a RenderTexture;
+    /// they are clamped to 8 bits when copied to an image.
+    /// RGB565 and RGBA4444 textures halve the memory of RGBA8
+    /// ones; the RGBA8 pixels given to update are dithered down
+    /// to 16 bits, images of the same format are uploaded as is.
+    ///
+    /// If the format is not supported (see isFormatAvailable),
+    /// or if this function fails, the texture is left unchanged.
+    ///
+    /// \param width  Width of the texture
+    /// \param height Height of the texture
+    /// \param format Storage format of the pixels
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, Format format);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the texture from a file in memory
     ///
-    /// This function is a shortcut for the following code:
+    /// This function is equivalent to the following code,
+    /// but it uploads the decoded pixels without copying them
+    /// into an intermediate image:
     /// \code
     /// sf::Image image;
     /// image.loadFromMemory(data, size);
@@ -129,7 +285,9 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Load the texture from a custom stream
     ///
-    /// This function is a shortcut for the following code:
+    /// This function is equivalent to the following code,
+    /// but it uploads the decoded pixels without copying them
+    /// into an intermediate image:
     /// \code
     /// sf::Image image;
     /// image.loadFromStream(stream);
@@ -157,6 +315,35 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromStream(InputStream& stream, const IntRect& area = IntRect());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a file in memory, without blocking
+    ///
+    /// In the browser, the file is decoded by createImageBitmap,
+    /// with the native decoders of the browser and off the main
+    /// thread, and the bitmap is uploaded with texImage2D when it
+    /// is ready: the callback is then called from the browser
+    /// event loop, a few frames later. This is several times
+    /// faster than decoding with stb_image in WebAssembly.
+    ///
+    /// Elsewhere, or if the browser can't decode the file, the
+    /// file is loaded with loadFromMemory, and the callback is
+    /// called before this function returns (or, for the browser
+    /// fallback, when the decode fails).
+    ///
+    /// The texture must stay alive and unused, and \a data
+    /// valid, until the callback is called. The alpha
+    /// premultiplication setting is applied by the decoder.
+    ///
+    /// \param data     Pointer to the file data in memory
+    /// \param size     Size of the data to load, in bytes
+    /// \param callback Function called when the load is finished
+    /// \param userData User data passed to the callback
+    ///
+    /// \see loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    void loadFromMemoryAsync(const void* data, std::size_t size, LoadCallback callback, void* userData = NULL);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the texture from an image
     ///
@@ -166,6 +353,10 @@ public:
     /// If the \a area rectangle crosses the bounds of the image, it
     /// is adjusted to fit the image size.
     ///
+    /// Images converted to RGB565, RGBA4444 or R8 (see Image::convert)
+    /// are loaded into a texture of the same format, so that they
+    /// take the same reduced memory on the graphics card.
+    ///
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
@@ -181,6 +372,189 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromImage(const Image& image, const IntRect& area = IntRect());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a view of pixels
+    ///
+    /// The rows of the view don't have to be contiguous: a
+    /// rectangle of a larger image is uploaded without being
+    /// copied first, when the driver supports it.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param source View of the pixels to load into the texture
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see ImageView
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImage(const ImageView& source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from an image and its precomputed mip chain
+    ///
+    /// Unlike generateMipmap, the levels are computed on the CPU
+    /// beforehand (see Image::generateMipChain), so the upload
+    /// doesn't stall the GPU and works for any texture size,
+    /// including on OpenGL ES 2 drivers that can't generate
+    /// mipmaps for non-power-of-two textures.
+    ///
+    /// \a levels must contain the levels below \a image, each one
+    /// half the size of the previous one (rounding down, never
+    /// below 1). The chain may stop before 1x1.
+    ///
+    /// If the texture is sRGB, the levels should have been
+    /// generated with the sRGB option of Image::generateMipChain.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param image  Image to load into the base level of the texture
+    /// \param levels Mip levels to load below the base level
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromImage, generateMipmap, Image::generateMipChain
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImageWithMips(const Image& image, const std::vector<Image>& levels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a compressed KTX, KTX2 or DDS file in memory
+    ///
+    /// The blocks are uploaded as is with glCompressedTexImage2D,
+    /// with their mip chain if the file has one, so the texture
+    /// uses 4 to 8 times less video memory than with
+    /// loadFromMemory. Supported formats are S3TC (BC1 to BC3,
+    /// also known as DXT1 to DXT5), ETC1, ETC2/EAC and ASTC.
+    ///
+    /// When the driver doesn't support the format of the file,
+    /// the first level is decompressed on the CPU and uploaded
+    /// uncompressed instead (mipmaps are then generated if the
+    /// file had some). ASTC and ETC2 punch-through alpha can't
+    /// be decompressed on the CPU.
+    ///
+    /// The sRGB setting of the texture follows the format of
+    /// the file. Compressed textures can't be modified with the
+    /// update functions.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadCompressedFromMemory(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from an entry of an asset bundle
+    ///
+    /// The texels were baked in their final format, with their
+    /// mip chain, so they are uploaded straight from the bundle
+    /// (from the mapping of its file, when it is mapped) without
+    /// any decoding or copy. Compressed entries follow the rules
+    /// of loadCompressedFromMemory, including the decompression
+    /// on drivers that lack their format. Single channel entries
+    /// are expanded to RGBA when R8 is not supported.
+    ///
+    /// The sRGB setting of the texture follows the entry, and
+    /// the texels are uploaded as they were baked: alpha
+    /// premultiplication, if wanted, must be done before baking.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param bundle Bundle containing the texture
+    /// \param name   Name of the texture entry
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see AssetBundle, AssetBundleWriter
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromBundle(const AssetBundle& bundle, const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from an image, on its first draw
+    ///
+    /// The texture keeps a copy of the image, and only creates
+    /// its OpenGL storage the first time it is drawn, within
+    /// the per-frame budget set with setLazyUploadBudget. Until
+    /// then, getSize already returns the size of the image and
+    /// getMemoryUsage returns 0. Functions that read or modify
+    /// the pixels (update, copyToImage, generateMipmap...)
+    /// upload them first, regardless of the budget.
+    ///
+    /// The current contents of the texture are released.
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param image Image to upload to the texture
+    ///
+    /// \return True if the image is valid
+    ///
+    /// \see loadFromBundleLazily, evict, isResident
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImageLazily(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from an asset bundle, on its first draw
+    ///
+    /// This is the lazy version of loadFromBundle, it works like
+    /// loadFromImageLazily. The texture only remembers the entry,
+    /// so the bundle must stay open as long as the texture may
+    /// be uploaded.
+    ///
+    /// When \a streamed is true and the entry has a mip chain,
+    /// the first draw only uploads a small level (at most 64
+    /// pixels wide and high) as a placeholder. The sprites that
+    /// are drawn with more detail request the larger levels,
+    /// which are uploaded at the next frames, the sprites that
+    /// cover the most pixels on screen first. Thumbnails thus
+    /// never load the full resolution. The size of the texture
+    /// is always the one of the largest level.
+    ///
+    /// \param bundle   Bundle containing the texture
+    /// \param name     Name of the texture entry
+    /// \param streamed True to upload the levels according to their on-screen size
+    ///
+    /// \return True if the entry is a valid texture
+    ///
+    /// \see loadFromImageLazily, evict, isResident
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromBundleLazily(const AssetBundle& bundle, const std::string& name, bool streamed = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the video memory of a lazy texture
+    ///
+    /// The texture keeps its source (image or bundle entry),
+    /// and is uploaded again the next time it is drawn. This is
+    /// meant for the callback of GpuMemory::setBudget, with the
+    /// textures that haven't been drawn for a while (see
+    /// getLastUsedFrame). Changes made to the pixels since the
+    /// texture was loaded are lost.
+    ///
+    /// \return True if the texture was lazy and resident
+    ///
+    /// \see loadFromImageLazily, isResident
+    ///
+    ////////////////////////////////////////////////////////////
+    bool evict();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the pixels of the texture are in video memory
+    ///
+    /// Only lazy textures can be non-resident, while they wait
+    /// for their first draw or after they were evicted.
+    ///
+    /// \return True if the texture has an OpenGL storage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isResident() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the texture
     ///
@@ -244,6 +618,51 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture without waiting for the transfer
+    ///
+    /// The pixels are copied into a mapped pixel buffer object,
+    /// and the texture is updated from that buffer by the GPU,
+    /// so the call returns as soon as the copy is done instead
+    /// of waiting for the driver to consume the client memory.
+    /// \a pixels can be released right after the call.
+    ///
+    /// The drawings issued after this call see the new pixels.
+    /// The returned token tells when the transfer has actually
+    /// completed on the GPU, see isUploadComplete.
+    ///
+    /// Pixel buffers and sync objects need GL 3.2 or GLES 3.0.
+    /// On older contexts and WebGL, this function is the same as
+    /// update and returns 0, a token that is always complete.
+    ///
+    /// \param pixels Array of pixels to copy to the texture
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the texture where to copy the source pixels
+    /// \param y      Y offset in the texture where to copy the source pixels
+    ///
+    /// \return Token identifying the transfer
+    ///
+    /// \see update, isUploadComplete
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 updateAsync(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether an asynchronous update has completed on the GPU
+    ///
+    /// This function never blocks. Transfers complete in the
+    /// order they were issued.
+    ///
+    /// \param token Token returned by updateAsync
+    ///
+    /// \return True if the transfer has completed
+    ///
+    /// \see updateAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isUploadComplete(Uint64 token);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update a part of this texture from another texture
     ///
@@ -318,6 +737,23 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Image& image, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from a view of pixels
+    ///
+    /// No additional check is performed on the size of the view,
+    /// passing an invalid combination of view size and offset
+    /// will lead to an undefined behavior.
+    ///
+    /// This function does nothing if the texture was not
+    /// previously created.
+    ///
+    /// \param source View of the pixels to copy to the texture
+    /// \param x      X offset in the texture where to copy the source view
+    /// \param y      Y offset in the texture where to copy the source view
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const ImageView& source, unsigned int x, unsigned int y);
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable the smooth filter
     ///
@@ -379,6 +815,41 @@ public:
     ////////////////////////////////////////////////////////////
     bool isSrgb() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable alpha premultiplication at load time
+    ///
+    /// When enabled, the color components of the pixels loaded
+    /// with loadFromMemory, loadFromStream and loadFromImage are
+    /// multiplied by their alpha before being uploaded. Filtering
+    /// premultiplied pixels doesn't bleed the color of transparent
+    /// texels into their neighbors, so textures and atlases need
+    /// no color padding around their sprites.
+    ///
+    /// A premultiplied texture must be drawn with the
+    /// sf::BlendPremultipliedAlpha blend mode, and with vertex
+    /// colors whose components are premultiplied as well.
+    ///
+    /// After enabling or disabling premultiplication, make sure
+    /// to reload the texture data in order for the setting to
+    /// take effect. The setting is disabled by default.
+    ///
+    /// \param premultiplied True to premultiply the loaded pixels
+    ///
+    /// \see isPremultipliedAlpha
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPremultipliedAlpha(bool premultiplied);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the loaded pixels are premultiplied by their alpha
+    ///
+    /// \return True if the loaded pixels are premultiplied, false if not
+    ///
+    /// \see setPremultipliedAlpha
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPremultipliedAlpha() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable repeating
     ///
@@ -433,6 +904,78 @@ public:
     ////////////////////////////////////////////////////////////
     bool isAttachedToFBO() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the texture holds signed distance fields
+    ///
+    /// This is the case of the glyph pages of a font with
+    /// distance field glyphs; the render pipeline thresholds
+    /// the alpha channel of such textures instead of blending it.
+    ///
+    /// \return True if the alpha channel stores distances
+    ///
+    /// \see Font::setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDistanceField() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the texture stores a single channel
+    ///
+    /// Font pages store the coverage of the glyphs in the red
+    /// channel of a GL_R8 texture when the driver supports it.
+    /// The render pipeline reads such textures as white with
+    /// the red channel as alpha; custom shaders drawing them
+    /// must do the same.
+    ///
+    /// \return True if the texture has a single (red) channel
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSingleChannel() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether all the texels are known to be opaque
+    ///
+    /// The pixels uploaded from the CPU (loadFromImage, update
+    /// with pixels or an image) are scanned for their alpha.
+    /// Textures whose contents come from the GPU, like the
+    /// texture of a render-texture, or from compressed data,
+    /// are never considered opaque.
+    ///
+    /// Opaque textures are drawn in the depth pre-pass of the
+    /// render targets that enable it.
+    ///
+    /// \return True if the alpha of every texel is 255
+    ///
+    /// \see RenderTarget::setDepthPrePassEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isOpaque() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the storage format of the pixels
+    ///
+    /// \return Format of the texture
+    ///
+    /// \see create(unsigned int, unsigned int, Format)
+    ///
+    ////////////////////////////////////////////////////////////
+    Format getFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the type of the texture coordinates drawn with the texture
+    ///
+    /// The vertices drawn with a texture normally give their
+    /// texture coordinates in range [0 .. 1]. Font pages are
+    /// drawn with coordinates in pixels instead, so that the
+    /// geometry of the texts stays valid when a page grows;
+    /// the render pipeline divides them by the size of the
+    /// texture, custom shaders drawing them must do the same.
+    ///
+    /// \return Type of the texture coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    CoordinateType getCoordinateType() const;
+
 
     ////////////////////////////////////////////////////////////
     /// \brief Generate a mipmap using the current texture data
@@ -469,6 +1012,20 @@ public:
     ////////////////////////////////////////////////////////////
     Texture& operator =(const Texture& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of move assignment operator
+    ///
+    /// The contents of the two textures are exchanged, the
+    /// previous texture of this instance is released when
+    /// \a right is destroyed.
+    ///
+    /// \param right Instance to move
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Texture& operator =(Texture&& right) noexcept;
+
     ////////////////////////////////////////////////////////////
     /// \brief Swap the contents of this texture with those of another
     ///
@@ -489,6 +1046,60 @@ public:
     ////////////////////////////////////////////////////////////
     unsigned int getNativeHandle() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the last frame the texture was drawn in
+    ///
+    /// Frames are counted by RenderTarget::resetFrameStats,
+    /// see GpuMemory::getCurrentFrame. Textures that were never
+    /// drawn return 0.
+    ///
+    /// \return Index of the last frame that used the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getLastUsedFrame() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the estimated video memory used by the texture
+    ///
+    /// \return Size of the texture storage, in bytes
+    ///
+    /// \see GpuMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getMemoryUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the identifier of the storage of the texture
+    ///
+    /// The identifier changes when the storage is created again
+    /// (create, loadFrom..., swap), which is when its size, its
+    /// format, and therefore the meaning of normalized texture
+    /// coordinates may change. Updating the pixels keeps it.
+    /// Caches of geometry built for the texture only need to
+    /// track this identifier.
+    ///
+    /// \return Unique identifier of the current storage
+    ///
+    /// \see getContentId
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getStorageId() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the identifier of the pixels of the texture
+    ///
+    /// The identifier changes with the storage, and each time
+    /// pixels are uploaded or copied to the texture. Rendering
+    /// to the texture through a sf::RenderTexture doesn't
+    /// change it.
+    ///
+    /// \return Unique identifier of the current contents
+    ///
+    /// \see getStorageId
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getContentId() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Bind a texture for rendering
     ///
@@ -534,11 +1145,113 @@ public:
     ////////////////////////////////////////////////////////////
     static unsigned int getMaximumSize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a storage format can be created and rendered to
+    ///
+    /// RGBA8 is always available. R8 needs OpenGL 3.0 (or
+    /// ARB_texture_rg), OpenGL ES 3.0 (or EXT_texture_rg).
+    /// RGBA16F needs OpenGL 3.0 (or ARB_texture_float), or on
+    /// OpenGL ES half-float textures (3.0 or OES_texture_half_float)
+    /// that are color-renderable (EXT_color_buffer_half_float
+    /// or EXT_color_buffer_float). RGB565 and RGBA4444 are
+    /// always available.
+    ///
+    /// \param format Format to check
+    ///
+    /// \return True if textures of this format are supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isFormatAvailable(Format format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Limit the bytes of lazy textures uploaded per frame
+    ///
+    /// When drawing lazy textures would upload more than this
+    /// amount in the current frame (see GpuMemory::getCurrentFrame),
+    /// the remaining ones are deferred to the next frames and
+    /// not drawn until then. The first upload of each frame is
+    /// always allowed, so that textures larger than the budget
+    /// still show up eventually.
+    ///
+    /// The budget is 0 (unlimited) by default. It is meant to
+    /// be used by the drawing thread only.
+    ///
+    /// \param bytesPerFrame Maximum bytes uploaded per frame (0 for no limit)
+    ///
+    /// \see loadFromImageLazily
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setLazyUploadBudget(Uint64 bytesPerFrame);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bytes of lazy textures uploaded per frame
+    ///
+    /// \return Maximum bytes uploaded per frame (0 for no limit)
+    ///
+    /// \see setLazyUploadBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getLazyUploadBudget();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size below which textures are drawn from a shared atlas
+    ///
+    /// When enabled, the batched draws of textures whose width
+    /// and height are both at most \a size are drawn from a copy
+    /// of the texture in a shared page (a texture atlas filled
+    /// on the graphics card), so that many small textures are
+    /// drawn with a single draw call instead of one per texture.
+    /// The copy is made at the first draw of the texture, and
+    /// made again after its pixels change.
+    ///
+    /// Only the textures that the copy represents exactly are
+    /// atlased: repeated, mipmapped, sRGB, single channel, distance
+    /// field, flipped (render-texture) and normalized-coordinate
+    /// textures are always drawn from their own storage, as are
+    /// the draws whose texture coordinates go outside the texture.
+    /// The border texels of smooth textures are filtered with the
+    /// transparent padding around their copy rather than clamped.
+    ///
+    /// The copies cost graphics memory on top of the textures
+    /// themselves (up to 8 pages of 1024x1024), and on OpenGL ES
+    /// every copy reads the texture back, so the atlas is best
+    /// suited to small textures that are rarely updated.
+    ///
+    /// The threshold is 0 (disabled) by default; setting it back
+    /// to 0 releases the pages. It is meant to be used by the
+    /// drawing thread only.
+    ///
+    /// \param size Maximum width and height of atlased textures, in pixels (0 to disable)
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setDynamicAtlasThreshold(unsigned int size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size below which textures are drawn from a shared atlas
+    ///
+    /// \return Maximum width and height of atlased textures, in pixels (0 if disabled)
+    ///
+    /// \see setDynamicAtlasThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getDynamicAtlasThreshold();
+
 private:
 
     friend class Text;
+    friend class Font;
+    friend class ContextRestore;
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class StreamingTexture;
+    friend class DrawReplay;
+    friend void priv::markTextureUsed(const Texture& texture);
+    friend void priv::resolveTexture(const Texture& texture);
+    friend unsigned int priv::getSampledTexture(const Texture& texture);
+    friend void priv::bindSampledTexture(unsigned int unit, const Texture& texture);
+    friend bool priv::isTextureStreamed(const Texture& texture);
+    friend void priv::requestTextureDetail(const Texture& texture, float texelsPerPixel, float footprint);
+    friend const Texture* priv::getAtlasPage(const Texture& texture, Vector2f& offset);
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -555,6 +1268,243 @@ private:
     ////////////////////////////////////////////////////////////
     static unsigned int getValidSize(unsigned int size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture storage in a given format
+    ///
+    /// Single channel storage is used by font pages; it falls
+    /// back to RGBA8 when R8 is not supported.
+    ///
+    /// \param width  Width of the texture
+    /// \param height Height of the texture
+    /// \param format Storage format of the pixels
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool createStorage(unsigned int width, unsigned int height, Format format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a view of RGBA pixels
+    ///
+    /// This is the implementation of loadFromImage, shared with
+    /// the functions that decode images straight to a texture.
+    /// The pixels are uploaded as they are (not premultiplied).
+    ///
+    /// \param source View of the pixels to load
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromPixels(const ImageView& source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from compressed blocks
+    ///
+    /// This is the implementation of loadCompressedFromMemory,
+    /// shared with loadFromBundle.
+    ///
+    /// \param image Format, size and levels of the blocks
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadCompressed(const priv::CompressedImage& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from the smaller levels of a bundle entry
+    ///
+    /// This is the implementation of loadFromBundle, shared with
+    /// the streamed textures.
+    ///
+    /// \param bundle     Bundle containing the texture
+    /// \param name       Name of the texture entry
+    /// \param firstLevel Index of the first mip level to load
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadBundleLevels(const AssetBundle& bundle, const std::string& name, unsigned int firstLevel);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load in progress, started by loadFromMemoryAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    struct AsyncLoad;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the storage of a texture decoded by the browser
+    ///
+    /// \param width    Width of the decoded image
+    /// \param height   Height of the decoded image
+    /// \param userData The AsyncLoad of the texture
+    ///
+    /// \return True if the storage was created and bound
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool prepareBrowserImage(unsigned int width, unsigned int height, void* userData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish a load started by loadFromMemoryAsync
+    ///
+    /// \param success  True if the browser uploaded the pixels
+    /// \param userData The AsyncLoad of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    static void finishBrowserImage(bool success, void* userData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Source of a lazy texture (image or bundle entry)
+    ///
+    ////////////////////////////////////////////////////////////
+    struct LazySource;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the source of a lazy texture if needed
+    ///
+    /// This function is const because drawing a texture calls
+    /// it; the contents don't change from the user's point of
+    /// view.
+    ///
+    /// \return False if the texture has no pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    bool ensureResident() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the levels of the lazy source from \a firstLevel
+    ///
+    /// \param firstLevel Index of the largest mip level to upload
+    ///
+    /// \return True if the upload was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool uploadLazySource(unsigned int firstLevel) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the levels requested by the draws of the last frame
+    ///
+    /// \see priv::requestTextureDetail
+    ///
+    ////////////////////////////////////////////////////////////
+    static void processStreamingRequests();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the source of a lazy texture
+    ///
+    /// Called by the functions that load new contents.
+    ///
+    ////////////////////////////////////////////////////////////
+    void discardLazySource();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the OpenGL storage and reset the size
+    ///
+    /// \param size New size of the texture (the one of a lazy source)
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseStorage(const Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the pixels of the storage, for a context restore
+    ///
+    /// Lazy textures keep their source instead, and the ones
+    /// attached to a render texture are not restored.
+    ///
+    /// \param data Receives the QOI-encoded pixels
+    ///
+    /// \return True if the texture has pixels to keep
+    ///
+    ////////////////////////////////////////////////////////////
+    bool retainPixels(std::vector<Uint8>& data) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recreate the storage after the context was lost
+    ///
+    /// The name of the lost texture is forgotten without being
+    /// deleted. Lazy textures only drop their storage, they are
+    /// uploaded again on their next draw.
+    ///
+    /// \param data Pixels kept by retainPixels (NULL to leave the contents undefined)
+    ///
+    /// \return True if the storage was recreated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool restoreStorage(const std::vector<Uint8>* data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the objects shared by all the textures
+    ///
+    /// The frame buffers of the copies and the placeholder of
+    /// the lazy textures belong to the lost context, so they
+    /// are not deleted.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void forgetSharedObjects();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a single channel texture
+    ///
+    /// \param pixels Array of one byte per pixel to copy to the texture
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the texture where to copy the source pixels
+    /// \param y      Y offset in the texture where to copy the source pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateSingleChannel(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a RGB565 or RGBA4444 texture
+    ///
+    /// \param pixels Array of 16-bit pixels in the format of the texture
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the texture where to copy the source pixels
+    /// \param y      Y offset in the texture where to copy the source pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void updatePacked(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from pixels of any image format
+    ///
+    /// Pixels in the format of the texture are uploaded as they
+    /// are, the others are expanded to RGBA8 and then go through
+    /// the conversions of update.
+    ///
+    /// \param pixels Array of pixels to copy to the texture
+    /// \param format Format of the pixels
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the texture where to copy the source pixels
+    /// \param y      Y offset in the texture where to copy the source pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void updatePixels(const Uint8* pixels, Image::PixelFormat format, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from an image of a reduced format
+    ///
+    /// \param image Image in the RGB565, RGBA4444 or R8 format
+    /// \param area  Area of the image to load
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromPackedImage(const Image& image, const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the whole texture with the contents of a pixel buffer
+    ///
+    /// The buffer holds RGBA8 pixels for the whole texture. It
+    /// is unbound from GL_PIXEL_UNPACK_BUFFER when the transfer
+    /// has been issued.
+    ///
+    /// \param buffer OpenGL identifier of the pixel unpack buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateFromPixelBuffer(unsigned int buffer);
+
     ////////////////////////////////////////////////////////////
     /// \brief Invalidate the mipmap if one exists
     ///
@@ -564,19 +1514,48 @@ private:
     ////////////////////////////////////////////////////////////
     void invalidateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the minifying function of the bound texture
+    ///
+    /// The filter follows the smooth and mipmap states, it is
+    /// only changed when it differs from the last one set.
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyMinFilter();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the size accounted in sf::GpuMemory
+    ///
+    /// \param bytes New size of the texture storage (0 when destroyed)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMemoryUsage(Uint64 bytes);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
     Vector2u     m_size;          ///< Public texture size
     Vector2u     m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
     unsigned int m_texture;       ///< Internal texture identifier
+    unsigned int m_storageFormat; ///< Internal format of the level 0 storage, if create can reuse it (0 otherwise)
     bool         m_isSmooth;      ///< Status of the smooth filter
     bool         m_sRgb;          ///< Should the texture source be converted from sRGB?
+    bool         m_premultiplied; ///< Should the loaded pixels be premultiplied by their alpha?
     bool         m_isRepeated;    ///< Is the texture in repeat mode?
     mutable bool m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
     bool         m_fboAttachment; ///< Is this texture owned by a framebuffer object?
     bool         m_hasMipmap;     ///< Has the mipmap been generated?
-    Uint64       m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    int          m_minFilter;     ///< Minifying function last set to the texture (0 if unknown)
+    bool         m_distanceField; ///< Does the alpha channel store signed distances?
+    bool         m_opaque;        ///< Are all the texels known to have an alpha of 255?
+    Format       m_format;        ///< Storage format of the pixels
+    CoordinateType m_texCoordType; ///< Type of the texture coordinates of the vertices drawn with the texture
+    Uint64       m_storageId;     ///< Unique number that identifies the storage of the texture (size and format)
+    Uint64       m_contentId;     ///< Unique number that identifies the pixels of the texture
+    Uint64       m_memoryUsage;   ///< Estimated size of the texture storage, in bytes
+    mutable Uint64 m_lastUsedFrame; ///< Last frame the texture was drawn in
+    mutable priv::RenderTextureImpl* m_resolver; ///< Render-texture whose pixels must be resolved to the texture before it is used
+    mutable LazySource* m_lazySource; ///< Source uploaded on the first draw, for lazy textures
 };
 
 } // namespace sf
@@ -670,6 +1649,20 @@ private:
 ///
 /// \endcode
 ///
+/// Textures that may never be shown (inventory icons, localized
+/// art...) can be loaded lazily: loadFromImageLazily and
+/// loadFromBundleLazily only keep the source, which is uploaded
+/// the first time the texture is drawn. setLazyUploadBudget
+/// spreads these uploads over several frames, and evict
+/// releases the video memory of the textures that went cold.
+/// \code
+/// // Upload at most 4 MB of lazy textures per frame
+/// sf::Texture::setLazyUploadBudget(4 * 1024 * 1024);
+///
+/// sf::Texture icon;
+/// icon.loadFromBundleLazily(bundle, "icons/sword");
+/// \endcode
+///
 /// Like sf::Shader that can be used as a raw OpenGL shader,
 /// sf::Texture can also be used directly as a raw texture for
 /// custom OpenGL geometry.
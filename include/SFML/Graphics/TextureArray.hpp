@@ -0,0 +1,275 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTUREARRAY_HPP
+#define SFML_TEXTUREARRAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Vertex drawn with a texture array
+///
+/// Same as sf::Vertex, with the index of the layer of the
+/// texture array to sample. The texture coordinates are
+/// normalized (0 to 1).
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API LayeredVertex
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    LayeredVertex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position, color, texture coordinates and layer
+    ///
+    /// \param thePosition  Vertex position
+    /// \param theColor     Vertex color
+    /// \param theTexCoords Vertex texture coordinates (normalized)
+    /// \param theLayer     Layer of the texture array
+    ///
+    ////////////////////////////////////////////////////////////
+    LayeredVertex(const Vector2f& thePosition, const Color& theColor, const Vector2f& theTexCoords, unsigned int theLayer);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2f  position;  ///< 2D position of the vertex
+    Color     color;     ///< Color of the vertex
+    Vector2f  texCoords; ///< Normalized coordinates of the texture's pixel to map to the vertex
+    float     layer;     ///< Layer of the texture array to map to the vertex
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Array of 2D textures of the same size, sampled as one
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureArray : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty texture array.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture array
+    ///
+    /// The storage of all the layers (and of their mipmaps,
+    /// if requested) is allocated at once, and can't be
+    /// resized afterwards; call create again to change it.
+    /// The contents of the layers are undefined.
+    ///
+    /// If this function fails, the texture array is left unchanged.
+    ///
+    /// \param width   Width of the layers, in pixels
+    /// \param height  Height of the layers, in pixels
+    /// \param layers  Number of layers
+    /// \param mipmaps True to allocate the mipmap levels (see generateMipmap)
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int layers, bool mipmaps = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a whole layer from an array of pixels
+    ///
+    /// The \a pixels array must contain width * height RGBA
+    /// pixels, the size of the layers.
+    ///
+    /// \param pixels Array of pixels to copy to the layer
+    /// \param layer  Index of the layer to update
+    ///
+    /// \return True if the layer was updated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint8* pixels, unsigned int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a whole layer from an image
+    ///
+    /// The image must have the size of the layers.
+    ///
+    /// \param image Image to copy to the layer
+    /// \param layer Index of the layer to update
+    ///
+    /// \return True if the layer was updated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Image& image, unsigned int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the mipmap levels of all the layers
+    ///
+    /// The texture array must have been created with mipmaps.
+    /// Call this function again after updating the layers.
+    ///
+    /// \return True if the mipmaps were generated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool generateMipmap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the layers
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of layers
+    ///
+    /// \return Number of layers
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getLayerCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the texture array
+    ///
+    /// \return OpenGL handle of the texture array or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the system supports texture arrays
+    ///
+    /// Texture arrays need OpenGL 3.0 (or EXT_texture_array),
+    /// OpenGL ES 3 or WebGL 2.
+    ///
+    /// \return True if texture arrays are supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the filter to the bound texture array
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyFilter();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u     m_size;        ///< Size of the layers
+    unsigned int m_layerCount;  ///< Number of layers
+    unsigned int m_levelCount;  ///< Number of mipmap levels, including the base level
+    unsigned int m_texture;     ///< Internal texture identifier
+    bool         m_isSmooth;    ///< Status of the smooth filter
+    Uint64       m_memoryUsage; ///< Estimated size of the storage, in bytes
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREARRAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureArray
+/// \ingroup graphics
+///
+/// sf::TextureArray holds several layers of the same size in
+/// a single OpenGL texture (GL_TEXTURE_2D_ARRAY). Geometry
+/// drawn with it picks its layer per vertex, so sprites that
+/// use different images are drawn in one call, without the
+/// batch breaks caused by texture changes. Unlike an atlas,
+/// each layer keeps its own edges for filtering and repeat.
+///
+/// The storage is immutable (glTexStorage3D) when the driver
+/// supports it, which lets the driver skip the completeness
+/// checks of mutable textures.
+///
+/// Texture arrays are drawn with sf::LayeredVertex and the
+/// corresponding overload of RenderTarget::draw. A custom
+/// shader can be used for these draws; its attributes are
+/// bound in the order of the members of sf::LayeredVertex
+/// (position, color, texCoords, layer).
+///
+/// Usage example:
+/// \code
+/// sf::TextureArray cards;
+/// cards.create(128, 192, 52);
+/// for (unsigned int i = 0; i < 52; ++i)
+///     cards.update(images[i], i);
+///
+/// std::vector<sf::LayeredVertex> vertices;
+/// // ... 6 vertices per card, with the layer of its image
+///
+/// window.draw(&vertices[0], vertices.size(), sf::Triangles, cards);
+/// \endcode
+///
+/// \see sf::Texture, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
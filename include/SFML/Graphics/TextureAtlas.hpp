@@ -0,0 +1,288 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREATLAS_HPP
+#define SFML_TEXTUREATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/SkylinePacker.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <deque>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+class InputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Packs many small images into a few large textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureAtlas : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of an image packed into the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::size_t Handle;
+
+    static const Handle InvalidHandle; ///< Handle returned when an image can't be packed
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Location of a packed image
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Region
+    {
+        Region();
+
+        const Texture*        texture;   ///< Page texture containing the image (NULL if invalid)
+        IntRect               rect;      ///< Area of the image in the page texture, in pixels
+        FloatRect             texCoords; ///< Area of the image in the page texture, normalized
+        std::vector<Vector2f> mesh;      ///< Convex outline of the visible pixels, relative to \a rect (empty to draw the whole rect)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param pageSize Width and height of the page textures,
+    ///                 clamped to Texture::getMaximumSize()
+    /// \param padding  Transparent pixels kept around each image,
+    ///                 to prevent bleeding when smoothing is enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextureAtlas(unsigned int pageSize = 1024, unsigned int padding = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pack an image into the atlas
+    ///
+    /// A new page is created when the image doesn't fit into
+    /// the existing ones.
+    ///
+    /// \param image Image to pack
+    ///
+    /// \return Handle of the packed image, or InvalidHandle if
+    ///         the image is bigger than a page
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle add(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode an image from memory and pack it into the atlas
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return Handle of the packed image, or InvalidHandle on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle addFromMemory(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode an image from a stream and pack it into the atlas
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return Handle of the packed image, or InvalidHandle on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle addFromStream(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the location of a packed image
+    ///
+    /// The page textures never move nor change size, so the
+    /// returned region stays valid as long as the atlas exists.
+    ///
+    /// \param handle Handle returned by add
+    ///
+    /// \return Region of the image, with a NULL texture if
+    ///         \a handle is invalid
+    ///
+    ////////////////////////////////////////////////////////////
+    Region getRegion(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of packed images
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getRegionCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of page textures
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a page texture
+    ///
+    /// \param index Index of the page, in [0, getPageCount())
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getPage(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter on all the pages
+    ///
+    /// Pages created later inherit this setting.
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of vertices of the meshes of the images
+    ///
+    /// When the budget is at least 3, each image added later
+    /// gets a convex outline of its visible (non fully
+    /// transparent) pixels, with at most \a maxVertices
+    /// vertices. Sprites built from its region draw this
+    /// tight mesh instead of the whole rectangle, which saves
+    /// the fill rate of the transparent pixels. Images whose
+    /// outline would cover nearly all their rectangle keep
+    /// the plain quad.
+    ///
+    /// The budget is 0 by default, i.e. no mesh is computed.
+    ///
+    /// \param maxVertices Maximum number of vertices of a mesh, 0 to disable meshes
+    ///
+    /// \see getMeshVertexBudget, Sprite::setMesh
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMeshVertexBudget(std::size_t maxVertices);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of vertices of the meshes of the images
+    ///
+    /// \return Maximum number of vertices of a mesh, 0 if meshes are disabled
+    ///
+    /// \see setMeshVertexBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMeshVertexBudget() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the images and destroy the pages
+    ///
+    /// All the handles and regions become invalid.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Page texture and its skyline
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Page
+    {
+        Texture             texture; ///< Texture containing the packed images
+        priv::SkylinePacker packer;  ///< Free area of the texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Packed image
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        std::size_t           page; ///< Index of the page containing the image
+        IntRect               rect; ///< Area of the image in the page, in pixels
+        std::vector<Vector2f> mesh; ///< Outline of the visible pixels, relative to rect
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a page texture
+    ///
+    /// \return True if the texture was created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addPage();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int       m_pageSize;   ///< Width and height of the pages
+    unsigned int       m_padding;    ///< Pixels kept between two images
+    bool               m_isSmooth;   ///< Smooth filter of the pages
+    std::size_t        m_meshBudget; ///< Maximum number of vertices of the meshes (0 to disable them)
+    std::deque<Page>   m_pages;      ///< Pages (a deque, so that the textures never move)
+    std::vector<Entry> m_entries;    ///< Packed images, indexed by handle
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREATLAS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureAtlas
+/// \ingroup graphics
+///
+/// Every texture switch breaks the batching of the render
+/// pipeline, so drawing hundreds of sprites that each use
+/// their own small texture costs hundreds of draw calls.
+/// sf::TextureAtlas packs the images into a few large page
+/// textures instead, with a skyline bottom-left packer: as
+/// long as the sprites share a page, they share a batch.
+///
+/// Each packed image is identified by a handle, whose region
+/// gives the page texture and the area of the image in it,
+/// both in pixels and normalized. A sprite can be built
+/// directly from a region.
+///
+/// Sprites with large transparent areas can also get a tight
+/// convex mesh (see setMeshVertexBudget): a few more vertices,
+/// but much fewer transparent pixels to shade and blend.
+///
+/// Pages have a fixed size and are never resized, which keeps
+/// the regions (and the sprites built from them) valid until
+/// the atlas is cleared or destroyed.
+///
+/// Usage example:
+/// \code
+/// sf::TextureAtlas atlas;
+/// sf::TextureAtlas::Handle player = atlas.addFromMemory(playerData, playerSize);
+/// sf::TextureAtlas::Handle enemy  = atlas.addFromMemory(enemyData, enemySize);
+///
+/// sf::Sprite playerSprite(atlas.getRegion(player));
+/// sf::Sprite enemySprite(atlas.getRegion(enemy));
+/// \endcode
+///
+/// \see sf::Texture, sf::Sprite
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTUREPOOL_HPP
+#define SFML_TEXTUREPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Recycler of the OpenGL storage of destroyed textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TexturePool
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of textures kept in the pool
+    ///
+    /// The pool is disabled by default (capacity of 0). When
+    /// the capacity is reduced, the oldest textures of the
+    /// pool are destroyed, so an OpenGL context must be active.
+    ///
+    /// \param capacity Maximum number of pooled textures (0 to disable the pool)
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCapacity(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of textures kept in the pool
+    ///
+    /// \return Maximum number of pooled textures (0 if disabled)
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getCapacity();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of textures currently in the pool
+    ///
+    /// \return Number of pooled textures
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getCount();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy all the textures of the pool
+    ///
+    /// An OpenGL context must be active. The capacity is
+    /// left unchanged.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clear();
+};
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Take a texture with a matching storage out of the pool
+///
+/// \param size   Size of the level 0 storage (padding included)
+/// \param format Internal format of the level 0 storage
+///
+/// \return OpenGL name of the texture, or 0 if none matches
+///
+////////////////////////////////////////////////////////////
+unsigned int acquirePooledTexture(const Vector2u& size, unsigned int format);
+
+////////////////////////////////////////////////////////////
+/// \brief Give the texture of a destroyed sf::Texture to the pool
+///
+/// \param texture OpenGL name of the texture
+/// \param size    Size of the level 0 storage (padding included)
+/// \param format  Internal format of the level 0 storage
+///
+/// \return True if the pool took the texture, false if the caller must delete it
+///
+////////////////////////////////////////////////////////////
+bool releasePooledTexture(unsigned int texture, const Vector2u& size, unsigned int format);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TexturePool
+/// \ingroup graphics
+///
+/// Creating a texture allocates its storage with glTexImage2D
+/// and destroying it calls glDeleteTextures, both of which
+/// are expensive on some drivers, mobile ones in particular.
+/// Applications that create many short-lived textures of the
+/// same sizes (thumbnails, popups, render textures) can
+/// enable sf::TexturePool: the storage of destroyed textures
+/// is then kept, and handed back to the next texture created
+/// with the same internal size and format, without any
+/// reallocation.
+///
+/// The storage is matched on the padded size, the sRGB
+/// setting and the single channel format; compressed
+/// textures are never pooled. Pooled textures are accounted
+/// in the GpuMemory::Textures category.
+///
+/// Usage example:
+/// \code
+/// sf::TexturePool::setCapacity(16);
+///
+/// for (std::size_t i = 0; i < files.size(); ++i)
+/// {
+///     sf::Texture thumbnail; // Reuses the storage of the previous one
+///     thumbnail.loadFromMemory(files[i].data, files[i].size);
+///     ...
+/// }
+///
+/// sf::TexturePool::clear();
+/// \endcode
+///
+/// \see sf::Texture, sf::GpuMemory
+///
+////////////////////////////////////////////////////////////
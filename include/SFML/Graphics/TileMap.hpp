@@ -0,0 +1,268 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TILEMAP_HPP
+#define SFML_TILEMAP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Grid of tiles from an atlas, stored in static
+///        vertex buffers
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TileMap : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty tile map.
+    ///
+    ////////////////////////////////////////////////////////////
+    TileMap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the grid of tiles
+    ///
+    /// The map is split into square chunks of \a chunkSize tiles,
+    /// each stored in its own static vertex buffer. All the tiles
+    /// are initially empty.
+    ///
+    /// If this function fails, the tile map is left empty.
+    ///
+    /// \param mapSize   Number of tiles of the map, horizontally and vertically
+    /// \param tileSize  Size of a tile, in pixels (both in the atlas and in local coordinates)
+    /// \param chunkSize Width and height of the chunks, in tiles
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(const Vector2u& mapSize, const Vector2u& tileSize, unsigned int chunkSize = 32);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the atlas that the tiles are taken from
+    ///
+    /// The tiles of the atlas are numbered from left to right,
+    /// then from top to bottom, starting at 0. All the chunks
+    /// are rebuilt, which is expensive; the texture is meant to
+    /// be set once.
+    ///
+    /// The texture must exist as long as the tile map uses it.
+    ///
+    /// \param texture Atlas of tiles
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the atlas that the tiles are taken from
+    ///
+    /// \return Pointer to the atlas, or NULL if no texture was set
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a single tile
+    ///
+    /// Only the 6 vertices of the tile are modified and uploaded,
+    /// at the next draw; edits of neighbouring tiles are merged
+    /// into ranges uploaded at once.
+    ///
+    /// \param x    Column of the tile, in range [0 .. getMapSize().x - 1]
+    /// \param y    Row of the tile, in range [0 .. getMapSize().y - 1]
+    /// \param tile Index of the tile in the atlas, or -1 for no tile
+    ///
+    /// \see getTile, setTiles
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTile(unsigned int x, unsigned int y, int tile);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change all the tiles at once
+    ///
+    /// \param tiles Array of getMapSize().x * getMapSize().y indices, row by row (-1 for no tile)
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTiles(const int* tiles);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a tile
+    ///
+    /// \param x Column of the tile, in range [0 .. getMapSize().x - 1]
+    /// \param y Row of the tile, in range [0 .. getMapSize().y - 1]
+    ///
+    /// \return Index of the tile in the atlas, or -1 if there is no tile
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    int getTile(unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of tiles of the map
+    ///
+    /// \return Number of columns and rows
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getMapSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a tile
+    ///
+    /// \return Size of a tile, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getTileSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the chunks
+    ///
+    /// \return Width and height of the chunks, in tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getChunkSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the map
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the map
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible chunks to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the map
+    ///
+    /// \param bounds Receives the global bounds of the map
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the vertices of a tile into its chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateTile(unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<int>          m_tiles;      ///< Index of each tile in the atlas, row by row
+    std::vector<VertexBuffer> m_chunks;     ///< Vertex buffer of each chunk, row by row
+    Vector2u                  m_mapSize;    ///< Number of tiles of the map
+    Vector2u                  m_tileSize;   ///< Size of a tile
+    unsigned int              m_chunkSize;  ///< Width and height of the chunks, in tiles
+    Vector2u                  m_chunkCount; ///< Number of chunks, horizontally and vertically
+    const Texture*            m_texture;    ///< Atlas of tiles
+};
+
+} // namespace sf
+
+
+#endif // SFML_TILEMAP_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TileMap
+/// \ingroup graphics
+///
+/// sf::TileMap displays a grid of tiles taken from a single
+/// texture atlas. Unlike a sf::VertexArray, which streams
+/// all its vertices to the graphics card each time it is
+/// drawn, the tiles are stored in graphics memory: the map is
+/// split into chunks, each one baked into a static
+/// sf::VertexBuffer. Drawing the map only draws the chunks
+/// that intersect the current view, with one draw call each
+/// and no upload.
+///
+/// Editing a tile rewrites its vertices in a CPU-side copy of
+/// its chunk (see VertexBuffer::setShadowed); the modified
+/// ranges are uploaded right before the chunk is drawn again.
+///
+/// Like the other vertex buffers, the chunks need an active
+/// OpenGL context when the map is created.
+///
+/// Usage example:
+/// \code
+/// sf::Texture atlas;
+/// atlas.loadFromFile("tiles.png");
+///
+/// sf::TileMap map;
+/// map.create(sf::Vector2u(1024, 1024), sf::Vector2u(16, 16));
+/// map.setTexture(atlas);
+/// map.setTiles(level.data());
+///
+/// // Later, a single tile changes
+/// map.setTile(10, 20, 7);
+///
+/// window.draw(map);
+/// \endcode
+///
+/// \see sf::VertexBuffer, sf::TiledTexture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TILEDTEXTURE_HPP
+#define SFML_TILEDTEXTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+class InputStream;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Image split into a grid of textures, for images
+///        bigger than the maximum texture size
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TiledTexture : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty tiled texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    TiledTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TiledTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the tiles from a file in memory
+    ///
+    /// The image is decoded once, each tile is uploaded from
+    /// the decoded pixels, which are released right after; no
+    /// intermediate sf::Image is created.
+    ///
+    /// If this function fails, the tiled texture is left empty.
+    ///
+    /// \param data     Pointer to the file data in memory
+    /// \param size     Size of the data to load, in bytes
+    /// \param tileSize Width and height of the tiles, clamped to Texture::getMaximumSize (0 to use the maximum)
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromStream, loadFromImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemory(const void* data, std::size_t size, unsigned int tileSize = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the tiles from a custom stream
+    ///
+    /// \param stream   Source stream to read from
+    /// \param tileSize Width and height of the tiles, clamped to Texture::getMaximumSize (0 to use the maximum)
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromMemory, loadFromImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromStream(InputStream& stream, unsigned int tileSize = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the tiles from an image
+    ///
+    /// \param image    Image to split into tiles
+    /// \param tileSize Width and height of the tiles, clamped to Texture::getMaximumSize (0 to use the maximum)
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromMemory, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImage(const Image& image, unsigned int tileSize = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the whole image, in pixels
+    ///
+    /// \return Size of the image
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the tiles, in pixels
+    ///
+    /// The tiles of the last column and of the last row can
+    /// be smaller.
+    ///
+    /// \return Width and height of the tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getTileSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter of the tiles
+    ///
+    /// Filtering doesn't sample across the tiles, so the
+    /// borders of the tiles may show when the image is
+    /// scaled with the smooth filter enabled.
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the entity
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the entity
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible tiles to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the tiled texture
+    ///
+    /// \param bounds Receives the global bounds of the tiled texture
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the tiles from an array of RGBA pixels
+    ///
+    /// \param pixels   Array of pixels of the whole image
+    /// \param size     Size of the image, in pixels
+    /// \param tileSize Requested size of the tiles
+    ///
+    /// \return True if all the tiles were created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromPixels(const Uint8* pixels, const Vector2u& size, unsigned int tileSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy all the tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    void cleanup();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Texture*> m_tiles;     ///< Textures of the tiles, row by row
+    Vector2u              m_size;      ///< Size of the whole image
+    Vector2u              m_tileCount; ///< Number of columns and rows of tiles
+    unsigned int          m_tileSize;  ///< Width and height of the tiles
+    bool                  m_isSmooth;  ///< Status of the smooth filter
+};
+
+} // namespace sf
+
+
+#endif // SFML_TILEDTEXTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TiledTexture
+/// \ingroup graphics
+///
+/// sf::TiledTexture displays images that are too big for a
+/// single sf::Texture, such as world maps. The image is split
+/// into a grid of square textures, and only the tiles that
+/// intersect the view of the render target are drawn.
+///
+/// Like sf::Sprite, it inherits the functions of
+/// sf::Transformable: position, rotation, scale, origin.
+///
+/// stb_image decodes whole images at once, so loading still
+/// needs the full RGBA pixels in memory for a moment; none
+/// are kept once the tiles are uploaded.
+///
+/// Usage example:
+/// \code
+/// sf::TiledTexture map;
+/// if (!map.loadFromMemory(data, size, 2048))
+///     return -1;
+///
+/// map.setPosition(-1000, -1000);
+/// window.draw(map);
+/// \endcode
+///
+/// \see sf::Texture, sf::Sprite
+///
+////////////////////////////////////////////////////////////
@@ -31,10 +31,13 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <cstddef>
 
 
 namespace sf
 {
+class Vertex;
+
 ////////////////////////////////////////////////////////////
 /// \brief Define a 3x3 transform matrix
 ///
@@ -54,6 +57,9 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Construct a transform from a 3x3 matrix
     ///
+    /// Transforms are affine, the last row of the matrix is
+    /// always (0, 0, 1): \a a20, \a a21 and \a a22 are ignored.
+    ///
     /// \param a00 Element (0, 0) of the matrix
     /// \param a01 Element (0, 1) of the matrix
     /// \param a02 Element (0, 2) of the matrix
@@ -70,21 +76,35 @@ public:
               float a20, float a21, float a22);
 
     ////////////////////////////////////////////////////////////
-    /// \brief Return the transform as a 4x4 matrix
+    /// \brief Expand the transform to a 4x4 matrix
     ///
-    /// This function returns a pointer to an array of 16 floats
-    /// containing the transform elements as a 4x4 matrix, which
-    /// is directly compatible with OpenGL functions.
+    /// This function fills an array of 16 floats with the
+    /// transform elements as a 4x4 matrix, which is directly
+    /// compatible with OpenGL functions.
     ///
     /// \code
     /// sf::Transform transform = ...;
-    /// glLoadMatrixf(transform.getMatrix());
+    /// float matrix[16];
+    /// transform.getMatrix(matrix);
+    /// glUniformMatrix4fv(location, 1, GL_FALSE, matrix);
     /// \endcode
     ///
-    /// \return Pointer to a 4x4 matrix
+    /// \param matrix Array of 16 floats to fill (column-major order)
+    ///
+    ////////////////////////////////////////////////////////////
+    void getMatrix(float* matrix) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the 2x3 part of the transform
+    ///
+    /// This function returns a pointer to the 6 floats stored
+    /// in the transform: the first two rows of its matrix, in
+    /// row-major order (a00, a01, a02, a10, a11, a12).
+    ///
+    /// \return Pointer to a 2x3 matrix
     ///
     ////////////////////////////////////////////////////////////
-    const float* getMatrix() const;
+    const float* getAffineMatrix() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Return the inverse of the transform
@@ -118,6 +138,41 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2f transformPoint(const Vector2f& point) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform the positions of an array of vertices
+    ///
+    /// Each vertex of \a input is copied to \a output with its
+    /// position transformed, in a single pass. This is the same
+    /// as calling transformPoint for each vertex, but SIMD
+    /// instructions are used when they are available (SSE, NEON
+    /// or WebAssembly SIMD).
+    ///
+    /// \a input and \a output may point to the same array,
+    /// otherwise they must not overlap.
+    ///
+    /// \param input  Vertices to transform
+    /// \param output Array receiving the transformed vertices
+    /// \param count  Number of vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformPoints(const Vertex* input, Vertex* output, std::size_t count) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform an array of 2D points
+    ///
+    /// This is the same as calling transformPoint for each
+    /// point, with the SIMD kernels of the vertex overload.
+    ///
+    /// \a input and \a output may point to the same array,
+    /// otherwise they must not overlap.
+    ///
+    /// \param input  Points to transform
+    /// \param output Array receiving the transformed points
+    /// \param count  Number of points
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformPoints(const Vector2f* input, Vector2f* output, std::size_t count) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Transform a rectangle
     ///
@@ -358,7 +413,7 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    float m_matrix[16]; ///< 4x4 matrix defining the transformation
+    float m_matrix[6]; ///< First two rows of the 3x3 matrix defining the transformation
 };
 
 ////////////////////////////////////////////////////////////
@@ -443,9 +498,14 @@ SFML_GRAPHICS_API bool operator !=(const Transform& left, const Transform& right
 /// \ingroup graphics
 ///
 /// A sf::Transform specifies how to translate, rotate, scale,
-/// shear, project, whatever things. In mathematical terms, it defines
+/// shear, whatever things. In mathematical terms, it defines
 /// how to transform a coordinate system into another.
 ///
+/// Only affine transforms are supported (the last row of the
+/// 3x3 matrix is always (0, 0, 1)), so that a transform fits in
+/// 6 floats and combining two of them is cheap; the full 4x4
+/// matrix expected by OpenGL is built on demand by getMatrix.
+///
 /// For example, if you apply a rotation transform to a sprite, the
 /// result will be a rotated sprite. And anything that is transformed
 /// by this rotation transform will be rotated the same way, according
@@ -0,0 +1,304 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TRANSFORMBUFFER_HPP
+#define SFML_TRANSFORMBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Position, rotation, scale and origin of many
+///        objects, stored as a structure of arrays
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TransformBuffer
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Components that can be accessed in bulk
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Component
+    {
+        PositionX, ///< X coordinate of the position
+        PositionY, ///< Y coordinate of the position
+        Rotation,  ///< Rotation, in degrees
+        ScaleX,    ///< Horizontal scale factor
+        ScaleY,    ///< Vertical scale factor
+        OriginX,   ///< X coordinate of the origin
+        OriginY,   ///< Y coordinate of the origin
+
+        ComponentCount ///< Keep last -- the total number of components
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty buffer.
+    ///
+    ////////////////////////////////////////////////////////////
+    TransformBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an object to the buffer
+    ///
+    /// \param position Position of the object
+    /// \param rotation Rotation of the object, in degrees
+    /// \param scale    Scale factors of the object
+    /// \param origin   Local origin of the object
+    ///
+    /// \return Index of the new object
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Vector2f& position, float rotation = 0.f, const Vector2f& scale = Vector2f(1.f, 1.f), const Vector2f& origin = Vector2f(0.f, 0.f));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the number of objects in the buffer
+    ///
+    /// New objects get the identity transform.
+    ///
+    /// \param count New number of objects
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve room for a number of objects
+    ///
+    /// \param count Number of objects
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the objects of the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of objects in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of an object
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(std::size_t index, const Vector2f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the rotation of an object, in degrees
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRotation(std::size_t index, float angle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the scale factors of an object
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScale(std::size_t index, const Vector2f& factors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the local origin of an object
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOrigin(std::size_t index, const Vector2f& origin);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of an object
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getPosition(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rotation of an object, in degrees
+    ///
+    ////////////////////////////////////////////////////////////
+    float getRotation(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the scale factors of an object
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getScale(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local origin of an object
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getOrigin(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get write access to a component of all the objects
+    ///
+    /// This is the fast path for simulations that update every
+    /// object each frame: the returned array holds getSize()
+    /// contiguous values and can be written in a tight loop.
+    /// All the transforms are recomputed on next access. The
+    /// pointer is invalidated when objects are added.
+    ///
+    /// \param component Component to access
+    ///
+    /// \return Pointer to the first value
+    ///
+    ////////////////////////////////////////////////////////////
+    float* getData(Component component);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get read access to a component of all the objects
+    ///
+    /// \param component Component to access
+    ///
+    /// \return Pointer to the first value
+    ///
+    ////////////////////////////////////////////////////////////
+    const float* getData(Component component) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the transform of an object
+    ///
+    /// The result is the same as sf::Transformable::getTransform
+    /// with the same components.
+    ///
+    /// \param index Index of the object
+    ///
+    /// \return Transform of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    Transform getTransform(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get one element of the transforms of all the objects
+    ///
+    /// The transforms are stored as 6 arrays of getSize()
+    /// values, one per element of the 2x3 affine matrix, in the
+    /// order of Transform::getAffineMatrix. Outdated transforms
+    /// are recomputed first.
+    ///
+    /// \param element Element of the matrix, in [0, 5]
+    ///
+    /// \return Pointer to the first value
+    ///
+    ////////////////////////////////////////////////////////////
+    const float* getMatrixData(std::size_t element) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the version of the transforms
+    ///
+    /// The version changes each time any object is modified,
+    /// objects built from the buffer can compare it to skip
+    /// redundant work.
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getVersion() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the transforms of a range of objects as outdated
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate(std::size_t begin, std::size_t end);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the outdated transforms
+    ///
+    ////////////////////////////////////////////////////////////
+    void update() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<float>         m_components[ComponentCount]; ///< Components of the objects, one array per component
+    mutable std::vector<float> m_matrices[6];                ///< Affine matrices of the objects, one array per element
+    mutable std::vector<float> m_cosines;                    ///< Scratch array for the cosines of the rotations
+    mutable std::vector<float> m_sines;                      ///< Scratch array for the sines of the rotations
+    mutable std::size_t        m_dirtyBegin;                 ///< First object whose transform is outdated
+    mutable std::size_t        m_dirtyEnd;                   ///< One past the last object whose transform is outdated
+    Uint32                     m_version;                    ///< Incremented on each modification
+};
+
+} // namespace sf
+
+
+#endif // SFML_TRANSFORMBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TransformBuffer
+/// \ingroup graphics
+///
+/// sf::TransformBuffer is an alternative to sf::Transformable
+/// for programs that move a very large number of objects.
+/// Instead of one object holding its components and cached
+/// matrices, each component of all the objects is stored in
+/// its own contiguous array, and the transforms are computed
+/// in bulk, in a loop that the compiler can vectorize.
+///
+/// Only the objects modified since the last computation are
+/// updated. Writing directly to the arrays returned by
+/// getData() is the fastest way to move everything at once.
+///
+/// A sf::SpriteBatch can read its transforms from the buffer
+/// by index, so that the whole path from the update of the
+/// simulation to the upload of the instances goes linearly
+/// through memory.
+///
+/// Usage example:
+/// \code
+/// sf::TransformBuffer transforms;
+/// sf::SpriteBatch batch(texture);
+/// batch.setTransformBuffer(&transforms);
+///
+/// for (std::size_t i = 0; i < 100000; ++i)
+/// {
+///     transforms.add(sf::Vector2f(rand() % 800, rand() % 600));
+///     batch.add(sf::IntRect(0, 0, 8, 8));
+/// }
+///
+/// // each frame
+/// float* x = transforms.getData(sf::TransformBuffer::PositionX);
+/// for (std::size_t i = 0; i < transforms.getSize(); ++i)
+///     x[i] += speed[i] * dt;
+///
+/// window.draw(batch);
+/// \endcode
+///
+/// \see sf::Transformable, sf::SpriteBatch
+///
+////////////////////////////////////////////////////////////
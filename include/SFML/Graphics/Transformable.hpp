@@ -311,8 +311,42 @@ public:
     ////////////////////////////////////////////////////////////
     const Transform& getInverseTransform() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the version of the transform
+    ///
+    /// The version changes each time the position, rotation,
+    /// scale or origin of the object is set, so that objects
+    /// which cache results derived from the transform can tell
+    /// whether they are still up to date.
+    ///
+    /// \return Current version of the transform
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getTransformVersion() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform local bounds to global bounds, with a cache
+    ///
+    /// The result of the last call is returned directly if
+    /// neither the transform nor \a localBounds changed since.
+    ///
+    /// \param localBounds Bounds of the object, in local coordinates
+    ///
+    /// \return Bounds of the object, in global coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getTransformedBounds(const FloatRect& localBounds) const;
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the transforms as outdated after a change
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateTransform();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -324,6 +358,11 @@ private:
     mutable bool      m_transformNeedUpdate;        ///< Does the transform need to be recomputed?
     mutable Transform m_inverseTransform;           ///< Combined transformation of the object
     mutable bool      m_inverseTransformNeedUpdate; ///< Does the transform need to be recomputed?
+    Uint32            m_transformVersion;           ///< Incremented at each change of the transform
+    mutable FloatRect m_localBounds;                ///< Local bounds given to the last getTransformedBounds call
+    mutable FloatRect m_globalBounds;               ///< Result of the last getTransformedBounds call
+    mutable Uint32    m_boundsVersion;              ///< Version of the transform used for m_globalBounds
+    mutable bool      m_boundsValid;                ///< Do m_localBounds and m_globalBounds hold a result?
 };
 
 } // namespace sf
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_UNIFORMBUFFER_HPP
+#define SFML_UNIFORMBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Buffer of uniform values shared by shader programs
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API UniformBuffer : NonCopyable
+{
+public:
+
+    enum
+    {
+        FrameBinding = 0 ///< Binding point of the built-in sf_Frame block, reserved by SFML
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty uniform buffer.
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~UniformBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the buffer
+    ///
+    /// The contents of the buffer are undefined until they
+    /// are updated.
+    ///
+    /// \param size Size of the buffer, in bytes
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer
+    ///
+    /// The data must follow the layout of the block in the
+    /// shaders, usually std140.
+    ///
+    /// \param data   Data to copy to the buffer
+    /// \param size   Size of the data, in bytes
+    /// \param offset Offset in the buffer where to copy the data, in bytes
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const void* data, std::size_t size, std::size_t offset = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the buffer
+    ///
+    /// \return Size of the buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the buffer
+    ///
+    /// \return OpenGL handle of the buffer or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the buffer to a uniform binding point
+    ///
+    /// Blocks of shaders assigned to the same binding point with
+    /// sf::Shader::setUniformBlock read from this buffer. The
+    /// binding is global: it stays until another buffer is bound
+    /// to the same point.
+    ///
+    /// \param bindingPoint Index of the binding point, FrameBinding is reserved
+    ///
+    ////////////////////////////////////////////////////////////
+    void bind(unsigned int bindingPoint) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports uniform buffers
+    ///
+    /// Uniform buffers need OpenGL 3.1 (or ARB_uniform_buffer_object),
+    /// OpenGL ES 3 or WebGL 2.
+    ///
+    /// \return True if uniform buffers are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_buffer; ///< Internal buffer identifier
+    std::size_t  m_size;   ///< Size of the buffer, in bytes
+};
+
+} // namespace sf
+
+
+#endif // SFML_UNIFORMBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::UniformBuffer
+/// \ingroup graphics
+///
+/// A uniform buffer holds the values of a uniform block in
+/// video memory. Programs that declare the same block read
+/// the same buffer, so values shared by many shaders are
+/// uploaded once instead of once per shader.
+///
+/// SFML fills a built-in block for every render target on
+/// its own; shaders that declare it get the current view
+/// and a few per-frame values without any setUniform:
+/// \code
+/// layout(std140) uniform sf_Frame
+/// {
+///     mat4  sf_ViewProj;   // projection of the current view
+///     vec2  sf_TargetSize; // size of the render target, in pixels
+///     float sf_Time;       // seconds since the first render target was created
+/// };
+/// \endcode
+/// sf_ViewProj doesn't include the transform of the draw.
+///
+/// Usage example:
+/// \code
+/// // layout(std140) uniform Lights { vec4 positions[16]; vec4 colors[16]; };
+/// sf::UniformBuffer lights;
+/// lights.create(sizeof(LightData));
+/// lights.update(&lightData, sizeof(LightData));
+/// lights.bind(1);
+///
+/// shader.setUniformBlock("Lights", 1);
+/// \endcode
+///
+/// \see sf::Shader
+///
+////////////////////////////////////////////////////////////
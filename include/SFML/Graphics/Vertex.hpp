@@ -99,6 +99,52 @@ public:
     Vector2f  texCoords; ///< Coordinates of the texture's pixel to map to the vertex
 };
 
+////////////////////////////////////////////////////////////
+/// \brief Compact vertex, with integer position and
+///        normalized 16-bit texture coordinates
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API VertexPacked
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexPacked();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position, color and texture coordinates
+    ///
+    /// \param thePosition  Vertex position
+    /// \param theColor     Vertex color
+    /// \param theTexCoords Vertex texture coordinates, 0 to 65535 mapping to 0 to 1
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexPacked(const Vector2<Int16>& thePosition, const Color& theColor, const Vector2<Uint16>& theTexCoords);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from a regular vertex
+    ///
+    /// The position is rounded to the nearest integer and
+    /// the texture coordinates, in pixels, are normalized by
+    /// the size of the texture.
+    ///
+    /// \param vertex      Vertex to convert
+    /// \param textureSize Size of the texture the vertex maps to
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexPacked(const Vertex& vertex, const Vector2u& textureSize);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2<Int16>  position;  ///< 2D position of the vertex
+    Color           color;     ///< Color of the vertex
+    Vector2<Uint16> texCoords; ///< Normalized coordinates of the texture's pixel to map to the vertex
+};
+
 } // namespace sf
 
 
@@ -143,6 +189,12 @@ public:
 /// amount of pixels, their type is float because of some buggy graphics
 /// drivers that are not able to process integer coordinates correctly.
 ///
-/// \see sf::VertexArray
+/// sf::VertexPacked is a 12 bytes alternative (instead of 20) for
+/// static geometry stored in a sf::VertexBuffer with the
+/// sf::VertexBuffer::Packed format, such as tile maps: positions
+/// are 16-bit integers and texture coordinates are normalized
+/// 16-bit integers, which is exact for atlas coordinates.
+///
+/// \see sf::VertexArray, sf::VertexBuffer
 ///
 ////////////////////////////////////////////////////////////
@@ -80,6 +80,10 @@ public:
     ///
     /// \param index Index of the vertex to get
     ///
+    /// When the bounds are tracked, this function conservatively
+    /// invalidates them, as the vertex may be moved through the
+    /// returned reference.
+    ///
     /// \return Reference to the index-th vertex
     ///
     /// \see getVertexCount
@@ -136,6 +140,70 @@ public:
     ////////////////////////////////////////////////////////////
     void append(const Vertex& vertex);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Add several vertices to the array
+    ///
+    /// The vertices are copied in a single block, with at most
+    /// one reallocation of the array. They must not be taken
+    /// from this array.
+    ///
+    /// \param vertices    Pointer to the vertices to add
+    /// \param vertexCount Number of vertices to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const Vertex* vertices, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate memory for a number of vertices
+    ///
+    /// This function doesn't change the vertex count, it only
+    /// makes sure that the array can grow up to \a vertexCount
+    /// vertices without reallocating its memory. Reserving
+    /// less than the current capacity does nothing.
+    ///
+    /// \param vertexCount Number of vertices to allocate memory for
+    ///
+    /// \see getCapacity, shrinkToFit
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of vertices the array can hold without reallocating
+    ///
+    /// \return Capacity of the array, in vertices
+    ///
+    /// \see reserve
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the memory that is not used by the vertices
+    ///
+    /// Since clear() and resize() keep the memory of the array,
+    /// an array that was once large keeps its capacity. This
+    /// function reallocates it to the current vertex count.
+    ///
+    /// \see reserve
+    ///
+    ////////////////////////////////////////////////////////////
+    void shrinkToFit();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the color of a range of vertices
+    ///
+    /// This only writes the color of the vertices, which is
+    /// the cheapest way to animate the color of a geometry.
+    /// The range is clamped to the size of the array.
+    ///
+    /// \param color Color to set
+    /// \param first Index of the first vertex to change
+    /// \param count Number of vertices to change (all the following ones by default)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColor(const Color& color, std::size_t first = 0, std::size_t count = static_cast<std::size_t>(-1));
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the type of primitives to draw
     ///
@@ -168,9 +236,38 @@ public:
     ///
     /// \return Bounding rectangle of the vertex array
     ///
+    /// \see setBoundsTracking
+    ///
     ////////////////////////////////////////////////////////////
     FloatRect getBounds() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the tracking of the bounds
+    ///
+    /// When tracking is enabled, the bounding rectangle is cached
+    /// and kept up to date by append() and resize(), so that
+    /// getBounds() costs nothing for arrays that are built once
+    /// or only grow. Writable access with operator[] drops the
+    /// cached bounds, which are then recomputed on next call to
+    /// getBounds().
+    ///
+    /// Tracking is disabled by default.
+    ///
+    /// \param enabled True to track the bounds, false to compute them on each call
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBoundsTracking(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the bounds are tracked
+    ///
+    /// \return True if the bounds are tracked, false otherwise
+    ///
+    /// \see setBoundsTracking
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBoundsTracking() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -182,6 +279,16 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the vertex array
+    ///
+    /// \param bounds Receives the untransformed bounds of the vertex array
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -189,6 +296,10 @@ private:
     ////////////////////////////////////////////////////////////
     std::vector<Vertex> m_vertices;      ///< Vertices contained in the array
     PrimitiveType       m_primitiveType; ///< Type of primitives to draw
+    bool                m_trackBounds;   ///< Are the bounds cached and updated incrementally?
+    mutable bool        m_boundsValid;   ///< Do m_boundsMin and m_boundsMax match the vertices?
+    mutable Vector2f    m_boundsMin;     ///< Top-left corner of the tracked bounds
+    mutable Vector2f    m_boundsMax;     ///< Bottom-right corner of the tracked bounds
 };
 
 } // namespace sf
@@ -218,6 +329,10 @@ private:
 /// window.draw(lines);
 /// \endcode
 ///
+/// Large arrays that are mostly built with append(), like
+/// tile maps, can enable setBoundsTracking() to make
+/// getBounds() a constant-time query.
+///
 /// \see sf::Vertex
 ///
 ////////////////////////////////////////////////////////////
@@ -31,11 +31,15 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <utility>
+#include <vector>
 
 namespace sf
 {
 class RenderTarget;
 class Vertex;
+class VertexBufferArena;
+class VertexPacked;
 
 ////////////////////////////////////////////////////////////
 /// \brief Vertex buffer storage for one or more 2D primitives
@@ -62,6 +66,16 @@ public:
         Static   ///< Rarely changing data
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Layout of the vertices stored in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Format
+    {
+        Standard, ///< sf::Vertex, 20 bytes per vertex
+        Packed    ///< sf::VertexPacked, 12 bytes per vertex
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -110,6 +124,17 @@ public:
     ////////////////////////////////////////////////////////////
     VertexBuffer(const VertexBuffer& copy);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The OpenGL buffer (and the CPU shadow, if any) is taken
+    /// over from \a right, which is left empty.
+    ///
+    /// \param right Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexBuffer(VertexBuffer&& right) noexcept;
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -127,6 +152,9 @@ public:
     /// as \p vertexCount. Don't forget to recreate with a non-zero
     /// value when graphics memory should be allocated again.
     ///
+    /// Buffers created in an arena stay in it: the memory is
+    /// allocated from the arena again.
+    ///
     /// \param vertexCount Number of vertices worth of memory to allocate
     ///
     /// \return True if creation was successful
@@ -134,6 +162,34 @@ public:
     ////////////////////////////////////////////////////////////
     bool create(std::size_t vertexCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the vertex buffer as a range of a vertex buffer arena
+    ///
+    /// The vertices are stored in one of the graphics buffers
+    /// of \a arena, shared with the other vertex buffers of the
+    /// arena, instead of a graphics buffer of their own. The
+    /// format of the vertex buffer becomes the one of the arena,
+    /// and the arena must outlive the vertex buffer. Any
+    /// previously allocated memory is freed in the process.
+    ///
+    /// \param vertexCount Number of vertices worth of memory to allocate
+    /// \param arena       Arena to allocate the memory from
+    ///
+    /// \return True if creation was successful
+    ///
+    /// \see sf::VertexBufferArena
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t vertexCount, VertexBufferArena& arena);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the arena the vertex buffer is allocated from
+    ///
+    /// \return Arena of the vertex buffer, or NULL if it has a graphics buffer of its own
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexBufferArena* getArena() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the vertex count
     ///
@@ -205,6 +261,34 @@ public:
     ////////////////////////////////////////////////////////////
     bool update(const VertexBuffer& vertexBuffer);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the whole buffer from an array of packed vertices
+    ///
+    /// Same as update(const Vertex*), for buffers of the
+    /// Packed format.
+    ///
+    /// \param vertices Array of packed vertices to copy to the buffer
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const VertexPacked* vertices);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of packed vertices
+    ///
+    /// Same as update(const Vertex*, std::size_t, unsigned int),
+    /// for buffers of the Packed format.
+    ///
+    /// \param vertices    Array of packed vertices to copy to the buffer
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const VertexPacked* vertices, std::size_t vertexCount, unsigned int offset);
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -215,6 +299,16 @@ public:
     ////////////////////////////////////////////////////////////
     VertexBuffer& operator =(const VertexBuffer& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of move assignment operator
+    ///
+    /// \param right Instance to move
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexBuffer& operator =(VertexBuffer&& right) noexcept;
+
     ////////////////////////////////////////////////////////////
     /// \brief Swap the contents of this vertex buffer with those of another
     ///
@@ -244,9 +338,23 @@ public:
     ///
     /// \return OpenGL handle of the vertex buffer or 0 if not yet created
     ///
+    /// \see getNativeOffset
+    ///
     ////////////////////////////////////////////////////////////
     unsigned int getNativeHandleBuffer() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of the first vertex in the OpenGL buffer
+    ///
+    /// This is 0 unless the vertex buffer is allocated from a
+    /// sf::VertexBufferArena, in which case its vertices start
+    /// at this index of the shared OpenGL buffer and vertex array.
+    ///
+    /// \return Index of the first vertex of the vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getNativeOffset() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the type of primitives to draw
     ///
@@ -293,6 +401,105 @@ public:
     ////////////////////////////////////////////////////////////
     Usage getUsage() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the layout of the vertices of this vertex buffer
+    ///
+    /// The Packed format stores sf::VertexPacked, which take 40%
+    /// less memory and upload bandwidth than sf::Vertex. Its
+    /// texture coordinates are normalized, and reach custom
+    /// shaders as is.
+    ///
+    /// If the buffer was already created, it is created again
+    /// with the same vertex count and its contents are lost.
+    ///
+    /// The default format is sf::VertexBuffer::Standard.
+    ///
+    /// \param format Layout of the vertices
+    ///
+    /// \return True if the buffer could be created again, or didn't need to
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setFormat(Format format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layout of the vertices of this vertex buffer
+    ///
+    /// \return Layout of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    Format getFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the CPU-side copy of the vertices
+    ///
+    /// When the buffer is shadowed, update() only writes to a
+    /// copy of the vertices in system memory and records the
+    /// modified ranges. The vertices can also be modified in
+    /// place through getVertices() or getPackedVertices(),
+    /// followed by a call to markDirty(). All the modified
+    /// ranges are uploaded at once, merged when they overlap or
+    /// are close, when the buffer is next drawn or bound.
+    ///
+    /// This is the most efficient way to change a few vertices
+    /// of a large buffer each frame. Enabling the shadow doesn't
+    /// read the current contents back from graphics memory: the
+    /// copy starts zeroed, enable it before filling the buffer.
+    ///
+    /// The shadow is disabled by default.
+    ///
+    /// \param shadowed True to keep a copy of the vertices in system memory
+    ///
+    ////////////////////////////////////////////////////////////
+    void setShadowed(bool shadowed);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the buffer keeps a CPU-side copy of the vertices
+    ///
+    /// \return True if the buffer is shadowed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isShadowed() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get write access to the CPU-side copy of the vertices
+    ///
+    /// Call markDirty() for the vertices that are changed. The
+    /// pointer is invalidated when the buffer grows.
+    ///
+    /// \return Pointer to the first vertex, or NULL if the buffer is not shadowed or has the Packed format
+    ///
+    ////////////////////////////////////////////////////////////
+    Vertex* getVertices();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get write access to the CPU-side copy of the packed vertices
+    ///
+    /// \return Pointer to the first vertex, or NULL if the buffer is not shadowed or has the Standard format
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexPacked* getPackedVertices();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a range of the CPU-side copy as modified
+    ///
+    /// The range is clamped to the size of the buffer. This
+    /// function does nothing if the buffer is not shadowed.
+    ///
+    /// \param first Index of the first modified vertex
+    /// \param count Number of modified vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void markDirty(std::size_t first, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the modified ranges of the CPU-side copy
+    ///
+    /// This is done automatically before drawing or binding the
+    /// buffer; it does nothing if nothing was modified.
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Bind a vertex buffer for rendering
     ///
@@ -318,6 +525,9 @@ public:
 
 private:
 
+    friend class ContextRestore;
+    friend class VertexBufferArena;
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the vertex buffer to a render target
     ///
@@ -327,6 +537,71 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload vertices of the format of the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    bool upload(const void* vertices, std::size_t vertexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size in bytes of a vertex of the format of the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getStride() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the memory of the buffer back
+    ///
+    /// The graphics buffer is deleted, or its range is released
+    /// to the arena.
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseStorage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the vertices back, for a context restore
+    ///
+    /// Shadowed buffers already have a copy. The vertices can't
+    /// be read back on OpenGL ES 2 and WebGL.
+    ///
+    /// \param data Receives the vertices
+    ///
+    /// \return True if the vertices were read
+    ///
+    ////////////////////////////////////////////////////////////
+    bool retainVertices(std::vector<Uint8>& data) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recreate the storage after the context was lost
+    ///
+    /// The names of the lost buffer and vertex array are
+    /// forgotten without being deleted; the buffers of an
+    /// arena take the blocks recreated by the arena first.
+    ///
+    /// \param data Vertices kept by retainVertices (NULL if none)
+    ///
+    /// \return True if the storage and the vertices were restored
+    ///
+    ////////////////////////////////////////////////////////////
+    bool restoreStorage(const std::vector<Uint8>* data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate a bigger range of the arena
+    ///
+    /// The previous contents are lost.
+    ///
+    ////////////////////////////////////////////////////////////
+    bool growInArena(std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the vertex attributes of a format to the bound vertex array
+    ///
+    /// The buffer that holds the vertices must be bound to
+    /// GL_ARRAY_BUFFER.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setupAttributes(Format format);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -337,6 +612,13 @@ private:
     std::size_t   m_size;          ///< Size in Vertexes of the currently allocated buffer
     PrimitiveType m_primitiveType; ///< Type of primitives to draw
     Usage         m_usage;         ///< How this vertex buffer is to be used
+    Format        m_format;        ///< Layout of the vertices
+    bool          m_shadowed;      ///< Is there a CPU-side copy of the vertices?
+    std::vector<char> m_shadow;    ///< CPU-side copy of the vertices
+    mutable std::vector<std::pair<std::size_t, std::size_t> > m_dirtyRanges; ///< Sorted, disjoint [begin, end) ranges of the shadow to upload
+    mutable bool  m_reallocate;    ///< Must the whole shadow be uploaded to new storage?
+    VertexBufferArena* m_arena;    ///< Arena the vertices are allocated from (NULL if the buffer owns its storage)
+    std::size_t   m_first;         ///< First vertex of the buffer in the graphics buffer
 };
 
 } // namespace sf
@@ -402,6 +684,20 @@ private:
 /// window.draw(triangles);
 /// \endcode
 ///
-/// \see sf::Vertex, sf::VertexArray
+/// Static geometry made of integer positions and atlas
+/// coordinates, like tile maps, can use the Packed format to
+/// store sf::VertexPacked instead, which are 12 bytes instead
+/// of 20.
+///
+/// Buffers where a few vertices change every frame, such as
+/// large dynamic tile maps, can keep a CPU-side copy of their
+/// vertices with setShadowed(): scattered updates are then
+/// merged and uploaded once, right before drawing.
+///
+/// Thousands of small static meshes are better allocated from
+/// a sf::VertexBufferArena, which stores them in a few large
+/// graphics buffers that are drawn without rebinding.
+///
+/// \see sf::Vertex, sf::VertexPacked, sf::VertexArray, sf::VertexBufferArena
 ///
 ////////////////////////////////////////////////////////////
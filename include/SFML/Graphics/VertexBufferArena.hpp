@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VERTEXBUFFERARENA_HPP
+#define SFML_VERTEXBUFFERARENA_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Large graphics buffers shared by many small vertex buffers
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API VertexBufferArena : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// No graphics memory is allocated until the first vertex
+    /// buffer is created in the arena.
+    ///
+    /// \param format    Layout of the vertices of all the buffers of the arena
+    /// \param blockSize Number of vertices of each graphics buffer
+    /// \param usage     Usage specifier of the graphics buffers
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit VertexBufferArena(VertexBuffer::Format format = VertexBuffer::Standard, std::size_t blockSize = 65536,
+                               VertexBuffer::Usage usage = VertexBuffer::Static);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the vertex buffers created in the arena must have
+    /// been destroyed (or recreated elsewhere) before.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~VertexBufferArena();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layout of the vertices of the arena
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexBuffer::Format getFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of vertices of each graphics buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBlockSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of graphics buffers allocated by the arena
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBlockCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of vertices allocated to vertex buffers
+    ///
+    /// This includes the padding that keeps each allocation
+    /// aligned to 4 vertices.
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getUsedVertexCount() const;
+
+private:
+
+    friend class ContextRestore;
+    friend class VertexBuffer;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Graphics buffer and vertex array shared by the allocations
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Block
+    {
+        unsigned int vao;         ///< Vertex array handle, with the attributes of the format
+        unsigned int vbo;         ///< Vertex buffer handle
+        unsigned int previousVbo; ///< Vertex buffer handle in the context lost before the last restore
+        std::size_t  size;        ///< Number of vertices of the buffer
+        std::size_t  used;        ///< Number of vertices allocated
+        std::vector<std::pair<std::size_t, std::size_t> > freeRanges; ///< Sorted, disjoint [begin, end) free ranges
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate a range of vertices
+    ///
+    /// A new block is created when none of the existing ones
+    /// has enough contiguous free space; ranges bigger than the
+    /// block size get a block of their own.
+    ///
+    /// \param vertexCount Number of vertices to allocate
+    /// \param vao         Receives the vertex array of the block
+    /// \param vbo         Receives the vertex buffer of the block
+    /// \param first       Receives the first vertex of the range
+    ///
+    /// \return True if the range was allocated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool allocate(std::size_t vertexCount, unsigned int& vao, unsigned int& vbo, std::size_t& first);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give back a range returned by allocate
+    ///
+    /// Blocks that become empty are destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(unsigned int vbo, std::size_t first, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the graphics buffer of a block
+    ///
+    ////////////////////////////////////////////////////////////
+    void destroyBlock(Block& block);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recreate the graphics buffers of the blocks after a context loss
+    ///
+    /// The names of the lost buffers are forgotten without
+    /// being deleted. The contents of the new buffers are
+    /// undefined, the vertex buffers of the arena upload their
+    /// range again.
+    ///
+    /// \return True if all the blocks were recreated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool restoreBlocks();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the block that replaces a lost graphics buffer
+    ///
+    /// \param previousVbo Vertex buffer handle in the lost context
+    /// \param vao         Receives the new vertex array of the block
+    /// \param vbo         Receives the new vertex buffer of the block
+    ///
+    /// \return True if the block was found and recreated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool findRestoredBlock(unsigned int previousVbo, unsigned int& vao, unsigned int& vbo) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    VertexBuffer::Format m_format;    ///< Layout of the vertices
+    VertexBuffer::Usage  m_usage;     ///< Usage specifier of the graphics buffers
+    std::size_t          m_blockSize; ///< Number of vertices of the regular blocks
+    std::vector<Block>   m_blocks;    ///< Graphics buffers of the arena
+};
+
+} // namespace sf
+
+
+#endif // SFML_VERTEXBUFFERARENA_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VertexBufferArena
+/// \ingroup graphics
+///
+/// A scene made of thousands of small static meshes spends
+/// more time binding the vertex array and buffer of each
+/// sf::VertexBuffer than drawing them. Vertex buffers created
+/// in a sf::VertexBufferArena are ranges of a few large
+/// graphics buffers instead, which share one vertex array per
+/// buffer: drawing them only changes the first vertex of the
+/// draw call, and RenderTarget::draw(const VertexBuffer* const*, std::size_t, const RenderStates&)
+/// merges consecutive buffers of the same block into a single
+/// multi-draw call.
+///
+/// The buffers of an arena are used exactly like regular
+/// vertex buffers. Their format is the one of the arena and
+/// they are allocated at 4-vertex boundaries, so that quads
+/// of blocks of up to 65536 vertices can always be drawn with
+/// the shared 16-bit quad indices. Growing a buffer moves it
+/// to another range of the arena.
+///
+/// Indexed draws (with sf::IndexBuffer) of arena buffers
+/// that don't start at the beginning of a block need base
+/// vertex support (OpenGL 3.2, OpenGL ES 3.2), which WebGL
+/// doesn't have.
+///
+/// Example:
+/// \code
+/// sf::VertexBufferArena arena;
+///
+/// std::vector<sf::VertexBuffer> meshes(1000, sf::VertexBuffer(sf::Triangles));
+/// for (std::size_t i = 0; i < meshes.size(); ++i)
+/// {
+///     meshes[i].create(vertices[i].size(), arena);
+///     meshes[i].update(vertices[i].data());
+/// }
+///
+/// std::vector<const sf::VertexBuffer*> visible;
+/// ... // gather the visible meshes
+/// window.draw(visible.data(), visible.size(), states);
+/// \endcode
+///
+/// \see sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
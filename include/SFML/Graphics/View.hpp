@@ -240,6 +240,44 @@ public:
     ////////////////////////////////////////////////////////////
     void zoom(float factor);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a copy of the view that scrolls by a fraction of its motion
+    ///
+    /// The center of the copy is moved \a factor times as far from
+    /// \a anchor as the center of this view, its size, rotation
+    /// and viewport are the same. Drawing a layer with this view
+    /// makes it scroll at \a factor times the speed of the view:
+    /// \li 1 scrolls with the view (same as the view itself)
+    /// \li < 1 scrolls slower, for distant backgrounds (0 doesn't scroll at all)
+    /// \li > 1 scrolls faster, for foregrounds
+    ///
+    /// Since only the view-projection changes, static layers
+    /// (typically a sf::VertexBuffer) are scrolled without
+    /// updating any of their vertices.
+    ///
+    /// \param factor Scrolling speed of the layer, relatively to the view, on each axis
+    /// \param anchor Center of the view at which the layer is drawn where it is defined
+    ///
+    /// \return Parallax view of the layer
+    ///
+    /// \see move
+    ///
+    ////////////////////////////////////////////////////////////
+    View withParallax(const Vector2f& factor, const Vector2f& anchor = Vector2f(0, 0)) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a copy of the view that scrolls by a fraction of its motion
+    ///
+    /// This overload applies the same factor on both axes.
+    ///
+    /// \param factor Scrolling speed of the layer, relatively to the view
+    /// \param anchor Center of the view at which the layer is drawn where it is defined
+    ///
+    /// \return Parallax view of the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    View withParallax(float factor, const Vector2f& anchor = Vector2f(0, 0)) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the projection transform of the view
     ///
@@ -266,6 +304,8 @@ public:
 
 private:
 
+    friend class RenderTarget;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -277,6 +317,7 @@ private:
     mutable Transform m_inverseTransform;    ///< Precomputed inverse projection transform corresponding to the view
     mutable bool      m_transformUpdated;    ///< Internal state telling if the transform needs to be updated
     mutable bool      m_invTransformUpdated; ///< Internal state telling if the inverse transform needs to be updated
+    Uint64            m_generation;          ///< Unique identifier of the current state, changed by every modification (copies share it)
 };
 
 } // namespace sf
@@ -336,6 +377,20 @@ private:
 /// window.draw(someText);
 /// \endcode
 ///
+/// Parallax layers, which scroll slower or faster than the
+/// camera, are drawn with a copy of the view made by
+/// withParallax; static layers then never have to be moved:
+/// \code
+/// // Distant mountains scroll at a quarter of the camera speed, clouds at half of it
+/// window.setView(camera.withParallax(0.25f));
+/// window.draw(mountainsBuffer);
+/// window.setView(camera.withParallax(0.5f));
+/// window.draw(cloudsBuffer);
+///
+/// window.setView(camera);
+/// window.draw(level);
+/// \endcode
+///
 /// See also the note on coordinates and undistorted rendering in sf::Transformable.
 ///
 /// \see sf::RenderWindow, sf::RenderTexture
@@ -0,0 +1,306 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_YUVTEXTURE_HPP
+#define SFML_YUVTEXTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+class YuvTexture;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Get the conversion from the planes of a YUV texture to RGB
+///
+/// The RGB color is matrix * (yuv - offset), with the samples
+/// of the planes normalized to [0 .. 1].
+///
+/// \param texture YUV texture to convert
+/// \param matrix  Receives the 3x3 matrix, in column-major order
+/// \param offset  Receives the offset subtracted from the samples
+///
+////////////////////////////////////////////////////////////
+void getYuvConversion(const YuvTexture& texture, float matrix[9], float offset[3]);
+
+} // namespace priv
+
+////////////////////////////////////////////////////////////
+/// \brief Video frame stored as planes of luma and chroma,
+///        converted to RGB when drawn
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API YuvTexture : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Arrangement of the planes of a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Layout
+    {
+        I420, ///< Full size Y plane, then half size U and V planes
+        NV12  ///< Full size Y plane, then a half size plane of interleaved U and V
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Standard that defines the conversion to RGB
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ColorSpace
+    {
+        Bt601, ///< ITU-R BT.601, standard definition video (default)
+        Bt709  ///< ITU-R BT.709, high definition video
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty YUV texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    YuvTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~YuvTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the planes of the texture
+    ///
+    /// The chroma planes are half the size of the luma plane,
+    /// rounded up. Any previous contents are lost.
+    ///
+    /// \param width  Width of the frame, in pixels
+    /// \param height Height of the frame, in pixels
+    /// \param layout Arrangement of the planes
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, Layout layout = I420);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the planes of an I420 texture
+    ///
+    /// Each plane is an array of one byte per sample, with no
+    /// padding between the rows.
+    ///
+    /// \param y Luma plane, width * height bytes
+    /// \param u Blue difference plane, (width + 1) / 2 * (height + 1) / 2 bytes
+    /// \param v Red difference plane, same size as \a u
+    ///
+    /// \return True if the planes were updated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint8* y, const Uint8* u, const Uint8* v);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the planes of an NV12 texture
+    ///
+    /// Each plane is an array of bytes with no padding between
+    /// the rows.
+    ///
+    /// \param y  Luma plane, width * height bytes
+    /// \param uv Interleaved chroma plane, 2 * (width + 1) / 2 * (height + 1) / 2 bytes
+    ///
+    /// \return True if the planes were updated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint8* y, const Uint8* uv);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the frame
+    ///
+    /// \return Size of the luma plane, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the arrangement of the planes
+    ///
+    /// \return Layout given to create
+    ///
+    ////////////////////////////////////////////////////////////
+    Layout getLayout() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the standard used to convert the frame to RGB
+    ///
+    /// \param colorSpace New color space (Bt601 by default)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColorSpace(ColorSpace colorSpace);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the standard used to convert the frame to RGB
+    ///
+    /// \return Current color space
+    ///
+    ////////////////////////////////////////////////////////////
+    ColorSpace getColorSpace() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the samples use the full 0-255 range
+    ///
+    /// Video is usually encoded in the limited range (16-235 for
+    /// luma, 16-240 for chroma), some cameras output the full
+    /// range instead. The limited range is the default.
+    ///
+    /// \param fullRange True if the samples use the full range
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFullRange(bool fullRange);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the samples are read as full range
+    ///
+    /// \return True for the full range, false for the limited range
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isFullRange() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter of the planes
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled (the default)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of planes of the layout
+    ///
+    /// \return 3 for I420, 2 for NV12, 0 if the texture is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPlaneCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenGL handle of a plane
+    ///
+    /// Single-channel planes are GL_R8 textures, or GL_LUMINANCE
+    /// textures where red textures are not supported; the NV12
+    /// chroma plane is GL_RG8 or GL_LUMINANCE_ALPHA.
+    ///
+    /// \param plane Index of the plane (0 for luma)
+    ///
+    /// \return OpenGL handle of the plane, or 0 if it doesn't exist
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle(unsigned int plane) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload a plane
+    ///
+    /// \param plane    Index of the plane
+    /// \param pixels   Samples of the plane
+    /// \param channels Number of bytes per sample
+    ///
+    ////////////////////////////////////////////////////////////
+    void updatePlane(unsigned int plane, const Uint8* pixels, unsigned int channels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the filter of the texture to the bound plane
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyFilter();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u     m_size;        ///< Size of the luma plane, in pixels
+    Layout       m_layout;      ///< Arrangement of the planes
+    ColorSpace   m_colorSpace;  ///< Standard used to convert to RGB
+    bool         m_fullRange;   ///< Do the samples use the full 0-255 range?
+    bool         m_isSmooth;    ///< Status of the smooth filter
+    unsigned int m_planes[3];   ///< OpenGL textures of the planes
+    Uint64       m_memoryUsage; ///< Accounted video memory, in bytes
+};
+
+} // namespace sf
+
+
+#endif // SFML_YUVTEXTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::YuvTexture
+/// \ingroup graphics
+///
+/// Video decoders and cameras output frames as separate planes
+/// of luma (Y) and chroma (U and V), with the chroma at half
+/// the resolution. sf::YuvTexture uploads the planes as they
+/// are, and the render target converts them to RGB in the
+/// fragment shader: an I420 frame is 1.5 bytes per pixel
+/// instead of 4, and no conversion runs on the CPU.
+///
+/// YUV textures are drawn with sf::YuvSprite, or with the
+/// RenderTarget::draw overload that takes a YUV texture.
+///
+/// Usage example:
+/// \code
+/// sf::YuvTexture frame;
+/// frame.create(1920, 1080, sf::YuvTexture::I420);
+/// frame.setColorSpace(sf::YuvTexture::Bt709);
+///
+/// sf::YuvSprite video(frame);
+///
+/// while (window.isOpen())
+/// {
+///     if (decoder.decodeNextFrame())
+///         frame.update(decoder.getY(), decoder.getU(), decoder.getV());
+///
+///     window.clear();
+///     window.draw(video);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::YuvSprite, sf::StreamingTexture
+///
+////////////////////////////////////////////////////////////
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Export.hpp>
+#include <cstddef>
 #include <ostream>
 
 
@@ -40,6 +41,64 @@ namespace sf
 ////////////////////////////////////////////////////////////
 SFML_SYSTEM_API std::ostream& err();
 
+////////////////////////////////////////////////////////////
+/// \brief Function receiving the messages of sf::err()
+///
+/// \param message  The message, including its final newline
+/// \param length   Length of the message, in characters
+/// \param userData User data given to setErrCallback
+///
+////////////////////////////////////////////////////////////
+typedef void (*ErrCallback)(const char* message, std::size_t length, void* userData);
+
+////////////////////////////////////////////////////////////
+/// \brief Redirect the messages of the default sf::err() output
+///
+/// A message is everything written between two flushes of
+/// the stream (std::endl flushes it). The callback is called
+/// once per message, on the logging thread if asynchronous
+/// logging is enabled. It must not write to sf::err().
+///
+/// \param callback Function receiving the messages, or NULL to write them to stderr
+/// \param userData User data passed to the callback
+///
+/// \see setErrAsync
+///
+////////////////////////////////////////////////////////////
+SFML_SYSTEM_API void setErrCallback(ErrCallback callback, void* userData = NULL);
+
+////////////////////////////////////////////////////////////
+/// \brief Limit the number of messages written by the default sf::err() output
+///
+/// Messages above the limit are dropped. With deduplication,
+/// a message identical to one already written since the
+/// start of the current second is dropped as well. The
+/// number of dropped messages is reported once per second.
+///
+/// \param maxMessagesPerSecond Maximum number of messages written per second, 0 for no limit
+/// \param deduplicate          Drop the repeated messages?
+///
+////////////////////////////////////////////////////////////
+SFML_SYSTEM_API void setErrRateLimit(unsigned int maxMessagesPerSecond, bool deduplicate = true);
+
+////////////////////////////////////////////////////////////
+/// \brief Enable or disable asynchronous logging
+///
+/// When enabled, the messages of the default sf::err()
+/// output are queued and written by a background thread, so
+/// that slow consoles (Android logcat, the browser console)
+/// don't stall the thread that reported them. The queue is
+/// drained when asynchronous logging is disabled again and
+/// at exit.
+///
+/// Asynchronous logging is not available on Emscripten
+/// without pthreads, the messages are written immediately.
+///
+/// \param async True to write the messages in the background
+///
+////////////////////////////////////////////////////////////
+SFML_SYSTEM_API void setErrAsync(bool async);
+
 } // namespace sf
 
 
@@ -75,6 +134,11 @@ SFML_SYSTEM_API std::ostream& err();
 /// sf::err().rdbuf(previous);
 /// \endcode
 ///
+/// The default output can also be sent to a callback, rate
+/// limited and written by a background thread, see
+/// setErrCallback, setErrRateLimit and setErrAsync. These
+/// settings don't apply once the stream is redirected.
+///
 /// \return Reference to std::ostream representing the SFML error stream
 ///
 ////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Config.hpp>
 #include <SFML/System/Export.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -87,6 +88,22 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual Int64 getSize() = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the whole contents of the stream, if they are contiguous in memory
+    ///
+    /// Streams whose data is already in memory can override this
+    /// function, so that the loaders decode their contents in
+    /// place instead of copying them through read. The default
+    /// implementation returns NULL.
+    ///
+    /// \param size Receives the size of the contents, in bytes
+    ///
+    /// \return Pointer to the contents, which stay valid as long as
+    ///         the stream is open, or NULL if they are not available
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual const void* getContiguousData(std::size_t& size) { size = 0; return NULL; }
 };
 
 } // namespace sf
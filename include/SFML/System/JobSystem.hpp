@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_JOBSYSTEM_HPP
+#define SFML_JOBSYSTEM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Interface of the schedulers running the parallel
+///        work of SFML
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API JobScheduler
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function processing the range [begin, end) of a parallel loop
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::function<void(std::size_t begin, std::size_t end)> RangeFunction;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~JobScheduler() {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads that can run jobs at the same time
+    ///
+    /// This includes the thread calling parallelFor.
+    ///
+    /// \return Number of threads (1 if the jobs run serially)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getConcurrency() const = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Split a range of indices and process the parts in parallel
+    ///
+    /// \a work is called with disjoint ranges covering [0, count),
+    /// each one of at least \a grain indices (except the last),
+    /// possibly from several threads at the same time. The
+    /// function returns when the whole range is processed. It
+    /// can be called from inside a job.
+    ///
+    /// \param count Number of indices to process
+    /// \param grain Minimum number of indices of a range
+    /// \param work  Function processing a range
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void parallelFor(std::size_t count, std::size_t grain, const RangeFunction& work) = 0;
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Pool of worker threads stealing jobs from each other
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API JobSystem : public JobScheduler, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the pool and start its threads
+    ///
+    /// The thread calling parallelFor takes part in the work,
+    /// so the pool starts one thread less than \a concurrency.
+    /// Without thread support (emscripten without pthreads), or
+    /// if the threads can't be created, the jobs run serially.
+    ///
+    /// \param concurrency Number of threads running jobs at the
+    ///                    same time, 0 to use all the cores
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit JobSystem(unsigned int concurrency = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the threads to finish their current job.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~JobSystem();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads that can run jobs at the same time
+    ///
+    /// \return Number of worker threads, plus the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getConcurrency() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Split a range of indices and process the parts in parallel
+    ///
+    /// The range is split in halves, recursively: each thread
+    /// keeps working on the first half and leaves the second
+    /// one in its queue, where idle threads steal it. The
+    /// calling thread runs jobs too until the range is done.
+    ///
+    /// \param count Number of indices to process
+    /// \param grain Minimum number of indices of a range
+    /// \param work  Function processing a range
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void parallelFor(std::size_t count, std::size_t grain, const RangeFunction& work);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the scheduler used by SFML
+    ///
+    /// All the parallel work of SFML goes through the current
+    /// scheduler, which is a JobSystem using all the cores by
+    /// default. An engine with its own scheduler can install
+    /// it here, so that SFML doesn't start threads of its own.
+    /// The scheduler must exist as long as it is installed, and
+    /// must not be replaced while SFML is running jobs.
+    ///
+    /// \param scheduler New scheduler, or NULL to restore the default one
+    ///
+    /// \see getScheduler
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setScheduler(JobScheduler* scheduler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the scheduler used by SFML
+    ///
+    /// The default JobSystem is created on first use.
+    ///
+    /// \return Current scheduler
+    ///
+    /// \see setScheduler
+    ///
+    ////////////////////////////////////////////////////////////
+    static JobScheduler& getScheduler();
+
+private:
+
+    struct Job;
+    struct Queue;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the worker threads
+    ///
+    /// \param index Index of the queue of the thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void runWorker(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take a job from a queue, or steal one from another
+    ///
+    /// \param index Index of the queue of the calling thread
+    /// \param job   Receives the job
+    ///
+    /// \return True if a job was taken
+    ///
+    ////////////////////////////////////////////////////////////
+    bool takeJob(std::size_t index, Job& job);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run a job, leaving its second halves to the other threads
+    ///
+    /// \param index Index of the queue of the calling thread
+    /// \param job   Job to run
+    ///
+    ////////////////////////////////////////////////////////////
+    void runJob(std::size_t index, Job job);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Queue*>       m_queues;    ///< Queue of each worker, then the queue shared by the other threads
+    std::vector<std::thread>  m_threads;   ///< Worker threads
+    std::mutex                m_mutex;     ///< Protects the sleep of the workers
+    std::condition_variable   m_condition; ///< Signals new jobs and the stop
+    std::atomic<std::size_t>  m_jobCount;  ///< Number of jobs waiting in the queues
+    bool                      m_stop;      ///< Must the workers exit?
+};
+
+} // namespace sf
+
+
+#endif // SFML_JOBSYSTEM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::JobSystem
+/// \ingroup system
+///
+/// sf::JobSystem is the worker pool running the parallel work
+/// of SFML (batch image decoding, image resampling, ...), so
+/// that features don't start threads of their own. Each worker
+/// has its own queue of jobs; a thread splitting a range keeps
+/// a half and pushes the other one to its queue, and the idle
+/// workers steal the oldest, largest ranges from the others.
+///
+/// The library uses the scheduler returned by getScheduler. An
+/// application can use it for its own loops too, or replace it
+/// with an implementation of sf::JobScheduler that forwards to
+/// the scheduler of its engine.
+///
+/// Usage example:
+/// \code
+/// std::vector<Particle> particles(100000);
+/// sf::JobSystem::getScheduler().parallelFor(particles.size(), 1024, [&](std::size_t begin, std::size_t end)
+/// {
+///     for (std::size_t i = begin; i < end; ++i)
+///         particles[i].update(dt);
+/// });
+/// \endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_MAPPEDFILEINPUTSTREAM_HPP
+#define SFML_MAPPEDFILEINPUTSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Implementation of input stream based on a file mapped in memory
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API MappedFileInputStream : public InputStream, NonCopyable
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    MappedFileInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default destructor
+    ///
+    /// The mapping is released, the pointers returned by
+    /// getData become invalid.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~MappedFileInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the stream from a file path
+    ///
+    /// \param filename Name of the file to open
+    ///
+    /// \return True on success, false on error
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the whole contents of the file
+    ///
+    /// The contents stay valid until the stream is destroyed
+    /// or opened again. They can be passed to the loadFromMemory
+    /// functions of the resources; the pages of the file are
+    /// then read by the system when they are first accessed.
+    ///
+    /// \return Pointer to the contents, or NULL if no file is open or if it is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read data from the stream
+    ///
+    /// After reading, the stream's reading position must be
+    /// advanced by the amount of bytes read.
+    ///
+    /// \param data Buffer where to copy the read data
+    /// \param size Desired number of bytes to read
+    ///
+    /// \return The number of bytes actually read, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 read(void* data, Int64 size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current reading position
+    ///
+    /// \param position The position to seek to, from the beginning
+    ///
+    /// \return The position actually sought to, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 seek(Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current reading position in the stream
+    ///
+    /// \return The current position, or -1 on error.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 tell();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the stream
+    ///
+    /// \return The total number of bytes available in the stream, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 getSize();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the whole contents of the stream
+    ///
+    /// \param size Receives the size of the contents, in bytes
+    ///
+    /// \return Pointer to the contents, or NULL if the stream is not open
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual const void* getContiguousData(std::size_t& size);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the mapping and close the file
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const char*       m_data;     ///< Contents of the file
+    Int64             m_size;     ///< Size of the file, in bytes
+    Int64             m_offset;   ///< Current reading position
+    bool              m_isOpen;   ///< Is a file open?
+    bool              m_isMapped; ///< Is m_data a mapping of the file (instead of m_buffer)?
+    std::vector<char> m_buffer;   ///< Contents of the file, on the systems that can't map files
+};
+
+} // namespace sf
+
+
+#endif // SFML_MAPPEDFILEINPUTSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::MappedFileInputStream
+/// \ingroup system
+///
+/// This class is a specialization of InputStream that
+/// reads from a file on disk, mapped in memory.
+///
+/// Unlike FileInputStream, the whole file is exposed as
+/// a contiguous block of memory by getData, so it can be
+/// used without any copy by the functions that load from
+/// memory. The file is paged in lazily by the system, as
+/// its contents are accessed.
+///
+/// Files are mapped on Unix-like systems (Linux, Android,
+/// macOS, iOS, BSD). On the other systems (Windows and
+/// Emscripten), the file is read in memory when it is opened.
+///
+/// Usage example:
+/// \code
+/// sf::MappedFileInputStream stream;
+/// sf::Font font;
+/// if (stream.open("font.ttf"))
+///     font.loadFromMemory(stream.getData(), static_cast<std::size_t>(stream.getSize()));
+///
+/// // The stream must outlive the font, which keeps using its data
+/// \endcode
+///
+/// InputStream, FileInputStream, MemoryInputStream
+///
+////////////////////////////////////////////////////////////
@@ -99,6 +99,16 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Int64 getSize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the whole contents of the stream
+    ///
+    /// \param size Receives the size of the contents, in bytes
+    ///
+    /// \return Pointer to the contents, or NULL if the stream is not open
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual const void* getContiguousData(std::size_t& size);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -158,6 +158,17 @@ public:
     ////////////////////////////////////////////////////////////
     String(const String& copy);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The characters are taken from \a other without being
+    /// copied, \a other is left empty.
+    ///
+    /// \param other Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    String(String&& other) noexcept;
+
     ////////////////////////////////////////////////////////////
     /// \brief Create a new sf::String from a UTF-8 encoded string
     ///
@@ -309,6 +320,16 @@ public:
     ////////////////////////////////////////////////////////////
     String& operator =(const String& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of move assignment operator
+    ///
+    /// \param right Instance to move, left empty
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    String& operator =(String&& right) noexcept;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of += operator to append an UTF-32 string
     ///
@@ -27,7 +27,9 @@
 template <typename T>
 String String::fromUtf8(T begin, T end)
 {
+    // A character takes at least one byte, reserving the byte count avoids reallocating while decoding
     String string;
+    string.m_string.reserve(static_cast<std::size_t>(std::distance(begin, end)));
     Utf8::toUtf32(begin, end, std::back_inserter(string.m_string));
     return string;
 }
@@ -54,7 +54,7 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     template <typename Rep, typename Period>
-    Time(const std::chrono::duration<Rep, Period>& duration);
+    constexpr Time(const std::chrono::duration<Rep, Period>& duration);
 
     ////////////////////////////////////////////////////////////
     /// \brief Return the time value as a number of seconds
@@ -64,7 +64,7 @@ public:
     /// \see `asMilliseconds`, `asMicroseconds`
     ///
     ////////////////////////////////////////////////////////////
-    float asSeconds() const;
+    constexpr float asSeconds() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Return the time value as a number of milliseconds
@@ -74,7 +74,7 @@ public:
     /// \see `asSeconds`, `asMicroseconds`
     ///
     ////////////////////////////////////////////////////////////
-    std::int32_t asMilliseconds() const;
+    constexpr std::int32_t asMilliseconds() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Return the time value as a number of microseconds
@@ -84,7 +84,7 @@ public:
     /// \see `asSeconds`, `asMilliseconds`
     ///
     ////////////////////////////////////////////////////////////
-    std::int64_t asMicroseconds() const;
+    constexpr std::int64_t asMicroseconds() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Return the time value as a `std::chrono::duration`
@@ -92,7 +92,7 @@ public:
     /// \return Time in microseconds
     ///
     ////////////////////////////////////////////////////////////
-    std::chrono::microseconds toDuration() const;
+    constexpr std::chrono::microseconds toDuration() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Implicit conversion to `std::chrono::duration`
@@ -101,7 +101,7 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     template <typename Rep, typename Period>
-    operator std::chrono::duration<Rep, Period>() const;
+    constexpr operator std::chrono::duration<Rep, Period>() const;
 
     ////////////////////////////////////////////////////////////
     // Static member data
@@ -127,7 +127,7 @@ private:
 /// \see `milliseconds`, `microseconds`
 ///
 ////////////////////////////////////////////////////////////
-Time seconds(float amount);
+constexpr Time seconds(float amount);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -140,7 +140,7 @@ Time seconds(float amount);
 /// \see `seconds`, `microseconds`
 ///
 ////////////////////////////////////////////////////////////
-Time milliseconds(std::int32_t amount);
+constexpr Time milliseconds(std::int32_t amount);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -153,7 +153,7 @@ Time milliseconds(std::int32_t amount);
 /// \see `seconds`, `milliseconds`
 ///
 ////////////////////////////////////////////////////////////
-Time microseconds(std::int64_t amount);
+constexpr Time microseconds(std::int64_t amount);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -165,7 +165,7 @@ Time microseconds(std::int64_t amount);
 /// \return `true` if both time values are equal
 ///
 ////////////////////////////////////////////////////////////
-bool operator==(Time left, Time right);
+constexpr bool operator==(Time left, Time right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -177,7 +177,7 @@ bool operator==(Time left, Time right);
 /// \return `true` if both time values are different
 ///
 ////////////////////////////////////////////////////////////
-bool operator!=(Time left, Time right);
+constexpr bool operator!=(Time left, Time right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -189,7 +189,7 @@ bool operator!=(Time left, Time right);
 /// \return `true` if `left` is lesser than `right`
 ///
 ////////////////////////////////////////////////////////////
-bool operator<(Time left, Time right);
+constexpr bool operator<(Time left, Time right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -201,7 +201,7 @@ bool operator<(Time left, Time right);
 /// \return `true` if `left` is greater than `right`
 ///
 ////////////////////////////////////////////////////////////
-bool operator>(Time left, Time right);
+constexpr bool operator>(Time left, Time right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -213,7 +213,7 @@ bool operator>(Time left, Time right);
 /// \return `true` if `left` is lesser or equal than `right`
 ///
 ////////////////////////////////////////////////////////////
-bool operator<=(Time left, Time right);
+constexpr bool operator<=(Time left, Time right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -225,7 +225,7 @@ bool operator<=(Time left, Time right);
 /// \return `true` if `left` is greater or equal than `right`
 ///
 ////////////////////////////////////////////////////////////
-bool operator>=(Time left, Time right);
+constexpr bool operator>=(Time left, Time right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -236,7 +236,7 @@ bool operator>=(Time left, Time right);
 /// \return Opposite of the time value
 ///
 ////////////////////////////////////////////////////////////
-Time operator-(Time right);
+constexpr Time operator-(Time right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -248,7 +248,7 @@ Time operator-(Time right);
 /// \return Sum of the two times values
 ///
 ////////////////////////////////////////////////////////////
-Time operator+(Time left, Time right);
+constexpr Time operator+(Time left, Time right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -272,7 +272,7 @@ Time& operator+=(Time& left, Time right);
 /// \return Difference of the two times values
 ///
 ////////////////////////////////////////////////////////////
-Time operator-(Time left, Time right);
+constexpr Time operator-(Time left, Time right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -296,7 +296,7 @@ Time& operator-=(Time& left, Time right);
 /// \return `left` multiplied by `right`
 ///
 ////////////////////////////////////////////////////////////
-Time operator*(Time left, float right);
+constexpr Time operator*(Time left, float right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -308,7 +308,7 @@ Time operator*(Time left, float right);
 /// \return `left` multiplied by `right`
 ///
 ////////////////////////////////////////////////////////////
-Time operator*(Time left, std::int64_t right);
+constexpr Time operator*(Time left, std::int64_t right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -320,7 +320,7 @@ Time operator*(Time left, std::int64_t right);
 /// \return `left` multiplied by `right`
 ///
 ////////////////////////////////////////////////////////////
-Time operator*(float left, Time right);
+constexpr Time operator*(float left, Time right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
@@ -332,7 +332,7 @@ Time operator*(float left, Time right);
 /// \return `left` multiplied by `right`
 ///
 ////////////////////////////////////////////////////////////
-Time operator*(std::int64_t left, Time right);
+constexpr Time operator*(std::int64_t left, Time right);
 
 ////////////////////////////////////////////////////////////
 /// \relates Time
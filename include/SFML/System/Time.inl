@@ -36,34 +36,34 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 template <typename Rep, typename Period>
-inline Time::Time(const std::chrono::duration<Rep, Period>& duration) : m_microseconds(duration)
+constexpr Time::Time(const std::chrono::duration<Rep, Period>& duration) : m_microseconds(duration)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
-inline float Time::asSeconds() const
+constexpr float Time::asSeconds() const
 {
     return std::chrono::duration<float>(m_microseconds).count();
 }
 
 
 ////////////////////////////////////////////////////////////
-inline std::int32_t Time::asMilliseconds() const
+constexpr std::int32_t Time::asMilliseconds() const
 {
     return std::chrono::duration_cast<std::chrono::duration<std::int32_t, std::milli>>(m_microseconds).count();
 }
 
 
 ////////////////////////////////////////////////////////////
-inline std::int64_t Time::asMicroseconds() const
+constexpr std::int64_t Time::asMicroseconds() const
 {
     return m_microseconds.count();
 }
 
 
 ////////////////////////////////////////////////////////////
-inline std::chrono::microseconds Time::toDuration() const
+constexpr std::chrono::microseconds Time::toDuration() const
 {
     return m_microseconds;
 }
@@ -71,84 +71,84 @@ inline std::chrono::microseconds Time::toDuration() const
 
 ////////////////////////////////////////////////////////////
 template <typename Rep, typename Period>
-inline Time::operator std::chrono::duration<Rep, Period>() const
+constexpr Time::operator std::chrono::duration<Rep, Period>() const
 {
     return m_microseconds;
 }
 
 
 ////////////////////////////////////////////////////////////
-inline Time seconds(float amount)
+constexpr Time seconds(float amount)
 {
     return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::duration<float>(amount));
 }
 
 
 ////////////////////////////////////////////////////////////
-inline Time milliseconds(std::int32_t amount)
+constexpr Time milliseconds(std::int32_t amount)
 {
     return std::chrono::milliseconds(amount);
 }
 
 
 ////////////////////////////////////////////////////////////
-inline Time microseconds(std::int64_t amount)
+constexpr Time microseconds(std::int64_t amount)
 {
     return std::chrono::microseconds(amount);
 }
 
 
 ////////////////////////////////////////////////////////////
-inline bool operator==(Time left, Time right)
+constexpr bool operator==(Time left, Time right)
 {
     return left.asMicroseconds() == right.asMicroseconds();
 }
 
 
 ////////////////////////////////////////////////////////////
-inline bool operator!=(Time left, Time right)
+constexpr bool operator!=(Time left, Time right)
 {
     return left.asMicroseconds() != right.asMicroseconds();
 }
 
 
 ////////////////////////////////////////////////////////////
-inline bool operator<(Time left, Time right)
+constexpr bool operator<(Time left, Time right)
 {
     return left.asMicroseconds() < right.asMicroseconds();
 }
 
 
 ////////////////////////////////////////////////////////////
-inline bool operator>(Time left, Time right)
+constexpr bool operator>(Time left, Time right)
 {
     return left.asMicroseconds() > right.asMicroseconds();
 }
 
 
 ////////////////////////////////////////////////////////////
-inline bool operator<=(Time left, Time right)
+constexpr bool operator<=(Time left, Time right)
 {
     return left.asMicroseconds() <= right.asMicroseconds();
 }
 
 
 ////////////////////////////////////////////////////////////
-inline bool operator>=(Time left, Time right)
+constexpr bool operator>=(Time left, Time right)
 {
     return left.asMicroseconds() >= right.asMicroseconds();
 }
 
 
 ////////////////////////////////////////////////////////////
-inline Time operator-(Time right)
+constexpr Time operator-(Time right)
 {
     return microseconds(-right.asMicroseconds());
 }
 
 
 ////////////////////////////////////////////////////////////
-inline Time operator+(Time left, Time right)
+constexpr Time operator+(Time left, Time right)
 {
     return microseconds(left.asMicroseconds() + right.asMicroseconds());
 }
@@ -162,7 +162,7 @@ inline Time& operator+=(Time& left, Time right)
 
 
 ////////////////////////////////////////////////////////////
-inline Time operator-(Time left, Time right)
+constexpr Time operator-(Time left, Time right)
 {
     return microseconds(left.asMicroseconds() - right.asMicroseconds());
 }
@@ -176,28 +176,28 @@ inline Time& operator-=(Time& left, Time right)
 
 
 ////////////////////////////////////////////////////////////
-inline Time operator*(Time left, float right)
+constexpr Time operator*(Time left, float right)
 {
     return seconds(left.asSeconds() * right);
 }
 
 
 ////////////////////////////////////////////////////////////
-inline Time operator*(Time left, std::int64_t right)
+constexpr Time operator*(Time left, std::int64_t right)
 {
     return microseconds(left.asMicroseconds() * right);
 }
 
 
 ////////////////////////////////////////////////////////////
-inline Time operator*(float left, Time right)
+constexpr Time operator*(float left, Time right)
 {
     return right * left;
 }
 
 
 ////////////////////////////////////////////////////////////
-inline Time operator*(std::int64_t left, Time right)
+constexpr Time operator*(std::int64_t left, Time right)
 {
     return right * left;
 }
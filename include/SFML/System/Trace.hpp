@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TRACE_HPP
+#define SFML_TRACE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+
+
+////////////////////////////////////////////////////////////
+// Trace scope macro, compiled out unless SFML_ENABLE_TRACING is defined
+////////////////////////////////////////////////////////////
+#define SFML_TRACE_CONCAT_IMPL(a, b) a##b
+#define SFML_TRACE_CONCAT(a, b)      SFML_TRACE_CONCAT_IMPL(a, b)
+
+#if defined(SFML_ENABLE_TRACING)
+
+    #define SFML_TRACE_SCOPE(name) sf::TraceScope SFML_TRACE_CONCAT(sfmlTraceScope, __LINE__)(name)
+
+#else
+
+    #define SFML_TRACE_SCOPE(name) ((void)0)
+
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Record the duration of the enclosing block in
+///        the trace of the calling thread
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API TraceScope : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Begin the scope
+    ///
+    /// \param name Name of the event, must be a string literal
+    ///             (or outlive the trace)
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TraceScope(const char* name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End the scope and record its event
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TraceScope();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const char* m_name;  ///< Name of the event
+    Int64       m_start; ///< Start time, in microseconds
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Access to the recorded trace events
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Trace
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record an event in the trace of the calling thread
+    ///
+    /// Each thread writes to its own ring buffer without any
+    /// lock; the oldest events are overwritten when it is full.
+    ///
+    /// \param name     Name of the event
+    /// \param start    Start time, in microseconds
+    /// \param duration Duration, in microseconds
+    ///
+    ////////////////////////////////////////////////////////////
+    static void record(const char* name, Int64 start, Int64 duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time of the trace clock
+    ///
+    /// \return Time elapsed since the first use of the trace, in microseconds
+    ///
+    ////////////////////////////////////////////////////////////
+    static Int64 now();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the recorded events as Chrome trace JSON
+    ///
+    /// The file can be opened in chrome://tracing or Perfetto.
+    /// Events recorded while the file is written may be missing
+    /// or incomplete.
+    ///
+    /// \param filename Path of the file to write
+    ///
+    /// \return True if the file was written successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool writeChromeTrace(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the recorded events of all the threads
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clear();
+};
+
+} // namespace sf
+
+
+#endif // SFML_TRACE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Trace
+/// \ingroup system
+///
+/// The hot paths of the graphics module (draws, text layout,
+/// glyph rasterization, texture uploads, shader compilation,
+/// image decoding) are instrumented with SFML_TRACE_SCOPE.
+/// The scopes are compiled out unless SFML_ENABLE_TRACING is
+/// defined (see SFML/Config.hpp), so release builds can ship
+/// with tracing enabled only when needed.
+///
+/// Usage example:
+/// \code
+/// void update()
+/// {
+///     SFML_TRACE_SCOPE("update");
+///     ...
+/// }
+///
+/// // when a hitch is detected
+/// sf::Trace::writeChromeTrace("hitch.json");
+/// \endcode
+///
+////////////////////////////////////////////////////////////
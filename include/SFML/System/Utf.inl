@@ -144,7 +144,10 @@ std::size_t Utf<8>::count(In begin, In end)
     std::size_t length = 0;
     while (begin < end)
     {
-        begin = next(begin, end);
+        if (static_cast<Uint8>(*begin) < 0x80)
+            ++begin;
+        else
+            begin = next(begin, end);
         ++length;
     }
 
@@ -254,6 +257,13 @@ Out Utf<8>::toUtf16(In begin, In end, Out output)
 {
     while (begin < end)
     {
+        // ASCII characters are the same in all encodings, they don't need the decoder
+        if (static_cast<Uint8>(*begin) < 0x80)
+        {
+            *output++ = static_cast<Uint8>(*begin++);
+            continue;
+        }
+
         Uint32 codepoint;
         begin = decode(begin, end, codepoint);
         output = Utf<16>::encode(codepoint, output);
@@ -269,6 +279,13 @@ Out Utf<8>::toUtf32(In begin, In end, Out output)
 {
     while (begin < end)
     {
+        // ASCII characters are the same in all encodings, they don't need the decoder
+        if (static_cast<Uint8>(*begin) < 0x80)
+        {
+            *output++ = static_cast<Uint8>(*begin++);
+            continue;
+        }
+
         Uint32 codepoint;
         begin = decode(begin, end, codepoint);
         *output++ = codepoint;
@@ -610,7 +627,13 @@ template <typename In, typename Out>
 Out Utf<32>::toUtf8(In begin, In end, Out output)
 {
     while (begin < end)
-        output = Utf<8>::encode(*begin++, output);
+    {
+        // ASCII characters are the same in all encodings, they don't need the encoder
+        if (*begin < 0x80)
+            *output++ = static_cast<Uint8>(*begin++);
+        else
+            output = Utf<8>::encode(*begin++, output);
+    }
 
     return output;
 }
@@ -620,7 +643,13 @@ template <typename In, typename Out>
 Out Utf<32>::toUtf16(In begin, In end, Out output)
 {
     while (begin < end)
-        output = Utf<16>::encode(*begin++, output);
+    {
+        // Characters below the surrogates are stored as is
+        if (*begin < 0xD800)
+            *output++ = static_cast<Uint16>(*begin++);
+        else
+            output = Utf<16>::encode(*begin++, output);
+    }
 
     return output;
 }
@@ -62,3 +62,52 @@ project "SFML_GRAPHICS"
    filter { "configurations:Release" }
       targetname "%{wks.name}"
       architecture "x86_64"
+
+
+project "SFML_GRAPHICS_BENCH"
+   kind "ConsoleApp"
+   dependson { "SFML_GRAPHICS" }
+   includedirs {    
+      "%{dir_inc}",
+      "%{dir_lib}/stb/include",
+      "%{dir_lib}/freetype/include", 
+      "%{dir_lib}/SDL2/include", 
+   }
+   libdirs {
+      "%{dir_bin}",
+      "%{dir_lib}/lib/%{cfg.platform}",
+   }
+   files { 
+      "%{wks.location}/../../bench/**.cpp",
+   }
+   links { "SFML_GRAPHICS", "freetype", "SDL2", "SDL2main" }
+   filter { "configurations:Debug" }
+      targetname "%{prj.name}d"
+      architecture "x86_64"
+   filter { "configurations:Release" }
+      targetname "%{prj.name}"
+      architecture "x86_64"
+
+project "SFML_GRAPHICS_REPLAY"
+   kind "ConsoleApp"
+   dependson { "SFML_GRAPHICS" }
+   includedirs {    
+      "%{dir_inc}",
+      "%{dir_lib}/stb/include",
+      "%{dir_lib}/freetype/include", 
+      "%{dir_lib}/SDL2/include", 
+   }
+   libdirs {
+      "%{dir_bin}",
+      "%{dir_lib}/lib/%{cfg.platform}",
+   }
+   files { 
+      "%{wks.location}/../../replay/**.cpp",
+   }
+   links { "SFML_GRAPHICS", "freetype", "SDL2", "SDL2main" }
+   filter { "configurations:Debug" }
+      targetname "%{prj.name}d"
+      architecture "x86_64"
+   filter { "configurations:Release" }
+      targetname "%{prj.name}"
+      architecture "x86_64"
@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+
+#include "SFML/System.hpp"
+#include "SFML/Graphics.hpp"
+#include "SFML/glad.h"
+
+
+//
+//  usage: SFML_GRAPHICS_REPLAY [--headless] capture.sfdc [passes]
+//
+//  replays the frames of a capture written by sf::DrawCapture, the given
+//  number of passes (10 by default) after a first warm-up pass that creates
+//  the textures. For each frame it reports the median over the passes of
+//  the CPU submission time (replay and flush) and of the total time (until
+//  glFinish returns), next to the duration of the frame in the application
+//  it was captured from, in microseconds.
+//
+//  --headless replays into a sf::RenderTexture of the captured size instead
+//  of the default framebuffer, the window is never shown nor swapped.
+//
+
+
+struct FrameTimes
+{
+    std::vector<double> submit;
+    std::vector<double> total;
+};
+
+
+double Median(std::vector<double>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+    return samples.empty() ? 0.0 : samples[samples.size() / 2];
+}
+
+
+int main(int argc, char** argv)
+{
+    bool headless = false;
+    std::vector<const char*> args;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--headless") == 0)
+            headless = true;
+        else
+            args.push_back(argv[i]);
+    };
+
+    if (args.empty())
+    {
+        printf("usage: SFML_GRAPHICS_REPLAY [--headless] capture.sfdc [passes]\n");
+        return -1;
+    };
+
+    int passes = (args.size() > 1) ? std::max(1, std::atoi(args[1])) : 10;
+
+    if (SDL_Init(SDL_INIT_EVENTS | SDL_INIT_VIDEO) < 0)
+    {
+        printf("Init SDL failed! %s\n", SDL_GetError());
+        return -1;
+    };
+
+    SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 2);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 1);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_ES);
+
+    // the window gets the captured size once the capture is loaded
+    SDL_Window* window = SDL_CreateWindow("SFML GRAPHICS REPLAY",
+                                          SDL_WINDOWPOS_UNDEFINED,
+                                          SDL_WINDOWPOS_UNDEFINED,
+                                          800,
+                                          600,
+                                          SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+    if (!window)
+    {
+        printf("Init SDL window failed! %s\n", SDL_GetError());
+        return -1;
+    };
+
+    SDL_GLContext glctx = SDL_GL_CreateContext(window);
+    if (!glctx)
+    {
+        printf("Init SDL OPENGL context failed! %s\n", SDL_GetError());
+        return -1;
+    };
+
+    SDL_GL_MakeCurrent(window, glctx);
+    SDL_GL_SetSwapInterval(0); // don't measure vsync
+
+    {
+        sf::DrawReplay replay;
+        if (!replay.loadFromFile(args[0]))
+            return -1;
+
+        sf::Vector2u size = replay.getTargetSize();
+        if ((size.x == 0) || (size.y == 0))
+            size = sf::Vector2u(800, 600);
+
+        SDL_SetWindowSize(window, static_cast<int>(size.x), static_cast<int>(size.y));
+        if (!headless)
+            SDL_ShowWindow(window);
+
+        sf::RenderWindow rw(static_cast<int>(size.x), static_cast<int>(size.y));
+        rw.onCreate();
+
+        sf::RenderTexture rtex;
+        if (headless && !rtex.create(size.x, size.y))
+        {
+            printf("Failed to create the offscreen render texture\n");
+            return -1;
+        };
+
+        sf::RenderTarget& target = headless ? static_cast<sf::RenderTarget&>(rtex) : rw;
+
+        const std::size_t frameCount = replay.getFrameCount();
+        printf("%s: %u frames, %ux%u, %d passes%s\n", args[0], static_cast<unsigned int>(frameCount),
+               size.x, size.y, passes, headless ? " (headless)" : "");
+
+        std::vector<FrameTimes> times(frameCount);
+
+        // the first pass creates the textures and warms up the pipeline
+        sf::Clock clock;
+        for (int pass = 0; pass <= passes; ++pass)
+        {
+            for (std::size_t i = 0; i < frameCount; ++i)
+            {
+                SDL_Event event;
+                while (SDL_PollEvent(&event)) {}
+
+                clock.restart();
+                if (!replay.replayFrame(i, target))
+                {
+                    printf("Frame %u is corrupt, replay stopped\n", static_cast<unsigned int>(i));
+                    return -1;
+                };
+
+                target.flush();
+                double submit = static_cast<double>(clock.getElapsedTime().asMicroseconds());
+
+                glFinish();
+                double total = static_cast<double>(clock.getElapsedTime().asMicroseconds());
+
+                if (headless)
+                    rtex.display();
+                else
+                    SDL_GL_SwapWindow(window);
+
+                if (pass > 0)
+                {
+                    times[i].submit.push_back(submit);
+                    times[i].total.push_back(total);
+                }
+            };
+        };
+
+        printf("\n%-8s %8s %8s %8s %8s %8s %12s %12s %12s\n", "frame", "draws", "vertices", "shaded", "skipped",
+               "uploads", "captured", "submit", "total");
+
+        double sumCaptured = 0.0;
+        double sumSubmit = 0.0;
+        double sumTotal = 0.0;
+        for (std::size_t i = 0; i < frameCount; ++i)
+        {
+            const sf::DrawReplay::FrameInfo& info = replay.getFrameInfo(i);
+            double captured = static_cast<double>(info.capturedTime.asMicroseconds());
+            double submit = Median(times[i].submit);
+            double total = Median(times[i].total);
+
+            printf("%-8u %8u %8u %8u %8u %8u %12.1f %12.1f %12.1f\n", static_cast<unsigned int>(i),
+                   static_cast<unsigned int>(info.draws), static_cast<unsigned int>(info.vertices),
+                   static_cast<unsigned int>(info.shadedDraws), static_cast<unsigned int>(info.skippedDraws),
+                   static_cast<unsigned int>(info.textureUploads), captured, submit, total);
+
+            sumCaptured += captured;
+            sumSubmit += submit;
+            sumTotal += total;
+        };
+
+        printf("\naverage: captured %.1f us, submit %.1f us, total %.1f us per frame\n",
+               sumCaptured / frameCount, sumSubmit / frameCount, sumTotal / frameCount);
+    } // release the GL resources while the context is still alive
+
+    SDL_GL_DeleteContext(glctx);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+
+    return 0;
+};
@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Allocator.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <atomic>
+#include <cstdlib>
+
+
+namespace
+{
+    sf::Mutex                         allocatorMutex;
+    sf::Allocator::AllocateCallback   allocateFunc   = NULL;
+    sf::Allocator::DeallocateCallback deallocateFunc = NULL;
+    void*                             allocatorData  = NULL;
+    std::atomic<sf::Uint64>           liveBlocks(0); // Blocks that must be freed by the current functions
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+bool Allocator::setCallbacks(AllocateCallback allocate, DeallocateCallback deallocate, void* userData)
+{
+    Lock lock(allocatorMutex);
+
+    if (liveBlocks.load() > 0)
+    {
+        err() << "Failed to set the allocator (blocks are still allocated)" << std::endl;
+        return false;
+    }
+
+    if ((allocate == NULL) != (deallocate == NULL))
+    {
+        err() << "Failed to set the allocator (the allocation and deallocation functions must be both set or both NULL)" << std::endl;
+        return false;
+    }
+
+    allocateFunc   = allocate;
+    deallocateFunc = deallocate;
+    allocatorData  = userData;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void* Allocator::allocate(std::size_t size, MemoryStats::Tag tag)
+{
+    void* block = allocateFunc ? allocateFunc(size, tag, allocatorData) : std::malloc(size);
+    if (!block)
+        return NULL;
+
+    ++liveBlocks;
+    priv::trackMemory(tag, 0, size);
+
+    return block;
+}
+
+
+////////////////////////////////////////////////////////////
+void Allocator::deallocate(void* block, std::size_t size, MemoryStats::Tag tag)
+{
+    if (!block)
+        return;
+
+    if (deallocateFunc)
+        deallocateFunc(block, size, tag, allocatorData);
+    else
+        std::free(block);
+
+    --liveBlocks;
+    priv::trackMemory(tag, size, 0);
+}
+
+} // namespace sf
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/AlphaHull.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // An outline that covers more than this fraction of its area isn't worth its extra vertices
+    const float maxCoverage = 0.9f;
+
+    float cross(const sf::Vector2f& a, const sf::Vector2f& b)
+    {
+        return a.x * b.y - a.y * b.x;
+    }
+
+    bool lessXY(const sf::Vector2f& a, const sf::Vector2f& b)
+    {
+        return (a.x < b.x) || ((a.x == b.x) && (a.y < b.y));
+    }
+
+    float polygonArea(const std::vector<sf::Vector2f>& polygon)
+    {
+        float area = 0.f;
+        for (std::size_t i = 0; i < polygon.size(); ++i)
+            area += cross(polygon[i], polygon[(i + 1) % polygon.size()]);
+
+        return std::abs(area) / 2.f;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool computeAlphaHull(const Image& image, const IntRect& area, std::size_t maxVertices, std::vector<Vector2f>& outline)
+{
+    outline.clear();
+
+    // Clamp the area to the image
+    Vector2u size = image.getSize();
+    int left   = std::max(area.left, 0);
+    int top    = std::max(area.top, 0);
+    int right  = std::min(area.left + area.width, static_cast<int>(size.x));
+    int bottom = std::min(area.top + area.height, static_cast<int>(size.y));
+    if ((maxVertices < 3) || (left >= right) || (top >= bottom))
+        return false;
+
+    // The hull of the visible pixels is the hull of the outer corners of the
+    // first and last visible pixel of each row
+    std::vector<Vector2f> points;
+    const Uint8* pixels = image.getPixelsPtr();
+    for (int y = top; y < bottom; ++y)
+    {
+        const Uint8* row = pixels + (static_cast<std::size_t>(y) * size.x) * 4;
+
+        int first = left;
+        while ((first < right) && (row[first * 4 + 3] == 0))
+            ++first;
+
+        if (first == right)
+            continue;
+
+        int last = right - 1;
+        while (row[last * 4 + 3] == 0)
+            --last;
+
+        float x0 = static_cast<float>(first - area.left);
+        float x1 = static_cast<float>(last + 1 - area.left);
+        float y0 = static_cast<float>(y - area.top);
+        float y1 = y0 + 1.f;
+
+        points.push_back(Vector2f(x0, y0));
+        points.push_back(Vector2f(x0, y1));
+        points.push_back(Vector2f(x1, y0));
+        points.push_back(Vector2f(x1, y1));
+    }
+
+    if (points.empty())
+        return false;
+
+    // Monotone chain, collinear points are dropped
+    std::sort(points.begin(), points.end(), lessXY);
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+
+    std::vector<Vector2f> hull(points.size() * 2);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        while ((count >= 2) && (cross(hull[count - 1] - hull[count - 2], points[i] - hull[count - 2]) <= 0.f))
+            --count;
+        hull[count++] = points[i];
+    }
+    for (std::size_t i = points.size() - 1, lower = count + 1; i > 0; --i)
+    {
+        while ((count >= lower) && (cross(hull[count - 1] - hull[count - 2], points[i - 1] - hull[count - 2]) <= 0.f))
+            --count;
+        hull[count++] = points[i - 1];
+    }
+    hull.resize(count - 1);
+
+    // Remove the edges one at a time, picking each time the one that adds the
+    // least area when its neighbour edges are extended to their intersection
+    float width  = static_cast<float>(area.width);
+    float height = static_cast<float>(area.height);
+    const float epsilon = 1e-3f;
+
+    while (hull.size() > maxVertices)
+    {
+        std::size_t n = hull.size();
+        std::size_t best = n;
+        float bestArea = 0.f;
+        Vector2f bestPoint;
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const Vector2f& a = hull[(i + n - 1) % n];
+            const Vector2f& b = hull[i];
+            const Vector2f& c = hull[(i + 1) % n];
+            const Vector2f& d = hull[(i + 2) % n];
+
+            // The extended edges only meet past b and c if they converge
+            Vector2f ab = b - a;
+            Vector2f dc = c - d;
+            float denominator = cross(ab, dc);
+            if (std::abs(denominator) < epsilon)
+                continue;
+
+            float t = cross(c - b, dc) / denominator;
+            float s = cross(c - b, ab) / denominator;
+            if ((t <= 0.f) || (s <= 0.f))
+                continue;
+
+            Vector2f p = b + ab * t;
+            if ((p.x < -epsilon) || (p.y < -epsilon) || (p.x > width + epsilon) || (p.y > height + epsilon))
+                continue;
+
+            float added = std::abs(cross(c - b, p - b)) / 2.f;
+            if ((best == n) || (added < bestArea))
+            {
+                best = i;
+                bestArea = added;
+                bestPoint = Vector2f(std::min(std::max(p.x, 0.f), width), std::min(std::max(p.y, 0.f), height));
+            }
+        }
+
+        if (best == n)
+            return false;
+
+        hull[best] = bestPoint;
+        hull.erase(hull.begin() + (best + 1) % n);
+    }
+
+    if (polygonArea(hull) > width * height * maxCoverage)
+        return false;
+
+    outline.swap(hull);
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
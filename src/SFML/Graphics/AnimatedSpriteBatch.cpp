@@ -0,0 +1,354 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/AnimatedSpriteBatch.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+
+namespace
+{
+    // Start at 1, zero is "never uploaded"
+    std::atomic<sf::Uint64> nextFramesId(1);
+
+    sf::Uint64 getUniqueFramesId()
+    {
+        return nextFramesId.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+AnimatedSpriteBatch::AnimatedSpriteBatch() :
+m_texture   (NULL),
+m_frames    (),
+m_framesId  (getUniqueFramesId()),
+m_items     (),
+m_time      (0.f),
+m_buffer    (0),
+m_bufferSize(0),
+m_dirtyBegin(0),
+m_dirtyEnd  (0),
+m_vertices  ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+AnimatedSpriteBatch::~AnimatedSpriteBatch()
+{
+    if (m_buffer)
+        priv::getGLStateCache().deleteBuffer(m_buffer);
+}
+
+
+////////////////////////////////////////////////////////////
+void AnimatedSpriteBatch::setTexture(const Texture* texture)
+{
+    m_texture = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* AnimatedSpriteBatch::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AnimatedSpriteBatch::addFrames(const IntRect* frames, std::size_t count)
+{
+    std::size_t first = getFrameCount();
+    if (first + count > MaxFrames)
+    {
+        err() << "Failed to add " << count << " frames to the animated sprite batch, "
+              << "the frame table is limited to " << MaxFrames << " frames" << std::endl;
+        return MaxFrames;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        m_frames.push_back(static_cast<float>(frames[i].left));
+        m_frames.push_back(static_cast<float>(frames[i].top));
+        m_frames.push_back(static_cast<float>(frames[i].width));
+        m_frames.push_back(static_cast<float>(frames[i].height));
+    }
+
+    m_framesId = getUniqueFramesId();
+
+    return first;
+}
+
+
+////////////////////////////////////////////////////////////
+void AnimatedSpriteBatch::setFrame(std::size_t index, const IntRect& frame)
+{
+    if (index >= getFrameCount())
+        return;
+
+    m_frames[index * 4 + 0] = static_cast<float>(frame.left);
+    m_frames[index * 4 + 1] = static_cast<float>(frame.top);
+    m_frames[index * 4 + 2] = static_cast<float>(frame.width);
+    m_frames[index * 4 + 3] = static_cast<float>(frame.height);
+
+    m_framesId = getUniqueFramesId();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AnimatedSpriteBatch::getFrameCount() const
+{
+    return m_frames.size() / 4;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AnimatedSpriteBatch::add(const Transform& transform, std::size_t firstFrame, std::size_t frameCount,
+                                     float frameRate, const Color& color)
+{
+    m_items.push_back(Item());
+    m_items.back().startTime = m_time;
+
+    std::size_t index = m_items.size() - 1;
+    set(index, transform, firstFrame, frameCount, frameRate, color);
+
+    return index;
+}
+
+
+////////////////////////////////////////////////////////////
+void AnimatedSpriteBatch::set(std::size_t index, const Transform& transform, std::size_t firstFrame, std::size_t frameCount,
+                              float frameRate, const Color& color)
+{
+    if (index >= m_items.size())
+        return;
+
+    // The shader indexes the frame table with these, they must stay inside of it
+    firstFrame = std::min<std::size_t>(firstFrame, MaxFrames - 1);
+    frameCount = std::max<std::size_t>(std::min<std::size_t>(frameCount, MaxFrames - firstFrame), 1);
+
+    Item& item = m_items[index];
+    item.transform  = transform;
+    item.color      = color;
+    item.firstFrame = static_cast<float>(firstFrame);
+    item.frameCount = static_cast<float>(frameCount);
+    item.frameRate  = frameRate;
+
+    invalidate(index);
+}
+
+
+////////////////////////////////////////////////////////////
+void AnimatedSpriteBatch::restart(std::size_t index)
+{
+    if (index >= m_items.size())
+        return;
+
+    m_items[index].startTime = m_time;
+    invalidate(index);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AnimatedSpriteBatch::getSpriteCount() const
+{
+    return m_items.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void AnimatedSpriteBatch::clear()
+{
+    m_items.clear();
+    m_time = 0.f;
+    m_dirtyBegin = 0;
+    m_dirtyEnd = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void AnimatedSpriteBatch::update(Time elapsed)
+{
+    m_time += elapsed.asSeconds();
+}
+
+
+////////////////////////////////////////////////////////////
+Time AnimatedSpriteBatch::getTime() const
+{
+    return seconds(m_time);
+}
+
+
+////////////////////////////////////////////////////////////
+bool AnimatedSpriteBatch::isGpuAnimationAvailable()
+{
+    return priv::isInstancingAvailable();
+}
+
+
+////////////////////////////////////////////////////////////
+void AnimatedSpriteBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_items.empty() || m_frames.empty())
+        return;
+
+    states.texture = m_texture;
+
+    if (isGpuAnimationAvailable() && !states.shader)
+    {
+        uploadSprites();
+        target.drawAnimatedInstances(m_buffer, m_items.size(), m_time, &m_frames[0], getFrameCount(), m_framesId, states);
+    }
+    else
+    {
+        animateSprites();
+        target.draw(&m_vertices[0], m_vertices.size(), Triangles, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void AnimatedSpriteBatch::uploadSprites() const
+{
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
+    if (!m_buffer)
+        glCheck(glGenBuffers(1, &m_buffer));
+
+    cache.bindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+    // The buffer grows by doubling, and is then entirely uploaded
+    if (m_bufferSize < m_items.size())
+    {
+        m_bufferSize = std::max<std::size_t>(m_items.size(), m_bufferSize * 2);
+        glCheck(glBufferData(GL_ARRAY_BUFFER, sizeof(priv::AnimatedInstance) * m_bufferSize, 0, GL_STATIC_DRAW));
+
+        m_dirtyBegin = 0;
+        m_dirtyEnd = m_items.size();
+    }
+
+    m_dirtyEnd = std::min(m_dirtyEnd, m_items.size());
+    if (m_dirtyBegin >= m_dirtyEnd)
+        return;
+
+    std::vector<priv::AnimatedInstance> instances(m_dirtyEnd - m_dirtyBegin);
+
+    for (std::size_t i = 0; i < instances.size(); ++i)
+    {
+        const Item& item = m_items[m_dirtyBegin + i];
+        const float* matrix = item.transform.getAffineMatrix();
+        priv::AnimatedInstance& instance = instances[i];
+
+        instance.row0[0] = matrix[0]; instance.row0[1] = matrix[1]; instance.row0[2] = matrix[2];
+        instance.row1[0] = matrix[3]; instance.row1[1] = matrix[4]; instance.row1[2] = matrix[5];
+
+        instance.animation[0] = item.firstFrame;
+        instance.animation[1] = item.frameCount;
+        instance.animation[2] = item.frameRate;
+        instance.animation[3] = item.startTime;
+
+        instance.color[0] = item.color.r;
+        instance.color[1] = item.color.g;
+        instance.color[2] = item.color.b;
+        instance.color[3] = item.color.a;
+    }
+
+    glCheck(glBufferSubData(GL_ARRAY_BUFFER, sizeof(priv::AnimatedInstance) * m_dirtyBegin,
+                            sizeof(priv::AnimatedInstance) * instances.size(), instances.data()));
+    priv::getRenderStats().bytesUploaded += sizeof(priv::AnimatedInstance) * instances.size();
+
+    m_dirtyBegin = 0;
+    m_dirtyEnd = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void AnimatedSpriteBatch::animateSprites() const
+{
+    // Same animation as the animation pipeline shader
+    static const float corners[4][2] = { {0.f, 0.f}, {0.f, 1.f}, {1.f, 1.f}, {1.f, 0.f} };
+    static const std::size_t order[6] = { 0, 1, 2, 0, 2, 3 };
+
+    std::size_t frameCount = getFrameCount();
+
+    m_vertices.resize(m_items.size() * 6);
+
+    for (std::size_t i = 0; i < m_items.size(); ++i)
+    {
+        const Item& item = m_items[i];
+
+        float step = std::floor((m_time - item.startTime) * item.frameRate);
+        std::size_t frame = static_cast<std::size_t>(item.firstFrame + (step - item.frameCount * std::floor(step / item.frameCount)) + 0.5f);
+
+        // Frames that are not in the table yet are empty
+        const float* rect = (frame < frameCount) ? &m_frames[frame * 4] : NULL;
+        float width = rect ? rect[2] : 0.f;
+        float height = rect ? rect[3] : 0.f;
+
+        for (std::size_t j = 0; j < 6; ++j)
+        {
+            float x = corners[order[j]][0];
+            float y = corners[order[j]][1];
+
+            Vertex& vertex = m_vertices[i * 6 + j];
+            vertex.position  = item.transform.transformPoint(x * width, y * height);
+            vertex.color     = item.color;
+            vertex.texCoords = rect ? Vector2f(rect[0] + x * width, rect[1] + y * height) : Vector2f();
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void AnimatedSpriteBatch::invalidate(std::size_t index)
+{
+    if (m_dirtyBegin >= m_dirtyEnd)
+    {
+        m_dirtyBegin = index;
+        m_dirtyEnd = index + 1;
+    }
+    else
+    {
+        m_dirtyBegin = std::min(m_dirtyBegin, index);
+        m_dirtyEnd = std::max(m_dirtyEnd, index + 1);
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,382 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/AssetBundle.hpp>
+#include <SFML/Graphics/AssetBundleFormat.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Check that [offset, offset + size) lies in a buffer of the given size, without overflowing
+    bool isRangeValid(sf::Uint64 offset, sf::Uint64 size, std::size_t total)
+    {
+        return (offset <= total) && (size <= total - offset);
+    }
+
+    // Compare a name stored in the bundle with a string, like std::string::compare
+    int compareName(const char* bytes, std::size_t length, const std::string& name)
+    {
+        int result = std::memcmp(bytes, name.data(), std::min(length, name.size()));
+        if (result != 0)
+            return result;
+
+        return (length < name.size()) ? -1 : ((length > name.size()) ? 1 : 0);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool parseBundleTexture(const void* data, std::size_t dataSize, BundleTexture& texture)
+{
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    if (!bytes || (dataSize < bundleTextureHeaderSize))
+        return false;
+
+    Uint32 pixelFormat = readBundleUint32(bytes);
+    Uint32 glFormat    = readBundleUint32(bytes + 4);
+    Uint32 flags       = readBundleUint32(bytes + 8);
+    Uint32 width       = readBundleUint32(bytes + 12);
+    Uint32 height      = readBundleUint32(bytes + 16);
+    Uint32 levelCount  = readBundleUint32(bytes + 20);
+
+    if ((pixelFormat > BundleCompressed) || (width == 0) || (height == 0) || (levelCount == 0) || (levelCount > 32) ||
+        !isRangeValid(bundleTextureHeaderSize, static_cast<Uint64>(levelCount) * bundleLevelEntrySize, dataSize))
+        return false;
+
+    texture.pixelFormat  = static_cast<BundlePixelFormat>(pixelFormat);
+    texture.image.format = (pixelFormat == BundleCompressed) ? glFormat : 0;
+    texture.image.sRgb   = (flags & bundleTextureSRgb) != 0;
+    texture.image.size   = Vector2u(width, height);
+    texture.image.levels.resize(levelCount);
+
+    // Uncompressed levels must have exactly the size of their texels
+    std::size_t bytesPerPixel = (pixelFormat == BundleRGBA8) ? 4 : 1;
+
+    Vector2u size(width, height);
+    for (Uint32 i = 0; i < levelCount; ++i)
+    {
+        const Uint8* entry = bytes + bundleTextureHeaderSize + i * bundleLevelEntrySize;
+        Uint64 offset = readBundleUint64(entry);
+        Uint64 length = readBundleUint64(entry + 8);
+
+        if (!isRangeValid(offset, length, dataSize) || (length == 0))
+            return false;
+
+        if ((pixelFormat != BundleCompressed) && (length != static_cast<Uint64>(size.x) * size.y * bytesPerPixel))
+            return false;
+
+        CompressedImage::Level& level = texture.image.levels[i];
+        level.data     = bytes + offset;
+        level.dataSize = static_cast<std::size_t>(length);
+        level.size     = size;
+
+        size = Vector2u(std::max(size.x / 2, 1u), std::max(size.y / 2, 1u));
+    }
+
+    return true;
+}
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+const std::size_t AssetBundle::NotFound = static_cast<std::size_t>(-1);
+
+
+////////////////////////////////////////////////////////////
+AssetBundle::AssetBundle() :
+m_data      (NULL),
+m_size      (0),
+m_entryCount(0),
+m_names     (NULL),
+m_namesSize (0),
+m_file      (),
+m_buffer    ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetBundle::openFromFile(const std::string& filename)
+{
+    close();
+
+    if (!m_file.open(filename))
+    {
+        err() << "Failed to open asset bundle \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    std::size_t size = 0;
+    const void* data = m_file.getContiguousData(size);
+    if (!open(data, size))
+    {
+        err() << "Failed to open asset bundle \"" << filename << "\" (invalid bundle)" << std::endl;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetBundle::openFromMemory(const void* data, std::size_t size)
+{
+    close();
+
+    if (!open(data, size))
+    {
+        err() << "Failed to open asset bundle from memory (invalid bundle)" << std::endl;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetBundle::openFromStream(InputStream& stream)
+{
+    close();
+
+    // Use the contents in place when the stream has them in memory
+    std::size_t size = 0;
+    const void* data = stream.getContiguousData(size);
+    if (!data)
+    {
+        Int64 streamSize = stream.getSize();
+        if ((streamSize <= 0) || (stream.seek(0) != 0))
+        {
+            err() << "Failed to open asset bundle from stream (empty or unreadable stream)" << std::endl;
+            return false;
+        }
+
+        m_buffer.resize(static_cast<std::size_t>(streamSize));
+        if (stream.read(&m_buffer[0], streamSize) != streamSize)
+        {
+            err() << "Failed to open asset bundle from stream (failed to read the stream)" << std::endl;
+            close();
+            return false;
+        }
+
+        data = &m_buffer[0];
+        size = m_buffer.size();
+    }
+
+    if (!open(data, size))
+    {
+        err() << "Failed to open asset bundle from stream (invalid bundle)" << std::endl;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetBundle::close()
+{
+    m_data       = NULL;
+    m_size       = 0;
+    m_entryCount = 0;
+    m_names      = NULL;
+    m_namesSize  = 0;
+
+    // Opening nothing releases the previous file
+    m_file.open("");
+    std::vector<Uint8>().swap(m_buffer);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AssetBundle::getEntryCount() const
+{
+    return m_entryCount;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AssetBundle::find(const std::string& name) const
+{
+    std::size_t first = 0;
+    std::size_t last = m_entryCount;
+    while (first < last)
+    {
+        std::size_t middle = first + (last - first) / 2;
+        const Uint8* entry = getIndexEntry(middle);
+        Uint32 offset = priv::readBundleUint32(entry + 4);
+        Uint32 length = priv::readBundleUint32(entry + 8);
+
+        int result = compareName(m_names + offset, length, name);
+        if (result == 0)
+            return middle;
+        else if (result < 0)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    return NotFound;
+}
+
+
+////////////////////////////////////////////////////////////
+std::string AssetBundle::getName(std::size_t index) const
+{
+    if (index >= m_entryCount)
+        return std::string();
+
+    const Uint8* entry = getIndexEntry(index);
+    Uint32 offset = priv::readBundleUint32(entry + 4);
+    Uint32 length = priv::readBundleUint32(entry + 8);
+
+    return std::string(m_names + offset, length);
+}
+
+
+////////////////////////////////////////////////////////////
+AssetBundle::EntryType AssetBundle::getType(std::size_t index) const
+{
+    if (index >= m_entryCount)
+        return EntryData;
+
+    return static_cast<EntryType>(priv::readBundleUint32(getIndexEntry(index)));
+}
+
+
+////////////////////////////////////////////////////////////
+const void* AssetBundle::getData(std::size_t index, std::size_t& size) const
+{
+    size = 0;
+    if (index >= m_entryCount)
+        return NULL;
+
+    const Uint8* entry = getIndexEntry(index);
+    size = static_cast<std::size_t>(priv::readBundleUint64(entry + 24));
+
+    return m_data + priv::readBundleUint64(entry + 16);
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetBundle::getAtlas(std::size_t index, std::size_t& texture, std::vector<Region>& regions) const
+{
+    regions.clear();
+
+    if (getType(index) != EntryAtlas)
+        return false;
+
+    std::size_t size = 0;
+    const Uint8* bytes = static_cast<const Uint8*>(getData(index, size));
+    if (size < priv::bundleAtlasHeaderSize)
+        return false;
+
+    Uint32 textureIndex = priv::readBundleUint32(bytes);
+    Uint32 regionCount  = priv::readBundleUint32(bytes + 4);
+    if ((textureIndex >= m_entryCount) || (getType(textureIndex) != EntryTexture) ||
+        !isRangeValid(priv::bundleAtlasHeaderSize, static_cast<Uint64>(regionCount) * priv::bundleRegionSize, size))
+        return false;
+
+    regions.resize(regionCount);
+    for (Uint32 i = 0; i < regionCount; ++i)
+    {
+        const Uint8* region = bytes + priv::bundleAtlasHeaderSize + i * priv::bundleRegionSize;
+        Uint32 nameOffset = priv::readBundleUint32(region);
+        Uint32 nameLength = priv::readBundleUint32(region + 4);
+        if (!isRangeValid(nameOffset, nameLength, m_namesSize))
+        {
+            regions.clear();
+            return false;
+        }
+
+        regions[i].name.assign(m_names + nameOffset, nameLength);
+        regions[i].rect.left   = static_cast<Int32>(priv::readBundleUint32(region + 8));
+        regions[i].rect.top    = static_cast<Int32>(priv::readBundleUint32(region + 12));
+        regions[i].rect.width  = static_cast<Int32>(priv::readBundleUint32(region + 16));
+        regions[i].rect.height = static_cast<Int32>(priv::readBundleUint32(region + 20));
+    }
+
+    texture = textureIndex;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetBundle::open(const void* data, std::size_t size)
+{
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    if (!bytes || (size < priv::bundleHeaderSize))
+        return false;
+
+    if ((priv::readBundleUint32(bytes) != priv::bundleMagic) || (priv::readBundleUint32(bytes + 4) != priv::bundleVersion))
+        return false;
+
+    Uint32 entryCount  = priv::readBundleUint32(bytes + 8);
+    Uint64 namesOffset = priv::readBundleUint64(bytes + 16);
+    Uint64 namesSize   = priv::readBundleUint64(bytes + 24);
+    if (!isRangeValid(priv::bundleHeaderSize, static_cast<Uint64>(entryCount) * priv::bundleIndexEntrySize, size) ||
+        !isRangeValid(namesOffset, namesSize, size))
+        return false;
+
+    // Check every entry once, so that the accessors don't have to
+    for (Uint32 i = 0; i < entryCount; ++i)
+    {
+        const Uint8* entry = bytes + priv::bundleHeaderSize + i * priv::bundleIndexEntrySize;
+        if ((priv::readBundleUint32(entry) > EntryGlyphCache) ||
+            !isRangeValid(priv::readBundleUint32(entry + 4), priv::readBundleUint32(entry + 8), static_cast<std::size_t>(namesSize)) ||
+            !isRangeValid(priv::readBundleUint64(entry + 16), priv::readBundleUint64(entry + 24), size))
+            return false;
+    }
+
+    m_data       = bytes;
+    m_size       = size;
+    m_entryCount = entryCount;
+    m_names      = reinterpret_cast<const char*>(bytes + namesOffset);
+    m_namesSize  = static_cast<std::size_t>(namesSize);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* AssetBundle::getIndexEntry(std::size_t index) const
+{
+    return m_data + priv::bundleHeaderSize + index * priv::bundleIndexEntrySize;
+}
+
+} // namespace sf
@@ -0,0 +1,377 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/AssetBundleWriter.hpp>
+#include <SFML/Graphics/AssetBundleFormat.hpp>
+#include <SFML/Graphics/CompressedImage.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+
+namespace
+{
+    // Round a size up to a multiple of alignment
+    std::size_t alignSize(std::size_t size, std::size_t alignment)
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    // Encode a texture payload: header, level table, then the 16 bytes aligned levels
+    void writeTexture(std::vector<sf::Uint8>& payload, sf::priv::BundlePixelFormat pixelFormat, const sf::priv::CompressedImage& image)
+    {
+        std::size_t levelCount = image.levels.size();
+        std::size_t offset = alignSize(sf::priv::bundleTextureHeaderSize + levelCount * sf::priv::bundleLevelEntrySize, sf::priv::bundleLevelAlignment);
+
+        std::size_t size = offset;
+        for (std::size_t i = 0; i < levelCount; ++i)
+            size = alignSize(size + image.levels[i].dataSize, sf::priv::bundleLevelAlignment);
+
+        payload.assign(size, 0);
+        sf::Uint8* bytes = &payload[0];
+        sf::priv::writeBundleUint32(bytes,      static_cast<sf::Uint32>(pixelFormat));
+        sf::priv::writeBundleUint32(bytes + 4,  (pixelFormat == sf::priv::BundleCompressed) ? image.format : 0);
+        sf::priv::writeBundleUint32(bytes + 8,  image.sRgb ? sf::priv::bundleTextureSRgb : 0);
+        sf::priv::writeBundleUint32(bytes + 12, image.size.x);
+        sf::priv::writeBundleUint32(bytes + 16, image.size.y);
+        sf::priv::writeBundleUint32(bytes + 20, static_cast<sf::Uint32>(levelCount));
+
+        for (std::size_t i = 0; i < levelCount; ++i)
+        {
+            const sf::priv::CompressedImage::Level& level = image.levels[i];
+            sf::Uint8* entry = bytes + sf::priv::bundleTextureHeaderSize + i * sf::priv::bundleLevelEntrySize;
+            sf::priv::writeBundleUint64(entry, offset);
+            sf::priv::writeBundleUint64(entry + 8, level.dataSize);
+
+            std::memcpy(bytes + offset, level.data, level.dataSize);
+            offset = alignSize(offset + level.dataSize, sf::priv::bundleLevelAlignment);
+        }
+    }
+
+    // Get the texels of an image in the format of the bundle
+    void convertPixels(const sf::Image& image, sf::Texture::Format format, std::vector<sf::Uint8>& pixels)
+    {
+        const sf::Uint8* source = image.getPixelsPtr();
+        std::size_t count = static_cast<std::size_t>(image.getSize().x) * image.getSize().y;
+
+        if (format == sf::Texture::R8)
+        {
+            pixels.resize(count);
+            for (std::size_t i = 0; i < count; ++i)
+                pixels[i] = source[4 * i];
+        }
+        else
+        {
+            pixels.assign(source, source + count * 4);
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+bool AssetBundleWriter::addData(const std::string& name, const void* data, std::size_t size)
+{
+    Entry* entry = addEntry(name, AssetBundle::EntryData);
+    if (!entry)
+        return false;
+
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    entry->payload.assign(bytes, bytes + size);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetBundleWriter::addTexture(const std::string& name, const Image& image, Texture::Format format, bool mipmaps, bool sRgb)
+{
+    if ((image.getSize().x == 0) || (image.getSize().y == 0))
+    {
+        err() << "Failed to add texture \"" << name << "\" to the asset bundle (the image is empty)" << std::endl;
+        return false;
+    }
+
+    if ((format != Texture::RGBA8) && (format != Texture::R8))
+    {
+        err() << "Failed to add texture \"" << name << "\" to the asset bundle (only RGBA8 and R8 can be bundled)" << std::endl;
+        return false;
+    }
+
+    // The texels are written from RGBA8 pixels
+    if (image.getPixelFormat() != Image::RGBA8)
+    {
+        Image expanded(image);
+        expanded.convert(Image::RGBA8);
+        return addTexture(name, expanded, format, mipmaps, sRgb);
+    }
+
+    std::vector<Image> chain;
+    if (mipmaps)
+        image.generateMipChain(chain, Image::BoxFilter, sRgb);
+
+    // Convert all the levels first, the texture header refers to them
+    std::vector<std::vector<Uint8> > pixels(chain.size() + 1);
+    priv::CompressedImage texels;
+    texels.format = 0;
+    texels.sRgb   = sRgb;
+    texels.size   = image.getSize();
+    texels.levels.resize(pixels.size());
+    for (std::size_t i = 0; i < pixels.size(); ++i)
+    {
+        const Image& level = (i == 0) ? image : chain[i - 1];
+        convertPixels(level, format, pixels[i]);
+
+        texels.levels[i].data     = &pixels[i][0];
+        texels.levels[i].dataSize = pixels[i].size();
+        texels.levels[i].size     = level.getSize();
+    }
+
+    Entry* entry = addEntry(name, AssetBundle::EntryTexture);
+    if (!entry)
+        return false;
+
+    writeTexture(entry->payload, (format == Texture::R8) ? priv::BundleR8 : priv::BundleRGBA8, texels);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetBundleWriter::addCompressedTexture(const std::string& name, const void* data, std::size_t size)
+{
+    priv::CompressedImage image;
+    if (!priv::parseCompressedImage(data, size, image))
+    {
+        err() << "Failed to add texture \"" << name << "\" to the asset bundle (invalid compressed file)" << std::endl;
+        return false;
+    }
+
+    Entry* entry = addEntry(name, AssetBundle::EntryTexture);
+    if (!entry)
+        return false;
+
+    writeTexture(entry->payload, priv::BundleCompressed, image);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetBundleWriter::addAtlas(const std::string& name, const std::string& texture, const std::vector<AssetBundle::Region>& regions)
+{
+    Entry* entry = addEntry(name, AssetBundle::EntryAtlas);
+    if (!entry)
+        return false;
+
+    // The index of the texture is only known once the entries are sorted
+    entry->texture = texture;
+    entry->regions = regions;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetBundleWriter::addGlyphCache(const std::string& name, const Font& font)
+{
+    std::vector<Uint8> cache;
+    if (!font.saveGlyphCache(cache))
+        return false;
+
+    Entry* entry = addEntry(name, AssetBundle::EntryGlyphCache);
+    if (!entry)
+        return false;
+
+    entry->payload.swap(cache);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetBundleWriter::saveToMemory(std::vector<Uint8>& data) const
+{
+    data.clear();
+
+    // The reader looks the entries up with a binary search
+    std::vector<const Entry*> sorted(m_entries.size());
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+        sorted[i] = &m_entries[i];
+
+    struct NameOrder
+    {
+        bool operator ()(const Entry* left, const Entry* right) const {return left->name < right->name;}
+    };
+    std::sort(sorted.begin(), sorted.end(), NameOrder());
+
+    // Names: the entries first, then the regions of the atlases
+    std::string names;
+    std::vector<std::size_t> nameOffsets(sorted.size());
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+    {
+        nameOffsets[i] = names.size();
+        names += sorted[i]->name;
+    }
+
+    // Encode the atlases, now that the texture indices are known
+    std::vector<std::vector<Uint8> > atlases(sorted.size());
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+    {
+        const Entry& entry = *sorted[i];
+        if (entry.type != AssetBundle::EntryAtlas)
+            continue;
+
+        std::size_t texture = sorted.size();
+        for (std::size_t j = 0; j < sorted.size(); ++j)
+        {
+            if ((sorted[j]->name == entry.texture) && (sorted[j]->type == AssetBundle::EntryTexture))
+                texture = j;
+        }
+
+        if (texture == sorted.size())
+        {
+            err() << "Failed to save the asset bundle, the texture \"" << entry.texture << "\" of atlas \""
+                  << entry.name << "\" is missing" << std::endl;
+            return false;
+        }
+
+        std::vector<Uint8>& payload = atlases[i];
+        payload.resize(priv::bundleAtlasHeaderSize + entry.regions.size() * priv::bundleRegionSize);
+        priv::writeBundleUint32(&payload[0], static_cast<Uint32>(texture));
+        priv::writeBundleUint32(&payload[4], static_cast<Uint32>(entry.regions.size()));
+
+        for (std::size_t j = 0; j < entry.regions.size(); ++j)
+        {
+            const AssetBundle::Region& region = entry.regions[j];
+            Uint8* bytes = &payload[priv::bundleAtlasHeaderSize + j * priv::bundleRegionSize];
+            priv::writeBundleUint32(bytes,      static_cast<Uint32>(names.size()));
+            priv::writeBundleUint32(bytes + 4,  static_cast<Uint32>(region.name.size()));
+            priv::writeBundleUint32(bytes + 8,  static_cast<Uint32>(region.rect.left));
+            priv::writeBundleUint32(bytes + 12, static_cast<Uint32>(region.rect.top));
+            priv::writeBundleUint32(bytes + 16, static_cast<Uint32>(region.rect.width));
+            priv::writeBundleUint32(bytes + 20, static_cast<Uint32>(region.rect.height));
+            names += region.name;
+        }
+    }
+
+    // Header, index and names, then the payloads each on their own pages
+    std::size_t namesOffset = priv::bundleHeaderSize + sorted.size() * priv::bundleIndexEntrySize;
+    std::size_t size = alignSize(namesOffset + names.size(), priv::bundleAlignment);
+    std::vector<std::size_t> payloadOffsets(sorted.size());
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+    {
+        const std::vector<Uint8>& payload = (sorted[i]->type == AssetBundle::EntryAtlas) ? atlases[i] : sorted[i]->payload;
+        payloadOffsets[i] = size;
+        size = alignSize(size + payload.size(), priv::bundleAlignment);
+    }
+
+    data.assign(size, 0);
+    priv::writeBundleUint32(&data[0],  priv::bundleMagic);
+    priv::writeBundleUint32(&data[4],  priv::bundleVersion);
+    priv::writeBundleUint32(&data[8],  static_cast<Uint32>(sorted.size()));
+    priv::writeBundleUint32(&data[12], static_cast<Uint32>(priv::bundleAlignment));
+    priv::writeBundleUint64(&data[16], namesOffset);
+    priv::writeBundleUint64(&data[24], names.size());
+
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+    {
+        const std::vector<Uint8>& payload = (sorted[i]->type == AssetBundle::EntryAtlas) ? atlases[i] : sorted[i]->payload;
+        Uint8* entry = &data[priv::bundleHeaderSize + i * priv::bundleIndexEntrySize];
+        priv::writeBundleUint32(entry,      static_cast<Uint32>(sorted[i]->type));
+        priv::writeBundleUint32(entry + 4,  static_cast<Uint32>(nameOffsets[i]));
+        priv::writeBundleUint32(entry + 8,  static_cast<Uint32>(sorted[i]->name.size()));
+        priv::writeBundleUint64(entry + 16, payloadOffsets[i]);
+        priv::writeBundleUint64(entry + 24, payload.size());
+
+        if (!payload.empty())
+            std::memcpy(&data[payloadOffsets[i]], &payload[0], payload.size());
+    }
+
+    if (!names.empty())
+        std::memcpy(&data[namesOffset], names.data(), names.size());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AssetBundleWriter::saveToFile(const std::string& filename) const
+{
+    std::vector<Uint8> data;
+    if (!saveToMemory(data))
+        return false;
+
+    std::FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file)
+    {
+        err() << "Failed to save the asset bundle to \"" << filename << "\" (cannot open the file)" << std::endl;
+        return false;
+    }
+
+    bool written = (std::fwrite(&data[0], 1, data.size(), file) == data.size());
+    if (std::fclose(file) != 0)
+        written = false;
+
+    if (!written)
+        err() << "Failed to save the asset bundle to \"" << filename << "\" (write error)" << std::endl;
+
+    return written;
+}
+
+
+////////////////////////////////////////////////////////////
+void AssetBundleWriter::clear()
+{
+    m_entries.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+AssetBundleWriter::Entry* AssetBundleWriter::addEntry(const std::string& name, AssetBundle::EntryType type)
+{
+    for (std::vector<Entry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->name == name)
+        {
+            err() << "Failed to add \"" << name << "\" to the asset bundle (the name is already taken)" << std::endl;
+            return NULL;
+        }
+    }
+
+    m_entries.push_back(Entry());
+    m_entries.back().name = name;
+    m_entries.back().type = type;
+
+    return &m_entries.back();
+}
+
+} // namespace sf
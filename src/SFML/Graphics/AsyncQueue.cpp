@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/AsyncQueue.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Trace.hpp>
+#include <vector>
+
+
+namespace
+{
+    // Continuation waiting for its operation
+    struct Operation
+    {
+        sf::AsyncQueue::Poll         poll;         // Function telling whether the operation is complete (empty if it is)
+        sf::AsyncQueue::Continuation continuation; // Function to call once it is
+        bool                         ready;        // Did the poll function return true?
+    };
+
+    // Operations posted and not resumed yet
+    struct OperationList
+    {
+        sf::Mutex              mutex;
+        std::vector<Operation> operations;
+    };
+
+    OperationList& getOperations()
+    {
+        static OperationList list;
+        return list;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+void AsyncQueue::post(const Continuation& continuation)
+{
+    post(Poll(), continuation);
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncQueue::post(const Poll& poll, const Continuation& continuation)
+{
+    Operation operation = {poll, continuation, !poll};
+
+    OperationList& list = getOperations();
+    Lock lock(list.mutex);
+    list.operations.push_back(operation);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AsyncQueue::pump(Time budget)
+{
+    SFML_TRACE_SCOPE("AsyncQueue::pump");
+
+    Clock clock;
+    OperationList& list = getOperations();
+
+    // Take the operations posted so far, the continuations may post new ones
+    std::vector<Operation> operations;
+    {
+        Lock lock(list.mutex);
+        operations.swap(list.operations);
+    }
+
+    std::size_t resumed = 0;
+    std::vector<Operation> remaining;
+    for (std::size_t i = 0; i < operations.size(); ++i)
+    {
+        Operation& operation = operations[i];
+
+        // Once the budget is spent, the other operations aren't even polled
+        if ((resumed == 0) || (clock.getElapsedTime() < budget))
+        {
+            if (!operation.ready)
+                operation.ready = operation.poll();
+
+            if (operation.ready)
+            {
+                operation.continuation();
+                ++resumed;
+                continue;
+            }
+        }
+
+        remaining.push_back(operation);
+    }
+
+    // Put the operations that are not resumed yet before the ones posted in the meantime
+    {
+        Lock lock(list.mutex);
+        remaining.insert(remaining.end(), list.operations.begin(), list.operations.end());
+        list.operations.swap(remaining);
+    }
+
+    return resumed;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AsyncQueue::getPendingCount()
+{
+    OperationList& list = getOperations();
+    Lock lock(list.mutex);
+    return list.operations.size();
+}
+
+} // namespace sf
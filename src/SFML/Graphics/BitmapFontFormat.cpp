@@ -0,0 +1,392 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/BitmapFontFormat.hpp>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace
+{
+    // Format specification: http://www.angelcode.com/products/bmfont/doc/file_format.html
+    const std::size_t binaryHeaderSize = 4;
+    const std::size_t binaryCharSize = 20;
+    const std::size_t binaryKerningSize = 10;
+
+    // Glyphs store their page in 8 bits in the binary format, fonts can't have more pages
+    const int maxPages = 256;
+
+    inline sf::Uint32 readUint16(const sf::Uint8* bytes)
+    {
+        return bytes[0] | (bytes[1] << 8);
+    }
+
+    inline int readInt16(const sf::Uint8* bytes)
+    {
+        return static_cast<sf::Int16>(readUint16(bytes));
+    }
+
+    inline sf::Uint32 readUint32(const sf::Uint8* bytes)
+    {
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<sf::Uint32>(bytes[3]) << 24);
+    }
+
+    inline bool isSpace(char character)
+    {
+        return (character == ' ') || (character == '\t') || (character == '\r');
+    }
+
+    // Read the next key=value pair of a line of the text format, values may be quoted
+    bool readAttribute(const char*& cursor, const char* end, std::string& key, std::string& value)
+    {
+        while ((cursor < end) && isSpace(*cursor))
+            ++cursor;
+
+        const char* keyBegin = cursor;
+        while ((cursor < end) && (*cursor != '=') && !isSpace(*cursor))
+            ++cursor;
+        key.assign(keyBegin, cursor);
+
+        if ((cursor >= end) || (*cursor != '='))
+        {
+            // A word without value, such as the tag of the line
+            value.clear();
+            return !key.empty();
+        }
+
+        ++cursor;
+        const char* valueBegin = cursor;
+        if ((cursor < end) && (*cursor == '"'))
+        {
+            valueBegin = ++cursor;
+            while ((cursor < end) && (*cursor != '"'))
+                ++cursor;
+            value.assign(valueBegin, cursor);
+            if (cursor < end)
+                ++cursor;
+        }
+        else
+        {
+            while ((cursor < end) && !isSpace(*cursor))
+                ++cursor;
+            value.assign(valueBegin, cursor);
+        }
+
+        return true;
+    }
+
+    int toInt(const std::string& value)
+    {
+        return static_cast<int>(std::strtol(value.c_str(), NULL, 10));
+    }
+
+    bool parseText(const char* data, std::size_t dataSize, sf::priv::BitmapFontDescriptor& descriptor, const char*& error)
+    {
+        const char* end = data + dataSize;
+        const char* line = data;
+        bool hasCommon = false;
+
+        while (line < end)
+        {
+            const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(end - line)));
+            if (!lineEnd)
+                lineEnd = end;
+
+            // The first word of the line tells what it describes
+            const char* cursor = line;
+            std::string tag, key, value;
+            readAttribute(cursor, lineEnd, tag, value);
+
+            if (tag == "common")
+                hasCommon = true;
+
+            sf::priv::BitmapFontDescriptor::Char glyph = {0, 0, 0, 0, 0, 0, 0, 0, 0, 15};
+            sf::priv::BitmapFontDescriptor::KerningPair pair = {0, 0, 0};
+            int pageId = -1;
+            std::string pageFile;
+
+            while (readAttribute(cursor, lineEnd, key, value))
+            {
+                if (tag == "info")
+                {
+                    if (key == "size")      descriptor.size = std::abs(toInt(value));
+                    else if (key == "face") descriptor.face = value;
+                }
+                else if (tag == "common")
+                {
+                    if (key == "lineHeight")     descriptor.lineHeight = toInt(value);
+                    else if (key == "base")      descriptor.base = toInt(value);
+                    else if (key == "pages")
+                    {
+                        const int pageCount = toInt(value);
+                        if ((pageCount < 0) || (pageCount > maxPages))
+                        {
+                            error = "invalid page count";
+                            return false;
+                        }
+
+                        descriptor.pages.resize(static_cast<std::size_t>(pageCount));
+                    }
+                    else if (key == "alphaChnl") descriptor.alphaChannel = static_cast<unsigned int>(toInt(value));
+                }
+                else if (tag == "page")
+                {
+                    if (key == "id")        pageId = toInt(value);
+                    else if (key == "file") pageFile = value;
+                }
+                else if (tag == "char")
+                {
+                    if (key == "id")            glyph.id = static_cast<sf::Uint32>(toInt(value));
+                    else if (key == "x")        glyph.x = toInt(value);
+                    else if (key == "y")        glyph.y = toInt(value);
+                    else if (key == "width")    glyph.width = toInt(value);
+                    else if (key == "height")   glyph.height = toInt(value);
+                    else if (key == "xoffset")  glyph.xOffset = toInt(value);
+                    else if (key == "yoffset")  glyph.yOffset = toInt(value);
+                    else if (key == "xadvance") glyph.xAdvance = toInt(value);
+                    else if (key == "page")     glyph.page = static_cast<unsigned int>(toInt(value));
+                    else if (key == "chnl")     glyph.channels = static_cast<unsigned int>(toInt(value));
+                }
+                else if (tag == "kerning")
+                {
+                    if (key == "first")       pair.first = static_cast<sf::Uint32>(toInt(value));
+                    else if (key == "second") pair.second = static_cast<sf::Uint32>(toInt(value));
+                    else if (key == "amount") pair.amount = toInt(value);
+                }
+            }
+
+            if (tag == "page")
+            {
+                if ((pageId < 0) || (pageId >= maxPages))
+                {
+                    error = "invalid page index";
+                    return false;
+                }
+
+                if (static_cast<std::size_t>(pageId) >= descriptor.pages.size())
+                    descriptor.pages.resize(static_cast<std::size_t>(pageId) + 1);
+                descriptor.pages[static_cast<std::size_t>(pageId)] = pageFile;
+            }
+            else if (tag == "char")
+            {
+                descriptor.chars.push_back(glyph);
+            }
+            else if (tag == "kerning")
+            {
+                descriptor.kerning.push_back(pair);
+            }
+
+            line = lineEnd + 1;
+        }
+
+        if (!hasCommon)
+        {
+            error = "missing common line";
+            return false;
+        }
+
+        return true;
+    }
+
+    bool parseBinary(const sf::Uint8* data, std::size_t dataSize, sf::priv::BitmapFontDescriptor& descriptor, const char*& error)
+    {
+        if (data[3] != 3)
+        {
+            error = "unsupported binary version";
+            return false;
+        }
+
+        bool hasCommon = false;
+        std::size_t position = binaryHeaderSize;
+        while (position < dataSize)
+        {
+            if (dataSize - position < 5)
+            {
+                error = "truncated block";
+                return false;
+            }
+
+            sf::Uint8 type = data[position];
+            std::size_t size = readUint32(data + position + 1);
+            position += 5;
+            if (size > dataSize - position)
+            {
+                error = "truncated block";
+                return false;
+            }
+
+            const sf::Uint8* block = data + position;
+            position += size;
+
+            if ((type == 1) && (size >= 14))
+            {
+                descriptor.size = std::abs(readInt16(block));
+
+                // The name is null terminated, after the fixed fields
+                const char* name = reinterpret_cast<const char*>(block + 14);
+                const char* nameEnd = static_cast<const char*>(std::memchr(name, 0, size - 14));
+                descriptor.face.assign(name, nameEnd ? nameEnd : name + size - 14);
+            }
+            else if ((type == 2) && (size >= 12))
+            {
+                descriptor.lineHeight   = static_cast<int>(readUint16(block));
+                descriptor.base         = static_cast<int>(readUint16(block + 2));
+                descriptor.alphaChannel = block[11];
+                if (static_cast<int>(readUint16(block + 8)) > maxPages)
+                {
+                    error = "invalid page count";
+                    return false;
+                }
+
+                descriptor.pages.resize(readUint16(block + 8));
+                hasCommon = true;
+            }
+            else if (type == 3)
+            {
+                // Null terminated names, in page order
+                std::size_t page = 0;
+                const sf::Uint8* name = block;
+                while (name < block + size)
+                {
+                    const sf::Uint8* nameEnd = static_cast<const sf::Uint8*>(std::memchr(name, 0, static_cast<std::size_t>(block + size - name)));
+                    if (!nameEnd)
+                        nameEnd = block + size;
+
+                    if (page >= static_cast<std::size_t>(maxPages))
+                    {
+                        error = "invalid page count";
+                        return false;
+                    }
+
+                    if (page >= descriptor.pages.size())
+                        descriptor.pages.resize(page + 1);
+                    descriptor.pages[page++].assign(reinterpret_cast<const char*>(name), reinterpret_cast<const char*>(nameEnd));
+                    name = nameEnd + 1;
+                }
+            }
+            else if (type == 4)
+            {
+                for (std::size_t i = 0; i + binaryCharSize <= size; i += binaryCharSize)
+                {
+                    const sf::Uint8* entry = block + i;
+                    sf::priv::BitmapFontDescriptor::Char glyph;
+                    glyph.id       = readUint32(entry);
+                    glyph.x        = static_cast<int>(readUint16(entry + 4));
+                    glyph.y        = static_cast<int>(readUint16(entry + 6));
+                    glyph.width    = static_cast<int>(readUint16(entry + 8));
+                    glyph.height   = static_cast<int>(readUint16(entry + 10));
+                    glyph.xOffset  = readInt16(entry + 12);
+                    glyph.yOffset  = readInt16(entry + 14);
+                    glyph.xAdvance = readInt16(entry + 16);
+                    glyph.page     = entry[18];
+                    glyph.channels = entry[19];
+                    descriptor.chars.push_back(glyph);
+                }
+            }
+            else if (type == 5)
+            {
+                for (std::size_t i = 0; i + binaryKerningSize <= size; i += binaryKerningSize)
+                {
+                    const sf::Uint8* entry = block + i;
+                    sf::priv::BitmapFontDescriptor::KerningPair pair;
+                    pair.first  = readUint32(entry);
+                    pair.second = readUint32(entry + 4);
+                    pair.amount = readInt16(entry + 8);
+                    descriptor.kerning.push_back(pair);
+                }
+            }
+        }
+
+        if (!hasCommon)
+        {
+            error = "missing common block";
+            return false;
+        }
+
+        return true;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool parseBitmapFont(const void* data, std::size_t dataSize, BitmapFontDescriptor& descriptor, const char*& error)
+{
+    descriptor.face.clear();
+    descriptor.size         = 0;
+    descriptor.lineHeight   = 0;
+    descriptor.base         = 0;
+    descriptor.alphaChannel = 0;
+    descriptor.pages.clear();
+    descriptor.chars.clear();
+    descriptor.kerning.clear();
+
+    if (!data || (dataSize == 0))
+    {
+        error = "empty descriptor";
+        return false;
+    }
+
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    bool parsed = false;
+    if ((dataSize >= binaryHeaderSize) && (std::memcmp(bytes, "BMF", 3) == 0))
+        parsed = parseBinary(bytes, dataSize, descriptor, error);
+    else
+        parsed = parseText(static_cast<const char*>(data), dataSize, descriptor, error);
+
+    if (!parsed)
+        return false;
+
+    if (descriptor.lineHeight <= 0)
+    {
+        error = "invalid line height";
+        return false;
+    }
+
+    // The descriptor doesn't always give the drawing size, the line height is close to it
+    if (descriptor.size == 0)
+        descriptor.size = descriptor.lineHeight;
+
+    for (std::size_t i = 0; i < descriptor.chars.size(); ++i)
+    {
+        const BitmapFontDescriptor::Char& glyph = descriptor.chars[i];
+        if ((glyph.page >= descriptor.pages.size()) || (glyph.width < 0) || (glyph.height < 0) || (glyph.x < 0) || (glyph.y < 0))
+        {
+            error = "invalid character";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -43,6 +43,9 @@ const BlendMode BlendMultiply(BlendMode::DstColor, BlendMode::Zero);
 
 const BlendMode BlendNone(BlendMode::One, BlendMode::Zero);
 
+const BlendMode BlendPremultipliedAlpha(BlendMode::One, BlendMode::OneMinusSrcAlpha, BlendMode::Add,
+                                        BlendMode::One, BlendMode::OneMinusSrcAlpha, BlendMode::Add);
+
 
 ////////////////////////////////////////////////////////////
 BlendMode::BlendMode() :
@@ -84,6 +87,18 @@ alphaEquation (alphaBlendEquation)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint32 BlendMode::getKey() const
+{
+    return (static_cast<Uint32>(colorSrcFactor) << 18) |
+           (static_cast<Uint32>(colorDstFactor) << 14) |
+           (static_cast<Uint32>(colorEquation)  << 11) |
+           (static_cast<Uint32>(alphaSrcFactor) << 7)  |
+           (static_cast<Uint32>(alphaDstFactor) << 3)  |
+           (static_cast<Uint32>(alphaEquation));
+}
+
+
 ////////////////////////////////////////////////////////////
 bool operator ==(const BlendMode& left, const BlendMode& right)
 {
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/BrowserImageDecoder.hpp>
+
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+    #include <emscripten/emscripten.h>
+    #include <emscripten/em_js.h>
+#endif
+
+
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+
+namespace
+{
+    struct BrowserRequest
+    {
+        sf::priv::BrowserImageStorage storage;
+        sf::priv::BrowserImageDone    done;
+        void*                         userData;
+    };
+}
+
+
+extern "C"
+{
+    // Called by the promise of createImageBitmap, to get the texture to upload to
+    EMSCRIPTEN_KEEPALIVE int sfmlBrowserImageStorage(BrowserRequest* request, int width, int height)
+    {
+        return request->storage(static_cast<unsigned int>(width), static_cast<unsigned int>(height), request->userData) ? 1 : 0;
+    }
+
+    // Called once per request, after the upload or when the decode failed
+    EMSCRIPTEN_KEEPALIVE void sfmlBrowserImageDone(BrowserRequest* request, int success)
+    {
+        request->done(success != 0, request->userData);
+        delete request;
+    }
+}
+
+
+// The bytes are sliced out of the heap: blobs can't be made from a shared buffer,
+// and the caller may release its data before the decode is done
+EM_JS(int, sfmlDecodeImage, (const void* data, int size, int premultiply, BrowserRequest* request),
+{
+    if ((typeof createImageBitmap === 'undefined') || (typeof Blob === 'undefined'))
+        return 0;
+
+    // Workers without OffscreenCanvas proxy their GL calls to the main thread
+    // (OFFSCREEN_FRAMEBUFFER), they have no context to upload the bitmap with
+    if ((typeof GLctx === 'undefined') || !GLctx)
+        return 0;
+
+    var blob = new Blob([HEAPU8.slice(data, data + size)]);
+    var options = {premultiplyAlpha: premultiply ? 'premultiply' : 'none', colorSpaceConversion: 'none'};
+
+    createImageBitmap(blob, options).then(function(bitmap)
+    {
+        var success = 0;
+        if (_sfmlBrowserImageStorage(request, bitmap.width, bitmap.height))
+        {
+            // The UNPACK_FLIP_Y and UNPACK_PREMULTIPLY_ALPHA settings don't apply to bitmaps
+            GLctx.texSubImage2D(GLctx.TEXTURE_2D, 0, 0, 0, GLctx.RGBA, GLctx.UNSIGNED_BYTE, bitmap);
+            success = 1;
+        }
+
+        bitmap.close();
+        _sfmlBrowserImageDone(request, success);
+    },
+    function()
+    {
+        _sfmlBrowserImageDone(request, 0);
+    });
+
+    return 1;
+});
+
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+
+////////////////////////////////////////////////////////////
+bool decodeImageInBrowser(const void* data, std::size_t size, bool premultiply,
+                          BrowserImageStorage storage, BrowserImageDone done, void* userData)
+{
+    if (!data || (size == 0))
+        return false;
+
+    BrowserRequest* request = new BrowserRequest;
+    request->storage  = storage;
+    request->done     = done;
+    request->userData = userData;
+
+    if (!sfmlDecodeImage(data, static_cast<int>(size), premultiply ? 1 : 0, request))
+    {
+        delete request;
+        return false;
+    }
+
+    return true;
+}
+
+#else
+
+////////////////////////////////////////////////////////////
+bool decodeImageInBrowser(const void* /* data */, std::size_t /* size */, bool /* premultiply */,
+                          BrowserImageStorage /* storage */, BrowserImageDone /* done */, void* /* userData */)
+{
+    // Native builds decode with stb_image, see ImageLoader
+    return false;
+}
+
+#endif
+
+} // namespace priv
+
+} // namespace sf
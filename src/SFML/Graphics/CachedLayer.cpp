@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CachedLayer.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Same as sf::BlendAlpha for the colors, but the alpha of the destination
+    // accumulates like the colors: the texture ends up premultiplied
+    const sf::BlendMode premultiplyingAlpha(sf::BlendMode::SrcAlpha, sf::BlendMode::OneMinusSrcAlpha, sf::BlendMode::Add,
+                                            sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha, sf::BlendMode::Add);
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CachedLayer::CachedLayer() :
+m_renderTexture(),
+m_size         (0, 0),
+m_scale        (1.f),
+m_clearColor   (Color::Transparent),
+m_children     (),
+m_invalidated  (true),
+m_renderCount  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool CachedLayer::create(unsigned int width, unsigned int height, float resolutionScale)
+{
+    if ((width == 0) || (height == 0) || !(resolutionScale > 0.f))
+    {
+        err() << "Failed to create cached layer, invalid size (" << width << "x" << height
+              << ", scale " << resolutionScale << ")" << std::endl;
+        return false;
+    }
+
+    unsigned int pixelWidth  = std::max(static_cast<unsigned int>(std::ceil(width * resolutionScale)), 1u);
+    unsigned int pixelHeight = std::max(static_cast<unsigned int>(std::ceil(height * resolutionScale)), 1u);
+
+    if (!m_renderTexture.create(pixelWidth, pixelHeight))
+    {
+        err() << "Failed to create cached layer, the render texture couldn't be created" << std::endl;
+        return false;
+    }
+
+    // The drawables keep their local coordinates, only the resolution changes
+    m_renderTexture.setView(View(FloatRect(0.f, 0.f, static_cast<float>(width), static_cast<float>(height))));
+    m_renderTexture.setSmooth(resolutionScale != 1.f);
+
+    m_size        = Vector2u(width, height);
+    m_scale       = resolutionScale;
+    m_invalidated = true;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u CachedLayer::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+float CachedLayer::getResolutionScale() const
+{
+    return m_scale;
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::add(const Drawable& drawable, const RenderStates& states)
+{
+    Child child;
+    child.drawable         = &drawable;
+    child.states           = states;
+    child.transformable    = NULL;
+    child.transformVersion = 0;
+    child.textureContent   = 0;
+
+    m_children.push_back(child);
+    m_invalidated = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::add(const Drawable& drawable, const Transformable& transformable, const RenderStates& states)
+{
+    Child child;
+    child.drawable         = &drawable;
+    child.states           = states;
+    child.transformable    = &transformable;
+    child.transformVersion = 0;
+    child.textureContent   = 0;
+
+    m_children.push_back(child);
+    m_invalidated = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::clear()
+{
+    m_children.clear();
+    m_invalidated = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CachedLayer::getDrawableCount() const
+{
+    return m_children.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::setClearColor(const Color& color)
+{
+    if (color != m_clearColor)
+    {
+        m_clearColor  = color;
+        m_invalidated = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& CachedLayer::getClearColor() const
+{
+    return m_clearColor;
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::invalidate()
+{
+    m_invalidated = true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CachedLayer::isOutdated() const
+{
+    if (m_invalidated)
+        return true;
+
+    for (std::size_t i = 0; i < m_children.size(); ++i)
+    {
+        const Child& child = m_children[i];
+
+        if (child.transformable && (child.transformable->getTransformVersion() != child.transformVersion))
+            return true;
+
+        if (child.states.texture && (child.states.texture->getContentId() != child.textureContent))
+            return true;
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& CachedLayer::getTexture() const
+{
+    return m_renderTexture.getTexture();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 CachedLayer::getRenderCount() const
+{
+    return m_renderCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::render() const
+{
+    // The background is premultiplied like the drawables
+    Color background(static_cast<Uint8>(m_clearColor.r * m_clearColor.a / 255),
+                     static_cast<Uint8>(m_clearColor.g * m_clearColor.a / 255),
+                     static_cast<Uint8>(m_clearColor.b * m_clearColor.a / 255),
+                     m_clearColor.a);
+    m_renderTexture.clear(background);
+
+    for (std::size_t i = 0; i < m_children.size(); ++i)
+    {
+        Child& child = m_children[i];
+
+        RenderStates states = child.states;
+        if (states.blendMode == BlendAlpha)
+            states.blendMode = premultiplyingAlpha;
+
+        m_renderTexture.draw(*child.drawable, states);
+
+        child.transformVersion = child.transformable ? child.transformable->getTransformVersion() : 0;
+        child.textureContent   = child.states.texture ? child.states.texture->getContentId() : 0;
+    }
+
+    m_renderTexture.display();
+
+    m_invalidated = false;
+    ++m_renderCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::draw(RenderTarget& target, RenderStates states) const
+{
+    if ((m_size.x == 0) || (m_size.y == 0))
+        return;
+
+    if (isOutdated())
+        render();
+
+    // The texture size is rounded up to whole pixels, map it back to the exact size of the layer
+    Vector2u pixels = m_renderTexture.getSize();
+    Sprite sprite(m_renderTexture.getTexture());
+    sprite.setScale(static_cast<float>(m_size.x) / pixels.x, static_cast<float>(m_size.y) / pixels.y);
+
+    states.transform *= getTransform();
+    if (states.blendMode == BlendAlpha)
+        states.blendMode = BlendPremultipliedAlpha;
+
+    target.draw(sprite, states);
+}
+
+} // namespace sf
@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Canvas.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <cmath>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Canvas::Canvas(RenderTarget& target) :
+m_target    (target),
+m_vertices  (),
+m_texture   (NULL),
+m_blendMode (BlendAlpha),
+m_unitCircle()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Canvas::~Canvas()
+{
+    flush();
+}
+
+
+////////////////////////////////////////////////////////////
+void Canvas::setBlendMode(const BlendMode& blendMode)
+{
+    if (blendMode != m_blendMode)
+    {
+        flush();
+        m_blendMode = blendMode;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Canvas::fillRect(const FloatRect& rectangle, const Color& color)
+{
+    float left   = rectangle.left;
+    float top    = rectangle.top;
+    float right  = rectangle.left + rectangle.width;
+    float bottom = rectangle.top + rectangle.height;
+
+    Vertex* vertices = allocate(NULL, 6);
+    vertices[0] = Vertex(Vector2f(left, top), color);
+    vertices[1] = Vertex(Vector2f(right, top), color);
+    vertices[2] = Vertex(Vector2f(left, bottom), color);
+    vertices[3] = vertices[2];
+    vertices[4] = vertices[1];
+    vertices[5] = Vertex(Vector2f(right, bottom), color);
+}
+
+
+////////////////////////////////////////////////////////////
+void Canvas::line(const Vector2f& start, const Vector2f& end, const Color& color, float thickness)
+{
+    Vector2f direction = end - start;
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (length == 0.f)
+        return;
+
+    // Half the thickness on each side of the segment
+    float scale = thickness / (2.f * length);
+    Vector2f normal(-direction.y * scale, direction.x * scale);
+
+    Vertex* vertices = allocate(NULL, 6);
+    vertices[0] = Vertex(start + normal, color);
+    vertices[1] = Vertex(end + normal, color);
+    vertices[2] = Vertex(start - normal, color);
+    vertices[3] = vertices[2];
+    vertices[4] = vertices[1];
+    vertices[5] = Vertex(end - normal, color);
+}
+
+
+////////////////////////////////////////////////////////////
+void Canvas::circle(const Vector2f& center, float radius, const Color& color, std::size_t pointCount)
+{
+    if (pointCount < 3)
+        return;
+
+    // Circles of a frame usually share the same point count
+    if (m_unitCircle.size() != pointCount)
+    {
+        static const float pi = 3.141592654f;
+
+        m_unitCircle.resize(pointCount);
+        for (std::size_t i = 0; i < pointCount; ++i)
+        {
+            float angle = i * 2.f * pi / pointCount - pi / 2.f;
+            m_unitCircle[i] = Vector2f(std::cos(angle), std::sin(angle));
+        }
+    }
+
+    // A fan of triangles around the center
+    Vertex* vertices = allocate(NULL, pointCount * 3);
+    Vector2f previous = center + m_unitCircle[pointCount - 1] * radius;
+    for (std::size_t i = 0; i < pointCount; ++i)
+    {
+        Vector2f point = center + m_unitCircle[i] * radius;
+
+        vertices[i * 3 + 0] = Vertex(center, color);
+        vertices[i * 3 + 1] = Vertex(previous, color);
+        vertices[i * 3 + 2] = Vertex(point, color);
+
+        previous = point;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Canvas::texturedQuad(const Texture& texture, const FloatRect& rectangle, const IntRect& textureRect, const Color& color)
+{
+    float left   = rectangle.left;
+    float top    = rectangle.top;
+    float right  = rectangle.left + rectangle.width;
+    float bottom = rectangle.top + rectangle.height;
+
+    // The texture coordinates follow the coordinate type of the texture
+    float u1 = static_cast<float>(textureRect.left);
+    float v1 = static_cast<float>(textureRect.top);
+    float u2 = static_cast<float>(textureRect.left + textureRect.width);
+    float v2 = static_cast<float>(textureRect.top + textureRect.height);
+    if ((texture.getCoordinateType() == Texture::Normalized) && (texture.getSize().x > 0) && (texture.getSize().y > 0))
+    {
+        float width  = static_cast<float>(texture.getSize().x);
+        float height = static_cast<float>(texture.getSize().y);
+        u1 /= width;
+        u2 /= width;
+        v1 /= height;
+        v2 /= height;
+    }
+
+    Vertex* vertices = allocate(&texture, 6);
+    vertices[0] = Vertex(Vector2f(left, top), color, Vector2f(u1, v1));
+    vertices[1] = Vertex(Vector2f(right, top), color, Vector2f(u2, v1));
+    vertices[2] = Vertex(Vector2f(left, bottom), color, Vector2f(u1, v2));
+    vertices[3] = vertices[2];
+    vertices[4] = vertices[1];
+    vertices[5] = Vertex(Vector2f(right, bottom), color, Vector2f(u2, v2));
+}
+
+
+////////////////////////////////////////////////////////////
+void Canvas::text(const Font& font, const String& string, const Vector2f& position, unsigned int characterSize, const Color& color)
+{
+    if (string.isEmpty())
+        return;
+
+    // Add the glyphs loaded in the background, which changes the font texture
+    font.commitGlyphs(false);
+
+    float whitespaceWidth = font.getGlyph(L' ', characterSize, false).advance;
+    float lineSpacing     = font.getLineSpacing(characterSize);
+
+    // Lay out the glyphs like sf::Text, from the baseline of the first line
+    float x = 0.f;
+    float y = static_cast<float>(characterSize);
+    Uint32 previous = 0;
+    for (std::size_t i = 0; i < string.getSize(); ++i)
+    {
+        Uint32 current = string[i];
+
+        // Skip the \r char to avoid weird graphical issues
+        if (current == L'\r')
+            continue;
+
+        x += font.getKerning(previous, current, characterSize);
+        previous = current;
+
+        switch (current)
+        {
+            case L' ':  x += whitespaceWidth;             continue;
+            case L'\t': x += whitespaceWidth * 4;         continue;
+            case L'\n': y += lineSpacing; x = 0;          continue;
+        }
+
+        const Glyph& glyph = font.getGlyph(current, characterSize, false);
+
+        // Same padding as sf::Text, so that smoothing doesn't cut the edges
+        float padding = 1.f;
+
+        float left   = position.x + x + glyph.bounds.left - padding;
+        float top    = position.y + y + glyph.bounds.top - padding;
+        float right  = position.x + x + glyph.bounds.left + glyph.bounds.width + padding;
+        float bottom = position.y + y + glyph.bounds.top + glyph.bounds.height + padding;
+
+        float u1 = static_cast<float>(glyph.textureRect.left) - padding;
+        float v1 = static_cast<float>(glyph.textureRect.top) - padding;
+        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
+        float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + padding;
+
+        Vertex* vertices = allocate(&font.getTexture(characterSize), 6);
+        vertices[0] = Vertex(Vector2f(left, top), color, Vector2f(u1, v1));
+        vertices[1] = Vertex(Vector2f(right, top), color, Vector2f(u2, v1));
+        vertices[2] = Vertex(Vector2f(left, bottom), color, Vector2f(u1, v2));
+        vertices[3] = vertices[2];
+        vertices[4] = vertices[1];
+        vertices[5] = Vertex(Vector2f(right, bottom), color, Vector2f(u2, v2));
+
+        x += glyph.advance;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Canvas::flush()
+{
+    if (m_vertices.empty())
+        return;
+
+    m_target.draw(&m_vertices[0], m_vertices.size(), Triangles, RenderStates(m_blendMode, Transform::Identity, m_texture, NULL));
+    m_vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+Vertex* Canvas::allocate(const Texture* texture, std::size_t vertexCount)
+{
+    if (texture != m_texture)
+    {
+        flush();
+        m_texture = texture;
+    }
+
+    // The vertices keep their capacity from one flush to the next
+    std::size_t first = m_vertices.size();
+    m_vertices.resize(first + vertexCount);
+
+    return &m_vertices[first];
+}
+
+} // namespace sf
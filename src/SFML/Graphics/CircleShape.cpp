@@ -26,7 +26,44 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
 #include <cmath>
+#include <map>
+#include <vector>
+
+
+namespace
+{
+    sf::Mutex unitCirclesMutex;
+
+    // Points of the unit circle for a given point count, shared by all the
+    // circles and never released so that the returned pointers stay valid
+    const sf::Vector2f* getUnitCircle(std::size_t pointCount)
+    {
+        if (pointCount == 0)
+            return NULL;
+
+        sf::Lock lock(unitCirclesMutex);
+
+        static std::map<std::size_t, std::vector<sf::Vector2f> > tables;
+        std::vector<sf::Vector2f>& table = tables[pointCount];
+
+        if (table.empty())
+        {
+            static const float pi = 3.141592654f;
+
+            table.resize(pointCount);
+            for (std::size_t i = 0; i < pointCount; ++i)
+            {
+                float angle = i * 2 * pi / pointCount - pi / 2;
+                table[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+            }
+        }
+
+        return &table[0];
+    }
+}
 
 
 namespace sf
@@ -34,7 +71,8 @@ namespace sf
 ////////////////////////////////////////////////////////////
 CircleShape::CircleShape(float radius, std::size_t pointCount) :
 m_radius    (radius),
-m_pointCount(pointCount)
+m_pointCount(pointCount),
+m_unitCircle(getUnitCircle(pointCount))
 {
     update();
 }
@@ -59,6 +97,7 @@ float CircleShape::getRadius() const
 void CircleShape::setPointCount(std::size_t count)
 {
     m_pointCount = count;
+    m_unitCircle = getUnitCircle(count);
     update();
 }
 
@@ -72,13 +111,20 @@ std::size_t CircleShape::getPointCount() const
 ////////////////////////////////////////////////////////////
 Vector2f CircleShape::getPoint(std::size_t index) const
 {
-    static const float pi = 3.141592654f;
+    const Vector2f& unit = m_unitCircle[index];
 
-    float angle = index * 2 * pi / m_pointCount - pi / 2;
-    float x = std::cos(angle) * m_radius;
-    float y = std::sin(angle) * m_radius;
+    return Vector2f(m_radius + unit.x * m_radius, m_radius + unit.y * m_radius);
+}
 
-    return Vector2f(m_radius + x, m_radius + y);
+
+////////////////////////////////////////////////////////////
+void CircleShape::getPoints(Vector2f* points) const
+{
+    for (std::size_t i = 0; i < m_pointCount; ++i)
+    {
+        const Vector2f& unit = m_unitCircle[i];
+        points[i] = Vector2f(m_radius + unit.x * m_radius, m_radius + unit.y * m_radius);
+    }
 }
 
-} // namespace sf
\ No newline at end of file
+} // namespace sf
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+constexpr Color::Color() :
+r(0),
+g(0),
+b(0),
+a(255)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr Color::Color(Uint8 red, Uint8 green, Uint8 blue, Uint8 alpha) :
+r(red),
+g(green),
+b(blue),
+a(alpha)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr Color::Color(Uint32 color) :
+r(static_cast<Uint8>((color & 0xff000000) >> 24)),
+g(static_cast<Uint8>((color & 0x00ff0000) >> 16)),
+b(static_cast<Uint8>((color & 0x0000ff00) >> 8 )),
+a(static_cast<Uint8>((color & 0x000000ff) >> 0 ))
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr Uint32 Color::toInteger() const
+{
+    return (static_cast<Uint32>(r) << 24) | (static_cast<Uint32>(g) << 16) | (static_cast<Uint32>(b) << 8) | a;
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr bool operator ==(const Color& left, const Color& right)
+{
+    return (left.r == right.r) &&
+           (left.g == right.g) &&
+           (left.b == right.b) &&
+           (left.a == right.a);
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr bool operator !=(const Color& left, const Color& right)
+{
+    return !(left == right);
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr Color operator +(const Color& left, const Color& right)
+{
+    // std::min and std::max are not constexpr in C++11
+    return Color(Uint8((int(left.r) + right.r < 255) ? int(left.r) + right.r : 255),
+                 Uint8((int(left.g) + right.g < 255) ? int(left.g) + right.g : 255),
+                 Uint8((int(left.b) + right.b < 255) ? int(left.b) + right.b : 255),
+                 Uint8((int(left.a) + right.a < 255) ? int(left.a) + right.a : 255));
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr Color operator -(const Color& left, const Color& right)
+{
+    return Color(Uint8((int(left.r) > right.r) ? int(left.r) - right.r : 0),
+                 Uint8((int(left.g) > right.g) ? int(left.g) - right.g : 0),
+                 Uint8((int(left.b) > right.b) ? int(left.b) - right.b : 0),
+                 Uint8((int(left.a) > right.a) ? int(left.a) - right.a : 0));
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr Color operator *(const Color& left, const Color& right)
+{
+    return Color(Uint8(int(left.r) * right.r / 255),
+                 Uint8(int(left.g) * right.g / 255),
+                 Uint8(int(left.b) * right.b / 255),
+                 Uint8(int(left.a) * right.a / 255));
+}
+
+
+////////////////////////////////////////////////////////////
+inline Color& operator +=(Color& left, const Color& right)
+{
+    return left = left + right;
+}
+
+
+////////////////////////////////////////////////////////////
+inline Color& operator -=(Color& left, const Color& right)
+{
+    return left = left - right;
+}
+
+
+////////////////////////////////////////////////////////////
+inline Color& operator *=(Color& left, const Color& right)
+{
+    return left = left * right;
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr Color lerp(const Color& from, const Color& to, float factor)
+{
+    return Color(Uint8(from.r + (int(to.r) - from.r) * factor + 0.5f),
+                 Uint8(from.g + (int(to.g) - from.g) * factor + 0.5f),
+                 Uint8(from.b + (int(to.b) - from.b) * factor + 0.5f),
+                 Uint8(from.a + (int(to.a) - from.a) * factor + 0.5f));
+}
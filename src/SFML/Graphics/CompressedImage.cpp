@@ -0,0 +1,868 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompressedImage.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Containers are little-endian
+    sf::Uint32 readUint32(const sf::Uint8* data)
+    {
+        return static_cast<sf::Uint32>(data[0]) | (static_cast<sf::Uint32>(data[1]) << 8) |
+               (static_cast<sf::Uint32>(data[2]) << 16) | (static_cast<sf::Uint32>(data[3]) << 24);
+    }
+
+    sf::Uint64 readUint64(const sf::Uint8* data)
+    {
+        return static_cast<sf::Uint64>(readUint32(data)) | (static_cast<sf::Uint64>(readUint32(data + 4)) << 32);
+    }
+
+    // ETC blocks are big-endian
+    sf::Uint64 readBlock64(const sf::Uint8* data)
+    {
+        sf::Uint64 block = 0;
+        for (int i = 0; i < 8; ++i)
+            block = (block << 8) | data[i];
+        return block;
+    }
+
+    const sf::Uint8 ktx1Identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+    const sf::Uint8 ktx2Identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+    // Size of the blocks of a compressed format
+    bool getBlockInfo(unsigned int format, unsigned int& blockWidth, unsigned int& blockHeight, unsigned int& blockSize)
+    {
+        blockWidth  = 4;
+        blockHeight = 4;
+
+        switch (format)
+        {
+            case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+            case GL_ETC1_RGB8_OES:
+            case GL_COMPRESSED_RGB8_ETC2:
+            case GL_COMPRESSED_SRGB8_ETC2:
+            case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+            case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+                blockSize = 8;
+                return true;
+
+            case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+            case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+            case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+            case GL_COMPRESSED_RGBA8_ETC2_EAC:
+            case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+                blockSize = 16;
+                return true;
+
+            default:
+                break;
+        }
+
+        // ASTC blocks are always 16 bytes, their footprint depends on the format
+        static const unsigned int astcFootprints[14][2] =
+        {
+            {4, 4}, {5, 4}, {5, 5}, {6, 5}, {6, 6}, {8, 5}, {8, 6},
+            {8, 8}, {10, 5}, {10, 6}, {10, 8}, {10, 10}, {12, 10}, {12, 12}
+        };
+
+        unsigned int index = 14;
+        if ((format >= GL_COMPRESSED_RGBA_ASTC_4x4) && (format <= GL_COMPRESSED_RGBA_ASTC_12x12))
+            index = format - GL_COMPRESSED_RGBA_ASTC_4x4;
+        else if ((format >= GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4) && (format <= GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12))
+            index = format - GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4;
+
+        if (index >= 14)
+            return false;
+
+        blockWidth  = astcFootprints[index][0];
+        blockHeight = astcFootprints[index][1];
+        blockSize   = 16;
+        return true;
+    }
+
+    bool isSrgbFormat(unsigned int format)
+    {
+        switch (format)
+        {
+            case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+            case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+            case GL_COMPRESSED_SRGB8_ETC2:
+            case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+            case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+                return true;
+
+            default:
+                return (format >= GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4) && (format <= GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12);
+        }
+    }
+
+    // Number of bytes of a level, or 0 if the format is unknown
+    std::size_t getLevelSize(unsigned int format, unsigned int width, unsigned int height)
+    {
+        unsigned int blockWidth, blockHeight, blockSize;
+        if (!getBlockInfo(format, blockWidth, blockHeight, blockSize))
+            return 0;
+
+        // Computed in 64 bits, the sizes come from the file and size_t has 32 bits on wasm32
+        sf::Uint64 blocksX = (static_cast<sf::Uint64>(width) + blockWidth - 1) / blockWidth;
+        sf::Uint64 blocksY = (static_cast<sf::Uint64>(height) + blockHeight - 1) / blockHeight;
+        sf::Uint64 size = blocksX * blocksY * blockSize;
+        return (size <= static_cast<std::size_t>(-1)) ? static_cast<std::size_t>(size) : 0;
+    }
+
+    // Vulkan formats used by KTX2, mapped to their GL equivalent
+    unsigned int getFormatFromVulkan(sf::Uint32 vkFormat)
+    {
+        switch (vkFormat)
+        {
+            case 131: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case 132: return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+            case 133: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case 134: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+            case 135: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+            case 136: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+            case 137: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case 138: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+            case 147: return GL_COMPRESSED_RGB8_ETC2;
+            case 148: return GL_COMPRESSED_SRGB8_ETC2;
+            case 149: return GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+            case 150: return GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+            case 151: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+            case 152: return GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+            default:  break;
+        }
+
+        // VK_FORMAT_ASTC_4x4_UNORM_BLOCK to VK_FORMAT_ASTC_12x12_SRGB_BLOCK, unorm and sRGB interleaved
+        if ((vkFormat >= 157) && (vkFormat <= 184))
+        {
+            unsigned int index = (vkFormat - 157) / 2;
+            bool sRgb = ((vkFormat - 157) % 2) == 1;
+            return (sRgb ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4 : GL_COMPRESSED_RGBA_ASTC_4x4) + index;
+        }
+
+        return 0;
+    }
+
+    // DXGI formats used by the DX10 extension of DDS, mapped to their GL equivalent
+    unsigned int getFormatFromDxgi(sf::Uint32 dxgiFormat)
+    {
+        switch (dxgiFormat)
+        {
+            case 71: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case 72: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+            case 74: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+            case 75: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+            case 77: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case 78: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+            default: return 0;
+        }
+    }
+
+    // Fill the levels of a tightly packed mip chain
+    bool addLevels(sf::priv::CompressedImage& image, const sf::Uint8* begin, const sf::Uint8* end, unsigned int count)
+    {
+        sf::Vector2u size = image.size;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            sf::priv::CompressedImage::Level level;
+            level.data     = begin;
+            level.dataSize = getLevelSize(image.format, size.x, size.y);
+            level.size     = size;
+
+            if ((level.dataSize == 0) || (static_cast<std::size_t>(end - begin) < level.dataSize))
+                return false;
+
+            image.levels.push_back(level);
+            begin += level.dataSize;
+
+            if ((size.x == 1) && (size.y == 1))
+                break;
+
+            size.x = std::max(size.x / 2, 1u);
+            size.y = std::max(size.y / 2, 1u);
+        }
+
+        return true;
+    }
+
+    bool parseKtx1(const sf::Uint8* data, std::size_t dataSize, sf::priv::CompressedImage& image)
+    {
+        if (dataSize < 64)
+            return false;
+
+        if (readUint32(data + 12) != 0x04030201)
+        {
+            sf::err() << "Failed to load KTX image: big-endian files are not supported" << std::endl;
+            return false;
+        }
+
+        sf::Uint32 glType      = readUint32(data + 16);
+        sf::Uint32 format      = readUint32(data + 28);
+        sf::Uint32 width       = readUint32(data + 36);
+        sf::Uint32 height      = readUint32(data + 40);
+        sf::Uint32 depth       = readUint32(data + 44);
+        sf::Uint32 arraySize   = readUint32(data + 48);
+        sf::Uint32 faces       = readUint32(data + 52);
+        sf::Uint32 levelCount  = std::max(readUint32(data + 56), 1u);
+        sf::Uint32 keyValueSize = readUint32(data + 60);
+
+        if ((glType != 0) || (depth > 1) || (arraySize > 0) || (faces != 1))
+        {
+            sf::err() << "Failed to load KTX image: only single compressed 2D images are supported" << std::endl;
+            return false;
+        }
+
+        image.format = format;
+        image.size   = sf::Vector2u(width, height);
+
+        // The sizes come from the file: they are checked against the remaining
+        // bytes rather than added to the offset, which could wrap around
+        if (keyValueSize > dataSize - 64)
+            return false;
+
+        // Each level is preceded by its size and padded to 4 bytes
+        std::size_t offset = 64 + static_cast<std::size_t>(keyValueSize);
+        sf::Vector2u size = image.size;
+        for (sf::Uint32 i = 0; i < levelCount; ++i)
+        {
+            if (dataSize - offset < 4)
+                return false;
+
+            sf::Uint32 imageSize = readUint32(data + offset);
+            offset += 4;
+
+            std::size_t levelSize = getLevelSize(format, size.x, size.y);
+            if ((levelSize == 0) || (imageSize < levelSize) || (imageSize > dataSize - offset))
+                return false;
+
+            sf::priv::CompressedImage::Level level;
+            level.data     = data + offset;
+            level.dataSize = levelSize;
+            level.size     = size;
+
+            image.levels.push_back(level);
+
+            // The padding may be missing after the last level
+            std::size_t paddedSize = (static_cast<std::size_t>(imageSize) + 3) & ~static_cast<std::size_t>(3);
+            offset += std::min(paddedSize, dataSize - offset);
+
+            size.x = std::max(size.x / 2, 1u);
+            size.y = std::max(size.y / 2, 1u);
+        }
+
+        return true;
+    }
+
+    bool parseKtx2(const sf::Uint8* data, std::size_t dataSize, sf::priv::CompressedImage& image)
+    {
+        if (dataSize < 80)
+            return false;
+
+        sf::Uint32 vkFormat    = readUint32(data + 12);
+        sf::Uint32 width       = readUint32(data + 20);
+        sf::Uint32 height      = readUint32(data + 24);
+        sf::Uint32 depth       = readUint32(data + 28);
+        sf::Uint32 layers      = readUint32(data + 32);
+        sf::Uint32 faces       = readUint32(data + 36);
+        sf::Uint32 levelCount  = std::max(readUint32(data + 40), 1u);
+        sf::Uint32 compression = readUint32(data + 44);
+
+        if (compression != 0)
+        {
+            sf::err() << "Failed to load KTX2 image: supercompressed files (Basis Universal, zstd) are not supported" << std::endl;
+            return false;
+        }
+
+        if ((depth > 1) || (layers > 1) || (faces != 1))
+        {
+            sf::err() << "Failed to load KTX2 image: only single 2D images are supported" << std::endl;
+            return false;
+        }
+
+        image.format = getFormatFromVulkan(vkFormat);
+        image.size   = sf::Vector2u(width, height);
+        if (image.format == 0)
+        {
+            sf::err() << "Failed to load KTX2 image: unsupported format (VkFormat " << vkFormat << ")" << std::endl;
+            return false;
+        }
+
+        if (levelCount > (dataSize - 80) / 24)
+            return false;
+
+        // The level index gives the location of each level, level 0 is the largest
+        sf::Vector2u size = image.size;
+        for (sf::Uint32 i = 0; i < levelCount; ++i)
+        {
+            const sf::Uint8* entry = data + 80 + i * 24;
+            sf::Uint64 offset = readUint64(entry);
+            sf::Uint64 length = readUint64(entry + 8);
+
+            // The offset and length come from the file: they are checked against
+            // the data size without being added, which could wrap around
+            std::size_t levelSize = getLevelSize(image.format, size.x, size.y);
+            if ((offset > dataSize) || (length > dataSize - offset) || (length < levelSize))
+                return false;
+
+            sf::priv::CompressedImage::Level level;
+            level.data     = data + static_cast<std::size_t>(offset);
+            level.dataSize = levelSize;
+            level.size     = size;
+
+            image.levels.push_back(level);
+
+            size.x = std::max(size.x / 2, 1u);
+            size.y = std::max(size.y / 2, 1u);
+        }
+
+        return true;
+    }
+
+    bool parseDds(const sf::Uint8* data, std::size_t dataSize, sf::priv::CompressedImage& image)
+    {
+        if ((dataSize < 128) || (readUint32(data + 4) != 124))
+            return false;
+
+        sf::Uint32 height     = readUint32(data + 12);
+        sf::Uint32 width      = readUint32(data + 16);
+        sf::Uint32 levelCount = std::max(readUint32(data + 28), 1u);
+        sf::Uint32 pixelFlags = readUint32(data + 80);
+        const sf::Uint8* fourCC = data + 84;
+        sf::Uint32 caps2      = readUint32(data + 112);
+
+        // DDSCAPS2_CUBEMAP, DDSCAPS2_VOLUME
+        if (caps2 & (0x200 | 0x200000))
+        {
+            sf::err() << "Failed to load DDS image: only 2D images are supported" << std::endl;
+            return false;
+        }
+
+        // DDPF_FOURCC
+        if (!(pixelFlags & 0x4))
+        {
+            sf::err() << "Failed to load DDS image: only compressed images are supported" << std::endl;
+            return false;
+        }
+
+        std::size_t offset = 128;
+        if (std::memcmp(fourCC, "DXT1", 4) == 0)
+        {
+            image.format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        }
+        else if (std::memcmp(fourCC, "DXT3", 4) == 0)
+        {
+            image.format = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+        }
+        else if (std::memcmp(fourCC, "DXT5", 4) == 0)
+        {
+            image.format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        }
+        else if (std::memcmp(fourCC, "DX10", 4) == 0)
+        {
+            if (dataSize < 148)
+                return false;
+
+            // Resource dimension must be D3D10_RESOURCE_DIMENSION_TEXTURE2D, no cube map nor array
+            if ((readUint32(data + 132) != 3) || (readUint32(data + 136) & 0x4) || (readUint32(data + 140) > 1))
+            {
+                sf::err() << "Failed to load DDS image: only single 2D images are supported" << std::endl;
+                return false;
+            }
+
+            image.format = getFormatFromDxgi(readUint32(data + 128));
+            offset = 148;
+        }
+        else
+        {
+            image.format = 0;
+        }
+
+        if (image.format == 0)
+        {
+            sf::err() << "Failed to load DDS image: unsupported format" << std::endl;
+            return false;
+        }
+
+        image.size = sf::Vector2u(width, height);
+        return addLevels(image, data + offset, data + dataSize, levelCount);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // CPU decompression, blocks are written as 4x4 RGBA pixels, row by row
+    ////////////////////////////////////////////////////////////
+    sf::Uint8 clamp255(int value)
+    {
+        return static_cast<sf::Uint8>(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+
+    void decodeBc1(const sf::Uint8* block, sf::Uint8* pixels, bool allowAlpha)
+    {
+        unsigned int c0 = block[0] | (block[1] << 8);
+        unsigned int c1 = block[2] | (block[3] << 8);
+
+        int colors[4][4];
+        const unsigned int endpoints[2] = {c0, c1};
+        for (int i = 0; i < 2; ++i)
+        {
+            unsigned int r = (endpoints[i] >> 11) & 31;
+            unsigned int g = (endpoints[i] >> 5) & 63;
+            unsigned int b = endpoints[i] & 31;
+            colors[i][0] = (r << 3) | (r >> 2);
+            colors[i][1] = (g << 2) | (g >> 4);
+            colors[i][2] = (b << 3) | (b >> 2);
+            colors[i][3] = 255;
+        }
+
+        for (int c = 0; c < 3; ++c)
+        {
+            if ((c0 > c1) || !allowAlpha)
+            {
+                colors[2][c] = (2 * colors[0][c] + colors[1][c]) / 3;
+                colors[3][c] = (colors[0][c] + 2 * colors[1][c]) / 3;
+            }
+            else
+            {
+                colors[2][c] = (colors[0][c] + colors[1][c]) / 2;
+                colors[3][c] = 0;
+            }
+        }
+        colors[2][3] = 255;
+        colors[3][3] = ((c0 > c1) || !allowAlpha) ? 255 : 0;
+
+        sf::Uint32 indices = readUint32(block + 4);
+        for (int i = 0; i < 16; ++i)
+        {
+            const int* color = colors[(indices >> (2 * i)) & 3];
+            for (int c = 0; c < 4; ++c)
+                pixels[i * 4 + c] = static_cast<sf::Uint8>(color[c]);
+        }
+    }
+
+    void decodeBc2Alpha(const sf::Uint8* block, sf::Uint8* pixels)
+    {
+        for (int i = 0; i < 16; ++i)
+            pixels[i * 4 + 3] = static_cast<sf::Uint8>(((block[i / 2] >> ((i & 1) * 4)) & 0xF) * 17);
+    }
+
+    void decodeBc3Alpha(const sf::Uint8* block, sf::Uint8* pixels)
+    {
+        int alphas[8];
+        alphas[0] = block[0];
+        alphas[1] = block[1];
+        if (alphas[0] > alphas[1])
+        {
+            for (int i = 1; i < 7; ++i)
+                alphas[i + 1] = ((7 - i) * alphas[0] + i * alphas[1]) / 7;
+        }
+        else
+        {
+            for (int i = 1; i < 5; ++i)
+                alphas[i + 1] = ((5 - i) * alphas[0] + i * alphas[1]) / 5;
+            alphas[6] = 0;
+            alphas[7] = 255;
+        }
+
+        sf::Uint64 indices = 0;
+        for (int i = 0; i < 6; ++i)
+            indices |= static_cast<sf::Uint64>(block[2 + i]) << (8 * i);
+
+        for (int i = 0; i < 16; ++i)
+            pixels[i * 4 + 3] = static_cast<sf::Uint8>(alphas[(indices >> (3 * i)) & 7]);
+    }
+
+    // ETC1 and ETC2 RGB blocks (the ETC2 modes are signalled by invalid ETC1 differential colors)
+    void decodeEtc(const sf::Uint8* data, sf::Uint8* pixels, bool etc2)
+    {
+        static const int modifiers[8][4] =
+        {
+            {2, 8, -2, -8}, {5, 17, -5, -17}, {9, 29, -9, -29}, {13, 42, -13, -42},
+            {18, 60, -18, -60}, {24, 80, -24, -80}, {33, 106, -33, -106}, {47, 183, -47, -183}
+        };
+        static const int distances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+        sf::Uint64 block = readBlock64(data);
+        sf::Uint32 indices = static_cast<sf::Uint32>(block);
+        bool differential = ((block >> 33) & 1) != 0;
+        bool flip = ((block >> 32) & 1) != 0;
+
+        int base[2][3];
+        if (!differential)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                base[0][c] = static_cast<int>((block >> (60 - 8 * c)) & 15) * 17;
+                base[1][c] = static_cast<int>((block >> (56 - 8 * c)) & 15) * 17;
+            }
+        }
+        else
+        {
+            int color[3], delta[3];
+            for (int c = 0; c < 3; ++c)
+            {
+                color[c] = static_cast<int>((block >> (59 - 8 * c)) & 31);
+                delta[c] = static_cast<int>((block >> (56 - 8 * c)) & 7);
+                if (delta[c] >= 4)
+                    delta[c] -= 8;
+            }
+
+            int overflow = -1;
+            for (int c = 0; (c < 3) && (overflow < 0); ++c)
+            {
+                if ((color[c] + delta[c] < 0) || (color[c] + delta[c] > 31))
+                    overflow = c;
+            }
+
+            if (etc2 && (overflow == 0 || overflow == 1))
+            {
+                // T mode (red overflow) or H mode (green overflow)
+                int c1[3], c2[3];
+                int distance;
+                if (overflow == 0)
+                {
+                    c1[0] = static_cast<int>(((block >> 57) & 0xC) | ((block >> 56) & 0x3));
+                    c1[1] = static_cast<int>((block >> 52) & 15);
+                    c1[2] = static_cast<int>((block >> 48) & 15);
+                    c2[0] = static_cast<int>((block >> 44) & 15);
+                    c2[1] = static_cast<int>((block >> 40) & 15);
+                    c2[2] = static_cast<int>((block >> 36) & 15);
+                    distance = distances[((block >> 33) & 0x6) | ((block >> 32) & 0x1)];
+                }
+                else
+                {
+                    c1[0] = static_cast<int>((block >> 59) & 15);
+                    c1[1] = static_cast<int>(((block >> 55) & 0xE) | ((block >> 52) & 0x1));
+                    c1[2] = static_cast<int>(((block >> 48) & 0x8) | ((block >> 47) & 0x7));
+                    c2[0] = static_cast<int>((block >> 43) & 15);
+                    c2[1] = static_cast<int>((block >> 39) & 15);
+                    c2[2] = static_cast<int>((block >> 35) & 15);
+                    int order = ((c1[0] << 8) | (c1[1] << 4) | c1[2]) >= ((c2[0] << 8) | (c2[1] << 4) | c2[2]) ? 1 : 0;
+                    distance = distances[((block >> 32) & 0x4) | ((block >> 31) & 0x2) | order];
+                }
+
+                int paint[4][3];
+                for (int c = 0; c < 3; ++c)
+                {
+                    c1[c] *= 17;
+                    c2[c] *= 17;
+                    if (overflow == 0)
+                    {
+                        paint[0][c] = c1[c];
+                        paint[1][c] = c2[c] + distance;
+                        paint[2][c] = c2[c];
+                        paint[3][c] = c2[c] - distance;
+                    }
+                    else
+                    {
+                        paint[0][c] = c1[c] + distance;
+                        paint[1][c] = c1[c] - distance;
+                        paint[2][c] = c2[c] + distance;
+                        paint[3][c] = c2[c] - distance;
+                    }
+                }
+
+                for (int x = 0; x < 4; ++x)
+                {
+                    for (int y = 0; y < 4; ++y)
+                    {
+                        int k = x * 4 + y;
+                        int index = (((indices >> (k + 16)) & 1) << 1) | ((indices >> k) & 1);
+                        sf::Uint8* pixel = pixels + (y * 4 + x) * 4;
+                        for (int c = 0; c < 3; ++c)
+                            pixel[c] = clamp255(paint[index][c]);
+                        pixel[3] = 255;
+                    }
+                }
+                return;
+            }
+
+            if (etc2 && (overflow == 2))
+            {
+                // Planar mode: the block is a gradient between 3 colors
+                int o[3], h[3], v[3];
+                o[0] = static_cast<int>((block >> 57) & 0x3F);
+                o[1] = static_cast<int>(((block >> 50) & 0x40) | ((block >> 49) & 0x3F));
+                o[2] = static_cast<int>(((block >> 43) & 0x20) | ((block >> 40) & 0x18) | ((block >> 39) & 0x7));
+                h[0] = static_cast<int>(((block >> 33) & 0x3E) | ((block >> 32) & 0x1));
+                h[1] = static_cast<int>((block >> 25) & 0x7F);
+                h[2] = static_cast<int>((block >> 19) & 0x3F);
+                v[0] = static_cast<int>((block >> 13) & 0x3F);
+                v[1] = static_cast<int>((block >> 6) & 0x7F);
+                v[2] = static_cast<int>(block & 0x3F);
+
+                for (int c = 0; c < 3; ++c)
+                {
+                    // Red and blue have 6 bits, green has 7
+                    int shift = (c == 1) ? 1 : 2;
+                    int rest = (c == 1) ? 6 : 4;
+                    o[c] = (o[c] << shift) | (o[c] >> rest);
+                    h[c] = (h[c] << shift) | (h[c] >> rest);
+                    v[c] = (v[c] << shift) | (v[c] >> rest);
+                }
+
+                for (int y = 0; y < 4; ++y)
+                {
+                    for (int x = 0; x < 4; ++x)
+                    {
+                        sf::Uint8* pixel = pixels + (y * 4 + x) * 4;
+                        for (int c = 0; c < 3; ++c)
+                            pixel[c] = clamp255((x * (h[c] - o[c]) + y * (v[c] - o[c]) + 4 * o[c] + 2) >> 2);
+                        pixel[3] = 255;
+                    }
+                }
+                return;
+            }
+
+            for (int c = 0; c < 3; ++c)
+            {
+                int c1 = color[c];
+                int c2 = (color[c] + delta[c]) & 31; // only wraps in invalid ETC1 blocks
+                base[0][c] = (c1 << 3) | (c1 >> 2);
+                base[1][c] = (c2 << 3) | (c2 >> 2);
+            }
+        }
+
+        // Individual and differential modes: two sub-blocks with their own base color and table
+        int table[2];
+        table[0] = static_cast<int>((block >> 37) & 7);
+        table[1] = static_cast<int>((block >> 34) & 7);
+
+        for (int x = 0; x < 4; ++x)
+        {
+            for (int y = 0; y < 4; ++y)
+            {
+                int k = x * 4 + y;
+                int index = (((indices >> (k + 16)) & 1) << 1) | ((indices >> k) & 1);
+                int subBlock = flip ? (y >= 2) : (x >= 2);
+                int modifier = modifiers[table[subBlock]][index];
+
+                sf::Uint8* pixel = pixels + (y * 4 + x) * 4;
+                for (int c = 0; c < 3; ++c)
+                    pixel[c] = clamp255(base[subBlock][c] + modifier);
+                pixel[3] = 255;
+            }
+        }
+    }
+
+    // EAC alpha block of ETC2 RGBA8
+    void decodeEacAlpha(const sf::Uint8* data, sf::Uint8* pixels)
+    {
+        static const int modifiers[16][8] =
+        {
+            {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12},
+            {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+            {-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10},
+            {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+            {-2, -6, -8, -10, 1, 5, 7, 9},  {-2, -5, -8, -10, 1, 4, 7, 9},
+            {-2, -4, -8, -10, 1, 3, 7, 9},  {-2, -5, -7, -10, 1, 4, 6, 9},
+            {-3, -4, -7, -10, 2, 3, 6, 9},  {-1, -2, -3, -10, 0, 1, 2, 9},
+            {-4, -6, -8, -9, 3, 5, 7, 8},   {-3, -5, -7, -9, 2, 4, 6, 8}
+        };
+
+        sf::Uint64 block = readBlock64(data);
+        int base       = static_cast<int>(block >> 56);
+        int multiplier = static_cast<int>((block >> 52) & 15);
+        int table      = static_cast<int>((block >> 48) & 15);
+
+        for (int x = 0; x < 4; ++x)
+        {
+            for (int y = 0; y < 4; ++y)
+            {
+                int k = x * 4 + y;
+                int index = static_cast<int>((block >> (45 - 3 * k)) & 7);
+                pixels[(y * 4 + x) * 4 + 3] = clamp255(base + modifiers[table][index] * multiplier);
+            }
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool isCompressedImage(const void* data, std::size_t dataSize)
+{
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+
+    return data && (dataSize >= 12) && ((std::memcmp(bytes, ktx1Identifier, 12) == 0) ||
+                                        (std::memcmp(bytes, ktx2Identifier, 12) == 0) ||
+                                        (std::memcmp(bytes, "DDS ", 4) == 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool parseCompressedImage(const void* data, std::size_t dataSize, CompressedImage& image)
+{
+    image.format = 0;
+    image.sRgb   = false;
+    image.size   = Vector2u(0, 0);
+    image.levels.clear();
+
+    if (!isCompressedImage(data, dataSize))
+    {
+        err() << "Failed to load compressed image: not a KTX, KTX2 or DDS file" << std::endl;
+        return false;
+    }
+
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+
+    bool parsed;
+    if (std::memcmp(bytes, ktx1Identifier, 12) == 0)
+        parsed = parseKtx1(bytes, dataSize, image);
+    else if (std::memcmp(bytes, ktx2Identifier, 12) == 0)
+        parsed = parseKtx2(bytes, dataSize, image);
+    else
+        parsed = parseDds(bytes, dataSize, image);
+
+    if (parsed && ((image.size.x == 0) || (image.size.y == 0) || image.levels.empty()))
+        parsed = false;
+
+    if (!parsed)
+    {
+        err() << "Failed to load compressed image: invalid, truncated or unsupported file" << std::endl;
+        image.levels.clear();
+        return false;
+    }
+
+    image.sRgb = isSrgbFormat(image.format);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool decompressImage(unsigned int format, const CompressedImage::Level& level, std::vector<Uint8>& pixels)
+{
+    bool alphaBlock = false;
+    switch (format)
+    {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+        case GL_ETC1_RGB8_OES:
+        case GL_COMPRESSED_RGB8_ETC2:
+        case GL_COMPRESSED_SRGB8_ETC2:
+            break;
+
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:
+        case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+            alphaBlock = true;
+            break;
+
+        default:
+            return false;
+    }
+
+    if (level.dataSize < getLevelSize(format, level.size.x, level.size.y))
+        return false;
+
+    unsigned int blocksX = (level.size.x + 3) / 4;
+    unsigned int blocksY = (level.size.y + 3) / 4;
+    std::size_t blockSize = alphaBlock ? 16 : 8;
+
+    pixels.resize(static_cast<std::size_t>(level.size.x) * level.size.y * 4);
+
+    Uint8 block[16 * 4];
+    for (unsigned int by = 0; by < blocksY; ++by)
+    {
+        for (unsigned int bx = 0; bx < blocksX; ++bx)
+        {
+            const Uint8* src = level.data + (by * blocksX + bx) * blockSize;
+
+            switch (format)
+            {
+                case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+                case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+                    decodeBc1(src, block, false);
+                    break;
+
+                case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+                case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+                    decodeBc1(src, block, true);
+                    break;
+
+                case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+                case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+                    decodeBc1(src + 8, block, false);
+                    decodeBc2Alpha(src, block);
+                    break;
+
+                case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+                case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+                    decodeBc1(src + 8, block, false);
+                    decodeBc3Alpha(src, block);
+                    break;
+
+                case GL_ETC1_RGB8_OES:
+                    decodeEtc(src, block, false);
+                    break;
+
+                case GL_COMPRESSED_RGB8_ETC2:
+                case GL_COMPRESSED_SRGB8_ETC2:
+                    decodeEtc(src, block, true);
+                    break;
+
+                default:
+                    decodeEtc(src + 8, block, true);
+                    decodeEacAlpha(src, block);
+                    break;
+            }
+
+            // Copy the block, clipped to the level size
+            unsigned int width  = std::min(4u, level.size.x - bx * 4);
+            unsigned int height = std::min(4u, level.size.y - by * 4);
+            for (unsigned int y = 0; y < height; ++y)
+            {
+                Uint8* dst = &pixels[((by * 4 + y) * level.size.x + bx * 4) * 4];
+                std::memcpy(dst, block + y * 16, width * 4);
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
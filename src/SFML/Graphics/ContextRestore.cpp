@@ -0,0 +1,302 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ContextRestore.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TexturePool.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/VertexBufferArena.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Trace.hpp>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <set>
+#include <vector>
+
+
+namespace
+{
+    // Tracked resources, by kind
+    sf::Mutex registryMutex;
+    std::set<void*> restorables[sf::priv::RestorableKindCount];
+
+    std::atomic<bool> trackingEnabled(false);
+    std::atomic<bool> trackingUsed(false);
+
+    typedef std::map<const void*, std::vector<sf::Uint8> > CopyTable;
+    typedef std::map<unsigned int, std::vector<sf::Uint8> > ProgramTable;
+
+    // Copies made by retain: pixels and vertices by object, binaries by program
+    CopyTable    retainedCopies;
+    ProgramTable retainedPrograms;
+
+    // Get the tracked resources of a kind; the restore creates and destroys objects, so it works on a copy
+    template <typename T>
+    std::vector<T*> getRestorables(sf::priv::RestorableKind kind)
+    {
+        sf::Lock lock(registryMutex);
+
+        std::vector<T*> objects;
+        objects.reserve(restorables[kind].size());
+        for (std::set<void*>::const_iterator it = restorables[kind].begin(); it != restorables[kind].end(); ++it)
+            objects.push_back(static_cast<T*>(*it));
+
+        return objects;
+    }
+
+    // Size of the retained copies (registryMutex must be locked)
+    sf::Uint64 getCopiesSize()
+    {
+        sf::Uint64 size = 0;
+        for (CopyTable::const_iterator it = retainedCopies.begin(); it != retainedCopies.end(); ++it)
+            size += it->second.size();
+        for (ProgramTable::const_iterator it = retainedPrograms.begin(); it != retainedPrograms.end(); ++it)
+            size += it->second.size();
+
+        return size;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+void ContextRestore::setEnabled(bool enabled)
+{
+    trackingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ContextRestore::isEnabled()
+{
+    return trackingEnabled.load(std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 ContextRestore::retain()
+{
+    SFML_TRACE_SCOPE("ContextRestore::retain");
+
+    CopyTable copies;
+    ProgramTable programs;
+
+    // The glyph pages are rebuilt from the coverage that the fonts keep anyway
+    std::vector<const Texture*> pages;
+    std::vector<Font*> fonts = getRestorables<Font>(priv::RestorableFont);
+    for (std::size_t i = 0; i < fonts.size(); ++i)
+        fonts[i]->getPageTextures(pages);
+    std::sort(pages.begin(), pages.end());
+
+    std::vector<Texture*> textures = getRestorables<Texture>(priv::RestorableTexture);
+    for (std::size_t i = 0; i < textures.size(); ++i)
+    {
+        if (std::binary_search(pages.begin(), pages.end(), textures[i]))
+            continue;
+
+        std::vector<Uint8> pixels;
+        if (textures[i]->retainPixels(pixels))
+            copies[textures[i]].swap(pixels);
+    }
+
+    // Shaders built from the same sources share their program, its binary is kept once
+    std::vector<Shader*> shaders = getRestorables<Shader>(priv::RestorableShader);
+    for (std::size_t i = 0; i < shaders.size(); ++i)
+    {
+        unsigned int program = shaders[i]->getNativeHandle();
+        if (!program || (programs.find(program) != programs.end()))
+            continue;
+
+        std::vector<Uint8> binary;
+        if (shaders[i]->retainProgram(binary))
+            programs[program].swap(binary);
+    }
+
+    std::vector<VertexBuffer*> buffers = getRestorables<VertexBuffer>(priv::RestorableVertexBuffer);
+    for (std::size_t i = 0; i < buffers.size(); ++i)
+    {
+        std::vector<Uint8> vertices;
+        if (buffers[i]->retainVertices(vertices))
+            copies[buffers[i]].swap(vertices);
+    }
+
+    Lock lock(registryMutex);
+
+    retainedCopies.swap(copies);
+    retainedPrograms.swap(programs);
+
+    return getCopiesSize();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ContextRestore::restore()
+{
+    SFML_TRACE_SCOPE("ContextRestore::restore");
+
+    // Forget the programs first: the built-in shaders of the pipelines are destroyed below,
+    // and deleting a program that doesn't exist is an error
+    std::map<const Shader*, unsigned int> lostPrograms;
+    std::vector<Shader*> shaders = getRestorables<Shader>(priv::RestorableShader);
+    for (std::size_t i = 0; i < shaders.size(); ++i)
+    {
+        unsigned int program = shaders[i]->forgetProgram();
+        if (program)
+            lostPrograms[shaders[i]] = program;
+    }
+
+    // Drop what SFML created for the lost contexts; deleting their textures, buffers,
+    // vertex arrays and frame buffers is harmless while the new context has no object yet
+    priv::forgetRenderPipelines();
+    TexturePool::clear();
+    Texture::forgetSharedObjects();
+    priv::forgetGLStateCaches();
+
+    CopyTable copies;
+    ProgramTable programs;
+    {
+        Lock lock(registryMutex);
+        copies.swap(retainedCopies);
+        programs.swap(retainedPrograms);
+    }
+
+    bool restored = true;
+
+    // The textures come first, the fonts upload their pages into them
+    std::vector<Texture*> textures = getRestorables<Texture>(priv::RestorableTexture);
+    for (std::size_t i = 0; i < textures.size(); ++i)
+    {
+        CopyTable::const_iterator copy = copies.find(textures[i]);
+        if (!textures[i]->restoreStorage((copy != copies.end()) ? &copy->second : NULL))
+            restored = false;
+    }
+
+    std::vector<Font*> fonts = getRestorables<Font>(priv::RestorableFont);
+    for (std::size_t i = 0; i < fonts.size(); ++i)
+        fonts[i]->restorePages();
+
+    // The arenas come before their vertex buffers, which take the new blocks
+    std::vector<VertexBufferArena*> arenas = getRestorables<VertexBufferArena>(priv::RestorableVertexBufferArena);
+    for (std::size_t i = 0; i < arenas.size(); ++i)
+    {
+        if (!arenas[i]->restoreBlocks())
+            restored = false;
+    }
+
+    std::vector<VertexBuffer*> buffers = getRestorables<VertexBuffer>(priv::RestorableVertexBuffer);
+    for (std::size_t i = 0; i < buffers.size(); ++i)
+    {
+        CopyTable::const_iterator copy = copies.find(buffers[i]);
+        if (!buffers[i]->restoreStorage((copy != copies.end()) ? &copy->second : NULL))
+            restored = false;
+    }
+
+    // The shaders of the pipelines are gone, only the remaining ones are restored;
+    // a shared program is created once, for its first user
+    std::map<unsigned int, unsigned int> recreatedPrograms;
+    shaders = getRestorables<Shader>(priv::RestorableShader);
+    for (std::size_t i = 0; i < shaders.size(); ++i)
+    {
+        std::map<const Shader*, unsigned int>::const_iterator lost = lostPrograms.find(shaders[i]);
+        if (lost == lostPrograms.end())
+            continue;
+
+        ProgramTable::const_iterator binary = programs.find(lost->second);
+        if (binary == programs.end())
+        {
+            err() << "Failed to restore shader, its program binary was not kept" << std::endl;
+            restored = false;
+            continue;
+        }
+
+        if (!shaders[i]->restoreProgram(binary->second, recreatedPrograms[lost->second]))
+            restored = false;
+    }
+
+    return restored;
+}
+
+
+////////////////////////////////////////////////////////////
+void ContextRestore::discard()
+{
+    Lock lock(registryMutex);
+
+    retainedCopies.clear();
+    retainedPrograms.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 ContextRestore::getRetainedSize()
+{
+    Lock lock(registryMutex);
+
+    return getCopiesSize();
+}
+
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void registerRestorable(RestorableKind kind, void* object)
+{
+    if (!trackingEnabled.load(std::memory_order_relaxed))
+        return;
+
+    Lock lock(registryMutex);
+
+    restorables[kind].insert(object);
+    trackingUsed.store(true, std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+void unregisterRestorable(RestorableKind kind, void* object)
+{
+    // Nothing to look up if the tracking was never used
+    if (!trackingUsed.load(std::memory_order_relaxed))
+        return;
+
+    Lock lock(registryMutex);
+
+    restorables[kind].erase(object);
+    retainedCopies.erase(object);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ConvexShape.hpp>
+#include <algorithm>
 
 
 namespace sf
@@ -60,10 +61,27 @@ void ConvexShape::setPoint(std::size_t index, const Vector2f& point)
 }
 
 
+////////////////////////////////////////////////////////////
+void ConvexShape::setPoints(const Vector2f* points, std::size_t count, bool updateGeometry)
+{
+    m_points.assign(points, points + count);
+
+    if (updateGeometry)
+        update();
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2f ConvexShape::getPoint(std::size_t index) const
 {
     return m_points[index];
 }
 
+
+////////////////////////////////////////////////////////////
+void ConvexShape::getPoints(Vector2f* points) const
+{
+    std::copy(m_points.begin(), m_points.end(), points);
+}
+
 } // namespace sf
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DirtyRegion.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+DirtyRegion::DirtyRegion() :
+m_bounds()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void DirtyRegion::add(const IntRect& area)
+{
+    if ((area.width <= 0) || (area.height <= 0))
+        return;
+
+    if (isEmpty())
+    {
+        m_bounds = area;
+        return;
+    }
+
+    int left   = std::min(area.left, m_bounds.left);
+    int top    = std::min(area.top, m_bounds.top);
+    int right  = std::max(area.left + area.width, m_bounds.left + m_bounds.width);
+    int bottom = std::max(area.top + area.height, m_bounds.top + m_bounds.height);
+
+    m_bounds = IntRect(left, top, right - left, bottom - top);
+}
+
+
+////////////////////////////////////////////////////////////
+void DirtyRegion::add(const FloatRect& area, const RenderTarget& target)
+{
+    // Map the corners to pixels, the view may be rotated
+    Vector2i corners[4] =
+    {
+        target.mapCoordsToPixel(Vector2f(area.left, area.top)),
+        target.mapCoordsToPixel(Vector2f(area.left + area.width, area.top)),
+        target.mapCoordsToPixel(Vector2f(area.left, area.top + area.height)),
+        target.mapCoordsToPixel(Vector2f(area.left + area.width, area.top + area.height))
+    };
+
+    Vector2i min = corners[0];
+    Vector2i max = corners[0];
+    for (int i = 1; i < 4; ++i)
+    {
+        min.x = std::min(min.x, corners[i].x);
+        min.y = std::min(min.y, corners[i].y);
+        max.x = std::max(max.x, corners[i].x);
+        max.y = std::max(max.y, corners[i].y);
+    }
+
+    // Grow by a pixel on each side for the rounding and the antialiasing
+    IntRect pixels(min.x - 1, min.y - 1, max.x - min.x + 3, max.y - min.y + 3);
+
+    // Clamp to the target
+    IntRect bounds(0, 0, static_cast<int>(target.getSize().x), static_cast<int>(target.getSize().y));
+    if (pixels.intersects(bounds, pixels))
+        add(pixels);
+}
+
+
+////////////////////////////////////////////////////////////
+void DirtyRegion::addAll(const RenderTarget& target)
+{
+    add(IntRect(0, 0, static_cast<int>(target.getSize().x), static_cast<int>(target.getSize().y)));
+}
+
+
+////////////////////////////////////////////////////////////
+bool DirtyRegion::isEmpty() const
+{
+    return (m_bounds.width <= 0) || (m_bounds.height <= 0);
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& DirtyRegion::getBounds() const
+{
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void DirtyRegion::clear()
+{
+    m_bounds = IntRect();
+}
+
+} // namespace sf
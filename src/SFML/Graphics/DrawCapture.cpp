@@ -0,0 +1,356 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DrawCapture.hpp>
+#include <SFML/Graphics/DrawCaptureFormat.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+
+namespace
+{
+    // 64-bit FNV-1a hash of the pixels of a texture
+    sf::Uint64 hashPixels(const sf::Uint8* pixels, std::size_t size)
+    {
+        sf::Uint64 hash = 14695981039346656037ull;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= pixels[i];
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+DrawCapture::DrawCapture() :
+m_file         (NULL),
+m_embedTextures(true),
+m_buffer       (),
+m_textures     (),
+m_shaders      (),
+m_nextId       (1),
+m_viewValid    (false),
+m_frameCount   (0),
+m_frameClock   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+DrawCapture::~DrawCapture()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool DrawCapture::openFromFile(const std::string& filename, bool embedTextures)
+{
+    close();
+
+    m_file = std::fopen(filename.c_str(), "wb");
+    if (!m_file)
+    {
+        err() << "Failed to create draw capture \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    m_embedTextures = embedTextures;
+    m_textures.clear();
+    m_shaders.clear();
+    m_nextId = 1;
+    m_viewValid = false;
+    m_frameCount = 0;
+    m_frameClock.restart();
+
+    m_buffer.assign(priv::captureHeaderSize, 0);
+    priv::writeBundleUint32(&m_buffer[0], priv::captureMagic);
+    priv::writeBundleUint32(&m_buffer[4], priv::captureVersion);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawCapture::close()
+{
+    if (!m_file)
+        return;
+
+    if (!m_buffer.empty() && (std::fwrite(&m_buffer[0], 1, m_buffer.size(), m_file) != m_buffer.size()))
+        err() << "Failed to write the end of the draw capture" << std::endl;
+
+    std::fclose(m_file);
+    m_file = NULL;
+    m_buffer.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool DrawCapture::isOpen() const
+{
+    return m_file != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DrawCapture::getFrameCount() const
+{
+    return m_frameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawCapture::recordClear(const RenderTarget& target, const Color& color)
+{
+    if (!m_file)
+        return;
+
+    recordView(target);
+
+    Uint8* payload = addRecord(priv::CaptureClear, priv::captureClearSize);
+    payload[0] = color.r;
+    payload[1] = color.g;
+    payload[2] = color.b;
+    payload[3] = color.a;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawCapture::recordDraw(const RenderTarget& target, const Vertex* vertices, std::size_t vertexCount,
+                             const Uint16* indices, std::size_t indexCount, PrimitiveType type, const RenderStates& states)
+{
+    if (!m_file)
+        return;
+
+    recordView(target);
+
+    // The resources are recorded before the draw that uses them
+    const Uint32 textureId = recordTexture(states.texture);
+    const Uint32 shaderId = recordShader(states.shader);
+
+    Uint8* payload = addRecord(priv::CaptureDraw, priv::captureDrawSize + vertexCount * priv::captureVertexSize + indexCount * 2);
+    priv::writeBundleUint32(payload + 0, static_cast<Uint32>(type));
+    priv::writeBundleUint32(payload + 4, states.blendMode.getKey());
+    priv::writeBundleUint32(payload + 8, textureId);
+    priv::writeBundleUint32(payload + 12, shaderId);
+
+    const float* matrix = states.transform.getAffineMatrix();
+    for (int i = 0; i < 6; ++i)
+        priv::writeCaptureFloat(payload + 16 + i * 4, matrix[i]);
+
+    priv::writeBundleUint32(payload + 40, static_cast<Uint32>(vertexCount));
+    priv::writeBundleUint32(payload + 44, static_cast<Uint32>(indexCount));
+
+    Uint8* vertex = payload + priv::captureDrawSize;
+    for (std::size_t i = 0; i < vertexCount; ++i, vertex += priv::captureVertexSize)
+    {
+        priv::writeCaptureFloat(vertex + 0, vertices[i].position.x);
+        priv::writeCaptureFloat(vertex + 4, vertices[i].position.y);
+        vertex[8]  = vertices[i].color.r;
+        vertex[9]  = vertices[i].color.g;
+        vertex[10] = vertices[i].color.b;
+        vertex[11] = vertices[i].color.a;
+        priv::writeCaptureFloat(vertex + 12, vertices[i].texCoords.x);
+        priv::writeCaptureFloat(vertex + 16, vertices[i].texCoords.y);
+    }
+
+    for (std::size_t i = 0; i < indexCount; ++i, vertex += 2)
+    {
+        vertex[0] = static_cast<Uint8>(indices[i]);
+        vertex[1] = static_cast<Uint8>(indices[i] >> 8);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawCapture::recordBufferDraw(std::size_t vertexCount)
+{
+    if (!m_file)
+        return;
+
+    Uint8* payload = addRecord(priv::CaptureBuffer, priv::captureBufferSize);
+    priv::writeBundleUint32(payload, static_cast<Uint32>(vertexCount));
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawCapture::recordFrame()
+{
+    if (!m_file)
+        return;
+
+    Uint8* payload = addRecord(priv::CaptureFrame, priv::captureFrameSize);
+    priv::writeBundleUint64(payload, static_cast<Uint64>(m_frameClock.restart().asMicroseconds()));
+
+    // One write per frame keeps the file usable if the application stops
+    if (std::fwrite(&m_buffer[0], 1, m_buffer.size(), m_file) != m_buffer.size())
+    {
+        err() << "Failed to write the draw capture, capture stopped" << std::endl;
+        std::fclose(m_file);
+        m_file = NULL;
+    }
+    else
+    {
+        std::fflush(m_file);
+    }
+
+    m_buffer.clear();
+    ++m_frameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawCapture::recordView(const RenderTarget& target)
+{
+    const View& view = target.getView();
+    const Vector2u targetSize = target.getSize();
+    const FloatRect& viewport = view.getViewport();
+
+    const float current[11] =
+    {
+        static_cast<float>(targetSize.x), static_cast<float>(targetSize.y),
+        view.getCenter().x, view.getCenter().y, view.getSize().x, view.getSize().y, view.getRotation(),
+        viewport.left, viewport.top, viewport.width, viewport.height
+    };
+
+    if (m_viewValid && (std::memcmp(current, m_view, sizeof(m_view)) == 0))
+        return;
+
+    std::memcpy(m_view, current, sizeof(m_view));
+    m_viewValid = true;
+
+    Uint8* payload = addRecord(priv::CaptureView, priv::captureViewSize);
+    priv::writeBundleUint32(payload + 0, targetSize.x);
+    priv::writeBundleUint32(payload + 4, targetSize.y);
+    for (int i = 2; i < 11; ++i)
+        priv::writeCaptureFloat(payload + i * 4, current[i]);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 DrawCapture::recordTexture(const Texture* texture)
+{
+    if (!texture)
+        return 0;
+
+    // Textures are read back only when they are new or their pixels changed
+    std::map<const Texture*, TextureEntry>::iterator it = m_textures.find(texture);
+    if ((it != m_textures.end()) && (it->second.contentId == texture->getContentId()))
+        return it->second.id;
+
+    if (it == m_textures.end())
+    {
+        TextureEntry entry;
+        entry.id = m_nextId++;
+        entry.contentId = 0;
+        it = m_textures.insert(std::make_pair(texture, entry)).first;
+    }
+
+    it->second.contentId = texture->getContentId();
+
+    const Image image = texture->copyToImage();
+    const Vector2u size = image.getSize();
+    const std::size_t pixelSize = static_cast<std::size_t>(size.x) * size.y * 4;
+    const bool embedded = m_embedTextures && (pixelSize > 0);
+
+    Uint32 flags = 0;
+    if (texture->isSmooth())
+        flags |= priv::captureTextureSmooth;
+    if (texture->isRepeated())
+        flags |= priv::captureTextureRepeat;
+    if (texture->getCoordinateType() == Texture::Pixels)
+        flags |= priv::captureTextureTexels;
+    if (texture->isSingleChannel())
+        flags |= priv::captureTextureSingle;
+    if (embedded)
+        flags |= priv::captureTexturePixels;
+
+    // The size of the texture is kept if its pixels can't be read back
+    const Vector2u recordedSize = (pixelSize > 0) ? size : texture->getSize();
+
+    Uint8* payload = addRecord(priv::CaptureTexture, priv::captureTextureSize + (embedded ? pixelSize : 0));
+    priv::writeBundleUint32(payload + 0, it->second.id);
+    priv::writeBundleUint32(payload + 4, recordedSize.x);
+    priv::writeBundleUint32(payload + 8, recordedSize.y);
+    priv::writeBundleUint32(payload + 12, flags);
+    priv::writeBundleUint64(payload + 16, (pixelSize > 0) ? hashPixels(image.getPixelsPtr(), pixelSize) : 0);
+
+    if (embedded)
+        std::memcpy(payload + priv::captureTextureSize, image.getPixelsPtr(), pixelSize);
+
+    return it->second.id;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 DrawCapture::recordShader(const Shader* shader)
+{
+    if (!shader)
+        return 0;
+
+    // A shader reloaded with other sources counts as a new one
+    std::map<const Shader*, ShaderEntry>::iterator it = m_shaders.find(shader);
+    if ((it != m_shaders.end()) && (it->second.key == shader->m_programKey))
+        return it->second.id;
+
+    ShaderEntry entry;
+    entry.id = m_nextId++;
+    entry.key = shader->m_programKey;
+    m_shaders[shader] = entry;
+
+    Uint8* payload = addRecord(priv::CaptureShader, priv::captureShaderSize);
+    priv::writeBundleUint32(payload + 0, entry.id);
+    priv::writeBundleUint64(payload + 4, entry.key);
+
+    return entry.id;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* DrawCapture::addRecord(Uint32 type, std::size_t payloadSize)
+{
+    const std::size_t offset = m_buffer.size();
+    m_buffer.resize(offset + priv::captureRecordSize + payloadSize);
+
+    priv::writeBundleUint32(&m_buffer[offset], type);
+    priv::writeBundleUint32(&m_buffer[offset + 4], static_cast<Uint32>(payloadSize));
+
+    return &m_buffer[offset + priv::captureRecordSize];
+}
+
+} // namespace sf
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DrawList.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+DrawList::DrawList() :
+m_commands(),
+m_vertices(),
+m_layer   (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawList::append(const Vertex* vertices, std::size_t vertexCount,
+                      PrimitiveType type, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    // Copy the vertices to the arena, in world coordinates
+    std::size_t firstVertex = m_vertices.size();
+    m_vertices.resize(firstVertex + vertexCount);
+
+    Vertex* arena = &m_vertices[firstVertex];
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        arena[i] = vertices[i];
+        arena[i].position = states.transform.transformPoint(vertices[i].position);
+    }
+
+    // The native handles are only read, no OpenGL call is made here
+    Uint64 shaderId  = states.shader ? states.shader->getNativeHandle() : 0;
+    Uint64 textureId = states.texture ? states.texture->getNativeHandle() : 0;
+
+    Command command;
+    command.key         = (static_cast<Uint64>(m_layer) << 56) | ((shaderId & 0xFFFFFF) << 32) | (textureId & 0xFFFFFFFF);
+    command.layer       = m_layer;
+    command.firstVertex = firstVertex;
+    command.vertexCount = vertexCount;
+    command.type        = type;
+    command.blendMode   = states.blendMode;
+    command.texture     = states.texture;
+    command.shader      = states.shader;
+
+    m_commands.push_back(command);
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawList::setLayer(Uint8 layer)
+{
+    m_layer = layer;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8 DrawList::getLayer() const
+{
+    return m_layer;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawList::sort()
+{
+    std::stable_sort(m_commands.begin(), m_commands.end(), [](const Command& left, const Command& right)
+    {
+        return left.key < right.key;
+    });
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawList::clear()
+{
+    m_commands.clear();
+    m_vertices.clear();
+    m_layer = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawList::reserve(std::size_t vertexCount)
+{
+    m_vertices.reserve(vertexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DrawList::getCommandCount() const
+{
+    return m_commands.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DrawList::getVertexCount() const
+{
+    return m_vertices.size();
+}
+
+} // namespace sf
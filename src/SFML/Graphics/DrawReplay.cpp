@@ -0,0 +1,413 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DrawReplay.hpp>
+#include <SFML/Graphics/DrawCaptureFormat.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Err.hpp>
+#include <fstream>
+#include <limits>
+
+
+namespace
+{
+    // Blend mode keys read from the file must map to valid enumerators
+    bool isValidBlendKey(sf::Uint32 key)
+    {
+        const sf::Uint32 maxFactor = sf::BlendMode::OneMinusDstAlpha;
+        const sf::Uint32 maxEquation = sf::BlendMode::Max;
+
+        return (key >> 22) == 0 &&
+               (((key >> 18) & 0xF) <= maxFactor) && (((key >> 14) & 0xF) <= maxFactor) &&
+               (((key >> 7) & 0xF) <= maxFactor) && (((key >> 3) & 0xF) <= maxFactor) &&
+               (((key >> 11) & 0x7) <= maxEquation) && ((key & 0x7) <= maxEquation);
+    }
+
+    // Placeholder for a texture whose pixels weren't captured: a checkerboard
+    // tinted by the content hash, so that different textures look different
+    sf::Image makePlaceholder(unsigned int width, unsigned int height, sf::Uint64 hash)
+    {
+        const sf::Color tint(static_cast<sf::Uint8>(hash | 0x40), static_cast<sf::Uint8>((hash >> 8) | 0x40),
+                             static_cast<sf::Uint8>((hash >> 16) | 0x40));
+
+        sf::Image image;
+        image.create(width, height, tint);
+        for (unsigned int y = 0; y < height; ++y)
+            for (unsigned int x = 0; x < width; ++x)
+                if (((x / 8) + (y / 8)) % 2)
+                    image.setPixel(x, y, sf::Color(tint.r / 2, tint.g / 2, tint.b / 2));
+
+        return image;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+DrawReplay::DrawReplay() :
+m_data      (),
+m_frames    (),
+m_targetSize(),
+m_textures  (),
+m_vertices  (),
+m_indices   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+DrawReplay::~DrawReplay()
+{
+    for (std::map<Uint32, Texture*>::iterator it = m_textures.begin(); it != m_textures.end(); ++it)
+        delete it->second;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DrawReplay::loadFromFile(const std::string& filename)
+{
+    for (std::map<Uint32, Texture*>::iterator it = m_textures.begin(); it != m_textures.end(); ++it)
+        delete it->second;
+
+    m_textures.clear();
+    m_frames.clear();
+    m_data.clear();
+    m_targetSize = Vector2u();
+
+    std::ifstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to open draw capture \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    file.seekg(0, std::ios_base::end);
+    std::streamsize size = file.tellg();
+    if (size > 0)
+    {
+        file.seekg(0, std::ios_base::beg);
+        m_data.resize(static_cast<std::size_t>(size));
+        file.read(reinterpret_cast<char*>(&m_data[0]), size);
+    }
+
+    if ((m_data.size() < priv::captureHeaderSize) || (priv::readBundleUint32(&m_data[0]) != priv::captureMagic))
+    {
+        err() << "Failed to load draw capture \"" << filename << "\" (not a draw capture)" << std::endl;
+        m_data.clear();
+        return false;
+    }
+
+    if (priv::readBundleUint32(&m_data[4]) != priv::captureVersion)
+    {
+        err() << "Failed to load draw capture \"" << filename << "\" (unsupported version)" << std::endl;
+        m_data.clear();
+        return false;
+    }
+
+    // Split the records into frames; a truncated end (the application
+    // stopped during a frame) is ignored
+    Frame frame;
+    frame.begin = priv::captureHeaderSize;
+    frame.info = FrameInfo();
+
+    std::size_t offset = priv::captureHeaderSize;
+    while (offset + priv::captureRecordSize <= m_data.size())
+    {
+        const Uint32 type = priv::readBundleUint32(&m_data[offset]);
+        const std::size_t payloadSize = priv::readBundleUint32(&m_data[offset + 4]);
+        const Uint8* payload = &m_data[offset + priv::captureRecordSize];
+        if (payloadSize > m_data.size() - offset - priv::captureRecordSize)
+            break;
+
+        offset += priv::captureRecordSize + payloadSize;
+
+        switch (type)
+        {
+            case priv::CaptureTexture:
+                ++frame.info.textureUploads;
+                break;
+
+            case priv::CaptureView:
+                if ((m_targetSize == Vector2u()) && (payloadSize >= priv::captureViewSize))
+                    m_targetSize = Vector2u(priv::readBundleUint32(payload), priv::readBundleUint32(payload + 4));
+                break;
+
+            case priv::CaptureDraw:
+                if (payloadSize >= priv::captureDrawSize)
+                {
+                    ++frame.info.draws;
+                    frame.info.vertices += priv::readBundleUint32(payload + 40);
+                    if (priv::readBundleUint32(payload + 12) != 0)
+                        ++frame.info.shadedDraws;
+                }
+                break;
+
+            case priv::CaptureBuffer:
+                ++frame.info.skippedDraws;
+                break;
+
+            case priv::CaptureFrame:
+                if (payloadSize >= priv::captureFrameSize)
+                    frame.info.capturedTime = microseconds(static_cast<Int64>(priv::readBundleUint64(payload)));
+
+                frame.end = offset;
+                m_frames.push_back(frame);
+
+                frame.begin = offset;
+                frame.info = FrameInfo();
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (m_frames.empty())
+    {
+        err() << "Failed to load draw capture \"" << filename << "\" (no complete frame)" << std::endl;
+        m_data.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DrawReplay::getFrameCount() const
+{
+    return m_frames.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u DrawReplay::getTargetSize() const
+{
+    return m_targetSize;
+}
+
+
+////////////////////////////////////////////////////////////
+const DrawReplay::FrameInfo& DrawReplay::getFrameInfo(std::size_t frame) const
+{
+    return m_frames[frame].info;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DrawReplay::replayFrame(std::size_t frame, RenderTarget& target)
+{
+    if (frame >= m_frames.size())
+        return false;
+
+    std::size_t offset = m_frames[frame].begin;
+    while (offset < m_frames[frame].end)
+    {
+        const Uint32 type = priv::readBundleUint32(&m_data[offset]);
+        const std::size_t size = priv::readBundleUint32(&m_data[offset + 4]);
+        const Uint8* payload = &m_data[offset + priv::captureRecordSize];
+        offset += priv::captureRecordSize + size;
+
+        switch (type)
+        {
+            case priv::CaptureTexture:
+            {
+                if (!replayTexture(payload, size))
+                    return false;
+                break;
+            }
+
+            case priv::CaptureView:
+            {
+                if (size < priv::captureViewSize)
+                    return false;
+
+                View view(Vector2f(priv::readCaptureFloat(payload + 8), priv::readCaptureFloat(payload + 12)),
+                          Vector2f(priv::readCaptureFloat(payload + 16), priv::readCaptureFloat(payload + 20)));
+                view.setRotation(priv::readCaptureFloat(payload + 24));
+                view.setViewport(FloatRect(priv::readCaptureFloat(payload + 28), priv::readCaptureFloat(payload + 32),
+                                           priv::readCaptureFloat(payload + 36), priv::readCaptureFloat(payload + 40)));
+                target.setView(view);
+                break;
+            }
+
+            case priv::CaptureClear:
+            {
+                if (size < priv::captureClearSize)
+                    return false;
+
+                target.clear(Color(payload[0], payload[1], payload[2], payload[3]));
+                break;
+            }
+
+            case priv::CaptureDraw:
+            {
+                if (!replayDraw(payload, size, target))
+                    return false;
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DrawReplay::replayTexture(const Uint8* payload, std::size_t size)
+{
+    if (size < priv::captureTextureSize)
+        return false;
+
+    const Uint32 id = priv::readBundleUint32(payload);
+    const unsigned int width = priv::readBundleUint32(payload + 4);
+    const unsigned int height = priv::readBundleUint32(payload + 8);
+    const Uint32 flags = priv::readBundleUint32(payload + 12);
+    const Uint64 hash = priv::readBundleUint64(payload + 16);
+
+    // Image computes its size in unsigned int: the dimensions are bounded so
+    // that neither the image nor the placeholder can wrap around
+    const unsigned int maximumSize = Texture::getMaximumSize();
+    if ((width > maximumSize) || (height > maximumSize) ||
+        (static_cast<Uint64>(width) * height * 4 > std::numeric_limits<unsigned int>::max()))
+        return false;
+
+    Image image;
+    if (flags & priv::captureTexturePixels)
+    {
+        const std::size_t pixelSize = static_cast<std::size_t>(width) * height * 4;
+        if (pixelSize > size - priv::captureTextureSize)
+            return false;
+
+        image.create(width, height, payload + priv::captureTextureSize);
+
+        // Single channel textures are drawn as white with the red channel as alpha
+        if (flags & priv::captureTextureSingle)
+        {
+            // Walk the image that was actually created, not the size read from the file
+            const Vector2u imageSize = image.getSize();
+            for (unsigned int y = 0; y < imageSize.y; ++y)
+                for (unsigned int x = 0; x < imageSize.x; ++x)
+                    image.setPixel(x, y, Color(255, 255, 255, image.getPixel(x, y).r));
+        }
+    }
+    else
+    {
+        image = makePlaceholder(width, height, hash);
+    }
+
+    Texture*& texture = m_textures[id];
+    if (!texture)
+        texture = new Texture;
+
+    if ((width > 0) && (height > 0) && !texture->loadFromImage(image))
+        return false;
+
+    texture->setSmooth((flags & priv::captureTextureSmooth) != 0);
+    texture->setRepeated((flags & priv::captureTextureRepeat) != 0);
+    texture->m_texCoordType = (flags & priv::captureTextureTexels) ? Texture::Pixels : Texture::Normalized;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DrawReplay::replayDraw(const Uint8* payload, std::size_t size, RenderTarget& target)
+{
+    if (size < priv::captureDrawSize)
+        return false;
+
+    const Uint32 type = priv::readBundleUint32(payload + 0);
+    const Uint32 blendKey = priv::readBundleUint32(payload + 4);
+    const Uint32 textureId = priv::readBundleUint32(payload + 8);
+    const std::size_t vertexCount = priv::readBundleUint32(payload + 40);
+    const std::size_t indexCount = priv::readBundleUint32(payload + 44);
+
+    if ((type > Quads) || !isValidBlendKey(blendKey) ||
+        (vertexCount > (size - priv::captureDrawSize) / priv::captureVertexSize) ||
+        (indexCount > (size - priv::captureDrawSize - vertexCount * priv::captureVertexSize) / 2))
+        return false;
+
+    float matrix[6];
+    for (int i = 0; i < 6; ++i)
+        matrix[i] = priv::readCaptureFloat(payload + 16 + i * 4);
+
+    // Shaders can't be rebuilt from their hash, the draw uses the default pipeline
+    RenderStates states;
+    states.blendMode = priv::unpackBlendMode(blendKey);
+    states.transform = Transform(matrix[0], matrix[1], matrix[2],
+                                 matrix[3], matrix[4], matrix[5],
+                                 0.f,       0.f,       1.f);
+
+    if (textureId)
+    {
+        std::map<Uint32, Texture*>::const_iterator it = m_textures.find(textureId);
+        states.texture = (it != m_textures.end()) ? it->second : NULL;
+    }
+
+    m_vertices.resize(vertexCount);
+    const Uint8* vertex = payload + priv::captureDrawSize;
+    for (std::size_t i = 0; i < vertexCount; ++i, vertex += priv::captureVertexSize)
+    {
+        m_vertices[i].position  = Vector2f(priv::readCaptureFloat(vertex + 0), priv::readCaptureFloat(vertex + 4));
+        m_vertices[i].color     = Color(vertex[8], vertex[9], vertex[10], vertex[11]);
+        m_vertices[i].texCoords = Vector2f(priv::readCaptureFloat(vertex + 12), priv::readCaptureFloat(vertex + 16));
+    }
+
+    if (vertexCount == 0)
+        return true;
+
+    if (indexCount > 0)
+    {
+        m_indices.resize(indexCount);
+        for (std::size_t i = 0; i < indexCount; ++i, vertex += 2)
+        {
+            m_indices[i] = static_cast<Uint16>(vertex[0] | (vertex[1] << 8));
+
+            // An index past the vertices would read out of the array: the draw is dropped
+            if (m_indices[i] >= vertexCount)
+                return true;
+        }
+
+        target.draw(&m_vertices[0], vertexCount, &m_indices[0], indexCount, static_cast<PrimitiveType>(type), states);
+    }
+    else
+    {
+        target.draw(&m_vertices[0], vertexCount, static_cast<PrimitiveType>(type), states);
+    }
+
+    return true;
+}
+
+} // namespace sf
@@ -0,0 +1,275 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DynamicAtlas.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/SkylinePacker.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int pageSize = 1024; // Width and height of the pages (if supported)
+    const unsigned int padding  = 2;    // Transparent rows and columns around each copy
+    const std::size_t  maxPages = 8;    // Textures that don't fit are drawn from their own storage
+
+    // Shared texture holding the copies of many small textures
+    struct Page
+    {
+        sf::Texture*            texture;
+        sf::priv::SkylinePacker packer;
+        bool                    smooth;  // pages are filtered like the textures they hold
+        std::size_t             copies;  // live copies in the page
+        bool                    recycle; // every copy was released, clear it before packing again
+    };
+
+    // Copy of a texture in a page
+    struct Entry
+    {
+        std::size_t  page;      // maxPages if the texture has no copy
+        sf::Vector2u position;
+        sf::Vector2u size;
+        bool         smooth;
+        sf::Uint64   contentId; // pixels of the texture that the copy holds, or that didn't fit
+    };
+
+    // Recursive, since the pages are textures: destroying one releases its (missing) entry
+    std::recursive_mutex                          atlasMutex;
+    std::vector<Page>                             pages;
+    std::unordered_map<const sf::Texture*, Entry> entries;
+
+    // Keeps the destruction of textures lock-free until the atlas is used
+    std::atomic<bool> atlasUsed(false);
+
+
+    // Fill a page with transparent pixels, so that the padding doesn't bleed when smoothing
+    bool clearPage(sf::Texture& texture, unsigned int size)
+    {
+        sf::Image pixels;
+        pixels.create(size, size, sf::Color::Transparent);
+
+        if (texture.getSize() == pixels.getSize())
+        {
+            texture.update(pixels);
+            return true;
+        }
+
+        return texture.loadFromImage(pixels);
+    }
+
+
+    bool addPage(bool smooth)
+    {
+        unsigned int size = std::min(pageSize, sf::Texture::getMaximumSize());
+
+        Page page;
+        page.texture = new sf::Texture;
+        page.smooth  = smooth;
+        page.copies  = 0;
+        page.recycle = false;
+
+        if (!clearPage(*page.texture, size))
+        {
+            sf::err() << "Failed to add a page to the dynamic texture atlas" << std::endl;
+            delete page.texture;
+            return false;
+        }
+
+        page.texture->setSmooth(smooth);
+
+        // The first rows and columns of the page hold the left and top padding
+        page.packer.reset(size, size, padding);
+
+        pages.push_back(page);
+        return true;
+    }
+
+
+    // Reserve room for a texture in a page with the same filter
+    bool placeEntry(Entry& entry)
+    {
+        unsigned int size = std::min(pageSize, sf::Texture::getMaximumSize());
+        if ((entry.size.x + padding * 2 > size) || (entry.size.y + padding * 2 > size))
+            return false;
+
+        // Each copy reserves its padding on the right and bottom
+        unsigned int width  = entry.size.x + padding;
+        unsigned int height = entry.size.y + padding;
+
+        sf::IntRect rect;
+        for (std::size_t i = pages.size(); i > 0; --i)
+        {
+            Page& page = pages[i - 1];
+            if (page.smooth != entry.smooth)
+                continue;
+
+            if (page.recycle)
+            {
+                clearPage(*page.texture, size);
+                page.packer.reset(size, size, padding);
+                page.recycle = false;
+            }
+
+            if (page.packer.insert(width, height, rect))
+            {
+                entry.page = i - 1;
+                break;
+            }
+        }
+
+        if (entry.page == maxPages)
+        {
+            if ((pages.size() == maxPages) || !addPage(entry.smooth) || !pages.back().packer.insert(width, height, rect))
+                return false;
+
+            entry.page = pages.size() - 1;
+        }
+
+        entry.position = sf::Vector2u(static_cast<unsigned int>(rect.left), static_cast<unsigned int>(rect.top));
+        ++pages[entry.page].copies;
+
+        return true;
+    }
+
+
+    void releaseCopy(Entry& entry)
+    {
+        if (entry.page == maxPages)
+            return;
+
+        // The room of the copies isn't reused one by one, the page is cleared once empty
+        Page& page = pages[entry.page];
+        if (--page.copies == 0)
+            page.recycle = true;
+
+        entry.page = maxPages;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+const Texture* getAtlasPage(const Texture& texture, Vector2f& offset)
+{
+    unsigned int threshold = Texture::getDynamicAtlasThreshold();
+    if (!threshold || !texture.m_texture || (texture.m_size.x > threshold) || (texture.m_size.y > threshold))
+        return NULL;
+
+    // Only the textures that are sampled exactly like their copy would be
+    if (texture.m_isRepeated || texture.m_hasMipmap || texture.m_pixelsFlipped || texture.m_fboAttachment ||
+        texture.m_distanceField || texture.m_sRgb || (texture.m_format != Texture::RGBA8) ||
+        (texture.m_texCoordType != Texture::Pixels) || texture.m_lazySource || texture.m_resolver)
+        return NULL;
+
+    std::lock_guard<std::recursive_mutex> lock(atlasMutex);
+
+    std::unordered_map<const Texture*, Entry>::iterator it = entries.find(&texture);
+    if (it == entries.end())
+    {
+        Entry entry;
+        entry.page      = maxPages;
+        entry.size      = texture.m_size;
+        entry.smooth    = texture.m_isSmooth;
+        entry.contentId = 0;
+
+        it = entries.insert(std::make_pair(&texture, entry)).first;
+        atlasUsed = true;
+    }
+
+    Entry& entry = it->second;
+
+    if ((entry.size != texture.m_size) || (entry.smooth != texture.m_isSmooth))
+    {
+        releaseCopy(entry);
+        entry.size      = texture.m_size;
+        entry.smooth    = texture.m_isSmooth;
+        entry.contentId = 0;
+    }
+
+    // Copy the pixels again when they changed; textures that didn't
+    // fit are only tried again when their pixels change
+    if (entry.contentId != texture.m_contentId)
+    {
+        entry.contentId = texture.m_contentId;
+
+        if ((entry.page == maxPages) && !placeEntry(entry))
+            return NULL;
+
+        pages[entry.page].texture->update(texture, entry.position.x, entry.position.y);
+    }
+
+    if (entry.page == maxPages)
+        return NULL;
+
+    offset = Vector2f(static_cast<float>(entry.position.x), static_cast<float>(entry.position.y));
+    return pages[entry.page].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void releaseAtlasEntry(const Texture& texture)
+{
+    if (!atlasUsed)
+        return;
+
+    std::lock_guard<std::recursive_mutex> lock(atlasMutex);
+
+    std::unordered_map<const Texture*, Entry>::iterator it = entries.find(&texture);
+    if (it != entries.end())
+    {
+        releaseCopy(it->second);
+        entries.erase(it);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void releaseAtlasPages()
+{
+    std::lock_guard<std::recursive_mutex> lock(atlasMutex);
+
+    std::vector<Page> released;
+    released.swap(pages);
+    entries.clear();
+
+    for (std::size_t i = 0; i < released.size(); ++i)
+        delete released[i].texture;
+}
+
+} // namespace priv
+
+} // namespace sf
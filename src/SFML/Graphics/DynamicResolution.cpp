@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DynamicResolution.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Weight of the last frame in the smoothed GPU time
+    const float smoothing = 0.2f;
+
+    // Number of updates before the scale goes up again, so that
+    // the profiler results of the new scale come in first
+    const unsigned int upscaleDelay = 30;
+
+    // The next scale must be predicted under this ratio of the target
+    const float upscaleHeadroom = 0.85f;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+DynamicResolution::DynamicResolution(RenderTexturePool& pool) :
+m_pool        (&pool),
+m_target      (NULL),
+m_area        (),
+m_targetTime  (microseconds(16667)),
+m_minScale    (0.5f),
+m_maxScale    (1.f),
+m_levelCount  (6),
+m_level       (5),
+m_averageTime (-1.f),
+m_stableFrames(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void DynamicResolution::setTargetFrameTime(Time time)
+{
+    m_targetTime = time;
+}
+
+
+////////////////////////////////////////////////////////////
+void DynamicResolution::setScaleRange(float minimum, float maximum, unsigned int levels)
+{
+    m_maxScale     = std::min(std::max(maximum, 0.01f), 1.f);
+    m_minScale     = std::min(std::max(minimum, 0.01f), m_maxScale);
+    m_levelCount   = std::max(levels, 2u);
+    m_level        = m_levelCount - 1;
+    m_stableFrames = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void DynamicResolution::update(Time gpuTime)
+{
+    float time = gpuTime.asSeconds();
+    float target = m_targetTime.asSeconds();
+
+    m_averageTime = (m_averageTime < 0.f) ? time : m_averageTime + (time - m_averageTime) * smoothing;
+    ++m_stableFrames;
+
+    if (target <= 0.f)
+        return;
+
+    float scale = getLevelScale(m_level);
+
+    if ((m_averageTime > target) && (m_level > 0))
+    {
+        // The time grows with the area: pick the largest level that should fit the target
+        float wanted = scale * std::sqrt(target / m_averageTime);
+        unsigned int level = m_level - 1;
+        while ((level > 0) && (getLevelScale(level) > wanted))
+            --level;
+
+        // The average was measured at the old scale, convert it
+        float ratio = getLevelScale(level) / scale;
+        m_averageTime *= ratio * ratio;
+        m_level = level;
+        m_stableFrames = 0;
+    }
+    else if ((m_level + 1 < m_levelCount) && (m_stableFrames >= upscaleDelay))
+    {
+        float ratio = getLevelScale(m_level + 1) / scale;
+        if (m_averageTime * ratio * ratio < target * upscaleHeadroom)
+        {
+            m_averageTime *= ratio * ratio;
+            ++m_level;
+            m_stableFrames = 0;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float DynamicResolution::getScale() const
+{
+    return getLevelScale(m_level);
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexture* DynamicResolution::begin(const RenderTarget& output, const View& view)
+{
+    m_area = output.getViewport(view);
+    m_target = NULL;
+
+    if ((m_area.width <= 0) || (m_area.height <= 0))
+        return NULL;
+
+    float scale = getLevelScale(m_level);
+    unsigned int width  = std::max(static_cast<unsigned int>(m_area.width * scale + 0.5f), 1u);
+    unsigned int height = std::max(static_cast<unsigned int>(m_area.height * scale + 0.5f), 1u);
+
+    m_target = m_pool->acquire(width, height);
+    if (!m_target)
+        return NULL;
+
+    // The scene keeps its coordinates, only the resolution changes
+    View sceneView(view);
+    sceneView.setViewport(FloatRect(0.f, 0.f, 1.f, 1.f));
+    m_target->setView(sceneView);
+    m_target->setSmooth(true);
+
+    return m_target;
+}
+
+
+////////////////////////////////////////////////////////////
+void DynamicResolution::end(RenderTarget& output)
+{
+    if (!m_target)
+        return;
+
+    m_target->display();
+
+    Vector2u size = m_target->getSize();
+    Sprite sprite(m_target->getTexture());
+    sprite.setPosition(static_cast<float>(m_area.left), static_cast<float>(m_area.top));
+    sprite.setScale(static_cast<float>(m_area.width) / size.x, static_cast<float>(m_area.height) / size.y);
+
+    // Draw in pixels of the output target
+    View previousView = output.getView();
+    Vector2u outputSize = output.getSize();
+    output.setView(View(FloatRect(0.f, 0.f, static_cast<float>(outputSize.x), static_cast<float>(outputSize.y))));
+    output.draw(sprite);
+    output.setView(previousView);
+
+    // The render texture goes back to the pool at the end of the frame, once its draw is submitted
+    m_target = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+float DynamicResolution::getLevelScale(unsigned int level) const
+{
+    return m_minScale + (m_maxScale - m_minScale) * level / (m_levelCount - 1);
+}
+
+} // namespace sf
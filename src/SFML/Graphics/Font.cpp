@@ -26,14 +26,30 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/BitmapFontFormat.hpp>
+#include <SFML/Graphics/ContextRestore.hpp>
+#include <SFML/Graphics/FontCollection.hpp>
+#include <SFML/Graphics/FontMetrics.hpp>
+#include <SFML/Graphics/FreeTypeLibrary.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GlyphRasterizer.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/MemoryStats.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Trace.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
-#include FT_OUTLINE_H
-#include FT_BITMAP_H
 #include FT_STROKER_H
+#include FT_ADVANCES_H
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -49,539 +65,2155 @@ namespace
         return output;
     }
 
-    // Combine outline thickness, boldness and font glyph index into a single 64-bit key
+    // Size at which distance field glyphs are rendered, other sizes scale it
+    const unsigned int distanceFieldSize = 64;
+
+    // Distance covered by the distance field on each side of the edge, in pixels of the base size (FreeType's default spread)
+    const float distanceFieldSpread = 8.f;
+
+    // Combine outline thickness, boldness and glyph index into a single 64-bit key
     sf::Uint64 combine(float outlineThickness, bool bold, sf::Uint32 index)
     {
-        return (static_cast<sf::Uint64>(reinterpret<sf::Uint32>(outlineThickness)) << 32) | (static_cast<sf::Uint64>(bold) << 31) | index;
+        return (static_cast<sf::Uint64>(reinterpret<sf::Uint32>(outlineThickness)) << 32) | (static_cast<sf::Uint64>(bold) << 31) | (index & 0x7FFFFFFF);
+    }
+
+    // Extract the outline thickness, boldness and glyph index of a key
+    void split(sf::Uint64 key, float& outlineThickness, bool& bold, sf::Uint32& index)
+    {
+        outlineThickness = reinterpret<float>(static_cast<sf::Uint32>(key >> 32));
+        bold = ((key >> 31) & 1) != 0;
+        index = static_cast<sf::Uint32>(key & 0x7FFFFFFF);
+    }
+
+    // Combined fonts store the index of the fallback font in the high bits of the glyph index
+    const unsigned int collectionIndexShift = 24;
+    const sf::Uint32 collectionGlyphMask = (1 << collectionIndexShift) - 1;
+
+    // Number of code points of the dense kerning table, and its marker of pairs not loaded yet
+    const sf::Uint32 latin1Count = 256;
+    const sf::Int16 unknownKerning = -32768;
+
+    // Tag and layout version of the glyph cache data
+    const sf::Uint32 glyphCacheMagic   = 0x43474653; // "SFGC"
+    const sf::Uint32 glyphCacheVersion = 2;
+
+    // Append little endian values to a glyph cache
+    void writeUint32(std::vector<sf::Uint8>& data, sf::Uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+            data.push_back(static_cast<sf::Uint8>(value >> (i * 8)));
+    }
+
+    void writeUint64(std::vector<sf::Uint8>& data, sf::Uint64 value)
+    {
+        writeUint32(data, static_cast<sf::Uint32>(value));
+        writeUint32(data, static_cast<sf::Uint32>(value >> 32));
+    }
+
+    void writeFloat(std::vector<sf::Uint8>& data, float value)
+    {
+        writeUint32(data, reinterpret<sf::Uint32>(value));
+    }
+
+    // Read little endian values from a glyph cache, without reading past its end
+    struct CacheReader
+    {
+        CacheReader(const void* cacheData, std::size_t cacheSize) : data(static_cast<const sf::Uint8*>(cacheData)), size(cacheSize), position(0) {}
+
+        const sf::Uint8* read(std::size_t count)
+        {
+            if (count > size - position)
+                return NULL;
+
+            const sf::Uint8* bytes = data + position;
+            position += count;
+            return bytes;
+        }
+
+        bool readUint32(sf::Uint32& value)
+        {
+            const sf::Uint8* bytes = read(4);
+            if (!bytes)
+                return false;
+
+            value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<sf::Uint32>(bytes[3]) << 24);
+            return true;
+        }
+
+        bool readUint64(sf::Uint64& value)
+        {
+            sf::Uint32 low, high;
+            if (!readUint32(low) || !readUint32(high))
+                return false;
+
+            value = (static_cast<sf::Uint64>(high) << 32) | low;
+            return true;
+        }
+
+        bool readFloat(float& value)
+        {
+            sf::Uint32 bits;
+            if (!readUint32(bits))
+                return false;
+
+            value = reinterpret<float>(bits);
+            return true;
+        }
+
+        const sf::Uint8* data;
+        std::size_t      size;
+        std::size_t      position;
+    };
+
+    // Identify the font file a glyph cache was made for (64-bit FNV-1a)
+    sf::Uint64 hashFontData(const void* data, std::size_t size)
+    {
+        const sf::Uint8* bytes = static_cast<const sf::Uint8*>(data);
+        sf::Uint64 hash = 14695981039346656037ULL;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
     }
+
+    // Size of a new page texture
+    const unsigned int initialPageSize = 128;
+
+    // Frames without a request after which a glyph can be dropped from a full page
+    const sf::Uint64 glyphEvictionAge = 60;
+
+    // Lock of the lookups of a font, which does nothing if concurrent layout is disabled
+    class LayoutLock : sf::NonCopyable
+    {
+    public:
+
+        explicit LayoutLock(std::recursive_mutex* mutex) : m_mutex(mutex)
+        {
+            if (m_mutex)
+                m_mutex->lock();
+        }
+
+        ~LayoutLock()
+        {
+            if (m_mutex)
+                m_mutex->unlock();
+        }
+
+    private:
+
+        std::recursive_mutex* m_mutex;
+    };
 }
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-Font::Font() :
-m_library  (NULL),
-m_face     (NULL),
-m_streamRec(NULL),
-m_stroker  (NULL),
-m_refCount (NULL),
-m_info     ()
+Font::Stats::Stats() :
+glyphCacheHits   (0),
+glyphCacheMisses (0),
+glyphsRasterized (0),
+rasterizationTime(Time::Zero),
+kerningLookups   (0),
+kerningLoads     (0),
+pageGrowths      (0),
+pageRepacks      (0),
+pageCount        (0),
+pagePixels       (0),
+glyphPixels      (0),
+textRebuilds     (0),
+textRelayouts    (0)
 {
+}
 
+
+////////////////////////////////////////////////////////////
+Font::Font() :
+m_library      (NULL),
+m_face         (NULL),
+m_streamRec    (NULL),
+m_stroker      (NULL),
+m_refCount     (NULL),
+m_info         (),
+m_atlasShared  (false),
+m_distanceField(false),
+m_glyphPadding (0),
+m_repacking    (false),
+m_uploadDeferred(false),
+m_asyncLoading (false),
+m_rasterizer   (NULL),
+m_metrics      (NULL),
+m_generation   (0),
+m_revision     (0),
+m_fontData     (NULL),
+m_fontDataSize (0),
+m_bitmapSize   (0),
+m_bitmapLineSpacing(0.f),
+m_collection   (NULL),
+m_layoutMutex  (NULL),
+m_renderThread (),
+m_pendingLoads (false),
+m_memory       (MemoryStats::Fonts),
+m_stats        ()
+{
+    priv::registerRestorable(priv::RestorableFont, this);
 }
 
 
 ////////////////////////////////////////////////////////////
 Font::Font(const Font& copy) :
-m_library    (copy.m_library),
-m_face       (copy.m_face),
-m_streamRec  (copy.m_streamRec),
-m_stroker    (copy.m_stroker),
-m_refCount   (copy.m_refCount),
-m_info       (copy.m_info),
-m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_library      (copy.m_library),
+m_face         (copy.m_face),
+m_streamRec    (copy.m_streamRec),
+m_stroker      (copy.m_stroker),
+m_refCount     (copy.m_refCount),
+m_info         (copy.m_info),
+m_pages        (copy.m_pages),
+m_glyphs       (copy.m_glyphs),
+m_kerning      (copy.m_kerning),
+m_sizeMetrics  (copy.m_sizeMetrics),
+m_shapedRuns   (),
+m_atlasShared  (copy.m_atlasShared),
+m_distanceField(copy.m_distanceField),
+m_glyphPadding (copy.m_glyphPadding),
+m_repacking    (false),
+m_uploadDeferred(false),
+m_asyncLoading (copy.m_asyncLoading),
+m_rasterizer   (NULL),
+m_metrics      (NULL),
+m_generation   (0),
+m_revision     (0),
+m_fontData     (copy.m_fontData),
+m_fontDataSize (copy.m_fontDataSize),
+m_pixelBuffer  (copy.m_pixelBuffer),
+m_bitmapSize   (copy.m_bitmapSize),
+m_bitmapLineSpacing(copy.m_bitmapLineSpacing),
+m_collection   (copy.m_collection),
+m_layoutMutex  (copy.m_layoutMutex ? new std::recursive_mutex : NULL),
+m_renderThread (copy.m_renderThread),
+m_pendingLoads (false),
+m_memory       (copy.m_memory),
+m_stats        ()
 {
+    priv::registerRestorable(priv::RestorableFont, this);
+
     // Note: as FreeType doesn't provide functions for copying/cloning,
     // we must share all the FreeType pointers
 
     if (m_refCount)
         (*m_refCount)++;
+
+    // The requests of the placeholders belong to the other font
+    loadPendingGlyphs();
+
+    if (m_asyncLoading)
+        startRasterizer();
+
+    if (m_fontData)
+        openMetrics();
+
+    updateMemoryUsage();
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Font(Font&& right) noexcept :
+Font()
+{
+    swap(right);
+}
+
+
+////////////////////////////////////////////////////////////
+Font::~Font()
+{
+    priv::unregisterRestorable(priv::RestorableFont, this);
+
+    cleanup();
+    delete m_layoutMutex;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::loadFromFile(const std::string& filename)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
+{
+    // Cleanup the previous resources
+    cleanup();
+    m_refCount = new int(1);
+
+    // Get the FreeType library shared by all the fonts
+    FT_Library library = static_cast<FT_Library>(priv::acquireFreeTypeLibrary());
+    if (!library)
+    {
+        err() << "Failed to load font from memory (failed to initialize FreeType)" << std::endl;
+        return false;
+    }
+    m_library = library;
+
+    // Faces and strokers can't be created concurrently on the same library
+    FT_Face face;
+    FT_Stroker stroker;
+    {
+        Lock lock(priv::getFreeTypeLibraryMutex());
+
+        // Load the new font face from the specified file
+        if (FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(data), static_cast<FT_Long>(sizeInBytes), 0, &face) != 0)
+        {
+            err() << "Failed to load font from memory (failed to create the font face)" << std::endl;
+            return false;
+        }
+
+        // Load the stroker that will be used to outline the font
+        if (FT_Stroker_New(library, &stroker) != 0)
+        {
+            err() << "Failed to load font from memory (failed to create the stroker)" << std::endl;
+            FT_Done_Face(face);
+            return false;
+        }
+
+        // Select the Unicode character map
+        if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0)
+        {
+            err() << "Failed to load font from memory (failed to set the Unicode character set)" << std::endl;
+            FT_Stroker_Done(stroker);
+            FT_Done_Face(face);
+            return false;
+        }
+    }
+
+    // Store the loaded font in our ugly void* :)
+    m_stroker = stroker;
+    m_face = face;
+
+    // Store the font information
+    m_info.family = face->family_name ? face->family_name : std::string();
+
+    // Keep the data around for the rasterizer thread, which opens its own face
+    m_fontData     = data;
+    m_fontDataSize = sizeInBytes;
+    if (m_asyncLoading)
+        startRasterizer();
+
+    // The metrics have a face of their own too, for the threads measuring strings
+    openMetrics();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::loadFromStream(InputStream& stream)
+{
+    // FreeType reads the face in place, without copies and per-read callbacks
+    std::size_t sizeInBytes;
+    const void* data = stream.getContiguousData(sizeInBytes);
+    if (!data)
+    {
+        err() << "Failed to load font from stream (the stream contents are not contiguous in memory)" << std::endl;
+        return false;
+    }
+
+    return loadFromMemory(data, sizeInBytes);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::loadFromBitmapFont(const void* descriptor, std::size_t sizeInBytes, const Image* pages, std::size_t pageCount)
+{
+    priv::BitmapFontDescriptor font;
+    const char* error = "";
+    if (!priv::parseBitmapFont(descriptor, sizeInBytes, font, error))
+    {
+        err() << "Failed to load bitmap font (" << error << ")" << std::endl;
+        return false;
+    }
+
+    if (!pages || (pageCount < font.pages.size()))
+    {
+        err() << "Failed to load bitmap font (" << font.pages.size() << " pages expected, " << pageCount << " given)" << std::endl;
+        return false;
+    }
+
+    // Cleanup the previous resources
+    cleanup();
+    m_bitmapSize        = static_cast<unsigned int>(font.size);
+    m_bitmapLineSpacing = static_cast<float>(font.lineHeight);
+    m_info.family       = font.face;
+
+    // All the glyphs go to a single page, which is uploaded once they are all copied
+    m_uploadDeferred = true;
+    Page& page = m_pages[m_bitmapSize];
+    initializePage(page);
+
+    priv::GlyphTable& glyphs = m_glyphs[m_bitmapSize];
+    Uint64 frame = GpuMemory::getCurrentFrame();
+    std::vector<Uint8> coverage;
+    for (std::vector<priv::BitmapFontDescriptor::Char>::const_iterator it = font.chars.begin(); it != font.chars.end(); ++it)
+    {
+        const priv::BitmapFontDescriptor::Char& c = *it;
+
+        // Skip the characters that are not Unicode code points, and the duplicates
+        Uint64 key = combine(0, false, c.id);
+        if ((c.id > 0x10FFFF) || glyphs.find(key))
+            continue;
+
+        const Image& image = pages[c.page];
+        Vector2u imageSize = image.getSize();
+
+        // The parser rejects negative rectangles
+        unsigned int left   = static_cast<unsigned int>(c.x);
+        unsigned int top    = static_cast<unsigned int>(c.y);
+        unsigned int width  = static_cast<unsigned int>(c.width);
+        unsigned int height = static_cast<unsigned int>(c.height);
+        if ((left + width > imageSize.x) || (top + height > imageSize.y))
+        {
+            err() << "Failed to load bitmap font (character " << c.id << " is outside of page " << c.page << ")" << std::endl;
+            m_uploadDeferred = false;
+            cleanup();
+            return false;
+        }
+
+        Glyph glyph;
+        glyph.advance = static_cast<float>(c.xAdvance);
+        glyph.bounds  = FloatRect(static_cast<float>(c.xOffset), static_cast<float>(c.yOffset - font.base),
+                                  static_cast<float>(c.width), static_cast<float>(c.height));
+
+        if ((width > 0) && (height > 0))
+        {
+            // Extract the coverage from the channel holding the glyph (the first one of the
+            // channel mask), leaving the same padding around it as the rasterized glyphs
+            const int padding = 1 + static_cast<int>(m_glyphPadding);
+            unsigned int channel = (c.channels & 4) ? 0 : (c.channels & 2) ? 1 : (c.channels & 1) ? 2 : 3;
+            if (c.channels == 15)
+                channel = ((font.alphaChannel == 3) || (font.alphaChannel == 4)) ? 0 : 3;
+
+            unsigned int paddedWidth  = width + 2 * padding;
+            unsigned int paddedHeight = height + 2 * padding;
+            coverage.assign(paddedWidth * paddedHeight, 0);
+
+            const Uint8* pixels = image.getPixelsPtr();
+            for (unsigned int y = 0; y < height; ++y)
+            {
+                const Uint8* src = pixels + ((top + y) * imageSize.x + left) * 4 + channel;
+                Uint8*       dst = &coverage[(y + padding) * paddedWidth + padding];
+                for (unsigned int x = 0; x < width; ++x)
+                    dst[x] = src[x * 4];
+            }
+
+            glyph.textureRect = findGlyphRect(page, paddedWidth, paddedHeight);
+            if ((glyph.textureRect.width == static_cast<int>(paddedWidth)) && (glyph.textureRect.height == static_cast<int>(paddedHeight)))
+                writeCoverage(page, &coverage[0], paddedWidth, paddedHeight, glyph.textureRect.left, glyph.textureRect.top);
+
+            glyph.textureRect.left += padding;
+            glyph.textureRect.top += padding;
+            glyph.textureRect.width -= 2 * padding;
+            glyph.textureRect.height -= 2 * padding;
+        }
+
+        glyphs.insert(key, c.id, glyph, frame);
+    }
+
+    m_uploadDeferred = false;
+    uploadCoverage(page);
+
+    // The kerning pairs are given in pixels, for the code points
+    KerningTable& kerning = m_kerning[m_bitmapSize];
+    for (std::vector<priv::BitmapFontDescriptor::KerningPair>::const_iterator it = font.kerning.begin(); it != font.kerning.end(); ++it)
+        kerning.others[(static_cast<Uint64>(it->first) << 32) | it->second] = static_cast<float>(it->amount);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::getBitmapFontPages(const void* descriptor, std::size_t sizeInBytes, std::vector<std::string>& files)
+{
+    files.clear();
+
+    priv::BitmapFontDescriptor font;
+    const char* error = "";
+    if (!priv::parseBitmapFont(descriptor, sizeInBytes, font, error))
+    {
+        err() << "Failed to read bitmap font (" << error << ")" << std::endl;
+        return false;
+    }
+
+    files = font.pages;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isBitmapFont() const
+{
+    return m_bitmapSize != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+const Font::Info& Font::getInfo() const
+{
+    return m_info;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Stats Font::getStats() const
+{
+    LayoutLock lock(m_layoutMutex);
+
+    Stats stats = m_stats;
+
+    // Shared pages appear under several character sizes
+    std::vector<const Page*> pages;
+    for (PageTable::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+    {
+        if (std::find(pages.begin(), pages.end(), &it->second) != pages.end())
+            continue;
+
+        pages.push_back(&it->second);
+        stats.pagePixels += static_cast<Uint64>(it->second.texture.getSize().x) * it->second.texture.getSize().y;
+    }
+
+    stats.pageCount = static_cast<unsigned int>(pages.size());
+
+    // Scaled distance field glyphs reuse the rectangle of their base glyph,
+    // the others occupy their rectangle and its padding
+    const int padding = 1 + static_cast<int>(m_glyphPadding);
+    for (GlyphTables::iterator table = m_glyphs.begin(); table != m_glyphs.end(); ++table)
+    {
+        if (useDistanceField() && (table->first != distanceFieldSize))
+            continue;
+
+        for (priv::GlyphTable::Iterator it = table->second.begin(); it != table->second.end(); ++it)
+        {
+            const IntRect& rect = it->glyph.textureRect;
+            if ((rect.width > 0) && (rect.height > 0))
+                stats.glyphPixels += static_cast<Uint64>(rect.width + 2 * padding) * static_cast<Uint64>(rect.height + 2 * padding);
+        }
+    }
+
+    return stats;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::resetStats()
+{
+    LayoutLock lock(m_layoutMutex);
+    m_stats = Stats();
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    return getGlyphByIndex(getGlyphIndex(codePoint), characterSize, bold, outlineThickness);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 Font::getGlyphIndex(Uint32 codePoint) const
+{
+    LayoutLock lock(m_layoutMutex);
+
+    // Combined fonts tell which fallback font draws the character
+    if (m_collection)
+    {
+        if (m_collection->m_fonts.empty())
+            return 0;
+
+        std::size_t font = m_collection->findFont(codePoint);
+        return (static_cast<Uint32>(font) << collectionIndexShift) | m_collection->m_fonts[font]->getGlyphIndex(codePoint);
+    }
+
+    // Bitmap fonts index their glyphs by code point
+    if (m_bitmapSize)
+    {
+        GlyphTables::iterator it = m_glyphs.find(m_bitmapSize);
+        return ((it != m_glyphs.end()) && it->second.find(combine(0, false, codePoint))) ? codePoint : 0;
+    }
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+    return face ? FT_Get_Char_Index(face, codePoint) : 0;
 }
 
 
-////////////////////////////////////////////////////////////
-Font::~Font()
-{
-    cleanup();
+////////////////////////////////////////////////////////////
+const Glyph& Font::getGlyphByIndex(Uint32 index, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    LayoutLock lock(m_layoutMutex);
+
+    // Bitmap fonts only have their pre-rendered glyphs, and no outline
+    if (m_bitmapSize)
+    {
+        static const Glyph empty;
+
+        GlyphTables::iterator it = m_glyphs.find(m_bitmapSize);
+        priv::GlyphTable::Entry* entry = (it != m_glyphs.end()) ? it->second.find(combine(0, false, index)) : NULL;
+        return (entry && (outlineThickness == 0)) ? entry->glyph : empty;
+    }
+
+    // Get the page corresponding to the character size
+    priv::GlyphTable& glyphs = m_glyphs[characterSize];
+
+    // Build the key by combining the glyph index, bold flag, and outline thickness
+    Uint64 key = combine(outlineThickness, bold, index);
+
+    // Search the glyph into the cache
+    priv::GlyphTable::Entry* entry = glyphs.find(key);
+    if (entry)
+    {
+        // Found: just return it
+        entry->lastUsedFrame = GpuMemory::getCurrentFrame();
+        ++m_stats.glyphCacheHits;
+        if (isRenderThread())
+            ++priv::getRenderStats().glyphCacheHits;
+
+        return entry->glyph;
+    }
+    else
+    {
+        // Not found: we have to load it
+        ++m_stats.glyphCacheMisses;
+        if (isRenderThread())
+            ++priv::getRenderStats().glyphCacheMisses;
+
+        Glyph glyph;
+        bool pending = false;
+        if (useDistanceField() && (characterSize != distanceFieldSize))
+        {
+            // If the base glyph is a placeholder, commitGlyphs scales it again once it is loaded
+            glyph = scaleGlyph(index, characterSize, bold, outlineThickness);
+
+            float scale = static_cast<float>(characterSize) / distanceFieldSize;
+            priv::GlyphTable::Entry* base = m_glyphs[distanceFieldSize].find(combine(outlineThickness / scale, bold, index));
+            pending = base && base->pending;
+        }
+        else if (useAsyncLoading())
+        {
+            // Let the rasterizer thread load it, and use a placeholder until then
+            priv::GlyphRasterizer::Request request;
+            request.key              = key;
+            request.generation       = m_generation;
+            request.index            = index;
+            request.characterSize    = characterSize;
+            request.bold             = bold;
+            request.outlineThickness = outlineThickness;
+            request.distanceField    = useDistanceField();
+            m_rasterizer->push(request);
+
+            glyph = getPlaceholderGlyph(index, characterSize, bold);
+            pending = true;
+        }
+        else if (!isRenderThread())
+        {
+            // Only the render thread can write to the pages, it loads the glyph at its next commit
+            glyph = getPlaceholderGlyph(index, characterSize, bold);
+            pending = true;
+            m_pendingLoads = true;
+        }
+        else
+        {
+            glyph = loadGlyph(index, characterSize, bold, outlineThickness);
+        }
+
+        priv::GlyphTable::Entry& inserted = glyphs.insert(key, index, glyph, GpuMemory::getCurrentFrame());
+        inserted.pending = pending;
+        updateMemoryUsage();
+
+        return inserted.glyph;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::preloadGlyphs(const String& characters, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    SFML_TRACE_SCOPE("Font::preloadGlyphs");
+
+    // Rasterize all the glyphs into the CPU copies of the pages first
+    m_uploadDeferred = true;
+    for (String::ConstIterator it = characters.begin(); it != characters.end(); ++it)
+        getGlyph(*it, characterSize, bold, outlineThickness);
+    m_uploadDeferred = false;
+
+    // Then upload the modified region of each page at once
+    for (PageTable::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        uploadCoverage(it->second);
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const
+{
+    // Special case where first or second is 0 (null character)
+    if (first == 0 || second == 0)
+        return 0.f;
+
+    LayoutLock lock(m_layoutMutex);
+    ++m_stats.kerningLookups;
+
+    // Combined fonts only kern the pairs drawn with the same fallback font
+    if (m_collection)
+    {
+        if (m_collection->m_fonts.empty())
+            return 0.f;
+
+        std::size_t font = m_collection->findFont(first);
+        return (font == m_collection->findFont(second)) ? m_collection->m_fonts[font]->getKerning(first, second, characterSize) : 0.f;
+    }
+
+    // Bitmap fonts have all their pairs loaded
+    if (m_bitmapSize)
+    {
+        KerningTables::const_iterator table = m_kerning.find(m_bitmapSize);
+        if (table == m_kerning.end())
+            return 0.f;
+
+        std::map<Uint64, float>::const_iterator it = table->second.others.find((static_cast<Uint64>(first) << 32) | second);
+        return (it != table->second.others.end()) ? it->second : 0.f;
+    }
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+
+    // Invalid font, or no kerning
+    if (!face || !FT_HAS_KERNING(face))
+        return 0.f;
+
+    KerningTable& table = m_kerning[characterSize];
+
+    // Pairs of Latin-1 characters are stored in a dense table, in 1/64 pixels
+    if ((first < latin1Count) && (second < latin1Count))
+    {
+        if (table.latin1.empty())
+            table.latin1.assign(latin1Count * latin1Count, unknownKerning);
+
+        Int16& cached = table.latin1[first * latin1Count + second];
+        if (cached == unknownKerning)
+        {
+            FT_Pos kerning = loadKerning(first, second, characterSize);
+            if ((kerning <= unknownKerning) || (kerning > 32767))
+                return static_cast<float>(kerning) / static_cast<float>(1 << 6);
+
+            cached = static_cast<Int16>(kerning);
+        }
+
+        return static_cast<float>(cached) / static_cast<float>(1 << 6);
+    }
+
+    // Other pairs go to the sparse table
+    Uint64 key = (static_cast<Uint64>(first) << 32) | second;
+    std::map<Uint64, float>::const_iterator it = table.others.find(key);
+    if (it != table.others.end())
+        return it->second;
+
+    float kerning = static_cast<float>(loadKerning(first, second, characterSize)) / static_cast<float>(1 << 6);
+    table.others.insert(std::make_pair(key, kerning));
+
+    return kerning;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect Font::measure(const String& string, unsigned int characterSize, Uint32 style) const
+{
+    float italicShear = (style & Text::Italic) ? 0.209f : 0.f; // 12 degrees in radians
+    if (m_bitmapSize || m_collection)
+        return measureGlyphs(string, characterSize, (style & Text::Bold) != 0, italicShear);
+
+    if (!m_metrics)
+        return FloatRect();
+
+    return m_metrics->measure(string, characterSize, (style & Text::Bold) != 0, italicShear);
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getLineSpacing(unsigned int characterSize) const
+{
+    // Combined fonts use the metrics of their first font
+    if (m_collection)
+        return m_collection->m_fonts.empty() ? 0.f : m_collection->m_fonts[0]->getLineSpacing(characterSize);
+
+    if (m_bitmapSize)
+        return m_bitmapLineSpacing;
+
+    LayoutLock lock(m_layoutMutex);
+    return getSizeMetrics(characterSize).lineSpacing;
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getUnderlinePosition(unsigned int characterSize) const
+{
+    // Combined fonts use the metrics of their first font
+    if (m_collection)
+        return m_collection->m_fonts.empty() ? 0.f : m_collection->m_fonts[0]->getUnderlinePosition(characterSize);
+
+    // Return a fixed position if font is a bitmap font
+    if (m_bitmapSize)
+        return m_bitmapSize / 10.f;
+
+    LayoutLock lock(m_layoutMutex);
+    return getSizeMetrics(characterSize).underlinePosition;
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getUnderlineThickness(unsigned int characterSize) const
+{
+    // Combined fonts use the metrics of their first font
+    if (m_collection)
+        return m_collection->m_fonts.empty() ? 0.f : m_collection->m_fonts[0]->getUnderlineThickness(characterSize);
+
+    // Return a fixed thickness if font is a bitmap font
+    if (m_bitmapSize)
+        return m_bitmapSize / 14.f;
+
+    LayoutLock lock(m_layoutMutex);
+    return getSizeMetrics(characterSize).underlineThickness;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& Font::getTexture(unsigned int characterSize) const
+{
+    return getPage(characterSize).texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setAtlasShared(bool shared)
+{
+    if (shared == m_atlasShared)
+        return;
+
+    m_atlasShared = shared;
+
+    // A bitmap font already has a single page, which can't be loaded again
+    if (m_bitmapSize)
+        return;
+
+    // The texture rectangles of the loaded glyphs refer to the old pages
+    m_pages.clear();
+    m_glyphs.clear();
+    ++m_generation;
+    ++m_revision;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isAtlasShared() const
+{
+    return m_atlasShared;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Font::getAtlasMemoryUsage() const
+{
+    LayoutLock lock(m_layoutMutex);
+
+    Uint64 usage = 0;
+    for (PageTable::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        usage += it->second.texture.getMemoryUsage();
+
+    return usage;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setDistanceFieldEnabled(bool enabled)
+{
+    if (enabled == m_distanceField)
+        return;
+
+    // Distance field glyphs use their own page and metrics
+    m_distanceField = enabled;
+
+    // The glyphs of a bitmap font can't be loaded again
+    if (m_bitmapSize)
+        return;
+
+    m_pages.clear();
+    m_glyphs.clear();
+    ++m_generation;
+    ++m_revision;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isDistanceFieldEnabled() const
+{
+    return m_distanceField;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setGlyphPadding(unsigned int padding)
+{
+    if (padding == m_glyphPadding)
+        return;
+
+    m_glyphPadding = padding;
+
+    // The glyphs of a bitmap font can't be loaded again
+    if (m_bitmapSize)
+        return;
+
+    // The loaded glyphs were packed with the old padding
+    m_pages.clear();
+    m_glyphs.clear();
+    ++m_generation;
+    ++m_revision;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Font::getGlyphPadding() const
+{
+    return m_glyphPadding;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setAsyncLoadingEnabled(bool enabled)
+{
+    if (enabled == m_asyncLoading)
+        return;
+
+    m_asyncLoading = enabled;
+
+    if (enabled)
+    {
+        startRasterizer();
+    }
+    else
+    {
+        // Finish the glyphs that are still waiting, then stop the thread
+        commitGlyphs(true);
+        delete m_rasterizer;
+        m_rasterizer = NULL;
+        loadPendingGlyphs();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isAsyncLoadingEnabled() const
+{
+    return m_asyncLoading;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setConcurrentLayoutEnabled(bool enabled)
+{
+    if (enabled)
+    {
+        if (!m_layoutMutex)
+            m_layoutMutex = new std::recursive_mutex;
+
+        m_renderThread = std::this_thread::get_id();
+    }
+    else if (m_layoutMutex)
+    {
+        // The placeholders left by the other threads are loaded by the next commit
+        delete m_layoutMutex;
+        m_layoutMutex = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isConcurrentLayoutEnabled() const
+{
+    return m_layoutMutex != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::saveGlyphCache(std::vector<Uint8>& data) const
+{
+    data.clear();
+
+    if (!m_face || !m_fontData)
+    {
+        err() << "Failed to save the glyph cache (no font loaded from memory)" << std::endl;
+        return false;
+    }
+
+    // Placeholders have nothing to save yet
+    commitGlyphs(true);
+
+    // Header: what the glyphs depend on
+    writeUint32(data, glyphCacheMagic);
+    writeUint32(data, glyphCacheVersion);
+    writeUint32(data, (FREETYPE_MAJOR << 16) | (FREETYPE_MINOR << 8) | FREETYPE_PATCH);
+    writeUint64(data, hashFontData(m_fontData, m_fontDataSize));
+    writeUint64(data, m_fontDataSize);
+    writeUint32(data, (useDistanceField() ? 1 : 0) | (m_atlasShared ? 2 : 0) | (m_glyphPadding << 8));
+
+    // Pages: size and coverage
+    writeUint32(data, static_cast<Uint32>(m_pages.size()));
+    for (PageTable::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+    {
+        writeUint32(data, it->first);
+        writeUint32(data, it->second.texture.getSize().x);
+        writeUint32(data, it->second.texture.getSize().y);
+        data.insert(data.end(), it->second.coverage.begin(), it->second.coverage.end());
+    }
+
+    // Glyphs of each character size
+    writeUint32(data, static_cast<Uint32>(m_glyphs.size()));
+    for (GlyphTables::iterator table = m_glyphs.begin(); table != m_glyphs.end(); ++table)
+    {
+        Uint32 count = 0;
+        for (priv::GlyphTable::Iterator it = table->second.begin(); it != table->second.end(); ++it)
+            count += it->pending ? 0 : 1;
+
+        writeUint32(data, table->first);
+        writeUint32(data, count);
+        for (priv::GlyphTable::Iterator it = table->second.begin(); it != table->second.end(); ++it)
+        {
+            if (it->pending)
+                continue;
+
+            const Glyph& glyph = it->glyph;
+            writeUint64(data, it->key);
+            writeUint32(data, it->index);
+            writeFloat(data, glyph.advance);
+            writeFloat(data, glyph.bounds.left);
+            writeFloat(data, glyph.bounds.top);
+            writeFloat(data, glyph.bounds.width);
+            writeFloat(data, glyph.bounds.height);
+            writeUint32(data, static_cast<Uint32>(glyph.textureRect.left));
+            writeUint32(data, static_cast<Uint32>(glyph.textureRect.top));
+            writeUint32(data, static_cast<Uint32>(glyph.textureRect.width));
+            writeUint32(data, static_cast<Uint32>(glyph.textureRect.height));
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::loadGlyphCache(const void* data, std::size_t sizeInBytes)
+{
+    if (!m_face || !m_fontData)
+    {
+        err() << "Failed to load the glyph cache (no font loaded from memory)" << std::endl;
+        return false;
+    }
+
+    // Check that the cache was made for this font and these options
+    CacheReader reader(data, sizeInBytes);
+    Uint32 magic, version, freetypeVersion, options;
+    Uint64 fontHash, fontSize;
+    if (!reader.readUint32(magic) || !reader.readUint32(version) || !reader.readUint32(freetypeVersion) ||
+        !reader.readUint64(fontHash) || !reader.readUint64(fontSize) || !reader.readUint32(options) ||
+        (magic != glyphCacheMagic) || (version != glyphCacheVersion))
+    {
+        err() << "Failed to load the glyph cache (invalid data)" << std::endl;
+        return false;
+    }
+
+    if ((freetypeVersion != static_cast<Uint32>((FREETYPE_MAJOR << 16) | (FREETYPE_MINOR << 8) | FREETYPE_PATCH)) ||
+        (fontSize != m_fontDataSize) || (fontHash != hashFontData(m_fontData, m_fontDataSize)) ||
+        (options != static_cast<Uint32>((useDistanceField() ? 1 : 0) | (m_atlasShared ? 2 : 0) | (m_glyphPadding << 8))))
+    {
+        err() << "Failed to load the glyph cache (it was made for another font or other options)" << std::endl;
+        return false;
+    }
+
+    // Read the pages
+    struct CachedPage
+    {
+        Uint32       key;
+        Uint32       width;
+        Uint32       height;
+        const Uint8* coverage;
+    };
+
+    Uint32 pageCount;
+    if (!reader.readUint32(pageCount))
+    {
+        err() << "Failed to load the glyph cache (invalid data)" << std::endl;
+        return false;
+    }
+
+    std::vector<CachedPage> pages;
+    for (Uint32 i = 0; i < pageCount; ++i)
+    {
+        CachedPage page;
+        page.coverage = NULL;
+        if (reader.readUint32(page.key) && reader.readUint32(page.width) && reader.readUint32(page.height) &&
+            (page.width > 0) && (page.width <= Texture::getMaximumSize()) &&
+            (page.height > 0) && (page.height <= Texture::getMaximumSize()))
+            page.coverage = reader.read(static_cast<std::size_t>(page.width) * page.height);
+
+        if (!page.coverage)
+        {
+            err() << "Failed to load the glyph cache (invalid data)" << std::endl;
+            return false;
+        }
+
+        pages.push_back(page);
+    }
+
+    // Read the glyphs
+    GlyphTables glyphs;
+    Uint64 frame = GpuMemory::getCurrentFrame();
+    Uint32 tableCount;
+    if (!reader.readUint32(tableCount))
+    {
+        err() << "Failed to load the glyph cache (invalid data)" << std::endl;
+        return false;
+    }
+
+    for (Uint32 i = 0; i < tableCount; ++i)
+    {
+        Uint32 characterSize, count;
+        if (!reader.readUint32(characterSize) || !reader.readUint32(count))
+        {
+            err() << "Failed to load the glyph cache (invalid data)" << std::endl;
+            return false;
+        }
+
+        priv::GlyphTable& table = glyphs[characterSize];
+        for (Uint32 j = 0; j < count; ++j)
+        {
+            Uint64 key;
+            Uint32 index, left, top, width, height;
+            Glyph glyph;
+            if (!reader.readUint64(key) || !reader.readUint32(index) || !reader.readFloat(glyph.advance) ||
+                !reader.readFloat(glyph.bounds.left) || !reader.readFloat(glyph.bounds.top) ||
+                !reader.readFloat(glyph.bounds.width) || !reader.readFloat(glyph.bounds.height) ||
+                !reader.readUint32(left) || !reader.readUint32(top) || !reader.readUint32(width) || !reader.readUint32(height) ||
+                table.find(key))
+            {
+                err() << "Failed to load the glyph cache (invalid data)" << std::endl;
+                return false;
+            }
+
+            glyph.textureRect = IntRect(static_cast<int>(left), static_cast<int>(top), static_cast<int>(width), static_cast<int>(height));
+            table.insert(key, index, glyph, frame);
+        }
+    }
+
+    // Everything is valid: replace the current glyphs
+    m_pages.clear();
+    m_glyphs.swap(glyphs);
+    ++m_generation;
+    ++m_revision;
+
+    for (std::size_t i = 0; i < pages.size(); ++i)
+    {
+        Page& page = m_pages[pages[i].key];
+        if (!page.texture.createStorage(pages[i].width, pages[i].height, Texture::R8))
+        {
+            err() << "Failed to load the glyph cache (failed to create the page texture)" << std::endl;
+            m_pages.clear();
+            m_glyphs.clear();
+            return false;
+        }
+
+        page.texture.setSmooth(true);
+        page.texture.m_distanceField = useDistanceField();
+        page.texture.m_texCoordType = Texture::Pixels;
+        page.packer.reset(pages[i].width, pages[i].height);
+        page.packer.occupy(IntRect(0, 0, 3, 3));
+        page.coverage.assign(pages[i].coverage, pages[i].coverage + pages[i].width * pages[i].height);
+        page.dirty = IntRect(0, 0, pages[i].width, pages[i].height);
+        uploadCoverage(page);
+    }
+
+    // Restore the packing state from the rectangles of the glyphs (and their padding)
+    const int padding = 1 + static_cast<int>(m_glyphPadding);
+    for (GlyphTables::iterator table = m_glyphs.begin(); table != m_glyphs.end(); ++table)
+    {
+        PageTable::iterator page = m_pages.find(getPageKey(table->first));
+        if (page == m_pages.end())
+            continue;
+
+        for (priv::GlyphTable::Iterator it = table->second.begin(); it != table->second.end(); ++it)
+        {
+            const IntRect& rect = it->glyph.textureRect;
+            if ((rect.width > 0) && (rect.height > 0))
+                page->second.packer.occupy(IntRect(rect.left - padding, rect.top - padding, rect.width + 2 * padding, rect.height + 2 * padding));
+        }
+    }
+
+    updateMemoryUsage();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::loadGlyphCache(InputStream& stream)
+{
+    // Read the whole stream first, the cache is small compared to a page upload
+    Int64 size = stream.getSize();
+    if ((size <= 0) || (stream.seek(0) != 0))
+    {
+        err() << "Failed to load the glyph cache (empty or unreadable stream)" << std::endl;
+        return false;
+    }
+
+    std::vector<Uint8> data(static_cast<std::size_t>(size));
+    if (stream.read(&data[0], size) != size)
+    {
+        err() << "Failed to load the glyph cache (failed to read the stream)" << std::endl;
+        return false;
+    }
+
+    return loadGlyphCache(&data[0], data.size());
+}
+
+
+////////////////////////////////////////////////////////////
+Font& Font::operator =(const Font& right)
+{
+    Font temp(right);
+
+    swap(temp);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Font& Font::operator =(Font&& right) noexcept
+{
+    swap(right);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::swap(Font& right)
+{
+    std::swap(m_library,     right.m_library);
+    std::swap(m_face,        right.m_face);
+    std::swap(m_streamRec,   right.m_streamRec);
+    std::swap(m_stroker,     right.m_stroker);
+    std::swap(m_refCount,    right.m_refCount);
+    std::swap(m_info,        right.m_info);
+    std::swap(m_pages,       right.m_pages);
+    std::swap(m_glyphs,      right.m_glyphs);
+    std::swap(m_kerning,     right.m_kerning);
+    std::swap(m_shapedRuns,  right.m_shapedRuns);
+    std::swap(m_asyncLoading, right.m_asyncLoading);
+    std::swap(m_rasterizer,  right.m_rasterizer);
+    std::swap(m_metrics,     right.m_metrics);
+    std::swap(m_generation,  right.m_generation);
+    std::swap(m_revision,    right.m_revision);
+    std::swap(m_fontData,    right.m_fontData);
+    std::swap(m_fontDataSize, right.m_fontDataSize);
+    std::swap(m_atlasShared, right.m_atlasShared);
+    std::swap(m_distanceField, right.m_distanceField);
+    std::swap(m_glyphPadding, right.m_glyphPadding);
+    std::swap(m_pixelBuffer, right.m_pixelBuffer);
+    std::swap(m_bitmapSize, right.m_bitmapSize);
+    std::swap(m_bitmapLineSpacing, right.m_bitmapLineSpacing);
+    std::swap(m_collection, right.m_collection);
+    std::swap(m_sizeMetrics, right.m_sizeMetrics);
+    std::swap(m_layoutMutex, right.m_layoutMutex);
+    std::swap(m_renderThread, right.m_renderThread);
+    std::swap(m_pendingLoads, right.m_pendingLoads);
+    std::swap(m_memory, right.m_memory);
+    std::swap(m_stats, right.m_stats);
+
+    // The texts using either font must not mistake the new glyphs for the ones they were built with
+    m_revision = right.m_revision = std::max(m_revision, right.m_revision) + 1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::setAllocator(AllocateCallback allocate, ReallocateCallback reallocate, DeallocateCallback deallocate, void* userData)
+{
+    return priv::setFreeTypeAllocator(allocate, reallocate, deallocate, userData);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::cleanup()
+{
+    // Check if we must destroy the FreeType pointers
+    if (m_refCount)
+    {
+        // Decrease the reference counter
+        (*m_refCount)--;
+
+        // Free the resources only if we are the last owner
+        if (*m_refCount == 0)
+        {
+            // Delete the reference counter
+            delete m_refCount;
+
+            {
+                Lock lock(priv::getFreeTypeLibraryMutex());
+
+                // Destroy the stroker
+                if (m_stroker)
+                    FT_Stroker_Done(static_cast<FT_Stroker>(m_stroker));
+
+                // Destroy the font face
+                if (m_face)
+                    FT_Done_Face(static_cast<FT_Face>(m_face));
+            }
+
+            // Destroy the stream rec instance, if any (must be done after FT_Done_Face!)
+            if (m_streamRec)
+                delete static_cast<FT_StreamRec*>(m_streamRec);
+
+            // Release our reference to the shared library
+            if (m_library)
+                priv::releaseFreeTypeLibrary();
+        }
+    }
+
+    // Stop loading glyphs in the background
+    delete m_rasterizer;
+    m_rasterizer = NULL;
+
+    delete m_metrics;
+    m_metrics = NULL;
+
+    // Reset members
+    m_library   = NULL;
+    m_face      = NULL;
+    m_stroker   = NULL;
+    m_streamRec = NULL;
+    m_refCount  = NULL;
+    m_fontData     = NULL;
+    m_fontDataSize = 0;
+    m_bitmapSize   = 0;
+    m_bitmapLineSpacing = 0.f;
+    m_pages.clear();
+    m_glyphs.clear();
+    m_kerning.clear();
+    m_sizeMetrics.clear();
+    m_shapedRuns.clear();
+    m_pendingLoads = false;
+    ++m_generation;
+    ++m_revision;
+    std::vector<Uint8>().swap(m_pixelBuffer);
+    updateMemoryUsage();
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::scaleGlyph(Uint32 index, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    // The distance field is rendered once at the base size, other sizes only scale its metrics
+    float scale = static_cast<float>(characterSize) / distanceFieldSize;
+    const Glyph& base = getGlyphByIndex(index, distanceFieldSize, bold, outlineThickness / scale);
+
+    Glyph glyph = base;
+    glyph.advance = base.advance * scale;
+
+    if ((base.textureRect.width > 0) && (base.textureRect.height > 0))
+    {
+        // Text pads the quads by one unit both in the world and in the texture,
+        // shift the bounds so that the texels still land at their scaled position
+        glyph.bounds.left   = base.bounds.left * scale - scale + 1;
+        glyph.bounds.top    = base.bounds.top * scale - scale + 1;
+        glyph.bounds.width  = base.bounds.width * scale + 2 * (scale - 1);
+        glyph.bounds.height = base.bounds.height * scale + 2 * (scale - 1);
+    }
+
+    return glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+const priv::ShapedRun& Font::getShapedRun(const String& string, unsigned int characterSize, bool bold) const
+{
+    LayoutLock lock(m_layoutMutex);
+    return m_shapedRuns.get(*this, string, characterSize, bold, m_revision);
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::loadGlyph(Uint32 index, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    SFML_TRACE_SCOPE("Font::loadGlyph");
+
+    // Combined fonts have no face of their own
+    if (m_collection)
+        return loadFallbackGlyph(index, characterSize, bold, outlineThickness);
+
+    // First, transform our ugly void* to a FT_Face
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face)
+        return Glyph();
+
+    // Set the character size
+    if (!setCurrentSize(characterSize))
+        return Glyph();
+
+    // Rasterize the glyph, and add it to its page
+    priv::GlyphBitmap bitmap;
+    Clock clock;
+    bool rasterized = priv::GlyphRasterizer::rasterize(m_library, m_face, m_stroker, index, bold, outlineThickness, useDistanceField(), bitmap);
+    countRasterization(clock.getElapsedTime());
+
+    if (!rasterized)
+        return Glyph();
+
+    return commitGlyph(bitmap, characterSize);
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::loadFallbackGlyph(Uint32 index, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    std::size_t fontIndex = index >> collectionIndexShift;
+    if (fontIndex >= m_collection->m_fonts.size())
+        return Glyph();
+
+    const Font& font = *m_collection->m_fonts[fontIndex];
+    Uint32 glyphIndex = index & collectionGlyphMask;
+
+    priv::GlyphBitmap bitmap;
+    if (font.m_bitmapSize)
+    {
+        // Copy the pre-rendered glyph from the page of the bitmap font, with its padding
+        bitmap.glyph = font.getGlyphByIndex(glyphIndex, characterSize, bold, outlineThickness);
+        IntRect rect = bitmap.glyph.textureRect;
+        bitmap.glyph.textureRect = IntRect();
+
+        const Page& page = font.getPage(characterSize);
+        Vector2u pageSize = page.texture.getSize();
+        if ((rect.width > 0) && (rect.height > 0) && (rect.left >= 1) && (rect.top >= 1) &&
+            (rect.left + rect.width + 1 <= static_cast<int>(pageSize.x)) && (rect.top + rect.height + 1 <= static_cast<int>(pageSize.y)))
+        {
+            bitmap.width  = rect.width + 2;
+            bitmap.height = rect.height + 2;
+            bitmap.pixels.resize(bitmap.width * bitmap.height);
+            for (unsigned int y = 0; y < bitmap.height; ++y)
+            {
+                const Uint8* row = &page.coverage[(rect.top - 1 + y) * pageSize.x + rect.left - 1];
+                std::copy(row, row + bitmap.width, &bitmap.pixels[y * bitmap.width]);
+            }
+        }
+    }
+    else
+    {
+        // Rasterize with the face of the fallback font, but into our own page
+        if (!font.m_face || !font.setCurrentSize(characterSize))
+            return Glyph();
+
+        Clock clock;
+        bool rasterized = priv::GlyphRasterizer::rasterize(font.m_library, font.m_face, font.m_stroker, glyphIndex, bold, outlineThickness, false, bitmap);
+        countRasterization(clock.getElapsedTime());
+
+        if (!rasterized)
+            return Glyph();
+    }
+
+    return commitGlyph(bitmap, characterSize);
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::commitGlyph(const priv::GlyphBitmap& bitmap, unsigned int characterSize) const
+{
+    Glyph glyph = bitmap.glyph;
+
+    if ((bitmap.width > 0) && (bitmap.height > 0))
+    {
+        // Padding left around the glyph by the rasterizer, and the empty space requested around it
+        const int extra   = static_cast<int>(m_glyphPadding);
+        const int padding = 1 + extra;
+
+        // Get the glyphs page corresponding to the character size
+        Page& page = getPage(characterSize);
+
+        // Find a good position for the new glyph into the texture
+        unsigned int width  = bitmap.width + 2 * extra;
+        unsigned int height = bitmap.height + 2 * extra;
+        glyph.textureRect = findGlyphRect(page, width, height);
+
+        // Write the pixels to the texture, unless there was no room for them
+        if ((glyph.textureRect.width == static_cast<int>(width)) && (glyph.textureRect.height == static_cast<int>(height)))
+        {
+            writeCoverage(page, &bitmap.pixels[0], bitmap.width, bitmap.height, glyph.textureRect.left + extra, glyph.textureRect.top + extra);
+            page.texture.m_distanceField = useDistanceField();
+        }
+
+        // Make sure the texture data is positioned in the center
+        // of the allocated texture rectangle
+        glyph.textureRect.left += padding;
+        glyph.textureRect.top += padding;
+        glyph.textureRect.width -= 2 * padding;
+        glyph.textureRect.height -= 2 * padding;
+    }
+
+    return glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::getPlaceholderGlyph(Uint32 index, unsigned int characterSize, bool bold) const
+{
+    // Only the advance is known before the glyph is rasterized, which is cheap to get
+    Glyph glyph;
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face || !setCurrentSize(characterSize))
+        return glyph;
+
+    FT_Int32 flags = useDistanceField() ? FT_LOAD_NO_HINTING : (FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT);
+    FT_Fixed advance;
+    if (FT_Get_Advance(face, index, flags, &advance) == 0)
+        glyph.advance = static_cast<float>(advance) / static_cast<float>(1 << 16);
+
+    if (bold)
+        glyph.advance += 1.f;
+
+    return glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::useAsyncLoading() const
+{
+    // Glyphs loaded for something else than a draw are needed right away
+    return m_rasterizer && !m_uploadDeferred && !m_repacking;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::openMetrics()
+{
+    delete m_metrics;
+
+    m_metrics = new priv::FontMetrics;
+    if (!m_metrics->open(m_fontData, m_fontDataSize))
+    {
+        delete m_metrics;
+        m_metrics = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::startRasterizer()
+{
+    delete m_rasterizer;
+    m_rasterizer = NULL;
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face || !FT_IS_SCALABLE(face) || !m_fontData)
+        return;
+
+    m_rasterizer = new priv::GlyphRasterizer;
+    if (!m_rasterizer->start(m_fontData, m_fontDataSize))
+    {
+        delete m_rasterizer;
+        m_rasterizer = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::commitGlyphs(bool wait) const
+{
+    LayoutLock lock(m_layoutMutex);
+
+    // Only the render thread writes to the pages
+    if (!isRenderThread())
+        return;
+
+    // Load the glyphs that other threads left as placeholders
+    if (m_pendingLoads)
+    {
+        m_pendingLoads = false;
+        loadPendingGlyphs();
+    }
+
+    if (!m_rasterizer)
+        return;
+
+    std::vector<priv::GlyphRasterizer::Result> results;
+    m_rasterizer->collect(results, wait);
+
+    // Add the rasterized glyphs to their page, unless they were dropped in the meantime
+    bool committed = false;
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const priv::GlyphRasterizer::Request& request = results[i].request;
+        if (request.generation != m_generation)
+            continue;
+
+        GlyphTables::iterator table = m_glyphs.find(request.characterSize);
+        if (table == m_glyphs.end())
+            continue;
+
+        priv::GlyphTable::Entry* entry = table->second.find(request.key);
+        if (!entry || !entry->pending)
+            continue;
+
+        entry->glyph = commitGlyph(results[i].bitmap, request.characterSize);
+        entry->pending = false;
+        committed = true;
+    }
+
+    // The texts showing the placeholders must be built again
+    if (committed)
+    {
+        ++m_revision;
+        updateMemoryUsage();
+    }
+
+    // Scaled distance field glyphs follow their base glyph
+    if (committed && useDistanceField())
+    {
+        for (GlyphTables::iterator table = m_glyphs.begin(); table != m_glyphs.end(); ++table)
+        {
+            if (table->first == distanceFieldSize)
+                continue;
+
+            float scale = static_cast<float>(table->first) / distanceFieldSize;
+            for (priv::GlyphTable::Iterator it = table->second.begin(); it != table->second.end(); ++it)
+            {
+                if (!it->pending)
+                    continue;
+
+                float outlineThickness;
+                bool bold;
+                Uint32 index;
+                split(it->key, outlineThickness, bold, index);
+
+                priv::GlyphTable::Entry* base = m_glyphs[distanceFieldSize].find(combine(outlineThickness / scale, bold, index));
+                if (base && !base->pending)
+                {
+                    it->glyph = scaleGlyph(index, table->first, bold, outlineThickness);
+                    it->pending = false;
+                }
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::loadPendingGlyphs() const
+{
+    // Rasterized glyphs first, then the scaled distance field glyphs which use them
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (GlyphTables::iterator table = m_glyphs.begin(); table != m_glyphs.end(); ++table)
+        {
+            bool scaled = useDistanceField() && (table->first != distanceFieldSize);
+            if (scaled != (pass == 1))
+                continue;
+
+            for (priv::GlyphTable::Iterator it = table->second.begin(); it != table->second.end(); ++it)
+            {
+                if (!it->pending)
+                    continue;
+
+                float outlineThickness;
+                bool bold;
+                Uint32 index;
+                split(it->key, outlineThickness, bold, index);
+
+                it->pending = false;
+                if (scaled)
+                    it->glyph = scaleGlyph(index, table->first, bold, outlineThickness);
+                else
+                    it->glyph = loadGlyph(it->index, table->first, bold, outlineThickness);
+            }
+        }
+    }
+
+    // The texts showing the placeholders must be built again
+    ++m_revision;
+}
+
+
+////////////////////////////////////////////////////////////
+long Font::loadKerning(Uint32 first, Uint32 second, unsigned int characterSize) const
+{
+    ++m_stats.kerningLoads;
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!setCurrentSize(characterSize))
+        return 0;
+
+    // Convert the characters to indices
+    FT_UInt index1 = FT_Get_Char_Index(face, first);
+    FT_UInt index2 = FT_Get_Char_Index(face, second);
+
+    // Get the kerning vector
+    FT_Vector kerning;
+    if (FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning) != 0)
+        return 0;
+
+    // X advance is already in pixels for bitmap fonts
+    if (!FT_IS_SCALABLE(face))
+        return kerning.x * (1 << 6);
+
+    return kerning.x;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Font::loadFromFile(const std::string& filename)
+IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
 {
-    return false;
+    IntRect rect;
+    while (!page.packer.insert(width, height, rect))
+    {
+        // Not enough space: resize the texture if possible
+        unsigned int textureWidth  = page.texture.getSize().x;
+        unsigned int textureHeight = page.texture.getSize().y;
+        if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
+        {
+            SFML_TRACE_SCOPE("Font::growPage");
+            ++m_stats.pageGrowths;
+
+            // Make the texture 2 times bigger, and upload the glyphs again from the CPU copy
+            Texture newTexture;
+            newTexture.createStorage(textureWidth * 2, textureHeight * 2, page.texture.getFormat());
+            newTexture.setSmooth(true);
+            newTexture.m_distanceField = page.texture.m_distanceField;
+            newTexture.m_texCoordType = Texture::Pixels;
+            page.texture.swap(newTexture);
+            page.packer.grow(textureWidth * 2, textureHeight * 2);
+
+            std::vector<Uint8> coverage(textureWidth * 2 * textureHeight * 2, 0);
+            for (unsigned int row = 0; row < textureHeight; ++row)
+                std::copy(&page.coverage[row * textureWidth], &page.coverage[row * textureWidth] + textureWidth, &coverage[row * textureWidth * 2]);
+            page.coverage.swap(coverage);
+            page.dirty = IntRect(0, 0, textureWidth, textureHeight);
+
+            if (!m_uploadDeferred)
+                uploadCoverage(page);
+        }
+        else if (!repackPage(page))
+        {
+            // Oops, we've reached the maximum texture size...
+            err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
+            return IntRect(0, 0, 2, 2);
+        }
+    }
+
+    return rect;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
+bool Font::repackPage(Page& page) const
 {
-    // Cleanup the previous resources
-    cleanup();
-    m_refCount = new int(1);
+    // Glyphs requested during the last frames must stay valid
+    Uint64 currentFrame = GpuMemory::getCurrentFrame();
+    if (m_repacking || (currentFrame < glyphEvictionAge))
+        return false;
 
-    // Initialize FreeType
-    // Note: we initialize FreeType for every font instance in order to avoid having a single
-    // global manager that would create a lot of issues regarding creation and destruction order.
-    FT_Library library;
-    if (FT_Init_FreeType(&library) != 0)
+    // Drop the glyphs of this page that haven't been requested for a while
+    std::vector<GlyphTables::iterator> tables;
+    bool evicted = false;
+    for (GlyphTables::iterator table = m_glyphs.begin(); table != m_glyphs.end(); ++table)
     {
-        err() << "Failed to load font from memory (failed to initialize FreeType)" << std::endl;
-        return false;
+        PageTable::iterator owner = m_pages.find(getPageKey(table->first));
+        if ((owner == m_pages.end()) || (&owner->second != &page))
+            continue;
+
+        tables.push_back(table);
+
+        if (table->second.removeOlderThan(currentFrame - glyphEvictionAge + 1))
+            evicted = true;
     }
-    m_library = library;
 
-    // Load the new font face from the specified file
-    FT_Face face;
-    if (FT_New_Memory_Face(static_cast<FT_Library>(m_library), reinterpret_cast<const FT_Byte*>(data), static_cast<FT_Long>(sizeInBytes), 0, &face) != 0)
-    {
-        err() << "Failed to load font from memory (failed to create the font face)" << std::endl;
+    if (!evicted)
         return false;
-    }
 
-    // Load the stroker that will be used to outline the font
-    FT_Stroker stroker;
-    if (FT_Stroker_New(static_cast<FT_Library>(m_library), &stroker) != 0)
+    // Start again from a small page, and load the remaining glyphs into it
+    // (the glyphs move, so the geometry built with them is outdated)
+    SFML_TRACE_SCOPE("Font::repackPage");
+    ++m_stats.pageRepacks;
+    m_repacking = true;
+    ++m_generation;
+    ++m_revision;
+    initializePage(page);
+
+    for (std::size_t i = 0; i < tables.size(); ++i)
     {
-        err() << "Failed to load font from memory (failed to create the stroker)" << std::endl;
-        FT_Done_Face(face);
-        return false;
+        unsigned int characterSize = tables[i]->first;
+        if (useDistanceField() && (characterSize != distanceFieldSize))
+            continue;
+
+        for (priv::GlyphTable::Iterator it = tables[i]->second.begin(); it != tables[i]->second.end(); ++it)
+        {
+            float outlineThickness;
+            bool bold;
+            Uint32 index;
+            split(it->key, outlineThickness, bold, index);
+
+            it->glyph = loadGlyph(it->index, characterSize, bold, outlineThickness);
+            it->pending = false;
+        }
     }
 
-    // Select the Unicode character map
-    if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0)
+    // Scaled distance field glyphs point to the base glyphs, which may have been reloaded
+    for (std::size_t i = 0; i < tables.size(); ++i)
     {
-        err() << "Failed to load font from memory (failed to set the Unicode character set)" << std::endl;
-        FT_Stroker_Done(stroker);
-        FT_Done_Face(face);
-        return false;
-    }
+        unsigned int characterSize = tables[i]->first;
+        if (!useDistanceField() || (characterSize == distanceFieldSize))
+            continue;
 
-    // Store the loaded font in our ugly void* :)
-    m_stroker = stroker;
-    m_face = face;
+        for (priv::GlyphTable::Iterator it = tables[i]->second.begin(); it != tables[i]->second.end(); ++it)
+        {
+            float outlineThickness;
+            bool bold;
+            Uint32 index;
+            split(it->key, outlineThickness, bold, index);
 
-    // Store the font information
-    m_info.family = face->family_name ? face->family_name : std::string();
+            it->glyph = scaleGlyph(index, characterSize, bold, outlineThickness);
+            it->pending = false;
+        }
+    }
+
+    m_repacking = false;
+    updateMemoryUsage();
 
     return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Font::loadFromStream(InputStream& stream)
+Font::Page& Font::getPage(unsigned int characterSize) const
 {
-    return false;
-}
+    Page& page = m_pages[getPageKey(characterSize)];
 
+    if (!page.texture.getNativeHandle())
+        initializePage(page);
 
-////////////////////////////////////////////////////////////
-const Font::Info& Font::getInfo() const
-{
-    return m_info;
+    return page;
 }
 
 
 ////////////////////////////////////////////////////////////
-const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
+unsigned int Font::getPageKey(unsigned int characterSize) const
 {
-    // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
+    if (m_bitmapSize)
+        return m_bitmapSize;
 
-    // Build the key by combining the glyph index (based on code point), bold flag, and outline thickness
-    Uint64 key = combine(outlineThickness, bold, FT_Get_Char_Index(static_cast<FT_Face>(m_face), codePoint));
-
-    // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
-    {
-        // Found: just return it
-        return it->second;
-    }
-    else
-    {
-        // Not found: we have to load it
-        Glyph glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
-    }
+    // 0 is never a valid character size, use it as the key of the shared page
+    return (m_atlasShared || useDistanceField()) ? 0 : characterSize;
 }
 
 
 ////////////////////////////////////////////////////////////
-float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const
+void Font::initializePage(Page& page) const
 {
-    // Special case where first or second is 0 (null character)
-    if (first == 0 || second == 0)
-        return 0.f;
-
-    FT_Face face = static_cast<FT_Face>(m_face);
+    // Coverage only needs one channel, the pipeline expands it to white
+    page.texture.createStorage(initialPageSize, initialPageSize, Texture::R8);
+    page.texture.setSmooth(true);
 
-    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
-    {
-        // Convert the characters to indices
-        FT_UInt index1 = FT_Get_Char_Index(face, first);
-        FT_UInt index2 = FT_Get_Char_Index(face, second);
+    // Texts give the texture coordinates of the glyphs in pixels, they stay valid when the page grows
+    page.texture.m_texCoordType = Texture::Pixels;
+    page.packer.reset(initialPageSize, initialPageSize);
 
-        // Get the kerning vector
-        FT_Vector kerning;
-        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
+    // Reserve a 2x2 white square for texturing underlines
+    IntRect underline;
+    page.packer.insert(3, 3, underline);
 
-        // X advance is already in pixels for bitmap fonts
-        if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
+    page.coverage.assign(initialPageSize * initialPageSize, 0);
+    page.coverage[0] = page.coverage[1] = page.coverage[initialPageSize] = page.coverage[initialPageSize + 1] = 255;
+    page.dirty = IntRect(0, 0, initialPageSize, initialPageSize);
 
-        // Return the X advance
-        return static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
-    }
-    else
-    {
-        // Invalid font, or no kerning
-        return 0.f;
-    }
+    if (!m_uploadDeferred)
+        uploadCoverage(page);
 }
 
 
 ////////////////////////////////////////////////////////////
-float Font::getLineSpacing(unsigned int characterSize) const
+void Font::writeCoverage(Page& page, const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y) const
 {
-    FT_Face face = static_cast<FT_Face>(m_face);
-
-    if (face && setCurrentSize(characterSize))
+    // Copy the region to the CPU copy of the page
+    unsigned int pageWidth = page.texture.getSize().x;
+    for (unsigned int row = 0; row < height; ++row)
+        std::copy(pixels + row * width, pixels + (row + 1) * width, &page.coverage[(y + row) * pageWidth + x]);
+
+    // Extend the region that must be uploaded
+    IntRect region(x, y, width, height);
+    if ((page.dirty.width > 0) && (page.dirty.height > 0))
     {
-        return static_cast<float>(face->size->metrics.height) / static_cast<float>(1 << 6);
-    }
-    else
-    {
-        return 0.f;
+        int right  = std::max(page.dirty.left + page.dirty.width, region.left + region.width);
+        int bottom = std::max(page.dirty.top + page.dirty.height, region.top + region.height);
+        region.left   = std::min(page.dirty.left, region.left);
+        region.top    = std::min(page.dirty.top, region.top);
+        region.width  = right - region.left;
+        region.height = bottom - region.top;
     }
+    page.dirty = region;
+
+    if (!m_uploadDeferred)
+        uploadCoverage(page);
 }
 
 
 ////////////////////////////////////////////////////////////
-float Font::getUnderlinePosition(unsigned int characterSize) const
+void Font::uploadCoverage(Page& page) const
 {
-    FT_Face face = static_cast<FT_Face>(m_face);
+    if ((page.dirty.width <= 0) || (page.dirty.height <= 0))
+        return;
 
-    if (face && setCurrentSize(characterSize))
-    {
-        // Return a fixed position if font is a bitmap font
-        if (!FT_IS_SCALABLE(face))
-            return characterSize / 10.f;
+    unsigned int pageWidth = page.texture.getSize().x;
+    unsigned int x         = page.dirty.left;
+    unsigned int y         = page.dirty.top;
+    unsigned int width     = page.dirty.width;
+    unsigned int height    = page.dirty.height;
+    page.dirty = IntRect();
 
-        return -static_cast<float>(FT_MulFix(face->underline_position, face->size->metrics.y_scale)) / static_cast<float>(1 << 6);
-    }
-    else
+    if (page.texture.isSingleChannel() && (width == pageWidth))
     {
-        return 0.f;
+        // Whole rows are contiguous in the CPU copy
+        page.texture.updateSingleChannel(&page.coverage[y * pageWidth], width, height, x, y);
+        return;
     }
-}
 
+    // Gather the rows of the region, expanded to white pixels if the
+    // texture has no single channel storage
+    std::size_t channels = page.texture.isSingleChannel() ? 1 : 4;
+    m_pixelBuffer.resize(width * height * channels);
 
-////////////////////////////////////////////////////////////
-float Font::getUnderlineThickness(unsigned int characterSize) const
-{
-    FT_Face face = static_cast<FT_Face>(m_face);
-
-    if (face && setCurrentSize(characterSize))
+    Uint8* pixel = &m_pixelBuffer[0];
+    for (unsigned int row = 0; row < height; ++row)
     {
-        // Return a fixed thickness if font is a bitmap font
-        if (!FT_IS_SCALABLE(face))
-            return characterSize / 14.f;
-
-        return static_cast<float>(FT_MulFix(face->underline_thickness, face->size->metrics.y_scale)) / static_cast<float>(1 << 6);
+        const Uint8* source = &page.coverage[(y + row) * pageWidth + x];
+        for (unsigned int column = 0; column < width; ++column)
+        {
+            if (channels == 1)
+            {
+                *pixel++ = source[column];
+            }
+            else
+            {
+                *pixel++ = 255;
+                *pixel++ = 255;
+                *pixel++ = 255;
+                *pixel++ = source[column];
+            }
+        }
     }
+
+    if (channels == 1)
+        page.texture.updateSingleChannel(&m_pixelBuffer[0], width, height, x, y);
     else
-    {
-        return 0.f;
-    }
+        page.texture.update(&m_pixelBuffer[0], width, height, x, y);
 }
 
 
 ////////////////////////////////////////////////////////////
-const Texture& Font::getTexture(unsigned int characterSize) const
+void Font::getPageTextures(std::vector<const Texture*>& textures) const
 {
-    return m_pages[characterSize].texture;
+    for (PageTable::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        textures.push_back(&it->second.texture);
 }
 
 
 ////////////////////////////////////////////////////////////
-Font& Font::operator =(const Font& right)
+void Font::restorePages() const
 {
-    Font temp(right);
-
-    std::swap(m_library,     temp.m_library);
-    std::swap(m_face,        temp.m_face);
-    std::swap(m_streamRec,   temp.m_streamRec);
-    std::swap(m_stroker,     temp.m_stroker);
-    std::swap(m_refCount,    temp.m_refCount);
-    std::swap(m_info,        temp.m_info);
-    std::swap(m_pages,       temp.m_pages);
-    std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    for (PageTable::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+    {
+        Page& page = it->second;
+        if (!page.texture.m_texture)
+            continue;
 
-    return *this;
+        Vector2u size = page.texture.getSize();
+        page.dirty = IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y));
+        uploadCoverage(page);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
-void Font::cleanup()
+bool Font::useDistanceField() const
 {
-    // Check if we must destroy the FreeType pointers
-    if (m_refCount)
-    {
-        // Decrease the reference counter
-        (*m_refCount)--;
-
-        // Free the resources only if we are the last owner
-        if (*m_refCount == 0)
-        {
-            // Delete the reference counter
-            delete m_refCount;
-
-            // Destroy the stroker
-            if (m_stroker)
-                FT_Stroker_Done(static_cast<FT_Stroker>(m_stroker));
-
-            // Destroy the font face
-            if (m_face)
-                FT_Done_Face(static_cast<FT_Face>(m_face));
-
-            // Destroy the stream rec instance, if any (must be done after FT_Done_Face!)
-            if (m_streamRec)
-                delete static_cast<FT_StreamRec*>(m_streamRec);
-
-            // Close the library
-            if (m_library)
-                FT_Done_FreeType(static_cast<FT_Library>(m_library));
-        }
-    }
+    FT_Face face = static_cast<FT_Face>(m_face);
 
-    // Reset members
-    m_library   = NULL;
-    m_face      = NULL;
-    m_stroker   = NULL;
-    m_streamRec = NULL;
-    m_refCount  = NULL;
-    m_pages.clear();
-    std::vector<Uint8>().swap(m_pixelBuffer);
+    return m_distanceField && face && FT_IS_SCALABLE(face);
 }
 
 
 ////////////////////////////////////////////////////////////
-Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
+FloatRect Font::measureGlyphs(const String& string, unsigned int characterSize, bool bold, float italicShear) const
 {
-    // The glyph to return
-    Glyph glyph;
-
-    // First, transform our ugly void* to a FT_Face
-    FT_Face face = static_cast<FT_Face>(m_face);
-    if (!face)
-        return glyph;
-
-    // Set the character size
-    if (!setCurrentSize(characterSize))
-        return glyph;
+    if (string.isEmpty())
+        return FloatRect();
+
+    // Same layout as FontMetrics::measure, with the glyphs of the font
+    float whitespaceWidth = getGlyph(L' ', characterSize, bold).advance;
+    float lineSpacing     = getLineSpacing(characterSize);
+
+    float x = 0.f;
+    float y = static_cast<float>(characterSize);
+    float minX = static_cast<float>(characterSize);
+    float minY = static_cast<float>(characterSize);
+    float maxX = 0.f;
+    float maxY = 0.f;
+    Uint32 prevChar = 0;
+    for (String::ConstIterator it = string.begin(); it != string.end(); ++it)
+    {
+        Uint32 curChar = *it;
 
-    // Load the glyph corresponding to the code point
-    FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
-    if (outlineThickness != 0)
-        flags |= FT_LOAD_NO_BITMAP;
-    if (FT_Load_Char(face, codePoint, flags) != 0)
-        return glyph;
+        // Skip the \r char, like sf::Text
+        if (curChar == '\r')
+            continue;
 
-    // Retrieve the glyph
-    FT_Glyph glyphDesc;
-    if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
-        return glyph;
+        x += getKerning(prevChar, curChar, characterSize);
+        prevChar = curChar;
 
-    // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
-    FT_Pos weight = 1 << 6;
-    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
-    if (outline)
-    {
-        if (bold)
+        // Whitespace only moves the pen
+        if ((curChar == L' ') || (curChar == L'\n') || (curChar == L'\t'))
         {
-            FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
-            FT_Outline_Embolden(&outlineGlyph->outline, weight);
-        }
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
 
-        if (outlineThickness != 0)
-        {
-            FT_Stroker stroker = static_cast<FT_Stroker>(m_stroker);
+            switch (curChar)
+            {
+                case L' ':  x += whitespaceWidth;     break;
+                case L'\t': x += whitespaceWidth * 4; break;
+                case L'\n': y += lineSpacing; x = 0;  break;
+            }
 
-            FT_Stroker_Set(stroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
-            FT_Glyph_Stroke(&glyphDesc, stroker, true);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            continue;
         }
-    }
-
-    // Convert the glyph to a bitmap (i.e. rasterize it)
-    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
-    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
 
-    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
-    if (!outline)
-    {
-        if (bold)
-            FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
+        const Glyph& glyph = getGlyph(curChar, characterSize, bold);
 
-        if (outlineThickness != 0)
-            err() << "Failed to outline glyph (no fallback available)" << std::endl;
-    }
+        float left   = glyph.bounds.left;
+        float top    = glyph.bounds.top;
+        float right  = glyph.bounds.left + glyph.bounds.width;
+        float bottom = glyph.bounds.top  + glyph.bounds.height;
 
-    // Compute the glyph's advance offset
-    glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
-    if (bold)
-        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+        minX = std::min(minX, x + left  - italicShear * bottom);
+        maxX = std::max(maxX, x + right - italicShear * top);
+        minY = std::min(minY, y + top);
+        maxY = std::max(maxY, y + bottom);
 
-    int width  = bitmap.width;
-    int height = bitmap.rows;
+        x += glyph.advance;
+    }
 
-    if ((width > 0) && (height > 0))
-    {
-        // Leave a small padding around characters, so that filtering doesn't
-        // pollute them with pixels from neighbors
-        const unsigned int padding = 1;
+    return FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
 
-        width += 2 * padding;
-        height += 2 * padding;
 
-        // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
+////////////////////////////////////////////////////////////
+float Font::getShaderOutlineWidth(float thickness, unsigned int characterSize) const
+{
+    thickness = std::abs(thickness);
 
-        // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, width, height);
+    if (useDistanceField())
+    {
+        // The field maps [-spread, spread] pixels of the base size to [0, 1], a bit
+        // of it is kept outside of the outline for antialiasing
+        float distance = thickness * distanceFieldSize / std::max(characterSize, 1u);
+        return std::min(distance, distanceFieldSpread * 0.9f) / (2.f * distanceFieldSpread);
+    }
 
-        // Make sure the texture data is positioned in the center
-        // of the allocated texture rectangle
-        glyph.textureRect.left += padding;
-        glyph.textureRect.top += padding;
-        glyph.textureRect.width -= 2 * padding;
-        glyph.textureRect.height -= 2 * padding;
+    // Beyond the padding, the outline would reach the neighbors of the glyph
+    return std::min(thickness, static_cast<float>(m_glyphPadding));
+}
 
-        // Compute the glyph's bounding box
-        glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
-        glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
-        glyph.bounds.width  =  static_cast<float>(face->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
-        glyph.bounds.height =  static_cast<float>(face->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
 
-        // Resize the pixel buffer to the new size and fill it with transparent white pixels
-        m_pixelBuffer.resize(width * height * 4);
+////////////////////////////////////////////////////////////
+const Font::SizeMetrics& Font::getSizeMetrics(unsigned int characterSize) const
+{
+    MetricsTables::const_iterator it = m_sizeMetrics.find(characterSize);
+    if (it != m_sizeMetrics.end())
+        return it->second;
 
-        Uint8* current = &m_pixelBuffer[0];
-        Uint8* end = current + width * height * 4;
+    // Resize the face once per character size, instead of at each query
+    SizeMetrics metrics = {0.f, 0.f, 0.f};
 
-        while (current != end)
-        {
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 0;
-        }
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (face && setCurrentSize(characterSize))
+    {
+        metrics.lineSpacing = static_cast<float>(face->size->metrics.height) / static_cast<float>(1 << 6);
 
-        // Extract the glyph's pixels from the bitmap
-        const Uint8* pixels = bitmap.buffer;
-        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+        // Return a fixed position and thickness if font is a bitmap font
+        if (!FT_IS_SCALABLE(face))
         {
-            // Pixels are 1 bit monochrome values
-            for (unsigned int y = padding; y < height - padding; ++y)
-            {
-                for (unsigned int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
-                }
-                pixels += bitmap.pitch;
-            }
+            metrics.underlinePosition  = characterSize / 10.f;
+            metrics.underlineThickness = characterSize / 14.f;
         }
         else
         {
-            // Pixels are 8 bits gray levels
-            for (unsigned int y = padding; y < height - padding; ++y)
-            {
-                for (unsigned int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = pixels[x - padding];
-                }
-                pixels += bitmap.pitch;
-            }
+            metrics.underlinePosition  = -static_cast<float>(FT_MulFix(face->underline_position, face->size->metrics.y_scale)) / static_cast<float>(1 << 6);
+            metrics.underlineThickness = static_cast<float>(FT_MulFix(face->underline_thickness, face->size->metrics.y_scale)) / static_cast<float>(1 << 6);
         }
-
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left - padding;
-        unsigned int y = glyph.textureRect.top - padding;
-        unsigned int w = glyph.textureRect.width + 2 * padding;
-        unsigned int h = glyph.textureRect.height + 2 * padding;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
     }
 
-    // Delete the FT glyph
-    FT_Done_Glyph(glyphDesc);
-
-    // Done :)
-    return glyph;
+    return m_sizeMetrics.insert(std::make_pair(characterSize, metrics)).first->second;
 }
 
 
 ////////////////////////////////////////////////////////////
-IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
+bool Font::isRenderThread() const
 {
-    // Find the line that fits well the glyph
-    Row* row = NULL;
-    float bestRatio = 0;
-    for (std::vector<Row>::iterator it = page.rows.begin(); it != page.rows.end() && !row; ++it)
-    {
-        float ratio = static_cast<float>(height) / it->height;
+    return !m_layoutMutex || (std::this_thread::get_id() == m_renderThread);
+}
 
-        // Ignore rows that are either too small or too high
-        if ((ratio < 0.7f) || (ratio > 1.f))
-            continue;
 
-        // Check if there's enough horizontal space left in the row
-        if (width > page.texture.getSize().x - it->width)
-            continue;
+////////////////////////////////////////////////////////////
+void Font::updateMemoryUsage() const
+{
+    Uint64 bytes = m_pixelBuffer.capacity();
+    for (PageTable::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        bytes += it->second.coverage.capacity();
+    for (GlyphTables::const_iterator it = m_glyphs.begin(); it != m_glyphs.end(); ++it)
+        bytes += it->second.getMemoryUsage();
 
-        // Make sure that this new row is the best found so far
-        if (ratio < bestRatio)
-            continue;
+    m_memory.update(bytes);
+}
 
-        // The current row passed all the tests: we can select it
-        row = &*it;
-        bestRatio = ratio;
-    }
 
-    // If we didn't find a matching row, create a new one (10% taller than the glyph)
-    if (!row)
-    {
-        int rowHeight = height + height / 10;
-        while ((page.nextRow + rowHeight >= page.texture.getSize().y) || (width >= page.texture.getSize().x))
-        {
-            // Not enough space: resize the texture if possible
-            unsigned int textureWidth  = page.texture.getSize().x;
-            unsigned int textureHeight = page.texture.getSize().y;
-            if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
-            {
-                // Make the texture 2 times bigger
-                Texture newTexture;
-                newTexture.create(textureWidth * 2, textureHeight * 2);
-                newTexture.setSmooth(true);
-                newTexture.update(page.texture);
-                page.texture.swap(newTexture);
-            }
-            else
-            {
-                // Oops, we've reached the maximum texture size...
-                err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
-                return IntRect(0, 0, 2, 2);
-            }
-        }
+////////////////////////////////////////////////////////////
+void Font::countRasterization(Time time) const
+{
+    ++m_stats.glyphsRasterized;
+    m_stats.rasterizationTime += time;
 
-        // We can now create the new row
-        page.rows.push_back(Row(page.nextRow, rowHeight));
-        page.nextRow += rowHeight;
-        row = &page.rows.back();
-    }
+    if (isRenderThread())
+        ++priv::getRenderStats().glyphsRasterized;
+}
 
-    // Find the glyph's rectangle on the selected row
-    IntRect rect(row->width, row->top, width, height);
 
-    // Update the row informations
-    row->width += width;
+////////////////////////////////////////////////////////////
+void Font::countTextRebuild(bool glyphsMoved) const
+{
+    LayoutLock lock(m_layoutMutex);
 
-    return rect;
+    if (glyphsMoved)
+        ++m_stats.textRelayouts;
+    else
+        ++m_stats.textRebuilds;
+
+    if (isRenderThread())
+        ++priv::getRenderStats().textRebuilds;
 }
 
 
@@ -626,22 +2258,4 @@ bool Font::setCurrentSize(unsigned int characterSize) const
 }
 
 
-////////////////////////////////////////////////////////////
-Font::Page::Page() :
-nextRow(3)
-{
-    // Make sure that the texture is initialized by default
-    sf::Image image;
-    image.create(128, 128, Color(255, 255, 255, 0));
-
-    // Reserve a 2x2 white square for texturing underlines
-    for (int x = 0; x < 2; ++x)
-        for (int y = 0; y < 2; ++y)
-            image.setPixel(x, y, Color(255, 255, 255, 255));
-
-    // Create the texture
-    texture.loadFromImage(image);
-    texture.setSmooth(true);
-}
-
 } // namespace sf
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FontCollection.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    // Number of characters of the Basic Multilingual Plane, resolved through a dense table
+    const sf::Uint32 basicPlaneSize = 0x10000;
+
+    // Find the first font that has a glyph for a character
+    std::size_t resolve(const std::vector<const sf::Font*>& fonts, sf::Uint32 codePoint)
+    {
+        for (std::size_t i = 0; i < fonts.size(); ++i)
+        {
+            if (fonts[i]->getGlyphIndex(codePoint) != 0)
+                return i;
+        }
+
+        // None has it: the first font draws its missing glyph
+        return 0;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+FontCollection::FontCollection()
+{
+    m_font.m_collection = this;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FontCollection::addFont(const Font& font)
+{
+    if (m_fonts.size() >= MaxFontCount)
+    {
+        err() << "Failed to add font to collection (a collection holds at most " << MaxFontCount << " fonts)" << std::endl;
+        return false;
+    }
+
+    if (font.m_collection)
+    {
+        err() << "Failed to add font to collection (combined fonts can't be nested)" << std::endl;
+        return false;
+    }
+
+    m_fonts.push_back(&font);
+    reset();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void FontCollection::clear()
+{
+    m_fonts.clear();
+    reset();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FontCollection::getFontCount() const
+{
+    return m_fonts.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const Font& FontCollection::getFont(std::size_t index) const
+{
+    return *m_fonts[index];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FontCollection::findFont(Uint32 codePoint) const
+{
+    if (m_fonts.size() <= 1)
+        return 0;
+
+    // Characters of the Basic Multilingual Plane go to the dense table
+    if (codePoint < basicPlaneSize)
+    {
+        if (m_basic.empty())
+            m_basic.assign(basicPlaneSize, 0);
+
+        Uint8& cached = m_basic[codePoint];
+        if (cached == 0)
+            cached = static_cast<Uint8>(resolve(m_fonts, codePoint) + 1);
+
+        return cached - 1;
+    }
+
+    // Other characters are rare, they go to the sparse table
+    std::map<Uint32, std::size_t>::const_iterator it = m_others.find(codePoint);
+    if (it != m_others.end())
+        return it->second;
+
+    std::size_t font = resolve(m_fonts, codePoint);
+    m_others.insert(std::make_pair(codePoint, font));
+
+    return font;
+}
+
+
+////////////////////////////////////////////////////////////
+const Font& FontCollection::getCombinedFont() const
+{
+    return m_font;
+}
+
+
+////////////////////////////////////////////////////////////
+void FontCollection::reset()
+{
+    std::vector<Uint8>().swap(m_basic);
+    m_others.clear();
+
+    // The glyph indices of the combined font depend on the list
+    m_font.cleanup();
+    m_font.m_info = m_fonts.empty() ? Font::Info() : m_fonts[0]->getInfo();
+}
+
+} // namespace sf
@@ -0,0 +1,231 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FontMetrics.hpp>
+#include <SFML/Graphics/FreeTypeLibrary.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <algorithm>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+FontMetrics::FontMetrics() :
+m_library(NULL),
+m_face   (NULL)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+FontMetrics::~FontMetrics()
+{
+    if (m_face)
+    {
+        Lock libraryLock(getFreeTypeLibraryMutex());
+        FT_Done_Face(static_cast<FT_Face>(m_face));
+    }
+
+    if (m_library)
+        releaseFreeTypeLibrary();
+}
+
+
+////////////////////////////////////////////////////////////
+bool FontMetrics::open(const void* data, std::size_t sizeInBytes)
+{
+    Lock lock(m_mutex);
+
+    FT_Library library = static_cast<FT_Library>(acquireFreeTypeLibrary());
+    if (!library)
+    {
+        err() << "Failed to open the font metrics (failed to initialize FreeType)" << std::endl;
+        return false;
+    }
+    m_library = library;
+
+    Lock libraryLock(getFreeTypeLibraryMutex());
+
+    FT_Face face;
+    if (FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(data), static_cast<FT_Long>(sizeInBytes), 0, &face) != 0)
+    {
+        err() << "Failed to open the font metrics (failed to create the font face)" << std::endl;
+        return false;
+    }
+    m_face = face;
+
+    if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0)
+    {
+        err() << "Failed to open the font metrics (failed to set the Unicode character set)" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect FontMetrics::measure(const String& string, unsigned int characterSize, bool bold, float italicShear)
+{
+    Lock lock(m_mutex);
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face || string.isEmpty())
+        return FloatRect();
+
+    if ((face->size->metrics.x_ppem != characterSize) && (FT_Set_Pixel_Sizes(face, 0, characterSize) != 0))
+        return FloatRect();
+
+    // Same layout as sf::Text, with the default spacing factors
+    float whitespaceWidth = getGlyph(L' ', characterSize, bold).advance;
+    float lineSpacing     = static_cast<float>(face->size->metrics.height) / static_cast<float>(1 << 6);
+
+    float x = 0.f;
+    float y = static_cast<float>(characterSize);
+    float minX = static_cast<float>(characterSize);
+    float minY = static_cast<float>(characterSize);
+    float maxX = 0.f;
+    float maxY = 0.f;
+    Uint32 prevChar = 0;
+    for (String::ConstIterator it = string.begin(); it != string.end(); ++it)
+    {
+        Uint32 curChar = *it;
+
+        // Skip the \r char, like sf::Text
+        if (curChar == '\r')
+            continue;
+
+        x += getKerning(prevChar, curChar, characterSize);
+        prevChar = curChar;
+
+        // Whitespace only moves the pen
+        if ((curChar == L' ') || (curChar == L'\n') || (curChar == L'\t'))
+        {
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+
+            switch (curChar)
+            {
+                case L' ':  x += whitespaceWidth;     break;
+                case L'\t': x += whitespaceWidth * 4; break;
+                case L'\n': y += lineSpacing; x = 0;  break;
+            }
+
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            continue;
+        }
+
+        const Glyph& glyph = getGlyph(curChar, characterSize, bold);
+
+        float left   = glyph.bounds.left;
+        float top    = glyph.bounds.top;
+        float right  = glyph.bounds.left + glyph.bounds.width;
+        float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+        minX = std::min(minX, x + left  - italicShear * bottom);
+        maxX = std::max(maxX, x + right - italicShear * top);
+        minY = std::min(minY, y + top);
+        maxY = std::max(maxY, y + bottom);
+
+        x += glyph.advance;
+    }
+
+    return FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& FontMetrics::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold)
+{
+    Uint64 key = (static_cast<Uint64>(characterSize) << 32) | (static_cast<Uint64>(bold) << 31) | (codePoint & 0x7FFFFFFF);
+
+    std::map<Uint64, Glyph>::iterator it = m_glyphs.find(key);
+    if (it != m_glyphs.end())
+        return it->second;
+
+    // Load the outline (or the bitmap) of the glyph to read its metrics, without rendering it
+    Glyph glyph;
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (FT_Load_Glyph(face, FT_Get_Char_Index(face, codePoint), FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) == 0)
+    {
+        const FT_Glyph_Metrics& metrics = face->glyph->metrics;
+
+        // Same metrics as the rasterized glyphs
+        glyph.advance = static_cast<float>(metrics.horiAdvance) / static_cast<float>(1 << 6);
+        if (bold)
+            glyph.advance += 1.f;
+
+        if ((metrics.width > 0) && (metrics.height > 0))
+        {
+            glyph.bounds.left   =  static_cast<float>(metrics.horiBearingX) / static_cast<float>(1 << 6);
+            glyph.bounds.top    = -static_cast<float>(metrics.horiBearingY) / static_cast<float>(1 << 6);
+            glyph.bounds.width  =  static_cast<float>(metrics.width)        / static_cast<float>(1 << 6);
+            glyph.bounds.height =  static_cast<float>(metrics.height)       / static_cast<float>(1 << 6);
+        }
+    }
+
+    return m_glyphs.insert(std::make_pair(key, glyph)).first->second;
+}
+
+
+////////////////////////////////////////////////////////////
+float FontMetrics::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if ((first == 0) || (second == 0) || !FT_HAS_KERNING(face))
+        return 0.f;
+
+    Uint64 key = (static_cast<Uint64>(characterSize) << 42) | (static_cast<Uint64>(first & 0x1FFFFF) << 21) | (second & 0x1FFFFF);
+
+    std::map<Uint64, float>::iterator it = m_kerning.find(key);
+    if (it != m_kerning.end())
+        return it->second;
+
+    float offset = 0.f;
+    FT_Vector kerning;
+    if (FT_Get_Kerning(face, FT_Get_Char_Index(face, first), FT_Get_Char_Index(face, second), FT_KERNING_DEFAULT, &kerning) == 0)
+    {
+        // X advance is already in pixels for bitmap fonts
+        offset = FT_IS_SCALABLE(face) ? static_cast<float>(kerning.x) / static_cast<float>(1 << 6) : static_cast<float>(kerning.x);
+    }
+
+    m_kerning.insert(std::make_pair(key, offset));
+    return offset;
+}
+
+} // namespace priv
+
+} // namespace sf
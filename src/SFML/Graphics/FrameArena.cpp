@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FrameArena.hpp>
+#include <algorithm>
+#include <cassert>
+
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // Offset of the first address aligned on \a alignment at or after \a offset in \a data
+    std::size_t alignOffset(const char* data, std::size_t offset, std::size_t alignment)
+    {
+        std::size_t address = reinterpret_cast<std::size_t>(data) + offset;
+        return offset + ((alignment - (address & (alignment - 1))) & (alignment - 1));
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+FrameArena::Scope::Scope(FrameArena& arena) :
+m_arena (arena),
+m_marker(arena.getMarker())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+FrameArena::Scope::~Scope()
+{
+    m_arena.rewind(m_marker);
+}
+
+
+////////////////////////////////////////////////////////////
+FrameArena::FrameArena(std::size_t blockSize) :
+m_blocks   (),
+m_current  (0),
+m_blockSize(blockSize)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+FrameArena::~FrameArena()
+{
+    for (std::size_t i = 0; i < m_blocks.size(); ++i)
+        delete[] m_blocks[i].data;
+}
+
+
+////////////////////////////////////////////////////////////
+void* FrameArena::allocate(std::size_t size, std::size_t alignment)
+{
+    assert((alignment != 0) && ((alignment & (alignment - 1)) == 0));
+
+    // Take the memory from the first block with enough room, the end of the skipped ones is lost until the next rewind
+    for (; m_current < m_blocks.size(); ++m_current)
+    {
+        Block& block = m_blocks[m_current];
+
+        std::size_t offset = alignOffset(block.data, block.used, alignment);
+        if (offset + size <= block.size)
+        {
+            block.used = offset + size;
+            return block.data + offset;
+        }
+    }
+
+    // No room left: request a new block to the heap
+    Block block;
+    block.size = std::max(m_blockSize, size + alignment);
+    block.data = new char[block.size];
+
+    std::size_t offset = alignOffset(block.data, 0, alignment);
+    block.used = offset + size;
+
+    m_blocks.push_back(block);
+    m_current = m_blocks.size() - 1;
+
+    return block.data + offset;
+}
+
+
+////////////////////////////////////////////////////////////
+FrameArena::Marker FrameArena::getMarker() const
+{
+    Marker marker;
+    marker.block = m_current;
+    marker.offset = (m_current < m_blocks.size()) ? m_blocks[m_current].used : 0;
+
+    return marker;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameArena::rewind(const Marker& marker)
+{
+    for (std::size_t i = marker.block; (i <= m_current) && (i < m_blocks.size()); ++i)
+        m_blocks[i].used = 0;
+
+    if (marker.block < m_blocks.size())
+        m_blocks[marker.block].used = marker.offset;
+
+    m_current = marker.block;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameArena::reset()
+{
+    // Merge the blocks, so that a frame as large as this one fits in a single block
+    if (m_blocks.size() > 1)
+    {
+        Block merged;
+        merged.size = getCapacity();
+        merged.used = 0;
+
+        for (std::size_t i = 0; i < m_blocks.size(); ++i)
+            delete[] m_blocks[i].data;
+
+        merged.data = new char[merged.size];
+
+        m_blocks.assign(1, merged);
+    }
+    else if (!m_blocks.empty())
+    {
+        m_blocks[0].used = 0;
+    }
+
+    m_current = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FrameArena::getUsedSize() const
+{
+    std::size_t size = 0;
+    for (std::size_t i = 0; (i <= m_current) && (i < m_blocks.size()); ++i)
+        size += m_blocks[i].used;
+
+    return size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FrameArena::getCapacity() const
+{
+    std::size_t capacity = 0;
+    for (std::size_t i = 0; i < m_blocks.size(); ++i)
+        capacity += m_blocks[i].size;
+
+    return capacity;
+}
+
+
+////////////////////////////////////////////////////////////
+FrameArena& FrameArena::getDefault()
+{
+    static thread_local FrameArena arena;
+
+    return arena;
+}
+
+} // namespace sf
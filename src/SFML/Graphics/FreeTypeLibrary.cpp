@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FreeTypeLibrary.hpp>
+#include <SFML/Graphics/Allocator.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_MODULE_H
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+
+namespace
+{
+    sf::Mutex                    libraryMutex;
+    FT_Library                   library        = NULL;
+    unsigned int                 libraryUsers   = 0;
+    FT_MemoryRec_                memoryRec;
+    sf::Font::AllocateCallback   allocateFunc   = NULL;
+    sf::Font::ReallocateCallback reallocateFunc = NULL;
+    sf::Font::DeallocateCallback deallocateFunc = NULL;
+    void*                        allocatorData  = NULL;
+
+    // FreeType doesn't give the size of the blocks it frees, it is stored before each block
+    const std::size_t headerSize = alignof(std::max_align_t);
+
+    char* writeHeader(void* block, std::size_t size)
+    {
+        *static_cast<std::size_t*>(block) = size;
+        return static_cast<char*>(block) + headerSize;
+    }
+
+    // FreeType memory callbacks, forwarding to the user allocator if any, or to sf::Allocator
+    void* ftAllocate(FT_Memory, long size)
+    {
+        std::size_t blockSize = static_cast<std::size_t>(size) + headerSize;
+
+        void* block = NULL;
+        if (allocateFunc)
+        {
+            block = allocateFunc(blockSize, allocatorData);
+            if (block)
+                sf::priv::trackMemory(sf::MemoryStats::Fonts, 0, blockSize);
+        }
+        else
+        {
+            block = sf::Allocator::allocate(blockSize, sf::MemoryStats::Fonts);
+        }
+
+        return block ? writeHeader(block, blockSize) : NULL;
+    }
+
+    void ftFree(FT_Memory, void* block)
+    {
+        if (!block)
+            return;
+
+        void* start = static_cast<char*>(block) - headerSize;
+        std::size_t blockSize = *static_cast<std::size_t*>(start);
+
+        if (deallocateFunc)
+        {
+            deallocateFunc(start, allocatorData);
+            sf::priv::trackMemory(sf::MemoryStats::Fonts, blockSize, 0);
+        }
+        else
+        {
+            sf::Allocator::deallocate(start, blockSize, sf::MemoryStats::Fonts);
+        }
+    }
+
+    void* ftReallocate(FT_Memory memory, long currentSize, long newSize, void* block)
+    {
+        if (!block)
+            return ftAllocate(memory, newSize);
+
+        if (reallocateFunc)
+        {
+            void* start = static_cast<char*>(block) - headerSize;
+            std::size_t blockSize = *static_cast<std::size_t*>(start);
+            std::size_t newBlockSize = static_cast<std::size_t>(newSize) + headerSize;
+
+            void* newBlock = reallocateFunc(start, blockSize, newBlockSize, allocatorData);
+            if (!newBlock)
+                return NULL;
+
+            sf::priv::trackMemory(sf::MemoryStats::Fonts, blockSize, newBlockSize);
+            return writeHeader(newBlock, newBlockSize);
+        }
+
+        // No reallocation function: emulate it with a new block
+        void* newBlock = ftAllocate(memory, newSize);
+        if (!newBlock)
+            return NULL;
+
+        std::memcpy(newBlock, block, static_cast<std::size_t>(std::min(currentSize, newSize)));
+        ftFree(memory, block);
+
+        return newBlock;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void* acquireFreeTypeLibrary()
+{
+    Lock lock(libraryMutex);
+
+    if (!library)
+    {
+        // Create the library manually so that it uses our memory callbacks
+        memoryRec.user    = NULL;
+        memoryRec.alloc   = &ftAllocate;
+        memoryRec.free    = &ftFree;
+        memoryRec.realloc = &ftReallocate;
+
+        if (FT_New_Library(&memoryRec, &library) != 0)
+        {
+            library = NULL;
+            return NULL;
+        }
+
+        FT_Add_Default_Modules(library);
+        FT_Set_Default_Properties(library);
+    }
+
+    ++libraryUsers;
+
+    return library;
+}
+
+
+////////////////////////////////////////////////////////////
+void releaseFreeTypeLibrary()
+{
+    Lock lock(libraryMutex);
+
+    if ((libraryUsers == 0) || (--libraryUsers > 0))
+        return;
+
+    // FT_Done_FreeType would also free the memory record, which is our static one
+    FT_Done_Library(library);
+
+    library = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+Mutex& getFreeTypeLibraryMutex()
+{
+    return libraryMutex;
+}
+
+
+////////////////////////////////////////////////////////////
+bool setFreeTypeAllocator(Font::AllocateCallback allocate, Font::ReallocateCallback reallocate, Font::DeallocateCallback deallocate, void* userData)
+{
+    Lock lock(libraryMutex);
+
+    if (library)
+    {
+        err() << "Failed to set the font allocator (fonts are still loaded)" << std::endl;
+        return false;
+    }
+
+    if ((allocate == NULL) != (deallocate == NULL))
+    {
+        err() << "Failed to set the font allocator (the allocation and deallocation functions must be both set or both NULL)" << std::endl;
+        return false;
+    }
+
+    allocateFunc   = allocate;
+    reallocateFunc = allocate ? reallocate : NULL;
+    deallocateFunc = deallocate;
+    allocatorData  = userData;
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
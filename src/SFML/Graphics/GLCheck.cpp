@@ -27,13 +27,104 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <string>
 
 
+namespace
+{
+    // Mode selected by setGLCheckMode
+    sf::priv::GLCheckMode checkMode = sf::priv::GLCheckEveryCall;
+    unsigned int sampleInterval = 64;
+
+#if !defined(SFML_SYSTEM_EMSCRIPTEN)
+
+    // Drivers may call back from their own threads
+    sf::Mutex debugOutputMutex;
+
+    // Report the errors detected by the driver
+    void APIENTRY debugOutputCallback(GLenum, GLenum type, GLuint id, GLenum, GLsizei, const GLchar* message, const void*)
+    {
+        if (type != GL_DEBUG_TYPE_ERROR)
+            return;
+
+        sf::Lock lock(debugOutputMutex);
+        sf::err() << "An OpenGL call failed (reported by the driver, id " << id << ")."
+                  << "\nError description:\n   " << message << "\n"
+                  << std::endl;
+    }
+
+#endif
+}
+
+
 namespace sf
 {
 namespace priv
 {
+////////////////////////////////////////////////////////////
+unsigned int glCheckInterval = 1;
+thread_local unsigned int glCheckCounter = 0;
+
+
+////////////////////////////////////////////////////////////
+void setGLCheckMode(GLCheckMode mode, unsigned int interval)
+{
+    checkMode = mode;
+    sampleInterval = (interval > 0) ? interval : 1;
+
+    switch (mode)
+    {
+        case GLCheckEveryCall:   glCheckInterval = 1;              break;
+        case GLCheckSampled:     glCheckInterval = sampleInterval; break;
+        case GLCheckDebugOutput: glCheckInterval = 0;              break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool installGLDebugOutput()
+{
+    if (checkMode != GLCheckDebugOutput)
+        return false;
+
+#if !defined(SFML_SYSTEM_EMSCRIPTEN)
+
+    ensureExtensionsInit();
+
+    // Only the errors are enabled, the performance and portability remarks would flood the log
+    if (glDebugMessageCallback && glDebugMessageControl)
+    {
+        glDebugMessageCallback(debugOutputCallback, NULL);
+        glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_FALSE);
+        glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_ERROR, GL_DONT_CARE, 0, NULL, GL_TRUE);
+        glEnable(GL_DEBUG_OUTPUT);
+        return true;
+    }
+
+    if (glDebugMessageCallbackKHR && glDebugMessageControlKHR)
+    {
+        glDebugMessageCallbackKHR(debugOutputCallback, NULL);
+        glDebugMessageControlKHR(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_FALSE);
+        glDebugMessageControlKHR(GL_DONT_CARE, GL_DEBUG_TYPE_ERROR_KHR, GL_DONT_CARE, 0, NULL, GL_TRUE);
+        glEnable(GL_DEBUG_OUTPUT_KHR);
+        return true;
+    }
+
+#endif
+
+    // Without KHR_debug, fall back to sampled polling
+    if (glCheckInterval == 0)
+    {
+        err() << "KHR_debug is not supported by the driver, OpenGL errors are sampled with glGetError instead" << std::endl;
+        glCheckInterval = sampleInterval;
+    }
+
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 void glCheckError(const char* file, unsigned int line, const char* expression)
 {
@@ -99,9 +190,10 @@ void glCheckError(const char* file, unsigned int line, const char* expression)
             }
         }
 
-        // Log the error
+        // Log the error (when sampling, the call that failed may be any call since the last poll)
         err() << "An internal OpenGL call failed in "
-              << fileString.substr(fileString.find_last_of("\\/") + 1) << "(" << line << ")."
+              << fileString.substr(fileString.find_last_of("\\/") + 1) << "(" << line << ")"
+              << ((glCheckInterval > 1) ? ", or in one of the calls before." : ".")
               << "\nExpression:\n   " << expression
               << "\nError description:\n   " << error << "\n   " << description << "\n"
               << std::endl;
@@ -26,16 +26,227 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+    #include <emscripten/html5.h>
+    #include <cstdint>
+#else
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+        extern void* SDL_GL_GetProcAddress(const char*);
+        extern void* SDL_GL_GetCurrentContext(void);
+    #ifdef __cplusplus
+    }
+    #endif
+#endif
 
 
-#ifdef __cplusplus
-extern "C" {
+namespace
+{
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+    // glad doesn't know the WebGL extensions, the entry point is looked up by hand
+    typedef void (*MultiDrawArraysWEBGL)(GLenum mode, const GLint* first, const GLsizei* count, GLsizei drawCount);
+    MultiDrawArraysWEBGL multiDrawArraysWEBGL = NULL;
 #endif
-    extern void* SDL_GL_GetProcAddress(const char*);
-#ifdef __cplusplus
-}
+
+    sf::GraphicsCaps graphicsCaps;
+    sf::StartupStats startupStats;
+    sf::Clock        startupClock;
+    bool             minimalLoading = true;
+
+    // The first render target may be created on any thread (a web worker in the browser)
+    std::atomic<bool> extensionsInitialized(false);
+    sf::Mutex         extensionsMutex;
+
+    // SDL only knows the contexts it created, and only on the thread that runs its video
+    // subsystem, which is the main thread in the browser. The html5 API also works on
+    // workers, with OffscreenCanvas contexts (OFFSCREENCANVAS_SUPPORT, OFFSCREEN_FRAMEBUFFER)
+    void* getProcAddress(const char* name)
+    {
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+        return emscripten_webgl_get_proc_address(name);
+#else
+        return SDL_GL_GetProcAddress(name);
 #endif
+    }
+
+    // The OpenGL functions called by the graphics module, plus glGetStringi that glad
+    // needs to list the extensions; sorted for the binary search. A function missing
+    // from this table stays NULL when minimal loading is enabled, new calls to OpenGL
+    // must be added here
+    const char* const usedEntryPoints[] =
+    {
+        "glActiveTexture",                      "glAttachShader",                       "glBeginQuery",
+        "glBeginQueryEXT",                      "glBindAttribLocation",                 "glBindBuffer",
+        "glBindBufferBase",                     "glBindFramebuffer",                    "glBindRenderbuffer",
+        "glBindSampler",                        "glBindTexture",                        "glBindVertexArray",
+        "glBindVertexArrayOES",                 "glBlendEquation",                      "glBlendEquationSeparate",
+        "glBlendFunc",                          "glBlendFuncSeparate",                  "glBlitFramebuffer",
+        "glBufferData",                         "glBufferSubData",                      "glCheckFramebufferStatus",
+        "glClear",                              "glClearColor",                         "glClearStencil",
+        "glClientWaitSync",                     "glColorMask",                          "glCompileShader",
+        "glCompressedTexImage2D",               "glCopyBufferSubData",                  "glCopyTexSubImage2D",
+        "glCreateProgram",                      "glCreateShader",                       "glDebugMessageCallback",
+        "glDebugMessageCallbackKHR",            "glDebugMessageControl",                "glDebugMessageControlKHR",
+        "glDeleteBuffers",                      "glDeleteFramebuffers",                 "glDeleteProgram",
+        "glDeleteQueries",                      "glDeleteQueriesEXT",                   "glDeleteRenderbuffers",
+        "glDeleteSamplers",                     "glDeleteShader",                       "glDeleteSync",
+        "glDeleteTextures",                     "glDeleteVertexArrays",                 "glDeleteVertexArraysOES",
+        "glDepthFunc",                          "glDepthMask",                          "glDepthRange",
+        "glDepthRangef",                        "glDisable",                            "glDiscardFramebufferEXT",
+        "glDrawArrays",                         "glDrawBuffers",                        "glDrawBuffersEXT",
+        "glDrawElements",                       "glDrawElementsBaseVertex",             "glDrawElementsInstanced",
+        "glDrawElementsInstancedANGLE",         "glDrawElementsInstancedARB",           "glDrawElementsInstancedEXT",
+        "glEnable",                             "glEnableVertexAttribArray",            "glEndQuery",
+        "glEndQueryEXT",                        "glFenceSync",                          "glFinish",
+        "glFlush",                              "glFramebufferRenderbuffer",            "glFramebufferTexture2D",
+        "glFramebufferTexture2DMultisampleEXT", "glGenBuffers",                         "glGenFramebuffers",
+        "glGenQueries",                         "glGenQueriesEXT",                      "glGenRenderbuffers",
+        "glGenSamplers",                        "glGenTextures",                        "glGenVertexArrays",
+        "glGenVertexArraysOES",                 "glGenerateMipmap",                     "glGetError",
+        "glGetIntegerv",                        "glGetProgramBinary",                   "glGetProgramBinaryOES",
+        "glGetProgramInfoLog",                  "glGetProgramiv",                       "glGetQueryObjectui64v",
+        "glGetQueryObjectui64vEXT",             "glGetQueryObjectuiv",                  "glGetQueryObjectuivEXT",
+        "glGetShaderInfoLog",                   "glGetShaderiv",                        "glGetString",
+        "glGetStringi",                         "glGetTexImage",                        "glGetUniformBlockIndex",
+        "glGetUniformLocation",                 "glInvalidateFramebuffer",              "glIsEnabled",
+        "glLinkProgram",                        "glMapBuffer",                          "glMapBufferRange",
+        "glMultiDrawArrays",                    "glMultiDrawArraysEXT",                 "glPixelStorei",
+        "glProgramBinary",                      "glProgramBinaryOES",                   "glProgramParameteri",
+        "glReadPixels",                         "glRenderbufferStorage",                "glRenderbufferStorageMultisample",
+        "glRenderbufferStorageMultisampleEXT",  "glSamplerParameteri",                  "glScissor",
+        "glShaderSource",                       "glStencilFunc",                        "glStencilOp",
+        "glTexImage2D",                         "glTexImage3D",                         "glTexParameteri",
+        "glTexStorage2D",                       "glTexStorage3D",                       "glTexSubImage2D",
+        "glTexSubImage3D",                      "glUniform1f",                          "glUniform1fv",
+        "glUniform1i",                          "glUniform1iv",                         "glUniform2f",
+        "glUniform2fv",                         "glUniform2iv",                         "glUniform3fv",
+        "glUniform3iv",                         "glUniform4f",                          "glUniform4fv",
+        "glUniform4iv",                         "glUniformBlockBinding",                "glUniformMatrix3fv",
+        "glUniformMatrix4fv",                   "glUnmapBuffer",                        "glUseProgram",
+        "glVertexAttribDivisor",                "glVertexAttribDivisorANGLE",           "glVertexAttribDivisorARB",
+        "glVertexAttribDivisorEXT",             "glVertexAttribPointer",                "glViewport",
+    };
+
+    struct NameLess
+    {
+        bool operator ()(const char* left, const char* right) const
+        {
+            return std::strcmp(left, right) < 0;
+        }
+    };
+
+    // glad looks up all the functions of all the versions and extensions it knows,
+    // which is slow in the browser; the ones SFML doesn't call are skipped
+    void* loadEntryPoint(const char* name)
+    {
+        if (minimalLoading && !std::binary_search(std::begin(usedEntryPoints), std::end(usedEntryPoints), name, NameLess()))
+        {
+            ++startupStats.entryPointsSkipped;
+            return NULL;
+        }
+
+        ++startupStats.entryPointsLoaded;
+        return getProcAddress(name);
+    }
+
+    // Fill the capabilities once, right after the functions are loaded
+    void detectGraphicsCaps()
+    {
+        sf::GraphicsCaps& caps = graphicsCaps;
+
+#if defined(SFML_OPENGL_ES) || defined(SFML_SYSTEM_EMSCRIPTEN)
+        caps.tier         = GLAD_GL_ES_VERSION_3_0 ? sf::GraphicsCaps::TierES3 : sf::GraphicsCaps::TierES2;
+        caps.majorVersion = GLAD_GL_ES_VERSION_3_0 ? 3 : 2;
+        caps.minorVersion = GLAD_GL_ES_VERSION_3_2 ? 2 : (GLAD_GL_ES_VERSION_3_1 ? 1 : 0);
+#else
+        if (GLAD_GL_VERSION_3_0)
+        {
+            // glad stops at 3.3, newer versions can only be queried
+            GLint major = 0;
+            GLint minor = 0;
+            glGetIntegerv(GL_MAJOR_VERSION, &major);
+            glGetIntegerv(GL_MINOR_VERSION, &minor);
+            caps.majorVersion = major;
+            caps.minorVersion = minor;
+        }
+        else
+        {
+            caps.majorVersion = GLAD_GL_VERSION_2_0 ? 2 : 1;
+            caps.minorVersion = GLAD_GL_VERSION_2_1 ? 1 : 0;
+        }
+
+        if (caps.majorVersion >= 4)
+            caps.tier = sf::GraphicsCaps::TierGL4;
+        else if (GLAD_GL_VERSION_3_3)
+            caps.tier = sf::GraphicsCaps::TierGL33;
+        else
+            caps.tier = sf::GraphicsCaps::TierGL2;
+#endif
+
+        caps.instancing = (glVertexAttribDivisor && glDrawElementsInstanced) ||
+                          (glVertexAttribDivisorARB && glDrawElementsInstancedARB) ||
+                          (glVertexAttribDivisorEXT && glDrawElementsInstancedEXT) ||
+                          (glVertexAttribDivisorANGLE && glDrawElementsInstancedANGLE);
+
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+        // The function exists whether the extension is enabled or not
+        const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+        if (extensions && std::strstr(extensions, "WEBGL_multi_draw"))
+            multiDrawArraysWEBGL = reinterpret_cast<MultiDrawArraysWEBGL>(getProcAddress("glMultiDrawArraysWEBGL"));
+
+        caps.multiDraw = (multiDrawArraysWEBGL != NULL);
+#else
+        caps.multiDraw = glMultiDrawArrays || glMultiDrawArraysEXT;
+#endif
+
+        // WebGL has no buffer mapping at all, and can't wait on sync objects
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+        caps.mapBufferRange = false;
+        caps.fenceSync      = false;
+        caps.drawBaseVertex = false;
+#elif defined(SFML_OPENGL_ES)
+        caps.mapBufferRange = (GLAD_GL_ES_VERSION_3_0 > 0);
+        caps.fenceSync      = (GLAD_GL_ES_VERSION_3_0 > 0);
+        caps.drawBaseVertex = (GLAD_GL_ES_VERSION_3_2 > 0);
+#else
+        caps.mapBufferRange = (GLAD_GL_VERSION_3_0 > 0) || (GLAD_GL_ARB_map_buffer_range > 0);
+        caps.fenceSync      = (GLAD_GL_VERSION_3_2 > 0) || (GLAD_GL_ARB_sync > 0);
+        caps.drawBaseVertex = (GLAD_GL_VERSION_3_2 > 0) || (GLAD_GL_ARB_draw_elements_base_vertex > 0);
+#endif
+
+        caps.textureStorage        = (glTexStorage2D != NULL);
+        caps.invalidateFramebuffer = glInvalidateFramebuffer || glDiscardFramebufferEXT;
+
+#if defined(SFML_OPENGL_ES) || defined(SFML_SYSTEM_EMSCRIPTEN)
+        caps.unpackRowLength  = (GLAD_GL_ES_VERSION_3_0 > 0) || (GLAD_GL_EXT_unpack_subimage > 0);
+        caps.elementIndexUint = (GLAD_GL_ES_VERSION_3_0 > 0) || (GLAD_GL_OES_element_index_uint > 0);
+        caps.uniformBuffers   = (GLAD_GL_ES_VERSION_3_0 > 0);
+        caps.textureArrays    = (GLAD_GL_ES_VERSION_3_0 > 0);
+        caps.timerQueries     = (GLAD_GL_EXT_disjoint_timer_query > 0);
+        caps.samplerObjects   = (GLAD_GL_ES_VERSION_3_0 > 0) && (glGenSamplers != NULL);
+#else
+        caps.unpackRowLength  = true;
+        caps.elementIndexUint = true;
+        caps.uniformBuffers   = (GLAD_GL_VERSION_3_1 > 0) || (GLAD_GL_ARB_uniform_buffer_object > 0);
+        caps.textureArrays    = (GLAD_GL_VERSION_3_0 > 0) || (GLAD_GL_EXT_texture_array > 0);
+        caps.timerQueries     = (GLAD_GL_VERSION_3_3 > 0) || (GLAD_GL_ARB_timer_query > 0);
+        caps.samplerObjects   = ((GLAD_GL_VERSION_3_3 > 0) || (GLAD_GL_ARB_sampler_objects > 0)) && (glGenSamplers != NULL);
+#endif
+    }
+}
 
 
 namespace sf
@@ -45,19 +256,308 @@ namespace priv
 ////////////////////////////////////////////////////////////
 void ensureExtensionsInit()
 {
-    static bool initialized = false;
-    if (!initialized)
+    if (extensionsInitialized.load(std::memory_order_acquire))
+        return;
+
+    Lock lock(extensionsMutex);
+
+    if (!extensionsInitialized.load(std::memory_order_relaxed))
     {
-        initialized = true;
+        startupClock.restart();
 
 #if defined(SFML_OPENGL_ES) || defined(SFML_SYSTEM_EMSCRIPTEN)
-        gladLoadGLES2Loader(reinterpret_cast<GLADloadproc>(SDL_GL_GetProcAddress));
+        gladLoadGLES2Loader(loadEntryPoint);
 #else    
-        gladLoadGLLoader(reinterpret_cast<GLADloadproc>(SDL_GL_GetProcAddress));
+        gladLoadGLLoader(loadEntryPoint);
 #endif    
+
+        startupStats.loaderTime = startupClock.getElapsedTime();
+
+        detectGraphicsCaps();
+
+        startupStats.capsTime = startupClock.getElapsedTime() - startupStats.loaderTime;
+
+        extensionsInitialized.store(true, std::memory_order_release);
     };
 }
 
+
+////////////////////////////////////////////////////////////
+void setMinimalGLLoading(bool enabled)
+{
+    minimalLoading = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+StartupStats& getStartupStats()
+{
+    return startupStats;
+}
+
+
+////////////////////////////////////////////////////////////
+Time getTimeSinceStartup()
+{
+    return startupClock.getElapsedTime();
+}
+
+
+////////////////////////////////////////////////////////////
+const GraphicsCaps& getGraphicsCaps()
+{
+    ensureExtensionsInit();
+
+    return graphicsCaps;
+}
+
+
+////////////////////////////////////////////////////////////
+void* getCurrentContext()
+{
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+    return reinterpret_cast<void*>(static_cast<std::uintptr_t>(emscripten_webgl_get_current_context()));
+#else
+    return SDL_GL_GetCurrentContext();
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool isInstancingAvailable()
+{
+    return getGraphicsCaps().instancing;
+}
+
+
+////////////////////////////////////////////////////////////
+void vertexAttribDivisor(GLuint index, GLuint divisor)
+{
+    if (glVertexAttribDivisor)
+        glVertexAttribDivisor(index, divisor);
+    else if (glVertexAttribDivisorARB)
+        glVertexAttribDivisorARB(index, divisor);
+    else if (glVertexAttribDivisorEXT)
+        glVertexAttribDivisorEXT(index, divisor);
+    else if (glVertexAttribDivisorANGLE)
+        glVertexAttribDivisorANGLE(index, divisor);
+}
+
+
+////////////////////////////////////////////////////////////
+void drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instanceCount)
+{
+    if (glDrawElementsInstanced)
+        glDrawElementsInstanced(mode, count, type, indices, instanceCount);
+    else if (glDrawElementsInstancedARB)
+        glDrawElementsInstancedARB(mode, count, type, indices, instanceCount);
+    else if (glDrawElementsInstancedEXT)
+        glDrawElementsInstancedEXT(mode, count, type, indices, instanceCount);
+    else if (glDrawElementsInstancedANGLE)
+        glDrawElementsInstancedANGLE(mode, count, type, indices, instanceCount);
+}
+
+
+////////////////////////////////////////////////////////////
+bool isMultiDrawAvailable()
+{
+    return getGraphicsCaps().multiDraw;
+}
+
+
+////////////////////////////////////////////////////////////
+void multiDrawArrays(GLenum mode, const GLint* first, const GLsizei* count, GLsizei drawCount)
+{
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+    if (multiDrawArraysWEBGL)
+        multiDrawArraysWEBGL(mode, first, count, drawCount);
+#else
+    if (glMultiDrawArrays)
+        glMultiDrawArrays(mode, first, count, drawCount);
+    else if (glMultiDrawArraysEXT)
+        glMultiDrawArraysEXT(mode, first, count, drawCount);
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool isProgramBinaryAvailable()
+{
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+    return false;
+#else
+    ensureExtensionsInit();
+
+    static bool available = false;
+    static bool queried = false;
+    if (!queried)
+    {
+        queried = true;
+
+        if ((glGetProgramBinary && glProgramBinary) || (glGetProgramBinaryOES && glProgramBinaryOES))
+        {
+            // Some drivers expose the functions without supporting any format
+            GLint formats = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            available = (formats > 0);
+        }
+    }
+
+    return available;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void getProgramBinary(GLuint program, GLsizei bufferSize, GLsizei* length, GLenum* format, void* binary)
+{
+    if (glGetProgramBinary)
+        glGetProgramBinary(program, bufferSize, length, format, binary);
+    else if (glGetProgramBinaryOES)
+        glGetProgramBinaryOES(program, bufferSize, length, format, binary);
+}
+
+
+////////////////////////////////////////////////////////////
+void programBinary(GLuint program, GLenum format, const void* binary, GLsizei length)
+{
+    if (glProgramBinary)
+        glProgramBinary(program, format, binary, length);
+    else if (glProgramBinaryOES)
+        glProgramBinaryOES(program, format, binary, length);
+}
+
+
+////////////////////////////////////////////////////////////
+bool isElementIndexUintAvailable()
+{
+    return getGraphicsCaps().elementIndexUint;
+}
+
+
+////////////////////////////////////////////////////////////
+void discardFramebuffer(bool color, bool depthStencil)
+{
+    if (!getGraphicsCaps().invalidateFramebuffer)
+        return;
+
+    // The default frame buffer names its buffers instead of its attachments
+    bool defaultFramebuffer = (getGLStateCache().getFramebuffer(GL_FRAMEBUFFER) == 0);
+
+    GLenum attachments[3];
+    GLsizei count = 0;
+
+    if (color)
+        attachments[count++] = defaultFramebuffer ? GL_COLOR : GL_COLOR_ATTACHMENT0;
+
+    if (depthStencil)
+    {
+        attachments[count++] = defaultFramebuffer ? GL_DEPTH : GL_DEPTH_ATTACHMENT;
+        attachments[count++] = defaultFramebuffer ? GL_STENCIL : GL_STENCIL_ATTACHMENT;
+    }
+
+    if (count == 0)
+        return;
+
+    if (glInvalidateFramebuffer)
+        glCheck(glInvalidateFramebuffer(GL_FRAMEBUFFER, count, attachments));
+    else
+        glCheck(glDiscardFramebufferEXT(GL_FRAMEBUFFER, count, attachments));
+}
+
+
+////////////////////////////////////////////////////////////
+bool isParallelShaderCompileAvailable()
+{
+    ensureExtensionsInit();
+
+    // The driver picks its own number of compiler threads by default
+    return GLAD_GL_KHR_parallel_shader_compile || GLAD_GL_ARB_parallel_shader_compile;
+}
+
+
+////////////////////////////////////////////////////////////
+GLenum getCompressedUploadFormat(GLenum format)
+{
+    ensureExtensionsInit();
+
+    // WebGL and some ES drivers expose their compressed formats under names
+    // that glad doesn't know, but they all list them in this query
+    static std::vector<GLint> formats;
+    static bool queried = false;
+    if (!queried)
+    {
+        queried = true;
+
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+        if (count > 0)
+        {
+            formats.resize(count);
+            glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, &formats[0]);
+        }
+    }
+
+    if (std::find(formats.begin(), formats.end(), static_cast<GLint>(format)) != formats.end())
+        return format;
+
+    switch (format)
+    {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+            return (GLAD_GL_EXT_texture_compression_s3tc || GLAD_GL_EXT_texture_compression_dxt1) ? format : 0;
+
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+            return (GLAD_GL_EXT_texture_compression_s3tc || GLAD_GL_ANGLE_texture_compression_dxt3) ? format : 0;
+
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            return (GLAD_GL_EXT_texture_compression_s3tc || GLAD_GL_ANGLE_texture_compression_dxt5) ? format : 0;
+
+        case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+            return (GLAD_GL_EXT_texture_compression_s3tc && (GLAD_GL_EXT_texture_sRGB || GLAD_GL_EXT_texture_compression_s3tc_srgb)) ? format : 0;
+
+        case GL_ETC1_RGB8_OES:
+            // Only OES_compressed_ETC1_RGB8_texture knows the ETC1 token, but ETC1
+            // data is valid ETC2 data, so it can be uploaded as such where ETC2 is
+            if (GLAD_GL_OES_compressed_ETC1_RGB8_texture)
+                return format;
+            return getCompressedUploadFormat(GL_COMPRESSED_RGB8_ETC2) ? GL_COMPRESSED_RGB8_ETC2 : 0;
+
+        case GL_COMPRESSED_RGB8_ETC2:
+        case GL_COMPRESSED_SRGB8_ETC2:
+        case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:
+        case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+            // ETC2 is not core in WebGL 2: WEBGL_compressed_texture_etc lists its formats in the query
+            return 0;
+#elif defined(SFML_OPENGL_ES)
+            return GLAD_GL_ES_VERSION_3_0 ? format : 0;
+#else
+            return GLAD_GL_ARB_ES3_compatibility ? format : 0;
+#endif
+
+        default:
+            break;
+    }
+
+    if ((format >= GL_COMPRESSED_RGBA_ASTC_4x4) && (format <= GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12))
+        return (GLAD_GL_KHR_texture_compression_astc_ldr || GLAD_GL_OES_texture_compression_astc) ? format : 0;
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool isCompressedFormatAvailable(GLenum format)
+{
+    return getCompressedUploadFormat(format) != 0;
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -0,0 +1,648 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <atomic>
+#include <map>
+
+
+namespace
+{
+    // Value of a shadowed binding that has to be read from the driver
+    const GLuint unknown = 0xFFFFFFFF;
+
+    // Buffer targets, in m_buffers order
+    const GLenum bufferTargets[] =
+    {
+        GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_COPY_READ_BUFFER,
+        GL_COPY_WRITE_BUFFER, GL_PIXEL_PACK_BUFFER, GL_PIXEL_UNPACK_BUFFER,
+        GL_UNIFORM_BUFFER
+    };
+
+    // Buffer binding queries, in m_buffers order
+    const GLenum bufferBindings[] =
+    {
+        GL_ARRAY_BUFFER_BINDING, GL_ELEMENT_ARRAY_BUFFER_BINDING, GL_COPY_READ_BUFFER_BINDING,
+        GL_COPY_WRITE_BUFFER_BINDING, GL_PIXEL_PACK_BUFFER_BINDING, GL_PIXEL_UNPACK_BUFFER_BINDING,
+        GL_UNIFORM_BUFFER_BINDING
+    };
+
+    // Query a binding from the driver
+    inline GLuint queryBinding(GLenum binding)
+    {
+        GLint value = 0;
+        glCheck(glGetIntegerv(binding, &value));
+        return static_cast<GLuint>(value);
+    }
+
+    // Shadows of the contexts, by OpenGL context
+    sf::Mutex cacheMutex;
+    std::map<void*, sf::priv::GLStateCache*> caches;
+
+    // Changed when a shadow is destroyed, so that the threads look their context up again
+    std::atomic<unsigned int> cacheGeneration(0);
+
+    // Last shadow looked up by the thread
+    thread_local void*                   threadContext = NULL;
+    thread_local sf::priv::GLStateCache* threadCache = NULL;
+    thread_local unsigned int            threadGeneration = 0;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+GLStateCache::GLStateCache()
+{
+    for (int i = 0; i < SamplerCount; ++i)
+        m_sharedSamplers[i] = 0;
+
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::invalidate()
+{
+    m_program         = unknown;
+    m_vertexArray     = unknown;
+    m_activeTexture   = unknown;
+    m_readFramebuffer = unknown;
+    m_drawFramebuffer = unknown;
+
+    for (int i = 0; i < BufferTargetCount; ++i)
+        m_buffers[i] = unknown;
+
+    for (int i = 0; i < MaxTextureUnits; ++i)
+    {
+        m_textures[i] = unknown;
+        m_samplers[i] = unknown;
+    }
+
+    for (int i = 0; i < CapabilityCount; ++i)
+        m_capabilities[i] = -1;
+
+    for (int i = 0; i < 4; ++i)
+        m_blendFunc[i] = unknown;
+
+    for (int i = 0; i < 2; ++i)
+        m_blendEquation[i] = unknown;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        m_viewport[i] = -1;
+        m_scissor[i] = -1;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::useProgram(GLuint program)
+{
+    if (m_program != program)
+    {
+        glCheck(glUseProgram(program));
+        m_program = program;
+
+        ++getRenderStats().programSwitches;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::bindVertexArray(GLuint vertexArray)
+{
+    if (m_vertexArray != vertexArray)
+    {
+        glCheck(SFML_GL_EXT_glBindVertexArray(vertexArray));
+        m_vertexArray = vertexArray;
+
+        // The element array binding is part of the vertex array state
+        m_buffers[bufferSlot(GL_ELEMENT_ARRAY_BUFFER)] = unknown;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::bindBuffer(GLenum target, GLuint buffer)
+{
+    int slot = bufferSlot(target);
+
+    if ((slot < 0) || (m_buffers[slot] != buffer))
+    {
+        glCheck(glBindBuffer(target, buffer));
+
+        if (slot >= 0)
+            m_buffers[slot] = buffer;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::bindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+    // Indexed bindings are not shadowed, but they also bind the generic target
+    glCheck(glBindBufferBase(target, index, buffer));
+
+    int slot = bufferSlot(target);
+    if (slot >= 0)
+        m_buffers[slot] = buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::activeTexture(unsigned int unit)
+{
+    if (m_activeTexture != unit)
+    {
+        glCheck(glActiveTexture(GL_TEXTURE0 + unit));
+        m_activeTexture = unit;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::bindTexture(GLuint texture)
+{
+    unsigned int unit = getActiveTexture();
+
+    if ((unit >= MaxTextureUnits) || (m_textures[unit] != texture))
+    {
+        glCheck(glBindTexture(GL_TEXTURE_2D, texture));
+
+        if (unit < MaxTextureUnits)
+            m_textures[unit] = texture;
+
+        ++getRenderStats().textureBinds;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::bindTexture(unsigned int unit, GLuint texture)
+{
+    if ((unit < MaxTextureUnits) && (m_textures[unit] == texture))
+        return;
+
+    activeTexture(unit);
+    bindTexture(texture);
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::bindSampler(unsigned int unit, GLuint sampler)
+{
+    if (((unit < MaxTextureUnits) && (m_samplers[unit] == sampler)) || !getGraphicsCaps().samplerObjects)
+        return;
+
+    glCheck(glBindSampler(unit, sampler));
+
+    if (unit < MaxTextureUnits)
+        m_samplers[unit] = sampler;
+}
+
+
+////////////////////////////////////////////////////////////
+GLuint GLStateCache::getSampler(bool smooth, bool repeated, bool mipmapped)
+{
+    if (!getGraphicsCaps().samplerObjects)
+        return 0;
+
+    GLuint& sampler = m_sharedSamplers[(smooth ? 1 : 0) | (repeated ? 2 : 0) | (mipmapped ? 4 : 0)];
+    if (!sampler)
+    {
+        GLint minFilter = mipmapped ? (smooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR) : (smooth ? GL_LINEAR : GL_NEAREST);
+        glCheck(glGenSamplers(1, &sampler));
+        glCheck(glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, repeated ? GL_REPEAT : GL_CLAMP_TO_EDGE));
+        glCheck(glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, repeated ? GL_REPEAT : GL_CLAMP_TO_EDGE));
+        glCheck(glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, smooth ? GL_LINEAR : GL_NEAREST));
+        glCheck(glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, minFilter));
+    }
+
+    return sampler;
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::bindFramebuffer(GLenum target, GLuint frameBuffer)
+{
+    bool read = (target != GL_DRAW_FRAMEBUFFER) && (m_readFramebuffer != frameBuffer);
+    bool draw = (target != GL_READ_FRAMEBUFFER) && (m_drawFramebuffer != frameBuffer);
+
+    if (read || draw)
+    {
+        glCheck(glBindFramebuffer(target, frameBuffer));
+
+        if (target != GL_DRAW_FRAMEBUFFER)
+            m_readFramebuffer = frameBuffer;
+
+        if (target != GL_READ_FRAMEBUFFER)
+            m_drawFramebuffer = frameBuffer;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::setEnabled(GLenum capability, bool enabled)
+{
+    int slot = capabilitySlot(capability);
+
+    if ((slot < 0) || (m_capabilities[slot] != static_cast<int>(enabled)))
+    {
+        if (enabled)
+            glCheck(glEnable(capability));
+        else
+            glCheck(glDisable(capability));
+
+        if (slot >= 0)
+            m_capabilities[slot] = static_cast<int>(enabled);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool GLStateCache::isEnabled(GLenum capability)
+{
+    int slot = capabilitySlot(capability);
+
+    if ((slot >= 0) && (m_capabilities[slot] >= 0))
+        return m_capabilities[slot] != 0;
+
+    GLboolean enabled = GL_FALSE;
+    glCheck(enabled = glIsEnabled(capability));
+
+    if (slot >= 0)
+        m_capabilities[slot] = (enabled == GL_TRUE) ? 1 : 0;
+
+    return enabled == GL_TRUE;
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    if ((m_viewport[0] == x) && (m_viewport[1] == y) && (m_viewport[2] == width) && (m_viewport[3] == height))
+        return;
+
+    glCheck(glViewport(x, y, width, height));
+
+    m_viewport[0] = x;
+    m_viewport[1] = y;
+    m_viewport[2] = width;
+    m_viewport[3] = height;
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::scissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    if ((m_scissor[0] == x) && (m_scissor[1] == y) && (m_scissor[2] == width) && (m_scissor[3] == height))
+        return;
+
+    glCheck(glScissor(x, y, width, height));
+
+    m_scissor[0] = x;
+    m_scissor[1] = y;
+    m_scissor[2] = width;
+    m_scissor[3] = height;
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::blendFunc(GLenum colorSrc, GLenum colorDst, GLenum alphaSrc, GLenum alphaDst)
+{
+    if ((m_blendFunc[0] == colorSrc) && (m_blendFunc[1] == colorDst) &&
+        (m_blendFunc[2] == alphaSrc) && (m_blendFunc[3] == alphaDst))
+        return;
+
+    // Fall back to the non-separate version if necessary
+    if (GLAD_GL_EXT_blend_func_separate)
+    {
+        glCheck(glBlendFuncSeparate(colorSrc, colorDst, alphaSrc, alphaDst));
+    }
+    else
+    {
+        glCheck(glBlendFunc(colorSrc, colorDst));
+        alphaSrc = colorSrc;
+        alphaDst = colorDst;
+    }
+
+    ++getRenderStats().blendChanges;
+
+    m_blendFunc[0] = colorSrc;
+    m_blendFunc[1] = colorDst;
+    m_blendFunc[2] = alphaSrc;
+    m_blendFunc[3] = alphaDst;
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::blendEquation(GLenum color, GLenum alpha)
+{
+    if ((m_blendEquation[0] == color) && (m_blendEquation[1] == alpha))
+        return;
+
+    // Fall back to the non-separate version if necessary
+    if (GLAD_GL_EXT_blend_equation_separate)
+    {
+        glCheck(glBlendEquationSeparate(color, alpha));
+    }
+    else
+    {
+        glCheck(glBlendEquation(color));
+        alpha = color;
+    }
+
+    ++getRenderStats().blendChanges;
+
+    m_blendEquation[0] = color;
+    m_blendEquation[1] = alpha;
+}
+
+
+////////////////////////////////////////////////////////////
+GLuint GLStateCache::getProgram()
+{
+    if (m_program == unknown)
+        m_program = queryBinding(GL_CURRENT_PROGRAM);
+
+    return m_program;
+}
+
+
+////////////////////////////////////////////////////////////
+GLuint GLStateCache::getVertexArray()
+{
+    if (m_vertexArray == unknown)
+        m_vertexArray = queryBinding(GL_VERTEX_ARRAY_BINDING);
+
+    return m_vertexArray;
+}
+
+
+////////////////////////////////////////////////////////////
+GLuint GLStateCache::getBuffer(GLenum target)
+{
+    int slot = bufferSlot(target);
+
+    if (slot < 0)
+        return 0;
+
+    if (m_buffers[slot] == unknown)
+        m_buffers[slot] = queryBinding(bufferBindings[slot]);
+
+    return m_buffers[slot];
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int GLStateCache::getActiveTexture()
+{
+    if (m_activeTexture == unknown)
+        m_activeTexture = queryBinding(GL_ACTIVE_TEXTURE) - GL_TEXTURE0;
+
+    return m_activeTexture;
+}
+
+
+////////////////////////////////////////////////////////////
+GLuint GLStateCache::getTexture()
+{
+    unsigned int unit = getActiveTexture();
+
+    if (unit >= MaxTextureUnits)
+        return queryBinding(GL_TEXTURE_BINDING_2D);
+
+    if (m_textures[unit] == unknown)
+        m_textures[unit] = queryBinding(GL_TEXTURE_BINDING_2D);
+
+    return m_textures[unit];
+}
+
+
+////////////////////////////////////////////////////////////
+GLuint GLStateCache::getFramebuffer(GLenum target)
+{
+    if (target == GL_READ_FRAMEBUFFER)
+    {
+        if (m_readFramebuffer == unknown)
+            m_readFramebuffer = queryBinding(GL_READ_FRAMEBUFFER_BINDING);
+
+        return m_readFramebuffer;
+    }
+
+    if (m_drawFramebuffer == unknown)
+        m_drawFramebuffer = queryBinding(GL_FRAMEBUFFER_BINDING);
+
+    return m_drawFramebuffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::deleteProgram(GLuint program)
+{
+    if (!program)
+        return;
+
+    glCheck(glDeleteProgram(program));
+
+    // A deleted program stays in use until another one is bound,
+    // its name may be recycled in the meantime
+    if (m_program == program)
+        m_program = unknown;
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::deleteVertexArray(GLuint vertexArray)
+{
+    if (!vertexArray)
+        return;
+
+    glCheck(SFML_GL_EXT_glDeleteVertexArrays(1, &vertexArray));
+
+    if (m_vertexArray == vertexArray)
+    {
+        m_vertexArray = 0;
+        m_buffers[bufferSlot(GL_ELEMENT_ARRAY_BUFFER)] = unknown;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::deleteBuffer(GLuint buffer)
+{
+    if (!buffer)
+        return;
+
+    glCheck(glDeleteBuffers(1, &buffer));
+
+    for (int i = 0; i < BufferTargetCount; ++i)
+    {
+        if (m_buffers[i] == buffer)
+            m_buffers[i] = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::deleteTexture(GLuint texture)
+{
+    if (!texture)
+        return;
+
+    glCheck(glDeleteTextures(1, &texture));
+
+    for (int i = 0; i < MaxTextureUnits; ++i)
+    {
+        if (m_textures[i] == texture)
+            m_textures[i] = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::deleteFramebuffer(GLuint frameBuffer)
+{
+    if (!frameBuffer)
+        return;
+
+    glCheck(glDeleteFramebuffers(1, &frameBuffer));
+
+    if (m_readFramebuffer == frameBuffer)
+        m_readFramebuffer = 0;
+
+    if (m_drawFramebuffer == frameBuffer)
+        m_drawFramebuffer = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+int GLStateCache::bufferSlot(GLenum target)
+{
+    for (int i = 0; i < BufferTargetCount; ++i)
+    {
+        if (bufferTargets[i] == target)
+            return i;
+    }
+
+    return -1;
+}
+
+
+////////////////////////////////////////////////////////////
+int GLStateCache::capabilitySlot(GLenum capability)
+{
+    switch (capability)
+    {
+        case GL_BLEND:        return 0;
+        case GL_CULL_FACE:    return 1;
+        case GL_DEPTH_TEST:   return 2;
+        case GL_SCISSOR_TEST: return 3;
+        case GL_STENCIL_TEST: return 4;
+        default:              return -1;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GLStateCache::deleteSamplers()
+{
+    for (int i = 0; i < SamplerCount; ++i)
+    {
+        if (m_sharedSamplers[i])
+            glCheck(glDeleteSamplers(1, &m_sharedSamplers[i]));
+
+        m_sharedSamplers[i] = 0;
+    }
+
+    for (int i = 0; i < MaxTextureUnits; ++i)
+        m_samplers[i] = unknown;
+}
+
+
+////////////////////////////////////////////////////////////
+GLStateCache& getGLStateCache()
+{
+    void* context = getCurrentContext();
+    unsigned int generation = cacheGeneration.load(std::memory_order_acquire);
+    if (threadCache && (threadContext == context) && (threadGeneration == generation))
+        return *threadCache;
+
+    Lock lock(cacheMutex);
+
+    GLStateCache*& cache = caches[context];
+    if (!cache)
+        cache = new GLStateCache;
+
+    threadContext = context;
+    threadCache = cache;
+    threadGeneration = generation;
+
+    return *cache;
+}
+
+
+////////////////////////////////////////////////////////////
+void releaseGLStateCache()
+{
+    Lock lock(cacheMutex);
+
+    std::map<void*, GLStateCache*>::iterator it = caches.find(getCurrentContext());
+    if (it == caches.end())
+        return;
+
+    it->second->deleteSamplers();
+    delete it->second;
+    caches.erase(it);
+
+    // Another context may be created at the same address
+    cacheGeneration.fetch_add(1, std::memory_order_release);
+}
+
+
+////////////////////////////////////////////////////////////
+void forgetGLStateCaches()
+{
+    Lock lock(cacheMutex);
+
+    for (std::map<void*, GLStateCache*>::iterator it = caches.begin(); it != caches.end(); ++it)
+        delete it->second;
+    caches.clear();
+
+    cacheGeneration.fetch_add(1, std::memory_order_release);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -38,21 +38,21 @@ namespace priv
     ////////////////////////////////////////////////////////////
     void copyMatrix(const Transform& source, Matrix<3, 3>& dest)
     {
-        const float* from = source.getMatrix(); // 4x4
-        float* to = dest.array;                 // 3x3
+        const float* from = source.getAffineMatrix(); // 2x3, row-major
+        float* to = dest.array;                       // 3x3, column-major
 
-        // Use only left-upper 3x3 block (for a 2D transform)
-        to[0] = from[ 0]; to[1] = from[ 1]; to[2] = from[ 3];
-        to[3] = from[ 4]; to[4] = from[ 5]; to[5] = from[ 7];
-        to[6] = from[12]; to[7] = from[13]; to[8] = from[15];
+        // The last row of a 2D transform is always (0, 0, 1)
+        to[0] = from[0]; to[1] = from[3]; to[2] = 0.f;
+        to[3] = from[1]; to[4] = from[4]; to[5] = 0.f;
+        to[6] = from[2]; to[7] = from[5]; to[8] = 1.f;
     }
 
 
     ////////////////////////////////////////////////////////////
     void copyMatrix(const Transform& source, Matrix<4, 4>& dest)
     {
-        // Adopt 4x4 matrix as-is
-        copyMatrix(source.getMatrix(), 4 * 4, dest.array);
+        // Expand the 2x3 matrix
+        source.getMatrix(dest.array);
     }
 
 
@@ -0,0 +1,320 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GlyphRasterizer.hpp>
+#include <SFML/Graphics/FreeTypeLibrary.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_GLYPH_H
+#include FT_OUTLINE_H
+#include FT_BITMAP_H
+#include FT_STROKER_H
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+GlyphRasterizer::GlyphRasterizer() :
+m_library(NULL),
+m_face   (NULL),
+m_stroker(NULL),
+m_busy   (false),
+m_stop   (false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphRasterizer::~GlyphRasterizer()
+{
+    if (m_thread.joinable())
+    {
+        {
+            Lock lock(m_mutex);
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+    }
+
+    {
+        Lock libraryLock(getFreeTypeLibraryMutex());
+
+        if (m_stroker)
+            FT_Stroker_Done(static_cast<FT_Stroker>(m_stroker));
+
+        if (m_face)
+            FT_Done_Face(static_cast<FT_Face>(m_face));
+    }
+
+    if (m_library)
+        releaseFreeTypeLibrary();
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphRasterizer::start(const void* data, std::size_t sizeInBytes)
+{
+    FT_Library library = static_cast<FT_Library>(acquireFreeTypeLibrary());
+    if (!library)
+    {
+        err() << "Failed to start the glyph rasterizer (failed to initialize FreeType)" << std::endl;
+        return false;
+    }
+    m_library = library;
+
+    Lock libraryLock(getFreeTypeLibraryMutex());
+
+    FT_Face face;
+    if (FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(data), static_cast<FT_Long>(sizeInBytes), 0, &face) != 0)
+    {
+        err() << "Failed to start the glyph rasterizer (failed to create the font face)" << std::endl;
+        return false;
+    }
+    m_face = face;
+
+    FT_Stroker stroker;
+    if (FT_Stroker_New(library, &stroker) != 0)
+    {
+        err() << "Failed to start the glyph rasterizer (failed to create the stroker)" << std::endl;
+        return false;
+    }
+    m_stroker = stroker;
+
+    if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0)
+    {
+        err() << "Failed to start the glyph rasterizer (failed to set the Unicode character set)" << std::endl;
+        return false;
+    }
+
+    m_thread = std::thread(&GlyphRasterizer::run, this);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::push(const Request& request)
+{
+    {
+        Lock lock(m_mutex);
+        m_requests.push_back(request);
+    }
+    m_condition.notify_all();
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::collect(std::vector<Result>& results, bool wait)
+{
+    Lock lock(m_mutex);
+
+    while (wait && (m_busy || !m_requests.empty()))
+        m_condition.wait(m_mutex);
+
+    results.swap(m_results);
+    m_results.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphRasterizer::run()
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+
+    Lock lock(m_mutex);
+    for (;;)
+    {
+        while (!m_stop && m_requests.empty())
+            m_condition.wait(m_mutex);
+
+        if (m_stop)
+            return;
+
+        Result result;
+        result.request = m_requests.front();
+        m_requests.pop_front();
+        m_busy = true;
+
+        // Rasterize without holding the lock, so that requests can be queued meanwhile
+        m_mutex.unlock();
+        if (face->size->metrics.x_ppem != result.request.characterSize)
+            FT_Set_Pixel_Sizes(face, 0, result.request.characterSize);
+        rasterize(m_library, m_face, m_stroker, result.request.index, result.request.bold, result.request.outlineThickness, result.request.distanceField, result.bitmap);
+        m_mutex.lock();
+
+        m_results.push_back(result);
+        m_busy = false;
+        m_condition.notify_all();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphRasterizer::rasterize(void* library, void* face, void* stroker, Uint32 index, bool bold, float outlineThickness, bool distanceField, GlyphBitmap& bitmap)
+{
+    FT_Face ftFace = static_cast<FT_Face>(face);
+
+    bitmap.glyph  = Glyph();
+    bitmap.width  = 0;
+    bitmap.height = 0;
+    bitmap.pixels.clear();
+
+    // Load the glyph corresponding to the index, distance fields
+    // are scaled to other sizes so they must not be hinted for this one
+    FT_Int32 flags = distanceField ? FT_LOAD_NO_HINTING : (FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT);
+    if ((outlineThickness != 0) || distanceField)
+        flags |= FT_LOAD_NO_BITMAP;
+    if (FT_Load_Glyph(ftFace, index, flags) != 0)
+        return false;
+
+    // Retrieve the glyph
+    FT_Glyph glyphDesc;
+    if (FT_Get_Glyph(ftFace->glyph, &glyphDesc) != 0)
+        return false;
+
+    // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
+    FT_Pos weight = 1 << 6;
+    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
+    if (outline)
+    {
+        if (bold)
+        {
+            FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+            FT_Outline_Embolden(&outlineGlyph->outline, weight);
+        }
+
+        if (outlineThickness != 0)
+        {
+            FT_Stroker ftStroker = static_cast<FT_Stroker>(stroker);
+
+            FT_Stroker_Set(ftStroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+            FT_Glyph_Stroke(&glyphDesc, ftStroker, true);
+        }
+    }
+
+    // Convert the glyph to a bitmap (i.e. rasterize it)
+    FT_Glyph_To_Bitmap(&glyphDesc, distanceField ? FT_RENDER_MODE_SDF : FT_RENDER_MODE_NORMAL, 0, 1);
+    FT_Bitmap& ftBitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+
+    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
+    if (!outline)
+    {
+        if (bold)
+            FT_Bitmap_Embolden(static_cast<FT_Library>(library), &ftBitmap, weight, weight);
+
+        if (outlineThickness != 0)
+            err() << "Failed to outline glyph (no fallback available)" << std::endl;
+    }
+
+    // Compute the glyph's advance offset
+    Glyph& glyph = bitmap.glyph;
+    glyph.advance = static_cast<float>(ftFace->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
+    if (bold)
+        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+
+    unsigned int width  = ftBitmap.width;
+    unsigned int height = ftBitmap.rows;
+
+    if ((width > 0) && (height > 0))
+    {
+        // Leave a small padding around characters, so that filtering doesn't
+        // pollute them with pixels from neighbors
+        const unsigned int padding = 1;
+
+        width += 2 * padding;
+        height += 2 * padding;
+
+        // Compute the glyph's bounding box
+        if (distanceField)
+        {
+            // The distance field spreads past the outline, the quad must cover all of it
+            // (Text already offsets outlined glyphs by their thickness)
+            FT_BitmapGlyph bitmapGlyph = reinterpret_cast<FT_BitmapGlyph>(glyphDesc);
+            glyph.bounds.left   =  static_cast<float>(bitmapGlyph->left) + outlineThickness;
+            glyph.bounds.top    = -static_cast<float>(bitmapGlyph->top) + outlineThickness;
+            glyph.bounds.width  =  static_cast<float>(ftBitmap.width);
+            glyph.bounds.height =  static_cast<float>(ftBitmap.rows);
+        }
+        else
+        {
+            glyph.bounds.left   =  static_cast<float>(ftFace->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
+            glyph.bounds.top    = -static_cast<float>(ftFace->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
+            glyph.bounds.width  =  static_cast<float>(ftFace->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
+            glyph.bounds.height =  static_cast<float>(ftFace->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
+        }
+
+        // Resize the pixel buffer to the new size and fill it with transparent pixels
+        bitmap.width  = width;
+        bitmap.height = height;
+        bitmap.pixels.assign(width * height, 0);
+
+        // Extract the glyph's coverage from the bitmap
+        const Uint8* pixels = ftBitmap.buffer;
+        if (ftBitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+        {
+            // Pixels are 1 bit monochrome values
+            for (unsigned int y = padding; y < height - padding; ++y)
+            {
+                for (unsigned int x = padding; x < width - padding; ++x)
+                {
+                    std::size_t pixel = x + y * width;
+                    bitmap.pixels[pixel] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
+                }
+                pixels += ftBitmap.pitch;
+            }
+        }
+        else
+        {
+            // Pixels are 8 bits gray levels
+            for (unsigned int y = padding; y < height - padding; ++y)
+            {
+                for (unsigned int x = padding; x < width - padding; ++x)
+                {
+                    std::size_t pixel = x + y * width;
+                    bitmap.pixels[pixel] = pixels[x - padding];
+                }
+                pixels += ftBitmap.pitch;
+            }
+        }
+    }
+
+    // Delete the FT glyph
+    FT_Done_Glyph(glyphDesc);
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
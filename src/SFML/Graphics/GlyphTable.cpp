@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GlyphTable.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Mix the bits of a key, glyph indices of a text are mostly consecutive
+    std::size_t hashKey(sf::Uint64 key)
+    {
+        key ^= key >> 31;
+        key *= 0xBF58476D1CE4E5B9ULL;
+        key ^= key >> 29;
+        return static_cast<std::size_t>(key);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+GlyphTable::GlyphTable() :
+m_entries(),
+m_slots  ()
+{
+    std::fill(m_recent, m_recent + RecentCount, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphTable::Entry* GlyphTable::find(Uint64 key)
+{
+    // Fast path: same characters are requested over and over
+    Uint32& recent = m_recent[key % RecentCount];
+    if (recent && (m_entries[recent - 1].key == key))
+        return &m_entries[recent - 1];
+
+    if (m_slots.empty())
+        return NULL;
+
+    std::size_t mask = m_slots.size() - 1;
+    for (std::size_t slot = hashKey(key) & mask; m_slots[slot]; slot = (slot + 1) & mask)
+    {
+        Entry& entry = m_entries[m_slots[slot] - 1];
+        if (entry.key == key)
+        {
+            recent = m_slots[slot];
+            return &entry;
+        }
+    }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphTable::Entry& GlyphTable::insert(Uint64 key, Uint32 index, const Glyph& glyph, Uint64 frame)
+{
+    m_entries.push_back(Entry(key, index, glyph, frame));
+
+    // Keep the table at most half full, so that probe sequences stay short
+    if (m_entries.size() * 2 > m_slots.size())
+    {
+        rehash(std::max<std::size_t>(m_slots.size() * 2, 64));
+    }
+    else
+    {
+        std::size_t mask = m_slots.size() - 1;
+        std::size_t slot = hashKey(key) & mask;
+        while (m_slots[slot])
+            slot = (slot + 1) & mask;
+
+        m_slots[slot] = static_cast<Uint32>(m_entries.size());
+    }
+
+    m_recent[key % RecentCount] = static_cast<Uint32>(m_entries.size());
+
+    return m_entries.back();
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlyphTable::removeOlderThan(Uint64 frame)
+{
+    std::deque<Entry> kept;
+    for (Iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->lastUsedFrame >= frame)
+            kept.push_back(*it);
+    }
+
+    if (kept.size() == m_entries.size())
+        return false;
+
+    m_entries.swap(kept);
+    rehash(m_slots.size());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphTable::Iterator GlyphTable::begin()
+{
+    return m_entries.begin();
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphTable::Iterator GlyphTable::end()
+{
+    return m_entries.end();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 GlyphTable::getMemoryUsage() const
+{
+    return m_entries.size() * sizeof(Entry) + m_slots.capacity() * sizeof(Uint32);
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphTable::rehash(std::size_t slotCount)
+{
+    m_slots.assign(slotCount, 0);
+    std::fill(m_recent, m_recent + RecentCount, 0);
+
+    std::size_t mask = slotCount - 1;
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        std::size_t slot = hashKey(m_entries[i].key) & mask;
+        while (m_slots[slot])
+            slot = (slot + 1) & mask;
+
+        m_slots[slot] = static_cast<Uint32>(i + 1);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
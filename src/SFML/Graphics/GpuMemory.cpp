@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+
+
+namespace
+{
+    // Resources can be created by loading threads, with their own context
+    sf::Mutex memoryMutex;
+
+    sf::Uint64 usage[sf::GpuMemory::CategoryCount] = {0};
+    sf::Uint64 totalUsage = 0;
+    sf::Uint64 budget = 0;
+    sf::GpuMemory::BudgetCallback budgetCallback = NULL;
+    void* budgetUserData = NULL;
+    bool inBudgetCallback = false;
+
+    sf::Uint64 currentFrame = 0;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Uint64 GpuMemory::getUsage(Category category)
+{
+    Lock lock(memoryMutex);
+
+    return usage[category];
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 GpuMemory::getTotalUsage()
+{
+    Lock lock(memoryMutex);
+
+    return totalUsage;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuMemory::setBudget(Uint64 bytes, BudgetCallback callback, void* userData)
+{
+    Lock lock(memoryMutex);
+
+    budget = bytes;
+    budgetCallback = callback;
+    budgetUserData = userData;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 GpuMemory::getBudget()
+{
+    Lock lock(memoryMutex);
+
+    return budget;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 GpuMemory::getCurrentFrame()
+{
+    return currentFrame;
+}
+
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void trackGpuMemory(GpuMemory::Category category, Uint64 oldSize, Uint64 newSize)
+{
+    if (oldSize == newSize)
+        return;
+
+    GpuMemory::BudgetCallback callback = NULL;
+    void* userData = NULL;
+    Uint64 total = 0;
+    Uint64 limit = 0;
+
+    {
+        Lock lock(memoryMutex);
+
+        usage[category] = usage[category] - oldSize + newSize;
+        totalUsage = totalUsage - oldSize + newSize;
+
+        // Only allocations can push the usage over the budget
+        if ((newSize > oldSize) && budget && (totalUsage > budget) && budgetCallback && !inBudgetCallback)
+        {
+            callback = budgetCallback;
+            userData = budgetUserData;
+            total = totalUsage;
+            limit = budget;
+            inBudgetCallback = true;
+        }
+    }
+
+    // Call the user outside of the lock, so that it can release resources
+    if (callback)
+    {
+        callback(total, limit, userData);
+
+        Lock lock(memoryMutex);
+        inBudgetCallback = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void advanceGpuMemoryFrame()
+{
+    ++currentFrame;
+}
+
+
+////////////////////////////////////////////////////////////
+void markTextureUsed(const Texture& texture)
+{
+    texture.m_lastUsedFrame = currentFrame;
+}
+
+} // namespace priv
+
+} // namespace sf
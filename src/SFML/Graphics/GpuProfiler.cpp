@@ -0,0 +1,287 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GpuProfiler.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    // Profiler measuring the scopes
+    sf::GpuProfiler* activeProfiler = nullptr;
+
+    // Frames kept waiting for their results before being dropped
+    const std::size_t MaxPendingFrames = 4;
+
+    // Marks a scope begun while the profiler can't measure
+    const std::size_t ignoredScope = static_cast<std::size_t>(-1);
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GpuProfiler::Scope::Scope(const char* name) :
+m_profiler(activeProfiler)
+{
+    if (m_profiler)
+        m_profiler->begin(name);
+}
+
+
+////////////////////////////////////////////////////////////
+GpuProfiler::Scope::~Scope()
+{
+    if (m_profiler)
+        m_profiler->end();
+}
+
+
+////////////////////////////////////////////////////////////
+GpuProfiler::GpuProfiler() :
+m_current(),
+m_pending(),
+m_stack  (),
+m_queries(),
+m_results()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GpuProfiler::~GpuProfiler()
+{
+    setActive(false);
+
+    if (!isAvailable())
+        return;
+
+    for (std::size_t i = 0; i < m_pending.size(); ++i)
+        recycle(m_pending[i]);
+
+    recycle(m_current);
+
+    if (!m_queries.empty())
+        glCheck(SFML_GL_EXT_glDeleteQueries(static_cast<GLsizei>(m_queries.size()), &m_queries[0]));
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuProfiler::isAvailable()
+{
+    return priv::getGraphicsCaps().timerQueries;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::setActive(bool active)
+{
+    if (active)
+        activeProfiler = this;
+    else if (activeProfiler == this)
+        activeProfiler = nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+GpuProfiler* GpuProfiler::getActive()
+{
+    return activeProfiler;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::begin(const char* name)
+{
+    if (!isAvailable())
+    {
+        m_stack.push_back(ignoredScope);
+        return;
+    }
+
+    // Only one elapsed time query can run at a time: interrupt the enclosing scope
+    if (!m_stack.empty())
+        glCheck(SFML_GL_EXT_glEndQuery(GL_TIME_ELAPSED));
+
+    Record record;
+    record.name   = name;
+    record.parent = m_stack.empty() ? ignoredScope : m_stack.back();
+    record.depth  = static_cast<unsigned int>(m_stack.size());
+
+    m_current.records.push_back(record);
+    m_stack.push_back(m_current.records.size() - 1);
+
+    beginSegment(m_stack.back());
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::end()
+{
+    if (m_stack.empty())
+    {
+        err() << "GpuProfiler::end called without a matching call to begin" << std::endl;
+        return;
+    }
+
+    std::size_t record = m_stack.back();
+    m_stack.pop_back();
+
+    if (record == ignoredScope)
+        return;
+
+    glCheck(SFML_GL_EXT_glEndQuery(GL_TIME_ELAPSED));
+
+    // Resume the enclosing scope
+    if (!m_stack.empty())
+        beginSegment(m_stack.back());
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::frame()
+{
+    if (!m_stack.empty())
+    {
+        err() << "GpuProfiler::frame called with unterminated scopes" << std::endl;
+
+        while (!m_stack.empty())
+            end();
+    }
+
+    if (!isAvailable())
+        return;
+
+    m_pending.push_back(Frame());
+    m_pending.back().records.swap(m_current.records);
+    m_pending.back().segments.swap(m_current.segments);
+
+#if defined(SFML_OPENGL_ES)
+    // The results of all the running queries are meaningless after a disjoint operation
+    GLint disjoint = 0;
+    glCheck(glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint));
+
+    if (disjoint)
+    {
+        for (std::size_t i = 0; i < m_pending.size(); ++i)
+            recycle(m_pending[i]);
+
+        m_pending.clear();
+        return;
+    }
+#endif
+
+    // Collect the frames that the GPU has finished, oldest first
+    while (!m_pending.empty())
+    {
+        Frame& oldest = m_pending.front();
+
+        if (!oldest.segments.empty())
+        {
+            GLuint available = 0;
+            glCheck(SFML_GL_EXT_glGetQueryObjectuiv(oldest.segments.back().query, GL_QUERY_RESULT_AVAILABLE, &available));
+
+            if (!available)
+                break;
+        }
+
+        std::vector<GLuint64> times(oldest.records.size(), 0);
+
+        for (std::size_t i = 0; i < oldest.segments.size(); ++i)
+        {
+            GLuint64 elapsed = 0;
+            glCheck(SFML_GL_EXT_glGetQueryObjectui64v(oldest.segments[i].query, GL_QUERY_RESULT, &elapsed));
+
+            // The time of a scope includes the time of its nested scopes
+            for (std::size_t record = oldest.segments[i].record; record != ignoredScope; record = oldest.records[record].parent)
+                times[record] += elapsed;
+        }
+
+        m_results.resize(oldest.records.size());
+
+        for (std::size_t i = 0; i < oldest.records.size(); ++i)
+        {
+            m_results[i].name  = oldest.records[i].name;
+            m_results[i].depth = oldest.records[i].depth;
+            m_results[i].time  = microseconds(static_cast<Int64>(times[i] / 1000));
+        }
+
+        recycle(oldest);
+        m_pending.erase(m_pending.begin());
+    }
+
+    // Don't let the GPU lag behind forever
+    while (m_pending.size() > MaxPendingFrames)
+    {
+        recycle(m_pending.front());
+        m_pending.erase(m_pending.begin());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<GpuProfiler::Result>& GpuProfiler::getResults() const
+{
+    return m_results;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::beginSegment(std::size_t record)
+{
+    GLuint query = 0;
+
+    if (m_queries.empty())
+    {
+        glCheck(SFML_GL_EXT_glGenQueries(1, &query));
+    }
+    else
+    {
+        query = m_queries.back();
+        m_queries.pop_back();
+    }
+
+    glCheck(SFML_GL_EXT_glBeginQuery(GL_TIME_ELAPSED, query));
+
+    Segment segment = {query, record};
+    m_current.segments.push_back(segment);
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::recycle(Frame& frame)
+{
+    for (std::size_t i = 0; i < frame.segments.size(); ++i)
+        m_queries.push_back(frame.segments[i].query);
+
+    frame.segments.clear();
+    frame.records.clear();
+}
+
+} // namespace sf
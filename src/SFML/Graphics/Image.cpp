@@ -27,18 +27,417 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageView.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/JobSystem.hpp>
 #include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <functional>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_IMAGE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_IMAGE_NEON
+#elif defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define SFML_IMAGE_WASM
+#endif
+
+
+namespace
+{
+    // Pixels are processed as 32-bit words (through memcpy, which compiles to plain
+    // loads and stores), so that the loops stay simple enough for the compiler to vectorize
+    sf::Uint32 packPixel(const sf::Color& color)
+    {
+        const sf::Uint8 components[4] = {color.r, color.g, color.b, color.a};
+        sf::Uint32 pixel;
+        std::memcpy(&pixel, components, sizeof(pixel));
+        return pixel;
+    }
+
+    // Pixels scanned between two checks of the accumulated alphas, to stop
+    // early on transparent images without testing every vector
+    const std::size_t opaqueScanBlock = 1024;
+
+    // Exact integer division by 255 of a product of two components, rounding down
+    sf::Uint32 divide255(sf::Uint32 x)
+    {
+        return (x + (x >> 8) + 1) >> 8;
+    }
+
+    // Expand the channels of 16-bit pixels to 8 bits, the high bits are repeated in the
+    // low ones so that the extremes map to 0 and 255 (and dropping the low bits is exact)
+    void expandRgb565(sf::Uint16 word, sf::Uint8* pixel)
+    {
+        sf::Uint32 r = (word >> 11) & 0x1F;
+        sf::Uint32 g = (word >> 5) & 0x3F;
+        sf::Uint32 b = word & 0x1F;
+        pixel[0] = static_cast<sf::Uint8>((r << 3) | (r >> 2));
+        pixel[1] = static_cast<sf::Uint8>((g << 2) | (g >> 4));
+        pixel[2] = static_cast<sf::Uint8>((b << 3) | (b >> 2));
+        pixel[3] = 255;
+    }
+
+    void expandRgba4444(sf::Uint16 word, sf::Uint8* pixel)
+    {
+        pixel[0] = static_cast<sf::Uint8>(((word >> 12) & 0xF) * 17);
+        pixel[1] = static_cast<sf::Uint8>(((word >> 8) & 0xF) * 17);
+        pixel[2] = static_cast<sf::Uint8>(((word >> 4) & 0xF) * 17);
+        pixel[3] = static_cast<sf::Uint8>((word & 0xF) * 17);
+    }
+
+    // Filter kernels of the resampling, as functions of the distance to the
+    // center of the destination pixel (in destination pixels when minifying)
+    const float kaiserRadius  = 3.f;
+    const float kaiserAlpha   = 4.f;
+    const float lanczosRadius = 3.f;
+    const float pi            = 3.141592654f;
+
+    float besselI0(float x)
+    {
+        // Power series of the modified Bessel function of the first kind, order 0
+        float sum  = 1.f;
+        float term = 1.f;
+        for (int k = 1; k < 16; ++k)
+        {
+            term *= (x / (2.f * k)) * (x / (2.f * k));
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    float sinc(float x)
+    {
+        return (x < 1e-5f) ? 1.f : std::sin(pi * x) / (pi * x);
+    }
+
+    float boxKernel(float x)
+    {
+        return (x < 0.5f) ? 1.f : ((x == 0.5f) ? 0.5f : 0.f);
+    }
+
+    float bilinearKernel(float x)
+    {
+        return (x < 1.f) ? 1.f - x : 0.f;
+    }
+
+    float kaiserKernel(float x)
+    {
+        if (x >= kaiserRadius)
+            return 0.f;
+
+        float ratio = x / kaiserRadius;
+        return sinc(x) * besselI0(kaiserAlpha * std::sqrt(1.f - ratio * ratio)) / besselI0(kaiserAlpha);
+    }
+
+    float lanczosKernel(float x)
+    {
+        return (x < lanczosRadius) ? sinc(x) * sinc(x / lanczosRadius) : 0.f;
+    }
+
+    float getKernelRadius(sf::Image::ResampleFilter filter)
+    {
+        switch (filter)
+        {
+            default:
+            case sf::Image::BoxFilter:      return 0.5f;
+            case sf::Image::BilinearFilter: return 1.f;
+            case sf::Image::KaiserFilter:   return kaiserRadius;
+            case sf::Image::LanczosFilter:  return lanczosRadius;
+        }
+    }
+
+    float evaluateKernel(sf::Image::ResampleFilter filter, float x)
+    {
+        x = std::fabs(x);
+        switch (filter)
+        {
+            default:
+            case sf::Image::BoxFilter:      return boxKernel(x);
+            case sf::Image::BilinearFilter: return bilinearKernel(x);
+            case sf::Image::KaiserFilter:   return kaiserKernel(x);
+            case sf::Image::LanczosFilter:  return lanczosKernel(x);
+        }
+    }
+
+    // Source pixels and weights contributing to each destination pixel along one axis,
+    // with the indices clamped to the edges of the source
+    struct Contributions
+    {
+        std::vector<std::size_t> offsets; // Start of the taps of each destination pixel (plus the end)
+        std::vector<unsigned int> indices;
+        std::vector<float> weights;
+    };
+
+    void computeContributions(unsigned int sourceSize, unsigned int destSize, sf::Image::ResampleFilter filter, Contributions& contributions)
+    {
+        // The kernel is stretched when minifying, so that it covers all the source pixels;
+        // when magnifying it is evaluated in source pixels (box then means nearest)
+        float scale       = static_cast<float>(sourceSize) / destSize;
+        float filterScale = std::max(scale, 1.f);
+        float radius      = getKernelRadius(filter) * filterScale;
+
+        contributions.offsets.assign(1, 0);
+        contributions.indices.clear();
+        contributions.weights.clear();
+
+        for (unsigned int i = 0; i < destSize; ++i)
+        {
+            float center = (i + 0.5f) * scale;
+            int first = static_cast<int>(std::floor(center - radius));
+            int last  = static_cast<int>(std::ceil(center + radius));
+
+            std::size_t begin = contributions.weights.size();
+            float total = 0.f;
+            for (int j = first; j <= last; ++j)
+            {
+                float weight = evaluateKernel(filter, (j + 0.5f - center) / filterScale);
+                if (weight == 0.f)
+                    continue;
+
+                int index = std::min(std::max(j, 0), static_cast<int>(sourceSize) - 1);
+                contributions.indices.push_back(static_cast<unsigned int>(index));
+                contributions.weights.push_back(weight);
+                total += weight;
+            }
+
+            // Magnifying with a box lands on pixel edges, where the taps can all be zero
+            if (contributions.weights.size() == begin)
+            {
+                int index = std::min(static_cast<int>(center), static_cast<int>(sourceSize) - 1);
+                contributions.indices.push_back(static_cast<unsigned int>(index));
+                contributions.weights.push_back(1.f);
+                total = 1.f;
+            }
+
+            for (std::size_t k = begin; k < contributions.weights.size(); ++k)
+                contributions.weights[k] /= total;
+
+            contributions.offsets.push_back(contributions.weights.size());
+        }
+    }
+
+    // Weighted sum of the RGBA pixels of a row (one vector per pixel)
+    void filterPixel(const float* source, const unsigned int* indices, const float* weights, std::size_t count, float* dest)
+    {
+#if defined(SFML_IMAGE_SSE2)
+
+        __m128 sum = _mm_setzero_ps();
+        for (std::size_t k = 0; k < count; ++k)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(source + indices[k] * 4), _mm_set1_ps(weights[k])));
+        _mm_storeu_ps(dest, sum);
+
+#elif defined(SFML_IMAGE_NEON)
+
+        float32x4_t sum = vdupq_n_f32(0.f);
+        for (std::size_t k = 0; k < count; ++k)
+            sum = vmlaq_n_f32(sum, vld1q_f32(source + indices[k] * 4), weights[k]);
+        vst1q_f32(dest, sum);
+
+#elif defined(SFML_IMAGE_WASM)
+
+        v128_t sum = wasm_f32x4_splat(0.f);
+        for (std::size_t k = 0; k < count; ++k)
+            sum = wasm_f32x4_add(sum, wasm_f32x4_mul(wasm_v128_load(source + indices[k] * 4), wasm_f32x4_splat(weights[k])));
+        wasm_v128_store(dest, sum);
+
+#else
+
+        float sum[4] = {0.f, 0.f, 0.f, 0.f};
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            const float* pixel = source + indices[k] * 4;
+            sum[0] += pixel[0] * weights[k];
+            sum[1] += pixel[1] * weights[k];
+            sum[2] += pixel[2] * weights[k];
+            sum[3] += pixel[3] * weights[k];
+        }
+        std::memcpy(dest, sum, sizeof(sum));
+
+#endif
+    }
+
+    // Add a weighted row to another one, the size is a multiple of 4 (whole pixels)
+    void accumulateRow(float* dest, const float* source, float weight, std::size_t size)
+    {
+#if defined(SFML_IMAGE_SSE2)
+
+        const __m128 factor = _mm_set1_ps(weight);
+        for (std::size_t i = 0; i < size; i += 4)
+            _mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(_mm_loadu_ps(source + i), factor)));
+
+#elif defined(SFML_IMAGE_NEON)
+
+        for (std::size_t i = 0; i < size; i += 4)
+            vst1q_f32(dest + i, vmlaq_n_f32(vld1q_f32(dest + i), vld1q_f32(source + i), weight));
+
+#elif defined(SFML_IMAGE_WASM)
+
+        const v128_t factor = wasm_f32x4_splat(weight);
+        for (std::size_t i = 0; i < size; i += 4)
+            wasm_v128_store(dest + i, wasm_f32x4_add(wasm_v128_load(dest + i), wasm_f32x4_mul(wasm_v128_load(source + i), factor)));
+
+#else
+
+        for (std::size_t i = 0; i < size; ++i)
+            dest[i] += source[i] * weight;
+
+#endif
+    }
+
+    // Split [0, count) into contiguous ranges processed by up to threadCount threads of the
+    // job scheduler, the calling thread being one of them
+    void parallelFor(unsigned int count, unsigned int threadCount, const std::function<void(unsigned int, unsigned int)>& work)
+    {
+        if (threadCount == 1)
+        {
+            work(0, count);
+            return;
+        }
+
+        // Don't bother waking threads for less than a few rows each
+        const unsigned int minRowsPerThread = 16;
+        std::size_t grain = minRowsPerThread;
+        if (threadCount > 1)
+            grain = std::max<std::size_t>(grain, (count + threadCount - 1) / threadCount);
+
+        sf::JobSystem::getScheduler().parallelFor(count, grain, [&work](std::size_t begin, std::size_t end)
+        {
+            work(static_cast<unsigned int>(begin), static_cast<unsigned int>(end));
+        });
+    }
+
+    // Separable resampling of RGBA float pixels
+    void resample(const std::vector<float>& source, const sf::Vector2u& sourceSize, std::vector<float>& dest, const sf::Vector2u& destSize,
+                  sf::Image::ResampleFilter filter, unsigned int threadCount, std::vector<float>& rows)
+    {
+        Contributions horizontal;
+        Contributions vertical;
+        computeContributions(sourceSize.x, destSize.x, filter, horizontal);
+        computeContributions(sourceSize.y, destSize.y, filter, vertical);
+
+        // Horizontal pass: (source.x x source.y) -> (dest.x x source.y)
+        std::size_t rowSize = static_cast<std::size_t>(destSize.x) * 4;
+        rows.resize(rowSize * sourceSize.y);
+        parallelFor(sourceSize.y, threadCount, [&](unsigned int begin, unsigned int end)
+        {
+            for (unsigned int y = begin; y < end; ++y)
+            {
+                const float* sourceRow = &source[static_cast<std::size_t>(y) * sourceSize.x * 4];
+                float* destRow = &rows[y * rowSize];
+                for (unsigned int x = 0; x < destSize.x; ++x)
+                {
+                    std::size_t first = horizontal.offsets[x];
+                    std::size_t count = horizontal.offsets[x + 1] - first;
+                    filterPixel(sourceRow, &horizontal.indices[first], &horizontal.weights[first], count, destRow + x * 4);
+                }
+            }
+        });
+
+        // Vertical pass: (dest.x x source.y) -> (dest.x x dest.y), whole rows at a time
+        dest.assign(rowSize * destSize.y, 0.f);
+        parallelFor(destSize.y, threadCount, [&](unsigned int begin, unsigned int end)
+        {
+            for (unsigned int y = begin; y < end; ++y)
+            {
+                float* destRow = &dest[y * rowSize];
+                for (std::size_t k = vertical.offsets[y]; k < vertical.offsets[y + 1]; ++k)
+                    accumulateRow(destRow, &rows[vertical.indices[k] * rowSize], vertical.weights[k], rowSize);
+            }
+        });
+    }
+
+    float srgbToLinear(float value)
+    {
+        return (value <= 0.04045f) ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    float linearToSrgb(float value)
+    {
+        return (value <= 0.0031308f) ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+    }
+
+    // Convert the pixels to floats, with the colors premultiplied by alpha (in linear space
+    // if sRGB), so that transparent pixels don't bleed into their neighbours while filtering
+    void decodePixels(const std::vector<sf::Uint8>& pixels, bool sRgb, std::vector<float>& output)
+    {
+        float decode[256];
+        for (int i = 0; i < 256; ++i)
+            decode[i] = sRgb ? srgbToLinear(i / 255.f) : i / 255.f;
+
+        output.resize(pixels.size());
+        for (std::size_t i = 0; i < pixels.size(); i += 4)
+        {
+            float alpha = pixels[i + 3] / 255.f;
+            output[i + 0] = decode[pixels[i + 0]] * alpha;
+            output[i + 1] = decode[pixels[i + 1]] * alpha;
+            output[i + 2] = decode[pixels[i + 2]] * alpha;
+            output[i + 3] = alpha;
+        }
+    }
+
+    // Convert filtered pixels back to 8 bits (sinc-based filters may overshoot, hence the clamping)
+    void encodePixels(const std::vector<float>& pixels, bool sRgb, std::vector<sf::Uint8>& output)
+    {
+        output.resize(pixels.size());
+        for (std::size_t i = 0; i < pixels.size(); i += 4)
+        {
+            float alpha = std::min(std::max(pixels[i + 3], 0.f), 1.f);
+            for (int c = 0; c < 3; ++c)
+            {
+                float value = (alpha > 0.f) ? std::min(std::max(pixels[i + c] / alpha, 0.f), 1.f) : 0.f;
+                if (sRgb)
+                    value = linearToSrgb(value);
+
+                output[i + c] = static_cast<sf::Uint8>(value * 255.f + 0.5f);
+            }
+
+            output[i + 3] = static_cast<sf::Uint8>(alpha * 255.f + 0.5f);
+        }
+    }
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Image::Image() :
-m_size(0, 0)
+m_size  (0, 0),
+m_pixels(),
+m_format(RGBA8),
+m_memory(MemoryStats::Images)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Image::Image(const Image& copy) :
+m_size  (copy.m_size),
+m_pixels(copy.m_pixels),
+m_format(copy.m_format),
+m_memory(copy.m_memory)
 {
+    m_memory.update(m_pixels.capacity());
+}
 
+
+////////////////////////////////////////////////////////////
+Image::Image(Image&& right) noexcept :
+m_size  (right.m_size),
+m_pixels(std::move(right.m_pixels)),
+m_format(right.m_format),
+m_memory(std::move(right.m_memory))
+{
+    right.m_size = Vector2u(0, 0);
+    right.m_pixels.clear();
+    right.m_format = RGBA8;
 }
 
 
@@ -49,6 +448,37 @@ Image::~Image()
 }
 
 
+////////////////////////////////////////////////////////////
+Image& Image::operator =(const Image& right)
+{
+    m_size   = right.m_size;
+    m_pixels = right.m_pixels;
+    m_format = right.m_format;
+    m_memory.update(m_pixels.capacity());
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Image& Image::operator =(Image&& right) noexcept
+{
+    if (&right != this)
+    {
+        m_size   = right.m_size;
+        m_pixels = std::move(right.m_pixels);
+        m_format = right.m_format;
+        m_memory = std::move(right.m_memory);
+
+        right.m_size = Vector2u(0, 0);
+        right.m_pixels.clear();
+        right.m_format = RGBA8;
+    }
+
+    return *this;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::create(unsigned int width, unsigned int height, const Color& color)
 {
@@ -57,16 +487,14 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
         // Create a new pixel buffer first for exception safety's sake
         std::vector<Uint8> newPixels(width * height * 4);
     
-        // Fill it with the specified color
+        // Fill it with the specified color: write the first pixel, then
+        // keep doubling the filled area by copying it onto the rest
         Uint8* ptr = &newPixels[0];
-        Uint8* end = ptr + newPixels.size();
-        while (ptr < end)
-        {
-            *ptr++ = color.r;
-            *ptr++ = color.g;
-            *ptr++ = color.b;
-            *ptr++ = color.a;
-        }
+        std::size_t size = newPixels.size();
+        Uint32 pixel = packPixel(color);
+        std::memcpy(ptr, &pixel, sizeof(pixel));
+        for (std::size_t filled = sizeof(pixel); filled < size; filled *= 2)
+            std::memcpy(ptr + filled, ptr, std::min(filled, size - filled));
     
         // Commit the new pixel buffer
         m_pixels.swap(newPixels);
@@ -84,6 +512,9 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
         m_size.x = 0;
         m_size.y = 0;
     }
+
+    m_format = RGBA8;
+    m_memory.update(m_pixels.capacity());
 }
 
 
@@ -111,30 +542,84 @@ void Image::create(unsigned int width, unsigned int height, const Uint8* pixels)
         m_size.x = 0;
         m_size.y = 0;
     }
+
+    m_format = RGBA8;
+    m_memory.update(m_pixels.capacity());
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::create(const ImageView& source)
+{
+    if (source.isEmpty())
+    {
+        create(0, 0, static_cast<const Uint8*>(NULL));
+        return;
+    }
+
+    // Gather the rows in a new pixel buffer, the view may point into the current one
+    std::size_t pitch = static_cast<std::size_t>(source.getSize().x) * 4;
+    std::vector<Uint8> newPixels(pitch * source.getSize().y);
+    for (unsigned int y = 0; y < source.getSize().y; ++y)
+        std::memcpy(&newPixels[pitch * y], source.getRow(y), pitch);
+
+    m_pixels.swap(newPixels);
+    m_size = source.getSize();
+    m_format = RGBA8;
+    m_memory.update(m_pixels.capacity());
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Image::loadFromMemory(const void* data, std::size_t size)
 {
-    return priv::ImageLoader::getInstance().loadImageFromMemory(data, size, m_pixels, m_size);
+    bool success = priv::ImageLoader::getInstance().loadImageFromMemory(data, size, m_pixels, m_size);
+    m_format = RGBA8;
+    m_memory.update(m_pixels.capacity());
+
+    return success;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Image::loadFromStream(InputStream& stream)
 {
-    return priv::ImageLoader::getInstance().loadImageFromStream(stream, m_pixels, m_size);
+    bool success = priv::ImageLoader::getInstance().loadImageFromStream(stream, m_pixels, m_size);
+    m_format = RGBA8;
+    m_memory.update(m_pixels.capacity());
+
+    return success;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Image::saveToFile(const std::string& filename) const
 {
+    if (m_format != RGBA8)
+    {
+        Image expanded(*this);
+        expanded.convert(RGBA8);
+        return expanded.saveToFile(filename);
+    }
+
     return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size);
 }
 
 
+////////////////////////////////////////////////////////////
+bool Image::saveToMemory(std::vector<Uint8>& output, const std::string& format) const
+{
+    if (m_format != RGBA8)
+    {
+        Image expanded(*this);
+        expanded.convert(RGBA8);
+        return expanded.saveToMemory(output, format);
+    }
+
+    return priv::ImageLoader::getInstance().saveImageToMemory(format, output, m_pixels, m_size);
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2u Image::getSize() const
 {
@@ -145,17 +630,22 @@ Vector2u Image::getSize() const
 ////////////////////////////////////////////////////////////
 void Image::createMaskFromColor(const Color& color, Uint8 alpha)
 {
+    convert(RGBA8);
+
     // Make sure that the image is not empty
     if (!m_pixels.empty())
     {
         // Replace the alpha of the pixels that match the transparent color
+        Uint32 key = packPixel(color);
+        Uint32 mask = packPixel(Color(color.r, color.g, color.b, alpha));
         Uint8* ptr = &m_pixels[0];
         Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
+        for (; ptr < end; ptr += 4)
         {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
+            Uint32 pixel;
+            std::memcpy(&pixel, ptr, sizeof(pixel));
+            if (pixel == key)
+                std::memcpy(ptr, &mask, sizeof(mask));
         }
     }
 }
@@ -163,31 +653,32 @@ void Image::createMaskFromColor(const Color& color, Uint8 alpha)
 
 ////////////////////////////////////////////////////////////
 void Image::copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect, bool applyAlpha)
+{
+    if (source.m_format != RGBA8)
+    {
+        Image expanded(source);
+        expanded.convert(RGBA8);
+        copy(expanded, destX, destY, sourceRect, applyAlpha);
+        return;
+    }
+
+    // The view clamps the source rectangle to the bounds of the source image
+    copy(ImageView(source, sourceRect), destX, destY, applyAlpha);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::copy(const ImageView& source, unsigned int destX, unsigned int destY, bool applyAlpha)
 {
     // Make sure that both images are valid
-    if ((source.m_size.x == 0) || (source.m_size.y == 0) || (m_size.x == 0) || (m_size.y == 0))
+    if (source.isEmpty() || (m_size.x == 0) || (m_size.y == 0))
         return;
 
-    // Adjust the source rectangle
-    IntRect srcRect = sourceRect;
-    if (srcRect.width == 0 || (srcRect.height == 0))
-    {
-        srcRect.left   = 0;
-        srcRect.top    = 0;
-        srcRect.width  = source.m_size.x;
-        srcRect.height = source.m_size.y;
-    }
-    else
-    {
-        if (srcRect.left   < 0) srcRect.left = 0;
-        if (srcRect.top    < 0) srcRect.top  = 0;
-        if (srcRect.width  > static_cast<int>(source.m_size.x)) srcRect.width  = source.m_size.x;
-        if (srcRect.height > static_cast<int>(source.m_size.y)) srcRect.height = source.m_size.y;
-    }
+    convert(RGBA8);
 
     // Then find the valid bounds of the destination rectangle
-    int width  = srcRect.width;
-    int height = srcRect.height;
+    int width  = static_cast<int>(source.getSize().x);
+    int height = static_cast<int>(source.getSize().y);
     if (destX + width  > m_size.x) width  = m_size.x - destX;
     if (destY + height > m_size.y) height = m_size.y - destY;
 
@@ -198,9 +689,9 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
     // Precompute as much as possible
     int          pitch     = width * 4;
     int          rows      = height;
-    int          srcStride = source.m_size.x * 4;
+    std::size_t  srcStride = source.getStride();
     int          dstStride = m_size.x * 4;
-    const Uint8* srcPixels = &source.m_pixels[0] + (srcRect.left + srcRect.top * source.m_size.x) * 4;
+    const Uint8* srcPixels = source.getPixelsPtr();
     Uint8*       dstPixels = &m_pixels[0] + (destX + destY * m_size.x) * 4;
 
     // Copy the pixels
@@ -215,12 +706,25 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
                 const Uint8* src = srcPixels + j * 4;
                 Uint8*       dst = dstPixels + j * 4;
 
+                // Opaque and transparent pixels are the most common, the
+                // interpolation is the same as a copy or as nothing for them
+                Uint32 alpha = src[3];
+                if (alpha == 255)
+                {
+                    std::memcpy(dst, src, 4);
+                    continue;
+                }
+                else if (alpha == 0)
+                {
+                    continue;
+                }
+
                 // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
+                Uint32 inverse = 255 - alpha;
+                dst[0] = static_cast<Uint8>(divide255(src[0] * alpha + dst[0] * inverse));
+                dst[1] = static_cast<Uint8>(divide255(src[1] * alpha + dst[1] * inverse));
+                dst[2] = static_cast<Uint8>(divide255(src[2] * alpha + dst[2] * inverse));
+                dst[3] = static_cast<Uint8>(alpha + divide255(dst[3] * inverse));
             }
 
             srcPixels += srcStride;
@@ -243,6 +747,13 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
 ////////////////////////////////////////////////////////////
 void Image::setPixel(unsigned int x, unsigned int y, const Color& color)
 {
+    if (m_format != RGBA8)
+    {
+        const Uint8 components[4] = {color.r, color.g, color.b, color.a};
+        priv::packPixels(components, 1, 0, m_format, false, &m_pixels[(x + y * m_size.x) * getBytesPerPixel(m_format)]);
+        return;
+    }
+
     Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
     *pixel++ = color.r;
     *pixel++ = color.g;
@@ -254,6 +765,13 @@ void Image::setPixel(unsigned int x, unsigned int y, const Color& color)
 ////////////////////////////////////////////////////////////
 Color Image::getPixel(unsigned int x, unsigned int y) const
 {
+    if (m_format != RGBA8)
+    {
+        Uint8 components[4];
+        priv::unpackPixels(&m_pixels[(x + y * m_size.x) * getBytesPerPixel(m_format)], 1, m_format, components);
+        return Color(components[0], components[1], components[2], components[3]);
+    }
+
     const Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
     return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
 }
@@ -274,24 +792,134 @@ const Uint8* Image::getPixelsPtr() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Image::convert(PixelFormat format, bool dither)
+{
+    if ((format == m_format) || m_pixels.empty())
+    {
+        m_format = format;
+        return;
+    }
+
+    // The reduced formats are converted to each other through RGBA8
+    std::size_t count = static_cast<std::size_t>(m_size.x) * m_size.y;
+    if (m_format != RGBA8)
+    {
+        std::vector<Uint8> expanded(count * 4);
+        priv::unpackPixels(&m_pixels[0], count, m_format, &expanded[0]);
+        m_pixels.swap(expanded);
+        m_format = RGBA8;
+    }
+
+    if (format != RGBA8)
+    {
+        // Row by row, the dither pattern depends on the coordinates of the pixels
+        std::size_t size = getBytesPerPixel(format);
+        std::vector<Uint8> packed(count * size);
+        for (unsigned int y = 0; y < m_size.y; ++y)
+            priv::packPixels(&m_pixels[static_cast<std::size_t>(y) * m_size.x * 4], m_size.x, y, format, dither, &packed[static_cast<std::size_t>(y) * m_size.x * size]);
+
+        m_pixels.swap(packed);
+        m_format = format;
+    }
+
+    m_memory.update(m_pixels.capacity());
+}
+
+
+////////////////////////////////////////////////////////////
+Image::PixelFormat Image::getPixelFormat() const
+{
+    return m_format;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Image::getBytesPerPixel(PixelFormat format)
+{
+    switch (format)
+    {
+        case RGB565:
+        case RGBA4444: return 2;
+        case R8:       return 1;
+        default:       return 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::isOpaque() const
+{
+    if (m_pixels.empty())
+        return false;
+
+    switch (m_format)
+    {
+        case RGB565:
+        {
+            return true;
+        }
+
+        case RGBA4444:
+        {
+            for (std::size_t i = 0; i < m_pixels.size(); i += 2)
+            {
+                Uint16 word;
+                std::memcpy(&word, &m_pixels[i], sizeof(word));
+                if ((word & 0xF) != 0xF)
+                    return false;
+            }
+            return true;
+        }
+
+        case R8:
+        {
+            return std::find_if(m_pixels.begin(), m_pixels.end(), [](Uint8 value) { return value != 255; }) == m_pixels.end();
+        }
+
+        default:
+        {
+            return priv::arePixelsOpaque(&m_pixels[0], m_pixels.size() / 4);
+        }
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::flipHorizontally()
 {
-    if (!m_pixels.empty())
+    if (!m_pixels.empty() && (m_format != RGBA8))
+    {
+        // Reduced formats: swap the bytes of the pixels one by one
+        std::size_t size = getBytesPerPixel(m_format);
+        std::size_t rowSize = m_size.x * size;
+
+        for (std::size_t y = 0; y < m_size.y; ++y)
+        {
+            Uint8* left = &m_pixels[y * rowSize];
+            Uint8* right = left + rowSize - size;
+
+            for (; left < right; left += size, right -= size)
+                std::swap_ranges(left, left + size, right);
+        }
+    }
+    else if (!m_pixels.empty())
     {
         std::size_t rowSize = m_size.x * 4;
 
         for (std::size_t y = 0; y < m_size.y; ++y)
         {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
+            Uint8* left = &m_pixels[y * rowSize];
+            Uint8* right = left + rowSize - 4;
 
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
+            for (; left < right; left += 4, right -= 4)
             {
-                std::swap_ranges(left, left + 4, right);
-
-                left += 4;
-                right -= 4;
+                Uint32 leftPixel;
+                Uint32 rightPixel;
+                std::memcpy(&leftPixel, left, sizeof(leftPixel));
+                std::memcpy(&rightPixel, right, sizeof(rightPixel));
+                std::memcpy(left, &rightPixel, sizeof(rightPixel));
+                std::memcpy(right, &leftPixel, sizeof(leftPixel));
             }
         }
     }
@@ -303,7 +931,7 @@ void Image::flipVertically()
 {
     if (!m_pixels.empty())
     {
-        std::size_t rowSize = m_size.x * 4;
+        std::size_t rowSize = m_size.x * getBytesPerPixel(m_format);
 
         std::vector<Uint8>::iterator top = m_pixels.begin();
         std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
@@ -318,4 +946,384 @@ void Image::flipVertically()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Image::premultiplyAlpha()
+{
+    convert(RGBA8);
+
+    if (!m_pixels.empty())
+        priv::ImageLoader::premultiplyAlpha(&m_pixels[0], m_pixels.size() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::unpremultiplyAlpha()
+{
+    convert(RGBA8);
+
+    if (!m_pixels.empty())
+    {
+        Uint8* ptr = &m_pixels[0];
+        Uint8* end = ptr + m_pixels.size();
+        for (; ptr < end; ptr += 4)
+        {
+            // Fully transparent pixels have lost their color, opaque ones are unchanged
+            Uint32 alpha = ptr[3];
+            if ((alpha == 0) || (alpha == 255))
+                continue;
+
+            ptr[0] = static_cast<Uint8>(std::min<Uint32>((ptr[0] * 255 + alpha / 2) / alpha, 255));
+            ptr[1] = static_cast<Uint8>(std::min<Uint32>((ptr[1] * 255 + alpha / 2) / alpha, 255));
+            ptr[2] = static_cast<Uint8>(std::min<Uint32>((ptr[2] * 255 + alpha / 2) / alpha, 255));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::resize(const Vector2u& size, ResampleFilter filter, bool sRgb, unsigned int threadCount)
+{
+    if ((size.x == 0) || (size.y == 0) || m_pixels.empty())
+    {
+        // Dump the pixel buffer
+        std::vector<Uint8>().swap(m_pixels);
+        m_size = Vector2u(0, 0);
+        m_format = RGBA8;
+        m_memory.update(0);
+        return;
+    }
+
+    convert(RGBA8);
+
+    if (size == m_size)
+        return;
+
+    std::vector<float> source;
+    std::vector<float> rows;
+    std::vector<float> dest;
+    decodePixels(m_pixels, sRgb, source);
+    resample(source, m_size, dest, size, filter, threadCount, rows);
+    encodePixels(dest, sRgb, m_pixels);
+    m_size = size;
+    m_memory.update(m_pixels.capacity());
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::generateMipChain(std::vector<Image>& levels, MipmapFilter filter, bool sRgb) const
+{
+    levels.clear();
+    if (m_pixels.empty())
+        return;
+
+    if (m_format != RGBA8)
+    {
+        Image expanded(*this);
+        expanded.convert(RGBA8);
+        expanded.generateMipChain(levels, filter, sRgb);
+        return;
+    }
+
+    // Each level is filtered from the floats of the previous one, so the rounding errors don't add up
+    Vector2u size = m_size;
+    std::vector<float> current;
+    std::vector<float> rows;
+    std::vector<float> next;
+    decodePixels(m_pixels, sRgb, current);
+    while ((size.x > 1) || (size.y > 1))
+    {
+        Vector2u nextSize(std::max(size.x / 2, 1u), std::max(size.y / 2, 1u));
+        resample(current, size, next, nextSize, filter, 1, rows);
+
+        levels.push_back(Image());
+        Image& level = levels.back();
+        level.m_size = nextSize;
+        encodePixels(next, sRgb, level.m_pixels);
+        level.m_memory.update(level.m_pixels.capacity());
+
+        current.swap(next);
+        size = nextSize;
+    }
+}
+
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool arePixelsOpaque(const Uint8* pixels, std::size_t count)
+{
+    // The pixels are opaque if the AND of all their alphas is 255; the alpha
+    // is the high byte of each pixel loaded as a little endian 32-bit word
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGE_SSE2)
+
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    while (i + 4 <= count)
+    {
+        __m128i alphas = alphaMask;
+        std::size_t end = std::min(count - count % 4, i + opaqueScanBlock);
+        for (; i < end; i += 4)
+            alphas = _mm_and_si128(alphas, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 4 * i)));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alphas, alphaMask)) != 0xFFFF)
+            return false;
+    }
+
+#elif defined(SFML_IMAGE_NEON)
+
+    while (i + 4 <= count)
+    {
+        uint32x4_t alphas = vdupq_n_u32(0xFF000000);
+        std::size_t end = std::min(count - count % 4, i + opaqueScanBlock);
+        for (; i < end; i += 4)
+            alphas = vandq_u32(alphas, vreinterpretq_u32_u8(vld1q_u8(pixels + 4 * i)));
+
+        uint32x2_t half = vand_u32(vget_low_u32(alphas), vget_high_u32(alphas));
+        if ((vget_lane_u32(half, 0) & vget_lane_u32(half, 1)) != 0xFF000000)
+            return false;
+    }
+
+#elif defined(SFML_IMAGE_WASM)
+
+    const v128_t alphaMask = wasm_i32x4_splat(static_cast<int>(0xFF000000));
+    while (i + 4 <= count)
+    {
+        v128_t alphas = alphaMask;
+        std::size_t end = std::min(count - count % 4, i + opaqueScanBlock);
+        for (; i < end; i += 4)
+            alphas = wasm_v128_and(alphas, wasm_v128_load(pixels + 4 * i));
+
+        if (!wasm_i32x4_all_true(wasm_i32x4_eq(alphas, alphaMask)))
+            return false;
+    }
+
+#endif
+
+    Uint8 alpha = 255;
+    for (; i < count; ++i)
+        alpha &= pixels[4 * i + 3];
+
+    return alpha == 255;
+}
+
+
+////////////////////////////////////////////////////////////
+void packPixels(const Uint8* source, unsigned int width, unsigned int y, Image::PixelFormat format, bool dither, Uint8* dest)
+{
+    if (format == Image::R8)
+    {
+        for (unsigned int x = 0; x < width; ++x)
+            dest[x] = source[4 * x];
+
+        return;
+    }
+
+    if (format != Image::RGB565 && format != Image::RGBA4444)
+    {
+        std::memcpy(dest, source, static_cast<std::size_t>(width) * 4);
+        return;
+    }
+
+    // Offsets added to the 4 pixels of a period of the dither pattern, before the
+    // low bits are dropped (the additions saturate, so 255 stays the maximum)
+    static const Uint8 bayer[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+    bool rgb565 = (format == Image::RGB565);
+    Uint8 offsets[16] = {0};
+    if (dither)
+    {
+        for (unsigned int x = 0; x < 4; ++x)
+        {
+            Uint8 threshold = bayer[y % 4][x];
+            offsets[x * 4 + 0] = rgb565 ? threshold / 2 : threshold;
+            offsets[x * 4 + 1] = rgb565 ? threshold / 4 : threshold;
+            offsets[x * 4 + 2] = rgb565 ? threshold / 2 : threshold;
+            offsets[x * 4 + 3] = rgb565 ? 0 : threshold;
+        }
+    }
+
+    unsigned int x = 0;
+
+#if defined(SFML_IMAGE_SSE2)
+
+    // 8 pixels per iteration, each one a 32-bit lane turned into 16 bits
+    const __m128i offset = _mm_loadu_si128(reinterpret_cast<const __m128i*>(offsets));
+    const __m128i bias   = _mm_set1_epi32(0x8000);
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i packed[2];
+        for (int i = 0; i < 2; ++i)
+        {
+            __m128i pixels = _mm_adds_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 4 * (x + 4 * i))), offset);
+            if (rgb565)
+            {
+                packed[i] = _mm_or_si128(_mm_or_si128(
+                            _mm_slli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0x000000F8)), 8),
+                            _mm_srli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0x0000FC00)), 5)),
+                            _mm_srli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0x00F80000)), 19));
+            }
+            else
+            {
+                packed[i] = _mm_or_si128(_mm_or_si128(
+                            _mm_slli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0x000000F0)), 8),
+                            _mm_srli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0x0000F000)), 4)),
+                            _mm_or_si128(
+                            _mm_srli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0x00F00000)), 16),
+                            _mm_srli_epi32(pixels, 28)));
+            }
+        }
+
+        // SSE2 only packs with signed saturation, shift the values to the signed range and back
+        __m128i words = _mm_packs_epi32(_mm_sub_epi32(packed[0], bias), _mm_sub_epi32(packed[1], bias));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * x), _mm_xor_si128(words, _mm_set1_epi16(static_cast<short>(0x8000))));
+    }
+
+#elif defined(SFML_IMAGE_NEON)
+
+    const uint8x16_t offset = vld1q_u8(offsets);
+    for (; x + 8 <= width; x += 8)
+    {
+        uint16x4_t packed[2];
+        for (int i = 0; i < 2; ++i)
+        {
+            uint32x4_t pixels = vreinterpretq_u32_u8(vqaddq_u8(vld1q_u8(source + 4 * (x + 4 * i)), offset));
+            uint32x4_t words;
+            if (rgb565)
+            {
+                words = vorrq_u32(vorrq_u32(
+                        vshlq_n_u32(vandq_u32(pixels, vdupq_n_u32(0x000000F8)), 8),
+                        vshrq_n_u32(vandq_u32(pixels, vdupq_n_u32(0x0000FC00)), 5)),
+                        vshrq_n_u32(vandq_u32(pixels, vdupq_n_u32(0x00F80000)), 19));
+            }
+            else
+            {
+                words = vorrq_u32(vorrq_u32(
+                        vshlq_n_u32(vandq_u32(pixels, vdupq_n_u32(0x000000F0)), 8),
+                        vshrq_n_u32(vandq_u32(pixels, vdupq_n_u32(0x0000F000)), 4)),
+                        vorrq_u32(
+                        vshrq_n_u32(vandq_u32(pixels, vdupq_n_u32(0x00F00000)), 16),
+                        vshrq_n_u32(pixels, 28)));
+            }
+            packed[i] = vmovn_u32(words);
+        }
+
+        vst1q_u8(dest + 2 * x, vreinterpretq_u8_u16(vcombine_u16(packed[0], packed[1])));
+    }
+
+#elif defined(SFML_IMAGE_WASM)
+
+    const v128_t offset = wasm_v128_load(offsets);
+    for (; x + 8 <= width; x += 8)
+    {
+        v128_t packed[2];
+        for (int i = 0; i < 2; ++i)
+        {
+            v128_t pixels = wasm_u8x16_add_sat(wasm_v128_load(source + 4 * (x + 4 * i)), offset);
+            if (rgb565)
+            {
+                packed[i] = wasm_v128_or(wasm_v128_or(
+                            wasm_i32x4_shl(wasm_v128_and(pixels, wasm_i32x4_splat(0x000000F8)), 8),
+                            wasm_u32x4_shr(wasm_v128_and(pixels, wasm_i32x4_splat(0x0000FC00)), 5)),
+                            wasm_u32x4_shr(wasm_v128_and(pixels, wasm_i32x4_splat(0x00F80000)), 19));
+            }
+            else
+            {
+                packed[i] = wasm_v128_or(wasm_v128_or(
+                            wasm_i32x4_shl(wasm_v128_and(pixels, wasm_i32x4_splat(0x000000F0)), 8),
+                            wasm_u32x4_shr(wasm_v128_and(pixels, wasm_i32x4_splat(0x0000F000)), 4)),
+                            wasm_v128_or(
+                            wasm_u32x4_shr(wasm_v128_and(pixels, wasm_i32x4_splat(0x00F00000)), 16),
+                            wasm_u32x4_shr(pixels, 28)));
+            }
+        }
+
+        // The values fit in 16 bits, the saturation of the narrowing never happens
+        wasm_v128_store(dest + 2 * x, wasm_u16x8_narrow_i32x4(packed[0], packed[1]));
+    }
+
+#endif
+
+    for (; x < width; ++x)
+    {
+        const Uint8* pixel = source + 4 * x;
+        const Uint8* pattern = offsets + 4 * (x % 4);
+        Uint32 r = std::min(pixel[0] + pattern[0], 255);
+        Uint32 g = std::min(pixel[1] + pattern[1], 255);
+        Uint32 b = std::min(pixel[2] + pattern[2], 255);
+        Uint32 a = std::min(pixel[3] + pattern[3], 255);
+
+        Uint16 word = rgb565 ? static_cast<Uint16>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+                             : static_cast<Uint16>(((r >> 4) << 12) | ((g >> 4) << 8) | ((b >> 4) << 4) | (a >> 4));
+        std::memcpy(dest + 2 * x, &word, sizeof(word));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void unpackPixels(const Uint8* source, std::size_t count, Image::PixelFormat format, Uint8* dest)
+{
+    switch (format)
+    {
+        case Image::RGB565:
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Uint16 word;
+                std::memcpy(&word, source + 2 * i, sizeof(word));
+                expandRgb565(word, dest + 4 * i);
+            }
+            break;
+        }
+
+        case Image::RGBA4444:
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Uint16 word;
+                std::memcpy(&word, source + 2 * i, sizeof(word));
+                expandRgba4444(word, dest + 4 * i);
+            }
+            break;
+        }
+
+        case Image::R8:
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                dest[4 * i + 0] = 255;
+                dest[4 * i + 1] = 255;
+                dest[4 * i + 2] = 255;
+                dest[4 * i + 3] = source[i];
+            }
+            break;
+        }
+
+        default:
+        {
+            std::memcpy(dest, source, count * 4);
+            break;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool arePixelsOpaque(const ImageView& pixels)
+{
+    if (pixels.isContiguous())
+        return arePixelsOpaque(pixels.getPixelsPtr(), static_cast<std::size_t>(pixels.getSize().x) * pixels.getSize().y);
+
+    // Scan the rows one by one, each of them with the vectorized kernel
+    for (unsigned int y = 0; y < pixels.getSize().y; ++y)
+    {
+        if (!arePixelsOpaque(pixels.getRow(y), pixels.getSize().x))
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace priv
+
 } // namespace sf
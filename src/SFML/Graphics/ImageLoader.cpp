@@ -26,13 +26,21 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/MemoryStats.hpp>
+#include <SFML/Graphics/QoiCodec.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/JobSystem.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Trace.hpp>
 //#define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 //#define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstdio>
+#include <cstring>
 
 
 namespace
@@ -61,6 +69,96 @@ namespace
         sf::InputStream* stream = static_cast<sf::InputStream*>(user);
         return stream->tell() >= stream->getSize();
     }
+
+    // stb_image_write callback that appends to a std::vector
+    void write(void* context, void* data, int size)
+    {
+        std::vector<sf::Uint8>* output = static_cast<std::vector<sf::Uint8>*>(context);
+        const sf::Uint8* bytes = static_cast<const sf::Uint8*>(data);
+        output->insert(output->end(), bytes, bytes + size);
+    }
+
+    // Read the whole contents of a stream when it starts with the QOI signature, which stb_image doesn't know
+    bool readQoiStream(sf::InputStream& stream, std::vector<sf::Uint8>& contents)
+    {
+        char signature[4];
+        stream.seek(0);
+        bool isQoi = (stream.read(signature, sizeof(signature)) == sizeof(signature)) && sf::priv::isQoiImage(signature, sizeof(signature));
+        stream.seek(0);
+
+        if (!isQoi)
+            return false;
+
+        sf::Int64 size = stream.getSize();
+        contents.resize(size > 0 ? static_cast<std::size_t>(size) : 0);
+        if (contents.empty() || (stream.read(&contents[0], size) != size))
+            contents.clear();
+
+        return true;
+    }
+
+    // Decode an item of a batch, the failure reason of stb_image is thread-local
+    const char* decodeBatchItem(sf::priv::ImageLoader::BatchItem& item)
+    {
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        unsigned char* ptr = NULL;
+
+        const char* qoiError = NULL;
+        std::vector<sf::Uint8> qoiContents;
+        if (item.stream && readQoiStream(*item.stream, qoiContents))
+        {
+            sf::Vector2u size;
+            ptr = qoiContents.empty() ? NULL : sf::priv::decodeQoiImage(&qoiContents[0], qoiContents.size(), size, qoiError);
+            width = static_cast<int>(size.x);
+            height = static_cast<int>(size.y);
+            if (!ptr && !qoiError)
+                qoiError = "failed to read the stream";
+        }
+        else if (item.stream)
+        {
+            stbi_io_callbacks callbacks;
+            callbacks.read = &read;
+            callbacks.skip = &skip;
+            callbacks.eof = &eof;
+
+            item.stream->seek(0);
+            ptr = stbi_load_from_callbacks(&callbacks, item.stream, &width, &height, &channels, STBI_rgb_alpha);
+        }
+        else if (sf::priv::isQoiImage(item.data, item.dataSize))
+        {
+            sf::Vector2u size;
+            ptr = sf::priv::decodeQoiImage(item.data, item.dataSize, size, qoiError);
+            width = static_cast<int>(size.x);
+            height = static_cast<int>(size.y);
+        }
+        else if (item.data && item.dataSize)
+        {
+            const unsigned char* buffer = static_cast<const unsigned char*>(item.data);
+            ptr = stbi_load_from_memory(buffer, static_cast<int>(item.dataSize), &width, &height, &channels, STBI_rgb_alpha);
+        }
+        else
+        {
+            return "no data provided";
+        }
+
+        if (!ptr)
+            return qoiError ? qoiError : stbi_failure_reason();
+
+        // The decoded pixels only live until they are copied into the item
+        sf::Uint64 decodedSize = static_cast<sf::Uint64>(width) * height * 4;
+        sf::priv::trackMemory(sf::MemoryStats::Loaders, 0, decodedSize);
+
+        item.size.x = width;
+        item.size.y = height;
+        item.pixels.assign(ptr, ptr + static_cast<std::size_t>(width) * height * 4);
+        item.success = true;
+        stbi_image_free(ptr);
+        sf::priv::trackMemory(sf::MemoryStats::Loaders, decodedSize, 0);
+
+        return NULL;
+    }
 }
 
 
@@ -94,58 +192,109 @@ ImageLoader::~ImageLoader()
 ////////////////////////////////////////////////////////////
 bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
 {
-    // Check input parameters
-    if (data && dataSize)
-    {
-        // Clear the array (just in case)
-        pixels.clear();
+    // Clear the array (just in case)
+    pixels.clear();
 
-        // Load the image and get a pointer to the pixels in memory
-        int width = 0;
-        int height = 0;
-        int channels = 0;
-        const unsigned char* buffer = static_cast<const unsigned char*>(data);
-        unsigned char* ptr = stbi_load_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels, STBI_rgb_alpha);
+    Uint8* ptr = decodeImageFromMemory(data, dataSize, size);
+    if (!ptr)
+        return false;
 
-        if (ptr)
-        {
-            // Assign the image properties
-            size.x = width;
-            size.y = height;
+    // Copy the loaded pixels to the pixel buffer
+    pixels.assign(ptr, ptr + static_cast<std::size_t>(size.x) * size.y * 4);
+    freeDecodedPixels(ptr, size);
 
-            if (width && height)
-            {
-                // Copy the loaded pixels to the pixel buffer
-                pixels.resize(width * height * 4);
-                memcpy(&pixels[0], ptr, pixels.size());
-            }
+    return true;
+}
 
-            // Free the loaded pixels (they are now in our own pixel buffer)
-            stbi_image_free(ptr);
 
-            return true;
-        }
+////////////////////////////////////////////////////////////
+bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+{
+    // Clear the array (just in case)
+    pixels.clear();
+
+    Uint8* ptr = decodeImageFromStream(stream, size);
+    if (!ptr)
+        return false;
+
+    // Copy the loaded pixels to the pixel buffer
+    pixels.assign(ptr, ptr + static_cast<std::size_t>(size.x) * size.y * 4);
+    freeDecodedPixels(ptr, size);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* ImageLoader::decodeImageFromMemory(const void* data, std::size_t dataSize, Vector2u& size)
+{
+    SFML_TRACE_SCOPE("ImageLoader::decodeImageFromMemory");
+
+    // Check input parameters
+    if (!data || !dataSize)
+    {
+        err() << "Failed to load image from memory, no data provided" << std::endl;
+        return NULL;
+    }
+
+    // QOI images are decoded by our own codec
+    if (isQoiImage(data, dataSize))
+    {
+        const char* error = NULL;
+        Uint8* pixels = decodeQoiImage(data, dataSize, size, error);
+        if (!pixels)
+            err() << "Failed to load image from memory. Reason: " << error << std::endl;
         else
-        {
-            // Error, failed to load the image
-            err() << "Failed to load image from memory. Reason: " << stbi_failure_reason() << std::endl;
+            trackMemory(MemoryStats::Loaders, 0, static_cast<Uint64>(size.x) * size.y * 4);
 
-            return false;
-        }
+        return pixels;
     }
-    else
+
+    // Load the image and get a pointer to the pixels in memory
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    const unsigned char* buffer = static_cast<const unsigned char*>(data);
+    unsigned char* ptr = stbi_load_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels, STBI_rgb_alpha);
+
+    if (!ptr)
     {
-        err() << "Failed to load image from memory, no data provided" << std::endl;
-        return false;
+        // Error, failed to load the image
+        err() << "Failed to load image from memory. Reason: " << stbi_failure_reason() << std::endl;
+        return NULL;
     }
+
+    // Assign the image properties
+    size.x = width;
+    size.y = height;
+    trackMemory(MemoryStats::Loaders, 0, static_cast<Uint64>(width) * height * 4);
+
+    return ptr;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+Uint8* ImageLoader::decodeImageFromStream(InputStream& stream, Vector2u& size)
 {
-    // Clear the array (just in case)
-    pixels.clear();
+    SFML_TRACE_SCOPE("ImageLoader::decodeImageFromStream");
+
+    // Decode the contents in place when they are already in memory
+    std::size_t dataSize;
+    if (const void* data = stream.getContiguousData(dataSize))
+        return decodeImageFromMemory(data, dataSize, size);
+
+    // QOI images can't be decoded from the stb_image callbacks, read them first
+    std::vector<Uint8> contents;
+    if (readQoiStream(stream, contents))
+    {
+        if (contents.empty())
+        {
+            err() << "Failed to load image from stream. Reason: failed to read the stream" << std::endl;
+            return NULL;
+        }
+
+        return decodeImageFromMemory(&contents[0], contents.size(), size);
+    }
 
     // Make sure that the stream's reading position is at the beginning
     stream.seek(0);
@@ -162,30 +311,86 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
     int channels = 0;
     unsigned char* ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &channels, STBI_rgb_alpha);
 
-    if (ptr)
+    if (!ptr)
     {
-        // Assign the image properties
-        size.x = width;
-        size.y = height;
+        // Error, failed to load the image
+        err() << "Failed to load image from stream. Reason: " << stbi_failure_reason() << std::endl;
+        return NULL;
+    }
+
+    // Assign the image properties
+    size.x = width;
+    size.y = height;
+    trackMemory(MemoryStats::Loaders, 0, static_cast<Uint64>(width) * height * 4);
+
+    return ptr;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageLoader::freeDecodedPixels(Uint8* pixels, const Vector2u& size)
+{
+    if (pixels)
+        trackMemory(MemoryStats::Loaders, static_cast<Uint64>(size.x) * size.y * 4, 0);
+
+    stbi_image_free(pixels);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageLoader::loadBatch(std::vector<BatchItem>& items, unsigned int threadCount)
+{
+    SFML_TRACE_SCOPE("ImageLoader::loadBatch");
+
+    if (items.empty())
+        return 0;
 
-        if (width && height)
+    JobScheduler& scheduler = JobSystem::getScheduler();
+    if (threadCount == 0)
+        threadCount = scheduler.getConcurrency();
+    threadCount = static_cast<unsigned int>(std::min<std::size_t>(threadCount, items.size()));
+
+    // Each job takes the next item to decode until there is none left, so that
+    // large and small images are balanced between the threadCount jobs
+    std::vector<const char*> errors(items.size(), static_cast<const char*>(NULL));
+    std::atomic<std::size_t> next(0);
+    scheduler.parallelFor(threadCount, 1, [&items, &errors, &next](std::size_t, std::size_t)
+    {
+        for (std::size_t i = next++; i < items.size(); i = next++)
         {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
+            items[i].pixels.clear();
+            items[i].success = false;
+            errors[i] = decodeBatchItem(items[i]);
         }
+    });
 
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
-
-        return true;
-    }
-    else
+    // Report the failures from the calling thread, since sf::err() is not thread-safe
+    std::size_t loaded = 0;
+    for (std::size_t i = 0; i < items.size(); ++i)
     {
-        // Error, failed to load the image
-        err() << "Failed to load image from stream. Reason: " << stbi_failure_reason() << std::endl;
+        if (items[i].success)
+            ++loaded;
+        else
+            err() << "Failed to load image " << i << " of batch. Reason: " << (errors[i] ? errors[i] : "unknown") << std::endl;
+    }
 
-        return false;
+    return loaded;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageLoader::premultiplyAlpha(Uint8* pixels, std::size_t pixelCount)
+{
+    Uint8* end = pixels + pixelCount * 4;
+    for (; pixels < end; pixels += 4)
+    {
+        // Divide the products by 255 with rounding, without an actual division
+        Uint32 alpha = pixels[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            Uint32 product = pixels[i] * alpha + 128;
+            pixels[i] = static_cast<Uint8>((product + (product >> 8)) >> 8);
+        }
     }
 }
 
@@ -226,12 +431,76 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
             if (stbi_write_jpg(filename.c_str(), size.x, size.y, 4, &pixels[0], 90))
                 return true;
         }
+        else if (extension == "qoi")
+        {
+            // QOI format
+            std::vector<Uint8> output;
+            encodeQoiImage(output, &pixels[0], size);
+
+            if (std::FILE* file = std::fopen(filename.c_str(), "wb"))
+            {
+                bool written = (std::fwrite(&output[0], 1, output.size(), file) == output.size());
+                if ((std::fclose(file) == 0) && written)
+                    return true;
+            }
+        }
     }
 
     err() << "Failed to save image \"" << filename << "\"" << std::endl;
     return false;
 }
 
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::saveImageToMemory(const std::string& format, std::vector<Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size)
+{
+    SFML_TRACE_SCOPE("ImageLoader::saveImageToMemory");
+
+    // Make sure the image is not empty
+    if (!pixels.empty() && (size.x > 0) && (size.y > 0))
+    {
+        // Clear the output buffer
+        output.clear();
+
+        // Choose function based on format
+        std::string specified = toLower(format);
+
+        if (specified == "bmp")
+        {
+            // BMP format
+            if (stbi_write_bmp_to_func(&write, &output, size.x, size.y, 4, &pixels[0]))
+                return true;
+        }
+        else if (specified == "tga")
+        {
+            // TGA format
+            if (stbi_write_tga_to_func(&write, &output, size.x, size.y, 4, &pixels[0]))
+                return true;
+        }
+        else if (specified == "png")
+        {
+            // PNG format
+            if (stbi_write_png_to_func(&write, &output, size.x, size.y, 4, &pixels[0], 0))
+                return true;
+        }
+        else if (specified == "jpg" || specified == "jpeg")
+        {
+            // JPG format
+            if (stbi_write_jpg_to_func(&write, &output, size.x, size.y, 4, &pixels[0], 90))
+                return true;
+        }
+        else if (specified == "qoi")
+        {
+            // QOI format
+            encodeQoiImage(output, &pixels[0], size);
+            return true;
+        }
+    }
+
+    err() << "Failed to save image with format \"" << format << "\"" << std::endl;
+    return false;
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Clamp a rectangle to [0, size), an empty rectangle selects everything
+    sf::IntRect clampArea(const sf::IntRect& area, const sf::Vector2u& size)
+    {
+        int width  = static_cast<int>(size.x);
+        int height = static_cast<int>(size.y);
+        if ((area.width == 0) || (area.height == 0))
+            return sf::IntRect(0, 0, width, height);
+
+        int left   = std::max(area.left, 0);
+        int top    = std::max(area.top, 0);
+        int right  = std::min(area.left + area.width, width);
+        int bottom = std::min(area.top + area.height, height);
+        if ((right <= left) || (bottom <= top))
+            return sf::IntRect();
+
+        return sf::IntRect(left, top, right - left, bottom - top);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageView::ImageView() :
+m_pixels(NULL),
+m_size  (0, 0),
+m_stride(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Image& image) :
+m_pixels(NULL),
+m_size  (0, 0),
+m_stride(0)
+{
+    // Views are made of RGBA8 pixels, images in the other formats can't be viewed
+    if ((image.getPixelFormat() == Image::RGBA8) && (image.getSize().x > 0) && (image.getSize().y > 0))
+    {
+        m_pixels = image.getPixelsPtr();
+        m_size   = image.getSize();
+        m_stride = static_cast<std::size_t>(m_size.x) * 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Image& image, const IntRect& area) :
+m_pixels(NULL),
+m_size  (0, 0),
+m_stride(0)
+{
+    *this = ImageView(image).subView(area);
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Uint8* pixels, unsigned int width, unsigned int height, std::size_t stride) :
+m_pixels(pixels),
+m_size  (width, height),
+m_stride(stride ? stride : static_cast<std::size_t>(width) * 4)
+{
+    if (!pixels || (width == 0) || (height == 0))
+    {
+        m_pixels = NULL;
+        m_size   = Vector2u(0, 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView ImageView::subView(const IntRect& area) const
+{
+    IntRect rectangle = clampArea(area, m_size);
+    if ((rectangle.width == 0) || (rectangle.height == 0) || !m_pixels)
+        return ImageView();
+
+    const Uint8* first = getRow(static_cast<unsigned int>(rectangle.top)) + 4 * static_cast<std::size_t>(rectangle.left);
+    return ImageView(first, static_cast<unsigned int>(rectangle.width), static_cast<unsigned int>(rectangle.height), m_stride);
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* ImageView::getPixelsPtr() const
+{
+    return m_pixels;
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* ImageView::getRow(unsigned int y) const
+{
+    return m_pixels + m_stride * y;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u ImageView::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageView::getStride() const
+{
+    return m_stride;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageView::isContiguous() const
+{
+    return m_stride == static_cast<std::size_t>(m_size.x) * 4;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageView::isEmpty() const
+{
+    return (m_size.x == 0) || (m_size.y == 0);
+}
+
+} // namespace sf
@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    GLenum usageToGlEnum(sf::VertexBuffer::Usage usage)
+    {
+        switch (usage)
+        {
+            case sf::VertexBuffer::Static:  return GL_STATIC_DRAW;
+            case sf::VertexBuffer::Dynamic: return GL_DYNAMIC_DRAW;
+            default:                        return GL_STREAM_DRAW;
+        }
+    }
+
+    // The element array binding belongs to the bound vertex array object:
+    // unbind it so that uploading doesn't change the indices of any of them
+    void bindForUpload(GLuint buffer)
+    {
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+        cache.bindVertexArray(0);
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexBuffer() :
+m_buffer(0),
+m_size  (0),
+m_type  (UnsignedShort),
+m_usage (VertexBuffer::Static)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexBuffer(Type type, VertexBuffer::Usage usage) :
+m_buffer(0),
+m_size  (0),
+m_type  (type),
+m_usage (usage)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::~IndexBuffer()
+{
+    if (m_buffer)
+    {
+        priv::getGLStateCache().deleteBuffer(m_buffer);
+        priv::trackGpuMemory(GpuMemory::VertexBuffers, getStride() * m_size, 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::create(std::size_t indexCount)
+{
+    if (!isAvailable(m_type))
+    {
+        err() << "Could not create index buffer, 32-bit indices are not supported by the system" << std::endl;
+        return false;
+    }
+
+    if (!m_buffer)
+        glCheck(glGenBuffers(1, &m_buffer));
+
+    if (!m_buffer)
+    {
+        err() << "Could not create index buffer, generation failed" << std::endl;
+        return false;
+    }
+
+    bindForUpload(m_buffer);
+    glCheck(glBufferData(GL_ELEMENT_ARRAY_BUFFER, getStride() * indexCount, 0, usageToGlEnum(m_usage)));
+
+    priv::trackGpuMemory(GpuMemory::VertexBuffers, getStride() * m_size, getStride() * indexCount);
+    m_size = indexCount;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t IndexBuffer::getIndexCount() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::update(const Uint16* indices, std::size_t indexCount, unsigned int offset)
+{
+    if (m_type != UnsignedShort)
+    {
+        err() << "Cannot update a buffer of 32-bit indices with 16-bit indices" << std::endl;
+        return false;
+    }
+
+    return upload(indices, indexCount, offset);
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::update(const Uint32* indices, std::size_t indexCount, unsigned int offset)
+{
+    if (m_type != UnsignedInt)
+    {
+        err() << "Cannot update a buffer of 16-bit indices with 32-bit indices" << std::endl;
+        return false;
+    }
+
+    return upload(indices, indexCount, offset);
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::Type IndexBuffer::getType() const
+{
+    return m_type;
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::Usage IndexBuffer::getUsage() const
+{
+    return m_usage;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int IndexBuffer::getNativeHandle() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::isAvailable(Type type)
+{
+    return (type == UnsignedShort) || priv::isElementIndexUintAvailable();
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::upload(const void* indices, std::size_t indexCount, unsigned int offset)
+{
+    // Sanity checks
+    if (!m_buffer || !indices)
+        return false;
+
+    if (offset && (offset + indexCount > m_size))
+        return false;
+
+    bindForUpload(m_buffer);
+
+    // Check if we need to resize or orphan the buffer
+    if (indexCount >= m_size)
+    {
+        glCheck(glBufferData(GL_ELEMENT_ARRAY_BUFFER, getStride() * indexCount, 0, usageToGlEnum(m_usage)));
+
+        priv::trackGpuMemory(GpuMemory::VertexBuffers, getStride() * m_size, getStride() * indexCount);
+        m_size = indexCount;
+    }
+
+    glCheck(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, getStride() * offset, getStride() * indexCount, indices));
+    priv::getRenderStats().bytesUploaded += getStride() * indexCount;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t IndexBuffer::getStride() const
+{
+    return (m_type == UnsignedInt) ? sizeof(Uint32) : sizeof(Uint16);
+}
+
+} // namespace sf
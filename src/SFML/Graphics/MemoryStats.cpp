@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/MemoryStats.hpp>
+#include <atomic>
+
+
+namespace
+{
+    // Updated by the loading threads too; the peaks are raised with compare-and-swap
+    std::atomic<sf::Uint64> liveBytes[sf::MemoryStats::TagCount];
+    std::atomic<sf::Uint64> peakBytes[sf::MemoryStats::TagCount];
+    std::atomic<sf::Uint64> totalLiveBytes(0);
+    std::atomic<sf::Uint64> totalPeakBytes(0);
+
+    // Raise a peak to a new usage, if it is larger
+    void raisePeak(std::atomic<sf::Uint64>& peak, sf::Uint64 usage)
+    {
+        sf::Uint64 current = peak.load(std::memory_order_relaxed);
+        while ((usage > current) && !peak.compare_exchange_weak(current, usage, std::memory_order_relaxed))
+        {
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+MemoryStats::Usage MemoryStats::getUsage(Tag tag)
+{
+    Usage usage;
+    usage.live = liveBytes[tag].load(std::memory_order_relaxed);
+    usage.peak = peakBytes[tag].load(std::memory_order_relaxed);
+
+    return usage;
+}
+
+
+////////////////////////////////////////////////////////////
+MemoryStats::Snapshot MemoryStats::getSnapshot()
+{
+    Snapshot snapshot;
+    for (int i = 0; i < TagCount; ++i)
+        snapshot.tags[i] = getUsage(static_cast<Tag>(i));
+
+    snapshot.total.live = totalLiveBytes.load(std::memory_order_relaxed);
+    snapshot.total.peak = totalPeakBytes.load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+
+////////////////////////////////////////////////////////////
+void MemoryStats::resetPeaks()
+{
+    for (int i = 0; i < TagCount; ++i)
+        peakBytes[i].store(liveBytes[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    totalPeakBytes.store(totalLiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void trackMemory(MemoryStats::Tag tag, Uint64 oldSize, Uint64 newSize)
+{
+    if (newSize > oldSize)
+    {
+        Uint64 growth = newSize - oldSize;
+        raisePeak(peakBytes[tag], liveBytes[tag].fetch_add(growth, std::memory_order_relaxed) + growth);
+        raisePeak(totalPeakBytes, totalLiveBytes.fetch_add(growth, std::memory_order_relaxed) + growth);
+    }
+    else if (newSize < oldSize)
+    {
+        liveBytes[tag].fetch_sub(oldSize - newSize, std::memory_order_relaxed);
+        totalLiveBytes.fetch_sub(oldSize - newSize, std::memory_order_relaxed);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+MemoryCounter::MemoryCounter(MemoryStats::Tag tag) :
+m_tag  (tag),
+m_bytes(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+MemoryCounter::MemoryCounter(const MemoryCounter& copy) :
+m_tag  (copy.m_tag),
+m_bytes(copy.m_bytes)
+{
+    trackMemory(m_tag, 0, m_bytes);
+}
+
+
+////////////////////////////////////////////////////////////
+MemoryCounter::MemoryCounter(MemoryCounter&& right) noexcept :
+m_tag  (right.m_tag),
+m_bytes(right.m_bytes)
+{
+    right.m_bytes = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+MemoryCounter::~MemoryCounter()
+{
+    trackMemory(m_tag, m_bytes, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+MemoryCounter& MemoryCounter::operator =(const MemoryCounter& right)
+{
+    update(right.m_bytes);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+MemoryCounter& MemoryCounter::operator =(MemoryCounter&& right) noexcept
+{
+    if (&right != this)
+    {
+        // The containers of the owner were released, and replaced by those of right
+        trackMemory(m_tag, m_bytes, 0);
+        m_bytes = right.m_bytes;
+        right.m_bytes = 0;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void MemoryCounter::update(Uint64 bytes)
+{
+    trackMemory(m_tag, m_bytes, bytes);
+    m_bytes = bytes;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/NineSliceSprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cstdlib>
+
+
+namespace
+{
+    // Corners of the two triangles of a slice, as offsets in the grid
+    const int sliceCornerX[6] = {0, 0, 1, 1, 0, 1};
+    const int sliceCornerY[6] = {0, 1, 0, 0, 1, 1};
+
+    // Compute the 4 grid lines along one axis, shrinking the borders if they don't fit
+    void computeGridLines(float* lines, float start, float border1, float border2, float size)
+    {
+        float borders = border1 + border2;
+        float factor = ((borders > size) && (borders > 0.f)) ? size / borders : 1.f;
+
+        lines[0] = start;
+        lines[1] = start + border1 * factor;
+        lines[2] = start + size - border2 * factor;
+        lines[3] = start + size;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+NineSliceSprite::NineSliceSprite() :
+m_texture    (NULL),
+m_textureRect(),
+m_centerRect (),
+m_size       (0, 0),
+m_color      (Color::White)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+NineSliceSprite::NineSliceSprite(const Texture& texture, const IntRect& textureRect, const IntRect& centerRect) :
+m_texture    (&texture),
+m_textureRect(textureRect),
+m_centerRect (centerRect),
+m_size       (static_cast<float>(std::abs(textureRect.width)), static_cast<float>(std::abs(textureRect.height))),
+m_color      (Color::White)
+{
+    updatePositions();
+    updateTexCoords();
+    setColor(m_color);
+}
+
+
+////////////////////////////////////////////////////////////
+void NineSliceSprite::setTexture(const Texture& texture)
+{
+    m_texture = &texture;
+    updateTexCoords();
+}
+
+
+////////////////////////////////////////////////////////////
+void NineSliceSprite::setTextureRect(const IntRect& rectangle)
+{
+    if (rectangle != m_textureRect)
+    {
+        m_textureRect = rectangle;
+        updatePositions();
+        updateTexCoords();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NineSliceSprite::setCenterRect(const IntRect& rectangle)
+{
+    if (rectangle != m_centerRect)
+    {
+        m_centerRect = rectangle;
+        updatePositions();
+        updateTexCoords();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NineSliceSprite::setSize(const Vector2f& size)
+{
+    if (size != m_size)
+    {
+        m_size = size;
+        updatePositions();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NineSliceSprite::setColor(const Color& color)
+{
+    m_color = color;
+
+    for (std::size_t i = 0; i < 54; ++i)
+        m_vertices[i].color = color;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* NineSliceSprite::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& NineSliceSprite::getTextureRect() const
+{
+    return m_textureRect;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& NineSliceSprite::getCenterRect() const
+{
+    return m_centerRect;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& NineSliceSprite::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& NineSliceSprite::getColor() const
+{
+    return m_color;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect NineSliceSprite::getLocalBounds() const
+{
+    return FloatRect(0.f, 0.f, m_size.x, m_size.y);
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect NineSliceSprite::getGlobalBounds() const
+{
+    return getTransformedBounds(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void NineSliceSprite::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_texture)
+    {
+        states.transform *= getTransform();
+        states.texture = m_texture;
+        target.draw(m_vertices, 54, Triangles, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool NineSliceSprite::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void NineSliceSprite::updatePositions()
+{
+    // Fixed borders, in pixels of the texture
+    float left   = static_cast<float>(std::max(m_centerRect.left, 0));
+    float top    = static_cast<float>(std::max(m_centerRect.top, 0));
+    float right  = static_cast<float>(std::max(std::abs(m_textureRect.width) - m_centerRect.left - m_centerRect.width, 0));
+    float bottom = static_cast<float>(std::max(std::abs(m_textureRect.height) - m_centerRect.top - m_centerRect.height, 0));
+
+    float x[4];
+    float y[4];
+    computeGridLines(x, 0.f, left, right, m_size.x);
+    computeGridLines(y, 0.f, top, bottom, m_size.y);
+
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int column = 0; column < 3; ++column)
+        {
+            Vertex* slice = m_vertices + (row * 3 + column) * 6;
+            for (int i = 0; i < 6; ++i)
+                slice[i].position = Vector2f(x[column + sliceCornerX[i]], y[row + sliceCornerY[i]]);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NineSliceSprite::updateTexCoords()
+{
+    // The texture is never shrunk, the grid lines are at the borders of the center
+    float u[4];
+    float v[4];
+    u[0] = static_cast<float>(m_textureRect.left);
+    u[1] = u[0] + m_centerRect.left;
+    u[2] = u[1] + m_centerRect.width;
+    u[3] = u[0] + m_textureRect.width;
+    v[0] = static_cast<float>(m_textureRect.top);
+    v[1] = v[0] + m_centerRect.top;
+    v[2] = v[1] + m_centerRect.height;
+    v[3] = v[0] + m_textureRect.height;
+
+    // Texture coordinates are normalized, like the ones of sprites
+    if (m_texture && (m_texture->getSize().x > 0) && (m_texture->getSize().y > 0))
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            u[i] /= static_cast<float>(m_texture->getSize().x);
+            v[i] /= static_cast<float>(m_texture->getSize().y);
+        }
+    }
+
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int column = 0; column < 3; ++column)
+        {
+            Vertex* slice = m_vertices + (row * 3 + column) * 6;
+            for (int i = 0; i < 6; ++i)
+                slice[i].texCoords = Vector2f(u[column + sliceCornerX[i]], v[row + sliceCornerY[i]]);
+        }
+    }
+}
+
+} // namespace sf
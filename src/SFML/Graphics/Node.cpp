@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Node.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Node::Node() :
+m_parent               (NULL),
+m_children             (),
+m_drawable             (NULL),
+m_worldTransform       (),
+m_inverseWorldTransform(),
+m_worldVersion         (0),
+m_localVersion         (0),
+m_parentVersion        (0),
+m_inverseVersion       (0),
+m_worldValid           (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Node::~Node()
+{
+    if (m_parent)
+        m_parent->detachChild(*this);
+
+    for (std::size_t i = 0; i < m_children.size(); ++i)
+    {
+        m_children[i]->m_parent = NULL;
+        m_children[i]->m_worldValid = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Node::attachChild(Node& child)
+{
+    if (child.m_parent == this)
+        return true;
+
+    // Attaching an ancestor would create a cycle
+    for (const Node* node = this; node; node = node->m_parent)
+    {
+        if (node == &child)
+        {
+            err() << "Failed to attach node: a node can't be attached to itself or to one of its descendants" << std::endl;
+            return false;
+        }
+    }
+
+    if (child.m_parent)
+        child.m_parent->detachChild(child);
+
+    m_children.push_back(&child);
+    child.m_parent = this;
+    child.m_worldValid = false;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::detachChild(Node& child)
+{
+    std::vector<Node*>::iterator it = std::find(m_children.begin(), m_children.end(), &child);
+    if (it == m_children.end())
+        return;
+
+    m_children.erase(it);
+    child.m_parent = NULL;
+    child.m_worldValid = false;
+}
+
+
+////////////////////////////////////////////////////////////
+Node* Node::getParent() const
+{
+    return m_parent;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<Node*>& Node::getChildren() const
+{
+    return m_children;
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::setDrawable(const Drawable* drawable)
+{
+    m_drawable = drawable;
+}
+
+
+////////////////////////////////////////////////////////////
+const Drawable* Node::getDrawable() const
+{
+    return m_drawable;
+}
+
+
+////////////////////////////////////////////////////////////
+const Transform& Node::getWorldTransform() const
+{
+    updateWorldTransform();
+
+    return m_worldTransform;
+}
+
+
+////////////////////////////////////////////////////////////
+const Transform& Node::getInverseWorldTransform() const
+{
+    const Uint32 version = updateWorldTransform();
+    if (m_inverseVersion != version)
+    {
+        m_inverseWorldTransform = m_worldTransform.getInverse();
+        m_inverseVersion = version;
+    }
+
+    return m_inverseWorldTransform;
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::draw(RenderTarget& target, RenderStates states) const
+{
+    states.transform *= getTransform();
+
+    if (m_drawable)
+        target.draw(*m_drawable, states);
+
+    for (std::size_t i = 0; i < m_children.size(); ++i)
+        target.draw(*m_children[i], states);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 Node::updateWorldTransform() const
+{
+    // Bring the ancestors up to date first, from the root down
+    const Uint32 parentVersion = m_parent ? m_parent->updateWorldTransform() : 0;
+
+    if (!m_worldValid || (m_localVersion != getTransformVersion()) || (m_parentVersion != parentVersion))
+    {
+        if (m_parent)
+            m_worldTransform = m_parent->m_worldTransform * getTransform();
+        else
+            m_worldTransform = getTransform();
+
+        m_localVersion = getTransformVersion();
+        m_parentVersion = parentVersion;
+        m_worldValid = true;
+
+        // Version 0 is never used, so that the inverse is computed on the first query
+        if (++m_worldVersion == 0)
+            ++m_worldVersion;
+    }
+
+    return m_worldVersion;
+}
+
+} // namespace sf
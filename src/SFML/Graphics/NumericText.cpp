@@ -0,0 +1,378 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/NumericText.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Indices of the characters of numbers in the glyph cache, after the 10 digits
+    const sf::Uint8 minusSign    = 10;
+    const sf::Uint8 decimalPoint = 11;
+
+    // Markers of the slots
+    const sf::Uint8 emptySlot    = 0xFF; // No character in the slot
+    const sf::Uint8 outdatedSlot = 0xFE; // The vertices of the slot must be written again
+
+    // Code points of the characters of the glyph cache
+    const sf::Uint32 codePoints[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '-', '.'};
+
+    // Append the decimal digits of a value, padded with zeros to a minimum number of digits
+    void appendDigits(std::vector<sf::Uint8>& characters, sf::Uint64 value, unsigned int minDigits)
+    {
+        sf::Uint8 digits[20];
+        unsigned int count = 0;
+        do
+        {
+            digits[count++] = static_cast<sf::Uint8>(value % 10);
+            value /= 10;
+        }
+        while ((value > 0) || (count < minDigits));
+
+        while (count > 0)
+            characters.push_back(digits[--count]);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+NumericText::NumericText() :
+m_font            (NULL),
+m_characterSize   (30),
+m_alignment       (Left),
+m_fillColor       (255, 255, 255),
+m_characters      (),
+m_slots           (8, outdatedSlot),
+m_vertices        (Triangles),
+m_slotWidth       (0),
+m_top             (0),
+m_bottom          (0),
+m_fontRevision    (0),
+m_glyphsNeedUpdate(true)
+{
+    m_characters.reserve(32);
+}
+
+
+////////////////////////////////////////////////////////////
+NumericText::NumericText(const Font& font, unsigned int characterSize, std::size_t slotCount) :
+m_font            (&font),
+m_characterSize   (characterSize),
+m_alignment       (Left),
+m_fillColor       (255, 255, 255),
+m_characters      (),
+m_slots           (slotCount, outdatedSlot),
+m_vertices        (Triangles),
+m_slotWidth       (0),
+m_top             (0),
+m_bottom          (0),
+m_fontRevision    (0),
+m_glyphsNeedUpdate(true)
+{
+    m_characters.reserve(32);
+}
+
+
+////////////////////////////////////////////////////////////
+void NumericText::setFont(const Font& font)
+{
+    if (m_font != &font)
+    {
+        m_font = &font;
+        m_glyphsNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Font* NumericText::getFont() const
+{
+    return m_font;
+}
+
+
+////////////////////////////////////////////////////////////
+void NumericText::setCharacterSize(unsigned int size)
+{
+    if (m_characterSize != size)
+    {
+        m_characterSize = size;
+        m_glyphsNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int NumericText::getCharacterSize() const
+{
+    return m_characterSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void NumericText::setSlotCount(std::size_t count)
+{
+    m_slots.assign(count, outdatedSlot);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t NumericText::getSlotCount() const
+{
+    return m_slots.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void NumericText::setAlignment(Alignment alignment)
+{
+    m_alignment = alignment;
+}
+
+
+////////////////////////////////////////////////////////////
+NumericText::Alignment NumericText::getAlignment() const
+{
+    return m_alignment;
+}
+
+
+////////////////////////////////////////////////////////////
+void NumericText::setFillColor(const Color& color)
+{
+    if (m_fillColor != color)
+    {
+        m_fillColor = color;
+        std::fill(m_slots.begin(), m_slots.end(), outdatedSlot);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& NumericText::getFillColor() const
+{
+    return m_fillColor;
+}
+
+
+////////////////////////////////////////////////////////////
+void NumericText::setValue(Int64 value)
+{
+    m_characters.clear();
+
+    if (value < 0)
+        m_characters.push_back(minusSign);
+
+    // The magnitude of the smallest value doesn't fit in an Int64
+    Uint64 magnitude = (value < 0) ? 0 - static_cast<Uint64>(value) : static_cast<Uint64>(value);
+    appendDigits(m_characters, magnitude, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void NumericText::setValue(double value, unsigned int decimals)
+{
+    m_characters.clear();
+
+    // Not a number: display nothing
+    if (value != value)
+        return;
+
+    decimals = std::min(decimals, 9u);
+    Uint64 scale = 1;
+    for (unsigned int i = 0; i < decimals; ++i)
+        scale *= 10;
+
+    // Round to the last decimal, and saturate the values too large for an Int64
+    double scaled = std::fabs(value) * static_cast<double>(scale) + 0.5;
+    Uint64 magnitude = (scaled < 9.2e18) ? static_cast<Uint64>(scaled) : static_cast<Uint64>(9.2e18);
+
+    if ((value < 0) && (magnitude > 0))
+        m_characters.push_back(minusSign);
+
+    appendDigits(m_characters, magnitude / scale, 1);
+
+    if (decimals > 0)
+    {
+        m_characters.push_back(decimalPoint);
+        appendDigits(m_characters, magnitude % scale, decimals);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect NumericText::getLocalBounds() const
+{
+    ensureGlyphsUpdate();
+
+    return FloatRect(0, m_top, m_slotWidth * static_cast<float>(m_slots.size()), m_bottom - m_top);
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect NumericText::getGlobalBounds() const
+{
+    return getTransformedBounds(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void NumericText::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_font)
+    {
+        ensureGeometryUpdate();
+
+        states.transform *= getTransform();
+        states.texture = &m_font->getTexture(m_characterSize);
+
+        target.draw(m_vertices, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool NumericText::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void NumericText::ensureGlyphsUpdate() const
+{
+    if (!m_font)
+        return;
+
+    // Add the glyphs loaded in the background, which may replace placeholders of the characters
+    m_font->commitGlyphs(false);
+
+    if (!m_glyphsNeedUpdate && (m_font->m_revision == m_fontRevision))
+        return;
+
+    // Load all the glyphs first, loading a glyph may move the glyphs loaded before it
+    for (std::size_t i = 0; i < CharacterCount; ++i)
+        m_font->getGlyph(codePoints[i], m_characterSize, false);
+
+    m_fontRevision = m_font->m_revision;
+    m_glyphsNeedUpdate = false;
+
+    // The slots are as wide as the largest character
+    m_slotWidth = 0;
+    m_top       = 0;
+    m_bottom    = 0;
+    for (std::size_t i = 0; i < CharacterCount; ++i)
+    {
+        const Glyph& glyph = m_font->getGlyph(codePoints[i], m_characterSize, false);
+        m_slotWidth = std::max(m_slotWidth, glyph.advance);
+        m_top       = std::min(m_top, glyph.bounds.top);
+        m_bottom    = std::max(m_bottom, glyph.bounds.top + glyph.bounds.height);
+    }
+
+    // Build the quad of each character, centered in its slot (same layout as the quads of sf::Text)
+    for (std::size_t i = 0; i < CharacterCount; ++i)
+    {
+        const Glyph& glyph = m_font->getGlyph(codePoints[i], m_characterSize, false);
+
+        float offset = std::floor((m_slotWidth - glyph.advance) / 2);
+        float left   = offset + glyph.bounds.left - 1;
+        float top    = glyph.bounds.top - 1;
+        float right  = offset + glyph.bounds.left + glyph.bounds.width + 1;
+        float bottom = glyph.bounds.top + glyph.bounds.height + 1;
+
+        float u1 = static_cast<float>(glyph.textureRect.left) - 1;
+        float v1 = static_cast<float>(glyph.textureRect.top) - 1;
+        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + 1;
+        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height) + 1;
+
+        Vertex* quad = m_quads[i];
+        quad[0] = Vertex(Vector2f(left,  top),    Vector2f(u1, v1));
+        quad[1] = Vertex(Vector2f(right, top),    Vector2f(u2, v1));
+        quad[2] = Vertex(Vector2f(left,  bottom), Vector2f(u1, v2));
+        quad[3] = Vertex(Vector2f(left,  bottom), Vector2f(u1, v2));
+        quad[4] = Vertex(Vector2f(right, top),    Vector2f(u2, v1));
+        quad[5] = Vertex(Vector2f(right, bottom), Vector2f(u2, v2));
+    }
+
+    // All the slots must be written again with the new quads
+    std::fill(m_slots.begin(), m_slots.end(), outdatedSlot);
+}
+
+
+////////////////////////////////////////////////////////////
+void NumericText::ensureGeometryUpdate() const
+{
+    ensureGlyphsUpdate();
+
+    std::size_t slotCount = m_slots.size();
+    if (m_vertices.getVertexCount() != slotCount * 6)
+    {
+        m_vertices.resize(slotCount * 6);
+        std::fill(m_slots.begin(), m_slots.end(), outdatedSlot);
+    }
+
+    // The characters that don't fit are not displayed
+    std::size_t length = std::min(m_characters.size(), slotCount);
+    std::size_t first  = (m_alignment == Right) ? slotCount - length : 0;
+
+    // Only write the slots whose character changed
+    for (std::size_t slot = 0; slot < slotCount; ++slot)
+    {
+        Uint8 character = ((slot >= first) && (slot < first + length)) ? m_characters[slot - first] : emptySlot;
+        if (m_slots[slot] == character)
+            continue;
+
+        m_slots[slot] = character;
+
+        Vertex* quad = &m_vertices[slot * 6];
+        if (character == emptySlot)
+        {
+            // Degenerate quad, nothing is rasterized
+            for (std::size_t i = 0; i < 6; ++i)
+                quad[i] = Vertex();
+        }
+        else
+        {
+            float x = m_slotWidth * static_cast<float>(slot);
+            for (std::size_t i = 0; i < 6; ++i)
+            {
+                quad[i] = m_quads[character][i];
+                quad[i].position.x += x;
+                quad[i].color = m_fillColor;
+            }
+        }
+    }
+}
+
+} // namespace sf
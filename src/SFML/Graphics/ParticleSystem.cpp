@@ -0,0 +1,363 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    const float degreesToRadians = 3.141592654f / 180.f;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ParticleSystem::Particle::Particle() :
+position       (0, 0),
+velocity       (0, 0),
+lifetime       (seconds(1.f)),
+startSize      (1.f),
+endSize        (1.f),
+rotation       (0.f),
+angularVelocity(0.f),
+startColor     (Color::White),
+endColor       (Color::White),
+textureRect    ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ParticleSystem::ParticleSystem() :
+m_particles (),
+m_spawnTimes(),
+m_capacity  (1024),
+m_next      (0),
+m_texture   (NULL),
+m_gravity   (0, 0),
+m_time      (0.f),
+m_deathTime (0.f),
+m_buffer    (0),
+m_bufferSize(0),
+m_dirtyBegin(0),
+m_dirtyCount(0),
+m_vertices  ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ParticleSystem::~ParticleSystem()
+{
+    if (m_buffer)
+        priv::getGLStateCache().deleteBuffer(m_buffer);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setCapacity(std::size_t capacity)
+{
+    m_capacity = capacity;
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getCapacity() const
+{
+    return m_capacity;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTexture(const Texture* texture)
+{
+    m_texture = texture;
+
+    // Texture rectangles are uploaded normalized
+    m_dirtyBegin = 0;
+    m_dirtyCount = m_particles.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* ParticleSystem::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setGravity(const Vector2f& gravity)
+{
+    m_gravity = gravity;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getGravity() const
+{
+    return m_gravity;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::emit(const Particle& particle)
+{
+    if ((m_capacity == 0) || (particle.lifetime <= Time::Zero))
+        return;
+
+    // Fill the ring, then replace the oldest particles
+    std::size_t slot = m_next;
+    if (slot == m_particles.size())
+    {
+        m_particles.push_back(particle);
+        m_spawnTimes.push_back(m_time);
+    }
+    else
+    {
+        m_particles[slot] = particle;
+        m_spawnTimes[slot] = m_time;
+    }
+
+    m_next = (slot + 1 < m_capacity) ? slot + 1 : 0;
+    m_deathTime = std::max(m_deathTime, m_time + particle.lifetime.asSeconds());
+
+    // Emitted slots are consecutive in the ring
+    if (m_dirtyCount == 0)
+        m_dirtyBegin = slot;
+    m_dirtyCount = std::min(m_dirtyCount + 1, m_capacity);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::emit(const Particle* particles, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        emit(particles[i]);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::update(Time elapsed)
+{
+    m_time += elapsed.asSeconds();
+
+    // Restart the clock when all the particles are dead, so that it never grows big enough to lose precision
+    if (m_time >= m_deathTime)
+        clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::clear()
+{
+    m_particles.clear();
+    m_spawnTimes.clear();
+    m_next = 0;
+    m_time = 0.f;
+    m_deathTime = 0.f;
+    m_dirtyBegin = 0;
+    m_dirtyCount = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ParticleSystem::isGpuSimulationAvailable()
+{
+    return priv::isInstancingAvailable();
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_particles.empty())
+        return;
+
+    states.texture = m_texture;
+
+    if (isGpuSimulationAvailable() && !states.shader)
+    {
+        uploadParticles();
+        target.drawParticleInstances(m_buffer, m_particles.size(), m_time, m_gravity, states);
+    }
+    else
+    {
+        simulateParticles();
+        if (!m_vertices.empty())
+            target.draw(&m_vertices[0], m_vertices.size(), Triangles, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::uploadParticles() const
+{
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
+    if (!m_buffer)
+        glCheck(glGenBuffers(1, &m_buffer));
+
+    cache.bindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+    // The buffer holds the whole ring, it is reallocated (and entirely uploaded) only when the capacity changes
+    if (m_bufferSize != m_capacity)
+    {
+        m_bufferSize = m_capacity;
+        glCheck(glBufferData(GL_ARRAY_BUFFER, sizeof(priv::ParticleInstance) * m_bufferSize, 0, GL_DYNAMIC_DRAW));
+
+        m_dirtyBegin = 0;
+        m_dirtyCount = m_particles.size();
+    }
+
+    if (m_dirtyCount == 0)
+        return;
+
+    Vector2f textureScale(0.f, 0.f);
+    if (m_texture && (m_texture->getSize().x > 0) && (m_texture->getSize().y > 0))
+        textureScale = Vector2f(1.f / m_texture->getSize().x, 1.f / m_texture->getSize().y);
+
+    std::vector<priv::ParticleInstance> instances;
+
+    // The emitted slots wrap around the end of the ring at most once
+    std::size_t first = m_dirtyBegin;
+    std::size_t remaining = std::min(m_dirtyCount, m_particles.size());
+    while (remaining > 0)
+    {
+        std::size_t count = std::min(remaining, m_particles.size() - first);
+        instances.resize(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Particle& particle = m_particles[first + i];
+            priv::ParticleInstance& instance = instances[i];
+
+            instance.motion[0] = particle.position.x;
+            instance.motion[1] = particle.position.y;
+            instance.motion[2] = particle.velocity.x;
+            instance.motion[3] = particle.velocity.y;
+
+            instance.life[0] = m_spawnTimes[first + i];
+            instance.life[1] = particle.lifetime.asSeconds();
+            instance.life[2] = particle.startSize;
+            instance.life[3] = particle.endSize;
+
+            instance.spin[0] = particle.rotation * degreesToRadians;
+            instance.spin[1] = particle.angularVelocity * degreesToRadians;
+
+            instance.texRect[0] = particle.textureRect.left   * textureScale.x;
+            instance.texRect[1] = particle.textureRect.top    * textureScale.y;
+            instance.texRect[2] = particle.textureRect.width  * textureScale.x;
+            instance.texRect[3] = particle.textureRect.height * textureScale.y;
+
+            instance.startColor[0] = particle.startColor.r;
+            instance.startColor[1] = particle.startColor.g;
+            instance.startColor[2] = particle.startColor.b;
+            instance.startColor[3] = particle.startColor.a;
+
+            instance.endColor[0] = particle.endColor.r;
+            instance.endColor[1] = particle.endColor.g;
+            instance.endColor[2] = particle.endColor.b;
+            instance.endColor[3] = particle.endColor.a;
+        }
+
+        glCheck(glBufferSubData(GL_ARRAY_BUFFER, sizeof(priv::ParticleInstance) * first,
+                                sizeof(priv::ParticleInstance) * count, instances.data()));
+        priv::getRenderStats().bytesUploaded += sizeof(priv::ParticleInstance) * count;
+
+        remaining -= count;
+        first = 0;
+    }
+
+    m_dirtyCount = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::simulateParticles() const
+{
+    // Same animation as the particle pipeline shader
+    static const float corners[4][2] = { {0.f, 0.f}, {0.f, 1.f}, {1.f, 1.f}, {1.f, 0.f} };
+    static const std::size_t order[6] = { 0, 1, 2, 0, 2, 3 };
+
+    Vector2f textureScale(0.f, 0.f);
+    if (m_texture && (m_texture->getSize().x > 0) && (m_texture->getSize().y > 0))
+        textureScale = Vector2f(1.f / m_texture->getSize().x, 1.f / m_texture->getSize().y);
+
+    m_vertices.resize(m_particles.size() * 6);
+    std::size_t out = 0;
+
+    for (std::size_t i = 0; i < m_particles.size(); ++i)
+    {
+        const Particle& particle = m_particles[i];
+
+        float age = m_time - m_spawnTimes[i];
+        float progress = age / particle.lifetime.asSeconds();
+        if ((progress < 0.f) || (progress > 1.f))
+            continue;
+
+        Vector2f center = particle.position + particle.velocity * age + m_gravity * (0.5f * age * age);
+        float size = particle.startSize + (particle.endSize - particle.startSize) * progress;
+        float angle = (particle.rotation + particle.angularVelocity * age) * degreesToRadians;
+        float cosine = std::cos(angle);
+        float sine = std::sin(angle);
+
+        Color color(static_cast<Uint8>(particle.startColor.r + (particle.endColor.r - particle.startColor.r) * progress),
+                    static_cast<Uint8>(particle.startColor.g + (particle.endColor.g - particle.startColor.g) * progress),
+                    static_cast<Uint8>(particle.startColor.b + (particle.endColor.b - particle.startColor.b) * progress),
+                    static_cast<Uint8>(particle.startColor.a + (particle.endColor.a - particle.startColor.a) * progress));
+
+        for (std::size_t j = 0; j < 6; ++j)
+        {
+            float x = corners[order[j]][0];
+            float y = corners[order[j]][1];
+            float offsetX = (x - 0.5f) * size;
+            float offsetY = (y - 0.5f) * size;
+
+            Vertex& vertex = m_vertices[out++];
+            vertex.position.x  = center.x + offsetX * cosine - offsetY * sine;
+            vertex.position.y  = center.y + offsetX * sine + offsetY * cosine;
+            vertex.color       = color;
+            vertex.texCoords.x = (particle.textureRect.left + x * particle.textureRect.width) * textureScale.x;
+            vertex.texCoords.y = (particle.textureRect.top + y * particle.textureRect.height) * textureScale.y;
+        }
+    }
+
+    m_vertices.resize(out);
+}
+
+} // namespace sf
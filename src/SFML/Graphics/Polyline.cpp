@@ -0,0 +1,426 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Polyline.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Vertices of the two caps, at the beginning of the geometry
+    const std::size_t capVertexCount = 12;
+
+    // Vertices of a segment: the join at its first point (two triangles), then its quad
+    const std::size_t segmentVertexCount = 12;
+
+    // Longest miter allowed, relative to the half-thickness (same default as SVG)
+    const float miterLimit = 4.f;
+
+    // Compute the unit direction of a segment (zero if it is degenerate)
+    sf::Vector2f computeDirection(const sf::Vector2f& p0, const sf::Vector2f& p1)
+    {
+        sf::Vector2f direction = p1 - p0;
+        float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+        if (length != 0.f)
+            direction /= length;
+        return direction;
+    }
+
+    // Collapse a triangle to a single point, so that it is not rasterized
+    void collapse(sf::Vertex* vertices, const sf::Vector2f& point)
+    {
+        vertices[0].position = point;
+        vertices[1].position = point;
+        vertices[2].position = point;
+    }
+
+    // Build the two triangles of a quad (a, b, c, d in strip order)
+    void makeQuad(sf::Vertex* vertices, const sf::Vector2f& a, const sf::Vector2f& b,
+                  const sf::Vector2f& c, const sf::Vector2f& d)
+    {
+        vertices[0].position = a;
+        vertices[1].position = b;
+        vertices[2].position = c;
+        vertices[3].position = c;
+        vertices[4].position = b;
+        vertices[5].position = d;
+    }
+
+    // Extend a bounding rectangle with a range of vertices
+    sf::FloatRect extendBounds(const sf::FloatRect& bounds, bool valid, const sf::Vertex* vertices, std::size_t count)
+    {
+        if (count == 0)
+            return bounds;
+
+        sf::Vector2f min = valid ? sf::Vector2f(bounds.left, bounds.top) : vertices[0].position;
+        sf::Vector2f max = valid ? sf::Vector2f(bounds.left + bounds.width, bounds.top + bounds.height) : vertices[0].position;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const sf::Vector2f& position = vertices[i].position;
+            min.x = std::min(min.x, position.x);
+            min.y = std::min(min.y, position.y);
+            max.x = std::max(max.x, position.x);
+            max.y = std::max(max.y, position.y);
+        }
+
+        return sf::FloatRect(min, max - min);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Polyline::Polyline() :
+m_points     (),
+m_vertices   (),
+m_thickness  (1.f),
+m_color      (Color::White),
+m_joinStyle  (MiterJoin),
+m_capStyle   (ButtCap),
+m_dirtyBegin (0),
+m_dirtyEnd   (0),
+m_boundsValid(false),
+m_bounds     ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::addPoint(const Vector2f& point)
+{
+    m_points.push_back(point);
+
+    // The new segment, its join with the previous one, and the caps;
+    // the bounds only grow, so they are extended rather than recomputed
+    if (m_points.size() >= 2)
+        invalidate(m_points.size() - 2, m_points.size() - 2);
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::setPoint(std::size_t index, const Vector2f& point)
+{
+    m_points[index] = point;
+
+    // Both segments sharing the point, and the join that follows them
+    invalidate((index > 0) ? index - 1 : 0, index + 1);
+    m_boundsValid = false;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& Polyline::getPoint(std::size_t index) const
+{
+    return m_points[index];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Polyline::getPointCount() const
+{
+    return m_points.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::clear()
+{
+    m_points.clear();
+    m_vertices.clear();
+    m_dirtyBegin = m_dirtyEnd = 0;
+    m_boundsValid = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::reserve(std::size_t pointCount)
+{
+    m_points.reserve(pointCount);
+    m_vertices.reserve(capVertexCount + pointCount * segmentVertexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::setThickness(float thickness)
+{
+    if (thickness != m_thickness)
+    {
+        m_thickness = thickness;
+        invalidate(0, m_points.size());
+        m_boundsValid = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float Polyline::getThickness() const
+{
+    return m_thickness;
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::setColor(const Color& color)
+{
+    m_color = color;
+
+    // The geometry doesn't change, only recolor it
+    for (std::size_t i = 0; i < m_vertices.size(); ++i)
+        m_vertices[i].color = color;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& Polyline::getColor() const
+{
+    return m_color;
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::setJoinStyle(JoinStyle style)
+{
+    if (style != m_joinStyle)
+    {
+        m_joinStyle = style;
+        invalidate(0, m_points.size());
+        m_boundsValid = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Polyline::JoinStyle Polyline::getJoinStyle() const
+{
+    return m_joinStyle;
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::setCapStyle(CapStyle style)
+{
+    if (style != m_capStyle)
+    {
+        m_capStyle = style;
+        m_boundsValid = false;
+
+        // Only the caps change; they are rebuilt with any dirty range
+        if (m_dirtyBegin >= m_dirtyEnd)
+            invalidate(0, 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Polyline::CapStyle Polyline::getCapStyle() const
+{
+    return m_capStyle;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect Polyline::getLocalBounds() const
+{
+    update();
+
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect Polyline::getGlobalBounds() const
+{
+    return getTransformedBounds(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::draw(RenderTarget& target, RenderStates states) const
+{
+    update();
+
+    if (!m_vertices.empty())
+    {
+        states.transform *= getTransform();
+        states.texture = NULL;
+        target.draw(&m_vertices[0], m_vertices.size(), Triangles, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Polyline::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::invalidate(std::size_t first, std::size_t last)
+{
+    if (m_dirtyBegin >= m_dirtyEnd)
+    {
+        m_dirtyBegin = first;
+        m_dirtyEnd = last + 1;
+    }
+    else
+    {
+        m_dirtyBegin = std::min(m_dirtyBegin, first);
+        m_dirtyEnd = std::max(m_dirtyEnd, last + 1);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::update() const
+{
+    if (m_dirtyBegin >= m_dirtyEnd)
+        return;
+
+    std::size_t segmentCount = (m_points.size() >= 2) ? m_points.size() - 1 : 0;
+    std::size_t begin = std::min(m_dirtyBegin, segmentCount);
+    std::size_t end = std::min(m_dirtyEnd, segmentCount);
+    m_dirtyBegin = m_dirtyEnd = 0;
+
+    if (segmentCount == 0)
+    {
+        m_vertices.clear();
+        m_bounds = FloatRect();
+        m_boundsValid = false;
+        return;
+    }
+
+    // New vertices get the color of the line, the others already have it
+    m_vertices.resize(capVertexCount + segmentCount * segmentVertexCount, Vertex(Vector2f(), m_color));
+
+    for (std::size_t i = begin; i < end; ++i)
+        updateSegment(i);
+    updateCaps();
+
+    // The bounds are recomputed after a modification, and only extended after an append
+    if (m_boundsValid)
+    {
+        m_bounds = extendBounds(m_bounds, true, &m_vertices[0], capVertexCount);
+        m_bounds = extendBounds(m_bounds, true, &m_vertices[capVertexCount + begin * segmentVertexCount],
+                                (end - begin) * segmentVertexCount);
+    }
+    else
+    {
+        m_bounds = extendBounds(FloatRect(), false, &m_vertices[0], m_vertices.size());
+        m_boundsValid = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::updateSegment(std::size_t index) const
+{
+    const Vector2f& p0 = m_points[index];
+    const Vector2f& p1 = m_points[index + 1];
+
+    Vector2f direction = computeDirection(p0, p1);
+    float halfThickness = m_thickness / 2.f;
+    Vector2f normal(-direction.y * halfThickness, direction.x * halfThickness);
+
+    Vertex* vertices = &m_vertices[capVertexCount + index * segmentVertexCount];
+
+    // Join with the previous segment, filling the gap on the outer side of the corner
+    collapse(vertices + 0, p0);
+    collapse(vertices + 3, p0);
+
+    if (index > 0)
+    {
+        Vector2f previousDirection = computeDirection(m_points[index - 1], p0);
+        Vector2f previousNormal(-previousDirection.y * halfThickness, previousDirection.x * halfThickness);
+
+        float cross = previousDirection.x * direction.y - previousDirection.y * direction.x;
+        if (cross != 0.f)
+        {
+            float side = (cross > 0.f) ? -1.f : 1.f;
+            Vector2f a = p0 + previousNormal * side;
+            Vector2f b = p0 + normal * side;
+
+            // Bevel
+            vertices[1].position = a;
+            vertices[2].position = b;
+
+            // Miter, unless it would be longer than the limit
+            float dot = previousDirection.x * direction.x + previousDirection.y * direction.y;
+            if ((m_joinStyle == MiterJoin) && (1.f + dot >= 2.f / (miterLimit * miterLimit)))
+            {
+                vertices[3].position = a;
+                vertices[4].position = p0 + (previousNormal + normal) * (side / (1.f + dot));
+                vertices[5].position = b;
+            }
+        }
+    }
+
+    // Body of the segment
+    makeQuad(vertices + 6, p0 + normal, p0 - normal, p1 + normal, p1 - normal);
+
+    for (std::size_t i = 0; i < segmentVertexCount; ++i)
+        vertices[i].color = m_color;
+}
+
+
+////////////////////////////////////////////////////////////
+void Polyline::updateCaps() const
+{
+    std::size_t last = m_points.size() - 1;
+    const Vector2f& first = m_points[0];
+    const Vector2f& end = m_points[last];
+
+    collapse(&m_vertices[0], first);
+    collapse(&m_vertices[3], first);
+    collapse(&m_vertices[6], end);
+    collapse(&m_vertices[9], end);
+
+    if (m_capStyle == SquareCap)
+    {
+        float halfThickness = m_thickness / 2.f;
+
+        Vector2f direction = computeDirection(first, m_points[1]);
+        Vector2f normal(-direction.y * halfThickness, direction.x * halfThickness);
+        Vector2f back = first - direction * halfThickness;
+        makeQuad(&m_vertices[0], back + normal, back - normal, first + normal, first - normal);
+
+        direction = computeDirection(m_points[last - 1], end);
+        normal = Vector2f(-direction.y * halfThickness, direction.x * halfThickness);
+        Vector2f front = end + direction * halfThickness;
+        makeQuad(&m_vertices[6], end + normal, end - normal, front + normal, front - normal);
+    }
+
+    for (std::size_t i = 0; i < capVertexCount; ++i)
+        m_vertices[i].color = m_color;
+}
+
+} // namespace sf
@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PostProcess.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Trace.hpp>
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+    // The passes draw a quad given in clip space, so they don't depend on the view of the target
+    const char* passVertexShader =
+        "#version 100                                                   \n"
+        "precision mediump float;                                       \n"
+        "attribute vec2 aPos;                                           \n"
+        "attribute vec4 aColor;                                         \n"
+        "attribute vec2 aTexCoord;                                      \n"
+        "varying vec2 oTexCoord;                                        \n"
+        "void main()                                                    \n"
+        "{                                                              \n"
+        "   oTexCoord = aTexCoord;                                      \n"
+        "   gl_Position = vec4(aPos, 0.0, 1.0);                         \n"
+        "}\n";
+
+    // Center and the four diagonal corners, half a texel away so that each tap averages 4 texels
+    const char* downsampleFragmentShader =
+        "#version 100                                                   \n"
+        "precision mediump float;                                       \n"
+        "uniform sampler2D uSource;                                     \n"
+        "uniform vec2 uHalfTexel;                                       \n"
+        "varying vec2 oTexCoord;                                        \n"
+        "void main()                                                    \n"
+        "{                                                              \n"
+        "   vec4 sum = texture2D(uSource, oTexCoord) * 4.0;             \n"
+        "   sum += texture2D(uSource, oTexCoord - uHalfTexel);          \n"
+        "   sum += texture2D(uSource, oTexCoord + uHalfTexel);          \n"
+        "   sum += texture2D(uSource, oTexCoord + vec2(uHalfTexel.x, -uHalfTexel.y)); \n"
+        "   sum += texture2D(uSource, oTexCoord - vec2(uHalfTexel.x, -uHalfTexel.y)); \n"
+        "   gl_FragColor = sum / 8.0;                                   \n"
+        "}\n";
+
+    // Tent around the pixel: four edge taps and four diagonal taps of double weight
+    const char* upsampleFragmentShader =
+        "#version 100                                                   \n"
+        "precision mediump float;                                       \n"
+        "uniform sampler2D uSource;                                     \n"
+        "uniform vec2 uHalfTexel;                                       \n"
+        "varying vec2 oTexCoord;                                        \n"
+        "void main()                                                    \n"
+        "{                                                              \n"
+        "   vec2 h = uHalfTexel;                                        \n"
+        "   vec4 sum = texture2D(uSource, oTexCoord + vec2(-h.x * 2.0, 0.0)); \n"
+        "   sum += texture2D(uSource, oTexCoord + vec2(h.x * 2.0, 0.0));      \n"
+        "   sum += texture2D(uSource, oTexCoord + vec2(0.0, -h.y * 2.0));     \n"
+        "   sum += texture2D(uSource, oTexCoord + vec2(0.0, h.y * 2.0));      \n"
+        "   sum += texture2D(uSource, oTexCoord + vec2(-h.x, h.y)) * 2.0;     \n"
+        "   sum += texture2D(uSource, oTexCoord + vec2(h.x, h.y)) * 2.0;      \n"
+        "   sum += texture2D(uSource, oTexCoord + vec2(h.x, -h.y)) * 2.0;     \n"
+        "   sum += texture2D(uSource, oTexCoord + vec2(-h.x, -h.y)) * 2.0;    \n"
+        "   gl_FragColor = sum / 12.0;                                  \n"
+        "}\n";
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PostProcess::PostProcess(RenderTexturePool& pool) :
+m_pool         (&pool),
+m_downsample   (),
+m_upsample     (),
+m_shadersReady (false),
+m_shadersFailed(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* PostProcess::blur(const Texture& source, unsigned int iterations, float offset)
+{
+    SFML_TRACE_SCOPE("PostProcess::blur");
+
+    Vector2u size = source.getSize();
+    if ((size.x == 0) || (size.y == 0) || (iterations == 0))
+        return NULL;
+
+    if (!createBlurShaders())
+        return NULL;
+
+    // Downsample chain: each level is half the size of the previous one
+    std::vector<RenderTexture*> levels;
+    levels.reserve(iterations);
+
+    const Texture* input = &source;
+    for (unsigned int i = 0; i < iterations; ++i)
+    {
+        Vector2u levelSize(std::max(size.x >> (i + 1), 1u), std::max(size.y >> (i + 1), 1u));
+
+        RenderTexture* level = m_pool->acquire(levelSize.x, levelSize.y);
+        if (!level)
+        {
+            for (std::size_t j = 0; j < levels.size(); ++j)
+                m_pool->release(*levels[j]);
+            return NULL;
+        }
+
+        level->setSmooth(true);
+        drawPass(*input, *level, m_downsample, offset);
+
+        levels.push_back(level);
+        input = &level->getTexture();
+    }
+
+    // Upsample chain: walk the levels back up, the last pass writes at the size of the source
+    RenderTexture* output = levels.back();
+    for (unsigned int i = iterations; i > 0; --i)
+    {
+        Vector2u levelSize = (i > 1) ? levels[i - 2]->getSize() : size;
+
+        // The matching downsample level is read by nobody else, write over it
+        RenderTexture* target = (i > 1) ? levels[i - 2] : m_pool->acquire(levelSize.x, levelSize.y);
+        if (!target)
+        {
+            m_pool->release(*output);
+            return NULL;
+        }
+
+        target->setSmooth(true);
+        drawPass(output->getTexture(), *target, m_upsample, offset);
+
+        m_pool->release(*output);
+        output = target;
+    }
+
+    return &output->getTexture();
+}
+
+
+////////////////////////////////////////////////////////////
+bool PostProcess::createBlurShaders()
+{
+    if (m_shadersReady)
+        return true;
+
+    // Don't try to compile again every frame
+    if (m_shadersFailed)
+        return false;
+
+    // Order should match sf::Vertex
+    m_downsample.setAttributes({ "aPos", "aColor", "aTexCoord" });
+    m_upsample.setAttributes({ "aPos", "aColor", "aTexCoord" });
+
+    if (!m_downsample.loadFromMemory(passVertexShader, downsampleFragmentShader) ||
+        !m_upsample.loadFromMemory(passVertexShader, upsampleFragmentShader))
+    {
+        err() << "Failed to create the blur shaders of the post-process" << std::endl;
+        m_shadersFailed = true;
+        return false;
+    }
+
+    m_shadersReady = true;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcess::drawPass(const Texture& source, RenderTexture& target, Shader& shader, float offset)
+{
+    // Render textures store their rows bottom-up like the target, other textures must be flipped
+    float bottom = source.isFlipped() ? 0.f : 1.f;
+    float top    = source.isFlipped() ? 1.f : 0.f;
+
+    Vertex quad[4] =
+    {
+        Vertex(Vector2f(-1.f, -1.f), Vector2f(0.f, bottom)),
+        Vertex(Vector2f( 1.f, -1.f), Vector2f(1.f, bottom)),
+        Vertex(Vector2f(-1.f,  1.f), Vector2f(0.f, top)),
+        Vertex(Vector2f( 1.f,  1.f), Vector2f(1.f, top))
+    };
+
+    Vector2u size = source.getSize();
+    shader.setUniform("uSource", source);
+    shader.setUniform("uHalfTexel", Glsl::Vec2(0.5f * offset / size.x, 0.5f * offset / size.y));
+
+    RenderStates states(BlendNone);
+    states.shader = &shader;
+
+    target.beginPass(RenderTarget::DiscardContents);
+    target.draw(quad, 4, TriangleStrip, states);
+    target.display();
+}
+
+} // namespace sf
@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/QoiCodec.hpp>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace
+{
+    // Format specification: https://qoiformat.org/qoi-specification.pdf
+    const std::size_t headerSize = 14;
+    const std::size_t endMarkerSize = 8;
+    const sf::Uint8   endMarker[endMarkerSize] = {0, 0, 0, 0, 0, 0, 0, 1};
+
+    // Same limit as the reference implementation, it keeps width * height * 4 far from overflowing
+    const sf::Uint64  maxPixels = 400000000;
+
+    const sf::Uint8   opIndex = 0x00; // 00xxxxxx
+    const sf::Uint8   opDiff  = 0x40; // 01xxxxxx
+    const sf::Uint8   opLuma  = 0x80; // 10xxxxxx
+    const sf::Uint8   opRun   = 0xc0; // 11xxxxxx
+    const sf::Uint8   opRgb   = 0xfe;
+    const sf::Uint8   opRgba  = 0xff;
+    const sf::Uint8   opMask  = 0xc0;
+
+    inline unsigned int hashPixel(const sf::Uint8* pixel)
+    {
+        return (pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64;
+    }
+
+    inline sf::Uint32 readBigEndian(const sf::Uint8* bytes)
+    {
+        return (static_cast<sf::Uint32>(bytes[0]) << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+    }
+
+    inline void writeBigEndian(sf::Uint8* bytes, sf::Uint32 value)
+    {
+        bytes[0] = static_cast<sf::Uint8>(value >> 24);
+        bytes[1] = static_cast<sf::Uint8>(value >> 16);
+        bytes[2] = static_cast<sf::Uint8>(value >> 8);
+        bytes[3] = static_cast<sf::Uint8>(value);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool isQoiImage(const void* data, std::size_t dataSize)
+{
+    return data && (dataSize >= 4) && (std::memcmp(data, "qoif", 4) == 0);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* decodeQoiImage(const void* data, std::size_t dataSize, Vector2u& size, const char*& error)
+{
+    if (!isQoiImage(data, dataSize) || (dataSize < headerSize + endMarkerSize))
+    {
+        error = "not a QOI image";
+        return NULL;
+    }
+
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    Uint32 width    = readBigEndian(bytes + 4);
+    Uint32 height   = readBigEndian(bytes + 8);
+    Uint8  channels = bytes[12];
+    if ((width == 0) || (height == 0) || (static_cast<Uint64>(width) * height > maxPixels) || (channels < 3) || (channels > 4))
+    {
+        error = "corrupt QOI header";
+        return NULL;
+    }
+
+    std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+    Uint8* pixels = static_cast<Uint8*>(std::malloc(pixelCount * 4));
+    if (!pixels)
+    {
+        error = "out of memory";
+        return NULL;
+    }
+
+    Uint8 index[64 * 4];
+    std::memset(index, 0, sizeof(index));
+    Uint8 pixel[4] = {0, 0, 0, 255};
+
+    // The last chunk can't start in the end marker, which bounds every read below
+    const Uint8* chunk = bytes + headerSize;
+    const Uint8* chunksEnd = bytes + dataSize - endMarkerSize;
+    unsigned int run = 0;
+
+    Uint8* output = pixels;
+    Uint8* outputEnd = pixels + pixelCount * 4;
+    for (; output < outputEnd; output += 4)
+    {
+        if (run > 0)
+        {
+            --run;
+        }
+        else if (chunk < chunksEnd)
+        {
+            Uint8 op = *chunk++;
+            if (op == opRgb)
+            {
+                pixel[0] = chunk[0];
+                pixel[1] = chunk[1];
+                pixel[2] = chunk[2];
+                chunk += 3;
+            }
+            else if (op == opRgba)
+            {
+                pixel[0] = chunk[0];
+                pixel[1] = chunk[1];
+                pixel[2] = chunk[2];
+                pixel[3] = chunk[3];
+                chunk += 4;
+            }
+            else if ((op & opMask) == opIndex)
+            {
+                std::memcpy(pixel, index + op * 4, 4);
+            }
+            else if ((op & opMask) == opDiff)
+            {
+                pixel[0] = static_cast<Uint8>(pixel[0] + ((op >> 4) & 0x03) - 2);
+                pixel[1] = static_cast<Uint8>(pixel[1] + ((op >> 2) & 0x03) - 2);
+                pixel[2] = static_cast<Uint8>(pixel[2] + (op & 0x03) - 2);
+            }
+            else if ((op & opMask) == opLuma)
+            {
+                int greenDiff = (op & 0x3f) - 32;
+                Uint8 next = *chunk++;
+                pixel[0] = static_cast<Uint8>(pixel[0] + greenDiff - 8 + ((next >> 4) & 0x0f));
+                pixel[1] = static_cast<Uint8>(pixel[1] + greenDiff);
+                pixel[2] = static_cast<Uint8>(pixel[2] + greenDiff - 8 + (next & 0x0f));
+            }
+            else
+            {
+                run = op & 0x3f;
+            }
+
+            std::memcpy(index + hashPixel(pixel) * 4, pixel, 4);
+        }
+
+        // Truncated files end with the last decoded pixel, like the reference decoder
+        std::memcpy(output, pixel, 4);
+    }
+
+    // 3 channel images are stored opaque, the header only describes their original contents
+    size.x = width;
+    size.y = height;
+
+    return pixels;
+}
+
+
+////////////////////////////////////////////////////////////
+void encodeQoiImage(std::vector<Uint8>& output, const Uint8* pixels, const Vector2u& size)
+{
+    std::size_t pixelCount = static_cast<std::size_t>(size.x) * size.y;
+
+    // Worst case: one RGBA chunk per pixel
+    output.resize(headerSize + pixelCount * 5 + endMarkerSize);
+    Uint8* bytes = &output[0];
+
+    std::memcpy(bytes, "qoif", 4);
+    writeBigEndian(bytes + 4, size.x);
+    writeBigEndian(bytes + 8, size.y);
+    bytes[12] = 4; // channels
+    bytes[13] = 0; // sRGB with linear alpha
+    bytes += headerSize;
+
+    Uint8 index[64 * 4];
+    std::memset(index, 0, sizeof(index));
+    Uint8 previous[4] = {0, 0, 0, 255};
+    unsigned int run = 0;
+
+    const Uint8* end = pixels + pixelCount * 4;
+    for (const Uint8* pixel = pixels; pixel < end; pixel += 4)
+    {
+        if (std::memcmp(pixel, previous, 4) == 0)
+        {
+            ++run;
+            if ((run == 62) || (pixel + 4 == end))
+            {
+                *bytes++ = static_cast<Uint8>(opRun | (run - 1));
+                run = 0;
+            }
+            continue;
+        }
+
+        if (run > 0)
+        {
+            *bytes++ = static_cast<Uint8>(opRun | (run - 1));
+            run = 0;
+        }
+
+        unsigned int hash = hashPixel(pixel);
+        if (std::memcmp(index + hash * 4, pixel, 4) == 0)
+        {
+            *bytes++ = static_cast<Uint8>(opIndex | hash);
+        }
+        else
+        {
+            std::memcpy(index + hash * 4, pixel, 4);
+
+            if (pixel[3] == previous[3])
+            {
+                // Differences wrap around, like the byte arithmetic of the decoder
+                int red   = static_cast<signed char>(pixel[0] - previous[0]);
+                int green = static_cast<signed char>(pixel[1] - previous[1]);
+                int blue  = static_cast<signed char>(pixel[2] - previous[2]);
+                int redGreen  = red - green;
+                int blueGreen = blue - green;
+
+                if ((red >= -2) && (red <= 1) && (green >= -2) && (green <= 1) && (blue >= -2) && (blue <= 1))
+                {
+                    *bytes++ = static_cast<Uint8>(opDiff | ((red + 2) << 4) | ((green + 2) << 2) | (blue + 2));
+                }
+                else if ((green >= -32) && (green <= 31) && (redGreen >= -8) && (redGreen <= 7) && (blueGreen >= -8) && (blueGreen <= 7))
+                {
+                    *bytes++ = static_cast<Uint8>(opLuma | (green + 32));
+                    *bytes++ = static_cast<Uint8>(((redGreen + 8) << 4) | (blueGreen + 8));
+                }
+                else
+                {
+                    *bytes++ = opRgb;
+                    *bytes++ = pixel[0];
+                    *bytes++ = pixel[1];
+                    *bytes++ = pixel[2];
+                }
+            }
+            else
+            {
+                *bytes++ = opRgba;
+                *bytes++ = pixel[0];
+                *bytes++ = pixel[1];
+                *bytes++ = pixel[2];
+                *bytes++ = pixel[3];
+            }
+        }
+
+        std::memcpy(previous, pixel, 4);
+    }
+
+    std::memcpy(bytes, endMarker, endMarkerSize);
+    bytes += endMarkerSize;
+
+    output.resize(static_cast<std::size_t>(bytes - &output[0]));
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RectBatch.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <algorithm>
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+    #include <xmmintrin.h>
+    #define SFML_RECTBATCH_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_RECTBATCH_NEON
+#elif defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define SFML_RECTBATCH_WASM_SIMD
+#endif
+
+
+namespace
+{
+    // Sides of the empty slots: nothing is inside, nothing intersects them
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    // Append the indices of the bits set in the 4-bit mask of a block
+    inline void appendMask(int mask, std::size_t block, std::vector<std::size_t>& indices)
+    {
+        for (std::size_t lane = 0; mask != 0; ++lane, mask >>= 1)
+        {
+            if (mask & 1)
+                indices.push_back(block + lane);
+        }
+    }
+
+#if defined(SFML_RECTBATCH_NEON)
+
+    // NEON has no movemask instruction
+    inline int moveMask(uint32x4_t lanes)
+    {
+        return static_cast<int>((vgetq_lane_u32(lanes, 0) & 1) | (vgetq_lane_u32(lanes, 1) & 2) |
+                                (vgetq_lane_u32(lanes, 2) & 4) | (vgetq_lane_u32(lanes, 3) & 8));
+    }
+
+#endif
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RectBatch::RectBatch() :
+m_count(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void RectBatch::clear()
+{
+    m_minX.clear();
+    m_minY.clear();
+    m_maxX.clear();
+    m_maxY.clear();
+    m_count = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void RectBatch::reserve(std::size_t count)
+{
+    const std::size_t padded = (count + 3) & ~static_cast<std::size_t>(3);
+    m_minX.reserve(padded);
+    m_minY.reserve(padded);
+    m_maxX.reserve(padded);
+    m_maxY.reserve(padded);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RectBatch::add(const FloatRect& rectangle)
+{
+    // Open a new block of 4 empty slots when the last one is full
+    if (m_count % 4 == 0)
+    {
+        m_minX.resize(m_count + 4, infinity);
+        m_minY.resize(m_count + 4, infinity);
+        m_maxX.resize(m_count + 4, -infinity);
+        m_maxY.resize(m_count + 4, -infinity);
+    }
+
+    set(m_count, rectangle);
+
+    return m_count++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RectBatch::set(std::size_t index, const FloatRect& rectangle)
+{
+    // Rectangles with negative dimensions are allowed, so we must handle them correctly
+    const float minX = std::min(rectangle.left, rectangle.left + rectangle.width);
+    const float maxX = std::max(rectangle.left, rectangle.left + rectangle.width);
+    const float minY = std::min(rectangle.top, rectangle.top + rectangle.height);
+    const float maxY = std::max(rectangle.top, rectangle.top + rectangle.height);
+
+    // Flat rectangles never intersect anything, store them as empty slots
+    // so that the intersection test only has to compare the sides once
+    const bool empty = !(minX < maxX) || !(minY < maxY);
+
+    m_minX[index] = empty ? infinity : minX;
+    m_minY[index] = empty ? infinity : minY;
+    m_maxX[index] = empty ? -infinity : maxX;
+    m_maxY[index] = empty ? -infinity : maxY;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RectBatch::getCount() const
+{
+    return m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RectBatch::findContaining(const Vector2f& point, std::vector<std::size_t>& indices) const
+{
+    indices.clear();
+
+    // The empty slots that pad the last block never contain anything
+    const std::size_t size = m_minX.size();
+
+#if defined(SFML_RECTBATCH_SSE)
+
+    const __m128 x = _mm_set1_ps(point.x);
+    const __m128 y = _mm_set1_ps(point.y);
+
+    for (std::size_t i = 0; i < size; i += 4)
+    {
+        const __m128 insideX = _mm_and_ps(_mm_cmpge_ps(x, _mm_loadu_ps(&m_minX[i])), _mm_cmplt_ps(x, _mm_loadu_ps(&m_maxX[i])));
+        const __m128 insideY = _mm_and_ps(_mm_cmpge_ps(y, _mm_loadu_ps(&m_minY[i])), _mm_cmplt_ps(y, _mm_loadu_ps(&m_maxY[i])));
+        appendMask(_mm_movemask_ps(_mm_and_ps(insideX, insideY)), i, indices);
+    }
+
+#elif defined(SFML_RECTBATCH_NEON)
+
+    const float32x4_t x = vdupq_n_f32(point.x);
+    const float32x4_t y = vdupq_n_f32(point.y);
+
+    for (std::size_t i = 0; i < size; i += 4)
+    {
+        const uint32x4_t insideX = vandq_u32(vcgeq_f32(x, vld1q_f32(&m_minX[i])), vcltq_f32(x, vld1q_f32(&m_maxX[i])));
+        const uint32x4_t insideY = vandq_u32(vcgeq_f32(y, vld1q_f32(&m_minY[i])), vcltq_f32(y, vld1q_f32(&m_maxY[i])));
+        appendMask(moveMask(vandq_u32(insideX, insideY)), i, indices);
+    }
+
+#elif defined(SFML_RECTBATCH_WASM_SIMD)
+
+    const v128_t x = wasm_f32x4_splat(point.x);
+    const v128_t y = wasm_f32x4_splat(point.y);
+
+    for (std::size_t i = 0; i < size; i += 4)
+    {
+        const v128_t insideX = wasm_v128_and(wasm_f32x4_ge(x, wasm_v128_load(&m_minX[i])), wasm_f32x4_lt(x, wasm_v128_load(&m_maxX[i])));
+        const v128_t insideY = wasm_v128_and(wasm_f32x4_ge(y, wasm_v128_load(&m_minY[i])), wasm_f32x4_lt(y, wasm_v128_load(&m_maxY[i])));
+        appendMask(wasm_i32x4_bitmask(wasm_v128_and(insideX, insideY)), i, indices);
+    }
+
+#else
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if ((point.x >= m_minX[i]) && (point.x < m_maxX[i]) && (point.y >= m_minY[i]) && (point.y < m_maxY[i]))
+            indices.push_back(i);
+    }
+
+#endif
+
+    return indices.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RectBatch::findIntersecting(const FloatRect& rectangle, std::vector<std::size_t>& indices) const
+{
+    indices.clear();
+
+    const float minX = std::min(rectangle.left, rectangle.left + rectangle.width);
+    const float maxX = std::max(rectangle.left, rectangle.left + rectangle.width);
+    const float minY = std::min(rectangle.top, rectangle.top + rectangle.height);
+    const float maxY = std::max(rectangle.top, rectangle.top + rectangle.height);
+
+    // A flat rectangle doesn't intersect anything
+    if (!(minX < maxX) || !(minY < maxY))
+        return 0;
+
+    // Both rectangles are not flat, so they intersect if each one starts before the other ends
+    const std::size_t size = m_minX.size();
+
+#if defined(SFML_RECTBATCH_SSE)
+
+    const __m128 left   = _mm_set1_ps(minX);
+    const __m128 right  = _mm_set1_ps(maxX);
+    const __m128 top    = _mm_set1_ps(minY);
+    const __m128 bottom = _mm_set1_ps(maxY);
+
+    for (std::size_t i = 0; i < size; i += 4)
+    {
+        const __m128 overlapX = _mm_and_ps(_mm_cmplt_ps(left, _mm_loadu_ps(&m_maxX[i])), _mm_cmplt_ps(_mm_loadu_ps(&m_minX[i]), right));
+        const __m128 overlapY = _mm_and_ps(_mm_cmplt_ps(top, _mm_loadu_ps(&m_maxY[i])), _mm_cmplt_ps(_mm_loadu_ps(&m_minY[i]), bottom));
+        appendMask(_mm_movemask_ps(_mm_and_ps(overlapX, overlapY)), i, indices);
+    }
+
+#elif defined(SFML_RECTBATCH_NEON)
+
+    const float32x4_t left   = vdupq_n_f32(minX);
+    const float32x4_t right  = vdupq_n_f32(maxX);
+    const float32x4_t top    = vdupq_n_f32(minY);
+    const float32x4_t bottom = vdupq_n_f32(maxY);
+
+    for (std::size_t i = 0; i < size; i += 4)
+    {
+        const uint32x4_t overlapX = vandq_u32(vcltq_f32(left, vld1q_f32(&m_maxX[i])), vcltq_f32(vld1q_f32(&m_minX[i]), right));
+        const uint32x4_t overlapY = vandq_u32(vcltq_f32(top, vld1q_f32(&m_maxY[i])), vcltq_f32(vld1q_f32(&m_minY[i]), bottom));
+        appendMask(moveMask(vandq_u32(overlapX, overlapY)), i, indices);
+    }
+
+#elif defined(SFML_RECTBATCH_WASM_SIMD)
+
+    const v128_t left   = wasm_f32x4_splat(minX);
+    const v128_t right  = wasm_f32x4_splat(maxX);
+    const v128_t top    = wasm_f32x4_splat(minY);
+    const v128_t bottom = wasm_f32x4_splat(maxY);
+
+    for (std::size_t i = 0; i < size; i += 4)
+    {
+        const v128_t overlapX = wasm_v128_and(wasm_f32x4_lt(left, wasm_v128_load(&m_maxX[i])), wasm_f32x4_lt(wasm_v128_load(&m_minX[i]), right));
+        const v128_t overlapY = wasm_v128_and(wasm_f32x4_lt(top, wasm_v128_load(&m_maxY[i])), wasm_f32x4_lt(wasm_v128_load(&m_minY[i]), bottom));
+        appendMask(wasm_i32x4_bitmask(wasm_v128_and(overlapX, overlapY)), i, indices);
+    }
+
+#else
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if ((minX < m_maxX[i]) && (m_minX[i] < maxX) && (minY < m_maxY[i]) && (m_minY[i] < maxY))
+            indices.push_back(i);
+    }
+
+#endif
+
+    return indices.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RectBatch::pick(const Vector2f& point, const Transformable* const* objects, const FloatRect* localBounds,
+                            std::size_t count, std::vector<std::size_t>& indices)
+{
+    indices.clear();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // The inverse transform is cached by the object, until it moves
+        const float* m = objects[i]->getInverseTransform().getAffineMatrix();
+        const Vector2f local(m[0] * point.x + m[1] * point.y + m[2],
+                             m[3] * point.x + m[4] * point.y + m[5]);
+
+        if (localBounds[i].contains(local))
+            indices.push_back(i);
+    }
+
+    return indices.size();
+}
+
+} // namespace sf
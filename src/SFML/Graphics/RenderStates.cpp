@@ -26,6 +26,8 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
 #include <cstddef>
 
 
@@ -99,4 +101,17 @@ shader   (theShader)
 {
 }
 
+
+////////////////////////////////////////////////////////////
+Uint64 RenderStates::getKey(PrimitiveType type) const
+{
+    const Uint64 program = shader ? shader->getNativeHandle() : 0;
+    const Uint64 storage = texture ? texture->getStorageId() : 0;
+
+    return ((program & 0xFFFF) << 48) |
+           (static_cast<Uint64>(blendMode.getKey()) << 26) |
+           ((storage & 0x7FFFFF) << 3) |
+           (static_cast<Uint64>(type) & 0x7);
+}
+
 } // namespace sf
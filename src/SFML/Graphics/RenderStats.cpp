@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderStats.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderStats::RenderStats() :
+drawCalls       (0),
+vertices        (0),
+bytesUploaded   (0),
+programSwitches (0),
+textureBinds    (0),
+blendChanges    (0),
+batchesFlushed  (0),
+batchesReused   (0),
+drawablesCulled (0),
+glyphCacheHits  (0),
+glyphCacheMisses(0),
+glyphsRasterized(0),
+textRebuilds    (0)
+{
+    for (int i = 0; i < FlushReasonCount; ++i)
+        flushReasons[i] = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderBudget::RenderBudget() :
+drawCalls       (0),
+bytesUploaded   (0),
+glyphCacheMisses(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderBudget::RenderBudget(Uint32 drawCalls, Uint64 bytesUploaded, Uint32 glyphCacheMisses) :
+drawCalls       (drawCalls),
+bytesUploaded   (bytesUploaded),
+glyphCacheMisses(glyphCacheMisses)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderBudget::isExceeded(const RenderStats& stats) const
+{
+    return ((drawCalls > 0) && (stats.drawCalls > drawCalls)) ||
+           ((bytesUploaded > 0) && (stats.bytesUploaded > bytesUploaded)) ||
+           ((glyphCacheMisses > 0) && (stats.glyphCacheMisses > glyphCacheMisses));
+}
+
+} // namespace sf
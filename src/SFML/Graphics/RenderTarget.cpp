@@ -26,46 +26,202 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/AnimatedSpriteBatch.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/DrawCapture.hpp>
+#include <SFML/Graphics/DrawList.hpp>
+#include <SFML/Graphics/FrameArena.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
 #include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/UniformBuffer.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/YuvTexture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GpuProfiler.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Trace.hpp>
 #include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 #include <map>
+#include <string>
+#include <vector>
 
 
 namespace
 {
-    // Mutex to protect ID generation and our context-RenderTarget-map
-    sf::Mutex mutex;
+    // Start at 1, zero is "no RenderTarget"
+    std::atomic<sf::Uint64> nextId(1);
 
-    // Last active render target id
-    sf::Uint64 lastActiveId = 0;
+    class SfmlRenderPipeline;
+
+    // Blend mode keys only use the 22 low bits
+    const sf::Uint32 NoBlendKey   = 0xFFFFFFFF;
+    const sf::Uint32 OverdrawFlag = 0x80000000;
+
+    // Key of the blend state that a draw applies, the overdraw heatmap replaces the blend mode
+    inline sf::Uint32 appliedBlendKey(const sf::BlendMode& mode, bool overdraw)
+    {
+        return overdraw ? OverdrawFlag : mode.getKey();
+    }
+
+    // Difference of a counter since a scope began; the counters restart from 0
+    // if the frame stats are reset in the meantime
+    template <typename T>
+    T countSince(T now, T start)
+    {
+        return (now >= start) ? now - start : now;
+    }
+
+    // Counters of the work submitted since the start of a scope
+    sf::RenderStats statsSince(const sf::RenderStats& now, const sf::RenderStats& start)
+    {
+        sf::RenderStats stats;
+        stats.drawCalls        = countSince(now.drawCalls,        start.drawCalls);
+        stats.vertices         = countSince(now.vertices,         start.vertices);
+        stats.bytesUploaded    = countSince(now.bytesUploaded,    start.bytesUploaded);
+        stats.programSwitches  = countSince(now.programSwitches,  start.programSwitches);
+        stats.textureBinds     = countSince(now.textureBinds,     start.textureBinds);
+        stats.blendChanges     = countSince(now.blendChanges,     start.blendChanges);
+        stats.batchesFlushed   = countSince(now.batchesFlushed,   start.batchesFlushed);
+        stats.batchesReused    = countSince(now.batchesReused,    start.batchesReused);
+        stats.drawablesCulled  = countSince(now.drawablesCulled,  start.drawablesCulled);
+        stats.glyphCacheHits   = countSince(now.glyphCacheHits,   start.glyphCacheHits);
+        stats.glyphCacheMisses = countSince(now.glyphCacheMisses, start.glyphCacheMisses);
+        stats.glyphsRasterized = countSince(now.glyphsRasterized, start.glyphsRasterized);
+        stats.textRebuilds     = countSince(now.textRebuilds,     start.textRebuilds);
+
+        for (int i = 0; i < sf::RenderStats::FlushReasonCount; ++i)
+            stats.flushReasons[i] = countSince(now.flushReasons[i], start.flushReasons[i]);
+
+        return stats;
+    }
+
+    // Everything that belongs to one OpenGL context: vertex arrays are
+    // not shared between contexts, and the applied states are per context
+    struct ContextState
+    {
+        ContextState() :
+        pipeline(nullptr),
+        lastActiveId(0),
+        stateOwnerId(0),
+        appliedBlendKey(NoBlendKey),
+        deferredTarget(nullptr)
+        {
+        }
+
+        // Pipeline instance, with its own buffers and vertex arrays
+        SfmlRenderPipeline* pipeline;
+
+        // Last active render target id
+        sf::Uint64 lastActiveId;
+
+        // Render target whose view and scissor rectangle are applied; they are
+        // the only OpenGL states that depend on the target, all the others
+        // are shared by the targets and filtered by the state shadow
+        sf::Uint64 stateOwnerId;
+
+        // Key of the blend mode applied by the last draw, whatever its target,
+        // with the overdraw heatmap flag in the top bit
+        sf::Uint32 appliedBlendKey;
+
+        // Active render target with recorded deferred draws
+        sf::RenderTarget* deferredTarget;
+    };
+
+    // Mutex to protect the map of the contexts and the lifetime of the pipelines
+    sf::Mutex contextMutex;
+
+    // States of the contexts SFML rendered with, by OpenGL context
+    std::map<void*, ContextState*> contextStates;
+
+    // Changed when a context state is destroyed, so that the threads look their context up again
+    std::atomic<unsigned int> contextGeneration(0);
+
+    // Last context state looked up by the thread
+    thread_local void*         threadContext = nullptr;
+    thread_local ContextState* threadState = nullptr;
+    thread_local unsigned int  threadGeneration = 0;
+
+
+    // State of the current OpenGL context, created on first use
+    inline ContextState& contextState()
+    {
+        void* context = sf::priv::getCurrentContext();
+        unsigned int generation = contextGeneration.load(std::memory_order_acquire);
+        if (threadState && (threadContext == context) && (threadGeneration == generation))
+            return *threadState;
+
+        sf::Lock lock(contextMutex);
+
+        ContextState*& state = contextStates[context];
+        if (!state)
+        {
+            state = new ContextState;
+
+            // The debug output is a state of the context too
+            sf::priv::installGLDebugOutput();
+        }
+
+        threadContext = context;
+        threadState = state;
+        threadGeneration = generation;
+
+        return *state;
+    }
 
     
     // Unique identifier, used for identifying RenderTargets when
     // tracking the currently active RenderTarget within a given context
     inline sf::Uint64 getUniqueId()
     {
-        sf::Lock lock(mutex);
-
-        static sf::Uint64 id = 1; // start at 1, zero is "no RenderTarget"
-
-        return id++;
+        return nextId.fetch_add(1, std::memory_order_relaxed);
     }
 
 
     // Check if a RenderTarget with the given ID is active in the current context
     inline bool isActive(sf::Uint64 id)
     {
-        return (lastActiveId == id);
+        return (contextState().lastActiveId == id);
+    }
+
+
+    // Pixels read back from a render target; either a pixel pack buffer that the GPU
+    // fills in the background, or pixels that were read synchronously
+    struct PixelReadback
+    {
+        sf::Uint64             token;
+        GLuint                 buffer;
+        GLsync                 fence;
+        sf::Vector2u           size;
+        std::vector<sf::Uint8> pixels;
+    };
+
+    std::vector<PixelReadback> pendingReadbacks;
+    std::vector<GLuint> freeReadbackBuffers;
+    sf::Uint64 lastReadbackToken = 0;
+
+    const std::size_t maxFreeReadbackBuffers = 4;
+
+    bool isAsyncReadbackAvailable()
+    {
+        const sf::GraphicsCaps& caps = sf::priv::getGraphicsCaps();
+        return caps.mapBufferRange && caps.fenceSync;
     }
 
     
@@ -114,15 +270,140 @@ namespace
     }
 
 
+    // Scale applied by the pipeline shaders to the texture coordinates drawn with a texture.
+    inline sf::Vector2f texCoordScale(const sf::Texture& texture)
+    {
+        if ((texture.getCoordinateType() == sf::Texture::Pixels) && (texture.getSize().x > 0) && (texture.getSize().y > 0))
+            return sf::Vector2f(1.f / texture.getSize().x, 1.f / texture.getSize().y);
+
+        return sf::Vector2f(1.f, 1.f);
+    }
+
+
+    // Shared page of the dynamic atlas to draw a small texture from (see
+    // Texture::setDynamicAtlasThreshold), unless the vertices sample outside of it
+    const sf::Texture* getAtlasPage(const sf::Texture* texture, const sf::Vertex* vertices, std::size_t vertexCount, sf::Vector2f& offset)
+    {
+        unsigned int threshold = sf::Texture::getDynamicAtlasThreshold();
+        if (!texture || (texture->getSize().x > threshold) || (texture->getSize().y > threshold))
+            return nullptr;
+
+        sf::Vector2f size(texture->getSize());
+        for (std::size_t i = 0; i < vertexCount; ++i)
+        {
+            const sf::Vector2f& texCoords = vertices[i].texCoords;
+            if ((texCoords.x < 0.f) || (texCoords.y < 0.f) || (texCoords.x > size.x) || (texCoords.y > size.y))
+                return nullptr;
+        }
+
+        return sf::priv::getAtlasPage(*texture, offset);
+    }
+
+
+    // 64-bit FNV-1a hash of the content of a batch, fed 32-bit words at a time
+    // (the members of sf::Vertex are all 4 bytes wide)
+    sf::Uint64 hashBatch(const sf::Vertex* vertices, std::size_t vertexCount, const sf::Uint8* slots, sf::PrimitiveType type)
+    {
+        sf::Uint64 hash = 14695981039346656037ULL;
+        hash = (hash ^ static_cast<sf::Uint64>(type)) * 1099511628211ULL;
+        hash = (hash ^ static_cast<sf::Uint64>(vertexCount)) * 1099511628211ULL;
+
+        const std::size_t wordCount = vertexCount * sizeof(sf::Vertex) / sizeof(sf::Uint32);
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(vertices);
+        for (std::size_t i = 0; i < wordCount; ++i)
+        {
+            sf::Uint32 word;
+            std::memcpy(&word, bytes + i * sizeof(sf::Uint32), sizeof(word));
+            hash = (hash ^ word) * 1099511628211ULL;
+        }
+
+        if (slots)
+        {
+            for (std::size_t i = 0; i < vertexCount; ++i)
+                hash = (hash ^ slots[i]) * 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+
+    // Batch whose vertices are still in the streaming buffer, reused as is
+    // when the next flush submits exactly the same content; the hash finds
+    // the candidates, the copy of the content rules out collisions
+    struct RetainedBatch
+    {
+        sf::Uint64              hash;
+        sf::PrimitiveType       type;
+        std::vector<sf::Vertex> vertices;
+        std::vector<sf::Uint8>  slots;
+        std::size_t             offset;
+        sf::Uint64              lastUse;
+    };
+
+
+    // Features of the specialised variants of the built-in pipeline shader,
+    // combined into the key of the variant
+    enum VariantFlag
+    {
+        VariantTextured      = 1 << 0, ///< Samples a texture
+        VariantFlipped       = 1 << 1, ///< Flips the texture vertically
+        VariantSingleChannel = 1 << 2, ///< The texture stores its coverage in the red channel
+        VariantDistanceField = 1 << 3, ///< Thresholds a distance field texture
+        VariantMultiTexture  = 1 << 4, ///< Picks one of several textures with the slot of the vertex
+        VariantOverdraw      = 1 << 5, ///< Outputs a constant increment of the overdraw heatmap
+        VariantAlphaMask     = 1 << 6, ///< Discards the fragments whose alpha is below 0.5 (stencil masks)
+
+        VariantCount         = 1 << 7
+    };
+
+
+    // Program specialised for one combination of features, and its uniform state
+    struct PipelineVariant
+    {
+        PipelineVariant()
+        : shader()
+        , id(0)
+        , locViewProj(-1)
+        , locTexScale(-1)
+        , texScale(1.f, 1.f)
+        , uploadedViewGeneration(0)
+        , uploadedModelView()
+        , pending(false)
+        {
+        }
+
+        sf::Shader      shader;
+        unsigned int    id;
+        int             locViewProj;
+        int             locTexScale;
+        sf::Vector2f    texScale;
+        sf::Uint64      uploadedViewGeneration;
+        sf::Transform   uploadedModelView;
+        bool            pending;
+    };
+
+
     class SfmlRenderPipeline
     {
     private:
 		static const std::size_t MAX_VERTEX = (256 * 256);
 
+        // Bigger draws are not worth pre-transforming on the CPU
+        static const std::size_t MAX_BATCH_DRAW_VERTEX = 1024;
+
+        // Textures a single batch can sample from, each bound to its own unit
+        static const unsigned int MAX_BATCH_TEXTURES = 8;
+
+        // Batches remembered for reuse, the least recently used one is forgotten first
+        static const std::size_t MAX_RETAINED_BATCHES = 64;
+
     public:
         SfmlRenderPipeline();
         ~SfmlRenderPipeline();
-        void applyCurrentView(sf::View& view);
+        void applyCurrentView(sf::View& view, const sf::Vector2u& targetSize);
+        void beginFrame();
+        void updateFrameBlock();
+        void uploadViewProj(GLint location) const;
         void applyCurrentTransform(const sf::Transform& transform);
         void preDraw(const sf::Texture* texture, const sf::Shader* shader);
         void postDraw(const sf::Texture* texture, const sf::Shader* shader);
@@ -144,101 +425,308 @@ namespace
                             std::size_t         firstVertex,
                             std::size_t         vertexCount);
 
+        void drawVertexRanges(const sf::Vertex*   vertices,
+                              const std::size_t*  firstVertices,
+                              const std::size_t*  vertexCounts,
+                              std::size_t         rangeCount,
+                              sf::PrimitiveType   type,
+                              const sf::Texture*  texture,
+                              const sf::Shader*   shader);
+
+        void drawVertexBufferRanges(const sf::VertexBuffer& vertexBuffer,
+                                    const std::size_t*      firstVertices,
+                                    const std::size_t*      vertexCounts,
+                                    std::size_t             rangeCount,
+                                    const sf::Texture*      texture,
+                                    const sf::Shader*       shader);
+
+        void drawVertexBufferList(const sf::VertexBuffer* const* vertexBuffers,
+                                  std::size_t                   count,
+                                  const sf::Texture*            texture,
+                                  const sf::Shader*             shader);
+
+        void drawRanges(sf::PrimitiveType type);
+
+        void drawIndexedVertices(const sf::Vertex*  vertices,
+                                 std::size_t        vertexCount,
+                                 const sf::Uint16*  indices,
+                                 std::size_t        indexCount,
+                                 sf::PrimitiveType  type,
+                                 const sf::Texture* texture,
+                                 const sf::Shader*  shader);
+
+        void drawIndexedBuffer(const sf::VertexBuffer& vertexBuffer,
+                               const sf::IndexBuffer&  indexBuffer,
+                               std::size_t             firstIndex,
+                               std::size_t             indexCount,
+                               const sf::Texture*      texture,
+                               const sf::Shader*       shader);
+
+        void drawQuadInstances(unsigned int       instanceBuffer,
+                               std::size_t        instanceCount,
+                               const sf::Texture* texture,
+                               const sf::Shader*  shader);
+
+        void drawParticleInstances(unsigned int        instanceBuffer,
+                                   std::size_t         instanceCount,
+                                   float               time,
+                                   const sf::Vector2f& gravity,
+                                   const sf::Texture*  texture);
+
+        void drawAnimatedInstances(unsigned int       instanceBuffer,
+                                   std::size_t        instanceCount,
+                                   float              time,
+                                   const float*       frames,
+                                   std::size_t        frameCount,
+                                   sf::Uint64         framesId,
+                                   const sf::Texture* texture);
+
+        void drawLayeredVertices(const sf::LayeredVertex*  vertices,
+                                 sf::PrimitiveType         type,
+                                 std::size_t               vertexCount,
+                                 const sf::TextureArray&   textureArray,
+                                 const sf::Shader*         shader);
+
+        void drawYuvVertices(const sf::Vertex*       vertices,
+                             sf::PrimitiveType       type,
+                             std::size_t             vertexCount,
+                             const sf::YuvTexture&   texture,
+                             const sf::Shader*       shader);
+
+        bool drawOutlinedGlyphs(const sf::Vertex*  vertices,
+                                std::size_t        vertexCount,
+                                const sf::Texture& texture,
+                                const sf::Color&   outlineColor,
+                                float              outlineWidth);
+
+        bool createInstancing();
+
+        bool createParticles();
+
+        bool createAnimation();
+
+        bool createLayered();
+
+        PipelineVariant& getVariant(unsigned int key);
+
+        void submitVariant(unsigned int key);
+
+        PipelineVariant& finishVariant(unsigned int key);
+
+        bool isMultiTextureReady();
+
+        PipelineVariant* getYuvVariant(sf::YuvTexture::Layout layout);
+
+        PipelineVariant* getOutlineVariant(const sf::Texture& texture);
+
+        void drawChunks(const sf::Vertex*   vertices,
+                        sf::PrimitiveType   type,
+                        std::size_t         vertexCount);
+
+        void drawIndexedQuads(std::size_t firstVertex, std::size_t vertexCount);
+
+        std::size_t streamVertices(const sf::Vertex* vertices, std::size_t vertexCount, std::size_t alignment = 1);
+
+        std::size_t streamBatch(bool& reused);
+
+        bool batchVertices(const sf::Vertex*    vertices,
+                           std::size_t          vertexCount,
+                           sf::PrimitiveType    type,
+                           const sf::Transform& transform,
+                           const sf::Texture*   texture);
+
+        bool findTextureSlot(const sf::Texture* texture, sf::Uint8& slot);
+
+        void drawBatch();
+
+        void drawMultiTextureBatch();
+
+        void flush(sf::RenderStats::FlushReason reason = sf::RenderStats::FlushExplicit);
+        void flush(const sf::Texture* texture);
+
+        void setOverdraw(bool overdraw);
+
+        void setAlphaMask(bool alphaMask);
+
     private:
         sf::Transform   m_matProj;
         sf::Transform   m_matModelView;
-        sf::Shader      m_shader;
-        unsigned int    m_shaderId;
-        int             m_locTexture0;
-        int             m_locViewProj;
-        int             m_locTexFlipped;
-        int             m_locUseTexture;
+        sf::Uint64      m_viewGeneration;
+        sf::UniformBuffer m_frameBuffer;
+        sf::Clock       m_frameClock;
+        float           m_frameTime;
+        sf::Vector2u    m_targetSize;
+        sf::Uint64      m_frameGeneration;
+        sf::Uint64      m_uploadedFrameGeneration;
+        PipelineVariant m_variants[VariantCount];
         unsigned int    m_vao;
         unsigned int    m_vbo;
-        unsigned int    m_cacheTextureId;
-        bool            m_cacheTextureFlipped;       
-		bool            m_cacheTextureUse;
+        unsigned int    m_quadIndices;
+        unsigned int    m_streamIndices;
+        std::vector<GLushort> m_rebasedIndices;
+        std::vector<GLint>    m_rangeFirsts;
+        std::vector<GLsizei>  m_rangeCounts;
+        std::size_t     m_vboOffset;
+        bool            m_mapBufferRange;
+        bool            m_drawBaseVertex;
+        bool            m_normalizedTexCoords;
+        std::vector<sf::Vertex> m_batchVertices;
+        sf::PrimitiveType       m_batchType;
+        const sf::Texture*      m_batchTexture;
+        std::vector<sf::Uint8>  m_batchSlots;
+        const sf::Texture*      m_batchTextures[MAX_BATCH_TEXTURES];
+        unsigned int            m_batchTextureCount;
+        unsigned int            m_textureSlots;
+        unsigned int            m_slotVbo;
+        std::vector<RetainedBatch> m_retainedBatches;
+        std::size_t             m_retainedCount;
+        std::size_t             m_retainedCursor;
+        sf::Uint64              m_batchSerial;
+        std::vector<sf::Vertex> m_chunkVertices;
+        sf::Shader      m_instanceShader;
+        unsigned int    m_instanceShaderId;
+        int             m_locInstanceViewProj;
+        int             m_locInstanceTexFlipped;
+        int             m_locInstanceUseTexture;
+        int             m_locInstanceSingleChannel;
+        unsigned int    m_instanceVao;
+        unsigned int    m_quadCorners;
+        sf::Shader      m_particleShader;
+        unsigned int    m_particleShaderId;
+        int             m_locParticleViewProj;
+        int             m_locParticleTexFlipped;
+        int             m_locParticleUseTexture;
+        int             m_locParticleSingleChannel;
+        int             m_locParticleTime;
+        int             m_locParticleGravity;
+        unsigned int    m_particleVao;
+        bool            m_particlesFailed;
+        sf::Shader      m_animationShader;
+        unsigned int    m_animationShaderId;
+        int             m_locAnimationViewProj;
+        int             m_locAnimationTexFlipped;
+        int             m_locAnimationUseTexture;
+        int             m_locAnimationSingleChannel;
+        int             m_locAnimationTime;
+        int             m_locAnimationTexScale;
+        int             m_locAnimationFrames;
+        unsigned int    m_animationVao;
+        sf::Uint64      m_animationFramesId;
+        bool            m_animationFailed;
+        bool            m_distanceFieldFailed;
+        sf::Shader      m_layeredShader;
+        unsigned int    m_layeredShaderId;
+        int             m_locLayeredViewProj;
+        unsigned int    m_layeredVao;
+        unsigned int    m_layeredVbo;
+        std::size_t     m_layeredVboCapacity;
+        bool            m_layeredFailed;
+        PipelineVariant m_yuvVariants[2];
+        int             m_locYuvMatrix[2];
+        int             m_locYuvOffset[2];
+        bool            m_yuvFailed;
+        PipelineVariant m_outlineVariants[4];
+        int             m_locOutlineColor[4];
+        int             m_locOutlineWidth[4];
+        bool            m_outlineFailed;
+        bool            m_overdraw;
+        bool            m_alphaMask;
     };
 
     
     SfmlRenderPipeline::SfmlRenderPipeline()
     : m_matProj()
     , m_matModelView()
-    , m_shader()
-    , m_shaderId(0)
-    , m_locTexture0(-1)
-    , m_locViewProj(-1)
-    , m_locTexFlipped(-1)
-    , m_locUseTexture(-1)
+    , m_viewGeneration(1)
+    , m_frameBuffer()
+    , m_frameClock()
+    , m_frameTime(0.f)
+    , m_targetSize()
+    , m_frameGeneration(1)
+    , m_uploadedFrameGeneration(0)
+    , m_variants()
     , m_vao(0)
     , m_vbo(0)
-    , m_cacheTextureId(0)
-    , m_cacheTextureFlipped(false)
-	, m_cacheTextureUse(false)
+    , m_quadIndices(0)
+    , m_streamIndices(0)
+    , m_rebasedIndices()
+    , m_rangeFirsts()
+    , m_rangeCounts()
+    , m_vboOffset(0)
+    , m_mapBufferRange(false)
+    , m_drawBaseVertex(false)
+    , m_normalizedTexCoords(false)
+    , m_batchVertices()
+    , m_batchType(sf::Triangles)
+    , m_batchTexture(nullptr)
+    , m_batchSlots()
+    , m_batchTextures()
+    , m_batchTextureCount(0)
+    , m_textureSlots(1)
+    , m_slotVbo(0)
+    , m_retainedBatches()
+    , m_retainedCount(0)
+    , m_retainedCursor(0)
+    , m_batchSerial(0)
+    , m_chunkVertices()
+    , m_instanceShader()
+    , m_instanceShaderId(0)
+    , m_locInstanceViewProj(-1)
+    , m_locInstanceTexFlipped(-1)
+    , m_locInstanceUseTexture(-1)
+    , m_locInstanceSingleChannel(-1)
+    , m_instanceVao(0)
+    , m_quadCorners(0)
+    , m_particleShader()
+    , m_particleShaderId(0)
+    , m_locParticleViewProj(-1)
+    , m_locParticleTexFlipped(-1)
+    , m_locParticleUseTexture(-1)
+    , m_locParticleSingleChannel(-1)
+    , m_locParticleTime(-1)
+    , m_locParticleGravity(-1)
+    , m_particleVao(0)
+    , m_particlesFailed(false)
+    , m_animationShader()
+    , m_animationShaderId(0)
+    , m_locAnimationViewProj(-1)
+    , m_locAnimationTexFlipped(-1)
+    , m_locAnimationUseTexture(-1)
+    , m_locAnimationSingleChannel(-1)
+    , m_locAnimationTime(-1)
+    , m_locAnimationTexScale(-1)
+    , m_locAnimationFrames(-1)
+    , m_animationVao(0)
+    , m_animationFramesId(0)
+    , m_animationFailed(false)
+    , m_distanceFieldFailed(false)
+    , m_layeredShader()
+    , m_layeredShaderId(0)
+    , m_locLayeredViewProj(-1)
+    , m_layeredVao(0)
+    , m_layeredVbo(0)
+    , m_layeredVboCapacity(0)
+    , m_layeredFailed(false)
+    , m_yuvVariants()
+    , m_locYuvMatrix()
+    , m_locYuvOffset()
+    , m_yuvFailed(false)
+    , m_outlineVariants()
+    , m_locOutlineColor()
+    , m_locOutlineWidth()
+    , m_outlineFailed(false)
+    , m_overdraw(false)
+    , m_alphaMask(false)
     {
-        const char* vertexShaderSource =
-            "#version 100                                           \n"
-            "precision mediump float;                               \n"
-            "uniform mat4 aViewProj;	                            \n"
-            "uniform bool bTexFlip;                                 \n"
-            "attribute vec2 aPos;                                   \n"
-            "attribute vec4 aColor;			                        \n"
-            "attribute vec2 aTexCoord;		                        \n"
-            "varying vec4 oColor;			                        \n"
-            "varying vec2 oTexCoord;		                        \n"
-            "void main()                                            \n"
-            "{                                                      \n"
-            "   oColor = aColor;                                    \n"
-            "   oTexCoord = aTexCoord;                              \n"
-            "   if (bTexFlip)                                       \n"
-            "       oTexCoord.y = 1.0 - oTexCoord.y;                \n"
-            "                                                       \n"
-            "   gl_Position = aViewProj * vec4(aPos.xy, 0.0, 1.0);  \n"
-            "}\n\0";
-
-		const char* fragmentShaderSource =
-			"#version 100                                                   \n"
-			"precision mediump float;                                       \n"
-            "uniform sampler2D Texture0;                                    \n"
-            "uniform bool bUseTexture;                                      \n"
-            "varying vec4 oColor;                                           \n"
-			"varying vec2 oTexCoord;                                        \n"
-			"void main()                                                    \n"
-            "{                                                              \n"
-            "   if (bUseTexture)                                            \n"
-            "       gl_FragColor = texture2D(Texture0, oTexCoord) * oColor; \n"
-            "   else                                                        \n"
-            "       gl_FragColor = oColor;                                  \n"
-            "}\n\0";
-
-        // order should match to sf::Vertex
-        m_shader.setAttributes({ "aPos", "aColor", "aTexCoord" });
-
-        bool bStatus = m_shader.loadFromMemory(vertexShaderSource, fragmentShaderSource);
-        assert(bStatus == true);
-
-        // we will use native handle for native glX functions to avoid alot of template calls of shader class
-        m_shaderId = m_shader.getNativeHandle();
-
-        glCheck(m_locTexture0 = glGetUniformLocation(m_shaderId, "Texture0"));
-        assert(m_locTexture0 != -1);
-
-        glCheck(m_locViewProj = glGetUniformLocation(m_shaderId, "aViewProj"));
-        assert(m_locViewProj != -1);
-
-        glCheck(m_locTexFlipped = glGetUniformLocation(m_shaderId, "bTexFlip"));
-        assert(m_locTexFlipped != -1);
-
-        glCheck(m_locUseTexture = glGetUniformLocation(m_shaderId, "bUseTexture"));
-        assert(m_locUseTexture != -1);    
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
 
         // now create vertices buffer
         glCheck(SFML_GL_EXT_glGenVertexArrays(1, &m_vao));
         glCheck(glGenBuffers(1, &m_vbo));
 
-        glCheck(SFML_GL_EXT_glBindVertexArray(m_vao));
+        cache.bindVertexArray(m_vao);
 
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
         glCheck(glBufferData(GL_ARRAY_BUFFER, sizeof(sf::Vertex) * MAX_VERTEX, 0, GL_STREAM_DRAW));
 
         glCheck(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(sf::Vertex), (void*)0));
@@ -250,32 +738,193 @@ namespace
         glCheck(glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(sf::Vertex), (void*)(sizeof(sf::Vertex::position) + sizeof(sf::Vertex::color))));
         glCheck(glEnableVertexAttribArray(2));
 
-        glCheck(SFML_GL_EXT_glBindVertexArray(0));
+        // static index buffer turning each group of 4 vertices (sf::Quads order) into 2 triangles,
+        // the element array binding is part of the vertex array state
+        std::vector<GLushort> indices((MAX_VERTEX / 4) * 6);
+        for (std::size_t quad = 0; quad < MAX_VERTEX / 4; ++quad)
+        {
+            GLushort vertex = static_cast<GLushort>(quad * 4);
+            indices[quad * 6 + 0] = vertex + 0;
+            indices[quad * 6 + 1] = vertex + 1;
+            indices[quad * 6 + 2] = vertex + 2;
+            indices[quad * 6 + 3] = vertex + 0;
+            indices[quad * 6 + 4] = vertex + 2;
+            indices[quad * 6 + 5] = vertex + 3;
+        }
+
+        glCheck(glGenBuffers(1, &m_quadIndices));
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadIndices);
+        glCheck(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * indices.size(), indices.data(), GL_STATIC_DRAW));
+
+        // batches mixing several textures carry the texture slot of each vertex in a
+        // parallel buffer, written at the same offsets as the streamed vertices
+        GLint maxUnits = 0;
+        glCheck(glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits));
+        m_textureSlots = static_cast<unsigned int>(std::max(1, std::min(maxUnits, static_cast<GLint>(MAX_BATCH_TEXTURES))));
+
+        if (m_textureSlots > 1)
+        {
+            glCheck(glGenBuffers(1, &m_slotVbo));
+            cache.bindBuffer(GL_ARRAY_BUFFER, m_slotVbo);
+            glCheck(glBufferData(GL_ARRAY_BUFFER, sizeof(sf::Uint8) * MAX_VERTEX, 0, GL_STREAM_DRAW));
+
+            glCheck(glVertexAttribPointer(3, 1, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(sf::Uint8), (void*)0));
+            glCheck(glEnableVertexAttribArray(3));
+        }
+
+        cache.bindVertexArray(0);
+
+        // the common variants of the shader compile in the background while the application
+        // loads its resources, and are waited for when first drawn with; the other variants
+        // are created when first needed
+        submitVariant(0);
+        submitVariant(VariantTextured);
+        if (m_textureSlots > 1)
+            submitVariant(VariantTextured | VariantMultiTexture);
+
+        // unsynchronized mapping of the streaming buffer, and base vertex
+        // to let the quad indices address any range of a vertex buffer
+        const sf::GraphicsCaps& caps = sf::priv::getGraphicsCaps();
+        m_mapBufferRange = caps.mapBufferRange;
+        m_drawBaseVertex = caps.drawBaseVertex;
     };
 
 
     SfmlRenderPipeline::~SfmlRenderPipeline()
     {
-        glCheck(SFML_GL_EXT_glBindVertexArray(0));
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
 
         if (m_vbo)
         {
-            glDeleteBuffers(1, &m_vbo);
+            cache.deleteBuffer(m_vbo);
             m_vbo = 0;
         };
 
+        if (m_quadIndices)
+        {
+            cache.deleteBuffer(m_quadIndices);
+            m_quadIndices = 0;
+        };
+
+        if (m_streamIndices)
+        {
+            cache.deleteBuffer(m_streamIndices);
+            m_streamIndices = 0;
+        };
+
+        if (m_quadCorners)
+        {
+            cache.deleteBuffer(m_quadCorners);
+            m_quadCorners = 0;
+        };
+
+        if (m_instanceVao)
+        {
+            cache.deleteVertexArray(m_instanceVao);
+            m_instanceVao = 0;
+        };
+
+        if (m_particleVao)
+        {
+            cache.deleteVertexArray(m_particleVao);
+            m_particleVao = 0;
+        };
+
+        if (m_animationVao)
+        {
+            cache.deleteVertexArray(m_animationVao);
+            m_animationVao = 0;
+        };
+
+        if (m_slotVbo)
+        {
+            cache.deleteBuffer(m_slotVbo);
+            m_slotVbo = 0;
+        };
+
+        if (m_layeredVbo)
+        {
+            cache.deleteBuffer(m_layeredVbo);
+            m_layeredVbo = 0;
+        };
+
+        if (m_layeredVao)
+        {
+            cache.deleteVertexArray(m_layeredVao);
+            m_layeredVao = 0;
+        };
+
         if (m_vao)
         {
-            SFML_GL_EXT_glDeleteVertexArrays(1, &m_vao);
+            cache.deleteVertexArray(m_vao);
             m_vao = 0;
         };
     };
 
 
-    void SfmlRenderPipeline::applyCurrentView(sf::View& view)
+    void SfmlRenderPipeline::applyCurrentView(sf::View& view, const sf::Vector2u& targetSize)
+    {
+        // targets of the same size with the same view share the uploaded uniforms
+        if ((m_targetSize == targetSize) && (m_matProj == view.getTransform()))
+            return;
+
+        m_matProj = view.getTransform();
+        m_targetSize = targetSize;
+
+        // the view-projection uniform and the frame block must be uploaded again
+        ++m_viewGeneration;
+        ++m_frameGeneration;
+    };
+
+
+    void SfmlRenderPipeline::beginFrame()
+    {
+        m_frameTime = m_frameClock.getElapsedTime().asSeconds();
+        ++m_frameGeneration;
+    };
+
+
+    void SfmlRenderPipeline::uploadViewProj(GLint location) const
+    {
+        // transforms are stored as 2x3, expand the product for the shader
+        float matrix[16];
+        (m_matProj * m_matModelView).getMatrix(matrix);
+        glUniformMatrix4fv(location, 1, GL_FALSE, matrix);
+    };
+
+
+    void SfmlRenderPipeline::updateFrameBlock()
     {
-	    m_matProj = view.getTransform();
+        // std140 layout of the sf_Frame block
+        struct FrameBlock
+        {
+            float viewProj[16];
+            float targetSize[2];
+            float time;
+            float padding;
+        };
+
+        if (m_uploadedFrameGeneration == m_frameGeneration)
+            return;
+
+        m_uploadedFrameGeneration = m_frameGeneration;
+
+        // user shaders on GL 3.0 / ES 2 simply can't declare the block
+        if (!sf::UniformBuffer::isAvailable())
+            return;
+
+        if (!m_frameBuffer.getSize() && !m_frameBuffer.create(sizeof(FrameBlock)))
+            return;
+
+        FrameBlock block;
+        m_matProj.getMatrix(block.viewProj);
+        block.targetSize[0] = static_cast<float>(m_targetSize.x);
+        block.targetSize[1] = static_cast<float>(m_targetSize.y);
+        block.time = m_frameTime;
+        block.padding = 0.f;
+
+        m_frameBuffer.update(&block, sizeof(block));
+        m_frameBuffer.bind(sf::UniformBuffer::FrameBinding);
     };
 
 
@@ -287,73 +936,72 @@ namespace
 
 	void SfmlRenderPipeline::preDraw(const sf::Texture* texture, const sf::Shader* shader)
     {
-        // if shader is passed execute user-defined pipeline for sf::Vertex
-        if (shader)
+        // keep the last-use stamp for the memory budget, and bring
+        // the pixels of a multisampled render texture up to date
+        if (texture)
+        {
+            sf::priv::markTextureUsed(*texture);
+            sf::priv::resolveTexture(*texture);
+        };
+
+        // if shader is passed execute user-defined pipeline for sf::Vertex,
+        // the overdraw heatmap replaces it like the built-in ones
+        if (shader && !m_overdraw)
         {
+            updateFrameBlock();
             shader->bind(shader);
             return;
         };
 
-        GLint id = 0;
-
-        // check for current shader        
-        glCheck(glGetIntegerv(GL_CURRENT_PROGRAM, &id));
-        if (static_cast<unsigned int>(id) != m_shaderId)
-            glCheck(glUseProgram(m_shaderId));
-
-		if (texture)
-		{
-			// update tex cache
-			unsigned int textureId = texture->getNativeHandle();
-			if (m_cacheTextureId != textureId)
-			{
-				m_cacheTextureId = textureId;
-
-				glCheck(glGetIntegerv(GL_TEXTURE_BINDING_2D, &id));
-				if (static_cast<unsigned int>(id) != m_cacheTextureId)
-				{
-					glActiveTexture(GL_TEXTURE0 + 0);
-					glBindTexture(GL_TEXTURE_2D, textureId);
-					glUniform1i(m_locTexture0, 0);
-				};
-			};
-
-			// update flip cache
-			if (texture->isFlipped())
-			{
-				if (!m_cacheTextureFlipped)
-				{
-					glUniform1i(m_locTexFlipped, static_cast<int>(true));
-					m_cacheTextureFlipped = true;
-				};
-			}
-			else
-			{
-				if (m_cacheTextureFlipped)
-				{
-					glUniform1i(m_locTexFlipped, static_cast<int>(false));
-					m_cacheTextureFlipped = false;
-				};
-			};
-
-			if (!m_cacheTextureUse)
-			{
-				glUniform1i(m_locUseTexture, static_cast<int>(true));
-				m_cacheTextureUse = true;
-			};
-		}
-		else
-		{
-			if (m_cacheTextureUse)
-			{
-				glUniform1i(m_locUseTexture, static_cast<int>(false));
-				m_cacheTextureUse = false;
-			};
-
-			m_cacheTextureId = 0;
-		};
-
-		glUniformMatrix4fv(m_locViewProj, 1, GL_FALSE, (m_matProj *m_matModelView).getMatrix());			
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+
+        // the state of the draw selects a specialised variant of the built-in shader
+        unsigned int key = 0;
+        if (m_overdraw)
+        {
+            key = VariantOverdraw;
+        }
+        else if (texture)
+        {
+            key |= VariantTextured;
+            if (texture->isFlipped())
+                key |= VariantFlipped;
+            if (texture->isSingleChannel())
+                key |= VariantSingleChannel;
+            if (texture->isDistanceField() && !m_distanceFieldFailed)
+                key |= VariantDistanceField;
+        };
+
+        if (m_alphaMask && !m_overdraw)
+            key |= VariantAlphaMask;
+
+        PipelineVariant& variant = getVariant(key);
+
+        // redundant program and texture binds are skipped by the state shadow
+        cache.useProgram(variant.id);
+
+        if (texture && !m_overdraw)
+        {
+            sf::priv::bindSampledTexture(0, *texture);
+
+            // font pages are drawn with texture coordinates in pixels,
+            // packed vertices always have normalized ones
+            sf::Vector2f texScale = m_normalizedTexCoords ? sf::Vector2f(1.f, 1.f) : texCoordScale(*texture);
+            if (texScale != variant.texScale)
+            {
+                variant.texScale = texScale;
+                glUniform2f(variant.locTexScale, texScale.x, texScale.y);
+            };
+        };
+
+        // skip the multiply and the upload if neither the view nor the transform changed
+        if ((variant.uploadedViewGeneration != m_viewGeneration) || (variant.uploadedModelView != m_matModelView))
+        {
+            uploadViewProj(variant.locViewProj);
+
+            variant.uploadedViewGeneration = m_viewGeneration;
+            variant.uploadedModelView = m_matModelView;
+        };
 	};
 
 
@@ -374,288 +1022,3872 @@ namespace
                                           const sf::Texture*  texture,
                                           const sf::Shader*   shader)
     {
+        SFML_TRACE_SCOPE("SfmlRenderPipeline::drawVertices");
+
         preDraw(texture, shader);
-        
-		GLint id = 0;
 
-        // check for current vertex array
-        glCheck(glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &id));
-        if (static_cast<unsigned int>(id) != m_vao)
-            glCheck(SFML_GL_EXT_glBindVertexArray(m_vao));
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+        cache.bindVertexArray(m_vao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
 
-        // check for current vertex buffer
-        glCheck(glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &id));
-        if (static_cast<unsigned int>(id) != m_vbo)
-            glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
+        vertices += firstVertex;
 
-        // copy vertices
-        glCheck(glBufferSubData(GL_ARRAY_BUFFER, 0, vertexCount * sizeof(sf::Vertex), vertices));
+        if (vertexCount <= MAX_VERTEX)
+        {
+            // copy vertices
+            std::size_t offset = streamVertices(vertices, vertexCount, (type == sf::Quads) ? 4 : 1);
 
-        // draw call
-        drawPrimitives(type, firstVertex, vertexCount);
+            // draw call
+            drawPrimitives(type, offset, vertexCount);
+        }
+        else
+        {
+            // Too big for the streaming buffer: split in chunks that
+            // restart the primitive correctly at each boundary
+            drawChunks(vertices, type, vertexCount);
+        }
 
         postDraw(texture, shader);
     };
 
-    
-    void SfmlRenderPipeline::drawVertexBuffer(const sf::VertexBuffer& vertexBuffer,
-                                              std::size_t             firstVertex,
-                                              std::size_t             vertexCount,
-                                              const sf::Texture*      texture,
-                                              const sf::Shader*       shader)
-    {
-        preDraw(texture, shader);
 
-        sf::VertexBuffer::bind(&vertexBuffer);
+    void SfmlRenderPipeline::drawChunks(const sf::Vertex*   vertices,
+                                        sf::PrimitiveType   type,
+                                        std::size_t         vertexCount)
+    {
+        // Chunk size, kept a multiple of the primitive size (and even for
+        // triangle strips, so that each chunk starts with the same winding)
+        std::size_t chunkSize = MAX_VERTEX;
+        std::size_t overlap = 0;
 
-        drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+        switch (type)
+        {
+            case sf::Points:        break;
+            case sf::Lines:         chunkSize -= chunkSize % 2; break;
+            case sf::LineStrip:     overlap = 1; break;
+            case sf::Triangles:     chunkSize -= chunkSize % 3; break;
+            case sf::TriangleStrip: chunkSize -= chunkSize % 2; overlap = 2; break;
+            case sf::TriangleFan:   overlap = 1; break;
+            case sf::Quads:         chunkSize -= chunkSize % 4; break;
+        }
 
-        sf::VertexBuffer::bind(nullptr);
+        std::size_t first = 0;
 
-        postDraw(texture, shader);
+        while (first + overlap < vertexCount)
+        {
+            std::size_t count = std::min(chunkSize, vertexCount - first);
+            std::size_t offset = 0;
+
+            if ((type == sf::TriangleFan) && (first > 0))
+            {
+                // Every chunk of a fan must start with its center
+                count = std::min(chunkSize - 1, vertexCount - first);
+
+                m_chunkVertices.resize(count + 1);
+                m_chunkVertices[0] = vertices[0];
+                std::copy(vertices + first, vertices + first + count, m_chunkVertices.begin() + 1);
+
+                offset = streamVertices(&m_chunkVertices[0], count + 1);
+                drawPrimitives(type, offset, count + 1);
+            }
+            else
+            {
+                offset = streamVertices(vertices + first, count, (type == sf::Quads) ? 4 : 1);
+                drawPrimitives(type, offset, count);
+            }
+
+            first += count - overlap;
+        }
     };
 
 
-    
-    void SfmlRenderPipeline::drawPrimitives(sf::PrimitiveType   type,
-                                            std::size_t         firstVertex,
-                                            std::size_t         vertexCount)
-    {
-        static const GLenum modes [] = { GL_POINTS,     GL_LINES,           GL_LINE_STRIP,
-                                         GL_TRIANGLES,  GL_TRIANGLE_STRIP,  GL_TRIANGLE_FAN, GL_QUADS };
-        GLenum mode = modes[type];
+    std::size_t SfmlRenderPipeline::streamVertices(const sf::Vertex* vertices, std::size_t vertexCount, std::size_t alignment)
+    {
+        // Indexed quads must start on a multiple of 4 to match the index buffer
+        m_vboOffset = ((m_vboOffset + alignment - 1) / alignment) * alignment;
+
+        // Orphan the buffer when the ring wraps: the driver hands out fresh
+        // storage while pending draws keep reading the previous one
+        if (m_vboOffset + vertexCount > MAX_VERTEX)
+        {
+            glCheck(glBufferData(GL_ARRAY_BUFFER, sizeof(sf::Vertex) * MAX_VERTEX, 0, GL_STREAM_DRAW));
+            m_vboOffset = 0;
+
+            // The retained batches went away with the previous storage (their
+            // entries are kept, to reuse the memory of their copies)
+            m_retainedCount = 0;
+            m_retainedCursor = 0;
+        }
+
+        std::size_t offset = m_vboOffset;
+        GLintptr    byteOffset = static_cast<GLintptr>(sizeof(sf::Vertex) * offset);
+        GLsizeiptr  byteSize = static_cast<GLsizeiptr>(sizeof(sf::Vertex) * vertexCount);
+
+        m_vboOffset += vertexCount;
+
+        sf::priv::getRenderStats().bytesUploaded += byteSize;
+
+#if !defined(SFML_SYSTEM_EMSCRIPTEN)
+
+        // The written range is never in use by the GPU, no need to synchronize
+        if (m_mapBufferRange)
+        {
+            void* destination = nullptr;
+            glCheck(destination = glMapBufferRange(GL_ARRAY_BUFFER, byteOffset, byteSize,
+                                                   GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+
+            if (destination)
+            {
+                std::memcpy(destination, vertices, byteSize);
+
+                GLboolean result = GL_FALSE;
+                glCheck(result = glUnmapBuffer(GL_ARRAY_BUFFER));
+
+                if (result == GL_TRUE)
+                    return offset;
+            }
+        }
+
+#endif
+
+        glCheck(glBufferSubData(GL_ARRAY_BUFFER, byteOffset, byteSize, vertices));
+
+        return offset;
+    };
+
+
+    std::size_t SfmlRenderPipeline::streamBatch(bool& reused)
+    {
+        SFML_TRACE_SCOPE("SfmlRenderPipeline::streamBatch");
+
+        // Scenes that don't change from one frame to the next flush the same
+        // batches in the same order: the search starts after the last match,
+        // and the copy already in the streaming buffer is drawn again (its
+        // range is never written until the ring wraps and orphans it)
+        const std::size_t count = m_batchVertices.size();
+        const sf::Uint8*  slots = (m_batchTextureCount > 1) ? m_batchSlots.data() : nullptr;
+        const sf::Uint64  hash  = hashBatch(m_batchVertices.data(), count, slots, m_batchType);
+
+        ++m_batchSerial;
+
+        for (std::size_t i = 0; i < m_retainedCount; ++i)
+        {
+            std::size_t index = (m_retainedCursor + i) % m_retainedCount;
+            RetainedBatch& batch = m_retainedBatches[index];
+
+            if ((batch.hash != hash) || (batch.type != m_batchType) || (batch.vertices.size() != count) ||
+                (batch.slots.size() != (slots ? count : 0)))
+                continue;
+
+            if ((std::memcmp(batch.vertices.data(), m_batchVertices.data(), count * sizeof(sf::Vertex)) != 0) ||
+                (slots && (std::memcmp(batch.slots.data(), slots, count) != 0)))
+                continue;
+
+            batch.lastUse = m_batchSerial;
+            m_retainedCursor = index + 1;
+            ++sf::priv::getRenderStats().batchesReused;
+
+            reused = true;
+            return batch.offset;
+        }
+
+        reused = false;
+
+        // Streaming may wrap the ring and forget the retained batches, record the new one after
+        std::size_t offset = streamVertices(m_batchVertices.data(), count, (m_batchType == sf::Quads) ? 4 : 1);
+
+        std::size_t index = m_retainedCount;
+        if (index < MAX_RETAINED_BATCHES)
+        {
+            if (index == m_retainedBatches.size())
+                m_retainedBatches.push_back(RetainedBatch());
+
+            ++m_retainedCount;
+        }
+        else
+        {
+            index = 0;
+            for (std::size_t i = 1; i < m_retainedCount; ++i)
+            {
+                if (m_retainedBatches[i].lastUse < m_retainedBatches[index].lastUse)
+                    index = i;
+            }
+        }
+
+        // The copies reuse the memory of the entry they replace
+        RetainedBatch& batch = m_retainedBatches[index];
+        batch.hash    = hash;
+        batch.type    = m_batchType;
+        batch.offset  = offset;
+        batch.lastUse = m_batchSerial;
+        batch.vertices.assign(m_batchVertices.begin(), m_batchVertices.end());
+        if (slots)
+            batch.slots.assign(slots, slots + count);
+        else
+            batch.slots.clear();
+
+        m_retainedCursor = index + 1;
+
+        return offset;
+    };
+
+
+    void SfmlRenderPipeline::drawVertexBuffer(const sf::VertexBuffer& vertexBuffer,
+                                              std::size_t             firstVertex,
+                                              std::size_t             vertexCount,
+                                              const sf::Texture*      texture,
+                                              const sf::Shader*       shader)
+    {
+        m_normalizedTexCoords = (vertexBuffer.getFormat() == sf::VertexBuffer::Packed);
+        preDraw(texture, shader);
+        m_normalizedTexCoords = false;
+
+        sf::VertexBuffer::bind(&vertexBuffer);
+
+        // borrow the pipeline quad indices
+        if (vertexBuffer.getPrimitiveType() == sf::Quads)
+            sf::priv::getGLStateCache().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadIndices);
+
+        // buffers of an arena start further in the shared buffer
+        drawPrimitives(vertexBuffer.getPrimitiveType(), vertexBuffer.getNativeOffset() + firstVertex, vertexCount);
+
+        sf::VertexBuffer::bind(nullptr);
+
+        postDraw(texture, shader);
+    };
+
+
+    
+    void SfmlRenderPipeline::drawPrimitives(sf::PrimitiveType   type,
+                                            std::size_t         firstVertex,
+                                            std::size_t         vertexCount)
+    {
+        // GLES and WebGL have no GL_QUADS, quads are always drawn as indexed triangles
+        if (type == sf::Quads)
+        {
+            drawIndexedQuads(firstVertex, vertexCount);
+            return;
+        }
+
+        static const GLenum modes [] = { GL_POINTS,     GL_LINES,           GL_LINE_STRIP,
+                                         GL_TRIANGLES,  GL_TRIANGLE_STRIP,  GL_TRIANGLE_FAN };
+        GLenum mode = modes[type];
+
+        glCheck(glDrawArrays(mode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
+
+        sf::RenderStats& stats = sf::priv::getRenderStats();
+        ++stats.drawCalls;
+        stats.vertices += vertexCount;
+    };
+
+
+    void SfmlRenderPipeline::drawVertexRanges(const sf::Vertex*   vertices,
+                                              const std::size_t*  firstVertices,
+                                              const std::size_t*  vertexCounts,
+                                              std::size_t         rangeCount,
+                                              sf::PrimitiveType   type,
+                                              const sf::Texture*  texture,
+                                              const sf::Shader*   shader)
+    {
+        // the vertices spanned by all the ranges are streamed at once
+        std::size_t start = firstVertices[0];
+        std::size_t end = 0;
+        for (std::size_t i = 0; i < rangeCount; ++i)
+        {
+            start = std::min(start, firstVertices[i]);
+            end = std::max(end, firstVertices[i] + vertexCounts[i]);
+        }
+
+        // quads are indexed from the start of each range, and a big span
+        // doesn't fit in the streaming buffer: draw the ranges one by one
+        if ((type == sf::Quads) || (end - start > MAX_VERTEX))
+        {
+            for (std::size_t i = 0; i < rangeCount; ++i)
+            {
+                if (vertexCounts[i] > 0)
+                    drawVertices(vertices, type, firstVertices[i], vertexCounts[i], texture, shader);
+            }
+            return;
+        }
+
+        preDraw(texture, shader);
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+        cache.bindVertexArray(m_vao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+        std::size_t offset = streamVertices(vertices + start, end - start);
+
+        m_rangeFirsts.clear();
+        m_rangeCounts.clear();
+        for (std::size_t i = 0; i < rangeCount; ++i)
+        {
+            if (vertexCounts[i] > 0)
+            {
+                m_rangeFirsts.push_back(static_cast<GLint>(offset + firstVertices[i] - start));
+                m_rangeCounts.push_back(static_cast<GLsizei>(vertexCounts[i]));
+            }
+        }
+
+        drawRanges(type);
+
+        postDraw(texture, shader);
+    };
+
+
+    void SfmlRenderPipeline::drawVertexBufferRanges(const sf::VertexBuffer& vertexBuffer,
+                                                    const std::size_t*      firstVertices,
+                                                    const std::size_t*      vertexCounts,
+                                                    std::size_t             rangeCount,
+                                                    const sf::Texture*      texture,
+                                                    const sf::Shader*       shader)
+    {
+        // ranges are clamped to the buffer, like single draws
+        std::size_t bufferCount = vertexBuffer.getVertexCount();
+        std::size_t base = vertexBuffer.getNativeOffset();
+
+        m_rangeFirsts.clear();
+        m_rangeCounts.clear();
+        for (std::size_t i = 0; i < rangeCount; ++i)
+        {
+            if (firstVertices[i] >= bufferCount)
+                continue;
+
+            std::size_t count = std::min(vertexCounts[i], bufferCount - firstVertices[i]);
+            if (count > 0)
+            {
+                m_rangeFirsts.push_back(static_cast<GLint>(base + firstVertices[i]));
+                m_rangeCounts.push_back(static_cast<GLsizei>(count));
+            }
+        }
+
+        if (m_rangeFirsts.empty())
+            return;
+
+        m_normalizedTexCoords = (vertexBuffer.getFormat() == sf::VertexBuffer::Packed);
+        preDraw(texture, shader);
+        m_normalizedTexCoords = false;
+
+        sf::VertexBuffer::bind(&vertexBuffer);
+
+        // borrow the pipeline quad indices
+        if (vertexBuffer.getPrimitiveType() == sf::Quads)
+            sf::priv::getGLStateCache().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadIndices);
+
+        drawRanges(vertexBuffer.getPrimitiveType());
+
+        sf::VertexBuffer::bind(nullptr);
+
+        postDraw(texture, shader);
+    };
+
+
+    void SfmlRenderPipeline::drawVertexBufferList(const sf::VertexBuffer* const* vertexBuffers,
+                                                  std::size_t                   count,
+                                                  const sf::Texture*            texture,
+                                                  const sf::Shader*             shader)
+    {
+        std::size_t i = 0;
+        while (i < count)
+        {
+            const sf::VertexBuffer* first = vertexBuffers[i];
+            if (!first || !first->getVertexCount() || !first->getNativeHandleArray())
+            {
+                ++i;
+                continue;
+            }
+
+            // a run is made of the buffers that share the vertex array of the first one
+            m_rangeFirsts.clear();
+            m_rangeCounts.clear();
+            for (; i < count; ++i)
+            {
+                const sf::VertexBuffer* buffer = vertexBuffers[i];
+                if (!buffer || !buffer->getVertexCount() || !buffer->getNativeHandleArray())
+                    continue;
+
+                if ((buffer->getNativeHandleArray() != first->getNativeHandleArray()) || (buffer->getPrimitiveType() != first->getPrimitiveType()))
+                    break;
+
+                buffer->flush();
+                m_rangeFirsts.push_back(static_cast<GLint>(buffer->getNativeOffset()));
+                m_rangeCounts.push_back(static_cast<GLsizei>(buffer->getVertexCount()));
+            }
+
+            m_normalizedTexCoords = (first->getFormat() == sf::VertexBuffer::Packed);
+            preDraw(texture, shader);
+            m_normalizedTexCoords = false;
+
+            sf::VertexBuffer::bind(first);
+
+            // borrow the pipeline quad indices
+            if (first->getPrimitiveType() == sf::Quads)
+                sf::priv::getGLStateCache().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadIndices);
+
+            drawRanges(first->getPrimitiveType());
+
+            sf::VertexBuffer::bind(nullptr);
+
+            postDraw(texture, shader);
+        }
+    };
+
+
+    void SfmlRenderPipeline::drawRanges(sf::PrimitiveType type)
+    {
+        // each range restarts its primitive, strips and fans don't
+        // need to be unrolled; quads are indexed and have no multi-draw
+        if ((type == sf::Quads) || (m_rangeFirsts.size() == 1) || !sf::priv::isMultiDrawAvailable())
+        {
+            for (std::size_t i = 0; i < m_rangeFirsts.size(); ++i)
+                drawPrimitives(type, static_cast<std::size_t>(m_rangeFirsts[i]), static_cast<std::size_t>(m_rangeCounts[i]));
+            return;
+        }
+
+        static const GLenum modes [] = { GL_POINTS,     GL_LINES,           GL_LINE_STRIP,
+                                         GL_TRIANGLES,  GL_TRIANGLE_STRIP,  GL_TRIANGLE_FAN };
+
+        glCheck(sf::priv::multiDrawArrays(modes[type], m_rangeFirsts.data(), m_rangeCounts.data(), static_cast<GLsizei>(m_rangeFirsts.size())));
+
+        sf::RenderStats& stats = sf::priv::getRenderStats();
+        ++stats.drawCalls;
+        for (std::size_t i = 0; i < m_rangeCounts.size(); ++i)
+            stats.vertices += static_cast<std::size_t>(m_rangeCounts[i]);
+    };
+
+
+    void SfmlRenderPipeline::drawIndexedVertices(const sf::Vertex*  vertices,
+                                                 std::size_t        vertexCount,
+                                                 const sf::Uint16*  indices,
+                                                 std::size_t        indexCount,
+                                                 sf::PrimitiveType  type,
+                                                 const sf::Texture* texture,
+                                                 const sf::Shader*  shader)
+    {
+        preDraw(texture, shader);
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+        cache.bindVertexArray(m_vao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+        std::size_t offset = streamVertices(vertices, vertexCount);
+
+        // The indices address the start of the streaming buffer: shift them
+        // to where the vertices landed, they still fit in 16 bits
+        if (offset > 0)
+        {
+            m_rebasedIndices.resize(indexCount);
+            for (std::size_t i = 0; i < indexCount; ++i)
+                m_rebasedIndices[i] = static_cast<GLushort>(indices[i] + offset);
+            indices = &m_rebasedIndices[0];
+        }
+
+        // the element array binding is part of the vertex array state,
+        // the quad indices are restored right after the draw
+        if (!m_streamIndices)
+            glCheck(glGenBuffers(1, &m_streamIndices));
+
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_streamIndices);
+        glCheck(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * indexCount, indices, GL_STREAM_DRAW));
+
+        static const GLenum modes [] = { GL_POINTS,     GL_LINES,           GL_LINE_STRIP,
+                                         GL_TRIANGLES,  GL_TRIANGLE_STRIP,  GL_TRIANGLE_FAN };
+        glCheck(glDrawElements(modes[type], static_cast<GLsizei>(indexCount), GL_UNSIGNED_SHORT, 0));
+
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadIndices);
+
+        sf::RenderStats& stats = sf::priv::getRenderStats();
+        ++stats.drawCalls;
+        stats.vertices += indexCount;
+        stats.bytesUploaded += sizeof(GLushort) * indexCount;
+
+        postDraw(texture, shader);
+    };
+
+
+    void SfmlRenderPipeline::drawIndexedBuffer(const sf::VertexBuffer& vertexBuffer,
+                                               const sf::IndexBuffer&  indexBuffer,
+                                               std::size_t             firstIndex,
+                                               std::size_t             indexCount,
+                                               const sf::Texture*      texture,
+                                               const sf::Shader*       shader)
+    {
+        // the indices of buffers of an arena are shifted by the first vertex of their range
+        std::size_t baseVertex = vertexBuffer.getNativeOffset();
+        if (baseVertex && !m_drawBaseVertex)
+        {
+            sf::err() << "Failed to draw indexed vertex buffer: buffers of an arena need base vertex support" << std::endl;
+            return;
+        }
+
+        m_normalizedTexCoords = (vertexBuffer.getFormat() == sf::VertexBuffer::Packed);
+        preDraw(texture, shader);
+        m_normalizedTexCoords = false;
+
+        sf::VertexBuffer::bind(&vertexBuffer);
+        sf::priv::getGLStateCache().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer.getNativeHandle());
+
+        bool wide = (indexBuffer.getType() == sf::IndexBuffer::UnsignedInt);
+        std::size_t indexSize = wide ? sizeof(GLuint) : sizeof(GLushort);
+
+        static const GLenum modes [] = { GL_POINTS,     GL_LINES,           GL_LINE_STRIP,
+                                         GL_TRIANGLES,  GL_TRIANGLE_STRIP,  GL_TRIANGLE_FAN };
+#if !defined(SFML_SYSTEM_EMSCRIPTEN)
+        if (baseVertex)
+        {
+            glCheck(glDrawElementsBaseVertex(modes[vertexBuffer.getPrimitiveType()], static_cast<GLsizei>(indexCount),
+                                             wide ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT,
+                                             reinterpret_cast<const void*>(firstIndex * indexSize), static_cast<GLint>(baseVertex)));
+        }
+        else
+#endif
+        {
+            glCheck(glDrawElements(modes[vertexBuffer.getPrimitiveType()], static_cast<GLsizei>(indexCount),
+                                   wide ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT,
+                                   reinterpret_cast<const void*>(firstIndex * indexSize)));
+        }
+
+        sf::RenderStats& stats = sf::priv::getRenderStats();
+        ++stats.drawCalls;
+        stats.vertices += indexCount;
+
+        sf::VertexBuffer::bind(nullptr);
+
+        postDraw(texture, shader);
+    };
+
+
+    void SfmlRenderPipeline::drawIndexedQuads(std::size_t firstVertex, std::size_t vertexCount)
+    {
+        vertexCount -= vertexCount % 4;
+
+        sf::RenderStats& stats = sf::priv::getRenderStats();
+        stats.vertices += vertexCount;
+
+        // Common case: the range is addressable by the 16-bit quad indices
+        if ((firstVertex % 4 == 0) && (firstVertex + vertexCount <= MAX_VERTEX))
+        {
+            std::size_t firstIndex = (firstVertex / 4) * 6;
+            glCheck(glDrawElements(GL_TRIANGLES, static_cast<GLsizei>((vertexCount / 4) * 6), GL_UNSIGNED_SHORT,
+                                   reinterpret_cast<const void*>(firstIndex * sizeof(GLushort))));
+            ++stats.drawCalls;
+            return;
+        }
+
+        // Large or unaligned vertex buffer ranges
+#if !defined(SFML_SYSTEM_EMSCRIPTEN)
+        if (m_drawBaseVertex)
+        {
+            for (std::size_t first = 0; first < vertexCount; first += MAX_VERTEX)
+            {
+                std::size_t count = std::min<std::size_t>(MAX_VERTEX, vertexCount - first);
+                glCheck(glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>((count / 4) * 6), GL_UNSIGNED_SHORT,
+                                                 0, static_cast<GLint>(firstVertex + first)));
+                ++stats.drawCalls;
+            }
+            return;
+        }
+#endif
+
+#if !defined(SFML_OPENGL_ES)
+        glCheck(glDrawArrays(GL_QUADS, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
+        ++stats.drawCalls;
+#else
+        sf::err() << "Failed to draw quads: range of the vertex buffer is not addressable without base vertex support" << std::endl;
+#endif
+    };
+
+
+    bool SfmlRenderPipeline::createInstancing()
+    {
+        // same as the built-in shader, but the vertex is built from the unit quad corner and the instance data
+        const char* vertexShaderSource =
+            "#version 100                                                   \n"
+            "precision mediump float;                                       \n"
+            "uniform mat4 aViewProj;                                        \n"
+            "uniform bool bTexFlip;                                         \n"
+            "attribute vec2 aCorner;                                        \n"
+            "attribute vec4 aColor;                                         \n"
+            "attribute vec4 aTexRect;                                       \n"
+            "attribute vec3 aRow0;                                          \n"
+            "attribute vec3 aRow1;                                          \n"
+            "varying vec4 oColor;                                           \n"
+            "varying vec2 oTexCoord;                                        \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "   vec3 corner = vec3(aCorner, 1.0);                           \n"
+            "   oColor = aColor;                                            \n"
+            "   oTexCoord = aTexRect.xy + aCorner * aTexRect.zw;            \n"
+            "   if (bTexFlip)                                               \n"
+            "       oTexCoord.y = 1.0 - oTexCoord.y;                        \n"
+            "                                                               \n"
+            "   gl_Position = aViewProj * vec4(dot(aRow0, corner), dot(aRow1, corner), 0.0, 1.0); \n"
+            "}\n\0";
+
+        const char* fragmentShaderSource =
+            "#version 100                                                   \n"
+            "precision mediump float;                                       \n"
+            "uniform sampler2D Texture0;                                    \n"
+            "uniform bool bUseTexture;                                      \n"
+            "uniform bool bTexSingleChannel;                                \n"
+            "varying vec4 oColor;                                           \n"
+            "varying vec2 oTexCoord;                                        \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "   if (bUseTexture)                                            \n"
+            "   {                                                           \n"
+            "       vec4 texel = texture2D(Texture0, oTexCoord);            \n"
+            "       if (bTexSingleChannel)                                  \n"
+            "           texel = vec4(1.0, 1.0, 1.0, texel.r);               \n"
+            "       gl_FragColor = texel * oColor;                          \n"
+            "   }                                                           \n"
+            "   else                                                        \n"
+            "       gl_FragColor = oColor;                                  \n"
+            "}\n\0";
+
+        m_instanceShader.setAttributes({ "aCorner", "aColor", "aTexRect", "aRow0", "aRow1" });
+
+        if (!m_instanceShader.loadFromMemory(vertexShaderSource, fragmentShaderSource))
+            return false;
+
+        m_instanceShaderId = m_instanceShader.getNativeHandle();
+
+        glCheck(m_locInstanceViewProj = glGetUniformLocation(m_instanceShaderId, "aViewProj"));
+        glCheck(m_locInstanceTexFlipped = glGetUniformLocation(m_instanceShaderId, "bTexFlip"));
+        glCheck(m_locInstanceUseTexture = glGetUniformLocation(m_instanceShaderId, "bUseTexture"));
+        glCheck(m_locInstanceSingleChannel = glGetUniformLocation(m_instanceShaderId, "bTexSingleChannel"));
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+
+        cache.useProgram(m_instanceShaderId);
+        glCheck(glUniform1i(glGetUniformLocation(m_instanceShaderId, "Texture0"), 0));
+
+        // unit quad, in sf::Quads order to match the quad indices
+        static const float corners[] = { 0.f, 0.f,  0.f, 1.f,  1.f, 1.f,  1.f, 0.f };
+
+        glCheck(SFML_GL_EXT_glGenVertexArrays(1, &m_instanceVao));
+        glCheck(glGenBuffers(1, &m_quadCorners));
+
+        cache.bindVertexArray(m_instanceVao);
+
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_quadCorners);
+        glCheck(glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW));
+        glCheck(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0));
+        glCheck(glEnableVertexAttribArray(0));
+
+        // the instance attributes advance once per quad, their buffer is set for each draw
+        for (GLuint attribute = 1; attribute <= 4; ++attribute)
+        {
+            glCheck(glEnableVertexAttribArray(attribute));
+            glCheck(sf::priv::vertexAttribDivisor(attribute, 1));
+        }
+
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadIndices);
+
+        cache.bindVertexArray(0);
+
+        return true;
+    };
+
+
+    bool SfmlRenderPipeline::createParticles()
+    {
+        if (m_particlesFailed)
+            return false;
+
+        // the unit quad corners and indices are shared with the instanced quad pipeline
+        if (!m_instanceVao && !createInstancing())
+        {
+            m_particlesFailed = true;
+            return false;
+        }
+
+        // the particle is animated from its age: ballistic motion, linear growth, spin and color fade
+        const char* vertexShaderSource =
+            "#version 100                                                   \n"
+            "precision highp float;                                         \n"
+            "uniform mat4 aViewProj;                                        \n"
+            "uniform bool bTexFlip;                                         \n"
+            "uniform float uTime;                                           \n"
+            "uniform vec2 uGravity;                                         \n"
+            "attribute vec2 aCorner;                                        \n"
+            "attribute vec4 aMotion;                                        \n"
+            "attribute vec4 aLife;                                          \n"
+            "attribute vec2 aSpin;                                          \n"
+            "attribute vec4 aTexRect;                                       \n"
+            "attribute vec4 aStartColor;                                    \n"
+            "attribute vec4 aEndColor;                                      \n"
+            "varying vec4 oColor;                                           \n"
+            "varying vec2 oTexCoord;                                        \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "   float age = uTime - aLife.x;                                \n"
+            "   float progress = age / aLife.y;                             \n"
+            "   oColor = mix(aStartColor, aEndColor, progress);             \n"
+            "   oTexCoord = aTexRect.xy + aCorner * aTexRect.zw;            \n"
+            "   if (bTexFlip)                                               \n"
+            "       oTexCoord.y = 1.0 - oTexCoord.y;                        \n"
+            "                                                               \n"
+            "   if ((progress < 0.0) || (progress > 1.0))                   \n"
+            "   {                                                           \n"
+            "       gl_Position = vec4(0.0, 0.0, 2.0, 1.0);                 \n"
+            "       return;                                                 \n"
+            "   }                                                           \n"
+            "                                                               \n"
+            "   vec2 position = aMotion.xy + aMotion.zw * age + 0.5 * uGravity * age * age; \n"
+            "   vec2 offset = (aCorner - 0.5) * mix(aLife.z, aLife.w, progress); \n"
+            "   float angle = aSpin.x + aSpin.y * age;                      \n"
+            "   float c = cos(angle);                                       \n"
+            "   float s = sin(angle);                                       \n"
+            "   position += vec2(offset.x * c - offset.y * s, offset.x * s + offset.y * c); \n"
+            "                                                               \n"
+            "   gl_Position = aViewProj * vec4(position, 0.0, 1.0);         \n"
+            "}\n\0";
+
+        const char* fragmentShaderSource =
+            "#version 100                                                   \n"
+            "precision mediump float;                                       \n"
+            "uniform sampler2D Texture0;                                    \n"
+            "uniform bool bUseTexture;                                      \n"
+            "uniform bool bTexSingleChannel;                                \n"
+            "varying vec4 oColor;                                           \n"
+            "varying vec2 oTexCoord;                                        \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "   if (bUseTexture)                                            \n"
+            "   {                                                           \n"
+            "       vec4 texel = texture2D(Texture0, oTexCoord);            \n"
+            "       if (bTexSingleChannel)                                  \n"
+            "           texel = vec4(1.0, 1.0, 1.0, texel.r);               \n"
+            "       gl_FragColor = texel * oColor;                          \n"
+            "   }                                                           \n"
+            "   else                                                        \n"
+            "       gl_FragColor = oColor;                                  \n"
+            "}\n\0";
+
+        m_particleShader.setAttributes({ "aCorner", "aMotion", "aLife", "aSpin", "aTexRect", "aStartColor", "aEndColor" });
+
+        if (!m_particleShader.loadFromMemory(vertexShaderSource, fragmentShaderSource))
+        {
+            m_particlesFailed = true;
+            return false;
+        }
+
+        m_particleShaderId = m_particleShader.getNativeHandle();
+
+        glCheck(m_locParticleViewProj = glGetUniformLocation(m_particleShaderId, "aViewProj"));
+        glCheck(m_locParticleTexFlipped = glGetUniformLocation(m_particleShaderId, "bTexFlip"));
+        glCheck(m_locParticleUseTexture = glGetUniformLocation(m_particleShaderId, "bUseTexture"));
+        glCheck(m_locParticleSingleChannel = glGetUniformLocation(m_particleShaderId, "bTexSingleChannel"));
+        glCheck(m_locParticleTime = glGetUniformLocation(m_particleShaderId, "uTime"));
+        glCheck(m_locParticleGravity = glGetUniformLocation(m_particleShaderId, "uGravity"));
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+
+        cache.useProgram(m_particleShaderId);
+        glCheck(glUniform1i(glGetUniformLocation(m_particleShaderId, "Texture0"), 0));
+
+        glCheck(SFML_GL_EXT_glGenVertexArrays(1, &m_particleVao));
+
+        cache.bindVertexArray(m_particleVao);
+
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_quadCorners);
+        glCheck(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0));
+        glCheck(glEnableVertexAttribArray(0));
+
+        // the instance attributes advance once per particle, their buffer is set for each draw
+        for (GLuint attribute = 1; attribute <= 6; ++attribute)
+        {
+            glCheck(glEnableVertexAttribArray(attribute));
+            glCheck(sf::priv::vertexAttribDivisor(attribute, 1));
+        }
+
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadIndices);
+
+        cache.bindVertexArray(0);
+
+        return true;
+    };
+
+
+    bool SfmlRenderPipeline::createAnimation()
+    {
+        if (m_animationFailed)
+            return false;
+
+        // the unit quad corners and indices are shared with the instanced quad pipeline
+        if (!m_instanceVao && !createInstancing())
+        {
+            m_animationFailed = true;
+            return false;
+        }
+
+        // the frame is picked from the time elapsed since the start of the animation; the frames
+        // are texture rectangles in pixels, which also give the size of the quad
+        const char* vertexShaderSource =
+            "precision highp float;                                         \n"
+            "uniform mat4 aViewProj;                                        \n"
+            "uniform bool bTexFlip;                                         \n"
+            "uniform float uTime;                                           \n"
+            "uniform vec2 uTexScale;                                        \n"
+            "uniform vec4 uFrames[MAX_FRAMES];                              \n"
+            "attribute vec2 aCorner;                                        \n"
+            "attribute vec3 aRow0;                                          \n"
+            "attribute vec3 aRow1;                                          \n"
+            "attribute vec4 aAnimation;                                     \n"
+            "attribute vec4 aColor;                                         \n"
+            "varying vec4 oColor;                                           \n"
+            "varying vec2 oTexCoord;                                        \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "   float frame = floor((uTime - aAnimation.w) * aAnimation.z); \n"
+            "   vec4 rect = uFrames[int(aAnimation.x + mod(frame, aAnimation.y) + 0.5)]; \n"
+            "   vec3 corner = vec3(aCorner * rect.zw, 1.0);                 \n"
+            "   oColor = aColor;                                            \n"
+            "   oTexCoord = (rect.xy + aCorner * rect.zw) * uTexScale;      \n"
+            "   if (bTexFlip)                                               \n"
+            "       oTexCoord.y = 1.0 - oTexCoord.y;                        \n"
+            "                                                               \n"
+            "   gl_Position = aViewProj * vec4(dot(aRow0, corner), dot(aRow1, corner), 0.0, 1.0); \n"
+            "}\n";
+
+        const char* fragmentShaderSource =
+            "#version 100                                                   \n"
+            "precision mediump float;                                       \n"
+            "uniform sampler2D Texture0;                                    \n"
+            "uniform bool bUseTexture;                                      \n"
+            "uniform bool bTexSingleChannel;                                \n"
+            "varying vec4 oColor;                                           \n"
+            "varying vec2 oTexCoord;                                        \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "   if (bUseTexture)                                            \n"
+            "   {                                                           \n"
+            "       vec4 texel = texture2D(Texture0, oTexCoord);            \n"
+            "       if (bTexSingleChannel)                                  \n"
+            "           texel = vec4(1.0, 1.0, 1.0, texel.r);               \n"
+            "       gl_FragColor = texel * oColor;                          \n"
+            "   }                                                           \n"
+            "   else                                                        \n"
+            "       gl_FragColor = oColor;                                  \n"
+            "}\n\0";
+
+        m_animationShader.setAttributes({ "aCorner", "aRow0", "aRow1", "aAnimation", "aColor" });
+
+        const std::string vertexShader = "#version 100\n#define MAX_FRAMES " +
+                                         std::to_string(sf::AnimatedSpriteBatch::MaxFrames) + "\n" + vertexShaderSource;
+
+        if (!m_animationShader.loadFromMemory(vertexShader.c_str(), fragmentShaderSource))
+        {
+            m_animationFailed = true;
+            return false;
+        }
+
+        m_animationShaderId = m_animationShader.getNativeHandle();
+        m_animationFramesId = 0;
+
+        glCheck(m_locAnimationViewProj = glGetUniformLocation(m_animationShaderId, "aViewProj"));
+        glCheck(m_locAnimationTexFlipped = glGetUniformLocation(m_animationShaderId, "bTexFlip"));
+        glCheck(m_locAnimationUseTexture = glGetUniformLocation(m_animationShaderId, "bUseTexture"));
+        glCheck(m_locAnimationSingleChannel = glGetUniformLocation(m_animationShaderId, "bTexSingleChannel"));
+        glCheck(m_locAnimationTime = glGetUniformLocation(m_animationShaderId, "uTime"));
+        glCheck(m_locAnimationTexScale = glGetUniformLocation(m_animationShaderId, "uTexScale"));
+        glCheck(m_locAnimationFrames = glGetUniformLocation(m_animationShaderId, "uFrames"));
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+
+        cache.useProgram(m_animationShaderId);
+        glCheck(glUniform1i(glGetUniformLocation(m_animationShaderId, "Texture0"), 0));
+
+        glCheck(SFML_GL_EXT_glGenVertexArrays(1, &m_animationVao));
+
+        cache.bindVertexArray(m_animationVao);
+
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_quadCorners);
+        glCheck(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0));
+        glCheck(glEnableVertexAttribArray(0));
+
+        // the instance attributes advance once per sprite, their buffer is set for each draw
+        for (GLuint attribute = 1; attribute <= 4; ++attribute)
+        {
+            glCheck(glEnableVertexAttribArray(attribute));
+            glCheck(sf::priv::vertexAttribDivisor(attribute, 1));
+        }
+
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadIndices);
+
+        cache.bindVertexArray(0);
+
+        return true;
+    };
+
+
+    PipelineVariant& SfmlRenderPipeline::getVariant(unsigned int key)
+    {
+        // untextured draws have no texture to flip or to read, and the texture
+        // coordinates of multi-texture batches are resolved on the CPU; the
+        // overdraw heatmap doesn't read the texture either
+        if (key & VariantOverdraw)
+            key = VariantOverdraw;
+        else if (!(key & VariantTextured))
+            key &= VariantAlphaMask;
+        else if (key & VariantMultiTexture)
+            key = VariantTextured | VariantMultiTexture;
+
+        PipelineVariant& variant = m_variants[key];
+        if (variant.id)
+            return variant;
+
+        if (!variant.pending)
+            submitVariant(key);
+
+        return finishVariant(key);
+    };
+
+
+    void SfmlRenderPipeline::submitVariant(unsigned int key)
+    {
+        PipelineVariant& variant = m_variants[key];
+
+        // all the variants are built from the same sources, specialised by the preprocessor
+        const char* vertexShaderSource =
+            "precision mediump float;                               \n"
+            "uniform mat4 aViewProj;                                \n"
+            "attribute vec2 aPos;                                   \n"
+            "attribute vec4 aColor;                                 \n"
+            "varying vec4 oColor;                                   \n"
+            "#ifdef TEXTURED                                        \n"
+            "uniform highp vec2 vTexScale;                          \n"
+            "attribute highp vec2 aTexCoord;                        \n"
+            "varying vec2 oTexCoord;                                \n"
+            "#endif                                                 \n"
+            "#ifdef MULTI_TEXTURE                                   \n"
+            "attribute float aTexSlot;                              \n"
+            "varying float oTexSlot;                                \n"
+            "#endif                                                 \n"
+            "void main()                                            \n"
+            "{                                                      \n"
+            "   oColor = aColor;                                    \n"
+            "#ifdef MULTI_TEXTURE                                   \n"
+            "   oTexSlot = aTexSlot;                                \n"
+            "#endif                                                 \n"
+            "#ifdef TEXTURED                                        \n"
+            "   oTexCoord = aTexCoord * vTexScale;                  \n"
+            "#ifdef FLIPPED                                         \n"
+            "   oTexCoord.y = 1.0 - oTexCoord.y;                    \n"
+            "#endif                                                 \n"
+            "#endif                                                 \n"
+            "   gl_Position = aViewProj * vec4(aPos.xy, 0.0, 1.0);  \n"
+            "}\n";
+
+        // the alpha channel of distance fields stores the distance to the
+        // edge (0.5), the antialiasing band follows the screen-space rate
+        // of change when derivatives are available
+        const char* fragmentShaderSource =
+            "#if defined(DISTANCE_FIELD) && defined(GL_OES_standard_derivatives) \n"
+            "#extension GL_OES_standard_derivatives : enable                \n"
+            "#endif                                                         \n"
+            "precision mediump float;                                       \n"
+            "varying vec4 oColor;                                           \n"
+            "#ifdef TEXTURED                                                \n"
+            "varying vec2 oTexCoord;                                        \n"
+            "#endif                                                         \n"
+            "#ifdef MULTI_TEXTURE                                           \n"
+            "uniform sampler2D Textures[TEXTURE_SLOTS];                     \n"
+            "varying float oTexSlot;                                        \n"
+            "vec4 sampleTexture(vec2 coords)                                \n"
+            "{                                                              \n"
+            "   if (oTexSlot < 0.5) return texture2D(Textures[0], coords);  \n"
+            "#if TEXTURE_SLOTS > 2                                          \n"
+            "   if (oTexSlot < 1.5) return texture2D(Textures[1], coords);  \n"
+            "#endif                                                         \n"
+            "#if TEXTURE_SLOTS > 3                                          \n"
+            "   if (oTexSlot < 2.5) return texture2D(Textures[2], coords);  \n"
+            "#endif                                                         \n"
+            "#if TEXTURE_SLOTS > 4                                          \n"
+            "   if (oTexSlot < 3.5) return texture2D(Textures[3], coords);  \n"
+            "#endif                                                         \n"
+            "#if TEXTURE_SLOTS > 5                                          \n"
+            "   if (oTexSlot < 4.5) return texture2D(Textures[4], coords);  \n"
+            "#endif                                                         \n"
+            "#if TEXTURE_SLOTS > 6                                          \n"
+            "   if (oTexSlot < 5.5) return texture2D(Textures[5], coords);  \n"
+            "#endif                                                         \n"
+            "#if TEXTURE_SLOTS > 7                                          \n"
+            "   if (oTexSlot < 6.5) return texture2D(Textures[6], coords);  \n"
+            "#endif                                                         \n"
+            "   return texture2D(Textures[TEXTURE_SLOTS - 1], coords);      \n"
+            "}                                                              \n"
+            "#elif defined(TEXTURED)                                        \n"
+            "uniform sampler2D Texture0;                                    \n"
+            "vec4 sampleTexture(vec2 coords)                                \n"
+            "{                                                              \n"
+            "   return texture2D(Texture0, coords);                         \n"
+            "}                                                              \n"
+            "#endif                                                         \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "#if defined(OVERDRAW)                                          \n"
+            "   gl_FragColor = vec4(32.0, 8.0, 2.0, 0.0) / 255.0;           \n"
+            "#elif defined(DISTANCE_FIELD)                                  \n"
+            "   vec4 texel = sampleTexture(oTexCoord);                      \n"
+            "#ifdef SINGLE_CHANNEL                                          \n"
+            "   float distance = texel.r;                                   \n"
+            "#else                                                          \n"
+            "   float distance = texel.a;                                   \n"
+            "#endif                                                         \n"
+            "#ifdef GL_OES_standard_derivatives                             \n"
+            "   float width = 0.7 * fwidth(distance);                       \n"
+            "#else                                                          \n"
+            "   float width = 0.1;                                          \n"
+            "#endif                                                         \n"
+            "   float alpha = smoothstep(0.5 - width, 0.5 + width, distance); \n"
+            "   gl_FragColor = vec4(oColor.rgb, oColor.a * alpha);          \n"
+            "#elif defined(TEXTURED)                                        \n"
+            "   vec4 texel = sampleTexture(oTexCoord);                      \n"
+            "#ifdef SINGLE_CHANNEL                                          \n"
+            "   texel = vec4(1.0, 1.0, 1.0, texel.r);                       \n"
+            "#endif                                                         \n"
+            "   gl_FragColor = texel * oColor;                              \n"
+            "#else                                                          \n"
+            "   gl_FragColor = oColor;                                      \n"
+            "#endif                                                         \n"
+            "#ifdef ALPHA_MASK                                              \n"
+            "   if (gl_FragColor.a < 0.5)                                   \n"
+            "       discard;                                                \n"
+            "#endif                                                         \n"
+            "}\n";
+
+        std::string header = "#version 100\n";
+        if (key & VariantTextured)
+            header += "#define TEXTURED\n";
+        if (key & VariantFlipped)
+            header += "#define FLIPPED\n";
+        if (key & VariantSingleChannel)
+            header += "#define SINGLE_CHANNEL\n";
+        if (key & VariantDistanceField)
+            header += "#define DISTANCE_FIELD\n";
+        if (key & VariantMultiTexture)
+            header += "#define MULTI_TEXTURE\n#define TEXTURE_SLOTS " + std::to_string(m_textureSlots) + "\n";
+        if (key & VariantOverdraw)
+            header += "#define OVERDRAW\n";
+        if (key & VariantAlphaMask)
+            header += "#define ALPHA_MASK\n";
+
+        const std::string vertexShader = header + vertexShaderSource;
+        const std::string fragmentShader = header + fragmentShaderSource;
+
+        // order should match to sf::Vertex, the texture slot comes from its own buffer
+        if (key & VariantMultiTexture)
+            variant.shader.setAttributes({ "aPos", "aColor", "aTexCoord", "aTexSlot" });
+        else
+            variant.shader.setAttributes({ "aPos", "aColor", "aTexCoord" });
+
+        // drivers with KHR_parallel_shader_compile compile and link in the background,
+        // a program restored from the shader cache is ready right away
+        variant.pending = variant.shader.loadFromMemoryAsync(vertexShader.c_str(), fragmentShader.c_str());
+    };
+
+
+    PipelineVariant& SfmlRenderPipeline::finishVariant(unsigned int key)
+    {
+        PipelineVariant& variant = m_variants[key];
+
+        bool linked = false;
+        if (variant.pending)
+        {
+            sf::Clock waitClock;
+            variant.pending = false;
+            // The variant is needed now: wait for the link rather than poll it, a link
+            // still running in the background (KHR_parallel_shader_compile) is not a failure
+            linked = variant.shader.waitUntilReady();
+
+            sf::StartupStats& startup = sf::priv::getStartupStats();
+            if (startup.firstFrameTime == sf::Time::Zero)
+                startup.shaderWaitTime += waitClock.getElapsedTime();
+        }
+
+        if (!linked)
+        {
+            if (key & VariantDistanceField)
+            {
+                sf::err() << "Failed to create the distance field pipeline, glyphs are drawn without thresholding" << std::endl;
+                m_distanceFieldFailed = true;
+                return getVariant(key & ~VariantDistanceField);
+            }
+
+            if (key & VariantMultiTexture)
+            {
+                sf::err() << "Failed to create the multi-texture pipeline, batches are broken at each texture change" << std::endl;
+                m_textureSlots = 1;
+                return variant;
+            }
+
+            // the other variants are required
+            assert(false);
+        };
+
+        // we will use native handle for native glX functions to avoid alot of template calls of shader class
+        variant.id = variant.shader.getNativeHandle();
+
+        glCheck(variant.locViewProj = glGetUniformLocation(variant.id, "aViewProj"));
+        assert(variant.locViewProj != -1);
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+        cache.useProgram(variant.id);
+
+        if (key & VariantTextured)
+        {
+            glCheck(variant.locTexScale = glGetUniformLocation(variant.id, "vTexScale"));
+
+            if (key & VariantMultiTexture)
+            {
+                // each slot samples from the texture unit of the same index
+                GLint units[MAX_BATCH_TEXTURES];
+                for (unsigned int i = 0; i < m_textureSlots; ++i)
+                    units[i] = static_cast<GLint>(i);
+
+                glCheck(glUniform1iv(glGetUniformLocation(variant.id, "Textures"), static_cast<GLsizei>(m_textureSlots), units));
+            }
+            else
+            {
+                // the built-in pipeline always samples from texture unit 0
+                glCheck(glUniform1i(glGetUniformLocation(variant.id, "Texture0"), 0));
+            }
+
+            glCheck(glUniform2f(variant.locTexScale, variant.texScale.x, variant.texScale.y));
+        };
+
+        return variant;
+    };
+
+
+    bool SfmlRenderPipeline::createLayered()
+    {
+        if (m_layeredFailed)
+            return false;
+
+        // sampler2DArray needs GLSL ES 3.00 (GLSL 1.30 on desktop)
+#if defined(SFML_OPENGL_ES) || defined(SFML_SYSTEM_EMSCRIPTEN)
+        #define SFML_LAYERED_GLSL_VERSION "#version 300 es                                                \n"
+#else
+        #define SFML_LAYERED_GLSL_VERSION "#version 130                                                   \n"
+#endif
+
+        // same as the built-in shader, with the layer as third texture coordinate
+        const char* vertexShaderSource =
+            SFML_LAYERED_GLSL_VERSION
+            "precision mediump float;                                       \n"
+            "uniform mat4 aViewProj;                                        \n"
+            "in vec2 aPos;                                                  \n"
+            "in vec4 aColor;                                                \n"
+            "in highp vec2 aTexCoord;                                       \n"
+            "in float aLayer;                                               \n"
+            "out vec4 oColor;                                               \n"
+            "out highp vec3 oTexCoord;                                      \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "   oColor = aColor;                                            \n"
+            "   oTexCoord = vec3(aTexCoord, aLayer);                        \n"
+            "   gl_Position = aViewProj * vec4(aPos.xy, 0.0, 1.0);          \n"
+            "}\n\0";
+
+        const char* fragmentShaderSource =
+            SFML_LAYERED_GLSL_VERSION
+            "precision mediump float;                                       \n"
+            "precision mediump sampler2DArray;                              \n"
+            "uniform sampler2DArray Textures;                               \n"
+            "in vec4 oColor;                                                \n"
+            "in highp vec3 oTexCoord;                                       \n"
+            "out vec4 fragColor;                                            \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "   fragColor = texture(Textures, oTexCoord) * oColor;          \n"
+            "}\n\0";
+
+#undef SFML_LAYERED_GLSL_VERSION
+
+        // order should match to sf::LayeredVertex
+        m_layeredShader.setAttributes({ "aPos", "aColor", "aTexCoord", "aLayer" });
+
+        if (!m_layeredShader.loadFromMemory(vertexShaderSource, fragmentShaderSource))
+        {
+            sf::err() << "Failed to create the texture array pipeline" << std::endl;
+            m_layeredFailed = true;
+            return false;
+        }
+
+        m_layeredShaderId = m_layeredShader.getNativeHandle();
+
+        glCheck(m_locLayeredViewProj = glGetUniformLocation(m_layeredShaderId, "aViewProj"));
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+
+        cache.useProgram(m_layeredShaderId);
+        glCheck(glUniform1i(glGetUniformLocation(m_layeredShaderId, "Textures"), 0));
+
+        glCheck(SFML_GL_EXT_glGenVertexArrays(1, &m_layeredVao));
+        glCheck(glGenBuffers(1, &m_layeredVbo));
+
+        cache.bindVertexArray(m_layeredVao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_layeredVbo);
+
+        const GLsizei stride = sizeof(sf::LayeredVertex);
+        glCheck(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(sf::LayeredVertex, position)));
+        glCheck(glEnableVertexAttribArray(0));
+        glCheck(glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(sf::LayeredVertex, color)));
+        glCheck(glEnableVertexAttribArray(1));
+        glCheck(glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(sf::LayeredVertex, texCoords)));
+        glCheck(glEnableVertexAttribArray(2));
+        glCheck(glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(sf::LayeredVertex, layer)));
+        glCheck(glEnableVertexAttribArray(3));
+
+        // quads are drawn with the shared quad indices
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadIndices);
+
+        cache.bindVertexArray(0);
+
+        return true;
+    };
+
+
+    void SfmlRenderPipeline::drawParticleInstances(unsigned int        instanceBuffer,
+                                                   std::size_t         instanceCount,
+                                                   float               time,
+                                                   const sf::Vector2f& gravity,
+                                                   const sf::Texture*  texture)
+    {
+        if (!m_particleVao && !createParticles())
+        {
+            sf::err() << "Failed to create the instanced particle pipeline" << std::endl;
+            return;
+        }
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+
+        cache.useProgram(m_particleShaderId);
+
+        if (texture)
+        {
+            sf::priv::resolveTexture(*texture);
+            sf::priv::bindSampledTexture(0, *texture);
+        };
+
+        glUniform1i(m_locParticleTexFlipped, static_cast<int>(texture && texture->isFlipped()));
+        glUniform1i(m_locParticleUseTexture, static_cast<int>(texture != nullptr));
+        glUniform1i(m_locParticleSingleChannel, static_cast<int>(texture && texture->isSingleChannel()));
+        glUniform1f(m_locParticleTime, time);
+        glUniform2f(m_locParticleGravity, gravity.x, gravity.y);
+        uploadViewProj(m_locParticleViewProj);
+
+        cache.bindVertexArray(m_particleVao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+
+        const GLsizei stride = sizeof(sf::priv::ParticleInstance);
+        glCheck(glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(sf::priv::ParticleInstance, motion)));
+        glCheck(glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(sf::priv::ParticleInstance, life)));
+        glCheck(glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(sf::priv::ParticleInstance, spin)));
+        glCheck(glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(sf::priv::ParticleInstance, texRect)));
+        glCheck(glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(sf::priv::ParticleInstance, startColor)));
+        glCheck(glVertexAttribPointer(6, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(sf::priv::ParticleInstance, endColor)));
+
+        glCheck(sf::priv::drawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0, static_cast<GLsizei>(instanceCount)));
+
+        sf::RenderStats& stats = sf::priv::getRenderStats();
+        ++stats.drawCalls;
+        stats.vertices += instanceCount * 4;
+
+        postDraw(texture, nullptr);
+    };
+
+
+    void SfmlRenderPipeline::drawAnimatedInstances(unsigned int       instanceBuffer,
+                                                   std::size_t        instanceCount,
+                                                   float              time,
+                                                   const float*       frames,
+                                                   std::size_t        frameCount,
+                                                   sf::Uint64         framesId,
+                                                   const sf::Texture* texture)
+    {
+        if (!m_animationVao && !createAnimation())
+        {
+            sf::err() << "Failed to create the instanced animation pipeline" << std::endl;
+            return;
+        }
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+
+        cache.useProgram(m_animationShaderId);
+
+        if (texture)
+        {
+            sf::priv::resolveTexture(*texture);
+            sf::priv::bindSampledTexture(0, *texture);
+        };
+
+        sf::Vector2f texScale(0.f, 0.f);
+        if (texture && (texture->getSize().x > 0) && (texture->getSize().y > 0))
+            texScale = sf::Vector2f(1.f / texture->getSize().x, 1.f / texture->getSize().y);
+
+        glUniform1i(m_locAnimationTexFlipped, static_cast<int>(texture && texture->isFlipped()));
+        glUniform1i(m_locAnimationUseTexture, static_cast<int>(texture != nullptr));
+        glUniform1i(m_locAnimationSingleChannel, static_cast<int>(texture && texture->isSingleChannel()));
+        glUniform1f(m_locAnimationTime, time);
+        glUniform2f(m_locAnimationTexScale, texScale.x, texScale.y);
+        uploadViewProj(m_locAnimationViewProj);
+
+        // the frame table only changes when the frames of a batch are edited, or another batch is drawn
+        if (framesId != m_animationFramesId)
+        {
+            glCheck(glUniform4fv(m_locAnimationFrames, static_cast<GLsizei>(frameCount), frames));
+            sf::priv::getRenderStats().bytesUploaded += frameCount * 4 * sizeof(float);
+            m_animationFramesId = framesId;
+        }
+
+        cache.bindVertexArray(m_animationVao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+
+        const GLsizei stride = sizeof(sf::priv::AnimatedInstance);
+        glCheck(glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(sf::priv::AnimatedInstance, row0)));
+        glCheck(glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(sf::priv::AnimatedInstance, row1)));
+        glCheck(glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(sf::priv::AnimatedInstance, animation)));
+        glCheck(glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(sf::priv::AnimatedInstance, color)));
+
+        glCheck(sf::priv::drawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0, static_cast<GLsizei>(instanceCount)));
+
+        sf::RenderStats& stats = sf::priv::getRenderStats();
+        ++stats.drawCalls;
+        stats.vertices += instanceCount * 4;
+
+        postDraw(texture, nullptr);
+    };
+
+
+    void SfmlRenderPipeline::drawLayeredVertices(const sf::LayeredVertex*  vertices,
+                                                 sf::PrimitiveType         type,
+                                                 std::size_t               vertexCount,
+                                                 const sf::TextureArray&   textureArray,
+                                                 const sf::Shader*         shader)
+    {
+        if (!m_layeredVao && !createLayered())
+            return;
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+
+        if (shader)
+        {
+            updateFrameBlock();
+            shader->bind(shader);
+        }
+        else
+        {
+            cache.useProgram(m_layeredShaderId);
+            uploadViewProj(m_locLayeredViewProj);
+        }
+
+        // the state shadow only tracks 2D textures, the array target is bound directly;
+        // the array has its own sampling parameters, no sampler object may override them
+        cache.activeTexture(0);
+        cache.bindSampler(0, 0);
+        glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray.getNativeHandle()));
+
+        cache.bindVertexArray(m_layeredVao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_layeredVbo);
+
+        // Orphan the storage for every draw, growing it when needed
+        GLsizeiptr byteSize = static_cast<GLsizeiptr>(sizeof(sf::LayeredVertex) * vertexCount);
+        m_layeredVboCapacity = std::max(m_layeredVboCapacity, vertexCount);
+        glCheck(glBufferData(GL_ARRAY_BUFFER, sizeof(sf::LayeredVertex) * m_layeredVboCapacity, 0, GL_STREAM_DRAW));
+        glCheck(glBufferSubData(GL_ARRAY_BUFFER, 0, byteSize, vertices));
+
+        sf::priv::getRenderStats().bytesUploaded += byteSize;
+
+        drawPrimitives(type, 0, vertexCount);
+
+        glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+
+        if (shader)
+            shader->bind(nullptr);
+    };
+
+
+    PipelineVariant* SfmlRenderPipeline::getYuvVariant(sf::YuvTexture::Layout layout)
+    {
+        PipelineVariant& variant = m_yuvVariants[layout];
+        if (variant.id)
+            return &variant;
+
+        if (m_yuvFailed)
+            return nullptr;
+
+        // same as the textured built-in shader, without flipping
+        const char* vertexShaderSource =
+            "precision mediump float;                               \n"
+            "uniform mat4 aViewProj;                                \n"
+            "uniform highp vec2 vTexScale;                          \n"
+            "attribute vec2 aPos;                                   \n"
+            "attribute vec4 aColor;                                 \n"
+            "attribute highp vec2 aTexCoord;                        \n"
+            "varying vec4 oColor;                                   \n"
+            "varying vec2 oTexCoord;                                \n"
+            "void main()                                            \n"
+            "{                                                      \n"
+            "   oColor = aColor;                                    \n"
+            "   oTexCoord = aTexCoord * vTexScale;                  \n"
+            "   gl_Position = aViewProj * vec4(aPos.xy, 0.0, 1.0);  \n"
+            "}\n";
+
+        // the chroma planes are half the size of the luma plane, so the same
+        // normalized coordinates address all of them; luminance textures
+        // replicate their sample in rgb and store the second one in alpha
+        const char* fragmentShaderSource =
+            "precision mediump float;                                       \n"
+            "uniform sampler2D PlaneY;                                      \n"
+            "uniform sampler2D PlaneU;                                      \n"
+            "uniform sampler2D PlaneV;                                      \n"
+            "uniform mat3 YuvMatrix;                                        \n"
+            "uniform vec3 YuvOffset;                                        \n"
+            "varying vec4 oColor;                                           \n"
+            "varying vec2 oTexCoord;                                        \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "   vec3 yuv;                                                   \n"
+            "   yuv.x = texture2D(PlaneY, oTexCoord).r;                     \n"
+            "#if defined(NV12) && defined(LUMINANCE_ALPHA)                  \n"
+            "   yuv.yz = texture2D(PlaneU, oTexCoord).ra;                   \n"
+            "#elif defined(NV12)                                            \n"
+            "   yuv.yz = texture2D(PlaneU, oTexCoord).rg;                   \n"
+            "#else                                                          \n"
+            "   yuv.y = texture2D(PlaneU, oTexCoord).r;                     \n"
+            "   yuv.z = texture2D(PlaneV, oTexCoord).r;                     \n"
+            "#endif                                                         \n"
+            "   vec3 rgb = clamp(YuvMatrix * (yuv - YuvOffset), 0.0, 1.0);  \n"
+            "   gl_FragColor = vec4(rgb, 1.0) * oColor;                     \n"
+            "}\n";
+
+        std::string header = "#version 100\n";
+        if (layout == sf::YuvTexture::NV12)
+            header += "#define NV12\n";
+        if (!sf::Texture::isFormatAvailable(sf::Texture::R8))
+            header += "#define LUMINANCE_ALPHA\n";
+
+        const std::string vertexShader = header + vertexShaderSource;
+        const std::string fragmentShader = header + fragmentShaderSource;
+
+        // order should match to sf::Vertex
+        variant.shader.setAttributes({ "aPos", "aColor", "aTexCoord" });
+
+        if (!variant.shader.loadFromMemory(vertexShader.c_str(), fragmentShader.c_str()))
+        {
+            sf::err() << "Failed to create the YUV conversion pipeline" << std::endl;
+            m_yuvFailed = true;
+            return nullptr;
+        }
+
+        variant.id = variant.shader.getNativeHandle();
+
+        glCheck(variant.locViewProj = glGetUniformLocation(variant.id, "aViewProj"));
+        glCheck(variant.locTexScale = glGetUniformLocation(variant.id, "vTexScale"));
+        glCheck(m_locYuvMatrix[layout] = glGetUniformLocation(variant.id, "YuvMatrix"));
+        glCheck(m_locYuvOffset[layout] = glGetUniformLocation(variant.id, "YuvOffset"));
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+        cache.useProgram(variant.id);
+
+        // each plane is bound to the texture unit of its index
+        glCheck(glUniform1i(glGetUniformLocation(variant.id, "PlaneY"), 0));
+        glCheck(glUniform1i(glGetUniformLocation(variant.id, "PlaneU"), 1));
+        glCheck(glUniform1i(glGetUniformLocation(variant.id, "PlaneV"), 2));
+        glCheck(glUniform2f(variant.locTexScale, variant.texScale.x, variant.texScale.y));
+
+        return &variant;
+    };
+
+
+    void SfmlRenderPipeline::drawYuvVertices(const sf::Vertex*       vertices,
+                                             sf::PrimitiveType       type,
+                                             std::size_t             vertexCount,
+                                             const sf::YuvTexture&   texture,
+                                             const sf::Shader*       shader)
+    {
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+
+        if (shader)
+        {
+            updateFrameBlock();
+            shader->bind(shader);
+        }
+        else
+        {
+            PipelineVariant* variant = getYuvVariant(texture.getLayout());
+            if (!variant)
+                return;
+
+            cache.useProgram(variant->id);
+            uploadViewProj(variant->locViewProj);
+
+            // texture coordinates are in pixels of the luma plane
+            sf::Vector2f texScale(1.f / static_cast<float>(texture.getSize().x), 1.f / static_cast<float>(texture.getSize().y));
+            if (texScale != variant->texScale)
+            {
+                variant->texScale = texScale;
+                glUniform2f(variant->locTexScale, texScale.x, texScale.y);
+            };
+
+            float matrix[9];
+            float offset[3];
+            sf::priv::getYuvConversion(texture, matrix, offset);
+            glUniformMatrix3fv(m_locYuvMatrix[texture.getLayout()], 1, GL_FALSE, matrix);
+            glUniform3fv(m_locYuvOffset[texture.getLayout()], 1, offset);
+        }
+
+        // the planes have their own sampling parameters
+        for (unsigned int plane = 0; plane < texture.getPlaneCount(); ++plane)
+        {
+            cache.bindTexture(plane, texture.getNativeHandle(plane));
+            cache.bindSampler(plane, 0);
+        }
+
+        cache.bindVertexArray(m_vao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+        if (vertexCount <= MAX_VERTEX)
+        {
+            std::size_t offset = streamVertices(vertices, vertexCount, (type == sf::Quads) ? 4 : 1);
+            drawPrimitives(type, offset, vertexCount);
+        }
+        else
+        {
+            drawChunks(vertices, type, vertexCount);
+        }
+
+        // the other draws expect the first unit to be active
+        cache.activeTexture(0);
+
+        if (shader)
+            shader->bind(nullptr);
+    };
+
+
+    PipelineVariant* SfmlRenderPipeline::getOutlineVariant(const sf::Texture& texture)
+    {
+        unsigned int key = (texture.isDistanceField() ? 1 : 0) | (texture.isSingleChannel() ? 2 : 0);
+
+        PipelineVariant& variant = m_outlineVariants[key];
+        if (variant.id)
+            return &variant;
+
+        if (m_outlineFailed)
+            return nullptr;
+
+        // same as the textured built-in shader, without flipping
+        const char* vertexShaderSource =
+            "precision mediump float;                               \n"
+            "uniform mat4 aViewProj;                                \n"
+            "uniform highp vec2 vTexScale;                          \n"
+            "attribute vec2 aPos;                                   \n"
+            "attribute vec4 aColor;                                 \n"
+            "attribute highp vec2 aTexCoord;                        \n"
+            "varying vec4 oColor;                                   \n"
+            "varying vec2 oTexCoord;                                \n"
+            "void main()                                            \n"
+            "{                                                      \n"
+            "   oColor = aColor;                                    \n"
+            "   oTexCoord = aTexCoord * vTexScale;                  \n"
+            "   gl_Position = aViewProj * vec4(aPos.xy, 0.0, 1.0);  \n"
+            "}\n";
+
+        // the outline of a distance field is a second threshold, closer to
+        // the outside; the outline of coverage is the coverage dilated by
+        // the outline radius, sampled on two rings around the fragment.
+        // The fill is composited over the outline, like the stroked glyphs
+        // drawn under the fill glyphs
+        const char* fragmentShaderSource =
+            "#if defined(DISTANCE_FIELD) && defined(GL_OES_standard_derivatives) \n"
+            "#extension GL_OES_standard_derivatives : enable                \n"
+            "#endif                                                         \n"
+            "precision mediump float;                                       \n"
+            "uniform sampler2D Texture0;                                    \n"
+            "uniform vec4 OutlineColor;                                     \n"
+            "uniform vec2 OutlineWidth;                                     \n"
+            "varying vec4 oColor;                                           \n"
+            "varying vec2 oTexCoord;                                        \n"
+            "float coverage(vec2 coords)                                    \n"
+            "{                                                              \n"
+            "#ifdef SINGLE_CHANNEL                                          \n"
+            "   return texture2D(Texture0, coords).r;                       \n"
+            "#else                                                          \n"
+            "   return texture2D(Texture0, coords).a;                       \n"
+            "#endif                                                         \n"
+            "}                                                              \n"
+            "void main()                                                    \n"
+            "{                                                              \n"
+            "   float fill = coverage(oTexCoord);                           \n"
+            "#ifdef DISTANCE_FIELD                                          \n"
+            "#ifdef GL_OES_standard_derivatives                             \n"
+            "   float width = 0.7 * fwidth(fill);                           \n"
+            "#else                                                          \n"
+            "   float width = 0.1;                                          \n"
+            "#endif                                                         \n"
+            "   float edge = 0.5 - OutlineWidth.x;                          \n"
+            "   float outline = smoothstep(edge - width, edge + width, fill); \n"
+            "   fill = smoothstep(0.5 - width, 0.5 + width, fill);          \n"
+            "#else                                                          \n"
+            "   float outline = fill;                                       \n"
+            "   for (int i = 0; i < 16; ++i)                                \n"
+            "   {                                                           \n"
+            "       float angle = float(i) * 0.3926991;                     \n"
+            "       vec2 offset = vec2(cos(angle), sin(angle)) * OutlineWidth; \n"
+            "       outline = max(outline, coverage(oTexCoord + offset));   \n"
+            "       outline = max(outline, coverage(oTexCoord + offset * 0.5)); \n"
+            "   }                                                           \n"
+            "#endif                                                         \n"
+            "   float fillAlpha = fill * oColor.a;                          \n"
+            "   float outlineAlpha = outline * OutlineColor.a * (1.0 - fillAlpha); \n"
+            "   float alpha = fillAlpha + outlineAlpha;                     \n"
+            "   vec3 rgb = (oColor.rgb * fillAlpha + OutlineColor.rgb * outlineAlpha) / max(alpha, 0.0001); \n"
+            "   gl_FragColor = vec4(rgb, alpha);                            \n"
+            "}\n";
+
+        std::string header = "#version 100\n";
+        if (key & 1)
+            header += "#define DISTANCE_FIELD\n";
+        if (key & 2)
+            header += "#define SINGLE_CHANNEL\n";
+
+        const std::string vertexShader = header + vertexShaderSource;
+        const std::string fragmentShader = header + fragmentShaderSource;
+
+        // order should match to sf::Vertex
+        variant.shader.setAttributes({ "aPos", "aColor", "aTexCoord" });
+
+        if (!variant.shader.loadFromMemory(vertexShader.c_str(), fragmentShader.c_str()))
+        {
+            sf::err() << "Failed to create the text outline pipeline, shader outlines are not drawn" << std::endl;
+            m_outlineFailed = true;
+            return nullptr;
+        }
+
+        variant.id = variant.shader.getNativeHandle();
+
+        glCheck(variant.locViewProj = glGetUniformLocation(variant.id, "aViewProj"));
+        glCheck(variant.locTexScale = glGetUniformLocation(variant.id, "vTexScale"));
+        glCheck(m_locOutlineColor[key] = glGetUniformLocation(variant.id, "OutlineColor"));
+        glCheck(m_locOutlineWidth[key] = glGetUniformLocation(variant.id, "OutlineWidth"));
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+        cache.useProgram(variant.id);
+
+        glCheck(glUniform1i(glGetUniformLocation(variant.id, "Texture0"), 0));
+        glCheck(glUniform2f(variant.locTexScale, variant.texScale.x, variant.texScale.y));
+
+        return &variant;
+    };
+
+
+    bool SfmlRenderPipeline::drawOutlinedGlyphs(const sf::Vertex*  vertices,
+                                                std::size_t        vertexCount,
+                                                const sf::Texture& texture,
+                                                const sf::Color&   outlineColor,
+                                                float              outlineWidth)
+    {
+        // the overdraw heatmap replaces all the shaders
+        if (m_overdraw)
+            return false;
+
+        unsigned int key = (texture.isDistanceField() ? 1 : 0) | (texture.isSingleChannel() ? 2 : 0);
+        PipelineVariant* variant = getOutlineVariant(texture);
+        if (!variant)
+            return false;
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+
+        sf::priv::markTextureUsed(texture);
+        sf::priv::resolveTexture(texture);
+
+        cache.useProgram(variant->id);
+        sf::priv::bindSampledTexture(0, texture);
+        uploadViewProj(variant->locViewProj);
+
+        // font pages are drawn with texture coordinates in pixels
+        sf::Vector2f texScale = texCoordScale(texture);
+        if (texScale != variant->texScale)
+        {
+            variant->texScale = texScale;
+            glUniform2f(variant->locTexScale, texScale.x, texScale.y);
+        };
+
+        // a distance for distance fields, a radius in normalized coordinates for coverage
+        if (texture.isDistanceField())
+            glUniform2f(m_locOutlineWidth[key], outlineWidth, outlineWidth);
+        else
+            glUniform2f(m_locOutlineWidth[key], outlineWidth * texScale.x, outlineWidth * texScale.y);
+
+        glUniform4f(m_locOutlineColor[key], outlineColor.r / 255.f, outlineColor.g / 255.f, outlineColor.b / 255.f, outlineColor.a / 255.f);
+
+        cache.bindVertexArray(m_vao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+        if (vertexCount <= MAX_VERTEX)
+        {
+            std::size_t offset = streamVertices(vertices, vertexCount);
+            drawPrimitives(sf::Triangles, offset, vertexCount);
+        }
+        else
+        {
+            drawChunks(vertices, sf::Triangles, vertexCount);
+        }
+
+        postDraw(&texture, nullptr);
+
+        return true;
+    };
+
+
+    void SfmlRenderPipeline::drawQuadInstances(unsigned int       instanceBuffer,
+                                               std::size_t        instanceCount,
+                                               const sf::Texture* texture,
+                                               const sf::Shader*  shader)
+    {
+        if (!m_instanceVao && !createInstancing())
+        {
+            sf::err() << "Failed to create the instanced quad pipeline" << std::endl;
+            return;
+        }
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+
+        if (shader)
+        {
+            updateFrameBlock();
+            shader->bind(shader);
+        }
+        else
+        {
+            cache.useProgram(m_instanceShaderId);
+
+            if (texture)
+            {
+                sf::priv::resolveTexture(*texture);
+                sf::priv::bindSampledTexture(0, *texture);
+            };
+
+            glUniform1i(m_locInstanceTexFlipped, static_cast<int>(texture && texture->isFlipped()));
+            glUniform1i(m_locInstanceUseTexture, static_cast<int>(texture != nullptr));
+            glUniform1i(m_locInstanceSingleChannel, static_cast<int>(texture && texture->isSingleChannel()));
+            uploadViewProj(m_locInstanceViewProj);
+        }
+
+        cache.bindVertexArray(m_instanceVao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+
+        const GLsizei stride = sizeof(sf::priv::QuadInstance);
+        glCheck(glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(sf::priv::QuadInstance, color)));
+        glCheck(glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(sf::priv::QuadInstance, texRect)));
+        glCheck(glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(sf::priv::QuadInstance, row0)));
+        glCheck(glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(sf::priv::QuadInstance, row1)));
+
+        glCheck(sf::priv::drawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0, static_cast<GLsizei>(instanceCount)));
+
+        sf::RenderStats& stats = sf::priv::getRenderStats();
+        ++stats.drawCalls;
+        stats.vertices += instanceCount * 4;
+
+        postDraw(texture, shader);
+    };
+
+
+    bool SfmlRenderPipeline::batchVertices(const sf::Vertex*    vertices,
+                                           std::size_t          vertexCount,
+                                           sf::PrimitiveType    type,
+                                           const sf::Transform& transform,
+                                           const sf::Texture*   texture)
+    {
+        // Strips and fans can't be concatenated, so they are
+        // unrolled to independent lines, triangles and quads
+        sf::PrimitiveType batchType = type;
+        std::size_t batchCount = 0;
+
+        switch (type)
+        {
+            case sf::Points:
+                batchCount = vertexCount;
+                break;
+
+            case sf::Lines:
+                batchCount = vertexCount - vertexCount % 2;
+                break;
+
+            case sf::LineStrip:
+                batchType = sf::Lines;
+                batchCount = (vertexCount >= 2) ? (vertexCount - 1) * 2 : 0;
+                break;
+
+            case sf::Triangles:
+                batchCount = vertexCount - vertexCount % 3;
+                break;
+
+            case sf::TriangleStrip:
+                // A 4-vertex strip (sprites) is a quad, drawn with the shared quad indices
+                batchType = (vertexCount == 4) ? sf::Quads : sf::Triangles;
+                batchCount = (vertexCount == 4) ? 4 : ((vertexCount >= 3) ? (vertexCount - 2) * 3 : 0);
+                break;
+
+            case sf::TriangleFan:
+                batchType = sf::Triangles;
+                batchCount = (vertexCount >= 3) ? (vertexCount - 2) * 3 : 0;
+                break;
+
+            case sf::Quads:
+                batchCount = vertexCount - vertexCount % 4;
+                break;
+        }
+
+        if (batchCount > MAX_BATCH_DRAW_VERTEX)
+            return false;
+
+        // Small textures are drawn from their copy in a shared page, so that they
+        // batch together; updating the copy flushes the draws that use the page
+        sf::Vector2f atlasOffset;
+        const sf::Texture* atlasPage = getAtlasPage(texture, vertices, vertexCount, atlasOffset);
+        if (atlasPage)
+            texture = atlasPage;
+
+        // Break the batch if the states differ or if it is full; another
+        // texture only breaks it when no texture slot is left
+        sf::Uint8 slot = 0;
+        if (!m_batchVertices.empty())
+        {
+            if ((m_batchTexture != texture) && !findTextureSlot(texture, slot))
+                flush(sf::RenderStats::FlushTexture);
+            else if (m_batchType != batchType)
+                flush(sf::RenderStats::FlushPrimitive);
+            else if (m_batchVertices.size() + batchCount > MAX_VERTEX)
+                flush(sf::RenderStats::FlushFull);
+        }
+
+        if (m_batchVertices.capacity() < MAX_VERTEX)
+            m_batchVertices.reserve(MAX_VERTEX);
+
+        if (m_batchVertices.empty())
+        {
+            m_batchTexture = texture;
+            m_batchTextures[0] = texture;
+            m_batchTextureCount = 1;
+            slot = 0;
+        }
+
+        m_batchType = batchType;
+
+        std::size_t offset = m_batchVertices.size();
+        m_batchVertices.resize(offset + batchCount);
+
+        if (m_textureSlots > 1)
+            m_batchSlots.resize(offset + batchCount, slot);
+
+        // Pre-transform the vertices, the batch is drawn with an identity model-view matrix
+        sf::Vertex* out = m_batchVertices.data() + offset;
+        auto emit = [&](std::size_t index)
+        {
+            out->position  = transform.transformPoint(vertices[index].position);
+            out->color     = vertices[index].color;
+            out->texCoords = vertices[index].texCoords;
+            ++out;
+        };
+
+        switch (type)
+        {
+            case sf::Points:
+            case sf::Lines:
+            case sf::Triangles:
+            case sf::Quads:
+                transform.transformPoints(vertices, out, batchCount);
+                break;
+
+            case sf::LineStrip:
+                for (std::size_t i = 1; i < vertexCount; ++i)
+                {
+                    emit(i - 1);
+                    emit(i);
+                }
+                break;
+
+            case sf::TriangleStrip:
+                if (batchType == sf::Quads)
+                {
+                    // The quad indices split the quad on its (0, 2) diagonal, and the
+                    // strip on its (1, 2) one: the order (1, 3, 2, 0) gives the triangles
+                    // (1, 3, 2) and (1, 2, 0), the same as the strip with the same winding,
+                    // so the interpolation and the covered area don't change
+                    emit(1);
+                    emit(3);
+                    emit(2);
+                    emit(0);
+                    break;
+                }
+
+                for (std::size_t i = 2; i < vertexCount; ++i)
+                {
+                    // Keep the winding of every other triangle consistent
+                    emit((i % 2) ? i - 1 : i - 2);
+                    emit((i % 2) ? i - 2 : i - 1);
+                    emit(i);
+                }
+                break;
+
+            case sf::TriangleFan:
+                for (std::size_t i = 2; i < vertexCount; ++i)
+                {
+                    emit(0);
+                    emit(i - 1);
+                    emit(i);
+                }
+                break;
+
+        }
+
+        if (atlasPage)
+        {
+            for (sf::Vertex* vertex = m_batchVertices.data() + offset; vertex != m_batchVertices.data() + m_batchVertices.size(); ++vertex)
+                vertex->texCoords += atlasOffset;
+        }
+
+        return true;
+    };
+
+
+    bool SfmlRenderPipeline::findTextureSlot(const sf::Texture* texture, sf::Uint8& slot)
+    {
+        // Single channel and distance field textures need their own variant of the shader
+        if (!texture || !m_batchTexture || (m_textureSlots < 2))
+            return false;
+
+        if (texture->isSingleChannel() || texture->isDistanceField() ||
+            m_batchTexture->isSingleChannel() || m_batchTexture->isDistanceField())
+            return false;
+
+        for (unsigned int i = 0; i < m_batchTextureCount; ++i)
+        {
+            if (m_batchTextures[i] == texture)
+            {
+                slot = static_cast<sf::Uint8>(i);
+                return true;
+            }
+        }
+
+        if ((m_batchTextureCount == m_textureSlots) || ((m_batchTextureCount == 1) && !isMultiTextureReady()))
+            return false;
+
+        slot = static_cast<sf::Uint8>(m_batchTextureCount);
+        m_batchTextures[m_batchTextureCount++] = texture;
+
+        return true;
+    };
+
+
+    bool SfmlRenderPipeline::isMultiTextureReady()
+    {
+        // Until the multi-texture variant is linked, batches are broken at each texture
+        // change rather than waiting for it; drivers without KHR_parallel_shader_compile
+        // can't tell, so the first mix of textures waits
+        PipelineVariant& variant = m_variants[VariantTextured | VariantMultiTexture];
+        if (variant.id)
+            return true;
+
+        if (variant.pending && !variant.shader.isReady())
+            return false;
+
+        return finishVariant(VariantTextured | VariantMultiTexture).id != 0;
+    };
+
+
+    void SfmlRenderPipeline::drawBatch()
+    {
+        preDraw(m_batchTexture, nullptr);
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+        cache.bindVertexArray(m_vao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+        bool        reused = false;
+        std::size_t offset = streamBatch(reused);
+        drawPrimitives(m_batchType, offset, m_batchVertices.size());
+
+        postDraw(m_batchTexture, nullptr);
+    };
+
+
+    void SfmlRenderPipeline::drawMultiTextureBatch()
+    {
+        // The textures differ in size and orientation, so their texture
+        // coordinates are resolved here and the shader only picks the sampler
+        sf::Vector2f scales[MAX_BATCH_TEXTURES];
+        bool         flipped[MAX_BATCH_TEXTURES];
+        for (unsigned int i = 0; i < m_batchTextureCount; ++i)
+        {
+            scales[i] = texCoordScale(*m_batchTextures[i]);
+            flipped[i] = m_batchTextures[i]->isFlipped();
+        }
+
+        for (std::size_t i = 0; i < m_batchVertices.size(); ++i)
+        {
+            sf::Uint8     slot = m_batchSlots[i];
+            sf::Vector2f& texCoords = m_batchVertices[i].texCoords;
+
+            texCoords.x *= scales[slot].x;
+            texCoords.y *= scales[slot].y;
+            if (flipped[slot])
+                texCoords.y = 1.f - texCoords.y;
+        }
+
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+
+        for (unsigned int i = 0; i < m_batchTextureCount; ++i)
+        {
+            sf::priv::markTextureUsed(*m_batchTextures[i]);
+            sf::priv::resolveTexture(*m_batchTextures[i]);
+            sf::priv::bindSampledTexture(i, *m_batchTextures[i]);
+        }
+
+        cache.activeTexture(0);
+
+        PipelineVariant& variant = getVariant(m_overdraw ? VariantOverdraw : VariantTextured | VariantMultiTexture);
+        cache.useProgram(variant.id);
+
+        if ((variant.uploadedViewGeneration != m_viewGeneration) || (variant.uploadedModelView != m_matModelView))
+        {
+            uploadViewProj(variant.locViewProj);
+
+            variant.uploadedViewGeneration = m_viewGeneration;
+            variant.uploadedModelView = m_matModelView;
+        };
+
+        cache.bindVertexArray(m_vao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+        std::size_t count = m_batchVertices.size();
+        bool        reused = false;
+        std::size_t offset = streamBatch(reused);
+
+        // The slots land at the same index as their vertices (a reused batch
+        // finds its slots where they were written with it)
+        if (!reused)
+        {
+            cache.bindBuffer(GL_ARRAY_BUFFER, m_slotVbo);
+            glCheck(glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(count), m_batchSlots.data()));
+            sf::priv::getRenderStats().bytesUploaded += count;
+        }
+
+        drawPrimitives(m_batchType, offset, count);
+
+        for (unsigned int i = 0; i < m_batchTextureCount; ++i)
+            postDraw(m_batchTextures[i], nullptr);
+    };
+
+
+    void SfmlRenderPipeline::flush(sf::RenderStats::FlushReason reason)
+    {
+        if (m_batchVertices.empty())
+            return;
+
+        sf::RenderStats& stats = sf::priv::getRenderStats();
+        ++stats.batchesFlushed;
+        ++stats.flushReasons[reason];
+
+        sf::GpuProfiler::Scope scope("batch flush");
+
+        // Batched vertices are already in world coordinates
+        sf::Transform modelView = m_matModelView;
+        m_matModelView = sf::Transform::Identity;
+
+        if (m_batchTextureCount > 1)
+            drawMultiTextureBatch();
+        else
+            drawBatch();
+
+        m_matModelView = modelView;
+        m_batchVertices.clear();
+        m_batchSlots.clear();
+        m_batchTexture = nullptr;
+        m_batchTextureCount = 0;
+    };
+
+
+    void SfmlRenderPipeline::flush(const sf::Texture* texture)
+    {
+        if (m_batchVertices.empty())
+            return;
+
+        for (unsigned int i = 0; i < m_batchTextureCount; ++i)
+        {
+            if (m_batchTextures[i] == texture)
+            {
+                flush(sf::RenderStats::FlushResource);
+                return;
+            }
+        }
+    };
+
+
+    void SfmlRenderPipeline::setOverdraw(bool overdraw)
+    {
+        // the pending batch was recorded for the other shader
+        if (overdraw != m_overdraw)
+        {
+            flush(sf::RenderStats::FlushExplicit);
+            m_overdraw = overdraw;
+        }
+    };
+
+
+    void SfmlRenderPipeline::setAlphaMask(bool alphaMask)
+    {
+        if (alphaMask != m_alphaMask)
+        {
+            flush(sf::RenderStats::FlushClip);
+            m_alphaMask = alphaMask;
+        }
+    };
+
+
+    // number of render targets alive, changed under contextMutex only
+    int pipelineRefCount = 0;
+
+    
+    // pipeline of the current context, created when first needed
+    inline SfmlRenderPipeline* getPipeline()
+    {
+        ContextState& state = contextState();
+        if (!state.pipeline)
+        {
+            sf::Clock creationClock;
+            state.pipeline = new SfmlRenderPipeline;
+
+            sf::StartupStats& startup = sf::priv::getStartupStats();
+            if (startup.pipelineTime == sf::Time::Zero)
+                startup.pipelineTime = creationClock.getElapsedTime();
+        }
+
+        return state.pipeline;
+    };
+
+    
+    // counts a new render target, and creates the pipeline of the current context if not exist
+    inline void pipelineCreate()
+    {
+        {
+            sf::Lock lock(contextMutex);
+            ++pipelineRefCount;
+        };
+
+        getPipeline();
+    };
+
+
+    // destroys the sfml render pipeline of the current context if refs end; the pipelines
+    // of the other contexts can only be destroyed with their context, see releaseContext
+    inline void pipelineDestroy()
+    {
+        ContextState& state = contextState();
+
+        sf::Lock lock(contextMutex);
+
+        assert(pipelineRefCount > 0);
+        if ((--pipelineRefCount == 0) && state.pipeline)
+        {
+            delete state.pipeline;
+            state.pipeline = nullptr;
+        };
+    };
+
+
+    // Sort key of a deferred draw: layer, then blend mode, texture and view
+    inline sf::Uint64 deferredSortKey(sf::Uint8 layer, std::size_t blendMode, sf::Uint64 textureId, std::size_t view)
+    {
+        return (static_cast<sf::Uint64>(layer) << 56) |
+               (static_cast<sf::Uint64>(blendMode & 0xFF) << 48) |
+               ((textureId & 0xFFFFFFFF) << 16) |
+               (static_cast<sf::Uint64>(view & 0xFFFF));
+    }
+
+
+    // Does the blend mode write the source color unchanged when its alpha is 1?
+    inline bool isReplaceWhenOpaque(const sf::BlendMode& mode)
+    {
+        return ((mode.colorSrcFactor == sf::BlendMode::One)  || (mode.colorSrcFactor == sf::BlendMode::SrcAlpha)) &&
+               ((mode.colorDstFactor == sf::BlendMode::Zero) || (mode.colorDstFactor == sf::BlendMode::OneMinusSrcAlpha)) &&
+               ((mode.alphaSrcFactor == sf::BlendMode::One)  || (mode.alphaSrcFactor == sf::BlendMode::SrcAlpha)) &&
+               ((mode.alphaDstFactor == sf::BlendMode::Zero) || (mode.alphaDstFactor == sf::BlendMode::OneMinusSrcAlpha)) &&
+               (mode.colorEquation == sf::BlendMode::Add) && (mode.alphaEquation == sf::BlendMode::Add);
+    }
+
+
+    // Can the draw be replayed without blending, in the depth pre-pass?
+    bool isOpaqueDraw(const sf::Vertex* vertices, std::size_t vertexCount, const sf::RenderStates& states)
+    {
+        if (!isReplaceWhenOpaque(states.blendMode))
+            return false;
+
+        if (states.texture && (!states.texture->isOpaque() || states.texture->isSingleChannel() || states.texture->isDistanceField()))
+            return false;
+
+        for (std::size_t i = 0; i < vertexCount; ++i)
+        {
+            if (vertices[i].color.a != 255)
+                return false;
+        }
+
+        return true;
+    }
+
+
+    // glDepthRange takes doubles on desktop OpenGL, OpenGL ES only has the float version
+    inline void setDepthRange(float nearValue, float farValue)
+    {
+#if defined(SFML_OPENGL_ES)
+        glCheck(glDepthRangef(nearValue, farValue));
+#else
+        glCheck(glDepthRange(nearValue, farValue));
+#endif
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void flushPendingDraws(const Texture* texture)
+{
+    if (!contextState().pipeline)
+        return;
+
+    // Deferred draws of the active target may use the texture too
+    if (contextState().deferredTarget)
+    {
+        contextState().deferredTarget->flush();
+        return;
+    }
+
+    if (texture)
+        getPipeline()->flush(texture);
+    else
+        getPipeline()->flush(RenderStats::FlushResource);
+}
+
+
+////////////////////////////////////////////////////////////
+RenderStats& getRenderStats()
+{
+    static RenderStats stats;
+    return stats;
+}
+
+
+////////////////////////////////////////////////////////////
+void forgetRenderPipelines()
+{
+    std::vector<ContextState*> states;
+    {
+        Lock lock(contextMutex);
+        for (std::map<void*, ContextState*>::iterator it = contextStates.begin(); it != contextStates.end(); ++it)
+            states.push_back(it->second);
+    }
+
+    // The pending draws refer to objects of the lost context, they are dropped with the pipelines
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+        delete states[i]->pipeline;
+        states[i]->pipeline = nullptr;
+        states[i]->deferredTarget = nullptr;
+    }
+
+    Lock lock(contextMutex);
+
+    for (std::map<void*, ContextState*>::iterator it = contextStates.begin(); it != contextStates.end(); ++it)
+        delete it->second;
+    contextStates.clear();
+
+    contextGeneration.fetch_add(1, std::memory_order_release);
+}
+
+} // namespace priv
+
+} // namespace sf
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderTarget::RenderTarget() :
+m_defaultView(),
+m_view(),
+m_cache(),
+m_id(0),
+m_batching(false),
+m_culling(false),
+m_cullAreaValid(false),
+m_cullArea(),
+m_deferred(false),
+m_queue(),
+m_depthPrePass(false),
+m_overdraw(false),
+m_storeAction(StoreColor),
+m_dirtyTracking(false),
+m_dirtyArea(),
+m_scissor(),
+m_clipStack(),
+m_clipDepth(0),
+m_budgetStack(),
+m_budgetCallback(),
+m_stencilMode(StencilTest),
+m_capture(NULL),
+m_viewMappings(),
+m_nextViewMapping(0)
+{
+    sf::priv::ensureExtensionsInit();
+    m_cache.enable = false;
+    m_cache.glStatesSet = false;
+    m_cache.scissorChanged = true;
+    m_queue.viewChanged = true;
+    m_queue.layer = 0;
+    pipelineCreate();
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTarget::~RenderTarget()
+{
+    // The deferred draws can't be replayed anymore, the derived target is already destroyed
+    if (contextState().deferredTarget == this)
+        contextState().deferredTarget = nullptr;
+
+    if (isActive(m_id))
+        getPipeline()->flush(RenderStats::FlushResource);
+
+    pipelineDestroy();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::clear(const Color& color)
+{
+    if (isActive(m_id) || setActive(true))
+    {
+        contextState().lastActiveId = m_id;
+
+        if (m_capture)
+            m_capture->recordClear(*this, color);
+
+        // Pending draws must not end up on top of the cleared target
+        replayDeferred();
+        getPipeline()->flush(RenderStats::FlushClear);
+
+        // Only the scissor rectangle is cleared
+        if (!m_cache.enable || m_cache.scissorChanged)
+            applyScissor();
+
+        // The overdraw heatmap counts from black
+        if (m_overdraw)
+            glCheck(glClearColor(0.f, 0.f, 0.f, 1.f));
+        else
+            glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
+        glCheck(glClear(m_depthPrePass ? (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT) : GL_COLOR_BUFFER_BIT));
+        markDirty();
+
+        // A clear starts a new frame of the target, for the sf_Frame block
+        getPipeline()->beginFrame();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::beginPass(LoadAction load, StoreAction store, const Color& clearColor)
+{
+    m_storeAction = store;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        contextState().lastActiveId = m_id;
+
+        // Pending draws belong to the previous pass
+        replayDeferred();
+        getPipeline()->flush(RenderStats::FlushClear);
+
+        if (!m_cache.enable || m_cache.scissorChanged)
+            applyScissor();
+
+        // Invalidation ignores the scissor test, the pixels outside must survive
+        if ((load == DiscardContents) && (m_scissor.width > 0) && (m_scissor.height > 0))
+            load = LoadContents;
+
+        if (load == ClearContents)
+        {
+            if (m_capture)
+                m_capture->recordClear(*this, clearColor);
+
+            // Clearing every buffer lets tiled GPUs skip loading all of them
+            glCheck(glClearColor(clearColor.r / 255.f, clearColor.g / 255.f, clearColor.b / 255.f, clearColor.a / 255.f));
+            glCheck(glClearStencil(0));
+            glCheck(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT));
+        }
+        else if (load == DiscardContents)
+        {
+            priv::discardFramebuffer(true, true);
+        }
+
+        if (load != LoadContents)
+        {
+            markDirty();
+            getPipeline()->beginFrame();
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::endPass()
+{
+    if (isActive(m_id) || setActive(true))
+    {
+        replayDeferred();
+        getPipeline()->flush();
+
+        if (m_storeAction == StoreColor)
+            priv::discardFramebuffer(false, true);
+    }
+
+    if (m_capture)
+        m_capture->recordFrame();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setView(const View& view)
+{
+    m_view = view;
+    m_cache.viewChanged = true;
+    m_queue.viewChanged = true;
+    m_cullAreaValid = false;
+}
+
+
+////////////////////////////////////////////////////////////
+const View& RenderTarget::getView() const
+{
+    return m_view;
+}
+
+
+////////////////////////////////////////////////////////////
+const View& RenderTarget::getDefaultView() const
+{
+    return m_defaultView;
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect RenderTarget::getViewport(const View& view) const
+{
+    return getViewMapping(view).viewport;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setScissor(const IntRect& area)
+{
+    // Pending deferred draws were issued with the previous scissor
+    if (!m_queue.draws.empty() && (isActive(m_id) || setActive(true)))
+        replayDeferred();
+
+    m_scissor = area;
+    m_cache.scissorChanged = true;
+    m_cullAreaValid = false;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& RenderTarget::getScissor() const
+{
+    return m_scissor;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::pushClipRect(const FloatRect& rectangle)
+{
+    ClipEntry entry;
+    entry.scissor = m_scissor;
+    entry.mask    = false;
+    m_clipStack.push_back(entry);
+
+    // Pixel bounds of the mapped corners
+    Vector2i corners[4] =
+    {
+        mapCoordsToPixel(Vector2f(rectangle.left, rectangle.top)),
+        mapCoordsToPixel(Vector2f(rectangle.left + rectangle.width, rectangle.top)),
+        mapCoordsToPixel(Vector2f(rectangle.left, rectangle.top + rectangle.height)),
+        mapCoordsToPixel(Vector2f(rectangle.left + rectangle.width, rectangle.top + rectangle.height))
+    };
+
+    Vector2i minimum = corners[0];
+    Vector2i maximum = corners[0];
+    for (int i = 1; i < 4; ++i)
+    {
+        minimum.x = std::min(minimum.x, corners[i].x);
+        minimum.y = std::min(minimum.y, corners[i].y);
+        maximum.x = std::max(maximum.x, corners[i].x);
+        maximum.y = std::max(maximum.y, corners[i].y);
+    }
+
+    IntRect area(minimum.x, minimum.y, maximum.x - minimum.x, maximum.y - minimum.y);
+
+    // An empty scissor rectangle disables the test, a clip that leaves
+    // nothing visible is a pixel just above the target instead
+    if (!area.intersects(getDrawableArea(), area) || (area.width <= 0) || (area.height <= 0))
+        area = IntRect(0, -1, 1, 1);
+
+    setScissor(area);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::pushClipMask(const Drawable& mask, const RenderStates& states)
+{
+    ClipEntry entry;
+    entry.scissor = m_scissor;
+    entry.mask    = true;
+
+    if (m_clipDepth >= 255)
+    {
+        err() << "Failed to push a clip mask, too many masks are nested" << std::endl;
+        entry.mask = false;
+        m_clipStack.push_back(entry);
+        return;
+    }
+
+    m_clipStack.push_back(entry);
+
+    if (!isActive(m_id) && !setActive(true))
+        return;
+
+    // The draws issued so far are clipped by the enclosing masks only
+    replayDeferred();
+    if (!m_cache.glStatesSet)
+        resetGLStates();
+
+    // Draw the mask right away and unbatched, with the alpha test of the mask
+    // shader variant, incrementing the stencil where the enclosing masks pass
+    getPipeline()->flush(RenderStats::FlushClip);
+    getPipeline()->setAlphaMask(true);
+    m_stencilMode = StencilIncrement;
+    applyStencil();
+
+    bool batching = m_batching;
+    bool deferred = m_deferred;
+    m_batching = false;
+    m_deferred = false;
+
+    draw(mask, states);
+
+    m_batching = batching;
+    m_deferred = deferred;
+
+    getPipeline()->setAlphaMask(false);
+    ++m_clipDepth;
+    m_stencilMode = StencilTest;
+    applyStencil();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::popClip()
+{
+    if (m_clipStack.empty())
+    {
+        err() << "Failed to pop a clip, no clip was pushed" << std::endl;
+        return;
+    }
+
+    ClipEntry entry = m_clipStack.back();
+    m_clipStack.pop_back();
+
+    if (!entry.mask)
+    {
+        setScissor(entry.scissor);
+        return;
+    }
+
+    --m_clipDepth;
+
+    if (!isActive(m_id) && !setActive(true))
+        return;
+
+    // The draws clipped by the mask must be rendered before it's removed
+    replayDeferred();
+    getPipeline()->flush(RenderStats::FlushClip);
+
+    if (!m_cache.enable || m_cache.scissorChanged)
+        applyScissor();
+
+    // The pixels of the mask are lowered back to the depth of the enclosing
+    // masks; clips are nested, so the mask was drawn within the current scissor
+    if (m_clipDepth == 0)
+    {
+        glCheck(glClearStencil(0));
+        glCheck(glClear(GL_STENCIL_BUFFER_BIT));
+    }
+    else
+    {
+        m_stencilMode = StencilClamp;
+        applyStencil();
+
+        Vector2f size(static_cast<float>(getSize().x), static_cast<float>(getSize().y));
+        Vertex quad[4] =
+        {
+            Vertex(Vector2f(0.f, 0.f)),
+            Vertex(Vector2f(0.f, size.y)),
+            Vertex(Vector2f(size.x, 0.f)),
+            Vertex(size)
+        };
+
+        View view = m_view;
+        bool batching = m_batching;
+        setView(View(FloatRect(0.f, 0.f, size.x, size.y)));
+        m_batching = false;
+
+        drawImmediate(quad, 4, TriangleStrip, RenderStates::Default);
+
+        m_batching = batching;
+        setView(view);
+
+        m_stencilMode = StencilTest;
+    }
+
+    applyStencil();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::pushBudgetScope(const std::string& name, const RenderBudget& budget, const char* file, unsigned int line)
+{
+    // The draws batched before the scope must not be counted in it
+    replayDeferred();
+    if (isActive(m_id))
+        getPipeline()->flush(RenderStats::FlushBudgetScope);
+
+    BudgetEntry entry;
+    entry.name   = name;
+    entry.budget = budget;
+    entry.start  = priv::getRenderStats();
+    entry.file   = file;
+    entry.line   = line;
+    m_budgetStack.push_back(entry);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::popBudgetScope()
+{
+    if (m_budgetStack.empty())
+    {
+        err() << "Failed to pop a budget scope, no scope was pushed" << std::endl;
+        return;
+    }
+
+    // The draws batched within the scope must be counted in it
+    replayDeferred();
+    if (isActive(m_id))
+        getPipeline()->flush(RenderStats::FlushBudgetScope);
+
+    BudgetEntry entry = m_budgetStack.back();
+    m_budgetStack.pop_back();
+
+    RenderStats usage = statsSince(priv::getRenderStats(), entry.start);
+    if (!entry.budget.isExceeded(usage))
+        return;
+
+    BudgetViolation violation;
+    violation.scope  = entry.name;
+    violation.budget = entry.budget;
+    violation.usage  = usage;
+    violation.file   = entry.file;
+    violation.line   = entry.line;
+
+    if (m_budgetCallback)
+    {
+        m_budgetCallback(violation);
+        return;
+    }
+
+    err() << "Render budget of scope \"" << violation.scope << "\" exceeded";
+    if (violation.file)
+        err() << " (" << violation.file << ":" << violation.line << ")";
+    err() << ": " << usage.drawCalls << " draw calls (budget " << entry.budget.drawCalls << "), "
+          << usage.bytesUploaded << " bytes uploaded (budget " << entry.budget.bytesUploaded << "), "
+          << usage.glyphCacheMisses << " glyph cache misses (budget " << entry.budget.glyphCacheMisses << ")" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setBudgetCallback(const BudgetCallback& callback)
+{
+    m_budgetCallback = callback;
+}
+
+
+
+////////////////////////////////////////////////////////////
+Vector2f RenderTarget::mapPixelToCoords(const Vector2i& point) const
+{
+    return mapPixelToCoords(point, getView());
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f RenderTarget::mapPixelToCoords(const Vector2i& point, const View& view) const
+{
+    return getViewMapping(view).pixelToCoords.transformPoint(static_cast<float>(point.x), static_cast<float>(point.y));
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2i RenderTarget::mapCoordsToPixel(const Vector2f& point) const
+{
+    return mapCoordsToPixel(point, getView());
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2i RenderTarget::mapCoordsToPixel(const Vector2f& point, const View& view) const
+{
+    Vector2f pixel = getViewMapping(view).coordsToPixel.transformPoint(point);
+
+    return Vector2i(static_cast<int>(pixel.x), static_cast<int>(pixel.y));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::mapPixelsToCoords(const Vector2i* points, Vector2f* coords, std::size_t count) const
+{
+    mapPixelsToCoords(points, coords, count, getView());
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::mapPixelsToCoords(const Vector2i* points, Vector2f* coords, std::size_t count, const View& view) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        coords[i] = Vector2f(static_cast<float>(points[i].x), static_cast<float>(points[i].y));
+
+    getViewMapping(view).pixelToCoords.transformPoints(coords, coords, count);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::mapCoordsToPixels(const Vector2f* points, Vector2i* pixels, std::size_t count) const
+{
+    mapCoordsToPixels(points, pixels, count, getView());
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::mapCoordsToPixels(const Vector2f* points, Vector2i* pixels, std::size_t count, const View& view) const
+{
+    const Transform& transform = getViewMapping(view).coordsToPixel;
+
+    // The float results go through a small buffer on the stack
+    Vector2f mapped[64];
+    for (std::size_t first = 0; first < count; first += 64)
+    {
+        std::size_t chunk = std::min<std::size_t>(count - first, 64);
+        transform.transformPoints(points + first, mapped, chunk);
+
+        for (std::size_t i = 0; i < chunk; ++i)
+            pixels[first + i] = Vector2i(static_cast<int>(mapped[i].x), static_cast<int>(mapped[i].y));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderTarget::ViewMapping& RenderTarget::getViewMapping(const View& view) const
+{
+    Vector2u size = getSize();
+
+    for (unsigned int i = 0; i < ViewMapping::CacheSize; ++i)
+    {
+        const ViewMapping& mapping = m_viewMappings[i];
+        if ((mapping.generation == view.m_generation) && (mapping.size == size))
+            return mapping;
+    }
+
+    ViewMapping& mapping = m_viewMappings[m_nextViewMapping];
+    m_nextViewMapping = (m_nextViewMapping + 1) % ViewMapping::CacheSize;
+
+    float width = static_cast<float>(size.x);
+    float height = static_cast<float>(size.y);
+    const FloatRect& viewport = view.getViewport();
+
+    mapping.generation = view.m_generation;
+    mapping.size       = size;
+    mapping.viewport   = IntRect(static_cast<int>(0.5f + width  * viewport.left),
+                                 static_cast<int>(0.5f + height * viewport.top),
+                                 static_cast<int>(0.5f + width  * viewport.width),
+                                 static_cast<int>(0.5f + height * viewport.height));
+
+    // Pixels to homogeneous coordinates, then by the inverse of the view matrix
+    float left = static_cast<float>(mapping.viewport.left);
+    float top = static_cast<float>(mapping.viewport.top);
+    float scaleX = 2.f / mapping.viewport.width;
+    float scaleY = 2.f / mapping.viewport.height;
+    Transform toNormalized(scaleX, 0.f,     -1.f - left * scaleX,
+                           0.f,    -scaleY,  1.f + top * scaleY,
+                           0.f,    0.f,      1.f);
+    mapping.pixelToCoords = view.getInverseTransform() * toNormalized;
+
+    // The view matrix, then homogeneous coordinates to pixels
+    float halfWidth = mapping.viewport.width / 2.f;
+    float halfHeight = mapping.viewport.height / 2.f;
+    Transform toPixels(halfWidth, 0.f,         halfWidth + left,
+                       0.f,       -halfHeight, halfHeight + top,
+                       0.f,       0.f,         1.f);
+    mapping.coordsToPixel = toPixels * view.getTransform();
+
+    return mapping;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Drawable& drawable, const RenderStates& states)
+{
+    FloatRect bounds;
+    if (m_culling && drawable.getCullingBounds(bounds) && isCulled(states.transform.transformRect(bounds)))
+        return;
+
+    drawable.draw(*this, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Sprite& sprite, const RenderStates& states)
+{
+    if (!sprite.m_texture)
+        return;
+
+    // Identity parents are the common case, the combine is skipped for them
+    RenderStates spriteStates(states.blendMode, sprite.getTransform(), sprite.m_texture, states.shader);
+    if (states.transform != Transform::Identity)
+        spriteStates.transform = states.transform * spriteStates.transform;
+
+    if (m_culling && isCulled(spriteStates.transform.transformRect(sprite.getLocalBounds())))
+        return;
+
+    // Streamed textures are refined to the level this draw displays
+    if (priv::isTextureStreamed(*sprite.m_texture))
+    {
+        FloatRect bounds = spriteStates.transform.transformRect(sprite.getLocalBounds());
+        IntRect viewport = getViewport(m_view);
+        Vector2f viewSize = m_view.getSize();
+        float width  = bounds.width * viewport.width / std::fabs(viewSize.x);
+        float height = bounds.height * viewport.height / std::fabs(viewSize.y);
+
+        const IntRect& rect = sprite.getTextureRect();
+        if ((width > 0.f) && (height > 0.f))
+            priv::requestTextureDetail(*sprite.m_texture, std::min(std::abs(rect.width) / width, std::abs(rect.height) / height), width * height);
+    }
+
+    sprite.drawTransformed(*this, spriteStates);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Vertex*       vertices,
+                        std::size_t         vertexCount,
+                        PrimitiveType       type,
+                        const RenderStates& states)
+{
+    SFML_TRACE_SCOPE("RenderTarget::draw");
+
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        if (m_capture)
+            m_capture->recordDraw(*this, vertices, vertexCount, NULL, 0, type, states);
+
+        // Draws with a custom shader are never deferred
+        if (m_deferred && !states.shader)
+        {
+            recordDeferred(vertices, vertexCount, type, states);
+            return;
+        }
+
+        replayDeferred();
+        drawImmediate(vertices, vertexCount, type, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Vertex*       vertices,
+                        std::size_t         vertexCount,
+                        const Uint16*       indices,
+                        std::size_t         indexCount,
+                        PrimitiveType       type,
+                        const RenderStates& states)
+{
+    SFML_TRACE_SCOPE("RenderTarget::draw");
+
+    // Nothing to draw? 16-bit indices can't address more vertices,
+    // and GLES and WebGL have no GL_QUADS to index
+    if (!vertices || (vertexCount == 0) || (vertexCount > 65536) || !indices || (indexCount == 0) || (type == Quads))
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        if (m_capture)
+            m_capture->recordDraw(*this, vertices, vertexCount, indices, indexCount, type, states);
+
+        replayDeferred();
+        setupDraw(states);
+
+        getPipeline()->flush(RenderStats::FlushUnbatchable);
+        getPipeline()->drawIndexedVertices(vertices, vertexCount, indices, indexCount, type, states.texture, states.shader);
+        markDirty(vertices, vertexCount, states);
+
+        cleanupDraw(states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const DrawList& drawList)
+{
+    Uint8 layer = m_queue.layer;
+
+    // The vertices are already transformed
+    for (std::size_t i = 0; i < drawList.m_commands.size(); ++i)
+    {
+        const DrawList::Command& command = drawList.m_commands[i];
+
+        m_queue.layer = command.layer;
+        draw(&drawList.m_vertices[command.firstVertex], command.vertexCount, command.type,
+             RenderStates(command.blendMode, Transform::Identity, command.texture, command.shader));
+    }
+
+    m_queue.layer = layer;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawImmediate(const Vertex*       vertices,
+                                 std::size_t         vertexCount,
+                                 PrimitiveType       type,
+                                 const RenderStates& states)
+{
+    setupDraw(states);
+
+    if (!m_batching || states.shader ||
+        !getPipeline()->batchVertices(vertices, vertexCount, type, states.transform, states.texture))
+    {
+        getPipeline()->flush(RenderStats::FlushUnbatchable);
+        getPipeline()->drawVertices(vertices, type, 0, vertexCount, states.texture, states.shader);
+    }
+
+    markDirty(vertices, vertexCount, states);
+
+    cleanupDraw(states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, 0, vertexBuffer.getVertexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer,
+                        std::size_t         firstVertex,
+                        std::size_t         vertexCount,
+                        const RenderStates& states)
+{
+    // Sanity check
+    if (firstVertex > vertexBuffer.getVertexCount())
+        return;
+
+    // Clamp vertexCount to something that makes sense
+    vertexCount = std::min(vertexCount, vertexBuffer.getVertexCount() - firstVertex);
+
+    // Nothing to draw?
+    if (!vertexCount)
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        if (m_capture)
+            m_capture->recordBufferDraw(vertexCount);
+
+        replayDeferred();
+        setupDraw(states);
+
+        getPipeline()->flush(RenderStats::FlushUnbatchable);
+        getPipeline()->drawVertexBuffer(vertexBuffer, firstVertex, vertexCount, states.texture, states.shader);
+        markDirty();
+
+        cleanupDraw(states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Vertex*       vertices,
+                        const std::size_t*  firstVertices,
+                        const std::size_t*  vertexCounts,
+                        std::size_t         rangeCount,
+                        PrimitiveType       type,
+                        const RenderStates& states)
+{
+    SFML_TRACE_SCOPE("RenderTarget::draw");
+
+    // Nothing to draw?
+    if (!vertices || !firstVertices || !vertexCounts || (rangeCount == 0))
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        if (m_capture)
+        {
+            for (std::size_t i = 0; i < rangeCount; ++i)
+                m_capture->recordDraw(*this, vertices + firstVertices[i], vertexCounts[i], NULL, 0, type, states);
+        }
+
+        replayDeferred();
+        setupDraw(states);
+
+        getPipeline()->flush(RenderStats::FlushUnbatchable);
+        getPipeline()->drawVertexRanges(vertices, firstVertices, vertexCounts, rangeCount, type, states.texture, states.shader);
+
+        for (std::size_t i = 0; i < rangeCount; ++i)
+            markDirty(vertices + firstVertices[i], vertexCounts[i], states);
+
+        cleanupDraw(states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer,
+                        const std::size_t*  firstVertices,
+                        const std::size_t*  vertexCounts,
+                        std::size_t         rangeCount,
+                        const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!firstVertices || !vertexCounts || (rangeCount == 0) || !vertexBuffer.getVertexCount())
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        if (m_capture)
+        {
+            for (std::size_t i = 0; i < rangeCount; ++i)
+                m_capture->recordBufferDraw(vertexCounts[i]);
+        }
+
+        replayDeferred();
+        setupDraw(states);
+
+        getPipeline()->flush(RenderStats::FlushUnbatchable);
+        getPipeline()->drawVertexBufferRanges(vertexBuffer, firstVertices, vertexCounts, rangeCount, states.texture, states.shader);
+        markDirty();
+
+        cleanupDraw(states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer* const* vertexBuffers, std::size_t count, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertexBuffers || (count == 0))
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        if (m_capture)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (vertexBuffers[i])
+                    m_capture->recordBufferDraw(vertexBuffers[i]->getVertexCount());
+            }
+        }
+
+        replayDeferred();
+        setupDraw(states);
+
+        getPipeline()->flush(RenderStats::FlushUnbatchable);
+        getPipeline()->drawVertexBufferList(vertexBuffers, count, states.texture, states.shader);
+        markDirty();
+
+        cleanupDraw(states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, indexBuffer, 0, indexBuffer.getIndexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer,
+                        const IndexBuffer&  indexBuffer,
+                        std::size_t         firstIndex,
+                        std::size_t         indexCount,
+                        const RenderStates& states)
+{
+    // Sanity check
+    if (firstIndex > indexBuffer.getIndexCount())
+        return;
+
+    // Clamp indexCount to something that makes sense
+    indexCount = std::min(indexCount, indexBuffer.getIndexCount() - firstIndex);
+
+    // Nothing to draw? GLES and WebGL have no GL_QUADS to index
+    if (!indexCount || !vertexBuffer.getVertexCount() || (vertexBuffer.getPrimitiveType() == Quads))
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        if (m_capture)
+            m_capture->recordBufferDraw(indexCount);
+
+        replayDeferred();
+        setupDraw(states);
+
+        getPipeline()->flush(RenderStats::FlushUnbatchable);
+        getPipeline()->drawIndexedBuffer(vertexBuffer, indexBuffer, firstIndex, indexCount, states.texture, states.shader);
+        markDirty();
+
+        cleanupDraw(states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const LayeredVertex* vertices,
+                        std::size_t          vertexCount,
+                        PrimitiveType        type,
+                        const TextureArray&  textureArray,
+                        const RenderStates&  states)
+{
+    SFML_TRACE_SCOPE("RenderTarget::draw");
+
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0) || !textureArray.getNativeHandle())
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        if (m_capture)
+            m_capture->recordBufferDraw(vertexCount);
+
+        replayDeferred();
+        setupDraw(states);
+
+        getPipeline()->flush(RenderStats::FlushUnbatchable);
+        getPipeline()->drawLayeredVertices(vertices, type, vertexCount, textureArray, states.shader);
+        markDirty();
+
+        cleanupDraw(states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Vertex*       vertices,
+                        std::size_t         vertexCount,
+                        PrimitiveType       type,
+                        const YuvTexture&   texture,
+                        const RenderStates& states)
+{
+    SFML_TRACE_SCOPE("RenderTarget::draw");
+
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0) || !texture.getNativeHandle(0))
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        if (m_capture)
+            m_capture->recordBufferDraw(vertexCount);
+
+        replayDeferred();
+        setupDraw(states);
+
+        getPipeline()->flush(RenderStats::FlushUnbatchable);
+        getPipeline()->drawYuvVertices(vertices, type, vertexCount, texture, states.shader);
+        markDirty();
+
+        cleanupDraw(states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawOutlinedGlyphs(const Vertex* vertices, std::size_t vertexCount, const Color& outlineColor,
+                                      float outlineWidth, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0) || !states.texture)
+        return;
+
+    // Custom shaders replace the outline shader
+    if (states.shader)
+    {
+        draw(vertices, vertexCount, Triangles, states);
+        return;
+    }
+
+    if (isActive(m_id) || setActive(true))
+    {
+        replayDeferred();
+        setupDraw(states);
+
+        getPipeline()->flush(RenderStats::FlushUnbatchable);
+        bool drawn = getPipeline()->drawOutlinedGlyphs(vertices, vertexCount, *states.texture, outlineColor, outlineWidth);
+        markDirty();
+
+        cleanupDraw(states);
+
+        // Without the outline shader, the glyphs are still drawn; the
+        // capture only keeps the glyphs, the outline shader can't be replayed
+        if (!drawn)
+            draw(vertices, vertexCount, Triangles, states);
+        else if (m_capture)
+            m_capture->recordDraw(*this, vertices, vertexCount, NULL, 0, Triangles, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawQuadInstances(unsigned int instanceBuffer, std::size_t instanceCount, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!instanceBuffer || (instanceCount == 0))
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        if (m_capture)
+            m_capture->recordBufferDraw(instanceCount * 4);
+
+        replayDeferred();
+        setupDraw(states);
+
+        getPipeline()->flush(RenderStats::FlushUnbatchable);
+        getPipeline()->drawQuadInstances(instanceBuffer, instanceCount, states.texture, states.shader);
+        markDirty();
+
+        cleanupDraw(states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawParticleInstances(unsigned int instanceBuffer, std::size_t instanceCount, float time,
+                                         const Vector2f& gravity, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!instanceBuffer || (instanceCount == 0))
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        if (m_capture)
+            m_capture->recordBufferDraw(instanceCount * 4);
+
+        replayDeferred();
+        setupDraw(states);
+
+        getPipeline()->flush(RenderStats::FlushUnbatchable);
+        getPipeline()->drawParticleInstances(instanceBuffer, instanceCount, time, gravity, states.texture);
+        markDirty();
+
+        cleanupDraw(states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawAnimatedInstances(unsigned int instanceBuffer, std::size_t instanceCount, float time,
+                                         const float* frames, std::size_t frameCount, Uint64 framesId,
+                                         const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!instanceBuffer || (instanceCount == 0) || (frameCount == 0))
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        if (m_capture)
+            m_capture->recordBufferDraw(instanceCount * 4);
+
+        replayDeferred();
+        setupDraw(states);
+
+        getPipeline()->flush(RenderStats::FlushUnbatchable);
+        getPipeline()->drawAnimatedInstances(instanceBuffer, instanceCount, time, frames, frameCount, framesId, states.texture);
+        markDirty();
+
+        cleanupDraw(states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::setActive(bool active)
+{
+    contextState().lastActiveId = active ? m_id : 0;
+
+    // Switching between targets only has to re-apply the view and
+    // the scissor rectangle, and only if another target changed them
+    if (active && (contextState().stateOwnerId != m_id))
+        m_cache.enable = false;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::pushGLStates()
+{
+    resetGLStates();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::popGLStates()
+{
+    flush();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    if (!enabled && isActive(m_id))
+        flush();
+
+    m_batching = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_batching;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setCullingEnabled(bool enabled)
+{
+    m_culling = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isCullingEnabled() const
+{
+    return m_culling;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flush()
+{
+    replayDeferred();
+    getPipeline()->flush();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 RenderTarget::readPixelsAsync(const IntRect& area)
+{
+    Vector2u targetSize = getSize();
+    if ((area.width <= 0) || (area.height <= 0) || (area.left < 0) || (area.top < 0) ||
+        (area.left + area.width > static_cast<int>(targetSize.x)) || (area.top + area.height > static_cast<int>(targetSize.y)))
+    {
+        err() << "Failed to read the pixels of the render target, the area is outside the target" << std::endl;
+        return 0;
+    }
+
+    if (!isActive(m_id) && !setActive(true))
+    {
+        err() << "Failed to read the pixels of the render target, it can't be activated" << std::endl;
+        return 0;
+    }
+
+    // The pixels must include the draws that are still batched
+    flush();
+
+    PixelReadback readback;
+    readback.token  = ++lastReadbackToken;
+    readback.buffer = 0;
+    readback.fence  = 0;
+    readback.size   = Vector2u(area.width, area.height);
+
+    // OpenGL rows go from bottom to top
+    GLint x = area.left;
+    GLint y = static_cast<GLint>(targetSize.y) - area.top - area.height;
+    GLsizeiptr size = static_cast<GLsizeiptr>(area.width) * area.height * 4;
+
+    glCheck(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+
+    if (isAsyncReadbackAvailable())
+    {
+        if (!freeReadbackBuffers.empty())
+        {
+            readback.buffer = freeReadbackBuffers.back();
+            freeReadbackBuffers.pop_back();
+        }
+        else
+        {
+            glCheck(glGenBuffers(1, &readback.buffer));
+        }
+
+        // The driver only records the copy, the pixels land in the buffer later
+        priv::GLStateCache& cache = priv::getGLStateCache();
+        cache.bindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+        glCheck(glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ));
+        glCheck(glReadPixels(x, y, area.width, area.height, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+
+        // Client memory readbacks must never see a bound pack buffer
+        cache.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        glCheck(readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    }
+    else
+    {
+        // No pixel buffers: read synchronously, the result is ready right away
+        readback.pixels.resize(static_cast<std::size_t>(size));
+        glCheck(glReadPixels(x, y, area.width, area.height, GL_RGBA, GL_UNSIGNED_BYTE, &readback.pixels[0]));
+    }
+
+    pendingReadbacks.push_back(readback);
+
+    return readback.token;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::collectPixels(Uint64 token, Image& image, bool wait)
+{
+    std::size_t index = 0;
+    while ((index < pendingReadbacks.size()) && (pendingReadbacks[index].token != token))
+        ++index;
+
+    if (index == pendingReadbacks.size())
+        return false;
+
+    PixelReadback& readback = pendingReadbacks[index];
+
+    if (readback.buffer)
+    {
+        // Don't stall the pipeline unless asked to, a few frames are
+        // usually enough for the copy to be done
+        const GLuint64 timeout = wait ? 1000000000ull : 0;
+        GLenum status;
+        glCheck(status = glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout));
+        if ((status != GL_ALREADY_SIGNALED) && (status != GL_CONDITION_SATISFIED))
+            return false;
+
+        glCheck(glDeleteSync(readback.fence));
+        readback.fence = 0;
+
+        priv::GLStateCache& cache = priv::getGLStateCache();
+        cache.bindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+
+        GLsizeiptr size = static_cast<GLsizeiptr>(readback.size.x) * readback.size.y * 4;
+        const void* source = NULL;
+        glCheck(source = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT));
+        if (source)
+        {
+            image.create(readback.size.x, readback.size.y, static_cast<const Uint8*>(source));
+            glCheck(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+        }
+        else
+        {
+            err() << "Failed to read the pixels of the render target, the pixel buffer can't be mapped" << std::endl;
+            image.create(0, 0, static_cast<const Uint8*>(NULL));
+        }
+
+        cache.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        if (freeReadbackBuffers.size() < maxFreeReadbackBuffers)
+            freeReadbackBuffers.push_back(readback.buffer);
+        else
+            cache.deleteBuffer(readback.buffer);
+    }
+    else
+    {
+        image.create(readback.size.x, readback.size.y, &readback.pixels[0]);
+    }
+
+    image.flipVertically();
+    pendingReadbacks.erase(pendingReadbacks.begin() + index);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderStats& RenderTarget::getFrameStats() const
+{
+    return priv::getRenderStats();
+}
+
+
+////////////////////////////////////////////////////////////
+const GraphicsCaps& RenderTarget::getGraphicsCaps() const
+{
+    return priv::getGraphicsCaps();
+}
 
-        glCheck(glDrawArrays(mode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
-    };
 
+////////////////////////////////////////////////////////////
+void RenderTarget::setOverdrawHeatmapEnabled(bool enabled)
+{
+    // The recorded draws are rendered in the mode they were issued in
+    if ((enabled != m_overdraw) && isActive(m_id))
+        replayDeferred();
 
-    // pipeline ref count
-    int pipelineRefCount = 0;
+    m_overdraw = enabled;
+}
 
-    
-    // pipeline instance
-    SfmlRenderPipeline* pipeline = nullptr;
 
-    
-    // creates new sfml render pipeline if not exist
-    inline void pipelineCreate()
-    {
-        if (pipelineRefCount++ == 0)
-        {
-            pipeline = new SfmlRenderPipeline;
-        };
-    };
+////////////////////////////////////////////////////////////
+bool RenderTarget::isOverdrawHeatmapEnabled() const
+{
+    return m_overdraw;
+}
 
 
-    // destroys sfml render pipelne if refs end
-    inline void pipelineDestroy()
-    {
-        if (--pipelineRefCount == 0)
-        {
-            delete pipeline;
-            pipeline = nullptr;
-        };
-    };
+////////////////////////////////////////////////////////////
+Uint64 RenderTarget::readOverdrawAsync()
+{
+    Vector2u size = getSize();
+    return readPixelsAsync(IntRect(0, 0, size.x, size.y));
 }
 
 
-namespace sf
-{
 ////////////////////////////////////////////////////////////
-RenderTarget::RenderTarget() :
-m_defaultView(),
-m_view(),
-m_cache(),
-m_id(0)
+bool RenderTarget::collectOverdraw(Uint64 token, float& factor, bool wait)
 {
-    sf::priv::ensureExtensionsInit();
-    m_cache.glStatesSet = false;
-    pipelineCreate();
+    Image image;
+    if (!collectPixels(token, image, wait))
+        return false;
+
+    // The blue channel holds twice the number of fragments of each pixel
+    std::size_t pixelCount = static_cast<std::size_t>(image.getSize().x) * image.getSize().y;
+    const Uint8* pixels = image.getPixelsPtr();
+    Uint64 total = 0;
+    for (std::size_t i = 0; i < pixelCount; ++i)
+        total += pixels[i * 4 + 2] / 2;
+
+    factor = pixelCount ? static_cast<float>(static_cast<double>(total) / pixelCount) : 0.f;
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-RenderTarget::~RenderTarget()
+void RenderTarget::resetFrameStats()
 {
-    pipelineDestroy();
+    priv::getRenderStats() = RenderStats();
+    priv::advanceGpuMemoryFrame();
+
+    // The temporaries of the frame are released at once
+    FrameArena::getDefault().reset();
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::clear(const Color& color)
+void RenderTarget::releaseContext()
 {
-    if (isActive(m_id) || setActive(true))
+    ContextState& state = contextState();
+
+    // The pending draws need the pipeline that is about to be destroyed
+    if (state.deferredTarget)
+        state.deferredTarget->flush();
+
+    if (state.pipeline)
+    {
+        state.pipeline->flush();
+        delete state.pipeline;
+        state.pipeline = nullptr;
+    }
+
+    priv::releaseCopyFramebuffers();
+
     {
-        lastActiveId = m_id;
+        Lock lock(contextMutex);
 
-        glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
-        glCheck(glClear(GL_COLOR_BUFFER_BIT));
+        contextStates.erase(priv::getCurrentContext());
+        delete &state;
+
+        // Another context may be created at the same address
+        contextGeneration.fetch_add(1, std::memory_order_release);
     }
+
+    priv::releaseGLStateCache();
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::setView(const View& view)
+void RenderTarget::setCapture(DrawCapture* capture)
 {
-    m_view = view;
-    m_cache.viewChanged = true;
+    m_capture = capture;
 }
 
 
 ////////////////////////////////////////////////////////////
-const View& RenderTarget::getView() const
+DrawCapture* RenderTarget::getCapture() const
 {
-    return m_view;
+    return m_capture;
 }
 
 
 ////////////////////////////////////////////////////////////
-const View& RenderTarget::getDefaultView() const
+void RenderTarget::setMinimalGLLoading(bool enabled)
 {
-    return m_defaultView;
+    priv::setMinimalGLLoading(enabled);
 }
 
 
 ////////////////////////////////////////////////////////////
-IntRect RenderTarget::getViewport(const View& view) const
+const StartupStats& RenderTarget::getStartupStats()
 {
-    float width = static_cast<float>(getSize().x);
-    float height = static_cast<float>(getSize().y);
-    const FloatRect& viewport = view.getViewport();
-
-    return IntRect(static_cast<int>(0.5f + width  * viewport.left),
-                   static_cast<int>(0.5f + height * viewport.top),
-                   static_cast<int>(0.5f + width  * viewport.width),
-                   static_cast<int>(0.5f + height * viewport.height));
+    return priv::getStartupStats();
 }
 
 
 ////////////////////////////////////////////////////////////
-Vector2f RenderTarget::mapPixelToCoords(const Vector2i& point) const
+void RenderTarget::setDeferredEnabled(bool enabled)
 {
-    return mapPixelToCoords(point, getView());
+    if (!enabled && isActive(m_id))
+        flush();
+
+    m_deferred = enabled;
 }
 
 
 ////////////////////////////////////////////////////////////
-Vector2f RenderTarget::mapPixelToCoords(const Vector2i& point, const View& view) const
+bool RenderTarget::isDeferredEnabled() const
 {
-    // First, convert from viewport coordinates to homogeneous coordinates
-    Vector2f normalized;
-    IntRect viewport = getViewport(view);
-    normalized.x = -1.f + 2.f * (point.x - viewport.left) / viewport.width;
-    normalized.y =  1.f - 2.f * (point.y - viewport.top)  / viewport.height;
-
-    // Then transform by the inverse of the view matrix
-    return view.getInverseTransform().transformPoint(normalized);
+    return m_deferred;
 }
 
 
 ////////////////////////////////////////////////////////////
-Vector2i RenderTarget::mapCoordsToPixel(const Vector2f& point) const
+void RenderTarget::setDrawLayer(Uint8 layer)
 {
-    return mapCoordsToPixel(point, getView());
+    m_queue.layer = layer;
 }
 
 
 ////////////////////////////////////////////////////////////
-Vector2i RenderTarget::mapCoordsToPixel(const Vector2f& point, const View& view) const
+Uint8 RenderTarget::getDrawLayer() const
 {
-    // First, transform the point by the view matrix
-    Vector2f normalized = view.getTransform().transformPoint(point);
+    return m_queue.layer;
+}
+
 
-    // Then convert to viewport coordinates
-    Vector2i pixel;
-    IntRect viewport = getViewport(view);
-    pixel.x = static_cast<int>((normalized.x  + 1.f) / 2.f * viewport.width  + viewport.left);
-    pixel.y = static_cast<int>((-normalized.y + 1.f) / 2.f * viewport.height + viewport.top);
+////////////////////////////////////////////////////////////
+void RenderTarget::setDepthPrePassEnabled(bool enabled)
+{
+    // The recorded draws were classified for the previous mode
+    if ((enabled != m_depthPrePass) && !m_queue.draws.empty() && isActive(m_id))
+        replayDeferred();
 
-    return pixel;
+    m_depthPrePass = enabled;
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::draw(const Drawable& drawable, const RenderStates& states)
+bool RenderTarget::isDepthPrePassEnabled() const
 {
-    drawable.draw(*this, states);
+    return m_depthPrePass;
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::draw(const Vertex*       vertices,
-                        std::size_t         vertexCount,
-                        PrimitiveType       type,
-                        const RenderStates& states)
+void RenderTarget::recordDeferred(const Vertex*       vertices,
+                                  std::size_t         vertexCount,
+                                  PrimitiveType       type,
+                                  const RenderStates& states)
 {
-    // Nothing to draw?
-    if (!vertices || (vertexCount == 0))
-        return;
+    // Copy the vertices to the frame arena, in world coordinates
+    std::size_t firstVertex = m_queue.vertices.size();
+    m_queue.vertices.resize(firstVertex + vertexCount);
 
-    if (isActive(m_id) || setActive(true))
+    states.transform.transformPoints(vertices, &m_queue.vertices[firstVertex], vertexCount);
+
+    // Snapshot the view if it changed since the last recorded draw
+    if (m_queue.viewChanged || m_queue.views.empty())
     {
-        setupDraw(states);
+        m_queue.views.push_back(m_view);
+        m_queue.viewChanged = false;
+    }
 
-        pipeline->drawVertices(vertices, type, 0, vertexCount, states.texture, states.shader);
+    // Few blend modes are used within a frame, a linear search of their keys is enough
+    const Uint32 blendKey = states.blendMode.getKey();
+    std::size_t blendMode = 0;
+    while ((blendMode < m_queue.blendKeys.size()) && (m_queue.blendKeys[blendMode] != blendKey))
+        ++blendMode;
 
-        cleanupDraw(states);
+    if (blendMode == m_queue.blendKeys.size())
+    {
+        m_queue.blendModes.push_back(states.blendMode);
+        m_queue.blendKeys.push_back(blendKey);
     }
-}
 
+    DeferredDraw draw;
+    draw.texture     = states.texture;
+    draw.blendMode   = blendMode;
+    draw.view        = m_queue.views.size() - 1;
+    draw.firstVertex = firstVertex;
+    draw.vertexCount = vertexCount;
+    draw.type        = type;
+    draw.key         = deferredSortKey(m_queue.layer, draw.blendMode, states.texture ? states.texture->m_storageId : 0, draw.view);
+    draw.opaque      = m_depthPrePass && isOpaqueDraw(&m_queue.vertices[firstVertex], vertexCount, states);
 
-////////////////////////////////////////////////////////////
-void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
-{
-    draw(vertexBuffer, 0, vertexBuffer.getVertexCount(), states);
+    m_queue.draws.push_back(draw);
+
+    contextState().deferredTarget = this;
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::draw(const VertexBuffer& vertexBuffer,
-                        std::size_t         firstVertex,
-                        std::size_t         vertexCount,
-                        const RenderStates& states)
+void RenderTarget::replayDeferred()
 {
-    // Sanity check
-    if (firstVertex > vertexBuffer.getVertexCount())
+    if (m_queue.draws.empty())
         return;
 
-    // Clamp vertexCount to something that makes sense
-    vertexCount = std::min(vertexCount, vertexBuffer.getVertexCount() - firstVertex);
+    if (contextState().deferredTarget == this)
+        contextState().deferredTarget = nullptr;
 
-    // Nothing to draw?
-    if (!vertexCount)
-        return;
+    // Take the draws out of the queue, so that nested calls see it empty
+    std::vector<DeferredDraw> draws;
+    draws.swap(m_queue.draws);
 
-    if (isActive(m_id) || setActive(true))
+    // Stable, to keep the painter's order of draws with the same states;
+    // opaque draws come first, with their layers from front to back
+    const Uint64 layerBits = static_cast<Uint64>(0xFF) << 56;
+    std::stable_sort(draws.begin(), draws.end(), [layerBits](const DeferredDraw& left, const DeferredDraw& right)
     {
-        setupDraw(states);
+        if (left.opaque != right.opaque)
+            return left.opaque;
 
-        pipeline->drawVertexBuffer(vertexBuffer, firstVertex, vertexCount, states.texture, states.shader);
+        if (left.opaque)
+            return (left.key ^ layerBits) < (right.key ^ layerBits);
 
-        cleanupDraw(states);
+        return left.key < right.key;
+    });
+
+    // Replay through the batcher, with the views the draws were recorded with
+    View view = m_view;
+    bool batching = m_batching;
+    m_batching = true;
+
+    std::size_t currentView = m_queue.views.size();
+
+    // Only the opaque draws fill the depth buffer, the others are only tested against it
+    bool depthPrePass = draws.front().opaque;
+    bool opaquePass = true;
+    int  depthLayer = -1;
+
+    if (depthPrePass)
+    {
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
+        getPipeline()->flush(RenderStats::FlushDepthLayer);
+
+        priv::GLStateCache& cache = priv::getGLStateCache();
+        cache.setEnabled(GL_BLEND, false);
+        cache.setEnabled(GL_DEPTH_TEST, true);
+        glCheck(glDepthFunc(GL_LEQUAL));
+        glCheck(glDepthMask(GL_TRUE));
     }
-}
 
+    for (std::size_t i = 0; i < draws.size(); ++i)
+    {
+        const DeferredDraw& draw = draws[i];
 
-////////////////////////////////////////////////////////////
-bool RenderTarget::setActive(bool active)
-{
-    m_cache.enable = false;
-    return true;
-}
+        if (depthPrePass)
+        {
+            int layer = static_cast<int>(draw.key >> 56);
+            if ((layer != depthLayer) || (draw.opaque != opaquePass))
+            {
+                getPipeline()->flush(RenderStats::FlushDepthLayer);
+
+                if (opaquePass && !draw.opaque)
+                {
+                    glCheck(glDepthMask(GL_FALSE));
+                    priv::getGLStateCache().setEnabled(GL_BLEND, true);
+                    opaquePass = false;
+                }
+
+                // A constant depth per layer, front layers are closer
+                setDepthRange((255 - layer) / 256.f, (255 - layer) / 256.f);
+                depthLayer = layer;
+            }
+        }
 
+        if (draw.view != currentView)
+        {
+            m_view = m_queue.views[draw.view];
+            m_cache.viewChanged = true;
+            currentView = draw.view;
+        }
 
-////////////////////////////////////////////////////////////
-void RenderTarget::pushGLStates()
-{
-    resetGLStates();
-}
+        RenderStates states(m_queue.blendModes[draw.blendMode], Transform::Identity, draw.texture, NULL);
+        drawImmediate(&m_queue.vertices[draw.firstVertex], draw.vertexCount, draw.type, states);
+    }
 
+    if (depthPrePass)
+    {
+        getPipeline()->flush(RenderStats::FlushDepthLayer);
 
-////////////////////////////////////////////////////////////
-void RenderTarget::popGLStates()
-{
+        priv::GLStateCache& cache = priv::getGLStateCache();
+        cache.setEnabled(GL_BLEND, true);
+        cache.setEnabled(GL_DEPTH_TEST, false);
+        glCheck(glDepthMask(GL_TRUE));
+        setDepthRange(0.f, 1.f);
+    }
+
+    m_batching = batching;
+    m_view = view;
+    m_cache.viewChanged = true;
 
+    // Reset the queue, keeping its memory for the next frame
+    draws.clear();
+    m_queue.draws.swap(draws);
+    m_queue.vertices.clear();
+    m_queue.views.clear();
+    m_queue.blendModes.clear();
+    m_queue.blendKeys.clear();
+    m_queue.viewChanged = true;
 }
 
 
@@ -673,16 +4905,24 @@ void RenderTarget::resetGLStates()
         // Make sure that extensions are initialized
         priv::ensureExtensionsInit();
 
+        // Submit pending draws with the states they were issued with
+        getPipeline()->flush();
+
+        // Forget the shadowed states, the user may have changed them with raw OpenGL calls
+        priv::GLStateCache& cache = priv::getGLStateCache();
+        cache.invalidate();
+
         // Define the default OpenGL states
-        glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glEnable(GL_BLEND));
+        cache.setEnabled(GL_CULL_FACE, false);
+        m_cache.scissorChanged = true;
+        cache.setEnabled(GL_DEPTH_TEST, false);
+        cache.setEnabled(GL_BLEND, true);
         m_cache.glStatesSet = true;
 
         // Apply the default SFML states
         applyBlendMode(BlendAlpha);
 
-        glCheck(VertexBuffer::bind(NULL));
+        VertexBuffer::bind(NULL);
         
         // Set the default view
         setView(getView());
@@ -698,6 +4938,7 @@ void RenderTarget::initialize()
     // Setup the default and current views
     m_defaultView.reset(FloatRect(0, 0, static_cast<float>(getSize().x), static_cast<float>(getSize().y)));
     m_view = m_defaultView;
+    m_cullAreaValid = false;
 
     // Set GL states only on first draw, so that we don't pollute user's states
     m_cache.glStatesSet = false;
@@ -705,54 +4946,289 @@ void RenderTarget::initialize()
     // Generate a unique ID for this RenderTarget to track
     // whether it is active within a specific context
     m_id = getUniqueId();
+
+    // The previous contents are gone with the previous size
+    m_dirtyArea = IntRect();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setDirtyTracking(bool enabled)
+{
+    m_dirtyTracking = enabled;
+    m_dirtyArea = IntRect();
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect RenderTarget::takeDirtyArea()
+{
+    IntRect area = m_dirtyArea;
+    m_dirtyArea = IntRect();
+
+    return area;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::markDirty()
+{
+    if (m_dirtyTracking)
+        mergeDirtyArea(getDrawableArea());
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::markDirty(const Vertex* vertices, std::size_t vertexCount, const RenderStates& states)
+{
+    if (!m_dirtyTracking)
+        return;
+
+    // A vertex shader may move the vertices anywhere
+    if (states.shader)
+    {
+        markDirty();
+        return;
+    }
+
+    // Bounding rectangle of the vertices, in world coordinates
+    float left   = vertices[0].position.x;
+    float top    = vertices[0].position.y;
+    float right  = left;
+    float bottom = top;
+
+    for (std::size_t i = 1; i < vertexCount; ++i)
+    {
+        const Vector2f& position = vertices[i].position;
+
+        left   = std::min(left, position.x);
+        top    = std::min(top, position.y);
+        right  = std::max(right, position.x);
+        bottom = std::max(bottom, position.y);
+    }
+
+    FloatRect bounds = states.transform.transformRect(FloatRect(left, top, right - left, bottom - top));
+
+    // Map the corners to pixels, the view may be rotated
+    Vector2i corners[4] =
+    {
+        mapCoordsToPixel(Vector2f(bounds.left, bounds.top)),
+        mapCoordsToPixel(Vector2f(bounds.left + bounds.width, bounds.top)),
+        mapCoordsToPixel(Vector2f(bounds.left, bounds.top + bounds.height)),
+        mapCoordsToPixel(Vector2f(bounds.left + bounds.width, bounds.top + bounds.height))
+    };
+
+    int minX = corners[0].x;
+    int minY = corners[0].y;
+    int maxX = minX;
+    int maxY = minY;
+
+    for (int i = 1; i < 4; ++i)
+    {
+        minX = std::min(minX, corners[i].x);
+        minY = std::min(minY, corners[i].y);
+        maxX = std::max(maxX, corners[i].x);
+        maxY = std::max(maxY, corners[i].y);
+    }
+
+    // Grow by a pixel on each side, for the rounding of the mapping
+    // and the width of lines and points, then clamp to what draws can reach
+    IntRect limit = getDrawableArea();
+    minX = std::max(minX - 1, limit.left);
+    minY = std::max(minY - 1, limit.top);
+    maxX = std::min(maxX + 2, limit.left + limit.width);
+    maxY = std::min(maxY + 2, limit.top + limit.height);
+
+    if ((minX < maxX) && (minY < maxY))
+        mergeDirtyArea(IntRect(minX, minY, maxX - minX, maxY - minY));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::mergeDirtyArea(const IntRect& area)
+{
+    if ((area.width <= 0) || (area.height <= 0))
+        return;
+
+    if ((m_dirtyArea.width <= 0) || (m_dirtyArea.height <= 0))
+    {
+        m_dirtyArea = area;
+        return;
+    }
+
+    int left   = std::min(area.left, m_dirtyArea.left);
+    int top    = std::min(area.top, m_dirtyArea.top);
+    int right  = std::max(area.left + area.width, m_dirtyArea.left + m_dirtyArea.width);
+    int bottom = std::max(area.top + area.height, m_dirtyArea.top + m_dirtyArea.height);
+
+    m_dirtyArea = IntRect(left, top, right - left, bottom - top);
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyCurrentView()
 {
+    // Pending draws use the previous view
+    getPipeline()->flush(RenderStats::FlushView);
+
     // Set the viewport
     IntRect viewport = getViewport(m_view);
     int top = getSize().y - (viewport.top + viewport.height);
-    glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
+    priv::getGLStateCache().viewport(viewport.left, top, viewport.width, viewport.height);
 
-    pipeline->applyCurrentView(m_view);
+    getPipeline()->applyCurrentView(m_view, getSize());
 
     m_cache.viewChanged = false;
+    contextState().stateOwnerId = m_id;
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::applyBlendMode(const BlendMode& mode)
+void RenderTarget::applyScissor()
 {
-    // Apply the blend mode, falling back to the non-separate versions if necessary
-    if (GLAD_GL_EXT_blend_func_separate)
+    // Pending draws use the previous scissor
+    getPipeline()->flush(RenderStats::FlushScissor);
+
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
+    if ((m_scissor.width > 0) && (m_scissor.height > 0))
     {
-        glCheck(glBlendFuncSeparate(
-            factorToGlConstant(mode.colorSrcFactor), factorToGlConstant(mode.colorDstFactor),
-            factorToGlConstant(mode.alphaSrcFactor), factorToGlConstant(mode.alphaDstFactor)));
+        int top = getSize().y - (m_scissor.top + m_scissor.height);
+        cache.scissor(m_scissor.left, top, m_scissor.width, m_scissor.height);
+        cache.setEnabled(GL_SCISSOR_TEST, true);
     }
     else
     {
-        glCheck(glBlendFunc(
-            factorToGlConstant(mode.colorSrcFactor),
-            factorToGlConstant(mode.colorDstFactor)));
+        cache.setEnabled(GL_SCISSOR_TEST, false);
     }
 
-    if (GLAD_GL_EXT_blend_minmax && GLAD_GL_EXT_blend_subtract)
+    // The stencil test of the clip masks belongs to the target as well
+    applyStencil();
+
+    m_cache.scissorChanged = false;
+    contextState().stateOwnerId = m_id;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isCulled(const FloatRect& bounds)
+{
+    // The area is cached separately from m_cache.viewChanged, which every draw resets
+    if (!m_cullAreaValid)
     {
-        if (GLAD_GL_EXT_blend_equation_separate)
-        {
-            glCheck(glBlendEquationSeparate(
-                equationToGlConstant(mode.colorEquation),
-                equationToGlConstant(mode.alphaEquation)));
-        }
-        else
+        m_cullArea = m_view.getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+
+        // Restrict it to the scissor rectangle, mapped to world coordinates
+        if ((m_scissor.width > 0) && (m_scissor.height > 0))
         {
-            glCheck(glBlendEquation(equationToGlConstant(mode.colorEquation)));
+            Vector2f corners[4] =
+            {
+                mapPixelToCoords(Vector2i(m_scissor.left, m_scissor.top)),
+                mapPixelToCoords(Vector2i(m_scissor.left + m_scissor.width, m_scissor.top)),
+                mapPixelToCoords(Vector2i(m_scissor.left, m_scissor.top + m_scissor.height)),
+                mapPixelToCoords(Vector2i(m_scissor.left + m_scissor.width, m_scissor.top + m_scissor.height))
+            };
+
+            Vector2f min = corners[0];
+            Vector2f max = corners[0];
+            for (int i = 1; i < 4; ++i)
+            {
+                min.x = std::min(min.x, corners[i].x);
+                min.y = std::min(min.y, corners[i].y);
+                max.x = std::max(max.x, corners[i].x);
+                max.y = std::max(max.y, corners[i].y);
+            }
+
+            FloatRect scissorArea(min.x, min.y, max.x - min.x, max.y - min.y);
+            if (!m_cullArea.intersects(scissorArea, m_cullArea))
+                m_cullArea = scissorArea;
         }
+
+        m_cullAreaValid = true;
+    }
+
+    // Unlike FloatRect::intersects, keep the flat bounds of lines and points
+    if ((bounds.left > m_cullArea.left + m_cullArea.width) || (bounds.left + bounds.width < m_cullArea.left) ||
+        (bounds.top > m_cullArea.top + m_cullArea.height) || (bounds.top + bounds.height < m_cullArea.top))
+    {
+        ++priv::getRenderStats().drawablesCulled;
+        return true;
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyStencil()
+{
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
+    if ((m_clipDepth == 0) && (m_stencilMode == StencilTest))
+    {
+        cache.setEnabled(GL_STENCIL_TEST, false);
+        return;
+    }
+
+    cache.setEnabled(GL_STENCIL_TEST, true);
+
+    switch (m_stencilMode)
+    {
+        case StencilTest:
+            glCheck(glStencilFunc(GL_EQUAL, static_cast<GLint>(m_clipDepth), 0xFF));
+            glCheck(glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP));
+            glCheck(glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE));
+            break;
+
+        case StencilIncrement:
+            glCheck(glStencilFunc(GL_EQUAL, static_cast<GLint>(m_clipDepth), 0xFF));
+            glCheck(glStencilOp(GL_KEEP, GL_KEEP, GL_INCR));
+            glCheck(glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE));
+            break;
+
+        case StencilClamp:
+            // Passes where the stencil is above the depth, and replaces it with the depth
+            glCheck(glStencilFunc(GL_LESS, static_cast<GLint>(m_clipDepth), 0xFF));
+            glCheck(glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE));
+            glCheck(glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE));
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect RenderTarget::getDrawableArea() const
+{
+    IntRect area(0, 0, static_cast<int>(getSize().x), static_cast<int>(getSize().y));
+
+    if ((m_scissor.width > 0) && (m_scissor.height > 0) && !area.intersects(m_scissor, area))
+        return IntRect();
+
+    return area;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyBlendMode(const BlendMode& mode)
+{
+    // Pending draws use the previous blend mode
+    getPipeline()->flush(RenderStats::FlushBlendMode);
+
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
+    // The overdraw heatmap adds up the fragments, whatever their blend mode
+    const BlendMode overdrawMode(BlendMode::One, BlendMode::One, BlendMode::Add);
+    const BlendMode& applied = m_overdraw ? overdrawMode : mode;
+
+    // Apply the blend mode, the shadow falls back to the non-separate versions if necessary
+    cache.blendFunc(factorToGlConstant(applied.colorSrcFactor), factorToGlConstant(applied.colorDstFactor),
+                    factorToGlConstant(applied.alphaSrcFactor), factorToGlConstant(applied.alphaDstFactor));
+
+    if (GLAD_GL_EXT_blend_minmax && GLAD_GL_EXT_blend_subtract)
+    {
+        cache.blendEquation(equationToGlConstant(applied.colorEquation), equationToGlConstant(applied.alphaEquation));
     }
-    else if ((mode.colorEquation != BlendMode::Add) || (mode.alphaEquation != BlendMode::Add))
+    else if ((applied.colorEquation != BlendMode::Add) || (applied.alphaEquation != BlendMode::Add))
     {
         static bool warned = false;
 
@@ -766,14 +5242,14 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
         }
     }
 
-    m_cache.lastBlendMode = mode;
+    contextState().appliedBlendKey = appliedBlendKey(mode, m_overdraw);
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTransform(const Transform& transform)
 {
-    pipeline->applyCurrentTransform(transform);
+    getPipeline()->applyCurrentTransform(transform);
 }
 
 
@@ -790,8 +5266,14 @@ void RenderTarget::setupDraw(const RenderStates& states)
     if (!m_cache.enable || m_cache.viewChanged)
         applyCurrentView();
 
-    // Apply the blend mode
-    if (!m_cache.enable || (states.blendMode != m_cache.lastBlendMode))
+    // Apply the scissor rectangle
+    if (!m_cache.enable || m_cache.scissorChanged)
+        applyScissor();
+
+    // Apply the blend mode, it is shared by all the targets, and so
+    // is the pipeline (which may draw another target's heatmap)
+    getPipeline()->setOverdraw(m_overdraw);
+    if (contextState().appliedBlendKey != appliedBlendKey(states.blendMode, m_overdraw))
         applyBlendMode(states.blendMode);
 }
 
@@ -27,9 +27,12 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/Graphics/GpuProfiler.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/Graphics/GLExtensions.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <cassert>
 
 
 namespace sf
@@ -45,6 +48,11 @@ m_impl(NULL)
 ////////////////////////////////////////////////////////////
 RenderTexture::~RenderTexture()
 {
+    // Pending draws must reach the frame buffer before it is destroyed
+    if (m_impl)
+        priv::flushPendingDraws();
+
+    m_texture.m_resolver = NULL;
     delete m_impl;
 }
 
@@ -59,19 +67,56 @@ bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBu
 ////////////////////////////////////////////////////////////
 bool RenderTexture::create(unsigned int width, unsigned int height, const ContextSettings& settings)
 {
+    return create(width, height, settings, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTexture::create(unsigned int width, unsigned int height, const ContextSettings& settings, unsigned int attachmentCount, Texture::Format format)
+{
+    if ((attachmentCount == 0) || (attachmentCount > getMaximumAttachmentCount()))
+    {
+        err() << "Impossible to create render texture (unsupported number of color attachments)";
+        err() << " Requested: " << attachmentCount << " Maximum supported: " << getMaximumAttachmentCount() << std::endl;
+        return false;
+    }
+
+    if ((format != Texture::RGBA8) && (settings.antialiasingLevel > 0))
+    {
+        err() << "Impossible to create render texture (anti-aliasing is only supported with the RGBA8 format)" << std::endl;
+        return false;
+    }
+
     // Create the texture
-    if (!m_texture.create(width, height))
+    if (!m_texture.create(width, height, format))
     {
         err() << "Impossible to create render texture (failed to create the target texture)" << std::endl;
         return false;
     }
 
+    // Create the additional color attachments
+    m_attachments.resize(attachmentCount - 1);
+
+    std::vector<unsigned int> textureIds(1, m_texture.m_texture);
+    for (std::size_t i = 0; i < m_attachments.size(); ++i)
+    {
+        if (!m_attachments[i].create(width, height, format))
+        {
+            err() << "Impossible to create render texture (failed to create the target texture)" << std::endl;
+            return false;
+        }
+
+        m_attachments[i].m_fboAttachment = true;
+        textureIds.push_back(m_attachments[i].m_texture);
+    }
+
     // We disable smoothing by default for render textures
     setSmooth(false);
 
     // Create the implementation
     if (m_impl)
     {
+        m_texture.m_resolver = NULL;
         delete m_impl;
         m_impl = nullptr;        
     };
@@ -83,12 +128,15 @@ bool RenderTexture::create(unsigned int width, unsigned int height, const Contex
     m_texture.m_fboAttachment = true;
 
     // Initialize the render texture
-    if (!m_impl->create(width, height, m_texture.m_texture, settings))
+    if (!m_impl->create(width, height, textureIds, settings))
         return false;
 
     // We can now initialize the render target part
     RenderTarget::initialize();
 
+    // A multisample buffer is only resolved where something was drawn
+    setDirtyTracking(m_impl->needsDirtyArea());
+
     return true;
 }
 
@@ -100,10 +148,20 @@ unsigned int RenderTexture::getMaximumAntialiasingLevel()
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getMaximumAttachmentCount()
+{
+    return priv::RenderTextureImplFBO::getMaximumAttachmentCount();
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTexture::setSmooth(bool smooth)
 {
     m_texture.setSmooth(smooth);
+
+    for (std::size_t i = 0; i < m_attachments.size(); ++i)
+        m_attachments[i].setSmooth(smooth);
 }
 
 
@@ -118,6 +176,9 @@ bool RenderTexture::isSmooth() const
 void RenderTexture::setRepeated(bool repeated)
 {
     m_texture.setRepeated(repeated);
+
+    for (std::size_t i = 0; i < m_attachments.size(); ++i)
+        m_attachments[i].setRepeated(repeated);
 }
 
 
@@ -131,13 +192,21 @@ bool RenderTexture::isRepeated() const
 ////////////////////////////////////////////////////////////
 bool RenderTexture::generateMipmap()
 {
-    return m_texture.generateMipmap();
+    bool result = m_texture.generateMipmap();
+
+    for (std::size_t i = 0; i < m_attachments.size(); ++i)
+        result = m_attachments[i].generateMipmap() && result;
+
+    return result;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool RenderTexture::setActive(bool active)
 {
+    // Submit pending draws before the frame buffer binding changes
+    priv::flushPendingDraws();
+
     bool result = m_impl && m_impl->activate(active);
 
     // Update RenderTarget tracking
@@ -154,9 +223,23 @@ void RenderTexture::display()
     // Update the target texture
     if (m_impl)
     {
-        m_impl->updateTexture(m_texture.m_texture);
+        GpuProfiler::Scope scope("RenderTexture::display");
+
+        // Submit the pass, the depth and stencil buffers are dropped unless the pass stores them
+        endPass();
+
+        // The resolve of a multisample buffer waits until the texture is used
+        if (m_impl->updateTexture(m_texture.m_texture, takeDirtyArea()))
+            m_texture.m_resolver = m_impl;
+
         m_texture.m_pixelsFlipped = true;
         m_texture.invalidateMipmap();
+
+        for (std::size_t i = 0; i < m_attachments.size(); ++i)
+        {
+            m_attachments[i].m_pixelsFlipped = true;
+            m_attachments[i].invalidateMipmap();
+        }
     }
 }
 
@@ -174,4 +257,20 @@ const Texture& RenderTexture::getTexture() const
     return m_texture;
 }
 
+
+////////////////////////////////////////////////////////////
+const Texture& RenderTexture::getTexture(unsigned int index) const
+{
+    assert(index < getAttachmentCount());
+
+    return (index == 0) ? m_texture : m_attachments[index - 1];
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getAttachmentCount() const
+{
+    return static_cast<unsigned int>(m_attachments.size() + 1);
+}
+
 } // namespace sf
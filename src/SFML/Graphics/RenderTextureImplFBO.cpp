@@ -26,11 +26,14 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <utility>
 #include <set>
 
@@ -48,8 +51,13 @@ m_colorBuffer               (0),
 m_width                     (0),
 m_height                    (0),
 m_textureId                 (0),
+m_textureIds                (),
 m_multisample               (false),
-m_stencil                   (false)
+m_stencil                   (false),
+m_implicitResolve           (false),
+m_samples                   (0),
+m_resolveArea               (),
+m_memoryUsage               (0)
 {
  
 }
@@ -72,19 +80,15 @@ RenderTextureImplFBO::~RenderTextureImplFBO()
         glCheck(glDeleteRenderbuffers(1, &depthStencilBuffer));
     }
 
+    trackGpuMemory(GpuMemory::Renderbuffers, m_memoryUsage, 0);
+
     // Destroy the framebuffer
     if (m_frameBufferId)
-    {
-        GLuint frameBuffer = static_cast<GLuint>(m_frameBufferId);
-        glCheck(glDeleteFramebuffers(1, &frameBuffer));
-    }
+        getGLStateCache().deleteFramebuffer(static_cast<GLuint>(m_frameBufferId));
 
     // Destroy the multisample framebuffer
     if (m_multisampleFrameBufferId)
-    {
-        GLuint multisampleFrameBufferId = static_cast<GLuint>(m_multisampleFrameBufferId);
-        glCheck(glDeleteFramebuffers(1, &multisampleFrameBufferId));
-    }
+        getGLStateCache().deleteFramebuffer(static_cast<GLuint>(m_multisampleFrameBufferId));
 }
 
 
@@ -97,22 +101,57 @@ unsigned int RenderTextureImplFBO::getMaximumAntialiasingLevel()
 
     glCheck(glGetIntegerv(GL_MAX_SAMPLES, &samples));
 
+#else
+
+    priv::ensureExtensionsInit();
+
+    if (GLAD_GL_EXT_multisampled_render_to_texture)
+        glCheck(glGetIntegerv(GL_MAX_SAMPLES_EXT, &samples));
+
 #endif
 
     return static_cast<unsigned int>(samples);
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int RenderTextureImplFBO::getMaximumAttachmentCount()
+{
+    priv::ensureExtensionsInit();
+
+    // glDrawBuffers is core since OpenGL 2.0 and OpenGL ES 3.0, EXT_draw_buffers provides it on OpenGL ES 2.0
+    if (!glDrawBuffers && !glDrawBuffersEXT)
+        return 1;
+
+    GLint drawBuffers = 0;
+    GLint colorAttachments = 0;
+    glCheck(glGetIntegerv(GL_MAX_DRAW_BUFFERS, &drawBuffers));
+    glCheck(glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &colorAttachments));
+
+    return static_cast<unsigned int>(std::max(1, std::min(drawBuffers, colorAttachments)));
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTextureImplFBO::unbind()
 {
-    glCheck(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    getGLStateCache().bindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsigned int textureId, const ContextSettings& settings)
+bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const ContextSettings& settings)
 {
+    if (textureIds.empty())
+        return false;
+
+    // The multisample resolve only handles a single color buffer
+    if ((textureIds.size() > 1) && settings.antialiasingLevel)
+    {
+        err() << "Impossible to create render texture (anti-aliasing is not supported with multiple color attachments)" << std::endl;
+        return false;
+    }
+
     // Store the dimensions
     m_width = width;
     m_height = height;
@@ -121,7 +160,15 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
         // Make sure that extensions are initialized
         priv::ensureExtensionsInit();
 
-        if (settings.antialiasingLevel && !(GLAD_GL_EXT_framebuffer_multisample && GLAD_GL_EXT_framebuffer_blit))
+#ifdef SFML_OPENGL_ES
+
+        // Tiled GPUs can render to the texture with more samples, and resolve
+        // in tile memory when the pass ends, without any multisample buffer
+        m_implicitResolve = settings.antialiasingLevel && GLAD_GL_EXT_multisampled_render_to_texture;
+
+#endif
+
+        if (settings.antialiasingLevel && !m_implicitResolve && !(GLAD_GL_EXT_framebuffer_multisample && GLAD_GL_EXT_framebuffer_blit))
             return false;
 
         if (settings.stencilBits && !GLAD_GL_EXT_packed_depth_stencil)
@@ -143,10 +190,50 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
             }
         }
 
+#else
+
+        // Check if the requested anti-aliasing level is supported
+        if (m_implicitResolve)
+        {
+            GLint samples = 0;
+            glCheck(glGetIntegerv(GL_MAX_SAMPLES_EXT, &samples));
+
+            if (settings.antialiasingLevel > static_cast<unsigned int>(samples))
+            {
+                err() << "Impossible to create render texture (unsupported anti-aliasing level)";
+                err() << " Requested: " << settings.antialiasingLevel << " Maximum supported: " << samples << std::endl;
+                return false;
+            }
+
+            m_samples = settings.antialiasingLevel;
+        }
+
 #endif // SFML_OPENGL_ES
 
 
-        if (!settings.antialiasingLevel)
+        if (m_implicitResolve)
+        {
+            // The multisample depth buffer must match the samples of the texture attachment
+            if (settings.stencilBits)
+            {
+                err() << "Impossible to create render texture (failed to create the attached multisample depth/stencil buffer)" << std::endl;
+                return false;
+            }
+            else if (settings.depthBits)
+            {
+                GLuint depthStencil = 0;
+                glCheck(glGenRenderbuffers(1, &depthStencil));
+                m_depthStencilBuffer = static_cast<unsigned int>(depthStencil);
+                if (!m_depthStencilBuffer)
+                {
+                    err() << "Impossible to create render texture (failed to create the attached multisample depth buffer)" << std::endl;
+                    return false;
+                }
+                glCheck(glBindRenderbuffer(GL_RENDERBUFFER, m_depthStencilBuffer));
+                glCheck(glRenderbufferStorageMultisampleEXT(GL_RENDERBUFFER, m_samples, GL_DEPTH_COMPONENT16, width, height));
+            }
+        }
+        else if (!settings.antialiasingLevel)
         {
             // Create the depth/stencil buffer if requested
             if (settings.stencilBits)
@@ -248,23 +335,36 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
         }
     }
 
+    // Account the render buffers, the color attachment of the
+    // single-sampled frame buffer is the texture itself
+    Uint64 samples = settings.antialiasingLevel ? settings.antialiasingLevel : 1;
+    Uint64 pixels = static_cast<Uint64>(width) * height * samples;
+    Uint64 memoryUsage = 0;
+
+    if (m_colorBuffer)
+        memoryUsage += pixels * 4;
+
+    if (m_depthStencilBuffer)
+        memoryUsage += pixels * 4;
+
+    trackGpuMemory(GpuMemory::Renderbuffers, m_memoryUsage, memoryUsage);
+    m_memoryUsage = memoryUsage;
+
     // Save our texture ID in order to be able to attach it to an FBO at any time
-    m_textureId = textureId;
+    m_textureId = textureIds[0];
+    m_textureIds = textureIds;
 
 #ifndef SFML_OPENGL_ES
 
     // Save the current bindings so we can restore them after we are done
-    GLint readFramebuffer = 0;
-    GLint drawFramebuffer = 0;
-
-    glCheck(glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer));
-    glCheck(glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer));
+    GLuint readFramebuffer = getGLStateCache().getFramebuffer(GL_READ_FRAMEBUFFER);
+    GLuint drawFramebuffer = getGLStateCache().getFramebuffer(GL_DRAW_FRAMEBUFFER);
 
     if (createFrameBuffer())
     {
         // Restore previously bound framebuffers
-        glCheck(glBindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer));
-        glCheck(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFramebuffer));
+        getGLStateCache().bindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer);
+        getGLStateCache().bindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFramebuffer);
 
         return true;
     }
@@ -272,14 +372,12 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
 #else
 
     // Save the current binding so we can restore them after we are done
-    GLint frameBuffer = 0;
-
-    glCheck(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &frameBuffer));
+    GLuint frameBuffer = getGLStateCache().getFramebuffer(GL_FRAMEBUFFER);
 
     if (createFrameBuffer())
     {
         // Restore previously bound framebuffer
-        glCheck(glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer));
+        getGLStateCache().bindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
 
         return true;
     }
@@ -302,7 +400,7 @@ bool RenderTextureImplFBO::createFrameBuffer()
         err() << "Impossible to create render texture (failed to create the frame buffer object)" << std::endl;
         return false;
     }
-    glCheck(glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer));
+    getGLStateCache().bindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
     
     // Link the depth/stencil renderbuffer to the frame buffer
     if (!m_multisample && m_depthStencilBuffer)
@@ -321,15 +419,38 @@ bool RenderTextureImplFBO::createFrameBuffer()
     }
 
     // Link the texture to the frame buffer
-    glCheck(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_textureId, 0));
+    if (m_implicitResolve)
+        glCheck(glFramebufferTexture2DMultisampleEXT(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_textureId, 0, m_samples));
+    else
+        glCheck(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_textureId, 0));
+
+    // Link the additional textures, and let the fragment shaders write to all of them
+    if (m_textureIds.size() > 1)
+    {
+        std::vector<GLenum> drawBuffers(1, GL_COLOR_ATTACHMENT0);
+
+        for (std::size_t i = 1; i < m_textureIds.size(); ++i)
+        {
+            GLenum attachment = static_cast<GLenum>(GL_COLOR_ATTACHMENT0 + i);
+            glCheck(glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, m_textureIds[i], 0));
+            drawBuffers.push_back(attachment);
+        }
+
+        // The draw buffers are part of the frame buffer state, they only need to be set once
+        GLsizei count = static_cast<GLsizei>(drawBuffers.size());
+        if (glDrawBuffers)
+            glCheck(glDrawBuffers(count, &drawBuffers[0]));
+        else
+            glCheck(glDrawBuffersEXT(count, &drawBuffers[0]));
+    }
 
     // A final check, just to be sure...
     GLenum status;
     glCheck(status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
     if (status != GL_FRAMEBUFFER_COMPLETE)
     {
-        glCheck(glBindFramebuffer(GL_FRAMEBUFFER, 0));
-        glCheck(glDeleteFramebuffers(1, &frameBuffer));
+        getGLStateCache().bindFramebuffer(GL_FRAMEBUFFER, 0);
+        getGLStateCache().deleteFramebuffer(frameBuffer);
         err() << "Impossible to create render texture (failed to link the target texture to the frame buffer)" << std::endl;
         return false;
     }
@@ -349,7 +470,7 @@ bool RenderTextureImplFBO::createFrameBuffer()
             err() << "Impossible to create render texture (failed to create the multisample frame buffer object)" << std::endl;
             return false;
         }
-        glCheck(glBindFramebuffer(GL_FRAMEBUFFER, multisampleFrameBuffer));
+        getGLStateCache().bindFramebuffer(GL_FRAMEBUFFER, multisampleFrameBuffer);
 
         // Link the multisample color buffer to the frame buffer
         glCheck(glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer));
@@ -370,8 +491,8 @@ bool RenderTextureImplFBO::createFrameBuffer()
         glCheck(status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
         if (status != GL_FRAMEBUFFER_COMPLETE)
         {
-            glCheck(glBindFramebuffer(GL_FRAMEBUFFER, 0));
-            glCheck(glDeleteFramebuffers(1, &multisampleFrameBuffer));
+            getGLStateCache().bindFramebuffer(GL_FRAMEBUFFER, 0);
+            getGLStateCache().deleteFramebuffer(multisampleFrameBuffer);
             err() << "Impossible to create render texture (failed to link the render buffers to the multisample frame buffer)" << std::endl;
             return false;
         }
@@ -391,15 +512,22 @@ bool RenderTextureImplFBO::activate(bool active)
     // Unbind the FBO if requested
     if (!active)
     {
-        glCheck(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+        getGLStateCache().bindFramebuffer(GL_FRAMEBUFFER, 0);
+        return true;
     }
-    else
+
+    // With multisampling, everything is drawn to the multisample
+    // FBO and blitted to the texture FBO when the texture is used
+    if (m_multisampleFrameBufferId)
     {
-		if (m_frameBufferId)
-		{
-            glCheck(glBindFramebuffer(GL_FRAMEBUFFER, m_frameBufferId));
-			return true;
-		}
+        getGLStateCache().bindFramebuffer(GL_FRAMEBUFFER, m_multisampleFrameBufferId);
+        return true;
+    }
+
+    if (m_frameBufferId && !m_multisample)
+    {
+        getGLStateCache().bindFramebuffer(GL_FRAMEBUFFER, m_frameBufferId);
+        return true;
     }
 
     return createFrameBuffer();
@@ -407,26 +535,81 @@ bool RenderTextureImplFBO::activate(bool active)
 
 
 ////////////////////////////////////////////////////////////
-void RenderTextureImplFBO::updateTexture(unsigned int)
+bool RenderTextureImplFBO::updateTexture(unsigned int, const IntRect& area)
 {
-    // If multisampling is enabled, we need to resolve by blitting
-    // from our FBO with multisample renderbuffer attachments
-    // to our FBO to which our target texture is attached
+    // Without a multisample FBO, the texture is rendered to directly
+    if (!m_multisample)
+        return false;
 
-#ifndef SFML_OPENGL_ES
+    // Nothing drawn since the previous update: only what is still pending
+    if ((area.width <= 0) || (area.height <= 0))
+        return (m_resolveArea.width > 0) && (m_resolveArea.height > 0);
 
-    // In case of multisampling, make sure both FBOs
-    // are already available within the current context
-    if (m_multisample && m_width && m_height && activate(true))
+    // Defer the blit until the texture is used, merging the areas of
+    // the successive updates so that nothing drawn is ever lost
+    if ((m_resolveArea.width > 0) && (m_resolveArea.height > 0))
     {
-		// Set up the blit target (draw framebuffer) and blit (from the read framebuffer, our multisample FBO)
-		glCheck(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_frameBufferId));
-		glCheck(glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
-		glCheck(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_multisampleFrameBufferId));
+        int left   = std::min(area.left, m_resolveArea.left);
+        int top    = std::min(area.top, m_resolveArea.top);
+        int right  = std::max(area.left + area.width, m_resolveArea.left + m_resolveArea.width);
+        int bottom = std::max(area.top + area.height, m_resolveArea.top + m_resolveArea.height);
+
+        m_resolveArea = IntRect(left, top, right - left, bottom - top);
     }
+    else
+    {
+        m_resolveArea = area;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTextureImplFBO::resolve()
+{
+
+#ifndef SFML_OPENGL_ES
+
+    if (!m_frameBufferId || !m_multisampleFrameBufferId || (m_resolveArea.width <= 0) || (m_resolveArea.height <= 0))
+        return;
+
+    GLStateCache& cache = getGLStateCache();
+
+    // Save the current bindings so we can restore them after we are done
+    GLuint readFramebuffer = cache.getFramebuffer(GL_READ_FRAMEBUFFER);
+    GLuint drawFramebuffer = cache.getFramebuffer(GL_DRAW_FRAMEBUFFER);
+
+    // The area has its origin at the top-left corner, frame buffers at the bottom-left one
+    GLint left   = m_resolveArea.left;
+    GLint right  = m_resolveArea.left + m_resolveArea.width;
+    GLint bottom = static_cast<GLint>(m_height) - (m_resolveArea.top + m_resolveArea.height);
+    GLint top    = static_cast<GLint>(m_height) - m_resolveArea.top;
+
+    // The blit would be clipped by the scissor rectangle of the active target
+    bool scissor = cache.isEnabled(GL_SCISSOR_TEST);
+    cache.setEnabled(GL_SCISSOR_TEST, false);
+
+    // Blit from our multisample FBO to the FBO to which our target texture is attached
+    cache.bindFramebuffer(GL_READ_FRAMEBUFFER, m_multisampleFrameBufferId);
+    cache.bindFramebuffer(GL_DRAW_FRAMEBUFFER, m_frameBufferId);
+    glCheck(glBlitFramebuffer(left, bottom, right, top, left, bottom, right, top, GL_COLOR_BUFFER_BIT, GL_NEAREST));
+
+    // Restore previously bound framebuffers
+    cache.bindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer);
+    cache.bindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFramebuffer);
+    cache.setEnabled(GL_SCISSOR_TEST, scissor);
 
 #endif // SFML_OPENGL_ES
 
+    m_resolveArea = IntRect();
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::needsDirtyArea() const
+{
+    return m_multisample;
 }
 
 } // namespace priv
@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct RenderTexturePool::Entry
+{
+    RenderTexture   texture;  ///< Pooled render texture
+    unsigned int    width;    ///< Width the render texture was created with
+    unsigned int    height;   ///< Height the render texture was created with
+    ContextSettings settings; ///< Settings the render texture was created with
+    bool            inUse;    ///< Is the render texture acquired?
+    Uint64          lastUsed; ///< Last frame the render texture was acquired in
+
+    bool matches(unsigned int w, unsigned int h, const ContextSettings& s) const
+    {
+        return (width == w) && (height == h) &&
+               (settings.depthBits == s.depthBits) &&
+               (settings.stencilBits == s.stencilBits) &&
+               (settings.antialiasingLevel == s.antialiasingLevel) &&
+               (settings.sRgbCapable == s.sRgbCapable);
+    }
+};
+
+
+////////////////////////////////////////////////////////////
+RenderTexturePool::RenderTexturePool() :
+m_entries  (),
+m_frame    (0),
+m_idleLimit(4)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexturePool::~RenderTexturePool()
+{
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexture* RenderTexturePool::acquire(unsigned int width, unsigned int height, const ContextSettings& settings)
+{
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        Entry& entry = *m_entries[i];
+        if (entry.inUse || !entry.matches(width, height, settings))
+            continue;
+
+        entry.inUse = true;
+        entry.lastUsed = m_frame;
+
+        // Hand the target over like a new one, except for its contents
+        entry.texture.setView(entry.texture.getDefaultView());
+        entry.texture.setScissor(IntRect());
+        entry.texture.setSmooth(false);
+        entry.texture.setRepeated(false);
+
+        return &entry.texture;
+    }
+
+    // No free target matches: create a new one
+    Entry* entry = new Entry;
+    if (!entry->texture.create(width, height, settings))
+    {
+        delete entry;
+        return NULL;
+    }
+
+    entry->width = width;
+    entry->height = height;
+    entry->settings = settings;
+    entry->inUse = true;
+    entry->lastUsed = m_frame;
+
+    m_entries.push_back(entry);
+
+    return &entry->texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::release(RenderTexture& texture)
+{
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        if (&m_entries[i]->texture == &texture)
+        {
+            m_entries[i]->inUse = false;
+            return;
+        }
+    }
+
+    err() << "Failed to release render texture, it doesn't belong to the pool" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::endFrame()
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        Entry* entry = m_entries[i];
+
+        // Destroy the targets that nobody asked for lately
+        if (m_frame - entry->lastUsed >= m_idleLimit)
+        {
+            delete entry;
+            continue;
+        }
+
+        entry->inUse = false;
+        m_entries[count++] = entry;
+    }
+
+    m_entries.resize(count);
+    ++m_frame;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::setIdleLimit(unsigned int frames)
+{
+    m_idleLimit = frames;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTexturePool::getIdleLimit() const
+{
+    return m_idleLimit;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getCount() const
+{
+    return m_entries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getUsedCount() const
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        if (m_entries[i]->inUse)
+            ++count;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::clear()
+{
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+        delete m_entries[i];
+
+    m_entries.clear();
+}
+
+} // namespace sf
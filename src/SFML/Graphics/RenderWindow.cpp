@@ -28,24 +28,163 @@
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/System/Trace.hpp>
+#include <algorithm>
+#include <thread>
+
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+    #include <emscripten/threading.h>
+#endif
+
+
+namespace
+{
+    // Fences bound the frames in flight (WebGL can't wait on them)
+    bool isFenceAvailable()
+    {
+        return sf::priv::getGraphicsCaps().fenceSync;
+    }
+
+    // Operating systems wake sleeping threads late, spin over the last part of the wait
+    const sf::Time spinMargin = sf::milliseconds(2);
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-RenderWindow::RenderWindow(int w, int h)
-: m_screenSize(Vector2u(w, h))
+RenderWindow::RenderWindow(int w, int h) :
+m_screenSize       (Vector2u(w, h)),
+m_swapCallback     (NULL),
+m_swapUserData     (NULL),
+m_frameTimeLimit   (Time::Zero),
+m_maxFramesInFlight(0),
+m_fenceIndex       (0),
+m_presentClock     (),
+m_presentInterval  (Time::Zero),
+m_swapDuration     (Time::Zero),
+m_waitDuration     (Time::Zero)
 {
-    // Nothing to do
+    for (unsigned int i = 0; i < MaxFramesInFlight; ++i)
+        m_fences[i] = NULL;
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderWindow::~RenderWindow()
 {
-    // Nothing to do
+    clearFences();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::display()
+{
+    SFML_TRACE_SCOPE("RenderWindow::display");
+
+    // Submit the frame
+    endPass();
+
+    Clock waitClock;
+
+    if (m_maxFramesInFlight > 0)
+    {
+        if (isFenceAvailable())
+        {
+            // The fence in this slot was inserted after the swap m_maxFramesInFlight frames ago
+            GLsync fence = static_cast<GLsync>(m_fences[m_fenceIndex]);
+            if (fence)
+            {
+                glCheck(glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull));
+                glCheck(glDeleteSync(fence));
+                m_fences[m_fenceIndex] = NULL;
+            }
+        }
+        else
+        {
+            // At least let the GPU start on the frame before the swap
+            glCheck(glFlush());
+        }
+    }
+
+    waitFrameLimit();
+
+    m_waitDuration = waitClock.getElapsedTime();
+
+    if (m_swapCallback)
+    {
+        Clock swapClock;
+        m_swapCallback(m_swapUserData);
+        m_swapDuration = swapClock.getElapsedTime();
+    }
+
+    m_presentInterval = m_presentClock.restart();
+
+    StartupStats& startup = priv::getStartupStats();
+    if (startup.firstFrameTime == Time::Zero)
+        startup.firstFrameTime = priv::getTimeSinceStartup();
+
+    if ((m_maxFramesInFlight > 0) && isFenceAvailable())
+    {
+        GLsync fence;
+        glCheck(fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        m_fences[m_fenceIndex] = fence;
+        m_fenceIndex = (m_fenceIndex + 1) % m_maxFramesInFlight;
+    }
+
+    // Start the next frame: counters, texture use stamps and frame arena
+    resetFrameStats();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::setSwapCallback(SwapCallback callback, void* userData)
+{
+    m_swapCallback = callback;
+    m_swapUserData = userData;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::setFramerateLimit(unsigned int limit)
+{
+    m_frameTimeLimit = (limit > 0) ? microseconds(1000000 / limit) : Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::setMaxFramesInFlight(unsigned int frames)
+{
+    // The slots of the fences depend on the limit, start over
+    clearFences();
+
+    m_maxFramesInFlight = std::min<unsigned int>(frames, MaxFramesInFlight);
+}
+
+
+////////////////////////////////////////////////////////////
+Time RenderWindow::getPresentInterval() const
+{
+    return m_presentInterval;
+}
+
+
+////////////////////////////////////////////////////////////
+Time RenderWindow::getSwapDuration() const
+{
+    return m_swapDuration;
+}
+
+
+////////////////////////////////////////////////////////////
+Time RenderWindow::getWaitDuration() const
+{
+    return m_waitDuration;
 }
 
 
@@ -60,6 +199,9 @@ Vector2u RenderWindow::getSize() const
 ////////////////////////////////////////////////////////////
 bool RenderWindow::setActive(bool active)
 {
+    // Submit pending draws before the frame buffer binding changes
+    priv::flushPendingDraws();
+
     bool result = RenderTarget::setActive(active);
 
     // If FBOs are available, make sure none are bound when we
@@ -76,15 +218,39 @@ bool RenderWindow::setActive(bool active)
 
 
 ////////////////////////////////////////////////////////////
-Image RenderWindow::toImage()
+Image RenderWindow::capture()
 {
     Vector2u windowSize = getSize();
 
-    Texture texture;
-    texture.create(windowSize.x, windowSize.y);
-    toTexture(texture);
+    Image image;
+    if ((windowSize.x == 0) || (windowSize.y == 0))
+        return image;
+
+    // Make sure that the back-buffer contains all the pending draws
+    priv::flushPendingDraws();
 
-    return texture.copyToImage();
+    // Read the back-buffer of the window, even if a render texture is bound
+    std::vector<Uint8> pixels(windowSize.x * windowSize.y * 4);
+    priv::GLStateCache& cache = priv::getGLStateCache();
+    GLuint previousFrameBuffer = cache.getFramebuffer(GL_FRAMEBUFFER);
+
+    cache.bindFramebuffer(GL_FRAMEBUFFER, 0);
+    glCheck(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+    glCheck(glReadPixels(0, 0, windowSize.x, windowSize.y, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
+    cache.bindFramebuffer(GL_FRAMEBUFFER, previousFrameBuffer);
+
+    // OpenGL rows go from bottom to top
+    image.create(windowSize.x, windowSize.y, &pixels[0]);
+    image.flipVertically();
+
+    return image;
+}
+
+
+////////////////////////////////////////////////////////////
+Image RenderWindow::toImage()
+{
+    return capture();
 }
 
 
@@ -105,11 +271,14 @@ void RenderWindow::toTexture(const Texture& texture, unsigned int x, unsigned in
     
     if (texture.getNativeHandle())// && setActive(true))
     {
+        // Make sure that the back-buffer contains all the pending draws
+        priv::flushPendingDraws();
+
         // Make sure that the current texture binding will be preserved
         priv::TextureSaver save;
 
         // Copy pixels from the back-buffer to the texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, texture.getNativeHandle()));
+        priv::getGLStateCache().bindTexture(texture.getNativeHandle());
         glCheck(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x, y, 0, 0, getSize().x, getSize().y));
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, texture.isSmooth() ? GL_LINEAR : GL_NEAREST));
 
@@ -138,4 +307,41 @@ void RenderWindow::onResize(int w, int h)
     setView(getView());
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderWindow::waitFrameLimit()
+{
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+    // The browser main thread must never block, a web worker can
+    if (emscripten_is_main_browser_thread())
+        return;
+#endif
+
+    if (m_frameTimeLimit == Time::Zero)
+        return;
+
+    Time remaining = m_frameTimeLimit - m_presentClock.getElapsedTime();
+    if (remaining > spinMargin)
+        std::this_thread::sleep_for((remaining - spinMargin).toDuration());
+
+    while (m_presentClock.getElapsedTime() < m_frameTimeLimit)
+        std::this_thread::yield();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::clearFences()
+{
+    for (unsigned int i = 0; i < MaxFramesInFlight; ++i)
+    {
+        if (m_fences[i])
+        {
+            glCheck(glDeleteSync(static_cast<GLsync>(m_fences[i])));
+            m_fences[i] = NULL;
+        }
+    }
+
+    m_fenceIndex = 0;
+}
+
 } // namespace sf
@@ -0,0 +1,435 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ResourceLoader.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Fences hand the uploads over to the render context (WebGL has no shared contexts)
+    bool isFenceAvailable()
+    {
+        return sf::priv::getGraphicsCaps().fenceSync;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ResourceLoader::ResourceLoader(unsigned int threadCount) :
+m_contextCallback(NULL),
+m_contextUserData(NULL),
+m_pendingCount   (0),
+m_nextToken      (1),
+m_stop           (false)
+{
+    // Leave a core to the render thread
+    if (threadCount == 0)
+        threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+    for (unsigned int i = 0; i < threadCount; ++i)
+        m_workers.push_back(std::thread(&ResourceLoader::runWorker, this));
+}
+
+
+////////////////////////////////////////////////////////////
+ResourceLoader::~ResourceLoader()
+{
+    {
+        Lock lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+
+    for (std::size_t i = 0; i < m_workers.size(); ++i)
+        m_workers[i].join();
+
+    if (m_uploader.joinable())
+        m_uploader.join();
+
+    // Abandon the loads that are not finished
+    std::deque<Job*>* queues[] = {&m_decodeQueue, &m_uploadQueue, &m_fenceQueue, &m_compileQueue};
+    for (std::size_t i = 0; i < sizeof(queues) / sizeof(*queues); ++i)
+    {
+        for (std::deque<Job*>::iterator it = queues[i]->begin(); it != queues[i]->end(); ++it)
+        {
+            if ((*it)->pixels)
+                priv::ImageLoader::getInstance().freeDecodedPixels((*it)->pixels, (*it)->size);
+
+            if ((*it)->fence)
+                glCheck(glDeleteSync(static_cast<GLsync>((*it)->fence)));
+
+            delete *it;
+        }
+    }
+
+    for (std::size_t i = 0; i < m_compiling.size(); ++i)
+        delete m_compiling[i];
+}
+
+
+////////////////////////////////////////////////////////////
+void ResourceLoader::setUploadContext(ContextCallback callback, void* userData)
+{
+#if defined(SFML_SYSTEM_EMSCRIPTEN)
+
+    err() << "Failed to start the upload thread (shared contexts are not supported with WebGL)" << std::endl;
+
+#else
+
+    if (m_uploader.joinable())
+    {
+        err() << "Failed to start the upload thread (the upload context is already set)" << std::endl;
+        return;
+    }
+
+    if (!callback)
+        return;
+
+    m_contextCallback = callback;
+    m_contextUserData = userData;
+    m_uploader = std::thread(&ResourceLoader::runUploader, this);
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 ResourceLoader::loadTexture(Texture& texture, const void* data, std::size_t sizeInBytes)
+{
+    Job* job = new Job;
+    job->type     = TextureJob;
+    job->resource = &texture;
+    job->data     = data;
+    job->dataSize = sizeInBytes;
+
+    return push(job);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 ResourceLoader::loadFont(Font& font, const void* data, std::size_t sizeInBytes)
+{
+    Job* job = new Job;
+    job->type     = FontJob;
+    job->resource = &font;
+    job->data     = data;
+    job->dataSize = sizeInBytes;
+
+    return push(job);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 ResourceLoader::loadShader(Shader& shader, const std::string& vertexShader, const std::string& fragmentShader)
+{
+    Job* job = new Job;
+    job->type           = ShaderJob;
+    job->resource       = &shader;
+    job->data           = NULL;
+    job->dataSize       = 0;
+    job->vertexShader   = vertexShader;
+    job->fragmentShader = fragmentShader;
+
+    return push(job);
+}
+
+
+////////////////////////////////////////////////////////////
+void ResourceLoader::update(Time budget)
+{
+    std::vector<Job*> compiles;
+
+    {
+        Lock lock(m_mutex);
+
+        // Complete the uploads of the upload thread, in the order they were submitted
+        while (!m_fenceQueue.empty())
+        {
+            Job* job = m_fenceQueue.front();
+            GLsync fence = static_cast<GLsync>(job->fence);
+
+            GLenum result;
+            glCheck(result = glClientWaitSync(fence, 0, 0));
+            if (result == GL_TIMEOUT_EXPIRED)
+                break;
+
+            glCheck(glDeleteSync(fence));
+            job->fence = NULL;
+            m_fenceQueue.pop_front();
+            finish(job, result != GL_WAIT_FAILED);
+        }
+
+        compiles.assign(m_compileQueue.begin(), m_compileQueue.end());
+        m_compileQueue.clear();
+    }
+
+    // Start the new shader compilations, and poll the running ones
+    for (std::size_t i = 0; i < compiles.size(); ++i)
+    {
+        Job* job = compiles[i];
+        Shader* shader = static_cast<Shader*>(job->resource);
+        if (shader->loadFromMemoryAsync(job->vertexShader.c_str(), job->fragmentShader.c_str()))
+        {
+            m_compiling.push_back(job);
+        }
+        else
+        {
+            Lock lock(m_mutex);
+            finish(job, false);
+        }
+    }
+
+    for (std::size_t i = 0; i < m_compiling.size();)
+    {
+        Job* job = m_compiling[i];
+        Shader* shader = static_cast<Shader*>(job->resource);
+        if (shader->isReady())
+        {
+            m_compiling.erase(m_compiling.begin() + i);
+
+            Lock lock(m_mutex);
+            finish(job, shader->getNativeHandle() != 0);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    // Without an upload thread, upload the decoded textures ourselves
+    if (m_uploader.joinable())
+        return;
+
+    Clock clock;
+    do
+    {
+        Job* job;
+        {
+            Lock lock(m_mutex);
+            if (m_uploadQueue.empty())
+                return;
+
+            job = m_uploadQueue.front();
+            m_uploadQueue.pop_front();
+        }
+
+        bool success = upload(*job);
+
+        Lock lock(m_mutex);
+        finish(job, success);
+    }
+    while (clock.getElapsedTime() < budget);
+}
+
+
+////////////////////////////////////////////////////////////
+ResourceLoader::Status ResourceLoader::getStatus(Uint64 token) const
+{
+    Lock lock(m_mutex);
+
+    std::map<Uint64, Status>::const_iterator it = m_statuses.find(token);
+    return (it != m_statuses.end()) ? it->second : Failed;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ResourceLoader::getPendingCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_pendingCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 ResourceLoader::push(Job* job)
+{
+    job->pixels = NULL;
+    job->fence  = NULL;
+
+    {
+        Lock lock(m_mutex);
+
+        job->token = m_nextToken++;
+        m_statuses[job->token] = Pending;
+        ++m_pendingCount;
+
+        // Shaders have nothing to decode, they only need the render thread
+        if (job->type == ShaderJob)
+            m_compileQueue.push_back(job);
+        else
+            m_decodeQueue.push_back(job);
+    }
+    m_condition.notify_all();
+
+    return job->token;
+}
+
+
+////////////////////////////////////////////////////////////
+void ResourceLoader::finish(Job* job, bool success)
+{
+    if (job->pixels)
+        priv::ImageLoader::getInstance().freeDecodedPixels(job->pixels, job->size);
+
+    m_statuses[job->token] = success ? Ready : Failed;
+    --m_pendingCount;
+
+    delete job;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ResourceLoader::upload(Job& job)
+{
+    Texture* texture = static_cast<Texture*>(job.resource);
+    if (!texture->create(job.size.x, job.size.y))
+        return false;
+
+    texture->update(job.pixels);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ResourceLoader::runWorker()
+{
+    for (;;)
+    {
+        Job* job;
+        {
+            Lock lock(m_mutex);
+
+            while (!m_stop && m_decodeQueue.empty())
+                m_condition.wait(m_mutex);
+
+            if (m_stop)
+                return;
+
+            job = m_decodeQueue.front();
+            m_decodeQueue.pop_front();
+        }
+
+        bool success;
+        if (job->type == TextureJob)
+        {
+            job->pixels = priv::ImageLoader::getInstance().decodeImageFromMemory(job->data, job->dataSize, job->size);
+            success = (job->pixels != NULL);
+
+            if (success && static_cast<Texture*>(job->resource)->isPremultipliedAlpha())
+                priv::ImageLoader::premultiplyAlpha(job->pixels, static_cast<std::size_t>(job->size.x) * job->size.y);
+        }
+        else
+        {
+            success = static_cast<Font*>(job->resource)->loadFromMemory(job->data, job->dataSize);
+        }
+
+        {
+            Lock lock(m_mutex);
+
+            if (success && (job->type == TextureJob))
+                m_uploadQueue.push_back(job);
+            else
+                finish(job, success);
+        }
+        m_condition.notify_all();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ResourceLoader::runUploader()
+{
+    m_contextCallback(true, m_contextUserData);
+
+    const bool fenceAvailable = isFenceAvailable();
+
+    for (;;)
+    {
+        Job* job;
+        {
+            Lock lock(m_mutex);
+
+            while (!m_stop && m_uploadQueue.empty())
+                m_condition.wait(m_mutex);
+
+            if (m_stop)
+                break;
+
+            job = m_uploadQueue.front();
+            m_uploadQueue.pop_front();
+        }
+
+        bool success = upload(*job);
+
+        // Without fences, wait for the upload here so that the render context never does
+        if (success && fenceAvailable)
+        {
+            GLsync fence;
+            glCheck(fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+            glCheck(glFlush());
+            job->fence = fence;
+        }
+        else
+        {
+            glCheck(glFinish());
+        }
+
+        Lock lock(m_mutex);
+        if (job->fence)
+        {
+            // The pixels are in the driver already
+            priv::ImageLoader::getInstance().freeDecodedPixels(job->pixels, job->size);
+            job->pixels = NULL;
+            m_fenceQueue.push_back(job);
+        }
+        else
+        {
+            finish(job, success);
+        }
+    }
+
+    // Destroy the pipeline and the state shadow of the upload context before it goes away
+    RenderTarget::releaseContext();
+
+    m_contextCallback(false, m_contextUserData);
+}
+
+} // namespace sf
@@ -0,0 +1,357 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SceneGrid.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Items covering more cells than this are kept out of the grid
+    const int maxItemCells = 64;
+
+    // Cells are kept in [-limit, limit] to avoid overflows with huge coordinates
+    const float cellLimit = 1073741824.f; // 2^30
+
+    // Build the key of a cell; the keys of a row are contiguous and ordered by column
+    sf::Uint64 getCellKey(int column, int row)
+    {
+        const sf::Uint32 x = static_cast<sf::Uint32>(column) ^ 0x80000000u;
+        const sf::Uint32 y = static_cast<sf::Uint32>(row) ^ 0x80000000u;
+        return (static_cast<sf::Uint64>(y) << 32) | x;
+    }
+
+    // Unlike FloatRect::intersects, accept flat rectangles (lines, points)
+    bool overlaps(const sf::FloatRect& a, const sf::FloatRect& b)
+    {
+        return (a.left <= b.left + b.width) && (b.left <= a.left + a.width) &&
+               (a.top <= b.top + b.height) && (b.top <= a.top + a.height);
+    }
+
+    // Remove a value from an unordered vector
+    void eraseValue(std::vector<std::size_t>& values, std::size_t value)
+    {
+        std::vector<std::size_t>::iterator it = std::find(values.begin(), values.end(), value);
+        if (it != values.end())
+        {
+            *it = values.back();
+            values.pop_back();
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SceneGrid::SceneGrid(float cellSize) :
+m_cellSize    (cellSize > 0.f ? cellSize : 256.f),
+m_items       (),
+m_freeItems   (),
+m_cells       (),
+m_unsorted    (),
+m_nextSequence(0),
+m_queryMark   (0),
+m_found       (),
+m_visible     ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SceneGrid::ItemId SceneGrid::insert(const Drawable& drawable, int layer)
+{
+    FloatRect bounds;
+    bool bounded = drawable.getCullingBounds(bounds);
+
+    return add(drawable, bounds, bounded, layer);
+}
+
+
+////////////////////////////////////////////////////////////
+SceneGrid::ItemId SceneGrid::insert(const Drawable& drawable, const FloatRect& bounds, int layer)
+{
+    return add(drawable, bounds, true, layer);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGrid::update(ItemId item)
+{
+    if ((item >= m_items.size()) || !m_items[item].drawable)
+        return;
+
+    FloatRect bounds;
+    if (m_items[item].drawable->getCullingBounds(bounds))
+        update(item, bounds);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGrid::update(ItemId item, const FloatRect& bounds)
+{
+    if ((item >= m_items.size()) || !m_items[item].drawable)
+        return;
+
+    Item& entry = m_items[item];
+
+    // Nothing to move if the item stays in the same cells
+    if (entry.inGrid)
+    {
+        CellRange cells = getCellRange(bounds);
+        if ((cells.left == entry.cells.left) && (cells.top == entry.cells.top) &&
+            (cells.right == entry.cells.right) && (cells.bottom == entry.cells.bottom))
+        {
+            entry.bounds = bounds;
+            return;
+        }
+    }
+
+    unlink(item);
+    entry.bounds = bounds;
+    entry.bounded = true;
+    link(item);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGrid::remove(ItemId item)
+{
+    if ((item >= m_items.size()) || !m_items[item].drawable)
+        return;
+
+    unlink(item);
+    m_items[item].drawable = NULL;
+    m_freeItems.push_back(item);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGrid::clear()
+{
+    m_items.clear();
+    m_freeItems.clear();
+    m_cells.clear();
+    m_unsorted.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SceneGrid::getItemCount() const
+{
+    return m_items.size() - m_freeItems.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGrid::query(const FloatRect& area, std::vector<const Drawable*>& result) const
+{
+    result.clear();
+    m_found.clear();
+
+    // Each item is reported once, even if it's stored in several of the cells
+    if (++m_queryMark == 0)
+    {
+        for (std::size_t i = 0; i < m_items.size(); ++i)
+            m_items[i].mark = 0;
+
+        m_queryMark = 1;
+    }
+
+    // Visit the non-empty cells of each row covered by the area, or
+    // all the non-empty cells if there are fewer of them than rows
+    const CellRange cells = getCellRange(area);
+    const bool allCells = static_cast<Uint64>(cells.bottom - cells.top + 1) > m_cells.size();
+    for (int row = cells.top; row <= cells.bottom; ++row)
+    {
+        CellTable::const_iterator cell = allCells ? m_cells.begin() : m_cells.lower_bound(getCellKey(cells.left, row));
+        const Uint64 last = getCellKey(cells.right, row);
+        for (; (cell != m_cells.end()) && (allCells || (cell->first <= last)); ++cell)
+        {
+            for (std::size_t i = 0; i < cell->second.size(); ++i)
+            {
+                const ItemId id = cell->second[i];
+                const Item& item = m_items[id];
+                if (item.mark != m_queryMark)
+                {
+                    item.mark = m_queryMark;
+                    if (overlaps(item.bounds, area))
+                        m_found.push_back(id);
+                }
+            }
+        }
+
+        if (allCells)
+            break;
+    }
+
+    // Items outside the cells are always tested
+    for (std::size_t i = 0; i < m_unsorted.size(); ++i)
+    {
+        const Item& item = m_items[m_unsorted[i]];
+        if (!item.bounded || overlaps(item.bounds, area))
+            m_found.push_back(m_unsorted[i]);
+    }
+
+    // Sort by layer, then by insertion order
+    const std::vector<Item>& items = m_items;
+    std::sort(m_found.begin(), m_found.end(), [&items](ItemId left, ItemId right)
+    {
+        if (items[left].layer != items[right].layer)
+            return items[left].layer < items[right].layer;
+
+        return items[left].sequence < items[right].sequence;
+    });
+
+    result.reserve(m_found.size());
+    for (std::size_t i = 0; i < m_found.size(); ++i)
+        result.push_back(m_items[m_found[i]].drawable);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGrid::draw(RenderTarget& target, RenderStates states) const
+{
+    // Area covered by the view, in the coordinate system of the grid
+    FloatRect area = target.getView().getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+    if (states.transform != Transform::Identity)
+        area = states.transform.getInverse().transformRect(area);
+
+    query(area, m_visible);
+
+    for (std::size_t i = 0; i < m_visible.size(); ++i)
+        target.draw(*m_visible[i], states);
+}
+
+
+////////////////////////////////////////////////////////////
+SceneGrid::ItemId SceneGrid::add(const Drawable& drawable, const FloatRect& bounds, bool bounded, int layer)
+{
+    ItemId id;
+    if (!m_freeItems.empty())
+    {
+        id = m_freeItems.back();
+        m_freeItems.pop_back();
+    }
+    else
+    {
+        id = m_items.size();
+        m_items.push_back(Item());
+    }
+
+    Item& item = m_items[id];
+    item.drawable = &drawable;
+    item.bounds = bounds;
+    item.bounded = bounded;
+    item.layer = layer;
+    item.sequence = m_nextSequence++;
+    item.inGrid = false;
+    item.mark = 0;
+
+    link(id);
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGrid::link(ItemId item)
+{
+    Item& entry = m_items[item];
+
+    if (entry.bounded)
+    {
+        const CellRange cells = getCellRange(entry.bounds);
+        const Int64 count = static_cast<Int64>(cells.right - cells.left + 1) * (cells.bottom - cells.top + 1);
+        if (count <= maxItemCells)
+        {
+            for (int row = cells.top; row <= cells.bottom; ++row)
+            {
+                for (int column = cells.left; column <= cells.right; ++column)
+                    m_cells[getCellKey(column, row)].push_back(item);
+            }
+
+            entry.cells = cells;
+            entry.inGrid = true;
+            return;
+        }
+    }
+
+    // Unbounded or too large for the grid
+    m_unsorted.push_back(item);
+    entry.inGrid = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGrid::unlink(ItemId item)
+{
+    Item& entry = m_items[item];
+
+    if (!entry.inGrid)
+    {
+        eraseValue(m_unsorted, item);
+        return;
+    }
+
+    for (int row = entry.cells.top; row <= entry.cells.bottom; ++row)
+    {
+        for (int column = entry.cells.left; column <= entry.cells.right; ++column)
+        {
+            CellTable::iterator cell = m_cells.find(getCellKey(column, row));
+            if (cell == m_cells.end())
+                continue;
+
+            eraseValue(cell->second, item);
+            if (cell->second.empty())
+                m_cells.erase(cell);
+        }
+    }
+
+    entry.inGrid = false;
+}
+
+
+////////////////////////////////////////////////////////////
+SceneGrid::CellRange SceneGrid::getCellRange(const FloatRect& rectangle) const
+{
+    const float left   = std::min(rectangle.left, rectangle.left + rectangle.width);
+    const float top    = std::min(rectangle.top, rectangle.top + rectangle.height);
+    const float right  = std::max(rectangle.left, rectangle.left + rectangle.width);
+    const float bottom = std::max(rectangle.top, rectangle.top + rectangle.height);
+
+    CellRange cells;
+    cells.left   = static_cast<int>(std::max(-cellLimit, std::min(cellLimit, std::floor(left / m_cellSize))));
+    cells.top    = static_cast<int>(std::max(-cellLimit, std::min(cellLimit, std::floor(top / m_cellSize))));
+    cells.right  = static_cast<int>(std::max(-cellLimit, std::min(cellLimit, std::floor(right / m_cellSize))));
+    cells.bottom = static_cast<int>(std::max(-cellLimit, std::min(cellLimit, std::floor(bottom / m_cellSize))));
+
+    return cells;
+}
+
+} // namespace sf
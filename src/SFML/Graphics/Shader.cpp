@@ -30,10 +30,18 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/ContextRestore.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/ShaderCache.hpp>
+#include <SFML/Graphics/UniformBuffer.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Trace.hpp>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <vector>
 
@@ -97,55 +105,137 @@ namespace
         }
     }
 
-    // Transforms an array of 2D vectors into a contiguous array of scalars
-    template <typename T>
-    std::vector<T> flatten(const sf::Vector2<T>* vectorArray, std::size_t length)
-    {
-        const std::size_t vectorSize = 2;
+    // The arrays of GLSL types are passed to OpenGL as they are, without being flattened first
+    static_assert(sizeof(sf::Glsl::Vec2) == 2 * sizeof(float), "Glsl::Vec2 must be tightly packed");
+    static_assert(sizeof(sf::Glsl::Vec3) == 3 * sizeof(float), "Glsl::Vec3 must be tightly packed");
+    static_assert(sizeof(sf::Glsl::Vec4) == 4 * sizeof(float), "Glsl::Vec4 must be tightly packed");
+    static_assert(sizeof(sf::Glsl::Mat3) == 3 * 3 * sizeof(float), "Glsl::Mat3 must be tightly packed");
+    static_assert(sizeof(sf::Glsl::Mat4) == 4 * 4 * sizeof(float), "Glsl::Mat4 must be tightly packed");
+
+    // Cache used to save and restore linked programs
+    sf::ShaderCache* shaderCache = NULL;
 
-        std::vector<T> contiguous(vectorSize * length);
-        for (std::size_t i = 0; i < length; ++i)
+    // Header of the cached program binaries
+    const sf::Uint32 programBinaryMagic = 0x42504653; // "SFPB"
+    const std::size_t programBinaryHeaderSize = 16;   // magic, format, key
+
+    // Feed a string (including its terminator) to a FNV-1a hash
+    void hashString(sf::Uint64& hash, const char* string)
+    {
+        // Hash a marker instead of nothing for missing shader stages
+        const char* bytes = string ? string : "\x01";
+        do
         {
-            contiguous[vectorSize * i]     = vectorArray[i].x;
-            contiguous[vectorSize * i + 1] = vectorArray[i].y;
+            hash ^= static_cast<sf::Uint8>(*bytes);
+            hash *= 1099511628211ULL;
         }
+        while (*bytes++);
+    }
+
+    // Compute the key of a program in the cache
+    sf::Uint64 getProgramKey(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode,
+                             const std::vector<std::string>& attributes)
+    {
+        sf::Uint64 hash = 14695981039346656037ULL;
+        hashString(hash, vertexShaderCode);
+        hashString(hash, geometryShaderCode);
+        hashString(hash, fragmentShaderCode);
 
-        return contiguous;
+        for (std::size_t i = 0; i < attributes.size(); ++i)
+            hashString(hash, attributes[i].c_str());
+
+        // Binaries are only valid for the driver that produced them
+        hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+        hashString(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+        hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+        return hash;
     }
 
-    // Transforms an array of 3D vectors into a contiguous array of scalars
-    template <typename T>
-    std::vector<T> flatten(const sf::Vector3<T>* vectorArray, std::size_t length)
+    // Assign the built-in sf_Frame block of a linked program to its binding point
+    void bindFrameBlock(GLuint program)
     {
-        const std::size_t vectorSize = 3;
+        if (!sf::UniformBuffer::isAvailable())
+            return;
+
+        GLuint index;
+        glCheck(index = glGetUniformBlockIndex(program, "sf_Frame"));
+        if (index != GL_INVALID_INDEX)
+            glCheck(glUniformBlockBinding(program, index, sf::UniformBuffer::FrameBinding));
+    }
 
-        std::vector<T> contiguous(vectorSize * length);
-        for (std::size_t i = 0; i < length; ++i)
+    // Create a program from a binary made by readProgramBinary, returns 0 if not possible
+    GLuint createProgramFromBinary(const std::vector<sf::Uint8>& data, sf::Uint64 key)
+    {
+        if (data.size() <= programBinaryHeaderSize)
+            return 0;
+
+        sf::Uint32 magic;
+        sf::Uint32 format;
+        sf::Uint64 storedKey;
+        std::memcpy(&magic, &data[0], sizeof(magic));
+        std::memcpy(&format, &data[4], sizeof(format));
+        std::memcpy(&storedKey, &data[8], sizeof(storedKey));
+        if ((magic != programBinaryMagic) || (storedKey != key))
+            return 0;
+
+        GLuint program;
+        glCheck(program = glCreateProgram());
+        sf::priv::programBinary(program, format, &data[programBinaryHeaderSize],
+                                static_cast<GLsizei>(data.size() - programBinaryHeaderSize));
+
+        // The driver refuses binaries made by other versions of itself
+        GLint success = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (success == GL_FALSE)
         {
-            contiguous[vectorSize * i]     = vectorArray[i].x;
-            contiguous[vectorSize * i + 1] = vectorArray[i].y;
-            contiguous[vectorSize * i + 2] = vectorArray[i].z;
+            glCheck(glDeleteProgram(program));
+            return 0;
         }
 
-        return contiguous;
+        return program;
     }
 
-    // Transforms an array of 4D vectors into a contiguous array of scalars
-    template <typename T>
-    std::vector<T> flatten(const sf::priv::Vector4<T>* vectorArray, std::size_t length)
+    // Create a program from its cached binary, returns 0 if not possible
+    GLuint loadProgramBinary(sf::Uint64 key)
     {
-        const std::size_t vectorSize = 4;
+        std::vector<sf::Uint8> data;
+        if (!shaderCache->load(key, data))
+            return 0;
 
-        std::vector<T> contiguous(vectorSize * length);
-        for (std::size_t i = 0; i < length; ++i)
-        {
-            contiguous[vectorSize * i]     = vectorArray[i].x;
-            contiguous[vectorSize * i + 1] = vectorArray[i].y;
-            contiguous[vectorSize * i + 2] = vectorArray[i].z;
-            contiguous[vectorSize * i + 3] = vectorArray[i].w;
-        }
+        return createProgramFromBinary(data, key);
+    }
+
+    // Get the binary of a linked program, prefixed with its header
+    bool readProgramBinary(GLuint program, sf::Uint64 key, std::vector<sf::Uint8>& data)
+    {
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+            return false;
+
+        data.resize(programBinaryHeaderSize + static_cast<std::size_t>(length));
+        GLsizei written = 0;
+        GLenum format = 0;
+        sf::priv::getProgramBinary(program, length, &written, &format, &data[programBinaryHeaderSize]);
+        if (written <= 0)
+            return false;
 
-        return contiguous;
+        const sf::Uint32 storedFormat = format;
+        std::memcpy(&data[0], &programBinaryMagic, sizeof(programBinaryMagic));
+        std::memcpy(&data[4], &storedFormat, sizeof(storedFormat));
+        std::memcpy(&data[8], &key, sizeof(key));
+        data.resize(programBinaryHeaderSize + static_cast<std::size_t>(written));
+
+        return true;
+    }
+
+    // Save the binary of a linked program to the cache
+    void storeProgramBinary(GLuint program, sf::Uint64 key)
+    {
+        std::vector<sf::Uint8> data;
+        if (readProgramBinary(program, key, data))
+            shaderCache->store(key, data);
     }
 }
 
@@ -153,67 +243,114 @@ namespace
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-Shader::CurrentTextureType Shader::CurrentTexture;
+struct Shader::SharedProgram
+{
+    typedef std::map<Uint64, SharedProgram*> Table;
 
+    Uint64        key;        ///< Hash of the sources of the program
+    unsigned int  program;    ///< OpenGL identifier of the program
+    unsigned int  references; ///< Number of shaders using the program
+    const Shader* lastUser;   ///< Shader whose uniform values are currently in the program
 
-////////////////////////////////////////////////////////////
-struct Shader::UniformBinder : private NonCopyable
-{
-    ////////////////////////////////////////////////////////////
-    /// \brief Constructor: set up state before uniform is set
-    ///
-    ////////////////////////////////////////////////////////////
-    UniformBinder(Shader& shader, const char* name) :
-    savedProgram(0),
-    currentProgram(castToGlHandle(shader.m_shaderProgram)),
-    location(-1)
-    {
-        if (currentProgram)
-        {
-            // Enable program object
-            glCheck(glGetIntegerv(GL_CURRENT_PROGRAM, reinterpret_cast<int*>(&savedProgram)));
-            if (currentProgram != savedProgram)
-                glCheck(glUseProgram(currentProgram));
+    static Table table; ///< Linked programs, mapped to their key
+    static Mutex mutex; ///< Protects the table and the reference counts
+};
 
-            // Store uniform location for further use outside constructor
-            location = shader.getUniformLocation(name);
-        }
-    }
 
-    ////////////////////////////////////////////////////////////
-    /// \brief Destructor: restore state after uniform is set
-    ///
-    ////////////////////////////////////////////////////////////
-    ~UniformBinder()
-    {
-        // Disable program object
-        if (currentProgram && (currentProgram != savedProgram))
-            glCheck(glUseProgram(savedProgram));
-    }
+////////////////////////////////////////////////////////////
+Shader::SharedProgram::Table Shader::SharedProgram::table;
+Mutex Shader::SharedProgram::mutex;
 
-    unsigned int         savedProgram;   ///< Handle to the previously active program object
-    unsigned int         currentProgram; ///< Handle to the program object of the modified sf::Shader instance
-    GLint                location;       ///< Uniform location, used by the surrounding sf::Shader code
-};
+
+////////////////////////////////////////////////////////////
+Shader::CurrentTextureType Shader::CurrentTexture;
 
 
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
 m_shaderProgram (0),
+m_sharedProgram (NULL),
 m_currentTexture(-1),
 m_textures      (),
-m_uniforms      ()
+m_uniforms      (),
+m_uniformCount  (0),
+m_uniformValues (),
+m_dirtyUniforms (0),
+m_linkPending   (false),
+m_storeBinary   (false),
+m_programKey    (0),
+m_memory        (MemoryStats::Shaders)
 {
-    
+    for (int i = 0; i < PendingShaderCount; ++i)
+        m_pendingShaders[i] = 0;
+
+    priv::registerRestorable(priv::RestorableShader, this);
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::Shader(Shader&& right) noexcept :
+Shader()
+{
+    swap(right);
 }
 
 
 ////////////////////////////////////////////////////////////
 Shader::~Shader()
 {
+    priv::unregisterRestorable(priv::RestorableShader, this);
+
     // Destroy effect program
-    if (m_shaderProgram)
-        glCheck(glDeleteProgram(castToGlHandle(m_shaderProgram)));
+    discardPending();
+    releaseProgram();
+}
+
+
+////////////////////////////////////////////////////////////
+Shader& Shader::operator =(Shader&& right) noexcept
+{
+    swap(right);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::swap(Shader& right)
+{
+    std::swap(m_shaderProgram,  right.m_shaderProgram);
+    std::swap(m_sharedProgram,  right.m_sharedProgram);
+    std::swap(m_currentTexture, right.m_currentTexture);
+    std::swap(m_textures,       right.m_textures);
+    std::swap(m_uniforms,       right.m_uniforms);
+    std::swap(m_uniformCount,   right.m_uniformCount);
+    std::swap(m_uniformValues,  right.m_uniformValues);
+    std::swap(m_dirtyUniforms,  right.m_dirtyUniforms);
+    std::swap(m_attributes,     right.m_attributes);
+    std::swap(m_pendingShaders, right.m_pendingShaders);
+    std::swap(m_linkPending,    right.m_linkPending);
+    std::swap(m_storeBinary,    right.m_storeBinary);
+    std::swap(m_programKey,     right.m_programKey);
+    std::swap(m_memory,         right.m_memory);
+
+    // The shared programs remember the shader whose uniform values they hold, that shader has moved
+    if (m_sharedProgram || right.m_sharedProgram)
+    {
+        Lock lock(SharedProgram::mutex);
+
+        SharedProgram* programs[] = {m_sharedProgram, right.m_sharedProgram};
+        for (int i = 0; i < 2; ++i)
+        {
+            if (!programs[i] || ((i == 1) && (programs[1] == programs[0])))
+                continue;
+
+            if (programs[i]->lastUser == this)
+                programs[i]->lastUser = &right;
+            else if (programs[i]->lastUser == &right)
+                programs[i]->lastUser = this;
+        }
+    }
 }
 
 
@@ -323,6 +460,51 @@ bool Shader::loadFromMemory(const char* vertexShader, const char* geometryShader
 }
 
 
+////////////////////////////////////////////////////////////
+bool Shader::loadFromMemoryAsync(const char* vertexShader, const char* fragmentShader)
+{
+    return loadFromMemoryAsync(vertexShader, NULL, fragmentShader);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromMemoryAsync(const char* vertexShader, const char* geometryShader, const char* fragmentShader)
+{
+    SFML_TRACE_SCOPE("Shader::loadFromMemoryAsync");
+
+    return submit(vertexShader, geometryShader, fragmentShader);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isReady() const
+{
+    if (!m_linkPending)
+        return true;
+
+    // Without the extension, the status query blocks until the link is done
+    if (priv::isParallelShaderCompileAvailable())
+    {
+        GLint completed = GL_FALSE;
+        glCheck(glGetProgramiv(castToGlHandle(m_shaderProgram), GL_COMPLETION_STATUS_KHR, &completed));
+        if (completed == GL_FALSE)
+            return false;
+    }
+
+    finishCompile();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::waitUntilReady() const
+{
+    // The link status query waits for the driver, whatever the extensions
+    return finishCompile();
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::loadFromStream(InputStream& stream, Type type)
 {
@@ -347,72 +529,118 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& geomet
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, float x)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniform1f(binder.location, x));
+    setUniform(getUniformHandle(name), x);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, float x)
+{
+    storeUniform(handle, UniformFloat, &x, 1, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, const Glsl::Vec2& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniform2f(binder.location, v.x, v.y));
+    setUniform(getUniformHandle(name), v);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec2& v)
+{
+    const float values[2] = {v.x, v.y};
+    storeUniform(handle, UniformVec2, values, 2, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, const Glsl::Vec3& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniform3f(binder.location, v.x, v.y, v.z));
+    setUniform(getUniformHandle(name), v);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec3& v)
+{
+    const float values[3] = {v.x, v.y, v.z};
+    storeUniform(handle, UniformVec3, values, 3, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, const Glsl::Vec4& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniform4f(binder.location, v.x, v.y, v.z, v.w));
+    setUniform(getUniformHandle(name), v);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec4& v)
+{
+    const float values[4] = {v.x, v.y, v.z, v.w};
+    storeUniform(handle, UniformVec4, values, 4, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, int x)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniform1i(binder.location, x));
+    setUniform(getUniformHandle(name), x);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, int x)
+{
+    storeUniform(handle, UniformInt, &x, 1, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, const Glsl::Ivec2& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniform2i(binder.location, v.x, v.y));
+    setUniform(getUniformHandle(name), v);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec2& v)
+{
+    const int values[2] = {v.x, v.y};
+    storeUniform(handle, UniformIvec2, values, 2, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, const Glsl::Ivec3& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniform3i(binder.location, v.x, v.y, v.z));
+    setUniform(getUniformHandle(name), v);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec3& v)
+{
+    const int values[3] = {v.x, v.y, v.z};
+    storeUniform(handle, UniformIvec3, values, 3, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, const Glsl::Ivec4& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniform4i(binder.location, v.x, v.y, v.z, v.w));
+    setUniform(getUniformHandle(name), v);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec4& v)
+{
+    const int values[4] = {v.x, v.y, v.z, v.w};
+    storeUniform(handle, UniformIvec4, values, 4, 1);
 }
 
 
@@ -423,6 +651,13 @@ void Shader::setUniform(const char* name, bool x)
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, bool x)
+{
+    setUniform(handle, static_cast<int>(x));
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, const Glsl::Bvec2& v)
 {
@@ -430,6 +665,13 @@ void Shader::setUniform(const char* name, const Glsl::Bvec2& v)
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec2& v)
+{
+    setUniform(handle, Glsl::Ivec2(v));
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, const Glsl::Bvec3& v)
 {
@@ -437,6 +679,13 @@ void Shader::setUniform(const char* name, const Glsl::Bvec3& v)
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec3& v)
+{
+    setUniform(handle, Glsl::Ivec3(v));
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, const Glsl::Bvec4& v)
 {
@@ -444,31 +693,54 @@ void Shader::setUniform(const char* name, const Glsl::Bvec4& v)
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec4& v)
+{
+    setUniform(handle, Glsl::Ivec4(v));
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, const Glsl::Mat3& matrix)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniformMatrix3fv(binder.location, 1, GL_FALSE, matrix.array));
+    setUniform(getUniformHandle(name), matrix);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat3& matrix)
+{
+    storeUniform(handle, UniformMat3, matrix.array, 3 * 3, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, const Glsl::Mat4& matrix)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniformMatrix4fv(binder.location, 1, GL_FALSE, matrix.array));
+    setUniform(getUniformHandle(name), matrix);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat4& matrix)
+{
+    storeUniform(handle, UniformMat4, matrix.array, 4 * 4, 1);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, const Texture& texture)
 {
-    if (m_shaderProgram)
+    setUniform(getUniformHandle(name), texture);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Texture& texture)
+{
+    if (finishCompile())
     {
-        // Find the location of the variable in the shader
-        int location = getUniformLocation(name);
+        int location = handle.location;
         if (location != -1)
         {
             // Store the location -> texture mapping
@@ -479,16 +751,22 @@ void Shader::setUniform(const char* name, const Texture& texture)
                 GLint maxUnits = getMaxTextureUnits();
                 if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
                 {
-                    err() << "Impossible to use texture \"" << name << "\" for shader: all available texture units are used" << std::endl;
+                    err() << "Impossible to use texture for shader: all available texture units are used" << std::endl;
                     return;
                 }
 
-                m_textures[location] = &texture;
+                // Give the sampler its own unit for the lifetime of the program;
+                // unit 0 is reserved for the current texture
+                TextureSlot& slot = m_textures[location];
+                slot.texture = &texture;
+                slot.unit = static_cast<int>(m_textures.size());
+                storeUniform(handle, UniformInt, &slot.unit, 1, 1);
+                updateMemoryUsage();
             }
             else
             {
                 // Location already used, just replace the texture
-                it->second = &texture;
+                it->second.texture = &texture;
             }
         }
     }
@@ -498,83 +776,97 @@ void Shader::setUniform(const char* name, const Texture& texture)
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const char* name, CurrentTextureType)
 {
-    if (m_shaderProgram)
+    setUniform(getUniformHandle(name), CurrentTexture);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, CurrentTextureType)
+{
+    if (finishCompile())
     {
-        // Find the location of the variable in the shader
-        m_currentTexture = getUniformLocation(name);
+        // The current texture is always bound to unit 0
+        const int unit = 0;
+        m_currentTexture = handle.location;
+        storeUniform(handle, UniformInt, &unit, 1, 1);
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setUniformBlock(const char* name, unsigned int bindingPoint)
+{
+    if (!finishCompile())
+        return;
+
+    if (!UniformBuffer::isAvailable())
+    {
+        err() << "Failed to set uniform block \"" << name << "\", uniform buffers are not supported by the driver" << std::endl;
+        return;
+    }
+
+    GLuint program = castToGlHandle(m_shaderProgram);
+    GLuint index;
+    glCheck(index = glGetUniformBlockIndex(program, name));
+    if (index == GL_INVALID_INDEX)
+    {
+        err() << "Uniform block \"" << name << "\" not found in shader" << std::endl;
+        return;
+    }
+
+    glCheck(glUniformBlockBinding(program, index, bindingPoint));
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const char* name)
+{
+    if (!finishCompile())
+        return UniformHandle();
+
+    return UniformHandle(getUniformLocation(name));
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const char* name, const float* scalarArray, std::size_t length)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniform1fv(binder.location, static_cast<GLsizei>(length), scalarArray));
+    storeUniform(getUniformHandle(name), UniformFloat, scalarArray, 1, length);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const char* name, const Glsl::Vec2* vectorArray, std::size_t length)
 {
-    std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniform2fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+    storeUniform(getUniformHandle(name), UniformVec2, vectorArray, 2, length);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const char* name, const Glsl::Vec3* vectorArray, std::size_t length)
 {
-    std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniform3fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+    storeUniform(getUniformHandle(name), UniformVec3, vectorArray, 3, length);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const char* name, const Glsl::Vec4* vectorArray, std::size_t length)
 {
-    std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniform4fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+    storeUniform(getUniformHandle(name), UniformVec4, vectorArray, 4, length);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const char* name, const Glsl::Mat3* matrixArray, std::size_t length)
 {
-    const std::size_t matrixSize = 3 * 3;
-
-    std::vector<float> contiguous(matrixSize * length);
-    for (std::size_t i = 0; i < length; ++i)
-        priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniformMatrix3fv(binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
+    storeUniform(getUniformHandle(name), UniformMat3, matrixArray, 3 * 3, length);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const char* name, const Glsl::Mat4* matrixArray, std::size_t length)
 {
-    const std::size_t matrixSize = 4 * 4;
-
-    std::vector<float> contiguous(matrixSize * length);
-    for (std::size_t i = 0; i < length; ++i)
-        priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(glUniformMatrix4fv(binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
+    storeUniform(getUniformHandle(name), UniformMat4, matrixArray, 4 * 4, length);
 }
 
 
@@ -651,6 +943,8 @@ void Shader::setParameter(const char* name, CurrentTextureType)
 ////////////////////////////////////////////////////////////
 unsigned int Shader::getNativeHandle() const
 {
+    finishCompile();
+
     return m_shaderProgram;
 }
 
@@ -662,25 +956,38 @@ void Shader::setAttributes(const std::vector<std::string>& attributes)
 };
 
 
+////////////////////////////////////////////////////////////
+void Shader::setCache(ShaderCache* cache)
+{
+    shaderCache = cache;
+}
+
+
+////////////////////////////////////////////////////////////
+ShaderCache* Shader::getCache()
+{
+    return shaderCache;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::bind(const Shader* shader)
 {
-    if (shader && shader->m_shaderProgram)
+    if (shader && shader->finishCompile())
     {
         // Enable the program
-        glCheck(glUseProgram(castToGlHandle(shader->m_shaderProgram)));
+        priv::getGLStateCache().useProgram(castToGlHandle(shader->m_shaderProgram));
+
+        // Upload the uniforms that changed since the last bind
+        shader->uploadUniforms();
 
         // Bind the textures
         shader->bindTextures();
-
-        // Bind the current texture
-        if (shader->m_currentTexture != -1)
-            glCheck(glUniform1i(shader->m_currentTexture, 0));
     }
     else
     {
         // Bind no shader
-        glCheck(glUseProgram(0));
+        priv::getGLStateCache().useProgram(0);
     }
 }
 
@@ -709,6 +1016,18 @@ bool Shader::isGeometryAvailable()
 
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+{
+    SFML_TRACE_SCOPE("Shader::compile");
+
+    if (!submit(vertexShaderCode, geometryShaderCode, fragmentShaderCode))
+        return false;
+
+    return finishCompile();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::submit(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
 {
     // Make sure we can use geometry shaders
     if (geometryShaderCode && !isGeometryAvailable())
@@ -719,134 +1038,295 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
     }
 
     // Destroy the shader if it was already created
-    if (m_shaderProgram)
-    {
-        glCheck(glDeleteProgram(castToGlHandle(m_shaderProgram)));
-        m_shaderProgram = 0;
-    }
+    discardPending();
+    releaseProgram();
 
     // Reset the internal state
     m_currentTexture = -1;
     m_textures.clear();
     m_uniforms.clear();
+    m_uniformCount = 0;
+    m_uniformValues.clear();
+    m_dirtyUniforms = 0;
+    updateMemoryUsage();
+
+    // Use the program of another shader if it was built from the same sources
+    m_programKey = getProgramKey(vertexShaderCode, geometryShaderCode, fragmentShaderCode, m_attributes);
+    if (acquireSharedProgram())
+        return true;
+
+    // Restore the program from the cache if it was already linked once
+    const bool useCache = shaderCache && priv::isProgramBinaryAvailable();
+    if (useCache)
+    {
+        GLuint cachedProgram = loadProgramBinary(m_programKey);
+        if (cachedProgram)
+        {
+            m_shaderProgram = castFromGlHandle(cachedProgram);
+            bindFrameBlock(cachedProgram);
+            shareProgram();
+            glCheck(glFlush());
+            return true;
+        }
+    }
 
     // Create the program
     unsigned int shaderProgram;
     glCheck(shaderProgram = glCreateProgram());
 
-    // Create the vertex shader if needed
-    if (vertexShaderCode)
+    // Create and compile the shaders; their status is only queried once
+    // the program is linked, so that the driver can work in the background
+    const char* sources[PendingShaderCount] = {vertexShaderCode, geometryShaderCode, fragmentShaderCode};
+    const GLenum types[PendingShaderCount] = {GL_VERTEX_SHADER, GL_GEOMETRY_SHADER, GL_FRAGMENT_SHADER};
+    for (int i = 0; i < PendingShaderCount; ++i)
     {
-        // Create and compile the shader
-        unsigned int vertexShader;
-        glCheck(vertexShader = glCreateShader(GL_VERTEX_SHADER));
-        glCheck(glShaderSource(vertexShader, 1, &vertexShaderCode, NULL));
-        glCheck(glCompileShader(vertexShader));
+        if (!sources[i])
+            continue;
 
-        // Check the compile log
-        GLint success;
-        glCheck(glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
-        {
-            char log[1024];
-            glGetShaderInfoLog(vertexShader, sizeof(log), NULL, log);
-            err() << "Failed to compile vertex shader:" << std::endl
-                  << log << std::endl;
-            glCheck(glDeleteShader(vertexShader));
-            glCheck(glDeleteProgram(shaderProgram));
-            return false;
-        }
+        unsigned int shader;
+        glCheck(shader = glCreateShader(types[i]));
+        glCheck(glShaderSource(shader, 1, &sources[i], NULL));
+        glCheck(glCompileShader(shader));
+        glCheck(glAttachShader(shaderProgram, shader));
 
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(glAttachShader(shaderProgram, vertexShader));
-        glCheck(glDeleteShader(vertexShader));
+        m_pendingShaders[i] = shader;
     }
 
-    // Create the geometry shader if needed
-    if (geometryShaderCode)
+    // bind attributes
+	GLuint loc = 0;
+    for (auto& attribute : m_attributes)
+        glBindAttribLocation(shaderProgram, loc++, attribute.c_str());
+
+    // Ask the driver to keep the binary around (not part of OES_get_program_binary)
+    const bool retainable = useCache || (ContextRestore::isEnabled() && priv::isProgramBinaryAvailable());
+    if (retainable && glProgramParameteri)
+        glCheck(glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+
+    // Link the program
+    glCheck(glLinkProgram(shaderProgram));
+
+    m_shaderProgram = castFromGlHandle(shaderProgram);
+    m_linkPending = true;
+    m_storeBinary = useCache;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::finishCompile() const
+{
+    if (!m_linkPending)
+        return m_shaderProgram != 0;
+
+    m_linkPending = false;
+
+    const unsigned int shaderProgram = castToGlHandle(m_shaderProgram);
+
+    // Check the link log (this waits for the driver if it isn't done yet)
+    GLint success;
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+    if (success == GL_FALSE)
     {
-        // Create and compile the shader
-        unsigned int geometryShader = glCreateShader(GL_GEOMETRY_SHADER);
-        glCheck(glShaderSource(geometryShader, 1, &geometryShaderCode, NULL));
-        glCheck(glCompileShader(geometryShader));
+        // Report the stage that failed to compile, if any
+        static const char* const names[PendingShaderCount] = {"vertex", "geometry", "fragment"};
+        bool compileFailed = false;
+        for (int i = 0; i < PendingShaderCount; ++i)
+        {
+            if (!m_pendingShaders[i])
+                continue;
 
-        // Check the compile log
-        GLint success;
-        glCheck(glGetShaderiv(geometryShader, GL_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
+            GLint compiled;
+            glCheck(glGetShaderiv(m_pendingShaders[i], GL_COMPILE_STATUS, &compiled));
+            if (compiled == GL_FALSE)
+            {
+                char log[1024];
+                log[0] = '\0';
+
+                glGetShaderInfoLog(m_pendingShaders[i], sizeof(log), NULL, log);
+                err() << "Failed to compile " << names[i] << " shader:" << std::endl
+                      << log << std::endl;
+                compileFailed = true;
+                break;
+            }
+        }
+
+        if (!compileFailed)
         {
             char log[1024];
-			log[0] = '\0';
+            log[0] = '\0';
 
-            glGetShaderInfoLog(geometryShader, sizeof(log), NULL, log);
-            err() << "Failed to compile geometry shader:" << std::endl
+            glGetProgramInfoLog(shaderProgram, sizeof(log), NULL, log);
+            err() << "Failed to link shader:" << std::endl
                   << log << std::endl;
-            glCheck(glDeleteShader(geometryShader));
-            glCheck(glDeleteProgram(shaderProgram));
-            return false;
         }
 
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(glAttachShader(shaderProgram, geometryShader));
-        glCheck(glDeleteShader(geometryShader));
+        discardPending();
+        priv::getGLStateCache().deleteProgram(shaderProgram);
+        m_shaderProgram = 0;
+        return false;
     }
 
-    // Create the fragment shader if needed
-    if (fragmentShaderCode)
-    {
-        // Create and compile the shader
-        unsigned int fragmentShader;
-        glCheck(fragmentShader = glCreateShader(GL_FRAGMENT_SHADER));
-        glCheck(glShaderSource(fragmentShader, 1, &fragmentShaderCode, NULL));
-        glCheck(glCompileShader(fragmentShader));
+    // The shaders are not needed anymore
+    discardPending();
 
-        // Check the compile log
-        GLint success;
-        glCheck(glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
+    bindFrameBlock(shaderProgram);
+
+    if (m_storeBinary)
+        storeProgramBinary(shaderProgram, m_programKey);
+
+    shareProgram();
+
+    // Force an OpenGL flush, so that the shader will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::discardPending() const
+{
+    for (int i = 0; i < PendingShaderCount; ++i)
+    {
+        if (m_pendingShaders[i])
         {
-            char log[1024];
-			log[0] = '\0';
+            glCheck(glDeleteShader(m_pendingShaders[i]));
+            m_pendingShaders[i] = 0;
+        }
+    }
 
-            glGetShaderInfoLog(fragmentShader, sizeof(log), NULL, log);
-            err() << "Failed to compile fragment shader:" << std::endl
-                  << log << std::endl;
-            glCheck(glDeleteShader(fragmentShader));
-            glCheck(glDeleteProgram(shaderProgram));
-            return false;
+    m_linkPending = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::acquireSharedProgram()
+{
+    Lock lock(SharedProgram::mutex);
+
+    SharedProgram::Table::iterator it = SharedProgram::table.find(m_programKey);
+    if (it == SharedProgram::table.end())
+        return false;
+
+    m_sharedProgram = it->second;
+    m_sharedProgram->references++;
+    m_shaderProgram = m_sharedProgram->program;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::shareProgram() const
+{
+    Lock lock(SharedProgram::mutex);
+
+    // If another shader linked the same sources in the meantime, this program stays private
+    std::pair<SharedProgram::Table::iterator, bool> inserted = SharedProgram::table.insert(std::make_pair(m_programKey, static_cast<SharedProgram*>(NULL)));
+    if (!inserted.second)
+        return;
+
+    m_sharedProgram = new SharedProgram;
+    m_sharedProgram->key = m_programKey;
+    m_sharedProgram->program = m_shaderProgram;
+    m_sharedProgram->references = 1;
+    m_sharedProgram->lastUser = this;
+    inserted.first->second = m_sharedProgram;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::releaseProgram() const
+{
+    if (m_sharedProgram)
+    {
+        Lock lock(SharedProgram::mutex);
+
+        SharedProgram* shared = m_sharedProgram;
+        m_sharedProgram = NULL;
+
+        if (shared->lastUser == this)
+            shared->lastUser = NULL;
+
+        // Other shaders still use the program
+        if (--shared->references > 0)
+        {
+            m_shaderProgram = 0;
+            return;
         }
 
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(glAttachShader(shaderProgram, fragmentShader));
-        glCheck(glDeleteShader(fragmentShader));
+        SharedProgram::table.erase(shared->key);
+        delete shared;
     }
 
-    // bind attributes
-	GLuint loc = 0;
-    for (auto& attribute : m_attributes)
-        glBindAttribLocation(shaderProgram, loc++, attribute.c_str());
+    if (m_shaderProgram)
+    {
+        priv::getGLStateCache().deleteProgram(castToGlHandle(m_shaderProgram));
+        m_shaderProgram = 0;
+    }
+}
 
-    // Link the program
-    glCheck(glLinkProgram(shaderProgram));
 
-    // Check the link log
-    GLint success;
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (success == GL_FALSE)
+////////////////////////////////////////////////////////////
+bool Shader::retainProgram(std::vector<Uint8>& binary) const
+{
+    if (!finishCompile() || !priv::isProgramBinaryAvailable())
+        return false;
+
+    return readProgramBinary(castToGlHandle(m_shaderProgram), m_programKey, binary);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Shader::forgetProgram() const
+{
+    // The shaders of a pending link were lost with the program
+    for (int i = 0; i < PendingShaderCount; ++i)
+        m_pendingShaders[i] = 0;
+    m_linkPending = false;
+
+    unsigned int program = castToGlHandle(m_shaderProgram);
+    m_shaderProgram = 0;
+
+    if (m_sharedProgram)
     {
-        char log[1024];
-        glGetProgramInfoLog(shaderProgram, sizeof(log), NULL, log);
-        err() << "Failed to link shader:" << std::endl
-              << log << std::endl;
-        glCheck(glDeleteProgram(shaderProgram));
+        Lock lock(SharedProgram::mutex);
+        m_sharedProgram->program = 0;
+    }
+
+    return program;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::restoreProgram(const std::vector<Uint8>& binary, unsigned int& program) const
+{
+    if (!program)
+        program = createProgramFromBinary(binary, m_programKey);
+
+    if (!program)
+    {
+        err() << "Failed to restore shader, the driver refused its program binary" << std::endl;
         return false;
     }
 
-    m_shaderProgram = castFromGlHandle(shaderProgram);
+    m_shaderProgram = castFromGlHandle(program);
 
-    // Force an OpenGL flush, so that the shader will appear updated
-    // in all contexts immediately (solves problems in multi-threaded apps)
-    glCheck(glFlush());
+    // The programs shared by several shaders get the values of their next user
+    if (m_sharedProgram)
+    {
+        Lock lock(SharedProgram::mutex);
+        m_sharedProgram->program = program;
+        m_sharedProgram->lastUser = NULL;
+    }
+
+    bindFrameBlock(program);
+
+    for (UniformValueTable::iterator it = m_uniformValues.begin(); it != m_uniformValues.end(); ++it)
+        it->second.dirty = true;
+    m_dirtyUniforms = m_uniformValues.size();
 
     return true;
 }
@@ -855,42 +1335,210 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
 ////////////////////////////////////////////////////////////
 void Shader::bindTextures() const
 {
-    TextureTable::const_iterator it = m_textures.begin();
-    for (std::size_t i = 0; i < m_textures.size(); ++i)
+    // The sampler uniforms already point to their units, only the
+    // units whose texture changed are actually rebound by the cache
+    for (TextureTable::const_iterator it = m_textures.begin(); it != m_textures.end(); ++it)
     {
-        GLint index = static_cast<GLsizei>(i + 1);
-        glCheck(glUniform1i(it->first, index));
-        glCheck(glActiveTexture(GL_TEXTURE0 + index));
-        Texture::bind(it->second);
-        ++it;
+        const TextureSlot& slot = it->second;
+
+        unsigned int unit = static_cast<unsigned int>(slot.unit);
+
+        if (slot.texture)
+        {
+            priv::resolveTexture(*slot.texture);
+            priv::bindSampledTexture(unit, *slot.texture);
+        }
+        else
+        {
+            priv::getGLStateCache().bindTexture(unit, 0);
+            priv::getGLStateCache().bindSampler(unit, 0);
+        }
     }
 
     // Make sure that the texture unit which is left active is the number 0
-    glCheck(glActiveTexture(GL_TEXTURE0));
+    priv::getGLStateCache().activeTexture(0);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::storeUniform(UniformHandle handle, UniformType type, const void* values, std::size_t components, std::size_t count)
+{
+    if (!finishCompile() || (handle.location == -1) || (count == 0))
+        return;
+
+    // Floats and ints are both stored as their 32-bit pattern
+    const std::size_t size = components * count;
+    const std::size_t entryCount = m_uniformValues.size();
+    UniformValue& value = m_uniformValues[handle.location];
+    if ((value.type == type) && (value.count == count) && (value.data.size() == size) &&
+        (std::memcmp(&value.data[0], values, size * sizeof(Uint32)) == 0))
+    {
+        // Same value as before, nothing to upload
+        return;
+    }
+
+    value.type = type;
+    value.count = count;
+    const std::size_t capacity = value.data.capacity();
+    value.data.resize(size);
+    if ((m_uniformValues.size() != entryCount) || (value.data.capacity() != capacity))
+        updateMemoryUsage();
+    std::memcpy(&value.data[0], values, size * sizeof(Uint32));
+
+    if (!value.dirty)
+    {
+        value.dirty = true;
+        ++m_dirtyUniforms;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::uploadUniforms() const
+{
+    // A shader sharing the same program may have replaced the values since the last upload
+    if (m_sharedProgram && (m_sharedProgram->lastUser != this))
+    {
+        m_sharedProgram->lastUser = this;
+
+        for (UniformValueTable::iterator it = m_uniformValues.begin(); it != m_uniformValues.end(); ++it)
+            it->second.dirty = true;
+
+        m_dirtyUniforms = m_uniformValues.size();
+    }
+
+    if (m_dirtyUniforms == 0)
+        return;
+
+    for (UniformValueTable::iterator it = m_uniformValues.begin(); it != m_uniformValues.end(); ++it)
+    {
+        UniformValue& value = it->second;
+        if (!value.dirty)
+            continue;
+
+        const GLint location = it->first;
+        const GLsizei count = static_cast<GLsizei>(value.count);
+        const GLfloat* floats = reinterpret_cast<const GLfloat*>(&value.data[0]);
+        const GLint* ints = reinterpret_cast<const GLint*>(&value.data[0]);
+        switch (value.type)
+        {
+            case UniformFloat: glCheck(glUniform1fv(location, count, floats)); break;
+            case UniformVec2:  glCheck(glUniform2fv(location, count, floats)); break;
+            case UniformVec3:  glCheck(glUniform3fv(location, count, floats)); break;
+            case UniformVec4:  glCheck(glUniform4fv(location, count, floats)); break;
+            case UniformInt:   glCheck(glUniform1iv(location, count, ints));   break;
+            case UniformIvec2: glCheck(glUniform2iv(location, count, ints));   break;
+            case UniformIvec3: glCheck(glUniform3iv(location, count, ints));   break;
+            case UniformIvec4: glCheck(glUniform4iv(location, count, ints));   break;
+            case UniformMat3:  glCheck(glUniformMatrix3fv(location, count, GL_FALSE, floats)); break;
+            case UniformMat4:  glCheck(glUniformMatrix4fv(location, count, GL_FALSE, floats)); break;
+        }
+
+        value.dirty = false;
+    }
+
+    m_dirtyUniforms = 0;
 }
 
 
 ////////////////////////////////////////////////////////////
 int Shader::getUniformLocation(const char* name)
 {
-    // Check the cache
-    UniformTable::const_iterator it = m_uniforms.find(name);
-    if (it != m_uniforms.end())
+    // Check the cache (open addressing with linear probing, the
+    // table always has free slots so that the probe terminates)
+    const Uint64 hash = hashUniformName(name);
+    if (!m_uniforms.empty())
     {
-        // Already in cache, return it
-        return it->second;
+        const std::size_t mask = m_uniforms.size() - 1;
+        for (std::size_t i = static_cast<std::size_t>(hash) & mask; m_uniforms[i].location != UnusedSlot; i = (i + 1) & mask)
+        {
+            // Already in cache, return it
+            if ((m_uniforms[i].hash == hash) && (m_uniforms[i].name == name))
+                return m_uniforms[i].location;
+        }
     }
-    else
+
+    // Not in cache, request the location from OpenGL
+    int location = glGetUniformLocation(castToGlHandle(m_shaderProgram), name);
+
+    // Keep the table at most half full
+    if ((m_uniformCount + 1) * 2 > m_uniforms.size())
     {
-        // Not in cache, request the location from OpenGL
-        int location = glGetUniformLocation(castToGlHandle(m_shaderProgram), name);
-        m_uniforms.insert(std::make_pair(name, location));
+        std::vector<UniformEntry> entries;
+        entries.swap(m_uniforms);
+        m_uniforms.resize(entries.empty() ? 16 : entries.size() * 2);
+        m_uniformCount = 0;
 
-        if (location == -1)
-            err() << "Uniform \"" << name << "\" not found in shader" << std::endl;
+        for (std::size_t i = 0; i < entries.size(); ++i)
+        {
+            if (entries[i].location != UnusedSlot)
+                insertUniform(entries[i]);
+        }
+    }
+
+    UniformEntry entry;
+    entry.hash     = hash;
+    entry.name     = name;
+    entry.location = location;
+    insertUniform(entry);
+    updateMemoryUsage();
+
+    if (location == -1)
+        err() << "Uniform \"" << name << "\" not found in shader" << std::endl;
+
+    return location;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::insertUniform(UniformEntry& entry)
+{
+    const std::size_t mask = m_uniforms.size() - 1;
+    std::size_t i = static_cast<std::size_t>(entry.hash) & mask;
+    while (m_uniforms[i].location != UnusedSlot)
+        i = (i + 1) & mask;
+
+    m_uniforms[i].hash = entry.hash;
+    m_uniforms[i].name.swap(entry.name);
+    m_uniforms[i].location = entry.location;
+    ++m_uniformCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::updateMemoryUsage()
+{
+    // Estimated size of the node of a std::map, on top of its value (links and color)
+    const std::size_t nodeOverhead = 4 * sizeof(void*);
 
-        return location;
+    Uint64 bytes = m_uniforms.capacity() * sizeof(UniformEntry);
+    for (std::size_t i = 0; i < m_uniforms.size(); ++i)
+    {
+        // Short names are stored inside the string object itself
+        if (m_uniforms[i].name.capacity() >= sizeof(std::string))
+            bytes += m_uniforms[i].name.capacity() + 1;
     }
+
+    bytes += m_textures.size() * (sizeof(TextureTable::value_type) + nodeOverhead);
+
+    for (UniformValueTable::const_iterator it = m_uniformValues.begin(); it != m_uniformValues.end(); ++it)
+        bytes += sizeof(UniformValueTable::value_type) + nodeOverhead + it->second.data.capacity() * sizeof(Uint32);
+
+    m_memory.update(bytes);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Shader::hashUniformName(const char* name)
+{
+    Uint64 hash = 14695981039346656037ULL;
+    for (; *name; ++name)
+    {
+        hash ^= static_cast<Uint8>(*name);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
 }
 
 } // namespace sf
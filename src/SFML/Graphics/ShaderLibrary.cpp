@@ -0,0 +1,291 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ShaderLibrary.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+
+namespace
+{
+    // Skip the spaces and tabs starting at the given position
+    std::size_t skipBlanks(const std::string& code, std::size_t pos, std::size_t end)
+    {
+        while ((pos < end) && ((code[pos] == ' ') || (code[pos] == '\t')))
+            ++pos;
+
+        return pos;
+    }
+
+    // Check whether the line [begin, end) is a directive, and return the position after its name
+    bool isDirective(const std::string& code, std::size_t begin, std::size_t end, const char* directive, std::size_t& after)
+    {
+        std::size_t pos = skipBlanks(code, begin, end);
+        if ((pos == end) || (code[pos] != '#'))
+            return false;
+
+        pos = skipBlanks(code, pos + 1, end);
+        const std::string name(directive);
+        if (code.compare(pos, name.size(), name) != 0)
+            return false;
+
+        after = pos + name.size();
+        return true;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ShaderLibrary::ShaderLibrary() :
+m_sources (),
+m_variants()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ShaderLibrary::~ShaderLibrary()
+{
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderLibrary::setSource(const char* name, const char* source)
+{
+    m_sources[name] = source;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ShaderLibrary::loadSourceFromFile(const char* name, const char* filename)
+{
+    std::ifstream file(filename, std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to open shader file \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    m_sources[name].assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ShaderLibrary::hasSource(const char* name) const
+{
+    return m_sources.find(name) != m_sources.end();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ShaderLibrary::preprocess(const char* name, const Defines& defines, std::string& result) const
+{
+    std::string code;
+    std::vector<std::string> stack;
+    if (!expand(name, stack, code))
+        return false;
+
+    std::string definitions;
+    for (Defines::const_iterator it = defines.begin(); it != defines.end(); ++it)
+    {
+        definitions += "#define " + it->first;
+        if (!it->second.empty())
+            definitions += " " + it->second;
+        definitions += "\n";
+    }
+
+    // #version must remain the first directive of the code
+    std::size_t insertion = 0;
+    std::size_t begin = 0;
+    while (begin < code.size())
+    {
+        std::size_t end = code.find('\n', begin);
+        if (end == std::string::npos)
+            end = code.size();
+
+        std::size_t after = 0;
+        if (isDirective(code, begin, end, "version", after))
+        {
+            insertion = (end < code.size()) ? end + 1 : end;
+            if (end == code.size())
+                definitions.insert(0, "\n");
+            break;
+        }
+
+        // Stop at the first line that is not blank
+        std::size_t first = skipBlanks(code, begin, end);
+        if ((first != end) && (code[first] != '\r'))
+            break;
+
+        begin = end + 1;
+    }
+
+    code.insert(insertion, definitions);
+    result.swap(code);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Shader* ShaderLibrary::getShader(const char* vertexName, const char* fragmentName, const Defines& defines)
+{
+    return getShader(vertexName, NULL, fragmentName, defines);
+}
+
+
+////////////////////////////////////////////////////////////
+Shader* ShaderLibrary::getShader(const char* vertexName, const char* geometryName, const char* fragmentName, const Defines& defines)
+{
+    // Build the key of the variant; names and definitions can't contain a null character
+    std::string key;
+    key += vertexName ? vertexName : "";
+    key += '\0';
+    key += geometryName ? geometryName : "";
+    key += '\0';
+    key += fragmentName ? fragmentName : "";
+    for (Defines::const_iterator it = defines.begin(); it != defines.end(); ++it)
+    {
+        key += '\0';
+        key += it->first;
+        key += '=';
+        key += it->second;
+    }
+
+    VariantTable::const_iterator it = m_variants.find(key);
+    if (it != m_variants.end())
+        return it->second;
+
+    // First request of this variant: preprocess the stages and build the program
+    std::string vertexCode;
+    std::string geometryCode;
+    std::string fragmentCode;
+    Shader* shader = NULL;
+
+    if ((!vertexName   || preprocess(vertexName, defines, vertexCode)) &&
+        (!geometryName || preprocess(geometryName, defines, geometryCode)) &&
+        (!fragmentName || preprocess(fragmentName, defines, fragmentCode)))
+    {
+        shader = new Shader;
+        if (!shader->loadFromMemory(vertexName   ? vertexCode.c_str()   : NULL,
+                                    geometryName ? geometryCode.c_str() : NULL,
+                                    fragmentName ? fragmentCode.c_str() : NULL))
+        {
+            delete shader;
+            shader = NULL;
+        }
+    }
+
+    // Failed variants are remembered too, so that they are not built again
+    m_variants[key] = shader;
+    return shader;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ShaderLibrary::getVariantCount() const
+{
+    return m_variants.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void ShaderLibrary::clear()
+{
+    for (VariantTable::iterator it = m_variants.begin(); it != m_variants.end(); ++it)
+        delete it->second;
+
+    m_variants.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ShaderLibrary::expand(const std::string& name, std::vector<std::string>& stack, std::string& result) const
+{
+    SourceTable::const_iterator source = m_sources.find(name);
+    if (source == m_sources.end())
+    {
+        err() << "Failed to preprocess shader: unknown source \"" << name << "\"" << std::endl;
+        return false;
+    }
+
+    if (std::find(stack.begin(), stack.end(), name) != stack.end())
+    {
+        err() << "Failed to preprocess shader: source \"" << name << "\" includes itself" << std::endl;
+        return false;
+    }
+
+    stack.push_back(name);
+
+    const std::string& code = source->second;
+    std::size_t begin = 0;
+    while (begin < code.size())
+    {
+        std::size_t end = code.find('\n', begin);
+        if (end == std::string::npos)
+            end = code.size();
+
+        std::size_t after = 0;
+        if (isDirective(code, begin, end, "include", after))
+        {
+            // Extract the name between quotes or angle brackets
+            std::size_t open = skipBlanks(code, after, end);
+            char closing = (open < end) && (code[open] == '<') ? '>' : '"';
+            std::size_t close = (open < end) ? code.find(closing, open + 1) : std::string::npos;
+            if ((open == end) || ((code[open] != '"') && (code[open] != '<')) || (close == std::string::npos) || (close >= end))
+            {
+                err() << "Failed to preprocess shader: invalid #include in source \"" << name << "\"" << std::endl;
+                return false;
+            }
+
+            if (!expand(code.substr(open + 1, close - open - 1), stack, result))
+                return false;
+
+            if (result.empty() || (result[result.size() - 1] != '\n'))
+                result += '\n';
+        }
+        else
+        {
+            result.append(code, begin, end - begin);
+            if (end < code.size())
+                result += '\n';
+        }
+
+        begin = end + 1;
+    }
+
+    stack.pop_back();
+    return true;
+}
+
+} // namespace sf
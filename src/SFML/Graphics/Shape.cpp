@@ -29,25 +29,66 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/JobSystem.hpp>
+#include <SFML/System/Trace.hpp>
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <vector>
 
 
 namespace
 {
-    // Compute the normal of a segment
-    sf::Vector2f computeNormal(const sf::Vector2f& p1, const sf::Vector2f& p2)
+    // Compute the direction in which each point of a closed contour is extruded,
+    // given the center of the shape; points[count] must repeat points[0]
+    void computeExtrusions(const sf::Vertex* points, std::size_t count, const sf::Vector2f& center, sf::Vector2f* extrusions)
     {
-        sf::Vector2f normal(p1.y - p2.y, p2.x - p1.x);
-        float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
-        if (length != 0.f)
-            normal /= length;
-        return normal;
-    }
-
-    // Compute the dot product of two vectors
-    float dotProduct(const sf::Vector2f& p1, const sf::Vector2f& p2)
-    {
-        return p1.x * p2.x + p1.y * p2.y;
+        // Normals of the segments [i, i + 1], computed once for the two points that share
+        // each of them and stored as separate x / y arrays so that the loops vectorize
+        static thread_local std::vector<float> normals;
+        normals.resize(count * 2);
+        float* nx = &normals[0];
+        float* ny = nx + count;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const sf::Vector2f& p1 = points[i].position;
+            const sf::Vector2f& p2 = points[i + 1].position;
+            float x = p1.y - p2.y;
+            float y = p2.x - p1.x;
+            float length = std::sqrt(x * x + y * y);
+            if (length == 0.f)
+                length = 1.f;
+            nx[i] = x / length;
+            ny[i] = y / length;
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // The point i is shared by the segments i - 1 and i
+            std::size_t previous = (i == 0) ? count - 1 : i - 1;
+            const sf::Vector2f& p1 = points[i].position;
+            float toCenterX = center.x - p1.x;
+            float toCenterY = center.y - p1.y;
+
+            // Make sure that the normals point towards the outside of the shape
+            // (this depends on the order in which the points were defined)
+            float n1x = nx[previous];
+            float n1y = ny[previous];
+            float n2x = nx[i];
+            float n2y = ny[i];
+            float sign1 = (n1x * toCenterX + n1y * toCenterY > 0) ? -1.f : 1.f;
+            float sign2 = (n2x * toCenterX + n2y * toCenterY > 0) ? -1.f : 1.f;
+            n1x *= sign1;
+            n1y *= sign1;
+            n2x *= sign2;
+            n2y *= sign2;
+
+            // Combine them to get the extrusion direction
+            float factor = 1.f + (n1x * n2x + n1y * n2y);
+            extrusions[i].x = (n1x + n2x) / factor;
+            extrusions[i].y = (n1y + n2y) / factor;
+        }
     }
 }
 
@@ -75,6 +116,7 @@ void Shape::setTexture(const Texture* texture, bool resetRect)
 
     // Assign the new texture
     m_texture = texture;
+    m_trianglesNeedUpdate = true;
 }
 
 
@@ -100,6 +142,21 @@ const IntRect& Shape::getTextureRect() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Shape::setOutlineTextureRect(const IntRect& rect)
+{
+    m_outlineTextureRect = rect;
+    m_trianglesNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& Shape::getOutlineTextureRect() const
+{
+    return m_outlineTextureRect;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shape::setFillColor(const Color& color)
 {
@@ -145,6 +202,26 @@ float Shape::getOutlineThickness() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Shape::setAntialiasingEnabled(bool enabled)
+{
+    m_antialiasing = enabled;
+
+    if (!enabled)
+    {
+        m_fringeWidth = 0.f;
+        m_trianglesNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shape::isAntialiasingEnabled() const
+{
+    return m_antialiasing;
+}
+
+
 ////////////////////////////////////////////////////////////
 FloatRect Shape::getLocalBounds() const
 {
@@ -155,22 +232,65 @@ FloatRect Shape::getLocalBounds() const
 ////////////////////////////////////////////////////////////
 FloatRect Shape::getGlobalBounds() const
 {
-    return getTransform().transformRect(getLocalBounds());
+    return getTransformedBounds(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::updateMany(Shape* const* shapes, std::size_t count)
+{
+    SFML_TRACE_SCOPE("Shape::updateMany");
+
+    if (count == 0)
+        return;
+
+    JobScheduler& scheduler = JobSystem::getScheduler();
+    std::size_t jobCount = std::min<std::size_t>(scheduler.getConcurrency(), count);
+    if (jobCount <= 1)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            shapes[i]->update();
+        return;
+    }
+
+    // Each job takes the next shape until there is none left, so that
+    // shapes with many and few points are balanced between the jobs
+    std::atomic<std::size_t> next(0);
+    scheduler.parallelFor(jobCount, 1, [shapes, count, &next](std::size_t, std::size_t)
+    {
+        for (std::size_t i = next++; i < count; i = next++)
+            shapes[i]->update();
+    });
 }
 
 
 ////////////////////////////////////////////////////////////
 Shape::Shape() :
-m_texture         (NULL),
-m_textureRect     (),
-m_fillColor       (255, 255, 255),
-m_outlineColor    (255, 255, 255),
-m_outlineThickness(0),
-m_vertices        (TriangleFan),
-m_outlineVertices (TriangleStrip),
-m_insideBounds    (),
-m_bounds          ()
+m_texture            (NULL),
+m_textureRect        (),
+m_outlineTextureRect (),
+m_fillColor          (255, 255, 255),
+m_outlineColor       (255, 255, 255),
+m_outlineThickness   (0),
+m_antialiasing       (false),
+m_vertices           (TriangleFan),
+m_outlineVertices    (TriangleStrip),
+m_triangles          (Triangles),
+m_trianglesNeedUpdate(true),
+m_texturedCount      (0),
+m_fringeWidth        (0),
+m_insideBounds       (),
+m_bounds             ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::getPoints(Vector2f* points) const
 {
+    std::size_t count = getPointCount();
+    for (std::size_t i = 0; i < count; ++i)
+        points[i] = getPoint(i);
 }
 
 
@@ -183,14 +303,19 @@ void Shape::update()
     {
         m_vertices.resize(0);
         m_outlineVertices.resize(0);
+        m_trianglesNeedUpdate = true;
         return;
     }
 
     m_vertices.resize(count + 2); // + 2 for center and repeated first point
 
-    // Position
+    // Position, with one virtual call for all the points
+    static thread_local std::vector<Vector2f> points;
+    points.resize(count);
+    getPoints(&points[0]);
+
     for (std::size_t i = 0; i < count; ++i)
-        m_vertices[i + 1].position = getPoint(i);
+        m_vertices[i + 1].position = points[i];
     m_vertices[count + 1].position = m_vertices[1].position;
 
     // Update the bounding rectangle
@@ -217,24 +342,73 @@ void Shape::draw(RenderTarget& target, RenderStates states) const
 {
     states.transform *= getTransform();
 
-    // Render the inside
+    // The fringe is one pixel wide, so it depends on the current view and transform
+    if (m_antialiasing)
+    {
+        const View& view = target.getView();
+        IntRect viewport = target.getViewport(view);
+
+        const float* matrix = states.transform.getAffineMatrix();
+        float scale = std::sqrt(std::fabs(matrix[0] * matrix[4] - matrix[1] * matrix[3]));
+
+        float width = 0.f;
+        if ((scale > 0.f) && (viewport.width > 0) && (viewport.height > 0))
+        {
+            float pixelSize = (std::fabs(view.getSize().x) / viewport.width +
+                               std::fabs(view.getSize().y) / viewport.height) / 2.f;
+            width = pixelSize / scale;
+        }
+
+        // Tolerate tiny changes so that animated transforms don't rebuild it every frame
+        if (std::fabs(width - m_fringeWidth) > m_fringeWidth * 0.01f)
+        {
+            m_fringeWidth = width;
+            m_trianglesNeedUpdate = true;
+        }
+    }
+
+    if (m_trianglesNeedUpdate)
+        updateTriangles();
+
+    std::size_t vertexCount = m_triangles.getVertexCount();
+    if (vertexCount == 0)
+        return;
+
+    // The fill and the outline are a single triangle list, so they are
+    // drawn (and batched) at once unless they need different textures
+    bool splitOutline = m_texture && (vertexCount > m_texturedCount) &&
+                        ((m_outlineTextureRect.width == 0) || (m_outlineTextureRect.height == 0));
+
     states.texture = m_texture;
-    target.draw(m_vertices, states);
 
-    // Render the outline
-    if (m_outlineThickness != 0)
+    if (!splitOutline)
     {
-        states.texture = NULL;
-        target.draw(m_outlineVertices, states);
+        target.draw(&m_triangles[0], vertexCount, Triangles, states);
+        return;
     }
+
+    // Render the inside
+    target.draw(&m_triangles[0], m_texturedCount, Triangles, states);
+
+    // Render the outline
+    states.texture = NULL;
+    target.draw(&m_triangles[m_texturedCount], vertexCount - m_texturedCount, Triangles, states);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shape::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shape::updateFillColors()
 {
-    for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
-        m_vertices[i].color = m_fillColor;
+    m_vertices.setColor(m_fillColor);
+    m_trianglesNeedUpdate = true;
 }
 
 
@@ -255,6 +429,8 @@ void Shape::updateTexCoords()
 			m_vertices[i].texCoords.y *= (1.0f / m_texture->getSize().y);// m_textureRect.height);
 		}
 	}
+
+    m_trianglesNeedUpdate = true;
 }
 
 
@@ -266,39 +442,23 @@ void Shape::updateOutline()
     {
         m_outlineVertices.clear();
         m_bounds = m_insideBounds;
+        m_trianglesNeedUpdate = true;
         return;
     }
 
     std::size_t count = m_vertices.getVertexCount() - 2;
     m_outlineVertices.resize((count + 1) * 2);
 
+    static thread_local std::vector<Vector2f> extrusions;
+    extrusions.resize(count);
+    computeExtrusions(&m_vertices[1], count, m_vertices[0].position, &extrusions[0]);
+
+    // Update the outline points
     for (std::size_t i = 0; i < count; ++i)
     {
-        std::size_t index = i + 1;
-
-        // Get the two segments shared by the current point
-        Vector2f p0 = (i == 0) ? m_vertices[count].position : m_vertices[index - 1].position;
-        Vector2f p1 = m_vertices[index].position;
-        Vector2f p2 = m_vertices[index + 1].position;
-
-        // Compute their normal
-        Vector2f n1 = computeNormal(p0, p1);
-        Vector2f n2 = computeNormal(p1, p2);
-
-        // Make sure that the normals point towards the outside of the shape
-        // (this depends on the order in which the points were defined)
-        if (dotProduct(n1, m_vertices[0].position - p1) > 0)
-            n1 = -n1;
-        if (dotProduct(n2, m_vertices[0].position - p1) > 0)
-            n2 = -n2;
-
-        // Combine them to get the extrusion direction
-        float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
-        Vector2f normal = (n1 + n2) / factor;
-
-        // Update the outline points
-        m_outlineVertices[i * 2 + 0].position = p1;
-        m_outlineVertices[i * 2 + 1].position = p1 + normal * m_outlineThickness;
+        const Vector2f& point = m_vertices[i + 1].position;
+        m_outlineVertices[i * 2 + 0].position = point;
+        m_outlineVertices[i * 2 + 1].position = point + extrusions[i] * m_outlineThickness;
     }
 
     // Duplicate the first point at the end, to close the outline
@@ -316,8 +476,123 @@ void Shape::updateOutline()
 ////////////////////////////////////////////////////////////
 void Shape::updateOutlineColors()
 {
-    for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
-        m_outlineVertices[i].color = m_outlineColor;
+    m_outlineVertices.setColor(m_outlineColor);
+    m_trianglesNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::updateTriangles() const
+{
+    m_trianglesNeedUpdate = false;
+    m_texturedCount = 0;
+
+    std::size_t fanCount = m_vertices.getVertexCount();
+    std::size_t stripCount = m_outlineVertices.getVertexCount();
+    if (fanCount < 3)
+    {
+        m_triangles.clear();
+        return;
+    }
+
+    std::size_t count = fanCount - 2;
+    std::size_t fillCount = count * 3;
+    std::size_t outlineCount = (stripCount >= 3) ? (stripCount - 2) * 3 : 0;
+    std::size_t fringeCount = (m_fringeWidth > 0.f) ? count * 6 : 0;
+    m_triangles.resize(fillCount + outlineCount + fringeCount);
+
+    // Fill: unroll the fan around the center vertex
+    std::size_t out = 0;
+    for (std::size_t i = 2; i < fanCount; ++i)
+    {
+        m_triangles[out++] = m_vertices[0];
+        m_triangles[out++] = m_vertices[i - 1];
+        m_triangles[out++] = m_vertices[i];
+    }
+
+    // Without outline, the fringe extends the fill and shares its texture
+    if (outlineCount == 0)
+        out = appendFringe(out);
+
+    m_texturedCount = out;
+
+    // Outline: unroll the strip, keeping the winding of every other triangle consistent
+    for (std::size_t i = 2; i < stripCount; ++i)
+    {
+        m_triangles[out++] = m_outlineVertices[(i % 2) ? i - 1 : i - 2];
+        m_triangles[out++] = m_outlineVertices[(i % 2) ? i - 2 : i - 1];
+        m_triangles[out++] = m_outlineVertices[i];
+    }
+
+    if (outlineCount > 0)
+        out = appendFringe(out);
+
+    // Make the outline sample the center of the white area of the texture
+    if (m_texture && (outlineCount > 0))
+    {
+        Vector2f textureSize(m_texture->getSize());
+        Vector2f texCoords(0.f, 0.f);
+        if ((textureSize.x > 0) && (textureSize.y > 0))
+        {
+            texCoords.x = (m_outlineTextureRect.left + m_outlineTextureRect.width / 2.f) / textureSize.x;
+            texCoords.y = (m_outlineTextureRect.top + m_outlineTextureRect.height / 2.f) / textureSize.y;
+        }
+
+        for (std::size_t i = m_texturedCount; i < out; ++i)
+            m_triangles[i].texCoords = texCoords;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Shape::appendFringe(std::size_t out) const
+{
+    if (m_fringeWidth <= 0.f)
+        return out;
+
+    // The fringe surrounds the outer edge of the shape: the outer edge
+    // of the outline if it extends outwards, the fill contour otherwise
+    std::size_t count = m_vertices.getVertexCount() - 2;
+    float offset = std::max(m_outlineThickness, 0.f);
+    bool outline = (m_outlineThickness != 0.f);
+    const Vector2f& center = m_vertices[0].position;
+
+    static thread_local std::vector<Vertex> ring;
+    static thread_local std::vector<Vector2f> extrusions;
+    ring.resize(count * 2);
+    extrusions.resize(count);
+    computeExtrusions(&m_vertices[1], count, center, &extrusions[0]);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::size_t index = i + 1;
+        const Vector2f& p1 = m_vertices[index].position;
+        const Vector2f& normal = extrusions[i];
+
+        // Inner vertex has the color of the edge, outer vertex is fully transparent
+        Vertex& inner = ring[i * 2 + 0];
+        Vertex& outer = ring[i * 2 + 1];
+        inner.position  = p1 + normal * offset;
+        inner.color     = outline ? m_outlineColor : m_vertices[index].color;
+        inner.texCoords = m_vertices[index].texCoords;
+        outer.position  = p1 + normal * (offset + m_fringeWidth);
+        outer.color     = Color(inner.color.r, inner.color.g, inner.color.b, 0);
+        outer.texCoords = inner.texCoords;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::size_t next = (i + 1 < count) ? i + 1 : 0;
+
+        m_triangles[out++] = ring[i * 2 + 0];
+        m_triangles[out++] = ring[i * 2 + 1];
+        m_triangles[out++] = ring[next * 2 + 0];
+        m_triangles[out++] = ring[next * 2 + 0];
+        m_triangles[out++] = ring[i * 2 + 1];
+        m_triangles[out++] = ring[next * 2 + 1];
+    }
+
+    return out;
 }
 
-} // namespace sf
\ No newline at end of file
+} // namespace sf
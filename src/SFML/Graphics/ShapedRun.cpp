@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ShapedRun.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
+
+
+namespace
+{
+    // Number of runs above which the runs not used during the current frame are dropped
+    const std::size_t maxShapedRuns = 256;
+
+    // FNV-1a hash of the code points of a string, its character size and boldness
+    sf::Uint64 hashRun(const sf::String& string, unsigned int characterSize, bool bold)
+    {
+        sf::Uint64 hash = 14695981039346656037ULL;
+        for (sf::String::ConstIterator it = string.begin(); it != string.end(); ++it)
+        {
+            hash ^= *it;
+            hash *= 1099511628211ULL;
+        }
+
+        hash ^= (static_cast<sf::Uint64>(characterSize) << 1) | (bold ? 1 : 0);
+        hash *= 1099511628211ULL;
+        return hash;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void shapeString(const Font& font, const String& string, std::size_t first, unsigned int characterSize, bool bold, ShapedRun& run)
+{
+    // The kerning pairs a character with the previous one, ignoring \r
+    Uint32 prevChar = 0;
+    for (std::size_t i = first; i > 0; --i)
+    {
+        if (string[i - 1] != '\r')
+        {
+            prevChar = string[i - 1];
+            break;
+        }
+    }
+
+    run.glyphs.reserve(run.glyphs.size() + string.getSize() - first);
+    for (std::size_t i = first; i < string.getSize(); ++i)
+    {
+        Uint32 curChar = string[i];
+
+        // Skip the \r char to avoid weird graphical issues
+        if (curChar == '\r')
+            continue;
+
+        ShapedGlyph glyph;
+        glyph.cluster = static_cast<Uint32>(i);
+        glyph.index   = font.getGlyphIndex(curChar);
+        glyph.offset  = font.getKerning(prevChar, curChar, characterSize);
+        glyph.advance = 0.f;
+
+        // Whitespace is positioned by the layout, it has no glyph to load
+        if ((curChar != L' ') && (curChar != L'\n') && (curChar != L'\t'))
+            glyph.advance = font.getGlyphByIndex(glyph.index, characterSize, bold).advance;
+
+        run.glyphs.push_back(glyph);
+        prevChar = curChar;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ShapedRunCache::ShapedRunCache() :
+m_runs()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+const ShapedRun& ShapedRunCache::get(const Font& font, const String& string, unsigned int characterSize, bool bold, Uint64 revision)
+{
+    Uint64 key = hashRun(string, characterSize, bold);
+    Uint64 currentFrame = GpuMemory::getCurrentFrame();
+
+    std::map<Uint64, Entry>::iterator it = m_runs.find(key);
+    if (it == m_runs.end())
+    {
+        // Make room by dropping the runs that nothing displays anymore
+        if (m_runs.size() >= maxShapedRuns)
+        {
+            for (std::map<Uint64, Entry>::iterator run = m_runs.begin(); run != m_runs.end();)
+            {
+                if (run->second.lastUsedFrame != currentFrame)
+                    m_runs.erase(run++);
+                else
+                    ++run;
+            }
+        }
+
+        it = m_runs.insert(std::make_pair(key, Entry())).first;
+        it->second.revision = revision + 1;
+    }
+
+    Entry& entry = it->second;
+    entry.lastUsedFrame = currentFrame;
+
+    // Shape the string, unless the run is already there (a different string may have the same hash)
+    if ((entry.revision != revision) || (entry.characterSize != characterSize) || (entry.bold != bold) || !(entry.string == string))
+    {
+        entry.string        = string;
+        entry.characterSize = characterSize;
+        entry.bold          = bold;
+        entry.revision      = revision;
+        entry.run.glyphs.clear();
+        shapeString(font, string, 0, characterSize, bold, entry.run);
+    }
+
+    return entry.run;
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapedRunCache::clear()
+{
+    m_runs.clear();
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SkylinePacker.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SkylinePacker::SkylinePacker() :
+m_width  (0),
+m_height (0),
+m_margin (0),
+m_skyline()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::reset(unsigned int width, unsigned int height, unsigned int margin)
+{
+    m_width  = width;
+    m_height = height;
+    m_margin = margin;
+
+    m_skyline.clear();
+    if (width > margin)
+        m_skyline.push_back(Node(margin, margin, width - margin));
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::grow(unsigned int width, unsigned int height)
+{
+    // The new columns are empty down to the top margin
+    if (width > m_width)
+    {
+        m_skyline.push_back(Node(m_width, m_margin, width - m_width));
+        m_width = width;
+        merge();
+    }
+
+    m_height = std::max(m_height, height);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SkylinePacker::insert(unsigned int width, unsigned int height, IntRect& rect)
+{
+    // Bottom-left heuristic: choose the position whose top is the lowest,
+    // prefer the narrowest segment on ties to keep the skyline flat
+    std::size_t  bestIndex  = m_skyline.size();
+    unsigned int bestBottom = 0;
+    unsigned int bestWidth  = 0;
+    unsigned int bestY      = 0;
+
+    for (std::size_t i = 0; i < m_skyline.size(); ++i)
+    {
+        unsigned int x = m_skyline[i].x;
+        if (x + width > m_width)
+            break;
+
+        // The rectangle sits on the highest segment it spans
+        unsigned int y = 0;
+        unsigned int remaining = width;
+        for (std::size_t j = i; remaining > 0; ++j)
+        {
+            y = std::max(y, m_skyline[j].y);
+            remaining -= std::min(remaining, m_skyline[j].width);
+        }
+
+        if (y + height > m_height)
+            continue;
+
+        if ((bestIndex == m_skyline.size()) || (y + height < bestBottom) ||
+            ((y + height == bestBottom) && (m_skyline[i].width < bestWidth)))
+        {
+            bestIndex  = i;
+            bestBottom = y + height;
+            bestWidth  = m_skyline[i].width;
+            bestY      = y;
+        }
+    }
+
+    if (bestIndex == m_skyline.size())
+        return false;
+
+    unsigned int x = m_skyline[bestIndex].x;
+
+    // Raise the skyline under the rectangle
+    m_skyline.insert(m_skyline.begin() + bestIndex, Node(x, bestY + height, width));
+
+    // Shrink or remove the segments that are now covered
+    for (std::size_t i = bestIndex + 1; i < m_skyline.size();)
+    {
+        Node& node = m_skyline[i];
+        unsigned int right = x + width;
+        if (node.x >= right)
+            break;
+
+        unsigned int shrink = right - node.x;
+        if (shrink >= node.width)
+        {
+            m_skyline.erase(m_skyline.begin() + i);
+        }
+        else
+        {
+            node.x     += shrink;
+            node.width -= shrink;
+            break;
+        }
+    }
+
+    merge();
+
+    rect = IntRect(x, bestY, width, height);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::occupy(const IntRect& rect)
+{
+    if ((rect.width <= 0) || (rect.height <= 0))
+        return;
+
+    unsigned int left   = static_cast<unsigned int>(std::max(rect.left, 0));
+    unsigned int right  = std::min(static_cast<unsigned int>(rect.left + rect.width), m_width);
+    unsigned int bottom = static_cast<unsigned int>(rect.top + rect.height);
+
+    splitAt(left);
+    splitAt(right);
+
+    for (std::size_t i = 0; i < m_skyline.size(); ++i)
+    {
+        Node& node = m_skyline[i];
+        if ((node.x >= left) && (node.x + node.width <= right))
+            node.y = std::max(node.y, bottom);
+    }
+
+    merge();
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::merge()
+{
+    for (std::size_t i = 0; i + 1 < m_skyline.size();)
+    {
+        if (m_skyline[i].y == m_skyline[i + 1].y)
+        {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::splitAt(unsigned int x)
+{
+    for (std::size_t i = 0; i < m_skyline.size(); ++i)
+    {
+        Node node = m_skyline[i];
+        if ((node.x < x) && (x < node.x + node.width))
+        {
+            m_skyline[i].width = x - node.x;
+            m_skyline.insert(m_skyline.begin() + i + 1, Node(x, node.y, node.x + node.width - x));
+            return;
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
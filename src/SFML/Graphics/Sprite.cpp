@@ -35,6 +35,7 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Sprite::Sprite() :
+m_mesh       (),
 m_texture    (NULL),
 m_textureRect()
 {
@@ -43,6 +44,7 @@ m_textureRect()
 
 ////////////////////////////////////////////////////////////
 Sprite::Sprite(const Texture& texture) :
+m_mesh       (),
 m_texture    (NULL),
 m_textureRect()
 {
@@ -52,6 +54,7 @@ m_textureRect()
 
 ////////////////////////////////////////////////////////////
 Sprite::Sprite(const Texture& texture, const IntRect& rectangle) :
+m_mesh       (),
 m_texture    (NULL),
 m_textureRect()
 {
@@ -60,6 +63,21 @@ m_textureRect()
 }
 
 
+////////////////////////////////////////////////////////////
+Sprite::Sprite(const TextureAtlas::Region& region) :
+m_mesh       (),
+m_texture    (NULL),
+m_textureRect()
+{
+    if (region.texture)
+    {
+        setTexture(*region.texture);
+        setTextureRect(region.rect);
+        setMesh(region.mesh);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Sprite::setTexture(const Texture& texture, bool resetRect)
 {
@@ -80,6 +98,9 @@ void Sprite::setTextureRect(const IntRect& rectangle)
 {
     if (rectangle != m_textureRect)
     {
+        // The mesh outlined the previous rect
+        m_mesh.clear();
+
         m_textureRect = rectangle;
         updatePositions();
         updateTexCoords();
@@ -95,6 +116,31 @@ void Sprite::setColor(const Color& color)
     m_vertices[1].color = color;
     m_vertices[2].color = color;
     m_vertices[3].color = color;
+
+    for (std::size_t i = 0; i < m_mesh.size(); ++i)
+        m_mesh[i].color = color;
+}
+
+
+////////////////////////////////////////////////////////////
+void Sprite::setMesh(const std::vector<Vector2f>& outline)
+{
+    m_mesh.clear();
+    if (outline.size() < 3)
+        return;
+
+    m_mesh.resize(outline.size(), Vertex(Vector2f(), m_vertices[0].color));
+    for (std::size_t i = 0; i < outline.size(); ++i)
+        m_mesh[i].position = outline[i];
+
+    updateTexCoords();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Sprite::hasMesh() const
+{
+    return !m_mesh.empty();
 }
 
 
@@ -132,7 +178,7 @@ FloatRect Sprite::getLocalBounds() const
 ////////////////////////////////////////////////////////////
 FloatRect Sprite::getGlobalBounds() const
 {
-    return getTransform().transformRect(getLocalBounds());
+    return getTransformedBounds(getLocalBounds());
 }
 
 
@@ -143,11 +189,29 @@ void Sprite::draw(RenderTarget& target, RenderStates states) const
     {
         states.transform *= getTransform();
         states.texture = m_texture;
-        target.draw(m_vertices, 4, TriangleStrip, states);
+        drawTransformed(target, states);
     }
 }
 
 
+////////////////////////////////////////////////////////////
+bool Sprite::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Sprite::drawTransformed(RenderTarget& target, const RenderStates& states) const
+{
+    if (m_mesh.empty())
+        target.draw(m_vertices, 4, TriangleStrip, states);
+    else
+        target.draw(&m_mesh[0], m_mesh.size(), TriangleFan, states);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Sprite::updatePositions()
 {
@@ -173,14 +237,29 @@ void Sprite::updateTexCoords()
     m_vertices[2].texCoords = Vector2f(right, top);
     m_vertices[3].texCoords = Vector2f(right, bottom);
 
-	if (m_texture)
-	{
-		for (std::size_t i = 0; i < 4; ++i)
-		{
-			m_vertices[i].texCoords.x *= (1.0f / static_cast<float>(m_texture->getSize().x));
-			m_vertices[i].texCoords.y *= (1.0f / static_cast<float>(m_texture->getSize().y));
-		};
-	};
+    // The mesh maps its local positions to the rect like the corners do
+    float signX = (m_textureRect.width < 0) ? -1.f : 1.f;
+    float signY = (m_textureRect.height < 0) ? -1.f : 1.f;
+    for (std::size_t i = 0; i < m_mesh.size(); ++i)
+        m_mesh[i].texCoords = Vector2f(left + m_mesh[i].position.x * signX, top + m_mesh[i].position.y * signY);
+
+    if (m_texture)
+    {
+        float scaleX = 1.0f / static_cast<float>(m_texture->getSize().x);
+        float scaleY = 1.0f / static_cast<float>(m_texture->getSize().y);
+
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            m_vertices[i].texCoords.x *= scaleX;
+            m_vertices[i].texCoords.y *= scaleY;
+        }
+
+        for (std::size_t i = 0; i < m_mesh.size(); ++i)
+        {
+            m_mesh[i].texCoords.x *= scaleX;
+            m_mesh[i].texCoords.y *= scaleY;
+        }
+    }
 }
 
 } // namespace sf
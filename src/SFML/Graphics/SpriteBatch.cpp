@@ -0,0 +1,305 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/FrameArena.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TransformBuffer.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <algorithm>
+#include <cstdlib>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch() :
+m_texture          (NULL),
+m_items            (),
+m_buffer           (0),
+m_bufferSize       (0),
+m_vertices         (),
+m_needUpdate       (true),
+m_textureSize      (),
+m_transforms       (NULL),
+m_transformsVersion(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch(const Texture& texture) :
+m_texture          (&texture),
+m_items            (),
+m_buffer           (0),
+m_bufferSize       (0),
+m_vertices         (),
+m_needUpdate       (true),
+m_textureSize      (),
+m_transforms       (NULL),
+m_transformsVersion(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::~SpriteBatch()
+{
+    if (m_buffer)
+        priv::getGLStateCache().deleteBuffer(m_buffer);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTexture(const Texture& texture)
+{
+    m_texture = &texture;
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* SpriteBatch::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::add(const Transform& transform, const IntRect& textureRect, const Color& color)
+{
+    Item item = {transform, textureRect, color};
+    m_items.push_back(item);
+    m_needUpdate = true;
+
+    return m_items.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::add(const Sprite& sprite)
+{
+    return add(sprite.getTransform(), sprite.getTextureRect(), sprite.getColor());
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::add(const IntRect& textureRect, const Color& color)
+{
+    return add(Transform::Identity, textureRect, color);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::set(std::size_t index, const Transform& transform, const IntRect& textureRect, const Color& color)
+{
+    Item& item = m_items[index];
+    item.transform   = transform;
+    item.textureRect = textureRect;
+    item.color       = color;
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::clear()
+{
+    m_items.clear();
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::reserve(std::size_t count)
+{
+    m_items.reserve(count);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getSize() const
+{
+    return m_items.size();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::isInstancingAvailable()
+{
+    return priv::isInstancingAvailable();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTransformBuffer(const TransformBuffer* buffer)
+{
+    m_transforms = buffer;
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const TransformBuffer* SpriteBatch::getTransformBuffer() const
+{
+    return m_transforms;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_texture || m_items.empty())
+        return;
+
+    bool instancing = isInstancingAvailable();
+
+    // Texture coordinates are normalized, rebuild if the texture was resized
+    if (m_texture->getSize() != m_textureSize)
+        m_needUpdate = true;
+
+    // Moving the objects of the transform buffer moves the sprites
+    if (m_transforms && (m_transforms->getVersion() != m_transformsVersion))
+        m_needUpdate = true;
+
+    if (m_needUpdate)
+    {
+        m_textureSize = m_texture->getSize();
+
+        float scaleX = 1.f / static_cast<float>(m_textureSize.x);
+        float scaleY = 1.f / static_cast<float>(m_textureSize.y);
+
+        // The instances are only needed until they are uploaded or expanded
+        FrameArena& arena = FrameArena::getDefault();
+        FrameArena::Scope scope(arena);
+        typedef FrameAllocator<priv::QuadInstance> InstanceAllocator;
+        std::vector<priv::QuadInstance, InstanceAllocator> instances(m_items.size(), priv::QuadInstance(), InstanceAllocator(arena));
+
+        // The transforms of the buffer are read as 6 linear streams
+        const float* world[6] = {NULL, NULL, NULL, NULL, NULL, NULL};
+        std::size_t worldCount = 0;
+        if (m_transforms)
+        {
+            for (std::size_t j = 0; j < 6; ++j)
+                world[j] = m_transforms->getMatrixData(j);
+            worldCount = m_transforms->getSize();
+            m_transformsVersion = m_transforms->getVersion();
+        }
+
+        for (std::size_t i = 0; i < m_items.size(); ++i)
+        {
+            const Item& item = m_items[i];
+
+            Transform transform = item.transform;
+            if (i < worldCount)
+            {
+                transform = Transform(world[0][i], world[1][i], world[2][i],
+                                      world[3][i], world[4][i], world[5][i],
+                                      0.f,         0.f,         1.f) * item.transform;
+            }
+
+            // The size of the quad is folded in its transform, like sf::Sprite's local bounds
+            transform.scale(static_cast<float>(std::abs(item.textureRect.width)),
+                            static_cast<float>(std::abs(item.textureRect.height)));
+
+            const float* matrix = transform.getAffineMatrix();
+            priv::QuadInstance& instance = instances[i];
+            instance.row0[0] = matrix[0]; instance.row0[1] = matrix[1]; instance.row0[2] = matrix[2];
+            instance.row1[0] = matrix[3]; instance.row1[1] = matrix[4]; instance.row1[2] = matrix[5];
+
+            instance.texRect[0] = item.textureRect.left   * scaleX;
+            instance.texRect[1] = item.textureRect.top    * scaleY;
+            instance.texRect[2] = item.textureRect.width  * scaleX;
+            instance.texRect[3] = item.textureRect.height * scaleY;
+
+            instance.color[0] = item.color.r;
+            instance.color[1] = item.color.g;
+            instance.color[2] = item.color.b;
+            instance.color[3] = item.color.a;
+        }
+
+        if (instancing)
+        {
+            priv::GLStateCache& cache = priv::getGLStateCache();
+
+            if (!m_buffer)
+                glCheck(glGenBuffers(1, &m_buffer));
+
+            cache.bindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+            // Grow the buffer geometrically, otherwise update its content in place
+            if (instances.size() > m_bufferSize)
+            {
+                m_bufferSize = std::max(instances.size(), m_bufferSize * 2);
+                glCheck(glBufferData(GL_ARRAY_BUFFER, sizeof(priv::QuadInstance) * m_bufferSize, 0, GL_DYNAMIC_DRAW));
+            }
+
+            glCheck(glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(priv::QuadInstance) * instances.size(), instances.data()));
+            priv::getRenderStats().bytesUploaded += sizeof(priv::QuadInstance) * instances.size();
+        }
+        else
+        {
+            // Expand the instances to quads, in sf::Quads order
+            static const float corners[4][2] = { {0.f, 0.f}, {0.f, 1.f}, {1.f, 1.f}, {1.f, 0.f} };
+
+            m_vertices.resize(instances.size() * 4);
+
+            for (std::size_t i = 0; i < instances.size(); ++i)
+            {
+                const priv::QuadInstance& instance = instances[i];
+
+                for (std::size_t j = 0; j < 4; ++j)
+                {
+                    float x = corners[j][0];
+                    float y = corners[j][1];
+
+                    Vertex& vertex = m_vertices[i * 4 + j];
+                    vertex.position.x  = instance.row0[0] * x + instance.row0[1] * y + instance.row0[2];
+                    vertex.position.y  = instance.row1[0] * x + instance.row1[1] * y + instance.row1[2];
+                    vertex.texCoords.x = instance.texRect[0] + x * instance.texRect[2];
+                    vertex.texCoords.y = instance.texRect[1] + y * instance.texRect[3];
+                    vertex.color       = Color(instance.color[0], instance.color[1], instance.color[2], instance.color[3]);
+                }
+            }
+        }
+
+        m_needUpdate = false;
+    }
+
+    states.texture = m_texture;
+
+    if (instancing)
+        target.drawQuadInstances(m_buffer, m_items.size(), states);
+    else
+        target.draw(m_vertices.data(), m_vertices.size(), Quads, states);
+}
+
+} // namespace sf
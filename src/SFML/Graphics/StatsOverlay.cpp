@@ -0,0 +1,288 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/StatsOverlay.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/Graphics/GpuProfiler.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    const char* const rowLabels[] =
+    {
+        "cpu ms", "gpu ms", "draws", "batches", "vertices", "upload KB", "textures MB", "atlases MB", "glyph hits %"
+    };
+
+    const sf::Color backgroundColor(0, 0, 0, 160);
+    const sf::Color labelColor(200, 200, 200);
+    const sf::Color graphColors[] = {sf::Color(80, 200, 120), sf::Color(230, 150, 60)};
+    const sf::Color overBudgetColor(230, 60, 60);
+    const sf::Color budgetColor(255, 255, 255, 96);
+
+    // Width of a bar of the graphs, in pixels
+    const float barWidth = 2.f;
+
+    // Write a rectangle as two triangles
+    void writeQuad(sf::Vertex* quad, float left, float top, float width, float height, const sf::Color& color)
+    {
+        float right  = left + width;
+        float bottom = top + height;
+
+        quad[0] = sf::Vertex(sf::Vector2f(left,  top),    color);
+        quad[1] = sf::Vertex(sf::Vector2f(right, top),    color);
+        quad[2] = sf::Vertex(sf::Vector2f(left,  bottom), color);
+        quad[3] = sf::Vertex(sf::Vector2f(left,  bottom), color);
+        quad[4] = sf::Vertex(sf::Vector2f(right, top),    color);
+        quad[5] = sf::Vertex(sf::Vector2f(right, bottom), color);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+StatsOverlay::StatsOverlay(const Font& font, unsigned int characterSize) :
+m_font           (&font),
+m_watchedFonts   (),
+m_labels         (font, characterSize),
+m_vertices       (),
+m_graphTop       (0),
+m_graphHeight    (0),
+m_graphSpacing   (0),
+m_width          (0),
+m_budget         (1000.f / 60.f),
+m_head           (0),
+m_refreshInterval(milliseconds(250)),
+m_refreshClock   (),
+m_glyphLookups   (0),
+m_frames         (0),
+m_gpuFrames      (0),
+m_gpuShown       (false)
+{
+    float size        = static_cast<float>(characterSize);
+    float padding     = std::floor(size / 2);
+    float lineSpacing = font.getLineSpacing(characterSize);
+
+    // The labels never change, they are laid out once
+    float labelWidth = 0;
+    for (std::size_t i = 0; i < RowCount; ++i)
+    {
+        m_labels.add(rowLabels[i], Transform().translate(padding, padding + lineSpacing * i), (i <= GpuTime) ? graphColors[i] : labelColor);
+        labelWidth = std::max(labelWidth, m_labels.getBounds(i).left + m_labels.getBounds(i).width);
+    }
+
+    // The figures are right-aligned in a column after the labels, on the baseline of their label
+    float valueWidth = 0;
+    for (std::size_t i = 0; i < RowCount; ++i)
+    {
+        m_values[i].setFont(font);
+        m_values[i].setCharacterSize(characterSize);
+        m_values[i].setSlotCount(8);
+        m_values[i].setAlignment(NumericText::Right);
+        m_values[i].setFillColor((i <= GpuTime) ? graphColors[i] : Color::White);
+        m_values[i].setPosition(labelWidth + padding, padding + lineSpacing * i + size);
+        m_values[i].setValue(Int64(0));
+        valueWidth = m_values[i].getLocalBounds().width;
+
+        m_sums[i] = 0;
+    }
+
+    m_width        = std::max(labelWidth + padding * 2 + valueWidth, padding * 2 + barWidth * HistorySize);
+    m_graphTop     = padding * 2 + lineSpacing * RowCount;
+    m_graphHeight  = size * 3;
+    m_graphSpacing = m_graphHeight + padding;
+
+    // Background, then the bars of both graphs, then the budget lines on top of them
+    m_vertices.resize(6 + HistorySize * 12 + 12);
+    writeQuad(&m_vertices[0], 0, 0, m_width, m_graphTop + m_graphSpacing + m_graphHeight + padding, backgroundColor);
+    for (std::size_t i = 0; i < HistorySize; ++i)
+    {
+        writeBar(0, i, -1.f);
+        writeBar(1, i, -1.f);
+    }
+    writeBudgetLines();
+}
+
+
+////////////////////////////////////////////////////////////
+void StatsOverlay::watchFont(const Font& font)
+{
+    if ((&font != m_font) && (std::find(m_watchedFonts.begin(), m_watchedFonts.end(), &font) == m_watchedFonts.end()))
+        m_watchedFonts.push_back(&font);
+}
+
+
+////////////////////////////////////////////////////////////
+void StatsOverlay::setFrameBudget(Time budget)
+{
+    m_budget = std::max(budget.asSeconds() * 1000.f, 0.001f);
+    writeBudgetLines();
+}
+
+
+////////////////////////////////////////////////////////////
+void StatsOverlay::setRefreshInterval(Time interval)
+{
+    m_refreshInterval = interval;
+}
+
+
+////////////////////////////////////////////////////////////
+void StatsOverlay::update(Time cpuTime)
+{
+    const RenderStats& stats = priv::getRenderStats();
+
+    // The GPU time is the total of the top-level scopes of the last measured frame
+    float gpuTime = -1.f;
+    if (GpuProfiler* profiler = GpuProfiler::getActive())
+    {
+        const std::vector<GpuProfiler::Result>& results = profiler->getResults();
+        if (!results.empty())
+        {
+            Time total;
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                if (results[i].depth == 0)
+                    total += results[i].time;
+            }
+            gpuTime = total.asSeconds() * 1000.f;
+        }
+    }
+
+    float cpuTimeMs = cpuTime.asSeconds() * 1000.f;
+
+    // Sweep the graphs: write the bars of the frame, and clear the next ones to show where the sweep is
+    writeBar(0, m_head, cpuTimeMs);
+    writeBar(1, m_head, gpuTime);
+    m_head = (m_head + 1) % HistorySize;
+    writeBar(0, m_head, -1.f);
+    writeBar(1, m_head, -1.f);
+
+    m_sums[CpuTime]   += cpuTimeMs;
+    m_sums[DrawCalls] += stats.drawCalls;
+    m_sums[Batches]   += stats.batchesFlushed;
+    m_sums[Vertices]  += static_cast<double>(stats.vertices);
+    m_sums[Uploads]   += static_cast<double>(stats.bytesUploaded);
+    m_sums[GlyphHits] += stats.glyphCacheHits;
+    m_glyphLookups    += stats.glyphCacheHits + stats.glyphCacheMisses;
+    ++m_frames;
+
+    if (gpuTime >= 0)
+    {
+        m_sums[GpuTime] += gpuTime;
+        ++m_gpuFrames;
+    }
+
+    if (m_refreshClock.getElapsedTime() < m_refreshInterval)
+        return;
+
+    // Refresh the figures with the averages of the interval
+    double frames = m_frames;
+    m_values[CpuTime].setValue(m_sums[CpuTime] / frames, 2);
+    m_values[DrawCalls].setValue(static_cast<Int64>(m_sums[DrawCalls] / frames + 0.5));
+    m_values[Batches].setValue(static_cast<Int64>(m_sums[Batches] / frames + 0.5));
+    m_values[Vertices].setValue(static_cast<Int64>(m_sums[Vertices] / frames + 0.5));
+    m_values[Uploads].setValue(m_sums[Uploads] / frames / 1024.0, 1);
+
+    m_gpuShown = (m_gpuFrames > 0);
+    if (m_gpuShown)
+        m_values[GpuTime].setValue(m_sums[GpuTime] / m_gpuFrames, 2);
+
+    // Memory figures are the current usage, not averages
+    Uint64 atlases = m_font->getAtlasMemoryUsage();
+    for (std::size_t i = 0; i < m_watchedFonts.size(); ++i)
+        atlases += m_watchedFonts[i]->getAtlasMemoryUsage();
+
+    m_values[Textures].setValue(static_cast<double>(GpuMemory::getUsage(GpuMemory::Textures)) / (1024.0 * 1024.0), 1);
+    m_values[Atlases].setValue(static_cast<double>(atlases) / (1024.0 * 1024.0), 1);
+    m_values[GlyphHits].setValue(m_glyphLookups ? m_sums[GlyphHits] * 100.0 / static_cast<double>(m_glyphLookups) : 100.0, 1);
+
+    for (std::size_t i = 0; i < RowCount; ++i)
+        m_sums[i] = 0;
+
+    m_glyphLookups = 0;
+    m_frames       = 0;
+    m_gpuFrames    = 0;
+    m_refreshClock.restart();
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect StatsOverlay::getLocalBounds() const
+{
+    return FloatRect(m_vertices[0].position, m_vertices[5].position - m_vertices[0].position);
+}
+
+
+////////////////////////////////////////////////////////////
+void StatsOverlay::draw(RenderTarget& target, RenderStates states) const
+{
+    states.transform *= getTransform();
+
+    // The solid triangles and the glyphs use different textures, but batch together
+    target.draw(&m_vertices[0], m_vertices.size(), Triangles, states);
+    target.draw(m_labels, states);
+
+    for (std::size_t i = 0; i < RowCount; ++i)
+    {
+        if ((i != GpuTime) || m_gpuShown)
+            target.draw(m_values[i], states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void StatsOverlay::writeBar(std::size_t graph, std::size_t index, float time)
+{
+    // The graphs go up to twice the budget
+    float height = (time > 0) ? std::min(time / (m_budget * 2), 1.f) * m_graphHeight : 0.f;
+    float left   = (m_width - barWidth * HistorySize) / 2 + barWidth * index;
+    float bottom = m_graphTop + m_graphSpacing * graph + m_graphHeight;
+
+    const Color& color = (time > m_budget) ? overBudgetColor : graphColors[graph];
+    writeQuad(&m_vertices[6 + (graph * HistorySize + index) * 6], left, bottom - height, barWidth, height, color);
+}
+
+
+////////////////////////////////////////////////////////////
+void StatsOverlay::writeBudgetLines()
+{
+    float left = (m_width - barWidth * HistorySize) / 2;
+
+    for (std::size_t graph = 0; graph < 2; ++graph)
+    {
+        float middle = m_graphTop + m_graphSpacing * graph + m_graphHeight / 2;
+        writeQuad(&m_vertices[6 + HistorySize * 12 + graph * 6], left, middle, barWidth * HistorySize, 1.f, budgetColor);
+    }
+}
+
+} // namespace sf
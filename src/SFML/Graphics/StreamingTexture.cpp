@@ -0,0 +1,299 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/StreamingTexture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    bool arePixelBuffersAvailable()
+    {
+        const sf::GraphicsCaps& caps = sf::priv::getGraphicsCaps();
+        return caps.mapBufferRange && caps.fenceSync;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+StreamingTexture::StreamingTexture() :
+m_bufferCount (0),
+m_writeIndex  (0),
+m_displayIndex(0),
+m_serial      (0),
+m_lockedPixels(NULL)
+{
+    for (unsigned int i = 0; i < MaxBufferCount; ++i)
+    {
+        m_buffers[i] = 0;
+        m_fences[i] = NULL;
+        m_serials[i] = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+StreamingTexture::~StreamingTexture()
+{
+    releaseBuffers();
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamingTexture::create(unsigned int width, unsigned int height, unsigned int bufferCount)
+{
+    if ((bufferCount < 2) || (bufferCount > MaxBufferCount))
+    {
+        err() << "Failed to create streaming texture, invalid buffer count (" << bufferCount << ")" << std::endl;
+        return false;
+    }
+
+    releaseBuffers();
+    m_bufferCount = 0;
+
+    for (unsigned int i = 0; i < bufferCount; ++i)
+    {
+        if (!m_textures[i].create(width, height))
+            return false;
+    }
+
+    // The textures that are no longer used are released
+    for (unsigned int i = bufferCount; i < MaxBufferCount; ++i)
+        m_textures[i] = Texture();
+
+    if (arePixelBuffersAvailable())
+    {
+        priv::GLStateCache& cache = priv::getGLStateCache();
+        GLsizeiptr size = static_cast<GLsizeiptr>(width) * height * 4;
+
+        for (unsigned int i = 0; i < bufferCount; ++i)
+        {
+            glCheck(glGenBuffers(1, &m_buffers[i]));
+            cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffers[i]);
+            glCheck(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW));
+        }
+
+        // Client memory uploads must never see a bound unpack buffer
+        cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+
+    m_bufferCount = bufferCount;
+    m_writeIndex = 0;
+    m_displayIndex = 0;
+    m_serial = 0;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* StreamingTexture::lock()
+{
+    if ((m_bufferCount == 0) || m_lockedPixels)
+        return NULL;
+
+    pollTransfers();
+
+    // Write into the oldest texture that isn't displayed; its pending
+    // transfer, if any, is superseded by the new one
+    m_writeIndex = (m_displayIndex + 1) % m_bufferCount;
+    for (unsigned int i = 0; i < m_bufferCount; ++i)
+    {
+        if ((i != m_displayIndex) && (m_serials[i] < m_serials[m_writeIndex]))
+            m_writeIndex = i;
+    }
+
+    if (m_fences[m_writeIndex])
+    {
+        glCheck(glDeleteSync(static_cast<GLsync>(m_fences[m_writeIndex])));
+        m_fences[m_writeIndex] = NULL;
+    }
+
+    Vector2u size = m_textures[m_writeIndex].getSize();
+    GLsizeiptr bytes = static_cast<GLsizeiptr>(size.x) * size.y * 4;
+
+    if (m_buffers[m_writeIndex])
+    {
+        priv::GLStateCache& cache = priv::getGLStateCache();
+        cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffers[m_writeIndex]);
+
+        // Invalidating lets the driver hand out fresh storage if the previous transfer is still reading it
+        void* destination = NULL;
+        glCheck(destination = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+
+        // The mapping stays valid after unbinding, client memory uploads must never see a bound unpack buffer
+        cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (destination)
+        {
+            m_lockedPixels = static_cast<Uint8*>(destination);
+            return m_lockedPixels;
+        }
+    }
+
+    // Fall back to a CPU copy sent by a regular texture update
+    m_staging.resize(static_cast<std::size_t>(bytes));
+    m_lockedPixels = &m_staging[0];
+
+    return m_lockedPixels;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::unlock()
+{
+    if (!m_lockedPixels)
+        return;
+
+    Texture& texture = m_textures[m_writeIndex];
+
+    if (m_staging.empty() || (m_lockedPixels != &m_staging[0]))
+    {
+        m_lockedPixels = NULL;
+
+        priv::GLStateCache& cache = priv::getGLStateCache();
+        cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffers[m_writeIndex]);
+
+        GLboolean unmapped;
+        glCheck(unmapped = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+        if (!unmapped)
+        {
+            // The buffer contents were lost (display mode change, etc.), the frame is dropped
+            cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            return;
+        }
+
+        texture.updateFromPixelBuffer(m_buffers[m_writeIndex]);
+
+        glCheck(m_fences[m_writeIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        m_serials[m_writeIndex] = ++m_serial;
+    }
+    else
+    {
+        m_lockedPixels = NULL;
+
+        // The update is synchronous, the texture can be displayed right away
+        texture.update(&m_staging[0]);
+        m_serials[m_writeIndex] = ++m_serial;
+        m_displayIndex = m_writeIndex;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& StreamingTexture::getTexture() const
+{
+    pollTransfers();
+
+    return m_textures[m_displayIndex];
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u StreamingTexture::getSize() const
+{
+    return m_textures[0].getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::setSmooth(bool smooth)
+{
+    for (unsigned int i = 0; i < MaxBufferCount; ++i)
+        m_textures[i].setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamingTexture::isSmooth() const
+{
+    return m_textures[0].isSmooth();
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::releaseBuffers()
+{
+    bool mapped = m_lockedPixels && (m_staging.empty() || (m_lockedPixels != &m_staging[0]));
+    m_lockedPixels = NULL;
+
+    for (unsigned int i = 0; i < MaxBufferCount; ++i)
+    {
+        if (m_fences[i])
+        {
+            glCheck(glDeleteSync(static_cast<GLsync>(m_fences[i])));
+            m_fences[i] = NULL;
+        }
+
+        if (m_buffers[i])
+        {
+            if (mapped && (i == m_writeIndex))
+            {
+                priv::GLStateCache& cache = priv::getGLStateCache();
+                cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffers[i]);
+                glCheck(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+                cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+
+            priv::getGLStateCache().deleteBuffer(m_buffers[i]);
+            m_buffers[i] = 0;
+        }
+
+        m_serials[i] = 0;
+    }
+
+    m_staging.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::pollTransfers() const
+{
+    for (unsigned int i = 0; i < m_bufferCount; ++i)
+    {
+        if (!m_fences[i])
+            continue;
+
+        GLenum status;
+        glCheck(status = glClientWaitSync(static_cast<GLsync>(m_fences[i]), GL_SYNC_FLUSH_COMMANDS_BIT, 0));
+        if ((status != GL_ALREADY_SIGNALED) && (status != GL_CONDITION_SATISFIED))
+            continue;
+
+        glCheck(glDeleteSync(static_cast<GLsync>(m_fences[i])));
+        m_fences[i] = NULL;
+
+        if (m_serials[i] > m_serials[m_displayIndex])
+            m_displayIndex = i;
+    }
+}
+
+} // namespace sf
@@ -28,29 +28,46 @@
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/System/Trace.hpp>
+#include <algorithm>
 #include <cmath>
+#include <utility>
 
 
 namespace
 {
+    // Make room for \a count more vertices, growing geometrically so that characters appended one by one stay cheap
+    void reserveVertices(sf::VertexArray& vertices, std::size_t count)
+    {
+        std::size_t required = vertices.getVertexCount() + count;
+        if (required > vertices.getCapacity())
+            vertices.reserve(std::max(required, vertices.getCapacity() * 2));
+    }
+
     // Add an underline or strikethrough line to the vertex array
     void addLine(sf::VertexArray& vertices, float lineLength, float lineTop, const sf::Color& color, float offset, float thickness, float outlineThickness = 0)
     {
         float top = std::floor(lineTop + offset - (thickness / 2) + 0.5f);
         float bottom = top + std::floor(thickness + 0.5f);
 
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1)));
+        const sf::Vertex quad[6] =
+        {
+            sf::Vertex(sf::Vector2f(-outlineThickness,             top    - outlineThickness), color, sf::Vector2f(1, 1)),
+            sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)),
+            sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)),
+            sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)),
+            sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)),
+            sf::Vertex(sf::Vector2f(lineLength + outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1))
+        };
+
+        vertices.append(quad, 6);
     }
 
     // Add a glyph quad to the vertex array
-    void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italicShear, float outlineThickness = 0)
+    // (\a grow enlarges the quad and its texture rectangle, for the outlines computed by the shader)
+    void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italicShear, float outlineThickness = 0, float grow = 0)
     {
-        float padding = 1.0;
+        float padding = 1.0f + grow;
 
         float left   = glyph.bounds.left - padding;
         float top    = glyph.bounds.top - padding;
@@ -62,13 +79,31 @@ namespace
         float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
         float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height) + padding;
 
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u1, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u2, v2)));
+        const sf::Vertex quad[6] =
+        {
+            sf::Vertex(sf::Vector2f(position.x + left  - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u1, v1)),
+            sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)),
+            sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)),
+            sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)),
+            sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)),
+            sf::Vertex(sf::Vector2f(position.x + right - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u2, v2))
+        };
+
+        vertices.append(quad, 6);
     }
+
+    // Order the caret positions by line, for the binary searches of findCharacterAt
+    struct CompareLine
+    {
+        bool operator ()(const sf::Vector2f& position, float y) const {return position.y < y;}
+        bool operator ()(float y, const sf::Vector2f& position) const {return y < position.y;}
+    };
+
+    // Order the caret positions of a line by column
+    struct CompareColumn
+    {
+        bool operator ()(const sf::Vector2f& position, float x) const {return position.x < x;}
+    };
 }
 
 
@@ -85,11 +120,27 @@ m_style              (Regular),
 m_fillColor          (255, 255, 255),
 m_outlineColor       (0, 0, 0),
 m_outlineThickness   (0),
+m_outlineMode        (StrokedOutline),
 m_vertices           (Triangles),
 m_outlineVertices    (Triangles),
 m_bounds             (),
 m_geometryNeedUpdate (false),
-m_fontTextureId      (0)
+m_colorNeedUpdate    (false),
+m_layoutEnd          (0),
+m_pen                (),
+m_prevChar           (0),
+m_boundsMin          (),
+m_boundsMax          (),
+m_fontRevision       (0),
+m_static             (false),
+m_vertexBuffer       (Triangles, VertexBuffer::Static),
+m_bufferNeedUpdate   (false),
+m_wrapWidth          (0.f),
+m_wordSegments       (),
+m_lineBreaks         (),
+m_segmentsNeedUpdate (true),
+m_caretPositions     (),
+m_memory             (MemoryStats::TextGeometry)
 {
 
 }
@@ -106,11 +157,27 @@ m_style              (Regular),
 m_fillColor          (255, 255, 255),
 m_outlineColor       (0, 0, 0),
 m_outlineThickness   (0),
+m_outlineMode        (StrokedOutline),
 m_vertices           (Triangles),
 m_outlineVertices    (Triangles),
 m_bounds             (),
 m_geometryNeedUpdate (true),
-m_fontTextureId      (0)
+m_colorNeedUpdate    (false),
+m_layoutEnd          (0),
+m_pen                (),
+m_prevChar           (0),
+m_boundsMin          (),
+m_boundsMax          (),
+m_fontRevision       (0),
+m_static             (false),
+m_vertexBuffer       (Triangles, VertexBuffer::Static),
+m_bufferNeedUpdate   (false),
+m_wrapWidth          (0.f),
+m_wordSegments       (),
+m_lineBreaks         (),
+m_segmentsNeedUpdate (true),
+m_caretPositions     (),
+m_memory             (MemoryStats::TextGeometry)
 {
 
 }
@@ -121,12 +188,47 @@ void Text::setString(const String& string)
 {
     if (m_string != string)
     {
+        // Extending the current string only lays out the new characters
+        bool extended = (string.getSize() > m_string.getSize()) && std::equal(m_string.begin(), m_string.end(), string.begin());
+
         m_string = string;
-        m_geometryNeedUpdate = true;
+        m_segmentsNeedUpdate = true;
+        if (!extended)
+            m_geometryNeedUpdate = true;
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void Text::setString(String&& string)
+{
+    if (m_string != string)
+    {
+        bool extended = (string.getSize() > m_string.getSize()) && std::equal(m_string.begin(), m_string.end(), string.begin());
+
+        m_string = std::move(string);
+        m_segmentsNeedUpdate = true;
+        if (!extended)
+            m_geometryNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::setUtf8String(const char* data, std::size_t size)
+{
+    setString(String::fromUtf8(data, data + size));
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::appendString(const String& string)
+{
+    m_string += string;
+    m_segmentsNeedUpdate = true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Text::setFont(const Font& font)
 {
@@ -134,6 +236,7 @@ void Text::setFont(const Font& font)
     {
         m_font = &font;
         m_geometryNeedUpdate = true;
+        m_segmentsNeedUpdate = true;
     }
 }
 
@@ -145,6 +248,7 @@ void Text::setCharacterSize(unsigned int size)
     {
         m_characterSize = size;
         m_geometryNeedUpdate = true;
+        m_segmentsNeedUpdate = true;
     }
 }
 
@@ -156,6 +260,7 @@ void Text::setLetterSpacing(float spacingFactor)
     {
         m_letterSpacingFactor = spacingFactor;
         m_geometryNeedUpdate = true;
+        m_segmentsNeedUpdate = true;
     }
 }
 
@@ -178,6 +283,7 @@ void Text::setStyle(Uint32 style)
     {
         m_style = style;
         m_geometryNeedUpdate = true;
+        m_segmentsNeedUpdate = true;
     }
 }
 
@@ -196,13 +302,9 @@ void Text::setFillColor(const Color& color)
     {
         m_fillColor = color;
 
-        // Change vertex colors directly, no need to update whole geometry
-        // (if geometry is updated anyway, we can skip this step)
-        if (!m_geometryNeedUpdate)
-        {
-            for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
-                m_vertices[i].color = m_fillColor;
-        }
+        // Only the vertex colors change, they are rewritten at the next update
+        // (if geometry is updated anyway, it uses the new color)
+        m_colorNeedUpdate = true;
     }
 }
 
@@ -214,13 +316,9 @@ void Text::setOutlineColor(const Color& color)
     {
         m_outlineColor = color;
 
-        // Change vertex colors directly, no need to update whole geometry
-        // (if geometry is updated anyway, we can skip this step)
-        if (!m_geometryNeedUpdate)
-        {
-            for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
-                m_outlineVertices[i].color = m_outlineColor;
-        }
+        // Only the vertex colors change, they are rewritten at the next update
+        // (if geometry is updated anyway, it uses the new color)
+        m_colorNeedUpdate = true;
     }
 }
 
@@ -236,6 +334,44 @@ void Text::setOutlineThickness(float thickness)
 }
 
 
+////////////////////////////////////////////////////////////
+void Text::setOutlineMode(OutlineMode mode)
+{
+    if (mode != m_outlineMode)
+    {
+        m_outlineMode = mode;
+        m_geometryNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::setWrapWidth(float width)
+{
+    if (width != m_wrapWidth)
+    {
+        // The words keep their measures, only the line breaks change
+        m_wrapWidth = width;
+        m_geometryNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::setStatic(bool isStatic)
+{
+    if (isStatic != m_static)
+    {
+        m_static = isStatic;
+        m_bufferNeedUpdate = true;
+
+        // Release the video memory of texts that become dynamic
+        if (!m_static)
+            VertexBuffer(Triangles, VertexBuffer::Static).swap(m_vertexBuffer);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 const String& Text::getString() const
 {
@@ -306,6 +442,27 @@ float Text::getOutlineThickness() const
 }
 
 
+////////////////////////////////////////////////////////////
+Text::OutlineMode Text::getOutlineMode() const
+{
+    return m_outlineMode;
+}
+
+
+////////////////////////////////////////////////////////////
+float Text::getWrapWidth() const
+{
+    return m_wrapWidth;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Text::isStatic() const
+{
+    return m_static;
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2f Text::findCharacterPos(std::size_t index) const
 {
@@ -313,39 +470,13 @@ Vector2f Text::findCharacterPos(std::size_t index) const
     if (!m_font)
         return Vector2f();
 
-    // Adjust the index if it's out of range
-    if (index > m_string.getSize())
-        index = m_string.getSize();
-
-    // Precompute the variables needed by the algorithm
-    bool  isBold          = m_style & Bold;
-    float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
-    float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
-    whitespaceWidth      += letterSpacing;
-    float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
+    // The positions of the characters are recorded by the layout
+    ensureGeometryUpdate();
 
-    // Compute the position
+    // Adjust the index if it's out of range
     Vector2f position;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < index; ++i)
-    {
-        Uint32 curChar = m_string[i];
-
-        // Apply the kerning offset
-        position.x += m_font->getKerning(prevChar, curChar, m_characterSize);
-        prevChar = curChar;
-
-        // Handle special characters
-        switch (curChar)
-        {
-            case ' ':  position.x += whitespaceWidth;             continue;
-            case '\t': position.x += whitespaceWidth * 4;         continue;
-            case '\n': position.y += lineSpacing; position.x = 0; continue;
-        }
-
-        // For regular characters, add the advance offset of the glyph
-        position.x += m_font->getGlyph(curChar, m_characterSize, isBold).advance + letterSpacing;
-    }
+    if (!m_caretPositions.empty())
+        position = m_caretPositions[std::min(index, m_caretPositions.size() - 1)];
 
     // Transform the position to global coordinates
     position = getTransform().transformPoint(position);
@@ -354,6 +485,40 @@ Vector2f Text::findCharacterPos(std::size_t index) const
 }
 
 
+////////////////////////////////////////////////////////////
+std::size_t Text::findCharacterAt(Vector2f point) const
+{
+    if (!m_font)
+        return 0;
+
+    ensureGeometryUpdate();
+
+    if (m_caretPositions.empty())
+        return 0;
+
+    // Work in local coordinates, like the recorded positions
+    point = getInverseTransform().transformPoint(point);
+
+    // Find the line of the point: the positions go down line by line,
+    // and the points above the first line or below the last one go to it
+    typedef std::vector<Vector2f>::const_iterator Iterator;
+    Iterator begin = m_caretPositions.begin();
+    Iterator end   = m_caretPositions.end();
+    Iterator below = std::upper_bound(begin, end, point.y, CompareLine());
+    float lineTop  = (below == begin) ? begin->y : (below - 1)->y;
+    std::pair<Iterator, Iterator> line = std::equal_range(begin, end, lineTop, CompareLine());
+
+    // Then the closest position of the line
+    Iterator after = std::lower_bound(line.first, line.second, point.x, CompareColumn());
+    if (after == line.second)
+        --after;
+    else if ((after != line.first) && (point.x - (after - 1)->x < after->x - point.x))
+        --after;
+
+    return static_cast<std::size_t>(after - begin);
+}
+
+
 ////////////////////////////////////////////////////////////
 FloatRect Text::getLocalBounds() const
 {
@@ -366,7 +531,7 @@ FloatRect Text::getLocalBounds() const
 ////////////////////////////////////////////////////////////
 FloatRect Text::getGlobalBounds() const
 {
-    return getTransform().transformRect(getLocalBounds());
+    return getTransformedBounds(getLocalBounds());
 }
 
 
@@ -380,6 +545,47 @@ void Text::draw(RenderTarget& target, RenderStates states) const
         states.transform *= getTransform();
         states.texture = &m_font->getTexture(m_characterSize);
 
+        // The shader outline is drawn with the fill glyphs, only the lines of the styles have an outline geometry
+        if ((m_outlineMode == ShaderOutline) && (m_outlineThickness != 0))
+        {
+            if (m_outlineVertices.getVertexCount() > 0)
+                target.draw(m_outlineVertices, states);
+
+            if (m_vertices.getVertexCount() > 0)
+                target.drawOutlinedGlyphs(&m_vertices[0], m_vertices.getVertexCount(), m_outlineColor,
+                                          m_font->getShaderOutlineWidth(m_outlineThickness, m_characterSize), states);
+
+            return;
+        }
+
+        if (m_static)
+        {
+            // Upload the geometry only when it changed
+            std::size_t outlineCount = m_outlineVertices.getVertexCount();
+            std::size_t fillCount    = m_vertices.getVertexCount();
+            if (m_bufferNeedUpdate && (outlineCount + fillCount > 0))
+            {
+                if ((m_vertexBuffer.getVertexCount() == outlineCount + fillCount) || m_vertexBuffer.create(outlineCount + fillCount))
+                {
+                    if (outlineCount > 0)
+                        m_vertexBuffer.update(&m_outlineVertices[0], outlineCount, 0);
+                    if (fillCount > 0)
+                        m_vertexBuffer.update(&m_vertices[0], fillCount, static_cast<unsigned int>(outlineCount));
+                }
+
+                m_bufferNeedUpdate = false;
+            }
+
+            // Only draw the outline if there is something to draw
+            if ((m_outlineThickness != 0) && (outlineCount > 0))
+                target.draw(m_vertexBuffer, 0, outlineCount, states);
+
+            if (fillCount > 0)
+                target.draw(m_vertexBuffer, outlineCount, fillCount, states);
+
+            return;
+        }
+
         // Only draw the outline if there is something to draw
         if (m_outlineThickness != 0)
             target.draw(m_outlineVertices, states);
@@ -389,20 +595,64 @@ void Text::draw(RenderTarget& target, RenderStates states) const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Text::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Text::ensureGeometryUpdate() const
 {
+    SFML_TRACE_SCOPE("Text::ensureGeometryUpdate");
+
     if (!m_font)
         return;
 
-    // Do nothing, if geometry has not changed and the font texture has not changed
-    if (!m_geometryNeedUpdate && m_font->getTexture(m_characterSize).m_cacheId == m_fontTextureId)
+    // Add the glyphs loaded in the background, which changes the font texture
+    m_font->commitGlyphs(false);
+
+    // Rewrite the colors of the current geometry, if they changed since the last update
+    if (m_colorNeedUpdate)
+    {
+        m_vertices.setColor(m_fillColor);
+        m_outlineVertices.setColor(m_outlineColor);
+        m_colorNeedUpdate = false;
+        m_bufferNeedUpdate = true;
+    }
+
+    // Do nothing, if geometry has not changed and the glyphs of the font have not moved
+    // (the texture coordinates are in pixels, they stay valid when the font texture grows)
+    bool glyphsMoved = (m_font->m_revision != m_fontRevision);
+    if (!m_geometryNeedUpdate && !glyphsMoved && (m_layoutEnd == m_string.getSize()))
         return;
 
-    // Save the current fonts texture id
-    m_fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+    // The advances of the glyphs may have changed with them
+    if (glyphsMoved)
+        m_segmentsNeedUpdate = true;
+
+    // The geometry changes below, the vertex buffer of a static text is outdated
+    m_bufferNeedUpdate = true;
+
+    // Characters were only appended: lay out the new ones after the current geometry
+    // (the lines of the underlined and strike through styles span the last line, and the new
+    // characters may move the last word of a wrapped line to the next one, they are rebuilt)
+    if (!m_geometryNeedUpdate && !glyphsMoved && !(m_style & (Underlined | StrikeThrough)) && !(m_wrapWidth > 0))
+    {
+        layoutCharacters();
+
+        // The new glyphs must not have repacked the texture of the previous ones
+        if (m_font->m_revision == m_fontRevision)
+        {
+            updateMemoryUsage();
+            return;
+        }
+    }
 
     // Mark geometry as updated
+    m_font->countTextRebuild(!m_geometryNeedUpdate && (m_font->m_revision != m_fontRevision));
     m_geometryNeedUpdate = false;
 
     // Clear the previous geometry
@@ -410,10 +660,76 @@ void Text::ensureGeometryUpdate() const
     m_outlineVertices.clear();
     m_bounds = FloatRect();
 
+    // Start the layout from the first character
+    m_layoutEnd      = 0;
+    m_pen            = Vector2f(0.f, static_cast<float>(m_characterSize));
+    m_prevChar       = 0;
+    m_boundsMin      = Vector2f(static_cast<float>(m_characterSize), static_cast<float>(m_characterSize));
+    m_boundsMax      = Vector2f(0.f, 0.f);
+    m_fontRevision = m_font->m_revision;
+    m_caretPositions.clear();
+
     // No text: nothing to draw
     if (m_string.isEmpty())
+    {
+        updateMemoryUsage();
         return;
+    }
+
+    // Find where the lines are wrapped
+    if (m_wrapWidth > 0)
+        updateLineBreaks();
+    else
+        m_lineBreaks.clear();
+
+    layoutCharacters();
+
+    // If we're using the underlined style, add the last line
+    bool  isUnderlined       = (m_style & Underlined) != 0;
+    bool  isStrikeThrough    = (m_style & StrikeThrough) != 0;
+    float underlineOffset    = m_font->getUnderlinePosition(m_characterSize);
+    float underlineThickness = m_font->getUnderlineThickness(m_characterSize);
+    float x                  = m_pen.x;
+    float y                  = m_pen.y;
+    if (isUnderlined && (x > 0))
+    {
+        addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+
+        if (m_outlineThickness != 0)
+            addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
+    }
+
+    // If we're using the strike through style, add the last line across all characters
+    if (isStrikeThrough && (x > 0))
+    {
+        FloatRect xBounds = m_font->getGlyph(L'x', m_characterSize, (m_style & Bold) != 0).bounds;
+        float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
+
+        addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+
+        if (m_outlineThickness != 0)
+            addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
+    }
+
+    updateMemoryUsage();
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::updateMemoryUsage() const
+{
+    Uint64 bytes = (m_vertices.getCapacity() + m_outlineVertices.getCapacity()) * sizeof(Vertex)
+                 + m_wordSegments.capacity() * sizeof(WordSegment)
+                 + m_lineBreaks.capacity() * sizeof(Uint32)
+                 + m_caretPositions.capacity() * sizeof(Vector2f);
+
+    m_memory.update(bytes);
+}
+
 
+////////////////////////////////////////////////////////////
+void Text::layoutCharacters() const
+{
     // Compute values related to the text style
     bool  isBold             = (m_style & Bold) != 0;
     bool  isUnderlined       = (m_style & Underlined) != 0;
@@ -422,6 +738,12 @@ void Text::ensureGeometryUpdate() const
     float underlineOffset    = m_font->getUnderlinePosition(m_characterSize);
     float underlineThickness = m_font->getUnderlineThickness(m_characterSize);
 
+    // Shader outlines grow the fill quads instead of adding outline glyphs
+    // (distance field quads already cover the spread of the field)
+    bool  shaderOutline      = (m_outlineMode == ShaderOutline) && (m_outlineThickness != 0);
+    bool  glyphOutline       = (m_outlineThickness != 0) && !shaderOutline;
+    float outlineGrowth      = (shaderOutline && !m_font->useDistanceField()) ? m_font->getShaderOutlineWidth(m_outlineThickness, m_characterSize) : 0.f;
+
     // Compute the location of the strike through dynamically
     // We use the center point of the lowercase 'x' glyph as the reference
     // We reuse the underline thickness as the thickness of the strike through as well
@@ -433,25 +755,79 @@ void Text::ensureGeometryUpdate() const
     float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
     whitespaceWidth      += letterSpacing;
     float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
-    float x               = 0.f;
-    float y               = static_cast<float>(m_characterSize);
-
-    // Create one quad for each character
-    float minX = static_cast<float>(m_characterSize);
-    float minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+
+    // Continue from where the previous layout stopped
+    float x = m_pen.x;
+    float y = m_pen.y;
+    float minX = m_boundsMin.x;
+    float minY = m_boundsMin.y;
+    float maxX = m_boundsMax.x;
+    float maxY = m_boundsMax.y;
+    Uint32 prevChar = m_prevChar;
+
+    // Convert the characters to glyphs: a whole string is shaped once by the font and shared
+    // with the other texts showing it, appended characters are shaped on their own (and so are
+    // the strings laid out from several threads, which would replace each other in the cache)
+    priv::ShapedRun appended;
+    const priv::ShapedRun* run = &appended;
+    if ((m_layoutEnd == 0) && !m_font->isConcurrentLayoutEnabled())
+        run = &m_font->getShapedRun(m_string, m_characterSize, isBold);
+    else
+        priv::shapeString(*m_font, m_string, m_layoutEnd, m_characterSize, isBold, appended);
+
+    // Reserve the geometry of the run at once: a quad per glyph at most, plus the lines of the styles
+    std::size_t quadCount = run->glyphs.size();
+    if (isUnderlined || isStrikeThrough)
+    {
+        std::size_t lineCount = m_lineBreaks.size() + 1;
+        for (std::size_t i = 0; i < run->glyphs.size(); ++i)
+        {
+            if (m_string[run->glyphs[i].cluster] == L'\n')
+                ++lineCount;
+        }
+
+        quadCount += lineCount * ((isUnderlined && isStrikeThrough) ? 2 : 1);
+    }
+
+    reserveVertices(m_vertices, quadCount * 6);
+    if (glyphOutline)
+        reserveVertices(m_outlineVertices, quadCount * 6);
+
+    // Record the position of each character, whose top is at the top of its line
+    // (the end position of the previous layout is recorded again by this one)
+    float lineOffset = static_cast<float>(m_characterSize);
+    m_caretPositions.reserve(m_string.getSize() + 1);
+    m_caretPositions.resize(m_layoutEnd);
+
+    // Create one quad for each glyph
+    std::size_t nextBreak = 0;
+    bool skipWhitespace = false;
+    for (std::size_t i = 0; i < run->glyphs.size(); ++i)
     {
-        Uint32 curChar = m_string[i];
+        const priv::ShapedGlyph& shaped = run->glyphs[i];
+        Uint32 curChar = m_string[shaped.cluster];
+
+        // The characters that have no glyph (\r) share the position of the next one
+        m_caretPositions.resize(shaped.cluster + 1, Vector2f(x, y - lineOffset));
 
-        // Skip the \r char to avoid weird graphical issues
-        if (curChar == '\r')
+        // Wrap the line: the whitespace it is broken at becomes a new line, and the whitespace after it is dropped
+        if ((nextBreak < m_lineBreaks.size()) && (shaped.cluster == m_lineBreaks[nextBreak]))
+        {
+            curChar = L'\n';
+            skipWhitespace = true;
+            ++nextBreak;
+        }
+        else if (skipWhitespace && ((curChar == L' ') || (curChar == L'\t')))
+        {
             continue;
+        }
+        else
+        {
+            skipWhitespace = false;
+        }
 
         // Apply the kerning offset
-        x += m_font->getKerning(prevChar, curChar, m_characterSize);
+        x += shaped.offset;
 
         // If we're using the underlined style and there's a new line, draw a line
         if (isUnderlined && (curChar == L'\n' && prevChar != L'\n'))
@@ -496,9 +872,9 @@ void Text::ensureGeometryUpdate() const
         }
 
         // Apply the outline
-        if (m_outlineThickness != 0)
+        if (glyphOutline)
         {
-            const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, isBold, m_outlineThickness);
+            const Glyph& glyph = m_font->getGlyphByIndex(shaped.index, m_characterSize, isBold, m_outlineThickness);
 
             float left   = glyph.bounds.left;
             float top    = glyph.bounds.top;
@@ -516,69 +892,135 @@ void Text::ensureGeometryUpdate() const
         }
 
         // Extract the current glyph's description
-        const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, isBold);
+        const Glyph& glyph = m_font->getGlyphByIndex(shaped.index, m_characterSize, isBold);
 
         // Add the glyph to the vertices
-        addGlyphQuad(m_vertices, Vector2f(x, y), m_fillColor, glyph, italicShear);
+        addGlyphQuad(m_vertices, Vector2f(x, y), m_fillColor, glyph, italicShear, 0, outlineGrowth);
 
-        // Update the current bounds with the non outlined glyph bounds
-        if (m_outlineThickness == 0)
+        // Update the current bounds with the glyph bounds, grown by a shader outline
+        if (!glyphOutline)
         {
+            float outline = shaderOutline ? std::abs(m_outlineThickness) : 0.f;
             float left   = glyph.bounds.left;
             float top    = glyph.bounds.top;
             float right  = glyph.bounds.left + glyph.bounds.width;
             float bottom = glyph.bounds.top  + glyph.bounds.height;
 
-            minX = std::min(minX, x + left  - italicShear * bottom);
-            maxX = std::max(maxX, x + right - italicShear * top);
-            minY = std::min(minY, y + top);
-            maxY = std::max(maxY, y + bottom);
+            minX = std::min(minX, x + left   - italicShear * bottom - outline);
+            maxX = std::max(maxX, x + right  - italicShear * top    + outline);
+            minY = std::min(minY, y + top    - outline);
+            maxY = std::max(maxY, y + bottom + outline);
         }
 
         // Advance to the next character
-        x += glyph.advance + letterSpacing;
-    }
-
-    // If we're using the underlined style, add the last line
-    if (isUnderlined && (x > 0))
-    {
-        addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
-
-        if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
+        x += shaped.advance + letterSpacing;
     }
 
-    // If we're using the strike through style, add the last line across all characters
-    if (isStrikeThrough && (x > 0))
-    {
-        addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+    // The end of the string is a position too, for the caret
+    m_caretPositions.resize(m_string.getSize() + 1, Vector2f(x, y - lineOffset));
 
-        if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
-    }
+    // Save the state of the layout, for the characters appended later
+    m_layoutEnd = m_string.getSize();
+    m_pen       = Vector2f(x, y);
+    m_prevChar  = prevChar;
+    m_boundsMin = Vector2f(minX, minY);
+    m_boundsMax = Vector2f(maxX, maxY);
 
     // Update the bounding rectangle
     m_bounds.left = minX;
     m_bounds.top = minY;
     m_bounds.width = maxX - minX;
     m_bounds.height = maxY - minY;
+}
 
-    // normalize tex coords to 0.0..1.0 range
-    const sf::Texture& texture = m_font->getTexture(m_characterSize);
-    float nx = (1.0f / texture.getSize().x);
-    float ny = (1.0f / texture.getSize().y);
 
-    for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
+////////////////////////////////////////////////////////////
+void Text::updateLineBreaks() const
+{
+    // Measure the words of the string, unless it didn't change
+    if (m_segmentsNeedUpdate)
     {
-        m_vertices[i].texCoords.x *= nx;
-        m_vertices[i].texCoords.y *= ny;
-    };
+        bool  isBold          = (m_style & Bold) != 0;
+        float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
+        float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
+        whitespaceWidth      += letterSpacing;
+
+        // Texts laid out from several threads can't share the shaped strings of the font
+        priv::ShapedRun own;
+        bool concurrent = m_font->isConcurrentLayoutEnabled();
+        if (concurrent)
+            priv::shapeString(*m_font, m_string, 0, m_characterSize, isBold, own);
+
+        const priv::ShapedRun& run = concurrent ? own : m_font->getShapedRun(m_string, m_characterSize, isBold);
+
+        m_wordSegments.clear();
+        const WordSegment empty = {static_cast<Uint32>(m_string.getSize()), 0.f, 0.f, false};
+        WordSegment segment = empty;
+        bool inWhitespace = false;
+        for (std::size_t i = 0; i < run.glyphs.size(); ++i)
+        {
+            const priv::ShapedGlyph& shaped = run.glyphs[i];
+            Uint32 curChar = m_string[shaped.cluster];
+
+            if ((curChar == L' ') || (curChar == L'\t') || (curChar == L'\n'))
+            {
+                if (!inWhitespace)
+                {
+                    segment.whitespace = shaped.cluster;
+                    inWhitespace = true;
+                }
+
+                segment.spacing += shaped.offset + ((curChar == L'\t') ? whitespaceWidth * 4 : (curChar == L' ') ? whitespaceWidth : 0.f);
+
+                // A new line ends the segment, the whitespace after it starts the next line
+                if (curChar == L'\n')
+                {
+                    segment.newLine = true;
+                    m_wordSegments.push_back(segment);
+                    segment = empty;
+                    inWhitespace = false;
+                }
+            }
+            else
+            {
+                // The first character after whitespace starts a new word
+                if (inWhitespace)
+                {
+                    m_wordSegments.push_back(segment);
+                    segment = empty;
+                    inWhitespace = false;
+                }
+
+                segment.width += shaped.offset + shaped.advance + letterSpacing;
+            }
+        }
+
+        m_wordSegments.push_back(segment);
+        m_segmentsNeedUpdate = false;
+    }
 
-    for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
+    // Break the lines greedily, before the first word that doesn't fit
+    // (a line always keeps its first word, even if it is too long)
+    m_lineBreaks.clear();
+    float lineWidth = 0.f;
+    bool  lineHasWord = false;
+    for (std::size_t i = 0; i < m_wordSegments.size(); ++i)
     {
-        m_outlineVertices[i].texCoords.x *= nx;
-        m_outlineVertices[i].texCoords.y *= ny;
-    };
+        const WordSegment& segment = m_wordSegments[i];
+        if (lineHasWord && (segment.width > 0.f) && (lineWidth + segment.width > m_wrapWidth))
+        {
+            m_lineBreaks.push_back(m_wordSegments[i - 1].whitespace);
+            lineWidth = 0.f;
+        }
+
+        lineWidth  += segment.width + segment.spacing;
+        lineHasWord = lineHasWord || (segment.width > 0.f);
+        if (segment.newLine)
+        {
+            lineWidth   = 0.f;
+            lineHasWord = false;
+        }
+    }
 }
 
 } // namespace sf
@@ -0,0 +1,438 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextBatch.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Number of times the changed strings are laid out again when laying them out loads new glyphs
+    const int maxUpdatePasses = 4;
+
+    // Transform the vertices of a layout into the vertices of the batch
+    bool transformVertices(const sf::VertexArray& source, const sf::Transform& transform, std::vector<sf::Vertex>& destination)
+    {
+        bool resized = (destination.size() != source.getVertexCount());
+        destination.resize(source.getVertexCount());
+
+        for (std::size_t i = 0; i < destination.size(); ++i)
+        {
+            destination[i] = source[i];
+            destination[i].position = transform.transformPoint(source[i].position);
+        }
+
+        return resized;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextBatch::TextBatch() :
+m_font            (NULL),
+m_characterSize   (30),
+m_style           (Text::Regular),
+m_outlineColor    (0, 0, 0),
+m_outlineThickness(0),
+m_outlineMode     (Text::StrokedOutline),
+m_entries         (),
+m_fill            (),
+m_outline         (),
+m_buffer          (Triangles, VertexBuffer::Static),
+m_bufferValid     (false),
+m_needUpdate      (true),
+m_revision        (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextBatch::TextBatch(const Font& font, unsigned int characterSize) :
+m_font            (&font),
+m_characterSize   (characterSize),
+m_style           (Text::Regular),
+m_outlineColor    (0, 0, 0),
+m_outlineThickness(0),
+m_outlineMode     (Text::StrokedOutline),
+m_entries         (),
+m_fill            (),
+m_outline         (),
+m_buffer          (Triangles, VertexBuffer::Static),
+m_bufferValid     (false),
+m_needUpdate      (true),
+m_revision        (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setFont(const Font& font)
+{
+    if (m_font != &font)
+    {
+        m_font = &font;
+        configureAll();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Font* TextBatch::getFont() const
+{
+    return m_font;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setCharacterSize(unsigned int size)
+{
+    if (m_characterSize != size)
+    {
+        m_characterSize = size;
+        configureAll();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextBatch::getCharacterSize() const
+{
+    return m_characterSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setStyle(Uint32 style)
+{
+    if (m_style != style)
+    {
+        m_style = style;
+        configureAll();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 TextBatch::getStyle() const
+{
+    return m_style;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setOutline(const Color& color, float thickness, Text::OutlineMode mode)
+{
+    if ((m_outlineColor != color) || (m_outlineThickness != thickness) || (m_outlineMode != mode))
+    {
+        m_outlineColor     = color;
+        m_outlineThickness = thickness;
+        m_outlineMode      = mode;
+        configureAll();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& TextBatch::getOutlineColor() const
+{
+    return m_outlineColor;
+}
+
+
+////////////////////////////////////////////////////////////
+float TextBatch::getOutlineThickness() const
+{
+    return m_outlineThickness;
+}
+
+
+////////////////////////////////////////////////////////////
+Text::OutlineMode TextBatch::getOutlineMode() const
+{
+    return m_outlineMode;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextBatch::add(const String& string, const Transform& transform, const Color& color)
+{
+    // New strings go at the end of the batch
+    Entry entry;
+    entry.fillOffset    = m_fill.size();
+    entry.outlineOffset = m_outline.size();
+    entry.revision      = 0;
+    configure(entry.text);
+
+    m_entries.push_back(entry);
+    set(m_entries.size() - 1, string, transform, color);
+
+    return m_entries.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::set(std::size_t index, const String& string, const Transform& transform, const Color& color)
+{
+    Entry& entry = m_entries[index];
+    entry.text.setString(string);
+    entry.text.setFillColor(color);
+    entry.transform  = transform;
+    entry.needUpdate = true;
+    m_needUpdate     = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::setTransform(std::size_t index, const Transform& transform)
+{
+    // The layout of the string doesn't change, ensureGeometryUpdate keeps it
+    Entry& entry = m_entries[index];
+    entry.transform  = transform;
+    entry.needUpdate = true;
+    m_needUpdate     = true;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TextBatch::getBounds(std::size_t index) const
+{
+    const Entry& entry = m_entries[index];
+    return entry.transform.transformRect(entry.text.getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::clear()
+{
+    m_entries.clear();
+    m_fill.clear();
+    m_outline.clear();
+    m_bufferValid = false;
+    m_needUpdate  = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::reserve(std::size_t count)
+{
+    m_entries.reserve(count);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextBatch::getSize() const
+{
+    return m_entries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_font)
+        return;
+
+    update();
+
+    if (m_fill.empty() && m_outline.empty())
+        return;
+
+    states.texture = &m_font->getTexture(m_characterSize);
+
+    std::size_t outlineCount = m_outline.size();
+    std::size_t fillCount    = m_fill.size();
+
+    // Upload the whole batch if its size changed, update() uploads the changed strings otherwise
+    if (!m_bufferValid)
+    {
+        if ((m_buffer.getVertexCount() == outlineCount + fillCount) || m_buffer.create(outlineCount + fillCount))
+        {
+            if (outlineCount > 0)
+                m_buffer.update(&m_outline[0], outlineCount, 0);
+            if (fillCount > 0)
+                m_buffer.update(&m_fill[0], fillCount, static_cast<unsigned int>(outlineCount));
+
+            m_bufferValid = true;
+        }
+    }
+
+    // The shader outline is drawn with the fill glyphs, only the lines of the styles have an outline geometry
+    if ((m_outlineMode == Text::ShaderOutline) && (m_outlineThickness != 0))
+    {
+        if (outlineCount > 0)
+        {
+            if (m_bufferValid)
+                target.draw(m_buffer, 0, outlineCount, states);
+            else
+                target.draw(&m_outline[0], outlineCount, Triangles, states);
+        }
+
+        if (fillCount > 0)
+            target.drawOutlinedGlyphs(&m_fill[0], fillCount, m_outlineColor,
+                                      m_font->getShaderOutlineWidth(m_outlineThickness, m_characterSize), states);
+
+        return;
+    }
+
+    if (m_bufferValid)
+    {
+        if ((m_outlineThickness != 0) && (outlineCount > 0))
+            target.draw(m_buffer, 0, outlineCount, states);
+
+        if (fillCount > 0)
+            target.draw(m_buffer, outlineCount, fillCount, states);
+
+        return;
+    }
+
+    if ((m_outlineThickness != 0) && (outlineCount > 0))
+        target.draw(&m_outline[0], outlineCount, Triangles, states);
+
+    if (fillCount > 0)
+        target.draw(&m_fill[0], fillCount, Triangles, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::configure(Text& text) const
+{
+    if (m_font)
+        text.setFont(*m_font);
+
+    text.setCharacterSize(m_characterSize);
+    text.setStyle(m_style);
+    text.setOutlineColor(m_outlineColor);
+    text.setOutlineThickness(m_outlineThickness);
+    text.setOutlineMode(m_outlineMode);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::configureAll()
+{
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        configure(it->text);
+        it->needUpdate = true;
+    }
+
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::update() const
+{
+    // Add the glyphs loaded in the background, which changes the font texture
+    m_font->commitGlyphs(false);
+
+    if (!m_needUpdate && (m_font->m_revision == m_revision))
+        return;
+
+    // Lay out the changed strings, and the strings whose glyphs moved in the font texture;
+    // laying out a string may load new glyphs and move the glyphs of the strings already
+    // laid out, they are laid out again in the next pass
+    bool        resized      = false;
+    std::size_t firstChanged = m_entries.size();
+    std::size_t lastChanged  = 0;
+    for (int pass = 0; pass < maxUpdatePasses; ++pass)
+    {
+        Uint64 revision = m_font->m_revision;
+
+        for (std::size_t i = 0; i < m_entries.size(); ++i)
+        {
+            Entry& entry = m_entries[i];
+            if (!entry.needUpdate && (entry.revision == revision))
+                continue;
+
+            entry.text.ensureGeometryUpdate();
+            resized |= transformVertices(entry.text.m_vertices, entry.transform, entry.fill);
+            resized |= transformVertices(entry.text.m_outlineVertices, entry.transform, entry.outline);
+            entry.revision   = entry.text.m_fontRevision;
+            entry.needUpdate = false;
+
+            firstChanged = std::min(firstChanged, i);
+            lastChanged  = std::max(lastChanged, i);
+        }
+
+        if (m_font->m_revision == revision)
+            break;
+    }
+
+    m_needUpdate = false;
+    m_revision   = m_font->m_revision;
+
+    if (firstChanged > lastChanged)
+        return;
+
+    // A string changed its number of vertices: the strings after it move in the batch
+    if (resized || (m_fill.empty() && m_outline.empty()))
+    {
+        m_fill.clear();
+        m_outline.clear();
+        for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            it->fillOffset    = m_fill.size();
+            it->outlineOffset = m_outline.size();
+            m_fill.insert(m_fill.end(), it->fill.begin(), it->fill.end());
+            m_outline.insert(m_outline.end(), it->outline.begin(), it->outline.end());
+        }
+
+        m_bufferValid = false;
+        return;
+    }
+
+    // Otherwise only copy the range of the changed strings
+    for (std::size_t i = firstChanged; i <= lastChanged; ++i)
+    {
+        const Entry& entry = m_entries[i];
+        std::copy(entry.fill.begin(), entry.fill.end(), m_fill.begin() + entry.fillOffset);
+        std::copy(entry.outline.begin(), entry.outline.end(), m_outline.begin() + entry.outlineOffset);
+    }
+
+    if (m_bufferValid)
+    {
+        const Entry& first = m_entries[firstChanged];
+        const Entry& last  = m_entries[lastChanged];
+
+        std::size_t outlineBegin = first.outlineOffset;
+        std::size_t outlineEnd   = last.outlineOffset + last.outline.size();
+        if (outlineEnd > outlineBegin)
+            m_buffer.update(&m_outline[outlineBegin], outlineEnd - outlineBegin, static_cast<unsigned int>(outlineBegin));
+
+        std::size_t fillBegin = first.fillOffset;
+        std::size_t fillEnd   = last.fillOffset + last.fill.size();
+        if (fillEnd > fillBegin)
+            m_buffer.update(&m_fill[fillBegin], fillEnd - fillBegin, static_cast<unsigned int>(m_outline.size() + fillBegin));
+    }
+}
+
+} // namespace sf
@@ -26,50 +26,395 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/AssetBundle.hpp>
+#include <SFML/Graphics/AssetBundleFormat.hpp>
+#include <SFML/Graphics/BrowserImageDecoder.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/CompressedImage.hpp>
+#include <SFML/Graphics/ContextRestore.hpp>
+#include <SFML/Graphics/DynamicAtlas.hpp>
+#include <SFML/Graphics/FrameArena.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/QoiCodec.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Graphics/TexturePool.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/Graphics/RenderTextureImpl.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Trace.hpp>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
+#include <map>
+#include <vector>
 
 
 namespace
 {
-    sf::Mutex idMutex;
     sf::Mutex maximumSizeMutex;
 
-    // Thread-safe unique identifier generator,
-    // is used for states cache (see RenderTarget)
+    // Start at 1, zero is "no texture"
+    std::atomic<sf::Uint64> nextId(1);
+
+    // Thread-safe unique identifier generator, lock-free since
+    // every pixel upload takes a new content identifier
     sf::Uint64 getUniqueId()
     {
-        sf::Lock lock(idMutex);
+        return nextId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Pixel buffer of an asynchronous texture update, reused once its fence is signaled
+    struct PixelUpload
+    {
+        GLuint     buffer;
+        GLsizeiptr capacity;
+        GLsync     fence;
+        sf::Uint64 token;
+    };
+
+    std::vector<PixelUpload> pendingUploads; // in submission order
+    std::vector<PixelUpload> freeUploads;
+    sf::Uint64 lastUploadToken = 0;
+    sf::Uint64 completedUploadToken = 0; // every token up to this one has completed
+
+    const std::size_t maxFreeUploads = 4;
+
+    // Bytes of lazy textures that can be uploaded per frame, and the bytes already
+    // uploaded in the frame lazyUploadFrame (lazy uploads happen on the drawing thread)
+    sf::Uint64 lazyUploadBudget = 0;
+    unsigned int dynamicAtlasThreshold = 0;
+    sf::Uint64 lazyUploadFrame = 0;
+    sf::Uint64 lazyUploadSpent = 0;
+
+    // Streamed textures drawn with more detail than they have, refined at the next frame
+    std::vector<const sf::Texture*> streamingRequests;
+
+    // Streamed textures first show the largest mip level that fits in this size
+    const unsigned int streamingPlaceholderSize = 64;
+
+    // Upload rule shared by the first uploads and the refinements: the first
+    // upload of a frame always goes through, so that textures larger than the budget show up too
+    bool reserveLazyUpload(sf::Uint64 bytes)
+    {
+        if (lazyUploadBudget && lazyUploadSpent && (lazyUploadSpent + bytes > lazyUploadBudget))
+            return false;
+
+        lazyUploadSpent += bytes;
+        return true;
+    }
+
+    // 1x1 transparent texture sampled instead of the lazy textures that wait for their upload
+    GLuint transparentTexture = 0;
+
+    GLuint getTransparentTexture()
+    {
+        GLuint& texture = transparentTexture;
+        if (!texture)
+        {
+            sf::priv::TextureSaver save;
+
+            const sf::Uint8 pixel[4] = {0, 0, 0, 0};
+            glCheck(glGenTextures(1, &texture));
+            sf::priv::getGLStateCache().bindTexture(texture);
+            glCheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixel));
+            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
+        }
+
+        return texture;
+    }
+
+#if defined(SFML_OPENGL_ES)
+    // OpenGL ES 2 has a single frame buffer binding
+    const GLenum copyReadTarget = GL_FRAMEBUFFER;
+#else
+    const GLenum copyReadTarget = GL_READ_FRAMEBUFFER;
+#endif
+
+    // Frame buffers with a texture attached, used by the copies and the read-backs;
+    // kept in least recently used order and released when their texture is destroyed.
+    // Frame buffers are not shared between contexts, so each context has its own list
+    struct CopyFramebuffer
+    {
+        GLuint texture;     // 0 once the texture is destroyed from another context
+        GLuint framebuffer;
+    };
+
+    typedef std::vector<CopyFramebuffer> CopyFramebufferList;
+
+    sf::Mutex copyFramebufferMutex;
+    std::map<void*, CopyFramebufferList> copyFramebuffers;
+
+    const std::size_t maxCopyFramebuffers = 8;
+
+    // Get the frame buffer that has the texture attached, or 0 if it can't be created
+    GLuint getCopyFramebuffer(GLuint texture)
+    {
+        sf::Lock lock(copyFramebufferMutex);
+
+        CopyFramebufferList& list = copyFramebuffers[sf::priv::getCurrentContext()];
+        sf::priv::GLStateCache& cache = sf::priv::getGLStateCache();
+
+        for (std::size_t i = 0; i < list.size();)
+        {
+            if (list[i].texture == texture)
+            {
+                CopyFramebuffer entry = list[i];
+                list.erase(list.begin() + i);
+                list.push_back(entry);
+                return entry.framebuffer;
+            }
+
+            // The texture was destroyed while another context was current
+            if (list[i].texture == 0)
+            {
+                cache.deleteFramebuffer(list[i].framebuffer);
+                list.erase(list.begin() + i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        if (list.size() >= maxCopyFramebuffers)
+        {
+            cache.deleteFramebuffer(list.front().framebuffer);
+            list.erase(list.begin());
+        }
+
+        GLuint framebuffer = 0;
+        glCheck(glGenFramebuffers(1, &framebuffer));
+        if (!framebuffer)
+        {
+            sf::err() << "Failed to create a frame buffer object to copy the texture" << std::endl;
+            return 0;
+        }
+
+        // The completeness of the attachment is only checked once
+        GLuint previous = cache.getFramebuffer(copyReadTarget);
+        cache.bindFramebuffer(copyReadTarget, framebuffer);
+        glCheck(glFramebufferTexture2D(copyReadTarget, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0));
+
+        GLenum status;
+        glCheck(status = glCheckFramebufferStatus(copyReadTarget));
+        cache.bindFramebuffer(copyReadTarget, previous);
+
+        if (status != GL_FRAMEBUFFER_COMPLETE)
+        {
+            cache.deleteFramebuffer(framebuffer);
+            return 0;
+        }
+
+        CopyFramebuffer entry = {texture, framebuffer};
+        list.push_back(entry);
+        return framebuffer;
+    }
+
+    // Forget the frame buffers of a texture that is about to be destroyed; those of
+    // other contexts can't be deleted now, they are deleted by their context later
+    void releaseCopyFramebuffer(GLuint texture)
+    {
+        sf::Lock lock(copyFramebufferMutex);
+
+        void* context = sf::priv::getCurrentContext();
+        for (std::map<void*, CopyFramebufferList>::iterator it = copyFramebuffers.begin(); it != copyFramebuffers.end(); ++it)
+        {
+            CopyFramebufferList& list = it->second;
+            for (std::size_t i = 0; i < list.size(); ++i)
+            {
+                if (list[i].texture != texture)
+                    continue;
+
+                if (it->first == context)
+                {
+                    sf::priv::getGLStateCache().deleteFramebuffer(list[i].framebuffer);
+                    list.erase(list.begin() + i);
+                }
+                else
+                {
+                    list[i].texture = 0;
+                }
+
+                break;
+            }
+        }
+    }
+
+    // Destroy the OpenGL texture of a sf::Texture, or give it to the pool
+    void destroyTexture(GLuint texture, const sf::Vector2u& size, unsigned int format)
+    {
+        releaseCopyFramebuffer(texture);
+
+        if (!sf::priv::releasePooledTexture(texture, size, format))
+            sf::priv::getGLStateCache().deleteTexture(texture);
+    }
+
+    // Sub-rectangles of client memory can be uploaded directly (GL_UNPACK_ROW_LENGTH)
+    bool isUnpackRowLengthAvailable()
+    {
+        return sf::priv::getGraphicsCaps().unpackRowLength;
+    }
+
+    // Red textures (GL_R8) stay color-renderable, so they can be copied like RGBA ones
+    bool isSingleChannelAvailable()
+    {
+#if defined(SFML_OPENGL_ES)
+        return (GLAD_GL_ES_VERSION_3_0 > 0) || (GLAD_GL_EXT_texture_rg > 0);
+#else
+        return (GLAD_GL_VERSION_3_0 > 0) || (GLAD_GL_ARB_texture_rg > 0);
+#endif
+    }
+
+    // Half-float textures are only useful if they can be rendered to
+    bool isHalfFloatAvailable()
+    {
+#if defined(SFML_OPENGL_ES)
+        return ((GLAD_GL_ES_VERSION_3_0 > 0) || (GLAD_GL_OES_texture_half_float > 0)) &&
+               ((GLAD_GL_EXT_color_buffer_half_float > 0) || (GLAD_GL_EXT_color_buffer_float > 0));
+#else
+        return (GLAD_GL_VERSION_3_0 > 0) || (GLAD_GL_ARB_texture_float > 0);
+#endif
+    }
+
+    // Size of a pixel in the storage of a texture
+    unsigned int getBytesPerPixel(sf::Texture::Format format)
+    {
+        switch (format)
+        {
+            case sf::Texture::R8:       return 1;
+            case sf::Texture::RGB565:
+            case sf::Texture::RGBA4444: return 2;
+            case sf::Texture::RGBA16F:  return 8;
+            default:                    return 4;
+        }
+    }
+
+#if defined(SFML_OPENGL_ES)
+    // Convert a normalized 8-bit value to a half-float (only the normal range is needed)
+    sf::Uint16 byteToHalf(sf::Uint8 value)
+    {
+        if (value == 0)
+            return 0;
+
+        float normalized = value / 255.f;
+        sf::Uint32 bits;
+        std::memcpy(&bits, &normalized, sizeof(bits));
+
+        sf::Uint32 exponent = ((bits >> 23) & 0xFF) - 127 + 15;
+        sf::Uint32 mantissa = (bits & 0x7FFFFF) + 0x1000; // round to nearest
+
+        if (mantissa & 0x800000)
+        {
+            mantissa = 0;
+            ++exponent;
+        }
+
+        return static_cast<sf::Uint16>((exponent << 10) | (mantissa >> 13));
+    }
+#endif
+
+    bool isAsyncUploadAvailable()
+    {
+        const sf::GraphicsCaps& caps = sf::priv::getGraphicsCaps();
+        return caps.mapBufferRange && caps.fenceSync;
+    }
+
+    // Recycle the buffers of the transfers that have completed, without blocking
+    void reclaimUploads()
+    {
+        std::size_t completed = 0;
+        while (completed < pendingUploads.size())
+        {
+            PixelUpload& upload = pendingUploads[completed];
+
+            GLenum status;
+            glCheck(status = glClientWaitSync(upload.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0));
+            if ((status != GL_ALREADY_SIGNALED) && (status != GL_CONDITION_SATISFIED))
+                break;
+
+            glCheck(glDeleteSync(upload.fence));
+            upload.fence = 0;
+            completedUploadToken = upload.token;
 
-        static sf::Uint64 id = 1; // start at 1, zero is "no texture"
+            if (freeUploads.size() < maxFreeUploads)
+                freeUploads.push_back(upload);
+            else
+                sf::priv::getGLStateCache().deleteBuffer(upload.buffer);
+
+            ++completed;
+        }
 
-        return id++;
+        pendingUploads.erase(pendingUploads.begin(), pendingUploads.begin() + completed);
     }
 }
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+struct Texture::LazySource
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Size of the upload of the levels from \a level to the smallest
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getUploadSize(unsigned int level) const
+    {
+        Uint64 bytes = 0;
+        for (std::size_t i = level; i < levelBytes.size(); ++i)
+            bytes += levelBytes[i];
+        return bytes;
+    }
+
+    Image               image;         ///< Pixels of the texture, when loaded from an image
+    const AssetBundle*  bundle;        ///< Bundle containing the texture, when loaded from a bundle
+    std::string         name;          ///< Name of the bundle entry
+    Vector2u            size;          ///< Size of the largest level, in pixels
+    std::vector<Uint64> levelBytes;    ///< Size of each mip level, counted against the per-frame budget
+    bool                streamed;      ///< Are the levels uploaded according to the on-screen size?
+    unsigned int        residentLevel; ///< Largest level uploaded (levelBytes.size() when not resident)
+    unsigned int        wantedLevel;   ///< Largest level displayed by the draws of wantedFrame
+    Uint64              wantedFrame;   ///< Frame of the last detail request
+    float               footprint;     ///< Largest on-screen area of the draws of wantedFrame, in pixels
+    bool                queued;        ///< Is the texture in the refinement requests?
+};
+
+
 ////////////////////////////////////////////////////////////
 Texture::Texture() :
 m_size         (0, 0),
 m_actualSize   (0, 0),
 m_texture      (0),
+m_storageFormat(0),
 m_isSmooth     (false),
 m_sRgb         (false),
+m_premultiplied(false),
 m_isRepeated   (false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_minFilter    (0),
+m_distanceField(false),
+m_opaque       (false),
+m_format       (RGBA8),
+m_texCoordType (Normalized),
+m_storageId    (getUniqueId()),
+m_contentId    (m_storageId),
+m_memoryUsage  (0),
+m_lastUsedFrame(0),
+m_resolver     (NULL),
+m_lazySource   (NULL)
 {
-    
+    priv::registerRestorable(priv::RestorableTexture, this);
 }
 
 
@@ -78,17 +423,31 @@ Texture::Texture(const Texture& copy) :
 m_size         (0, 0),
 m_actualSize   (0, 0),
 m_texture      (0),
+m_storageFormat(0),
 m_isSmooth     (copy.m_isSmooth),
 m_sRgb         (copy.m_sRgb),
+m_premultiplied(copy.m_premultiplied),
 m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_minFilter    (0),
+m_distanceField(copy.m_distanceField),
+m_opaque       (false),
+m_format       (RGBA8),
+m_texCoordType (copy.m_texCoordType),
+m_storageId    (getUniqueId()),
+m_contentId    (m_storageId),
+m_memoryUsage  (0),
+m_lastUsedFrame(0),
+m_resolver     (NULL),
+m_lazySource   (NULL)
 {
+    priv::registerRestorable(priv::RestorableTexture, this);
+
     if (copy.m_texture)
     {
-        if (create(copy.getSize().x, copy.getSize().y))
+        if (createStorage(copy.getSize().x, copy.getSize().y, copy.m_format))
         {
             update(copy);
 
@@ -101,23 +460,72 @@ m_cacheId      (getUniqueId())
             err() << "Failed to copy texture, failed to create new texture" << std::endl;
         }
     }
+
+    // A lazy copy is uploaded on its first draw too
+    if (copy.m_lazySource)
+    {
+        // Copying the storage made the source fully resident
+        m_lazySource = new LazySource(*copy.m_lazySource);
+        m_lazySource->queued = false;
+        if (!m_texture)
+        {
+            m_lazySource->residentLevel = static_cast<unsigned int>(m_lazySource->levelBytes.size());
+            m_size       = copy.m_size;
+            m_actualSize = copy.m_size;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Texture::Texture(Texture&& right) noexcept :
+Texture()
+{
+    swap(right);
 }
 
 
 ////////////////////////////////////////////////////////////
 Texture::~Texture()
 {
+    priv::unregisterRestorable(priv::RestorableTexture, this);
+
     // Destroy the OpenGL texture
     if (m_texture)
     {
-        GLuint texture = static_cast<GLuint>(m_texture);
-        glCheck(glDeleteTextures(1, &texture));
+        priv::flushPendingDraws(this);
+
+        destroyTexture(static_cast<GLuint>(m_texture), m_actualSize, m_storageFormat);
     }
+
+    priv::releaseAtlasEntry(*this);
+    setMemoryUsage(0);
+    discardLazySource();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Texture::create(unsigned int width, unsigned int height)
+{
+    return createStorage(width, height, RGBA8);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::create(unsigned int width, unsigned int height, Format format)
+{
+    if (!isFormatAvailable(format))
+    {
+        err() << "Failed to create texture, its format is not supported by the driver" << std::endl;
+        return false;
+    }
+
+    return createStorage(width, height, format);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::createStorage(unsigned int width, unsigned int height, Format format)
 {
     // Check if texture parameters are valid before creating it
     if ((width == 0) || (height == 0))
@@ -145,23 +553,21 @@ bool Texture::create(unsigned int width, unsigned int height)
         return false;
     }
 
+    // Pending draws still refer to the previous contents
+    priv::flushPendingDraws(this);
+    discardLazySource();
+
+    // Remember the current storage, create may be able to reuse it
+    Vector2u previousSize = m_actualSize;
+    unsigned int previousFormat = m_storageFormat;
+
     // All the validity checks passed, we can store the new texture settings
     m_size.x        = width;
     m_size.y        = height;
     m_actualSize    = actualSize;
     m_pixelsFlipped = false;
     m_fboAttachment = false;
-
-    // Create the OpenGL texture if it doesn't exist yet
-    if (!m_texture)
-    {
-        GLuint texture;
-        glCheck(glGenTextures(1, &texture));
-        m_texture = static_cast<unsigned int>(texture);
-    }
-
-    // Make sure that the current texture binding will be preserved
-    priv::TextureSaver save;
+    m_format        = ((format == R8) && !isSingleChannelAvailable()) ? RGBA8 : format;
 
     static bool textureEdgeClamp = true;
 
@@ -200,17 +606,93 @@ bool Texture::create(unsigned int width, unsigned int height)
         m_sRgb = false;
     }
 
+    // The contents of a new texture are undefined, so a storage of the same size and format
+    // can be reused as is: either the current one, or one from the texture pool
+    unsigned int storageFormat = (m_format == R8) ? GL_R8 : ((m_format == RGBA16F) ? GL_RGBA16F : (m_sRgb ? GL_SRGB8_ALPHA8 : GL_RGBA));
+    if ((m_format == RGB565) || (m_format == RGBA4444))
+        storageFormat = (m_format == RGB565) ? GL_RGB565 : GL_RGBA4;
+    bool reuseStorage = m_texture && (previousFormat == storageFormat) && (previousSize == m_actualSize);
+    if (!reuseStorage)
+    {
+        unsigned int pooled = priv::acquirePooledTexture(m_actualSize, storageFormat);
+        if (pooled)
+        {
+            if (m_texture)
+                destroyTexture(static_cast<GLuint>(m_texture), previousSize, previousFormat);
+
+            m_texture = pooled;
+            reuseStorage = true;
+        }
+    }
+
+    // Create the OpenGL texture if it doesn't exist yet
+    if (!m_texture)
+    {
+        GLuint texture;
+        glCheck(glGenTextures(1, &texture));
+        m_texture = static_cast<unsigned int>(texture);
+    }
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
     // Initialize the texture
-    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, (m_sRgb ? GL_SRGB8_ALPHA8 : GL_RGBA), m_actualSize.x, m_actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    priv::getGLStateCache().bindTexture(m_texture);
+    if (!reuseStorage)
+    {
+        if (m_format == R8)
+        {
+#if defined(SFML_OPENGL_ES)
+            // EXT_texture_rg only has the unsized red format
+            GLint internalFormat = GLAD_GL_ES_VERSION_3_0 ? GL_R8 : GL_RED;
+#else
+            GLint internalFormat = GL_R8;
+#endif
+            glCheck(glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_actualSize.x, m_actualSize.y, 0, GL_RED, GL_UNSIGNED_BYTE, NULL));
+        }
+        else if (m_format == RGBA16F)
+        {
+#if defined(SFML_OPENGL_ES)
+            // OES_texture_half_float only has the unsized format, with its own type
+            GLint internalFormat = GLAD_GL_ES_VERSION_3_0 ? GL_RGBA16F : GL_RGBA;
+            GLenum type = GLAD_GL_ES_VERSION_3_0 ? GL_HALF_FLOAT : GL_HALF_FLOAT_OES;
+#else
+            GLint internalFormat = GL_RGBA16F;
+            GLenum type = GL_FLOAT;
+#endif
+            glCheck(glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_actualSize.x, m_actualSize.y, 0, GL_RGBA, type, NULL));
+        }
+        else if ((m_format == RGB565) || (m_format == RGBA4444))
+        {
+            bool rgb565 = (m_format == RGB565);
+#if defined(SFML_OPENGL_ES)
+            // The unsized formats with a packed type are the 16-bit formats of OpenGL ES 2
+            GLint internalFormat = rgb565 ? GL_RGB : GL_RGBA;
+#else
+            // GL_RGB565 only appeared with ARB_ES2_compatibility, GL_RGB5 is the closest before
+            GLint internalFormat = rgb565 ? (GLAD_GL_ARB_ES2_compatibility ? GL_RGB565 : GL_RGB5) : GL_RGBA4;
+#endif
+            glCheck(glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_actualSize.x, m_actualSize.y, 0, rgb565 ? GL_RGB : GL_RGBA,
+                                 rgb565 ? GL_UNSIGNED_SHORT_5_6_5 : GL_UNSIGNED_SHORT_4_4_4_4, NULL));
+        }
+        else
+        {
+            glCheck(glTexImage2D(GL_TEXTURE_2D, 0, (m_sRgb ? GL_SRGB8_ALPHA8 : GL_RGBA), m_actualSize.x, m_actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+        }
+    }
+    m_storageFormat = storageFormat;
 	glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GL_CLAMP_TO_EDGE : GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GL_CLAMP_TO_EDGE : GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
 	glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
-    m_cacheId = getUniqueId();
+    m_minFilter = m_isSmooth ? GL_LINEAR : GL_NEAREST;
+    m_storageId = getUniqueId();
+    m_contentId = m_storageId;
+    m_opaque = false;
 
     m_hasMipmap = false;
+    setMemoryUsage(static_cast<Uint64>(m_actualSize.x) * m_actualSize.y * getBytesPerPixel(m_format));
 
     return true;
 }
@@ -219,131 +701,937 @@ bool Texture::create(unsigned int width, unsigned int height)
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect& area)
 {
-    Image image;
-    return image.loadFromMemory(data, size) && loadFromImage(image, area);
+    // Upload the decoded pixels directly, instead of copying them into an sf::Image first
+    Vector2u imageSize;
+    Uint8* pixels = priv::ImageLoader::getInstance().decodeImageFromMemory(data, size, imageSize);
+    if (!pixels)
+        return false;
+
+    if (m_premultiplied)
+        priv::ImageLoader::premultiplyAlpha(pixels, static_cast<std::size_t>(imageSize.x) * imageSize.y);
+
+    bool result = loadFromPixels(ImageView(pixels, imageSize.x, imageSize.y).subView(area));
+    priv::ImageLoader::getInstance().freeDecodedPixels(pixels, imageSize);
+
+    return result;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromStream(InputStream& stream, const IntRect& area)
 {
-    Image image;
-    return image.loadFromStream(stream) && loadFromImage(image, area);
+    // Upload the decoded pixels directly, instead of copying them into an sf::Image first
+    Vector2u imageSize;
+    Uint8* pixels = priv::ImageLoader::getInstance().decodeImageFromStream(stream, imageSize);
+    if (!pixels)
+        return false;
+
+    if (m_premultiplied)
+        priv::ImageLoader::premultiplyAlpha(pixels, static_cast<std::size_t>(imageSize.x) * imageSize.y);
+
+    bool result = loadFromPixels(ImageView(pixels, imageSize.x, imageSize.y).subView(area));
+    priv::ImageLoader::getInstance().freeDecodedPixels(pixels, imageSize);
+
+    return result;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Texture::loadFromImage(const Image& image, const IntRect& area)
+struct Texture::AsyncLoad
 {
-    // Retrieve the image size
-    int width = static_cast<int>(image.getSize().x);
-    int height = static_cast<int>(image.getSize().y);
-
-    // Load the entire image if the source area is either empty or contains the whole image
-    if (area.width == 0 || (area.height == 0) ||
-       ((area.left <= 0) && (area.top <= 0) && (area.width >= width) && (area.height >= height)))
-    {
-        // Load the entire image
-        if (create(image.getSize().x, image.getSize().y))
-        {
-            update(image);
+    Texture*     texture;  ///< Texture being loaded
+    const void*  data;     ///< File data, kept for the stb_image fallback
+    std::size_t  size;     ///< Size of the file data, in bytes
+    LoadCallback callback; ///< Function called when the load is finished
+    void*        userData; ///< User data passed to the callback
+};
 
-            return true;
-        }
-        else
-        {
-            return false;
-        }
-    }
-    else
-    {
-        // Load a sub-area of the image
 
-        // Adjust the rectangle to the size of the image
-        IntRect rectangle = area;
-        if (rectangle.left   < 0) rectangle.left = 0;
-        if (rectangle.top    < 0) rectangle.top  = 0;
-        if (rectangle.left + rectangle.width > width)  rectangle.width  = width - rectangle.left;
-        if (rectangle.top + rectangle.height > height) rectangle.height = height - rectangle.top;
+////////////////////////////////////////////////////////////
+void Texture::loadFromMemoryAsync(const void* data, std::size_t size, LoadCallback callback, void* userData)
+{
+    SFML_TRACE_SCOPE("Texture::loadFromMemoryAsync");
+
+    AsyncLoad* load = new AsyncLoad;
+    load->texture  = this;
+    load->data     = data;
+    load->size     = size;
+    load->callback = callback;
+    load->userData = userData;
+
+    // Outside the browser, the load finishes right away with stb_image
+    if (!priv::decodeImageInBrowser(data, size, m_premultiplied, &Texture::prepareBrowserImage, &Texture::finishBrowserImage, load))
+        finishBrowserImage(false, load);
+}
 
-        // Create the texture and upload the pixels
-        if (create(rectangle.width, rectangle.height))
-        {
-            // Make sure that the current texture binding will be preserved
-            priv::TextureSaver save;
 
-            // Copy the pixels to the texture, row by row
-            const Uint8* pixels = image.getPixelsPtr() + 4 * (rectangle.left + (width * rectangle.top));
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-            for (int i = 0; i < rectangle.height; ++i)
-            {
-                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, rectangle.width, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-                pixels += 4 * width;
-            }
+////////////////////////////////////////////////////////////
+bool Texture::prepareBrowserImage(unsigned int width, unsigned int height, void* userData)
+{
+    Texture& texture = *static_cast<AsyncLoad*>(userData)->texture;
+    if (!texture.create(width, height))
+        return false;
 
-            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
-            m_hasMipmap = false;
+    // The browser uploads to the texture bound to the active unit
+    priv::getGLStateCache().bindTexture(texture.m_texture);
 
-            // Force an OpenGL flush, so that the texture will appear updated
-            // in all contexts immediately (solves problems in multi-threaded apps)
-            glCheck(glFlush());
+    priv::getRenderStats().bytesUploaded += static_cast<Uint64>(width) * height * 4;
+    texture.m_hasMipmap     = false;
+    texture.m_pixelsFlipped = false;
+    texture.m_contentId     = getUniqueId();
+    texture.m_opaque        = false;
 
-            return true;
-        }
-        else
-        {
-            return false;
-        }
-    }
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-Vector2u Texture::getSize() const
+void Texture::finishBrowserImage(bool success, void* userData)
 {
-    return m_size;
+    AsyncLoad* load = static_cast<AsyncLoad*>(userData);
+    Texture& texture = *load->texture;
+
+    // stb_image remains the fallback for the files the browser can't decode
+    if (!success)
+        success = texture.loadFromMemory(load->data, load->size);
+
+    if (load->callback)
+        load->callback(texture, success, load->userData);
+
+    delete load;
 }
 
 
 ////////////////////////////////////////////////////////////
-Image Texture::copyToImage() const
+bool Texture::loadFromImage(const Image& image, const IntRect& area)
 {
-    // Easy case: empty texture
-    if (!m_texture)
-        return Image();
-
-    // Make sure that the current texture binding will be preserved
-    priv::TextureSaver save;
+    if (image.getPixelFormat() != Image::RGBA8)
+        return loadFromPackedImage(image, area);
 
-    // Create an array of pixels
-    std::vector<Uint8> pixels(m_size.x * m_size.y * 4);
+    return loadFromImage(ImageView(image, area));
+}
 
-#if defined (SFML_OPENGL_ES) || defined(SFML_SYSTEM_EMSCRIPTEN)
 
-    // OpenGL ES doesn't have the glGetTexImage function, the only way to read
-    // from a texture is to bind it to a FBO and use glReadPixels
-    GLuint frameBuffer = 0;
-    glCheck(glGenFramebuffers(1, &frameBuffer));
-    if (frameBuffer)
+////////////////////////////////////////////////////////////
+bool Texture::loadFromImage(const ImageView& source)
+{
+    if (m_premultiplied && !source.isEmpty())
     {
-        GLint previousFrameBuffer;
-        glCheck(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFrameBuffer));
-
-        glCheck(glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer));
-        glCheck(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0));
-        glCheck(glReadPixels(0, 0, m_size.x, m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
-        glCheck(glDeleteFramebuffers(1, &frameBuffer));
-
-        glCheck(glBindFramebuffer(GL_FRAMEBUFFER, previousFrameBuffer));
+        // The source is left untouched, premultiply a copy of its pixels
+        FrameArena& arena = FrameArena::getDefault();
+        FrameArena::Scope scope(arena);
+
+        unsigned int width  = source.getSize().x;
+        unsigned int height = source.getSize().y;
+        std::size_t  pitch  = static_cast<std::size_t>(width) * 4;
+        Uint8* pixels = arena.allocate<Uint8>(pitch * height);
+        for (unsigned int y = 0; y < height; ++y)
+            std::memcpy(pixels + pitch * y, source.getRow(y), pitch);
+        priv::ImageLoader::premultiplyAlpha(pixels, static_cast<std::size_t>(width) * height);
+
+        return loadFromPixels(ImageView(pixels, width, height));
     }
 
+    return loadFromPixels(source);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromImageWithMips(const Image& image, const std::vector<Image>& levels)
+{
+    SFML_TRACE_SCOPE("Texture::loadFromImageWithMips");
+
+    // Check the sizes of the chain before touching the texture
+    Vector2u size = image.getSize();
+    if ((size.x == 0) || (size.y == 0))
+    {
+        err() << "Failed to load texture with mipmaps, the image is empty" << std::endl;
+        return false;
+    }
+
+    for (std::size_t i = 0; i < levels.size(); ++i)
+    {
+        size = Vector2u(std::max(size.x / 2, 1u), std::max(size.y / 2, 1u));
+        if (levels[i].getSize() != size)
+        {
+            err() << "Failed to load texture with mipmaps, level " << (i + 1) << " should be "
+                  << size.x << "x" << size.y << " (it is " << levels[i].getSize().x << "x" << levels[i].getSize().y << ")"
+                  << std::endl;
+            return false;
+        }
+    }
+
+    if (!loadFromImage(image))
+        return false;
+
+    if (levels.empty())
+        return true;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    priv::getGLStateCache().bindTexture(m_texture);
+
+    GLint internalFormat = m_sRgb ? GL_SRGB8_ALPHA8 : GL_RGBA;
+    Vector2u actualSize = m_actualSize;
+    Uint64 memoryUsage = static_cast<Uint64>(m_actualSize.x) * m_actualSize.y * 4;
+    std::vector<Uint8> premultiplied;
+    for (std::size_t i = 0; i < levels.size(); ++i)
+    {
+        const Image& level = levels[i];
+        const Uint8* pixels = level.getPixelsPtr();
+        std::size_t pixelCount = static_cast<std::size_t>(level.getSize().x) * level.getSize().y;
+
+        if (m_premultiplied)
+        {
+            premultiplied.assign(pixels, pixels + pixelCount * 4);
+            priv::ImageLoader::premultiplyAlpha(&premultiplied[0], pixelCount);
+            pixels = &premultiplied[0];
+        }
+
+        // Padded textures have larger levels, the level goes into their top-left corner
+        actualSize = Vector2u(std::max(actualSize.x / 2, 1u), std::max(actualSize.y / 2, 1u));
+        GLint index = static_cast<GLint>(i + 1);
+        if (actualSize == level.getSize())
+        {
+            glCheck(glTexImage2D(GL_TEXTURE_2D, index, internalFormat, actualSize.x, actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        }
+        else
+        {
+            glCheck(glTexImage2D(GL_TEXTURE_2D, index, internalFormat, actualSize.x, actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, index, 0, 0, level.getSize().x, level.getSize().y, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        }
+
+        priv::getRenderStats().bytesUploaded += pixelCount * 4;
+        memoryUsage += static_cast<Uint64>(actualSize.x) * actualSize.y * 4;
+    }
+
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels.size())));
+
+    m_hasMipmap = true;
+    applyMinFilter();
+    setMemoryUsage(memoryUsage);
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromPackedImage(const Image& image, const IntRect& area)
+{
+    // Adjust the rectangle to the size of the image, like the views do for RGBA8 images
+    int width  = static_cast<int>(image.getSize().x);
+    int height = static_cast<int>(image.getSize().y);
+    IntRect rectangle(0, 0, width, height);
+    if ((area.width != 0) && (area.height != 0))
+    {
+        rectangle.left   = std::max(area.left, 0);
+        rectangle.top    = std::max(area.top, 0);
+        rectangle.width  = std::max(std::min(area.left + area.width, width) - rectangle.left, 0);
+        rectangle.height = std::max(std::min(area.top + area.height, height) - rectangle.top, 0);
+    }
+
+    // Keep the reduced format on the graphics card
+    Image::PixelFormat imageFormat = image.getPixelFormat();
+    Format format = (imageFormat == Image::RGB565) ? RGB565 : ((imageFormat == Image::RGBA4444) ? RGBA4444 : R8);
+    if (!create(static_cast<unsigned int>(rectangle.width), static_cast<unsigned int>(rectangle.height), format))
+        return false;
+
+    // Gather the rows of the area into a contiguous buffer
+    FrameArena& arena = FrameArena::getDefault();
+    FrameArena::Scope scope(arena);
+
+    std::size_t size  = Image::getBytesPerPixel(imageFormat);
+    std::size_t pitch = size * rectangle.width;
+    const Uint8* source = image.getPixelsPtr() + size * (rectangle.left + static_cast<std::size_t>(width) * rectangle.top);
+    Uint8* region = arena.allocate<Uint8>(pitch * rectangle.height);
+    for (int i = 0; i < rectangle.height; ++i)
+        std::memcpy(region + pitch * i, source + size * width * i, pitch);
+
+    if (m_premultiplied && (imageFormat == Image::RGBA4444))
+    {
+        // Premultiply the expanded colors, update then packs them again
+        std::size_t count = static_cast<std::size_t>(rectangle.width) * rectangle.height;
+        Uint8* expanded = arena.allocate<Uint8>(count * 4);
+        priv::unpackPixels(region, count, imageFormat, expanded);
+        priv::ImageLoader::premultiplyAlpha(expanded, count);
+        update(expanded, rectangle.width, rectangle.height, 0, 0);
+    }
+    else
+    {
+        updatePixels(region, imageFormat, rectangle.width, rectangle.height, 0, 0);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromPixels(const ImageView& source)
+{
+    if (!create(source.getSize().x, source.getSize().y))
+        return false;
+
+    // Sub-rectangles are uploaded directly when the driver supports it (see update)
+    update(source, 0, 0);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadCompressedFromMemory(const void* data, std::size_t size)
+{
+    SFML_TRACE_SCOPE("Texture::loadCompressedFromMemory");
+
+    priv::CompressedImage image;
+    if (!priv::parseCompressedImage(data, size, image))
+        return false;
+
+    return loadCompressed(image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromBundle(const AssetBundle& bundle, const std::string& name)
+{
+    return loadBundleLevels(bundle, name, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadBundleLevels(const AssetBundle& bundle, const std::string& name, unsigned int firstLevel)
+{
+    SFML_TRACE_SCOPE("Texture::loadFromBundle");
+
+    std::size_t index = bundle.find(name);
+    if ((index == AssetBundle::NotFound) || (bundle.getType(index) != AssetBundle::EntryTexture))
+    {
+        err() << "Failed to load texture \"" << name << "\" from the asset bundle (no such texture)" << std::endl;
+        return false;
+    }
+
+    std::size_t size = 0;
+    const void* data = bundle.getData(index, size);
+    priv::BundleTexture texture;
+    if (!priv::parseBundleTexture(data, size, texture))
+    {
+        err() << "Failed to load texture \"" << name << "\" from the asset bundle (invalid texture entry)" << std::endl;
+        return false;
+    }
+
+    // Streamed textures skip the levels larger than what is displayed
+    if ((firstLevel > 0) && (firstLevel < texture.image.levels.size()))
+    {
+        texture.image.levels.erase(texture.image.levels.begin(), texture.image.levels.begin() + firstLevel);
+        texture.image.size = texture.image.levels[0].size;
+    }
+
+    if (texture.pixelFormat == priv::BundleCompressed)
+        return loadCompressed(texture.image);
+
+    const priv::CompressedImage& image = texture.image;
+    bool redOnly = (texture.pixelFormat == priv::BundleR8);
+
+    bool sRgb = m_sRgb;
+    m_sRgb = image.sRgb;
+    if (!create(image.size.x, image.size.y, redOnly ? R8 : RGBA8))
+    {
+        m_sRgb = sRgb;
+        return false;
+    }
+
+    // R8 may have fallen back to RGBA8, the texels are then expanded like the pipeline reads them
+    bool singleChannel = (m_format == R8);
+    GLenum pixelFormat = singleChannel ? GL_RED : GL_RGBA;
+#if defined(SFML_OPENGL_ES)
+    GLint internalFormat = singleChannel ? (GLAD_GL_ES_VERSION_3_0 ? GL_R8 : GL_RED) : (m_sRgb ? GL_SRGB8_ALPHA8 : GL_RGBA);
+#else
+    GLint internalFormat = singleChannel ? GL_R8 : (m_sRgb ? GL_SRGB8_ALPHA8 : GL_RGBA);
+#endif
+    unsigned int bytesPerPixel = singleChannel ? 1 : 4;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    priv::getGLStateCache().bindTexture(m_texture);
+    glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+    FrameArena& arena = FrameArena::getDefault();
+    Vector2u actualSize = m_actualSize;
+    Uint64 memoryUsage = 0;
+    for (std::size_t i = 0; i < image.levels.size(); ++i)
+    {
+        const priv::CompressedImage::Level& level = image.levels[i];
+        const Uint8* pixels = level.data;
+
+        FrameArena::Scope scope(arena);
+        if (redOnly && !singleChannel)
+        {
+            std::size_t count = static_cast<std::size_t>(level.size.x) * level.size.y;
+            Uint8* expanded = arena.allocate<Uint8>(count * 4);
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                expanded[4 * j + 0] = 255;
+                expanded[4 * j + 1] = 255;
+                expanded[4 * j + 2] = 255;
+                expanded[4 * j + 3] = pixels[j];
+            }
+            pixels = expanded;
+        }
+
+        // Level 0 was allocated by create, padded textures have larger levels
+        GLint levelIndex = static_cast<GLint>(i);
+        if (i > 0)
+            actualSize = Vector2u(std::max(actualSize.x / 2, 1u), std::max(actualSize.y / 2, 1u));
+
+        if ((i > 0) && (actualSize == level.size))
+        {
+            glCheck(glTexImage2D(GL_TEXTURE_2D, levelIndex, internalFormat, actualSize.x, actualSize.y, 0, pixelFormat, GL_UNSIGNED_BYTE, pixels));
+        }
+        else
+        {
+            if (i > 0)
+                glCheck(glTexImage2D(GL_TEXTURE_2D, levelIndex, internalFormat, actualSize.x, actualSize.y, 0, pixelFormat, GL_UNSIGNED_BYTE, NULL));
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, levelIndex, 0, 0, level.size.x, level.size.y, pixelFormat, GL_UNSIGNED_BYTE, pixels));
+        }
+
+        priv::getRenderStats().bytesUploaded += static_cast<Uint64>(level.size.x) * level.size.y * bytesPerPixel;
+        memoryUsage += static_cast<Uint64>(actualSize.x) * actualSize.y * bytesPerPixel;
+    }
+
+    glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+
+    m_hasMipmap = (image.levels.size() > 1);
+    applyMinFilter();
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.levels.size() - 1)));
+
+    setMemoryUsage(memoryUsage);
+    m_pixelsFlipped = false;
+    m_contentId = getUniqueId();
+    m_opaque = !redOnly && priv::arePixelsOpaque(image.levels[0].data, static_cast<std::size_t>(image.size.x) * image.size.y);
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromImageLazily(const Image& image)
+{
+    if ((image.getSize().x == 0) || (image.getSize().y == 0))
+    {
+        err() << "Failed to load texture lazily, the image is empty" << std::endl;
+        return false;
+    }
+
+    LazySource* source = new LazySource;
+    source->image         = image;
+    source->bundle        = NULL;
+    source->size          = image.getSize();
+    source->streamed      = false;
+    source->residentLevel = 1;
+    source->wantedLevel   = 0;
+    source->wantedFrame   = 0;
+    source->footprint     = 0.f;
+    source->queued        = false;
+    source->levelBytes.push_back(static_cast<Uint64>(image.getSize().x) * image.getSize().y * 4);
+
+    releaseStorage(image.getSize());
+    m_lazySource = source;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromBundleLazily(const AssetBundle& bundle, const std::string& name, bool streamed)
+{
+    // Validate the entry now, so that the first draw can't fail
+    std::size_t index = bundle.find(name);
+    std::size_t size = 0;
+    const void* data = (index != AssetBundle::NotFound) ? bundle.getData(index, size) : NULL;
+    priv::BundleTexture texture;
+    if (!data || (bundle.getType(index) != AssetBundle::EntryTexture) || !priv::parseBundleTexture(data, size, texture))
+    {
+        err() << "Failed to load texture \"" << name << "\" lazily from the asset bundle (no such texture)" << std::endl;
+        return false;
+    }
+
+    LazySource* source = new LazySource;
+    source->bundle        = &bundle;
+    source->name          = name;
+    source->size          = texture.image.size;
+    source->streamed      = streamed && (texture.image.levels.size() > 1);
+    source->residentLevel = static_cast<unsigned int>(texture.image.levels.size());
+    source->wantedLevel   = 0;
+    source->wantedFrame   = 0;
+    source->footprint     = 0.f;
+    source->queued        = false;
+    for (std::size_t i = 0; i < texture.image.levels.size(); ++i)
+        source->levelBytes.push_back(texture.image.levels[i].dataSize);
+
+    releaseStorage(texture.image.size);
+    m_lazySource = source;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::evict()
+{
+    if (!m_lazySource || !m_texture)
+        return false;
+
+    // The storage is deleted rather than pooled, evicting is meant to save memory
+    priv::flushPendingDraws(this);
+    destroyTexture(static_cast<GLuint>(m_texture), m_actualSize, 0);
+    m_texture       = 0;
+    m_storageFormat = 0;
+    m_minFilter     = 0;
+    m_hasMipmap     = false;
+    m_actualSize    = m_size;
+    m_lazySource->residentLevel = static_cast<unsigned int>(m_lazySource->levelBytes.size());
+    setMemoryUsage(0);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isResident() const
+{
+    return m_texture != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::ensureResident() const
+{
+    if (!m_lazySource || (m_lazySource->residentLevel == 0))
+        return m_texture != 0;
+
+    return uploadLazySource(0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::uploadLazySource(unsigned int firstLevel) const
+{
+    SFML_TRACE_SCOPE("Texture::uploadLazySource");
+
+    // This may run while the batch that draws the texture is being submitted: load a
+    // temporary texture, which no pending draw refers to, and take over its storage
+    Texture uploaded;
+    uploaded.m_isSmooth      = m_isSmooth;
+    uploaded.m_sRgb          = m_sRgb;
+    uploaded.m_premultiplied = m_premultiplied;
+    uploaded.m_isRepeated    = m_isRepeated;
+
+    const LazySource& source = *m_lazySource;
+    bool loaded = source.bundle ? uploaded.loadBundleLevels(*source.bundle, source.name, firstLevel) : uploaded.loadFromImage(source.image);
+
+    Texture& self = const_cast<Texture&>(*this);
+    if (!loaded)
+    {
+        // Don't try again on every draw; a streamed texture keeps the levels it already has
+        self.discardLazySource();
+        if (!m_texture)
+        {
+            self.m_size       = Vector2u(0, 0);
+            self.m_actualSize = Vector2u(0, 0);
+        }
+        return false;
+    }
+
+    // The storage of a streamed texture may be smaller than its size, which is
+    // fine for normalized texture coordinates; the memory usage is moved along,
+    // it is already accounted in sf::GpuMemory
+    std::swap(self.m_actualSize,    uploaded.m_actualSize);
+    std::swap(self.m_texture,       uploaded.m_texture);
+    std::swap(self.m_storageFormat, uploaded.m_storageFormat);
+    std::swap(self.m_sRgb,          uploaded.m_sRgb);
+    std::swap(self.m_pixelsFlipped, uploaded.m_pixelsFlipped);
+    std::swap(self.m_hasMipmap,     uploaded.m_hasMipmap);
+    std::swap(self.m_minFilter,     uploaded.m_minFilter);
+    std::swap(self.m_opaque,        uploaded.m_opaque);
+    std::swap(self.m_format,        uploaded.m_format);
+    std::swap(self.m_memoryUsage,   uploaded.m_memoryUsage);
+    self.m_size      = source.size;
+    self.m_storageId = uploaded.m_storageId;
+    self.m_contentId = uploaded.m_contentId;
+    m_lazySource->residentLevel = firstLevel;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::processStreamingRequests()
+{
+    // The largest items on screen are refined first, within the upload budget;
+    // the requests that don't fit are made again by the next draws
+    std::vector<const Texture*> requests;
+    requests.swap(streamingRequests);
+    std::stable_sort(requests.begin(), requests.end(), [](const Texture* left, const Texture* right)
+    {
+        return left->m_lazySource->footprint > right->m_lazySource->footprint;
+    });
+
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        const Texture& texture = *requests[i];
+        LazySource& source = *texture.m_lazySource;
+        source.queued = false;
+
+        // Evicted textures start again from their placeholder on their next draw
+        if (!texture.m_texture || (source.wantedLevel >= source.residentLevel))
+            continue;
+
+        if (reserveLazyUpload(source.getUploadSize(source.wantedLevel)))
+            texture.uploadLazySource(source.wantedLevel);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::discardLazySource()
+{
+    if (m_lazySource && m_lazySource->queued)
+        streamingRequests.erase(std::remove(streamingRequests.begin(), streamingRequests.end(), this), streamingRequests.end());
+
+    delete m_lazySource;
+    m_lazySource = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::releaseStorage(const Vector2u& size)
+{
+    priv::flushPendingDraws(this);
+    discardLazySource();
+
+    if (m_texture)
+        destroyTexture(static_cast<GLuint>(m_texture), m_actualSize, m_storageFormat);
+
+    m_size          = size;
+    m_actualSize    = size;
+    m_texture       = 0;
+    m_storageFormat = 0;
+    m_minFilter     = 0;
+    m_pixelsFlipped = false;
+    m_fboAttachment = false;
+    m_hasMipmap     = false;
+    m_opaque        = false;
+    m_format        = RGBA8;
+    m_storageId     = getUniqueId();
+    m_contentId     = m_storageId;
+    setMemoryUsage(0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::retainPixels(std::vector<Uint8>& data) const
+{
+    if (!m_texture || m_lazySource || m_fboAttachment)
+        return false;
+
+    Image image = copyToImage();
+    if ((image.getSize().x == 0) || (image.getSize().y == 0))
+        return false;
+
+    data.clear();
+    priv::encodeQoiImage(data, image.getPixelsPtr(), image.getSize());
+
+    return !data.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::restoreStorage(const std::vector<Uint8>* data)
+{
+    // The name belongs to the lost context: forget it, the new one may already reuse it
+    bool hadStorage = (m_texture != 0);
+    bool mipmapped  = m_hasMipmap;
+    m_texture       = 0;
+    m_storageFormat = 0;
+    m_minFilter     = 0;
+    m_hasMipmap     = false;
+    setMemoryUsage(0);
+
+    if (!hadStorage || m_fboAttachment)
+        return true;
+
+    if (m_lazySource)
+    {
+        m_actualSize = m_size;
+        m_lazySource->residentLevel = static_cast<unsigned int>(m_lazySource->levelBytes.size());
+        return true;
+    }
+
+    Uint8* pixels = NULL;
+    Vector2u pixelsSize;
+    if (data && !data->empty())
+    {
+        const char* error = "";
+        pixels = priv::decodeQoiImage(&(*data)[0], data->size(), pixelsSize, error);
+        if (!pixels)
+        {
+            err() << "Failed to restore texture. Reason: " << error << std::endl;
+        }
+        else if (pixelsSize != m_size)
+        {
+            err() << "Failed to restore texture, the size of its copy doesn't match" << std::endl;
+            std::free(pixels);
+            pixels = NULL;
+        }
+    }
+
+    bool created = createStorage(m_size.x, m_size.y, m_format);
+    if (created && pixels)
+    {
+        update(pixels);
+
+        if (mipmapped)
+            generateMipmap();
+    }
+
+    std::free(pixels);
+
+    return created && (pixels || !data);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::forgetSharedObjects()
+{
+    {
+        Lock lock(copyFramebufferMutex);
+        copyFramebuffers.clear();
+    }
+
+    transparentTexture = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadCompressed(const priv::CompressedImage& image)
+{
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    GLenum uploadFormat = priv::getCompressedUploadFormat(image.format);
+    if (uploadFormat)
+    {
+        // Check the maximum texture size (compressed textures are never padded)
+        unsigned int maxSize = getMaximumSize();
+        if ((image.size.x > maxSize) || (image.size.y > maxSize))
+        {
+            err() << "Failed to load compressed texture, its size is too high "
+                  << "(" << image.size.x << "x" << image.size.y << ", "
+                  << "maximum is " << maxSize << "x" << maxSize << ")"
+                  << std::endl;
+            return false;
+        }
+
+        // Pending draws still refer to the previous contents
+        priv::flushPendingDraws(this);
+        discardLazySource();
+
+        m_size          = image.size;
+        m_actualSize    = image.size;
+        m_sRgb          = image.sRgb;
+        m_pixelsFlipped = false;
+        m_fboAttachment = false;
+        m_format        = RGBA8;
+        m_storageFormat = 0;
+
+        // Create the OpenGL texture if it doesn't exist yet
+        if (!m_texture)
+        {
+            GLuint texture;
+            glCheck(glGenTextures(1, &texture));
+            m_texture = static_cast<unsigned int>(texture);
+        }
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        priv::getGLStateCache().bindTexture(m_texture);
+
+        // The driver may still reject a format it claims to support, so the errors
+        // of each upload are checked (after discarding the ones raised before)
+        while (glGetError() != GL_NO_ERROR)
+        {
+        }
+
+        bool uploaded = true;
+        Uint64 memoryUsage = 0;
+        for (std::size_t i = 0; (i < image.levels.size()) && uploaded; ++i)
+        {
+            const priv::CompressedImage::Level& level = image.levels[i];
+            glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), uploadFormat, level.size.x, level.size.y, 0,
+                                   static_cast<GLsizei>(level.dataSize), level.data);
+            uploaded = (glGetError() == GL_NO_ERROR);
+            priv::getRenderStats().bytesUploaded += level.dataSize;
+            memoryUsage += level.dataSize;
+        }
+
+        if (uploaded)
+        {
+            setMemoryUsage(memoryUsage);
+
+            m_hasMipmap = image.levels.size() > 1;
+
+            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : GL_CLAMP_TO_EDGE));
+            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : GL_CLAMP_TO_EDGE));
+            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+            applyMinFilter();
+            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.levels.size() - 1)));
+
+            m_storageId = getUniqueId();
+            m_contentId = m_storageId;
+            m_opaque = false;
+
+            return true;
+        }
+
+        err() << "Failed to upload compressed texture, format 0x" << std::hex << image.format << std::dec
+              << " was rejected by the driver, decompressing it instead" << std::endl;
+
+        // Drop the incomplete texture, the decompressed pixels go to a new one
+        destroyTexture(static_cast<GLuint>(m_texture), m_actualSize, 0);
+        m_texture   = 0;
+        m_minFilter = 0;
+    }
+
+    // The driver can't sample this format: decompress it and upload plain RGBA
+    std::vector<Uint8> pixels;
+    if (!priv::decompressImage(image.format, image.levels[0], pixels))
+    {
+        err() << "Failed to load compressed texture, format 0x" << std::hex << image.format << std::dec
+              << " is not supported by the driver and can't be decompressed" << std::endl;
+        return false;
+    }
+
+    bool sRgb = m_sRgb;
+    m_sRgb = image.sRgb;
+    if (!create(image.size.x, image.size.y))
+    {
+        m_sRgb = sRgb;
+        return false;
+    }
+
+    update(&pixels[0]);
+
+    if (image.levels.size() > 1)
+        generateMipmap();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u Texture::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+Image Texture::copyToImage() const
+{
+    // Easy case: empty texture
+    if (!ensureResident())
+        return Image();
+
+    priv::resolveTexture(*this);
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // The pixels are read straight into the storage of the image
+    Image image;
+    image.m_pixels.resize(static_cast<std::size_t>(m_size.x) * m_size.y * 4);
+    image.m_size = m_size;
+    image.m_memory.update(image.m_pixels.capacity());
+    Uint8* pixels = &image.m_pixels[0];
+    std::size_t pitch = m_size.x * 4;
+
+    // Read exactly the visible area from the frame buffer that has the texture
+    // attached, which also skips the padding; compressed textures can't be
+    // attached, they are read with glGetTexImage on desktop OpenGL
+#ifndef SFML_OPENGL_ES
+
+    {
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+    }
+
+    bool frameBufferAvailable = GLAD_GL_EXT_framebuffer_object && GLAD_GL_EXT_framebuffer_blit;
+
 #else
 
+    bool frameBufferAvailable = true;
+
+#endif
+
+    GLuint frameBuffer = frameBufferAvailable ? getCopyFramebuffer(m_texture) : 0;
+    if (frameBuffer)
+    {
+        priv::GLStateCache& cache = priv::getGLStateCache();
+        GLuint previousFrameBuffer = cache.getFramebuffer(copyReadTarget);
+        cache.bindFramebuffer(copyReadTarget, frameBuffer);
+
+#if defined(SFML_OPENGL_ES)
+        if ((m_format == RGBA16F) && GLAD_GL_ES_VERSION_3_0)
+        {
+            // OpenGL ES 3 only reads floating-point color buffers as floats
+            std::vector<float> values(image.m_pixels.size());
+            glCheck(glReadPixels(0, 0, m_size.x, m_size.y, GL_RGBA, GL_FLOAT, &values[0]));
+            for (std::size_t i = 0; i < values.size(); ++i)
+                pixels[i] = static_cast<Uint8>(std::min(std::max(values[i], 0.f), 1.f) * 255.f + 0.5f);
+        }
+        else
+#endif
+        {
+            glCheck(glReadPixels(0, 0, m_size.x, m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        }
+
+        cache.bindFramebuffer(copyReadTarget, previousFrameBuffer);
+
+        // The rows of flipped textures are stored from bottom to top
+        if (m_pixelsFlipped)
+        {
+            std::vector<Uint8> row(pitch);
+            for (unsigned int i = 0; i < m_size.y / 2; ++i)
+            {
+                Uint8* top = pixels + pitch * i;
+                Uint8* bottom = pixels + pitch * (m_size.y - 1 - i);
+                std::memcpy(&row[0], top, pitch);
+                std::memcpy(top, bottom, pitch);
+                std::memcpy(bottom, &row[0], pitch);
+            }
+        }
+
+        return image;
+    }
+
+#ifndef SFML_OPENGL_ES
+
     if ((m_size == m_actualSize) && !m_pixelsFlipped)
     {
         // Texture is not padded nor flipped, we can use a direct copy
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
+        priv::getGLStateCache().bindTexture(m_texture);
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
     }
     else
     {
@@ -351,12 +1639,12 @@ Image Texture::copyToImage() const
 
         // All the pixels will first be copied to a temporary array
         std::vector<Uint8> allPixels(m_actualSize.x * m_actualSize.y * 4);
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        priv::getGLStateCache().bindTexture(m_texture);
         glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &allPixels[0]));
 
         // Then we copy the useful pixels from the temporary array to the final one
         const Uint8* src = &allPixels[0];
-        Uint8* dst = &pixels[0];
+        Uint8* dst = pixels;
         int srcPitch = m_actualSize.x * 4;
         int dstPitch = m_size.x * 4;
 
@@ -367,57 +1655,408 @@ Image Texture::copyToImage() const
             srcPitch = -srcPitch;
         }
 
-        for (unsigned int i = 0; i < m_size.y; ++i)
-        {
-            std::memcpy(dst, src, dstPitch);
-            src += srcPitch;
-            dst += dstPitch;
-        }
+        for (unsigned int i = 0; i < m_size.y; ++i)
+        {
+            std::memcpy(dst, src, dstPitch);
+            src += srcPitch;
+            dst += dstPitch;
+        }
+    }
+
+#endif // SFML_OPENGL_ES
+
+    return image;
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const Uint8* pixels)
+{
+    // Update the whole texture
+    update(pixels, m_size.x, m_size.y, 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    update(ImageView(pixels, width, height), x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const ImageView& source, unsigned int x, unsigned int y)
+{
+    SFML_TRACE_SCOPE("Texture::update");
+
+    unsigned int width  = source.getSize().x;
+    unsigned int height = source.getSize().y;
+
+#if defined(SFML_DEBUG)
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+#endif
+
+    ensureResident();
+
+    // Strided RGBA8 rows are skipped by the driver (GL_UNPACK_ROW_LENGTH), other
+    // sources are gathered into a contiguous buffer first (GLES 2 and WebGL 1)
+    bool rowLength = !source.isContiguous() && (m_format == RGBA8) && (source.getStride() % 4 == 0) && isUnpackRowLengthAvailable();
+    if (m_texture && !source.isEmpty() && !source.isContiguous() && !rowLength)
+    {
+        FrameArena& arena = FrameArena::getDefault();
+        FrameArena::Scope scope(arena);
+
+        std::size_t pitch = static_cast<std::size_t>(width) * 4;
+        Uint8* region = arena.allocate<Uint8>(pitch * height);
+        for (unsigned int i = 0; i < height; ++i)
+            std::memcpy(region + pitch * i, source.getRow(i), pitch);
+
+        update(ImageView(region, width, height), x, y);
+        return;
+    }
+
+    const Uint8* pixels = source.getPixelsPtr();
+    if (pixels && m_texture && ((m_format == RGB565) || (m_format == RGBA4444)))
+    {
+        // Dither the pixels down to the 16 bits of the texture
+        FrameArena& arena = FrameArena::getDefault();
+        FrameArena::Scope scope(arena);
+
+        Image::PixelFormat format = (m_format == RGB565) ? Image::RGB565 : Image::RGBA4444;
+        Uint8* packed = arena.allocate<Uint8>(static_cast<std::size_t>(width) * height * 2);
+        for (unsigned int i = 0; i < height; ++i)
+            priv::packPixels(source.getRow(i), width, y + i, format, true, packed + static_cast<std::size_t>(width) * 2 * i);
+
+        updatePacked(packed, width, height, x, y);
+    }
+    else if (pixels && m_texture && (m_format == R8))
+    {
+        // Keep the red channel, OpenGL ES can't convert uploads between formats
+        FrameArena& arena = FrameArena::getDefault();
+        FrameArena::Scope scope(arena);
+
+        std::size_t count = static_cast<std::size_t>(width) * height;
+        Uint8* red = arena.allocate<Uint8>(count);
+        for (std::size_t i = 0; i < count; ++i)
+            red[i] = pixels[4 * i];
+
+        updateSingleChannel(red, width, height, x, y);
+        glCheck(glFlush());
+    }
+    else if (pixels && m_texture)
+    {
+        priv::flushPendingDraws(this);
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        // Copy pixels from the given array to the texture
+        priv::getGLStateCache().bindTexture(m_texture);
+#if defined(SFML_OPENGL_ES)
+        if (m_format == RGBA16F)
+        {
+            // OpenGL ES only accepts half-float pixels for half-float textures
+            static Uint16 halfs[256];
+            static bool tableReady = false;
+            if (!tableReady)
+            {
+                for (unsigned int i = 0; i < 256; ++i)
+                    halfs[i] = byteToHalf(static_cast<Uint8>(i));
+                tableReady = true;
+            }
+
+            FrameArena& arena = FrameArena::getDefault();
+            FrameArena::Scope scope(arena);
+
+            std::size_t count = static_cast<std::size_t>(width) * height * 4;
+            Uint16* converted = arena.allocate<Uint16>(count);
+            for (std::size_t i = 0; i < count; ++i)
+                converted[i] = halfs[pixels[i]];
+
+            GLenum type = GLAD_GL_ES_VERSION_3_0 ? GL_HALF_FLOAT : GL_HALF_FLOAT_OES;
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, type, converted));
+        }
+        else
+#endif
+        {
+            if (rowLength)
+                glCheck(glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(source.getStride() / 4)));
+
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+
+            if (rowLength)
+                glCheck(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+        }
+        priv::getRenderStats().bytesUploaded += getBytesPerPixel(m_format) * width * height;
+        m_hasMipmap = false;
+        applyMinFilter();
+        m_pixelsFlipped = false;
+        m_contentId = getUniqueId();
+
+        // Keep track of fully opaque textures, for the depth pre-pass of render targets
+        bool whole = (width == m_size.x) && (height == m_size.y);
+        m_opaque = (whole || m_opaque) && priv::arePixelsOpaque(source);
+
+        // Force an OpenGL flush, so that the texture data will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::updateSingleChannel(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+#if defined(SFML_DEBUG)
+    assert(m_format == R8);
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+#endif
+
+    if (pixels && m_texture)
+    {
+        priv::flushPendingDraws(this);
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        // Rows of one byte per pixel are not aligned to 4 bytes
+        priv::getGLStateCache().bindTexture(m_texture);
+        glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RED, GL_UNSIGNED_BYTE, pixels));
+        glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+        priv::getRenderStats().bytesUploaded += width * height;
+        m_hasMipmap = false;
+        applyMinFilter();
+        m_pixelsFlipped = false;
+        m_contentId = getUniqueId();
+        m_opaque = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::updatePacked(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+#if defined(SFML_DEBUG)
+    assert((m_format == RGB565) || (m_format == RGBA4444));
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+#endif
+
+    if (pixels && m_texture)
+    {
+        priv::flushPendingDraws(this);
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        // Rows of two bytes per pixel are not aligned to 4 bytes
+        bool rgb565 = (m_format == RGB565);
+        priv::getGLStateCache().bindTexture(m_texture);
+        glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 2));
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, rgb565 ? GL_RGB : GL_RGBA,
+                                rgb565 ? GL_UNSIGNED_SHORT_5_6_5 : GL_UNSIGNED_SHORT_4_4_4_4, pixels));
+        glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+        priv::getRenderStats().bytesUploaded += 2 * width * height;
+        m_hasMipmap = false;
+        applyMinFilter();
+        m_pixelsFlipped = false;
+        m_contentId = getUniqueId();
+        m_opaque = rgb565;
+
+        // Force an OpenGL flush, so that the texture data will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::updatePixels(const Uint8* pixels, Image::PixelFormat format, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    if (!pixels || !ensureResident())
+        return;
+
+    if (format == Image::RGBA8)
+    {
+        update(pixels, width, height, x, y);
+    }
+    else if ((format == Image::R8) && (m_format == R8))
+    {
+        updateSingleChannel(pixels, width, height, x, y);
+        glCheck(glFlush());
+    }
+    else if (((format == Image::RGB565) && (m_format == RGB565)) || ((format == Image::RGBA4444) && (m_format == RGBA4444)))
+    {
+        updatePacked(pixels, width, height, x, y);
+    }
+    else
+    {
+        // Expand the pixels, update converts them to the format of the texture
+        FrameArena& arena = FrameArena::getDefault();
+        FrameArena::Scope scope(arena);
+
+        std::size_t count = static_cast<std::size_t>(width) * height;
+        Uint8* expanded = arena.allocate<Uint8>(count * 4);
+        priv::unpackPixels(pixels, count, format, expanded);
+        update(expanded, width, height, x, y);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Texture::updateAsync(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    SFML_TRACE_SCOPE("Texture::updateAsync");
+
+#if defined(SFML_DEBUG)
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+#endif
+
+    if (!pixels || !ensureResident())
+        return 0;
+
+    // The staging buffer holds RGBA8 pixels, the other formats are converted by update
+    if (!isAsyncUploadAvailable() || (m_format != RGBA8))
+    {
+        update(pixels, width, height, x, y);
+        return 0;
+    }
+
+    reclaimUploads();
+
+    // Take the smallest free buffer that is big enough, or grow one
+    GLsizeiptr size = static_cast<GLsizeiptr>(width) * height * 4;
+    std::size_t best = freeUploads.size();
+    for (std::size_t i = 0; i < freeUploads.size(); ++i)
+    {
+        if ((freeUploads[i].capacity >= size) && ((best == freeUploads.size()) || (freeUploads[i].capacity < freeUploads[best].capacity)))
+            best = i;
+    }
+
+    PixelUpload upload;
+    if (best < freeUploads.size())
+    {
+        upload = freeUploads[best];
+        freeUploads.erase(freeUploads.begin() + best);
+    }
+    else if (!freeUploads.empty())
+    {
+        upload = freeUploads.back();
+        freeUploads.pop_back();
+    }
+    else
+    {
+        glCheck(glGenBuffers(1, &upload.buffer));
+        upload.capacity = 0;
+    }
+
+    priv::GLStateCache& cache = priv::getGLStateCache();
+    cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, upload.buffer);
+
+    if (upload.capacity < size)
+    {
+        glCheck(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW));
+        upload.capacity = size;
+    }
+
+    // The buffer is idle (its fence was signaled), so the previous contents can be discarded
+    void* destination = NULL;
+    glCheck(destination = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    if (!destination)
+    {
+        cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        cache.deleteBuffer(upload.buffer);
+        update(pixels, width, height, x, y);
+        return 0;
+    }
+
+    std::memcpy(destination, pixels, static_cast<std::size_t>(size));
+
+    GLboolean unmapped;
+    glCheck(unmapped = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+    if (!unmapped)
+    {
+        // The buffer contents were lost (display mode change, etc.)
+        cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        cache.deleteBuffer(upload.buffer);
+        update(pixels, width, height, x, y);
+        return 0;
+    }
+
+    priv::flushPendingDraws(this);
+
+    {
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        // The pixel pointer is an offset into the bound unpack buffer
+        cache.bindTexture(m_texture);
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+        priv::getRenderStats().bytesUploaded += static_cast<Uint64>(size);
+        m_hasMipmap = false;
+        applyMinFilter();
     }
 
-#endif // SFML_OPENGL_ES
+    // Client memory uploads must never see a bound unpack buffer
+    cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
-    // Create the image
-    Image image;
-    image.create(m_size.x, m_size.y, &pixels[0]);
+    glCheck(upload.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    upload.token = ++lastUploadToken;
+    pendingUploads.push_back(upload);
 
-    return image;
+    m_pixelsFlipped = false;
+    m_contentId = getUniqueId();
+    m_opaque = (m_opaque || ((width == m_size.x) && (height == m_size.y))) && priv::arePixelsOpaque(pixels, static_cast<std::size_t>(width) * height);
+
+    return upload.token;
 }
 
 
 ////////////////////////////////////////////////////////////
-void Texture::update(const Uint8* pixels)
+void Texture::updateFromPixelBuffer(unsigned int buffer)
 {
-    // Update the whole texture
-    update(pixels, m_size.x, m_size.y, 0, 0);
-}
+    if (!m_texture)
+        return;
 
+    priv::flushPendingDraws(this);
+
+    priv::GLStateCache& cache = priv::getGLStateCache();
 
-////////////////////////////////////////////////////////////
-void Texture::update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
-{
-#if defined(SFML_DEBUG)
-    assert(x + width <= m_size.x);
-    assert(y + height <= m_size.y);
-#endif
-    
-    if (pixels && m_texture)
     {
         // Make sure that the current texture binding will be preserved
         priv::TextureSaver save;
 
-        // Copy pixels from the given array to the texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+        // The pixel pointer is an offset into the bound unpack buffer
+        cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+        cache.bindTexture(m_texture);
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_size.x, m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+        priv::getRenderStats().bytesUploaded += static_cast<Uint64>(m_size.x) * m_size.y * 4;
         m_hasMipmap = false;
-        m_pixelsFlipped = false;
-        m_cacheId = getUniqueId();
-
-        // Force an OpenGL flush, so that the texture data will appear updated
-        // in all contexts immediately (solves problems in multi-threaded apps)
-        glCheck(glFlush());
+        applyMinFilter();
     }
+
+    // Client memory uploads must never see a bound unpack buffer
+    cache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    m_pixelsFlipped = false;
+    m_opaque = false;
+    m_contentId = getUniqueId();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isUploadComplete(Uint64 token)
+{
+    if (token <= completedUploadToken)
+        return true;
+
+    reclaimUploads();
+
+    return token <= completedUploadToken;
 }
 
 
@@ -436,10 +2075,14 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
     assert(x + texture.m_size.x <= m_size.x);
     assert(y + texture.m_size.y <= m_size.y);
 #endif
-    
-    if (!m_texture || !texture.m_texture)
+
+    texture.ensureResident();
+    if (!ensureResident() || !texture.m_texture)
         return;
 
+    priv::flushPendingDraws(this);
+    priv::resolveTexture(texture);
+
 #ifndef SFML_OPENGL_ES
 
     {
@@ -449,48 +2092,33 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
 
     if (GLAD_GL_EXT_framebuffer_object && GLAD_GL_EXT_framebuffer_blit)
     {
-        // Save the current bindings so we can restore them after we are done
-        GLint readFramebuffer = 0;
-        GLint drawFramebuffer = 0;
+        priv::GLStateCache& cache = priv::getGLStateCache();
 
-        glCheck(glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer));
-        glCheck(glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer));
+        // Save the current bindings so we can restore them after we are done
+        GLuint readFramebuffer = cache.getFramebuffer(GL_READ_FRAMEBUFFER);
+        GLuint drawFramebuffer = cache.getFramebuffer(GL_DRAW_FRAMEBUFFER);
 
-        // Create the framebuffers
-        GLuint sourceFrameBuffer = 0;
-        GLuint destFrameBuffer = 0;
-        glCheck(glGenFramebuffers(1, &sourceFrameBuffer));
-        glCheck(glGenFramebuffers(1, &destFrameBuffer));
+        // Get the frame buffers that have the textures attached
+        GLuint sourceFrameBuffer = getCopyFramebuffer(texture.m_texture);
+        GLuint destFrameBuffer = getCopyFramebuffer(m_texture);
 
-        if (!sourceFrameBuffer || !destFrameBuffer)
+        if (sourceFrameBuffer && destFrameBuffer)
         {
-            err() << "Cannot copy texture, failed to create a frame buffer object" << std::endl;
-            return;
-        }
-
-        // Link the source texture to the source frame buffer
-        glCheck(glBindFramebuffer(GL_READ_FRAMEBUFFER, sourceFrameBuffer));
-        glCheck(glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.m_texture, 0));
+            // The blit would be clipped by the scissor rectangle of the active target
+            bool scissor = cache.isEnabled(GL_SCISSOR_TEST);
+            cache.setEnabled(GL_SCISSOR_TEST, false);
 
-        // Link the destination texture to the destination frame buffer
-        glCheck(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, destFrameBuffer));
-        glCheck(glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0));
+            cache.bindFramebuffer(GL_READ_FRAMEBUFFER, sourceFrameBuffer);
+            cache.bindFramebuffer(GL_DRAW_FRAMEBUFFER, destFrameBuffer);
 
-        // A final check, just to be sure...
-        GLenum sourceStatus;
-        glCheck(sourceStatus = glCheckFramebufferStatus(GL_READ_FRAMEBUFFER));
-
-        GLenum destStatus;
-        glCheck(destStatus = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER));
-
-        if ((sourceStatus == GL_FRAMEBUFFER_COMPLETE) && (destStatus == GL_FRAMEBUFFER_COMPLETE))
-        {
             // Blit the texture contents from the source to the destination texture
             glCheck(glBlitFramebuffer(
                 0, texture.m_pixelsFlipped ? texture.m_size.y : 0, texture.m_size.x, texture.m_pixelsFlipped ? 0 : texture.m_size.y, // Source rectangle, flip y if source is flipped
                 x, y, x + texture.m_size.x, y + texture.m_size.y, // Destination rectangle
                 GL_COLOR_BUFFER_BIT, GL_NEAREST
             ));
+
+            cache.setEnabled(GL_SCISSOR_TEST, scissor);
         }
         else
         {
@@ -498,22 +2126,19 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
         }
 
         // Restore previously bound framebuffers
-        glCheck(glBindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer));
-        glCheck(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFramebuffer));
-
-        // Delete the framebuffers
-        glCheck(glDeleteFramebuffers(1, &sourceFrameBuffer));
-        glCheck(glDeleteFramebuffers(1, &destFrameBuffer));
+        cache.bindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer);
+        cache.bindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFramebuffer);
 
         // Make sure that the current texture binding will be preserved
         priv::TextureSaver save;
 
         // Set the parameters of this texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+        priv::getGLStateCache().bindTexture(m_texture);
         m_hasMipmap = false;
+        applyMinFilter();
         m_pixelsFlipped = false;
-        m_cacheId = getUniqueId();
+        m_contentId = getUniqueId();
+        m_opaque = texture.m_opaque && (m_opaque || ((x == 0) && (y == 0) && (texture.m_size == m_size)));
 
         // Force an OpenGL flush, so that the texture data will appear updated
         // in all contexts immediately (solves problems in multi-threaded apps)
@@ -524,7 +2149,23 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
 
 #endif // SFML_OPENGL_ES
 
-    update(texture.copyToImage(), x, y);
+    Image image = texture.copyToImage();
+
+    if (m_format == R8)
+    {
+        // Single channel textures keep the red channel of the copy
+        std::vector<Uint8> pixels(image.getSize().x * image.getSize().y);
+        const Uint8* source = image.getPixelsPtr();
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+            pixels[i] = source[i * 4];
+
+        if (!pixels.empty())
+            updateSingleChannel(&pixels[0], image.getSize().x, image.getSize().y, x, y);
+
+        return;
+    }
+
+    update(image, x, y);
 }
 
 
@@ -532,14 +2173,14 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
 void Texture::update(const Image& image)
 {
     // Update the whole texture
-    update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, 0, 0);
+    updatePixels(image.getPixelsPtr(), image.getPixelFormat(), image.getSize().x, image.getSize().y, 0, 0);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Texture::update(const Image& image, unsigned int x, unsigned int y)
 {
-    update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, x, y);
+    updatePixels(image.getPixelsPtr(), image.getPixelFormat(), image.getSize().x, image.getSize().y, x, y);
 }
 
 
@@ -552,20 +2193,15 @@ void Texture::setSmooth(bool smooth)
 
         if (m_texture)
         {
+            priv::flushPendingDraws(this);
+
             // Make sure that the current texture binding will be preserved
             priv::TextureSaver save;
 
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            priv::getGLStateCache().bindTexture(m_texture);
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
 
-            if (m_hasMipmap)
-            {
-                glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
-            }
-            else
-            {
-                glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
-            }
+            applyMinFilter();
         }
     }
 }
@@ -592,6 +2228,20 @@ bool Texture::isSrgb() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::setPremultipliedAlpha(bool premultiplied)
+{
+    m_premultiplied = premultiplied;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isPremultipliedAlpha() const
+{
+    return m_premultiplied;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::setRepeated(bool repeated)
 {
@@ -601,6 +2251,8 @@ void Texture::setRepeated(bool repeated)
 
         if (m_texture)
         {
+            priv::flushPendingDraws(this);
+
             // Make sure that the current texture binding will be preserved
             priv::TextureSaver save;
 
@@ -621,7 +2273,7 @@ void Texture::setRepeated(bool repeated)
             }
 
             glCheck(glEnable(GL_TEXTURE_2D));
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            priv::getGLStateCache().bindTexture(m_texture);
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GL_CLAMP_TO_EDGE : GL_CLAMP)));
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GL_CLAMP_TO_EDGE : GL_CLAMP)));
             glCheck(glDisable(GL_TEXTURE_2D));
@@ -651,10 +2303,45 @@ bool Texture::isAttachedToFBO() const
 };
 
 
+////////////////////////////////////////////////////////////
+bool Texture::isDistanceField() const
+{
+    return m_distanceField;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isOpaque() const
+{
+    return m_opaque;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isSingleChannel() const
+{
+    return m_format == R8;
+}
+
+
+////////////////////////////////////////////////////////////
+Texture::Format Texture::getFormat() const
+{
+    return m_format;
+}
+
+
+////////////////////////////////////////////////////////////
+Texture::CoordinateType Texture::getCoordinateType() const
+{
+    return m_texCoordType;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Texture::generateMipmap()
 {
-    if (!m_texture)
+    if (!ensureResident())
         return false;
 
     // Make sure that extensions are initialized
@@ -663,14 +2350,27 @@ bool Texture::generateMipmap()
     if (!GLAD_GL_EXT_framebuffer_object)
         return false;
 
+    priv::flushPendingDraws(this);
+    priv::resolveTexture(*this);
+
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
-    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    priv::getGLStateCache().bindTexture(m_texture);
+
+    // create limits the texture to its base level, open up the whole chain
+    GLint maxLevel = 0;
+    for (unsigned int size = std::max(m_actualSize.x, m_actualSize.y); size > 1; size /= 2)
+        ++maxLevel;
+
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, maxLevel));
     glCheck(glGenerateMipmap(GL_TEXTURE_2D));
-    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
 
     m_hasMipmap = true;
+    applyMinFilter();
+
+    // The full chain of levels adds a third to the size of the base level
+    setMemoryUsage(static_cast<Uint64>(m_actualSize.x) * m_actualSize.y * getBytesPerPixel(m_format) * 4 / 3);
 
     return true;
 }
@@ -685,25 +2385,45 @@ void Texture::invalidateMipmap()
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
-    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    priv::getGLStateCache().bindTexture(m_texture);
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
 
     m_hasMipmap = false;
+    applyMinFilter();
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::applyMinFilter()
+{
+    GLint filter = m_hasMipmap ? (m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR) : (m_isSmooth ? GL_LINEAR : GL_NEAREST);
+
+    // Uploads only change the filter when they drop the mipmap
+    if (filter != m_minFilter)
+    {
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter));
+        m_minFilter = filter;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void Texture::bind(const Texture* texture, CoordinateType coordinateType)
 {
-    if (texture && texture->m_texture)
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
+    if (texture && (texture->m_texture || texture->m_lazySource))
     {
+        priv::resolveTexture(*texture);
+
         // Bind the texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
+        priv::bindSampledTexture(cache.getActiveTexture(), *texture);
     }
     else
     {
         // Bind no texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+        cache.bindTexture(0);
+        cache.bindSampler(cache.getActiveTexture(), 0);
     }
 }
 
@@ -727,6 +2447,50 @@ unsigned int Texture::getMaximumSize()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::isFormatAvailable(Format format)
+{
+
+    switch (format)
+    {
+        case R8:      return isSingleChannelAvailable();
+        case RGBA16F: return isHalfFloatAvailable();
+        default:      return true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::setLazyUploadBudget(Uint64 bytesPerFrame)
+{
+    lazyUploadBudget = bytesPerFrame;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Texture::getLazyUploadBudget()
+{
+    return lazyUploadBudget;
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::setDynamicAtlasThreshold(unsigned int size)
+{
+    dynamicAtlasThreshold = size;
+
+    if (!size)
+        priv::releaseAtlasPages();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Texture::getDynamicAtlasThreshold()
+{
+    return dynamicAtlasThreshold;
+}
+
+
 ////////////////////////////////////////////////////////////
 Texture& Texture::operator =(const Texture& right)
 {
@@ -738,21 +2502,58 @@ Texture& Texture::operator =(const Texture& right)
 }
 
 
+////////////////////////////////////////////////////////////
+Texture& Texture::operator =(Texture&& right) noexcept
+{
+    swap(right);
+
+    return *this;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::swap(Texture& right)
 {
+    priv::flushPendingDraws(this);
+    priv::flushPendingDraws(&right);
+
     std::swap(m_size,          right.m_size);
     std::swap(m_actualSize,    right.m_actualSize);
     std::swap(m_texture,       right.m_texture);
+    std::swap(m_storageFormat, right.m_storageFormat);
     std::swap(m_isSmooth,      right.m_isSmooth);
     std::swap(m_sRgb,          right.m_sRgb);
+    std::swap(m_premultiplied, right.m_premultiplied);
     std::swap(m_isRepeated,    right.m_isRepeated);
     std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
     std::swap(m_fboAttachment, right.m_fboAttachment);
     std::swap(m_hasMipmap,     right.m_hasMipmap);
+    std::swap(m_minFilter,     right.m_minFilter);
+    std::swap(m_distanceField, right.m_distanceField);
+    std::swap(m_opaque,        right.m_opaque);
+    std::swap(m_format,        right.m_format);
+    std::swap(m_texCoordType,  right.m_texCoordType);
+    std::swap(m_memoryUsage,   right.m_memoryUsage);
+    std::swap(m_lastUsedFrame, right.m_lastUsedFrame);
+    std::swap(m_resolver,      right.m_resolver);
+    std::swap(m_lazySource,    right.m_lazySource);
+
+    // The refinement requests refer to the textures that own the sources
+    if ((m_lazySource && m_lazySource->queued) || (right.m_lazySource && right.m_lazySource->queued))
+    {
+        for (std::size_t i = 0; i < streamingRequests.size(); ++i)
+        {
+            if (streamingRequests[i] == this)
+                streamingRequests[i] = &right;
+            else if (streamingRequests[i] == &right)
+                streamingRequests[i] = this;
+        }
+    }
 
-    m_cacheId = getUniqueId();
-    right.m_cacheId = getUniqueId();
+    m_storageId = getUniqueId();
+    m_contentId = m_storageId;
+    right.m_storageId = getUniqueId();
+    right.m_contentId = right.m_storageId;
 }
 
 
@@ -763,6 +2564,44 @@ unsigned int Texture::getNativeHandle() const
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 Texture::getLastUsedFrame() const
+{
+    return m_lastUsedFrame;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Texture::getMemoryUsage() const
+{
+    return m_memoryUsage;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Texture::getStorageId() const
+{
+    return m_storageId;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Texture::getContentId() const
+{
+    return m_contentId;
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::setMemoryUsage(Uint64 bytes)
+{
+    Uint64 previous = m_memoryUsage;
+    m_memoryUsage = bytes;
+
+    priv::trackGpuMemory(GpuMemory::Textures, previous, bytes);
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int Texture::getValidSize(unsigned int size)
 {
@@ -794,4 +2633,135 @@ unsigned int Texture::getValidSize(unsigned int size)
     }
 }
 
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void releaseCopyFramebuffers()
+{
+    Lock lock(copyFramebufferMutex);
+
+    std::map<void*, CopyFramebufferList>::iterator it = copyFramebuffers.find(getCurrentContext());
+    if (it == copyFramebuffers.end())
+        return;
+
+    for (std::size_t i = 0; i < it->second.size(); ++i)
+        getGLStateCache().deleteFramebuffer(it->second[i].framebuffer);
+
+    // Another context may be created at the same address
+    copyFramebuffers.erase(it);
+}
+
+
+////////////////////////////////////////////////////////////
+void resolveTexture(const Texture& texture)
+{
+    if (texture.m_lazySource)
+    {
+        // The first lazy draw of a frame refines the textures requested by the previous one
+        Uint64 frame = GpuMemory::getCurrentFrame();
+        if (frame != lazyUploadFrame)
+        {
+            lazyUploadFrame = frame;
+            lazyUploadSpent = 0;
+            Texture::processStreamingRequests();
+        }
+
+        // Streamed textures start with a small level, the detail requests bring the larger ones
+        if (texture.m_lazySource && !texture.m_texture)
+        {
+            const Texture::LazySource& source = *texture.m_lazySource;
+            unsigned int levelCount = static_cast<unsigned int>(source.levelBytes.size());
+            unsigned int level = 0;
+            if (source.streamed)
+            {
+                Vector2u size = source.size;
+                while ((level + 1 < levelCount) && (std::max(size.x, size.y) > streamingPlaceholderSize))
+                {
+                    size = Vector2u(std::max(size.x / 2, 1u), std::max(size.y / 2, 1u));
+                    ++level;
+                }
+            }
+
+            if (reserveLazyUpload(source.getUploadSize(level)))
+                texture.uploadLazySource(level);
+        }
+    }
+
+    if (texture.m_resolver)
+    {
+        // Reset first, the resolve may bind the texture again
+        RenderTextureImpl* resolver = texture.m_resolver;
+        texture.m_resolver = NULL;
+
+        resolver->resolve();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool isTextureStreamed(const Texture& texture)
+{
+    return texture.m_lazySource && texture.m_lazySource->streamed;
+}
+
+
+////////////////////////////////////////////////////////////
+void requestTextureDetail(const Texture& texture, float texelsPerPixel, float footprint)
+{
+    Texture::LazySource* source = texture.m_lazySource;
+    if (!source || !source->streamed)
+        return;
+
+    // Each level halves the texels per screen pixel, the level displayed has at least one
+    unsigned int levelCount = static_cast<unsigned int>(source->levelBytes.size());
+    unsigned int level = 0;
+    while ((texelsPerPixel >= 2.f) && (level + 1 < levelCount))
+    {
+        texelsPerPixel *= 0.5f;
+        ++level;
+    }
+
+    Uint64 frame = GpuMemory::getCurrentFrame();
+    if (source->wantedFrame != frame)
+    {
+        source->wantedFrame = frame;
+        source->wantedLevel = level;
+        source->footprint   = footprint;
+    }
+    else
+    {
+        source->wantedLevel = std::min(source->wantedLevel, level);
+        source->footprint   = std::max(source->footprint, footprint);
+    }
+
+    if ((source->wantedLevel < source->residentLevel) && !source->queued)
+    {
+        source->queued = true;
+        streamingRequests.push_back(&texture);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int getSampledTexture(const Texture& texture)
+{
+    if (!texture.m_texture && texture.m_lazySource)
+        return getTransparentTexture();
+
+    return texture.m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void bindSampledTexture(unsigned int unit, const Texture& texture)
+{
+    GLStateCache& cache = getGLStateCache();
+
+    cache.bindTexture(unit, getSampledTexture(texture));
+    cache.bindSampler(unit, cache.getSampler(texture.m_isSmooth, texture.m_isRepeated, texture.m_hasMipmap));
+}
+
+} // namespace priv
+
 } // namespace sf
@@ -0,0 +1,289 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Immutable storage: ES 3 core, or ARB_texture_storage (core in OpenGL 4.2)
+    bool isTextureStorageAvailable()
+    {
+#if defined(SFML_OPENGL_ES) || defined(SFML_SYSTEM_EMSCRIPTEN)
+        return (GLAD_GL_ES_VERSION_3_0 > 0);
+#else
+        return (GLAD_GL_ARB_texture_storage > 0);
+#endif
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+LayeredVertex::LayeredVertex() :
+position (0, 0),
+color    (255, 255, 255),
+texCoords(0, 0),
+layer    (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+LayeredVertex::LayeredVertex(const Vector2f& thePosition, const Color& theColor, const Vector2f& theTexCoords, unsigned int theLayer) :
+position (thePosition),
+color    (theColor),
+texCoords(theTexCoords),
+layer    (static_cast<float>(theLayer))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureArray::TextureArray() :
+m_size       (0, 0),
+m_layerCount (0),
+m_levelCount (0),
+m_texture    (0),
+m_isSmooth   (false),
+m_memoryUsage(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureArray::~TextureArray()
+{
+    if (m_texture)
+        priv::getGLStateCache().deleteTexture(static_cast<GLuint>(m_texture));
+
+    priv::trackGpuMemory(GpuMemory::Textures, m_memoryUsage, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::create(unsigned int width, unsigned int height, unsigned int layers, bool mipmaps)
+{
+    if (!isAvailable())
+    {
+        err() << "Failed to create texture array, texture arrays are not supported by the driver" << std::endl;
+        return false;
+    }
+
+    if ((width == 0) || (height == 0) || (layers == 0))
+    {
+        err() << "Failed to create texture array, invalid size (" << width << "x" << height << "x" << layers << ")" << std::endl;
+        return false;
+    }
+
+    unsigned int maxSize = Texture::getMaximumSize();
+    GLint maxLayers = 0;
+    glCheck(glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers));
+    if ((width > maxSize) || (height > maxSize) || (layers > static_cast<unsigned int>(maxLayers)))
+    {
+        err() << "Failed to create texture array, its size is too high "
+              << "(" << width << "x" << height << "x" << layers << ", "
+              << "maximum is " << maxSize << "x" << maxSize << "x" << maxLayers << ")"
+              << std::endl;
+        return false;
+    }
+
+    // Immutable storage can't be redefined, a new texture is needed every time
+    if (m_texture)
+        priv::getGLStateCache().deleteTexture(static_cast<GLuint>(m_texture));
+
+    GLuint texture;
+    glCheck(glGenTextures(1, &texture));
+    m_texture = static_cast<unsigned int>(texture);
+
+    m_size       = Vector2u(width, height);
+    m_layerCount = layers;
+    m_levelCount = 1;
+    if (mipmaps)
+    {
+        for (unsigned int size = std::max(width, height); size > 1; size /= 2)
+            ++m_levelCount;
+    }
+
+    glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, m_texture));
+
+    if (isTextureStorageAvailable())
+    {
+        glCheck(glTexStorage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLsizei>(m_levelCount), GL_RGBA8, width, height, layers));
+    }
+    else
+    {
+        for (unsigned int level = 0; level < m_levelCount; ++level)
+        {
+            GLsizei levelWidth  = static_cast<GLsizei>(std::max(width >> level, 1u));
+            GLsizei levelHeight = static_cast<GLsizei>(std::max(height >> level, 1u));
+            glCheck(glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA8, levelWidth, levelHeight, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+        }
+
+        glCheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_levelCount - 1)));
+    }
+
+    glCheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    glCheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    applyFilter();
+
+    glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+
+    // The full chain of levels adds a third to the size of the base level
+    Uint64 memoryUsage = static_cast<Uint64>(width) * height * layers * 4;
+    if (m_levelCount > 1)
+        memoryUsage = memoryUsage * 4 / 3;
+
+    priv::trackGpuMemory(GpuMemory::Textures, m_memoryUsage, memoryUsage);
+    m_memoryUsage = memoryUsage;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::update(const Uint8* pixels, unsigned int layer)
+{
+    if (!m_texture || !pixels || (layer >= m_layerCount))
+    {
+        err() << "Failed to update texture array, invalid layer " << layer << " (the array has " << m_layerCount << ")" << std::endl;
+        return false;
+    }
+
+    glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, m_texture));
+    glCheck(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(layer), m_size.x, m_size.y, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+
+    priv::getRenderStats().bytesUploaded += static_cast<Uint64>(m_size.x) * m_size.y * 4;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::update(const Image& image, unsigned int layer)
+{
+    if (image.getSize() != m_size)
+    {
+        err() << "Failed to update texture array, the image is " << image.getSize().x << "x" << image.getSize().y
+              << " but the layers are " << m_size.x << "x" << m_size.y << std::endl;
+        return false;
+    }
+
+    return update(image.getPixelsPtr(), layer);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::generateMipmap()
+{
+    if (!m_texture || (m_levelCount < 2))
+        return false;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, m_texture));
+    glCheck(glGenerateMipmap(GL_TEXTURE_2D_ARRAY));
+    glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureArray::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getLayerCount() const
+{
+    return m_layerCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::setSmooth(bool smooth)
+{
+    if (smooth == m_isSmooth)
+        return;
+
+    m_isSmooth = smooth;
+
+    if (m_texture)
+    {
+        glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, m_texture));
+        applyFilter();
+        glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getNativeHandle() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isAvailable()
+{
+    return priv::getGraphicsCaps().textureArrays;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::applyFilter()
+{
+    GLint minFilter = GL_NEAREST;
+    if (m_levelCount > 1)
+        minFilter = m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR;
+    else if (m_isSmooth)
+        minFilter = GL_LINEAR;
+
+    glCheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    glCheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, minFilter));
+}
+
+} // namespace sf
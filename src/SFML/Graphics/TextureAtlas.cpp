@@ -0,0 +1,243 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <SFML/Graphics/AlphaHull.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const TextureAtlas::Handle TextureAtlas::InvalidHandle = static_cast<TextureAtlas::Handle>(-1);
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Region::Region() :
+texture  (NULL),
+rect     (),
+texCoords(),
+mesh     ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas(unsigned int pageSize, unsigned int padding) :
+m_pageSize  (pageSize),
+m_padding   (padding),
+m_isSmooth  (false),
+m_meshBudget(0),
+m_pages     (),
+m_entries   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Handle TextureAtlas::add(const Image& image)
+{
+    Vector2u size = image.getSize();
+    if ((size.x == 0) || (size.y == 0))
+    {
+        err() << "Failed to add an image to the texture atlas: the image is empty" << std::endl;
+        return InvalidHandle;
+    }
+
+    // The page size is only known to be valid once a GL context exists
+    unsigned int pageSize = std::min(m_pageSize, Texture::getMaximumSize());
+    if ((size.x + m_padding * 2 > pageSize) || (size.y + m_padding * 2 > pageSize))
+    {
+        err() << "Failed to add an image to the texture atlas: "
+              << "the image (" << size.x << "x" << size.y << ") is bigger than a page (" << pageSize << "x" << pageSize << ")"
+              << std::endl;
+        return InvalidHandle;
+    }
+
+    // Each image reserves its padding on the right and bottom (the left and top
+    // padding of the page are reserved by the initial skyline)
+    unsigned int width  = size.x + m_padding;
+    unsigned int height = size.y + m_padding;
+
+    // Try the existing pages first, the last one is the most likely to have room
+    Entry entry;
+    bool found = false;
+    for (std::size_t i = m_pages.size(); (i > 0) && !found; --i)
+    {
+        if (m_pages[i - 1].packer.insert(width, height, entry.rect))
+        {
+            entry.page = i - 1;
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        if (!addPage() || !m_pages.back().packer.insert(width, height, entry.rect))
+            return InvalidHandle;
+
+        entry.page = m_pages.size() - 1;
+    }
+
+    entry.rect.width  = size.x;
+    entry.rect.height = size.y;
+    m_pages[entry.page].texture.update(image, entry.rect.left, entry.rect.top);
+
+    if (m_meshBudget >= 3)
+        priv::computeAlphaHull(image, IntRect(0, 0, size.x, size.y), m_meshBudget, entry.mesh);
+
+    m_entries.push_back(entry);
+    return m_entries.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Handle TextureAtlas::addFromMemory(const void* data, std::size_t size)
+{
+    Image image;
+    if (!image.loadFromMemory(data, size))
+        return InvalidHandle;
+
+    return add(image);
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Handle TextureAtlas::addFromStream(InputStream& stream)
+{
+    Image image;
+    if (!image.loadFromStream(stream))
+        return InvalidHandle;
+
+    return add(image);
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Region TextureAtlas::getRegion(Handle handle) const
+{
+    Region region;
+    if (handle >= m_entries.size())
+        return region;
+
+    const Entry& entry = m_entries[handle];
+    const Texture& texture = m_pages[entry.page].texture;
+    float width  = static_cast<float>(texture.getSize().x);
+    float height = static_cast<float>(texture.getSize().y);
+
+    region.texture   = &texture;
+    region.rect      = entry.rect;
+    region.texCoords = FloatRect(entry.rect.left / width, entry.rect.top / height, entry.rect.width / width, entry.rect.height / height);
+    region.mesh      = entry.mesh;
+
+    return region;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getRegionCount() const
+{
+    return m_entries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getPageCount() const
+{
+    return m_pages.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getPage(std::size_t index) const
+{
+    return m_pages[index].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setSmooth(bool smooth)
+{
+    m_isSmooth = smooth;
+
+    for (std::deque<Page>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        it->texture.setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setMeshVertexBudget(std::size_t maxVertices)
+{
+    m_meshBudget = maxVertices;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getMeshVertexBudget() const
+{
+    return m_meshBudget;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::clear()
+{
+    m_pages.clear();
+    m_entries.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::addPage()
+{
+    unsigned int pageSize = std::min(m_pageSize, Texture::getMaximumSize());
+
+    // Start from transparent pixels so that the padding doesn't bleed when smoothing
+    Image pixels;
+    pixels.create(pageSize, pageSize, Color::Transparent);
+
+    m_pages.push_back(Page());
+    Page& page = m_pages.back();
+    if (!page.texture.loadFromImage(pixels))
+    {
+        err() << "Failed to add a page to the texture atlas" << std::endl;
+        m_pages.pop_back();
+        return false;
+    }
+
+    page.texture.setSmooth(m_isSmooth);
+
+    // The first row and column of the page hold the left and top padding
+    page.packer.reset(pageSize, pageSize, m_padding);
+
+    return true;
+}
+
+} // namespace sf
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TexturePool.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <vector>
+
+
+namespace
+{
+    struct PooledTexture
+    {
+        unsigned int texture;
+        sf::Vector2u size;
+        unsigned int format;
+    };
+
+    // Textures can be destroyed by loading threads, with their own context
+    sf::Mutex poolMutex;
+
+    // Oldest textures first
+    std::vector<PooledTexture> pool;
+    std::size_t capacity = 0;
+
+    sf::Uint64 getStorageSize(const PooledTexture& entry)
+    {
+        return static_cast<sf::Uint64>(entry.size.x) * entry.size.y * (entry.format == GL_R8 ? 1 : (entry.format == GL_RGBA16F ? 8 : 4));
+    }
+
+    // Destroy the oldest textures until the pool holds at most count of them (poolMutex must be locked)
+    void trimPool(std::size_t count)
+    {
+        if (pool.size() <= count)
+            return;
+
+        std::size_t removed = pool.size() - count;
+        for (std::size_t i = 0; i < removed; ++i)
+        {
+            sf::priv::getGLStateCache().deleteTexture(static_cast<GLuint>(pool[i].texture));
+            sf::priv::trackGpuMemory(sf::GpuMemory::Textures, getStorageSize(pool[i]), 0);
+        }
+
+        pool.erase(pool.begin(), pool.begin() + removed);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+void TexturePool::setCapacity(std::size_t count)
+{
+    Lock lock(poolMutex);
+
+    capacity = count;
+    trimPool(capacity);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TexturePool::getCapacity()
+{
+    Lock lock(poolMutex);
+
+    return capacity;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TexturePool::getCount()
+{
+    Lock lock(poolMutex);
+
+    return pool.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void TexturePool::clear()
+{
+    Lock lock(poolMutex);
+
+    trimPool(0);
+}
+
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+unsigned int acquirePooledTexture(const Vector2u& size, unsigned int format)
+{
+    Lock lock(poolMutex);
+
+    // Prefer the most recently released textures, which are the most likely to be resident
+    for (std::size_t i = pool.size(); i > 0; --i)
+    {
+        PooledTexture entry = pool[i - 1];
+        if ((entry.size == size) && (entry.format == format))
+        {
+            pool.erase(pool.begin() + (i - 1));
+            trackGpuMemory(GpuMemory::Textures, getStorageSize(entry), 0);
+            return entry.texture;
+        }
+    }
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool releasePooledTexture(unsigned int texture, const Vector2u& size, unsigned int format)
+{
+    Lock lock(poolMutex);
+
+    if ((capacity == 0) || (format == 0))
+        return false;
+
+    trimPool(capacity - 1);
+
+    PooledTexture entry = {texture, size, format};
+    pool.push_back(entry);
+    trackGpuMemory(GpuMemory::Textures, 0, getStorageSize(entry));
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
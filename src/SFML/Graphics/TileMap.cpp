@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TileMap.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TileMap::TileMap() :
+m_tiles     (),
+m_chunks    (),
+m_mapSize   (0, 0),
+m_tileSize  (0, 0),
+m_chunkSize (0),
+m_chunkCount(0, 0),
+m_texture   (NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileMap::create(const Vector2u& mapSize, const Vector2u& tileSize, unsigned int chunkSize)
+{
+    m_tiles.clear();
+    m_chunks.clear();
+    m_mapSize = Vector2u(0, 0);
+    m_chunkCount = Vector2u(0, 0);
+
+    if ((mapSize.x == 0) || (mapSize.y == 0) || (tileSize.x == 0) || (tileSize.y == 0) || (chunkSize == 0))
+    {
+        err() << "Failed to create tile map, invalid size (map: " << mapSize.x << "x" << mapSize.y
+              << ", tile: " << tileSize.x << "x" << tileSize.y << ", chunk: " << chunkSize << ")" << std::endl;
+        return false;
+    }
+
+    Vector2u chunkCount((mapSize.x + chunkSize - 1) / chunkSize, (mapSize.y + chunkSize - 1) / chunkSize);
+    m_chunks.resize(chunkCount.x * chunkCount.y);
+
+    for (unsigned int y = 0; y < chunkCount.y; ++y)
+    {
+        for (unsigned int x = 0; x < chunkCount.x; ++x)
+        {
+            unsigned int width  = std::min(chunkSize, mapSize.x - x * chunkSize);
+            unsigned int height = std::min(chunkSize, mapSize.y - y * chunkSize);
+
+            // Two triangles per tile, edited through the shadow copy
+            VertexBuffer& chunk = m_chunks[y * chunkCount.x + x];
+            chunk.setPrimitiveType(Triangles);
+            chunk.setUsage(VertexBuffer::Static);
+            chunk.setShadowed(true);
+
+            if (!chunk.create(width * height * 6))
+            {
+                err() << "Failed to create tile map, chunk " << x << "x" << y << " could not be created" << std::endl;
+                m_chunks.clear();
+                return false;
+            }
+        }
+    }
+
+    m_tiles.assign(mapSize.x * mapSize.y, -1);
+    m_mapSize = mapSize;
+    m_tileSize = tileSize;
+    m_chunkSize = chunkSize;
+    m_chunkCount = chunkCount;
+
+    setTiles(&m_tiles[0]);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTexture(const Texture& texture)
+{
+    m_texture = &texture;
+
+    // Texture coordinates depend on the layout of the atlas
+    if (!m_tiles.empty())
+        setTiles(&m_tiles[0]);
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* TileMap::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTile(unsigned int x, unsigned int y, int tile)
+{
+    m_tiles[y * m_mapSize.x + x] = tile;
+    updateTile(x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTiles(const int* tiles)
+{
+    if (tiles != &m_tiles[0])
+        std::copy(tiles, tiles + m_tiles.size(), m_tiles.begin());
+
+    for (unsigned int y = 0; y < m_mapSize.y; ++y)
+        for (unsigned int x = 0; x < m_mapSize.x; ++x)
+            updateTile(x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+int TileMap::getTile(unsigned int x, unsigned int y) const
+{
+    return m_tiles[y * m_mapSize.x + x];
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TileMap::getMapSize() const
+{
+    return m_mapSize;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TileMap::getTileSize() const
+{
+    return m_tileSize;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TileMap::getChunkSize() const
+{
+    return m_chunkSize;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getLocalBounds() const
+{
+    return FloatRect(0.f, 0.f, static_cast<float>(m_mapSize.x * m_tileSize.x), static_cast<float>(m_mapSize.y * m_tileSize.y));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getGlobalBounds() const
+{
+    return getTransformedBounds(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_chunks.empty() || !m_texture)
+        return;
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    // Area of the world seen by the view, in the local coordinates of the map
+    const Transform& viewToWorld = target.getView().getInverseTransform();
+    FloatRect visible = viewToWorld.transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+    visible = states.transform.getInverse().transformRect(visible);
+
+    // Range of chunks that intersect it
+    float chunkWidth  = static_cast<float>(m_chunkSize * m_tileSize.x);
+    float chunkHeight = static_cast<float>(m_chunkSize * m_tileSize.y);
+    int left   = std::max(static_cast<int>(std::floor(visible.left / chunkWidth)), 0);
+    int top    = std::max(static_cast<int>(std::floor(visible.top / chunkHeight)), 0);
+    int right  = std::min(static_cast<int>(std::ceil((visible.left + visible.width) / chunkWidth)), static_cast<int>(m_chunkCount.x));
+    int bottom = std::min(static_cast<int>(std::ceil((visible.top + visible.height) / chunkHeight)), static_cast<int>(m_chunkCount.y));
+
+    for (int y = top; y < bottom; ++y)
+        for (int x = left; x < right; ++x)
+            target.draw(m_chunks[y * m_chunkCount.x + x], states);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileMap::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::updateTile(unsigned int x, unsigned int y)
+{
+    // Locate the tile in its chunk
+    unsigned int chunkX = x / m_chunkSize;
+    unsigned int chunkY = y / m_chunkSize;
+    unsigned int chunkWidth = std::min(m_chunkSize, m_mapSize.x - chunkX * m_chunkSize);
+    std::size_t offset = ((y % m_chunkSize) * chunkWidth + (x % m_chunkSize)) * 6;
+
+    VertexBuffer& chunk = m_chunks[chunkY * m_chunkCount.x + chunkX];
+    Vertex* vertices = chunk.getVertices() + offset;
+
+    float left   = static_cast<float>(x * m_tileSize.x);
+    float top    = static_cast<float>(y * m_tileSize.y);
+    float right  = left + m_tileSize.x;
+    float bottom = top + m_tileSize.y;
+
+    // Locate the tile in the atlas; missing tiles are collapsed to a point
+    int tile = m_tiles[y * m_mapSize.x + x];
+    unsigned int columns = m_texture ? m_texture->getSize().x / m_tileSize.x : 0;
+    unsigned int rows    = m_texture ? m_texture->getSize().y / m_tileSize.y : 0;
+
+    if ((tile < 0) || (static_cast<unsigned int>(tile) >= columns * rows))
+    {
+        for (std::size_t i = 0; i < 6; ++i)
+            vertices[i] = Vertex(Vector2f(left, top));
+    }
+    else
+    {
+        // Texture coordinates are normalized, like the ones of sprites
+        Vector2f textureSize(m_texture->getSize());
+        float texLeft   = static_cast<float>((tile % columns) * m_tileSize.x) / textureSize.x;
+        float texTop    = static_cast<float>((tile / columns) * m_tileSize.y) / textureSize.y;
+        float texRight  = texLeft + m_tileSize.x / textureSize.x;
+        float texBottom = texTop + m_tileSize.y / textureSize.y;
+
+        vertices[0] = Vertex(Vector2f(left, top),     Vector2f(texLeft, texTop));
+        vertices[1] = Vertex(Vector2f(left, bottom),  Vector2f(texLeft, texBottom));
+        vertices[2] = Vertex(Vector2f(right, top),    Vector2f(texRight, texTop));
+        vertices[3] = Vertex(Vector2f(right, top),    Vector2f(texRight, texTop));
+        vertices[4] = Vertex(Vector2f(left, bottom),  Vector2f(texLeft, texBottom));
+        vertices[5] = Vertex(Vector2f(right, bottom), Vector2f(texRight, texBottom));
+    }
+
+    chunk.markDirty(offset, 6);
+}
+
+} // namespace sf
@@ -0,0 +1,260 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TiledTexture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Trace.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TiledTexture::TiledTexture() :
+m_tiles    (),
+m_size     (0, 0),
+m_tileCount(0, 0),
+m_tileSize (0),
+m_isSmooth (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TiledTexture::~TiledTexture()
+{
+    cleanup();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TiledTexture::loadFromMemory(const void* data, std::size_t size, unsigned int tileSize)
+{
+    cleanup();
+
+    Vector2u imageSize;
+    Uint8* pixels = priv::ImageLoader::getInstance().decodeImageFromMemory(data, size, imageSize);
+    if (!pixels)
+        return false;
+
+    bool result = loadFromPixels(pixels, imageSize, tileSize);
+    priv::ImageLoader::getInstance().freeDecodedPixels(pixels, imageSize);
+
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TiledTexture::loadFromStream(InputStream& stream, unsigned int tileSize)
+{
+    cleanup();
+
+    Vector2u imageSize;
+    Uint8* pixels = priv::ImageLoader::getInstance().decodeImageFromStream(stream, imageSize);
+    if (!pixels)
+        return false;
+
+    bool result = loadFromPixels(pixels, imageSize, tileSize);
+    priv::ImageLoader::getInstance().freeDecodedPixels(pixels, imageSize);
+
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TiledTexture::loadFromImage(const Image& image, unsigned int tileSize)
+{
+    cleanup();
+
+    if ((image.getSize().x == 0) || (image.getSize().y == 0))
+    {
+        err() << "Failed to load tiled texture, the image is empty" << std::endl;
+        return false;
+    }
+
+    return loadFromPixels(image.getPixelsPtr(), image.getSize(), tileSize);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TiledTexture::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TiledTexture::getTileSize() const
+{
+    return m_tileSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void TiledTexture::setSmooth(bool smooth)
+{
+    m_isSmooth = smooth;
+
+    for (std::size_t i = 0; i < m_tiles.size(); ++i)
+        m_tiles[i]->setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TiledTexture::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TiledTexture::getLocalBounds() const
+{
+    return FloatRect(0.f, 0.f, static_cast<float>(m_size.x), static_cast<float>(m_size.y));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TiledTexture::getGlobalBounds() const
+{
+    return getTransformedBounds(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TiledTexture::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_tiles.empty())
+        return;
+
+    states.transform *= getTransform();
+
+    // Area of the world seen by the view, in the local coordinates of the image
+    const Transform& viewToWorld = target.getView().getInverseTransform();
+    FloatRect visible = viewToWorld.transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+    visible = states.transform.getInverse().transformRect(visible);
+
+    // Range of tiles that intersect it
+    float tileSize = static_cast<float>(m_tileSize);
+    int left   = std::max(static_cast<int>(std::floor(visible.left / tileSize)), 0);
+    int top    = std::max(static_cast<int>(std::floor(visible.top / tileSize)), 0);
+    int right  = std::min(static_cast<int>(std::ceil((visible.left + visible.width) / tileSize)), static_cast<int>(m_tileCount.x));
+    int bottom = std::min(static_cast<int>(std::ceil((visible.top + visible.height) / tileSize)), static_cast<int>(m_tileCount.y));
+
+    for (int y = top; y < bottom; ++y)
+    {
+        for (int x = left; x < right; ++x)
+        {
+            const Texture* tile = m_tiles[y * m_tileCount.x + x];
+            Vector2f size(tile->getSize());
+            Vector2f position(x * tileSize, y * tileSize);
+
+            Vertex vertices[4] =
+            {
+                Vertex(position,                                 Vector2f(0.f, 0.f)),
+                Vertex(Vector2f(position.x, position.y + size.y), Vector2f(0.f, 1.f)),
+                Vertex(Vector2f(position.x + size.x, position.y), Vector2f(1.f, 0.f)),
+                Vertex(position + size,                          Vector2f(1.f, 1.f))
+            };
+
+            states.texture = tile;
+            target.draw(vertices, 4, TriangleStrip, states);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TiledTexture::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TiledTexture::loadFromPixels(const Uint8* pixels, const Vector2u& size, unsigned int tileSize)
+{
+    SFML_TRACE_SCOPE("TiledTexture::loadFromPixels");
+
+    unsigned int maximumSize = Texture::getMaximumSize();
+    if ((tileSize == 0) || (tileSize > maximumSize))
+        tileSize = maximumSize;
+
+    m_size      = size;
+    m_tileSize  = tileSize;
+    m_tileCount = Vector2u((size.x + tileSize - 1) / tileSize, (size.y + tileSize - 1) / tileSize);
+    m_tiles.reserve(m_tileCount.x * m_tileCount.y);
+
+    // Each tile is uploaded straight from its rectangle of the pixels
+    ImageView source(pixels, size.x, size.y);
+    for (unsigned int y = 0; y < m_tileCount.y; ++y)
+    {
+        for (unsigned int x = 0; x < m_tileCount.x; ++x)
+        {
+            unsigned int width  = std::min(tileSize, size.x - x * tileSize);
+            unsigned int height = std::min(tileSize, size.y - y * tileSize);
+
+            Texture* tile = new Texture;
+            m_tiles.push_back(tile);
+            tile->setSmooth(m_isSmooth);
+            if (!tile->create(width, height))
+            {
+                err() << "Failed to load tiled texture, failed to create tile (" << x << ", " << y << ")" << std::endl;
+                cleanup();
+                return false;
+            }
+
+            IntRect area(static_cast<int>(x * tileSize), static_cast<int>(y * tileSize), static_cast<int>(width), static_cast<int>(height));
+            tile->update(source.subView(area), 0, 0);
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TiledTexture::cleanup()
+{
+    for (std::size_t i = 0; i < m_tiles.size(); ++i)
+        delete m_tiles[i];
+
+    m_tiles.clear();
+    m_size      = Vector2u(0, 0);
+    m_tileCount = Vector2u(0, 0);
+    m_tileSize  = 0;
+}
+
+} // namespace sf
@@ -26,8 +26,20 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 #include <cmath>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+    #include <xmmintrin.h>
+    #define SFML_TRANSFORM_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_TRANSFORM_NEON
+#elif defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define SFML_TRANSFORM_WASM_SIMD
+#endif
+
 
 namespace sf
 {
@@ -39,27 +51,36 @@ const Transform Transform::Identity;
 Transform::Transform()
 {
     // Identity matrix
-    m_matrix[0] = 1.f; m_matrix[4] = 0.f; m_matrix[8]  = 0.f; m_matrix[12] = 0.f;
-    m_matrix[1] = 0.f; m_matrix[5] = 1.f; m_matrix[9]  = 0.f; m_matrix[13] = 0.f;
-    m_matrix[2] = 0.f; m_matrix[6] = 0.f; m_matrix[10] = 1.f; m_matrix[14] = 0.f;
-    m_matrix[3] = 0.f; m_matrix[7] = 0.f; m_matrix[11] = 0.f; m_matrix[15] = 1.f;
+    m_matrix[0] = 1.f; m_matrix[1] = 0.f; m_matrix[2] = 0.f;
+    m_matrix[3] = 0.f; m_matrix[4] = 1.f; m_matrix[5] = 0.f;
 }
 
 
 ////////////////////////////////////////////////////////////
 Transform::Transform(float a00, float a01, float a02,
                      float a10, float a11, float a12,
-                     float a20, float a21, float a22)
+                     float, float, float)
 {
-    m_matrix[0] = a00; m_matrix[4] = a01; m_matrix[8]  = 0.f; m_matrix[12] = a02;
-    m_matrix[1] = a10; m_matrix[5] = a11; m_matrix[9]  = 0.f; m_matrix[13] = a12;
-    m_matrix[2] = 0.f; m_matrix[6] = 0.f; m_matrix[10] = 1.f; m_matrix[14] = 0.f;
-    m_matrix[3] = a20; m_matrix[7] = a21; m_matrix[11] = 0.f; m_matrix[15] = a22;
+    // The last row of an affine transform is always (0, 0, 1)
+    m_matrix[0] = a00; m_matrix[1] = a01; m_matrix[2] = a02;
+    m_matrix[3] = a10; m_matrix[4] = a11; m_matrix[5] = a12;
 }
 
 
 ////////////////////////////////////////////////////////////
-const float* Transform::getMatrix() const
+void Transform::getMatrix(float* matrix) const
+{
+    const float* a = m_matrix;
+
+    matrix[0] = a[0]; matrix[4] = a[1]; matrix[8]  = 0.f; matrix[12] = a[2];
+    matrix[1] = a[3]; matrix[5] = a[4]; matrix[9]  = 0.f; matrix[13] = a[5];
+    matrix[2] = 0.f;  matrix[6] = 0.f;  matrix[10] = 1.f; matrix[14] = 0.f;
+    matrix[3] = 0.f;  matrix[7] = 0.f;  matrix[11] = 0.f; matrix[15] = 1.f;
+}
+
+
+////////////////////////////////////////////////////////////
+const float* Transform::getAffineMatrix() const
 {
     return m_matrix;
 }
@@ -68,24 +89,22 @@ const float* Transform::getMatrix() const
 ////////////////////////////////////////////////////////////
 Transform Transform::getInverse() const
 {
-    // Compute the determinant
-    float det = m_matrix[0] * (m_matrix[15] * m_matrix[5] - m_matrix[7] * m_matrix[13]) -
-                m_matrix[1] * (m_matrix[15] * m_matrix[4] - m_matrix[7] * m_matrix[12]) +
-                m_matrix[3] * (m_matrix[13] * m_matrix[4] - m_matrix[5] * m_matrix[12]);
+    const float* a = m_matrix;
+
+    // Compute the determinant of the linear part
+    float det = a[0] * a[4] - a[1] * a[3];
 
     // Compute the inverse if the determinant is not zero
     // (don't use an epsilon because the determinant may *really* be tiny)
     if (det != 0.f)
     {
-        return Transform( (m_matrix[15] * m_matrix[5] - m_matrix[7] * m_matrix[13]) / det,
-                         -(m_matrix[15] * m_matrix[4] - m_matrix[7] * m_matrix[12]) / det,
-                          (m_matrix[13] * m_matrix[4] - m_matrix[5] * m_matrix[12]) / det,
-                         -(m_matrix[15] * m_matrix[1] - m_matrix[3] * m_matrix[13]) / det,
-                          (m_matrix[15] * m_matrix[0] - m_matrix[3] * m_matrix[12]) / det,
-                         -(m_matrix[13] * m_matrix[0] - m_matrix[1] * m_matrix[12]) / det,
-                          (m_matrix[7]  * m_matrix[1] - m_matrix[3] * m_matrix[5])  / det,
-                         -(m_matrix[7]  * m_matrix[0] - m_matrix[3] * m_matrix[4])  / det,
-                          (m_matrix[5]  * m_matrix[0] - m_matrix[1] * m_matrix[4])  / det);
+        return Transform( a[4] / det,
+                         -a[1] / det,
+                          (a[1] * a[5] - a[4] * a[2]) / det,
+                         -a[3] / det,
+                          a[0] / det,
+                          (a[3] * a[2] - a[0] * a[5]) / det,
+                          0.f, 0.f, 1.f);
     }
     else
     {
@@ -97,8 +116,8 @@ Transform Transform::getInverse() const
 ////////////////////////////////////////////////////////////
 Vector2f Transform::transformPoint(float x, float y) const
 {
-    return Vector2f(m_matrix[0] * x + m_matrix[4] * y + m_matrix[12],
-                    m_matrix[1] * x + m_matrix[5] * y + m_matrix[13]);
+    return Vector2f(m_matrix[0] * x + m_matrix[1] * y + m_matrix[2],
+                    m_matrix[3] * x + m_matrix[4] * y + m_matrix[5]);
 }
 
 
@@ -109,6 +128,156 @@ Vector2f Transform::transformPoint(const Vector2f& point) const
 }
 
 
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vertex* input, Vertex* output, std::size_t count) const
+{
+    const float* m = m_matrix;
+    std::size_t i = 0;
+
+    // The kernels compute (a * x + b * y) + t in the same order as transformPoint
+
+#if defined(SFML_TRANSFORM_SSE)
+
+    // Two vertices per iteration: (x0, y0, x1, y1)
+    const __m128 columnX = _mm_setr_ps(m[0], m[3], m[0], m[3]);
+    const __m128 columnY = _mm_setr_ps(m[1], m[4], m[1], m[4]);
+    const __m128 offset  = _mm_setr_ps(m[2], m[5], m[2], m[5]);
+
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128 positions = _mm_setzero_ps();
+        positions = _mm_loadl_pi(positions, reinterpret_cast<const __m64*>(&input[i].position));
+        positions = _mm_loadh_pi(positions, reinterpret_cast<const __m64*>(&input[i + 1].position));
+
+        const __m128 x = _mm_shuffle_ps(positions, positions, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 y = _mm_shuffle_ps(positions, positions, _MM_SHUFFLE(3, 3, 1, 1));
+        const __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, columnX), _mm_mul_ps(y, columnY)), offset);
+
+        output[i].color         = input[i].color;
+        output[i].texCoords     = input[i].texCoords;
+        output[i + 1].color     = input[i + 1].color;
+        output[i + 1].texCoords = input[i + 1].texCoords;
+        _mm_storel_pi(reinterpret_cast<__m64*>(&output[i].position), result);
+        _mm_storeh_pi(reinterpret_cast<__m64*>(&output[i + 1].position), result);
+    }
+
+#elif defined(SFML_TRANSFORM_NEON)
+
+    // One vertex per iteration: (x, y)
+    const float32x2_t columnX = {m[0], m[3]};
+    const float32x2_t columnY = {m[1], m[4]};
+    const float32x2_t offset  = {m[2], m[5]};
+
+    for (; i < count; ++i)
+    {
+        const float32x2_t position = vld1_f32(&input[i].position.x);
+        const float32x2_t result = vadd_f32(vadd_f32(vmul_lane_f32(columnX, position, 0),
+                                                     vmul_lane_f32(columnY, position, 1)), offset);
+
+        output[i].color     = input[i].color;
+        output[i].texCoords = input[i].texCoords;
+        vst1_f32(&output[i].position.x, result);
+    }
+
+#elif defined(SFML_TRANSFORM_WASM_SIMD)
+
+    // Two vertices per iteration: (x0, y0, x1, y1)
+    const v128_t columnX = wasm_f32x4_make(m[0], m[3], m[0], m[3]);
+    const v128_t columnY = wasm_f32x4_make(m[1], m[4], m[1], m[4]);
+    const v128_t offset  = wasm_f32x4_make(m[2], m[5], m[2], m[5]);
+
+    for (; i + 2 <= count; i += 2)
+    {
+        const v128_t positions = wasm_f32x4_make(input[i].position.x, input[i].position.y,
+                                                 input[i + 1].position.x, input[i + 1].position.y);
+
+        const v128_t x = wasm_i32x4_shuffle(positions, positions, 0, 0, 2, 2);
+        const v128_t y = wasm_i32x4_shuffle(positions, positions, 1, 1, 3, 3);
+        const v128_t result = wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_mul(x, columnX), wasm_f32x4_mul(y, columnY)), offset);
+
+        output[i].color         = input[i].color;
+        output[i].texCoords     = input[i].texCoords;
+        output[i + 1].color     = input[i + 1].color;
+        output[i + 1].texCoords = input[i + 1].texCoords;
+        output[i].position.x     = wasm_f32x4_extract_lane(result, 0);
+        output[i].position.y     = wasm_f32x4_extract_lane(result, 1);
+        output[i + 1].position.x = wasm_f32x4_extract_lane(result, 2);
+        output[i + 1].position.y = wasm_f32x4_extract_lane(result, 3);
+    }
+
+#endif
+
+    // Remaining vertices (or all of them without SIMD)
+    for (; i < count; ++i)
+    {
+        const Vector2f position = transformPoint(input[i].position);
+        output[i].color     = input[i].color;
+        output[i].texCoords = input[i].texCoords;
+        output[i].position  = position;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vector2f* input, Vector2f* output, std::size_t count) const
+{
+    const float* m = m_matrix;
+    std::size_t i = 0;
+
+#if defined(SFML_TRANSFORM_SSE)
+
+    // Two points per iteration: (x0, y0, x1, y1)
+    const __m128 columnX = _mm_setr_ps(m[0], m[3], m[0], m[3]);
+    const __m128 columnY = _mm_setr_ps(m[1], m[4], m[1], m[4]);
+    const __m128 offset  = _mm_setr_ps(m[2], m[5], m[2], m[5]);
+
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128 positions = _mm_loadu_ps(&input[i].x);
+
+        const __m128 x = _mm_shuffle_ps(positions, positions, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 y = _mm_shuffle_ps(positions, positions, _MM_SHUFFLE(3, 3, 1, 1));
+        _mm_storeu_ps(&output[i].x, _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, columnX), _mm_mul_ps(y, columnY)), offset));
+    }
+
+#elif defined(SFML_TRANSFORM_NEON)
+
+    // One point per iteration: (x, y)
+    const float32x2_t columnX = {m[0], m[3]};
+    const float32x2_t columnY = {m[1], m[4]};
+    const float32x2_t offset  = {m[2], m[5]};
+
+    for (; i < count; ++i)
+    {
+        const float32x2_t position = vld1_f32(&input[i].x);
+        vst1_f32(&output[i].x, vadd_f32(vadd_f32(vmul_lane_f32(columnX, position, 0),
+                                                 vmul_lane_f32(columnY, position, 1)), offset));
+    }
+
+#elif defined(SFML_TRANSFORM_WASM_SIMD)
+
+    // Two points per iteration: (x0, y0, x1, y1)
+    const v128_t columnX = wasm_f32x4_make(m[0], m[3], m[0], m[3]);
+    const v128_t columnY = wasm_f32x4_make(m[1], m[4], m[1], m[4]);
+    const v128_t offset  = wasm_f32x4_make(m[2], m[5], m[2], m[5]);
+
+    for (; i + 2 <= count; i += 2)
+    {
+        const v128_t positions = wasm_v128_load(&input[i].x);
+
+        const v128_t x = wasm_i32x4_shuffle(positions, positions, 0, 0, 2, 2);
+        const v128_t y = wasm_i32x4_shuffle(positions, positions, 1, 1, 3, 3);
+        wasm_v128_store(&output[i].x, wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_mul(x, columnX), wasm_f32x4_mul(y, columnY)), offset));
+    }
+
+#endif
+
+    // Remaining points (or all of them without SIMD)
+    for (; i < count; ++i)
+        output[i] = transformPoint(input[i]);
+}
+
+
 ////////////////////////////////////////////////////////////
 FloatRect Transform::transformRect(const FloatRect& rectangle) const
 {
@@ -144,15 +313,17 @@ Transform& Transform::combine(const Transform& transform)
     const float* a = m_matrix;
     const float* b = transform.m_matrix;
 
-    *this = Transform(a[0] * b[0]  + a[4] * b[1]  + a[12] * b[3],
-                      a[0] * b[4]  + a[4] * b[5]  + a[12] * b[7],
-                      a[0] * b[12] + a[4] * b[13] + a[12] * b[15],
-                      a[1] * b[0]  + a[5] * b[1]  + a[13] * b[3],
-                      a[1] * b[4]  + a[5] * b[5]  + a[13] * b[7],
-                      a[1] * b[12] + a[5] * b[13] + a[13] * b[15],
-                      a[3] * b[0]  + a[7] * b[1]  + a[15] * b[3],
-                      a[3] * b[4]  + a[7] * b[5]  + a[15] * b[7],
-                      a[3] * b[12] + a[7] * b[13] + a[15] * b[15]);
+    // The last rows are (0, 0, 1), only the 2x3 part needs to be computed
+    // (\a transform may be *this, so compute everything before storing)
+    const float r0 = a[0] * b[0] + a[1] * b[3];
+    const float r1 = a[0] * b[1] + a[1] * b[4];
+    const float r2 = a[0] * b[2] + a[1] * b[5] + a[2];
+    const float r3 = a[3] * b[0] + a[4] * b[3];
+    const float r4 = a[3] * b[1] + a[4] * b[4];
+    const float r5 = a[3] * b[2] + a[4] * b[5] + a[5];
+
+    m_matrix[0] = r0; m_matrix[1] = r1; m_matrix[2] = r2;
+    m_matrix[3] = r3; m_matrix[4] = r4; m_matrix[5] = r5;
 
     return *this;
 }
@@ -161,11 +332,11 @@ Transform& Transform::combine(const Transform& transform)
 ////////////////////////////////////////////////////////////
 Transform& Transform::translate(float x, float y)
 {
-    Transform translation(1, 0, x,
-                          0, 1, y,
-                          0, 0, 1);
+    // Same as combining with a translation matrix, without the useless products
+    m_matrix[2] += m_matrix[0] * x + m_matrix[1] * y;
+    m_matrix[5] += m_matrix[3] * x + m_matrix[4] * y;
 
-    return combine(translation);
+    return *this;
 }
 
 
@@ -216,11 +387,11 @@ Transform& Transform::rotate(float angle, const Vector2f& center)
 ////////////////////////////////////////////////////////////
 Transform& Transform::scale(float scaleX, float scaleY)
 {
-    Transform scaling(scaleX, 0,      0,
-                      0,      scaleY, 0,
-                      0,      0,      1);
+    // Same as combining with a scaling matrix, without the useless products
+    m_matrix[0] *= scaleX; m_matrix[1] *= scaleY;
+    m_matrix[3] *= scaleX; m_matrix[4] *= scaleY;
 
-    return combine(scaling);
+    return *this;
 }
 
 
@@ -273,12 +444,11 @@ Vector2f operator *(const Transform& left, const Vector2f& right)
 ////////////////////////////////////////////////////////////
 bool operator ==(const Transform& left, const Transform& right)
 {
-    const float* a = left.getMatrix();
-    const float* b = right.getMatrix();
+    const float* a = left.getAffineMatrix();
+    const float* b = right.getAffineMatrix();
 
-    return ((a[0]  == b[0])  && (a[1]  == b[1])  && (a[3]  == b[3]) &&
-            (a[4]  == b[4])  && (a[5]  == b[5])  && (a[7]  == b[7]) &&
-            (a[12] == b[12]) && (a[13] == b[13]) && (a[15] == b[15]));
+    return ((a[0] == b[0]) && (a[1] == b[1]) && (a[2] == b[2]) &&
+            (a[3] == b[3]) && (a[4] == b[4]) && (a[5] == b[5]));
 }
 
 
@@ -0,0 +1,305 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TransformBuffer.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TransformBuffer::TransformBuffer() :
+m_dirtyBegin(0),
+m_dirtyEnd  (0),
+m_version   (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TransformBuffer::add(const Vector2f& position, float rotation, const Vector2f& scale, const Vector2f& origin)
+{
+    std::size_t index = getSize();
+
+    m_components[PositionX].push_back(position.x);
+    m_components[PositionY].push_back(position.y);
+    m_components[Rotation].push_back(rotation);
+    m_components[ScaleX].push_back(scale.x);
+    m_components[ScaleY].push_back(scale.y);
+    m_components[OriginX].push_back(origin.x);
+    m_components[OriginY].push_back(origin.y);
+
+    invalidate(index, index + 1);
+
+    return index;
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformBuffer::resize(std::size_t count)
+{
+    std::size_t size = getSize();
+
+    m_components[PositionX].resize(count, 0.f);
+    m_components[PositionY].resize(count, 0.f);
+    m_components[Rotation].resize(count, 0.f);
+    m_components[ScaleX].resize(count, 1.f);
+    m_components[ScaleY].resize(count, 1.f);
+    m_components[OriginX].resize(count, 0.f);
+    m_components[OriginY].resize(count, 0.f);
+
+    if (count > size)
+        invalidate(size, count);
+    else
+        ++m_version;
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformBuffer::reserve(std::size_t count)
+{
+    for (std::size_t i = 0; i < ComponentCount; ++i)
+        m_components[i].reserve(count);
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformBuffer::clear()
+{
+    resize(0);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TransformBuffer::getSize() const
+{
+    return m_components[PositionX].size();
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformBuffer::setPosition(std::size_t index, const Vector2f& position)
+{
+    m_components[PositionX][index] = position.x;
+    m_components[PositionY][index] = position.y;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformBuffer::setRotation(std::size_t index, float angle)
+{
+    angle = static_cast<float>(std::fmod(angle, 360.f));
+    if (angle < 0)
+        angle += 360.f;
+
+    m_components[Rotation][index] = angle;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformBuffer::setScale(std::size_t index, const Vector2f& factors)
+{
+    m_components[ScaleX][index] = factors.x;
+    m_components[ScaleY][index] = factors.y;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformBuffer::setOrigin(std::size_t index, const Vector2f& origin)
+{
+    m_components[OriginX][index] = origin.x;
+    m_components[OriginY][index] = origin.y;
+    invalidate(index, index + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f TransformBuffer::getPosition(std::size_t index) const
+{
+    return Vector2f(m_components[PositionX][index], m_components[PositionY][index]);
+}
+
+
+////////////////////////////////////////////////////////////
+float TransformBuffer::getRotation(std::size_t index) const
+{
+    return m_components[Rotation][index];
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f TransformBuffer::getScale(std::size_t index) const
+{
+    return Vector2f(m_components[ScaleX][index], m_components[ScaleY][index]);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f TransformBuffer::getOrigin(std::size_t index) const
+{
+    return Vector2f(m_components[OriginX][index], m_components[OriginY][index]);
+}
+
+
+////////////////////////////////////////////////////////////
+float* TransformBuffer::getData(Component component)
+{
+    invalidate(0, getSize());
+    return m_components[component].data();
+}
+
+
+////////////////////////////////////////////////////////////
+const float* TransformBuffer::getData(Component component) const
+{
+    return m_components[component].data();
+}
+
+
+////////////////////////////////////////////////////////////
+Transform TransformBuffer::getTransform(std::size_t index) const
+{
+    update();
+
+    return Transform(m_matrices[0][index], m_matrices[1][index], m_matrices[2][index],
+                     m_matrices[3][index], m_matrices[4][index], m_matrices[5][index],
+                     0.f,                  0.f,                  1.f);
+}
+
+
+////////////////////////////////////////////////////////////
+const float* TransformBuffer::getMatrixData(std::size_t element) const
+{
+    update();
+    return m_matrices[element].data();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 TransformBuffer::getVersion() const
+{
+    return m_version;
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformBuffer::invalidate(std::size_t begin, std::size_t end)
+{
+    if (m_dirtyBegin >= m_dirtyEnd)
+    {
+        m_dirtyBegin = begin;
+        m_dirtyEnd   = end;
+    }
+    else
+    {
+        m_dirtyBegin = std::min(m_dirtyBegin, begin);
+        m_dirtyEnd   = std::max(m_dirtyEnd, end);
+    }
+
+    ++m_version;
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformBuffer::update() const
+{
+    std::size_t size = getSize();
+
+    if (m_matrices[0].size() != size)
+    {
+        for (std::size_t i = 0; i < 6; ++i)
+            m_matrices[i].resize(size);
+        m_cosines.resize(size);
+        m_sines.resize(size);
+    }
+
+    std::size_t begin = m_dirtyBegin;
+    std::size_t end   = std::min(m_dirtyEnd, size);
+    m_dirtyBegin = 0;
+    m_dirtyEnd   = 0;
+
+    if (begin >= end)
+        return;
+
+    const float* rotation = &m_components[Rotation][0];
+    float*       cosine   = &m_cosines[0];
+    float*       sine     = &m_sines[0];
+
+    // First pass: the trigonometry, which is not vectorizable,
+    // skipped for unrotated objects like Transformable does
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        if (rotation[i] != 0.f)
+        {
+            float angle = -rotation[i] * 3.141592654f / 180.f;
+            cosine[i] = static_cast<float>(std::cos(angle));
+            sine[i]   = static_cast<float>(std::sin(angle));
+        }
+        else
+        {
+            cosine[i] = 1.f;
+            sine[i]   = 0.f;
+        }
+    }
+
+    // Second pass: branch-free arithmetic on contiguous arrays, which
+    // the compiler turns into SIMD code
+    const float* positionX = &m_components[PositionX][0];
+    const float* positionY = &m_components[PositionY][0];
+    const float* scaleX    = &m_components[ScaleX][0];
+    const float* scaleY    = &m_components[ScaleY][0];
+    const float* originX   = &m_components[OriginX][0];
+    const float* originY   = &m_components[OriginY][0];
+    float*       a00       = &m_matrices[0][0];
+    float*       a01       = &m_matrices[1][0];
+    float*       a02       = &m_matrices[2][0];
+    float*       a10       = &m_matrices[3][0];
+    float*       a11       = &m_matrices[4][0];
+    float*       a12       = &m_matrices[5][0];
+
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        float sxc = scaleX[i] * cosine[i];
+        float syc = scaleY[i] * cosine[i];
+        float sxs = scaleX[i] * sine[i];
+        float sys = scaleY[i] * sine[i];
+
+        a00[i] =  sxc;
+        a01[i] =  sys;
+        a02[i] = -originX[i] * sxc - originY[i] * sys + positionX[i];
+        a10[i] = -sxs;
+        a11[i] =  syc;
+        a12[i] =  originX[i] * sxs - originY[i] * syc + positionY[i];
+    }
+}
+
+} // namespace sf
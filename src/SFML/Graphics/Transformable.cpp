@@ -40,7 +40,12 @@ m_scale                     (1, 1),
 m_transform                 (),
 m_transformNeedUpdate       (true),
 m_inverseTransform          (),
-m_inverseTransformNeedUpdate(true)
+m_inverseTransformNeedUpdate(true),
+m_transformVersion          (0),
+m_localBounds               (),
+m_globalBounds              (),
+m_boundsVersion             (0),
+m_boundsValid               (false)
 {
 }
 
@@ -56,8 +61,7 @@ void Transformable::setPosition(float x, float y)
 {
     m_position.x = x;
     m_position.y = y;
-    m_transformNeedUpdate = true;
-    m_inverseTransformNeedUpdate = true;
+    invalidateTransform();
 }
 
 
@@ -75,8 +79,7 @@ void Transformable::setRotation(float angle)
     if (m_rotation < 0)
         m_rotation += 360.f;
 
-    m_transformNeedUpdate = true;
-    m_inverseTransformNeedUpdate = true;
+    invalidateTransform();
 }
 
 
@@ -85,8 +88,7 @@ void Transformable::setScale(float factorX, float factorY)
 {
     m_scale.x = factorX;
     m_scale.y = factorY;
-    m_transformNeedUpdate = true;
-    m_inverseTransformNeedUpdate = true;
+    invalidateTransform();
 }
 
 
@@ -102,8 +104,7 @@ void Transformable::setOrigin(float x, float y)
 {
     m_origin.x = x;
     m_origin.y = y;
-    m_transformNeedUpdate = true;
-    m_inverseTransformNeedUpdate = true;
+    invalidateTransform();
 }
 
 
@@ -183,9 +184,15 @@ const Transform& Transformable::getTransform() const
     // Recompute the combined transform if needed
     if (m_transformNeedUpdate)
     {
-        float angle  = -m_rotation * 3.141592654f / 180.f;
-        float cosine = static_cast<float>(std::cos(angle));
-        float sine   = static_cast<float>(std::sin(angle));
+        // Most objects are not rotated, skip the trigonometry for them
+        float cosine = 1.f;
+        float sine   = 0.f;
+        if (m_rotation != 0.f)
+        {
+            float angle = -m_rotation * 3.141592654f / 180.f;
+            cosine = static_cast<float>(std::cos(angle));
+            sine   = static_cast<float>(std::sin(angle));
+        }
         float sxc    = m_scale.x * cosine;
         float syc    = m_scale.y * cosine;
         float sxs    = m_scale.x * sine;
@@ -216,4 +223,35 @@ const Transform& Transformable::getInverseTransform() const
     return m_inverseTransform;
 }
 
+
+////////////////////////////////////////////////////////////
+Uint32 Transformable::getTransformVersion() const
+{
+    return m_transformVersion;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect Transformable::getTransformedBounds(const FloatRect& localBounds) const
+{
+    if (!m_boundsValid || (m_boundsVersion != m_transformVersion) || (m_localBounds != localBounds))
+    {
+        m_localBounds = localBounds;
+        m_globalBounds = getTransform().transformRect(localBounds);
+        m_boundsVersion = m_transformVersion;
+        m_boundsValid = true;
+    }
+
+    return m_globalBounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void Transformable::invalidateTransform()
+{
+    m_transformNeedUpdate = true;
+    m_inverseTransformNeedUpdate = true;
+    ++m_transformVersion;
+}
+
 } // namespace sf
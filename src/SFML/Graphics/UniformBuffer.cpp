@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/UniformBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+UniformBuffer::UniformBuffer() :
+m_buffer(0),
+m_size  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+UniformBuffer::~UniformBuffer()
+{
+    if (m_buffer)
+        priv::getGLStateCache().deleteBuffer(m_buffer);
+
+    priv::trackGpuMemory(GpuMemory::UniformBuffers, m_size, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::create(std::size_t size)
+{
+    if (!isAvailable())
+    {
+        err() << "Failed to create uniform buffer, uniform buffers are not supported by the driver" << std::endl;
+        return false;
+    }
+
+    if (size == 0)
+    {
+        err() << "Failed to create uniform buffer, invalid size (0)" << std::endl;
+        return false;
+    }
+
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
+    if (!m_buffer)
+        glCheck(glGenBuffers(1, &m_buffer));
+
+    if (!m_buffer)
+    {
+        err() << "Could not create uniform buffer, generation failed" << std::endl;
+        return false;
+    }
+
+    cache.bindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+    glCheck(glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), NULL, GL_DYNAMIC_DRAW));
+
+    priv::trackGpuMemory(GpuMemory::UniformBuffers, m_size, size);
+    m_size = size;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(const void* data, std::size_t size, std::size_t offset)
+{
+    if (!m_buffer || !data)
+        return false;
+
+    if ((offset > m_size) || (size > m_size - offset))
+    {
+        err() << "Failed to update uniform buffer, " << size << " bytes at offset " << offset
+              << " don't fit in " << m_size << " bytes" << std::endl;
+        return false;
+    }
+
+    priv::getGLStateCache().bindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+
+    // Replacing the whole contents lets the driver rename the storage instead of waiting
+    if ((offset == 0) && (size == m_size))
+        glCheck(glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), data, GL_DYNAMIC_DRAW));
+    else
+        glCheck(glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t UniformBuffer::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int UniformBuffer::getNativeHandle() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::bind(unsigned int bindingPoint) const
+{
+    if (m_buffer)
+        priv::getGLStateCache().bindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, m_buffer);
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::isAvailable()
+{
+    return priv::getGraphicsCaps().uniformBuffers;
+}
+
+} // namespace sf
@@ -26,6 +26,18 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Vertex.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Round to the nearest integer in [low, high]
+    float clampRound(float value, float low, float high)
+    {
+        return std::floor(std::min(std::max(value, low), high) + 0.5f);
+    }
+}
 
 
 namespace sf
@@ -74,4 +86,37 @@ texCoords(theTexCoords)
 {
 }
 
+
+////////////////////////////////////////////////////////////
+VertexPacked::VertexPacked() :
+position (0, 0),
+color    (255, 255, 255),
+texCoords(0, 0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+VertexPacked::VertexPacked(const Vector2<Int16>& thePosition, const Color& theColor, const Vector2<Uint16>& theTexCoords) :
+position (thePosition),
+color    (theColor),
+texCoords(theTexCoords)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+VertexPacked::VertexPacked(const Vertex& vertex, const Vector2u& textureSize) :
+position (static_cast<Int16>(clampRound(vertex.position.x, -32768.f, 32767.f)),
+          static_cast<Int16>(clampRound(vertex.position.y, -32768.f, 32767.f))),
+color    (vertex.color),
+texCoords(0, 0)
+{
+    if ((textureSize.x > 0) && (textureSize.y > 0))
+    {
+        texCoords.x = static_cast<Uint16>(clampRound(vertex.texCoords.x / textureSize.x * 65535.f, 0.f, 65535.f));
+        texCoords.y = static_cast<Uint16>(clampRound(vertex.texCoords.y / textureSize.y * 65535.f, 0.f, 65535.f));
+    }
+}
+
 } // namespace sf
@@ -27,6 +27,100 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+    #include <xmmintrin.h>
+    #define SFML_VERTEXARRAY_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_VERTEXARRAY_NEON
+#elif defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define SFML_VERTEXARRAY_WASM_SIMD
+#endif
+
+
+namespace
+{
+    // Min/max reduction of the positions of a non-empty range of vertices
+    void computeBounds(const sf::Vertex* vertices, std::size_t count, sf::Vector2f& min, sf::Vector2f& max)
+    {
+        std::size_t i = 1;
+        min = vertices[0].position;
+        max = vertices[0].position;
+
+#if defined(SFML_VERTEXARRAY_SSE)
+
+        // Two positions per iteration: (x0, y0, x1, y1)
+        __m128 low = _mm_setr_ps(min.x, min.y, min.x, min.y);
+        __m128 high = low;
+
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128 positions = _mm_setzero_ps();
+            positions = _mm_loadl_pi(positions, reinterpret_cast<const __m64*>(&vertices[i].position));
+            positions = _mm_loadh_pi(positions, reinterpret_cast<const __m64*>(&vertices[i + 1].position));
+
+            low  = _mm_min_ps(low, positions);
+            high = _mm_max_ps(high, positions);
+        }
+
+        low  = _mm_min_ps(low, _mm_movehl_ps(low, low));
+        high = _mm_max_ps(high, _mm_movehl_ps(high, high));
+        _mm_storel_pi(reinterpret_cast<__m64*>(&min), low);
+        _mm_storel_pi(reinterpret_cast<__m64*>(&max), high);
+
+#elif defined(SFML_VERTEXARRAY_NEON)
+
+        // One position per iteration: (x, y)
+        float32x2_t low = vld1_f32(&min.x);
+        float32x2_t high = low;
+
+        for (; i < count; ++i)
+        {
+            const float32x2_t position = vld1_f32(&vertices[i].position.x);
+            low  = vmin_f32(low, position);
+            high = vmax_f32(high, position);
+        }
+
+        vst1_f32(&min.x, low);
+        vst1_f32(&max.x, high);
+
+#elif defined(SFML_VERTEXARRAY_WASM_SIMD)
+
+        // Two positions per iteration: (x0, y0, x1, y1)
+        v128_t low = wasm_f32x4_make(min.x, min.y, min.x, min.y);
+        v128_t high = low;
+
+        for (; i + 2 <= count; i += 2)
+        {
+            const v128_t positions = wasm_f32x4_make(vertices[i].position.x, vertices[i].position.y,
+                                                     vertices[i + 1].position.x, vertices[i + 1].position.y);
+            low  = wasm_f32x4_pmin(low, positions);
+            high = wasm_f32x4_pmax(high, positions);
+        }
+
+        low  = wasm_f32x4_pmin(low, wasm_i32x4_shuffle(low, low, 2, 3, 0, 1));
+        high = wasm_f32x4_pmax(high, wasm_i32x4_shuffle(high, high, 2, 3, 0, 1));
+        min.x = wasm_f32x4_extract_lane(low, 0);
+        min.y = wasm_f32x4_extract_lane(low, 1);
+        max.x = wasm_f32x4_extract_lane(high, 0);
+        max.y = wasm_f32x4_extract_lane(high, 1);
+
+#endif
+
+        // Remaining positions (or all of them without SIMD)
+        for (; i < count; ++i)
+        {
+            const sf::Vector2f& position = vertices[i].position;
+            min.x = std::min(min.x, position.x);
+            min.y = std::min(min.y, position.y);
+            max.x = std::max(max.x, position.x);
+            max.y = std::max(max.y, position.y);
+        }
+    }
+}
 
 
 namespace sf
@@ -34,7 +128,11 @@ namespace sf
 ////////////////////////////////////////////////////////////
 VertexArray::VertexArray() :
 m_vertices     (),
-m_primitiveType(Points)
+m_primitiveType(Points),
+m_trackBounds  (false),
+m_boundsValid  (false),
+m_boundsMin    (),
+m_boundsMax    ()
 {
 }
 
@@ -42,7 +140,11 @@ m_primitiveType(Points)
 ////////////////////////////////////////////////////////////
 VertexArray::VertexArray(PrimitiveType type, std::size_t vertexCount) :
 m_vertices     (vertexCount),
-m_primitiveType(type)
+m_primitiveType(type),
+m_trackBounds  (false),
+m_boundsValid  (false),
+m_boundsMin    (),
+m_boundsMax    ()
 {
 }
 
@@ -57,6 +159,9 @@ std::size_t VertexArray::getVertexCount() const
 ////////////////////////////////////////////////////////////
 Vertex& VertexArray::operator [](std::size_t index)
 {
+    // The vertex may be moved, we can't know where
+    m_boundsValid = false;
+
     return m_vertices[index];
 }
 
@@ -72,13 +177,29 @@ const Vertex& VertexArray::operator [](std::size_t index) const
 void VertexArray::clear()
 {
     m_vertices.clear();
+    m_boundsValid = false;
 }
 
 
 ////////////////////////////////////////////////////////////
 void VertexArray::resize(std::size_t vertexCount)
 {
+    std::size_t previousCount = m_vertices.size();
     m_vertices.resize(vertexCount);
+
+    if (vertexCount < previousCount)
+    {
+        // Removed vertices may have defined the bounds
+        m_boundsValid = false;
+    }
+    else if ((vertexCount > previousCount) && m_boundsValid)
+    {
+        // New vertices are default-constructed at (0, 0)
+        m_boundsMin.x = std::min(m_boundsMin.x, 0.f);
+        m_boundsMin.y = std::min(m_boundsMin.y, 0.f);
+        m_boundsMax.x = std::max(m_boundsMax.x, 0.f);
+        m_boundsMax.y = std::max(m_boundsMax.y, 0.f);
+    }
 }
 
 
@@ -86,6 +207,95 @@ void VertexArray::resize(std::size_t vertexCount)
 void VertexArray::append(const Vertex& vertex)
 {
     m_vertices.push_back(vertex);
+
+    if (m_trackBounds)
+    {
+        const Vector2f& position = vertex.position;
+
+        if (m_vertices.size() == 1)
+        {
+            m_boundsMin = position;
+            m_boundsMax = position;
+            m_boundsValid = true;
+        }
+        else if (m_boundsValid)
+        {
+            m_boundsMin.x = std::min(m_boundsMin.x, position.x);
+            m_boundsMin.y = std::min(m_boundsMin.y, position.y);
+            m_boundsMax.x = std::max(m_boundsMax.x, position.x);
+            m_boundsMax.y = std::max(m_boundsMax.y, position.y);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::append(const Vertex* vertices, std::size_t vertexCount)
+{
+    if (vertexCount == 0)
+        return;
+
+    bool wasEmpty = m_vertices.empty();
+
+    // Vertex is trivially copyable: the insertion is a plain memory copy
+    m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+
+    if (m_trackBounds && (wasEmpty || m_boundsValid))
+    {
+        Vector2f min;
+        Vector2f max;
+        computeBounds(vertices, vertexCount, min, max);
+
+        if (wasEmpty)
+        {
+            m_boundsMin = min;
+            m_boundsMax = max;
+            m_boundsValid = true;
+        }
+        else
+        {
+            m_boundsMin.x = std::min(m_boundsMin.x, min.x);
+            m_boundsMin.y = std::min(m_boundsMin.y, min.y);
+            m_boundsMax.x = std::max(m_boundsMax.x, max.x);
+            m_boundsMax.y = std::max(m_boundsMax.y, max.y);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::reserve(std::size_t vertexCount)
+{
+    m_vertices.reserve(vertexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexArray::getCapacity() const
+{
+    return m_vertices.capacity();
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::shrinkToFit()
+{
+    m_vertices.shrink_to_fit();
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::setColor(const Color& color, std::size_t first, std::size_t count)
+{
+    if (first >= m_vertices.size())
+        return;
+
+    count = std::min(count, m_vertices.size() - first);
+
+    // Only the color is written, with a fixed stride: no need to go through operator[]
+    Vertex* vertex = &m_vertices[first];
+    for (Vertex* end = vertex + count; vertex != end; ++vertex)
+        vertex->color = color;
 }
 
 
@@ -106,37 +316,40 @@ PrimitiveType VertexArray::getPrimitiveType() const
 ////////////////////////////////////////////////////////////
 FloatRect VertexArray::getBounds() const
 {
-    if (!m_vertices.empty())
-    {
-        float left   = m_vertices[0].position.x;
-        float top    = m_vertices[0].position.y;
-        float right  = m_vertices[0].position.x;
-        float bottom = m_vertices[0].position.y;
+    // Array is empty
+    if (m_vertices.empty())
+        return FloatRect();
 
-        for (std::size_t i = 1; i < m_vertices.size(); ++i)
-        {
-            Vector2f position = m_vertices[i].position;
-
-            // Update left and right
-            if (position.x < left)
-                left = position.x;
-            else if (position.x > right)
-                right = position.x;
-
-            // Update top and bottom
-            if (position.y < top)
-                top = position.y;
-            else if (position.y > bottom)
-                bottom = position.y;
-        }
+    if (m_trackBounds && m_boundsValid)
+        return FloatRect(m_boundsMin, m_boundsMax - m_boundsMin);
 
-        return FloatRect(left, top, right - left, bottom - top);
-    }
-    else
+    Vector2f min;
+    Vector2f max;
+    computeBounds(&m_vertices[0], m_vertices.size(), min, max);
+
+    if (m_trackBounds)
     {
-        // Array is empty
-        return FloatRect();
+        m_boundsMin = min;
+        m_boundsMax = max;
+        m_boundsValid = true;
     }
+
+    return FloatRect(min, max - min);
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::setBoundsTracking(bool enabled)
+{
+    m_trackBounds = enabled;
+    m_boundsValid = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexArray::isBoundsTracking() const
+{
+    return m_trackBounds;
 }
 
 
@@ -147,4 +360,12 @@ void VertexArray::draw(RenderTarget& target, RenderStates states) const
         target.draw(&m_vertices[0], m_vertices.size(), m_primitiveType, states);
 }
 
+
+////////////////////////////////////////////////////////////
+bool VertexArray::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getBounds();
+    return true;
+}
+
 } // namespace sf
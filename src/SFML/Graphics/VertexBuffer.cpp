@@ -26,18 +26,31 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/VertexBufferArena.hpp>
+#include <SFML/Graphics/ContextRestore.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/GraphicsCaps.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
 
 namespace
 {
     sf::Mutex isAvailableMutex;
 
+    // Dirty ranges closer than this (in vertices) are uploaded as one:
+    // a few redundant bytes are cheaper than another call
+    const std::size_t dirtyMergeGap = 64;
+
     GLenum usageToGlEnum(sf::VertexBuffer::Usage usage)
     {
         switch (usage)
@@ -58,8 +71,16 @@ m_vao          (0),
 m_vbo          (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (Stream)
+m_usage        (Stream),
+m_format       (Standard),
+m_shadowed     (false),
+m_shadow       (),
+m_dirtyRanges  (),
+m_reallocate   (false),
+m_arena        (NULL),
+m_first        (0)
 {
+    priv::registerRestorable(priv::RestorableVertexBuffer, this);
 }
 
 
@@ -69,8 +90,16 @@ m_vao          (0),
 m_vbo          (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (Stream)
+m_usage        (Stream),
+m_format       (Standard),
+m_shadowed     (false),
+m_shadow       (),
+m_dirtyRanges  (),
+m_reallocate   (false),
+m_arena        (NULL),
+m_first        (0)
 {
+    priv::registerRestorable(priv::RestorableVertexBuffer, this);
 }
 
 
@@ -80,8 +109,16 @@ m_vao          (0),
 m_vbo          (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (usage)
+m_usage        (usage),
+m_format       (Standard),
+m_shadowed     (false),
+m_shadow       (),
+m_dirtyRanges  (),
+m_reallocate   (false),
+m_arena        (NULL),
+m_first        (0)
 {
+    priv::registerRestorable(priv::RestorableVertexBuffer, this);
 }
 
 
@@ -91,8 +128,16 @@ m_vao          (0),
 m_vbo          (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (usage)
+m_usage        (usage),
+m_format       (Standard),
+m_shadowed     (false),
+m_shadow       (),
+m_dirtyRanges  (),
+m_reallocate   (false),
+m_arena        (NULL),
+m_first        (0)
 {
+    priv::registerRestorable(priv::RestorableVertexBuffer, this);
 }
 
 
@@ -102,11 +147,22 @@ m_vao          (0),
 m_vbo          (0),
 m_size         (0),
 m_primitiveType(copy.m_primitiveType),
-m_usage        (copy.m_usage)
+m_usage        (copy.m_usage),
+m_format       (copy.m_format),
+m_shadowed     (false),
+m_shadow       (),
+m_dirtyRanges  (),
+m_reallocate   (false),
+m_arena        (NULL),
+m_first        (0)
 {
+    priv::registerRestorable(priv::RestorableVertexBuffer, this);
+
     if (copy.m_vbo && copy.m_size)
     {
-        if (!create(copy.m_size))
+        m_shadowed = copy.m_shadowed;
+
+        if (copy.m_arena ? !create(copy.m_size, *copy.m_arena) : !create(copy.m_size))
         {
             err() << "Could not create vertex buffer for copying" << std::endl;
             return;
@@ -118,19 +174,29 @@ m_usage        (copy.m_usage)
 }
 
 
+////////////////////////////////////////////////////////////
+VertexBuffer::VertexBuffer(VertexBuffer&& right) noexcept :
+VertexBuffer()
+{
+    swap(right);
+}
+
+
 ////////////////////////////////////////////////////////////
 VertexBuffer::~VertexBuffer()
 {
-    if (m_vbo)
-    {
-        glCheck(glDeleteBuffers(1, &m_vbo));
-    }
+    priv::unregisterRestorable(priv::RestorableVertexBuffer, this);
+
+    releaseStorage();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool VertexBuffer::create(std::size_t vertexCount)
 {
+    if (m_arena)
+        return create(vertexCount, *m_arena);
+
     if (!m_vao)
         glCheck(SFML_GL_EXT_glGenVertexArrays(1, &m_vao));
 
@@ -149,29 +215,91 @@ bool VertexBuffer::create(std::size_t vertexCount)
         return false;
     }
 
-    glCheck(SFML_GL_EXT_glBindVertexArray(m_vao));
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
+    cache.bindVertexArray(m_vao);
+
+    cache.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glCheck(glBufferData(GL_ARRAY_BUFFER, getStride() * vertexCount, 0, usageToGlEnum(m_usage)));
+    setupAttributes(m_format);
+
+    cache.bindVertexArray(0);
+
+    priv::trackGpuMemory(GpuMemory::VertexBuffers, getStride() * m_size, getStride() * vertexCount);
+    m_size = vertexCount;
+
+    if (m_shadowed)
+        m_shadow.assign(getStride() * vertexCount, 0);
+    m_dirtyRanges.clear();
+    m_reallocate = false;
 
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
-    glCheck(glBufferData(GL_ARRAY_BUFFER, sizeof(sf::Vertex) * vertexCount, 0, usageToGlEnum(m_usage)));
+    return true;
+}
 
-    glCheck(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(sf::Vertex), (void*)0));
-    glCheck(glEnableVertexAttribArray(0));
 
-    glCheck(glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(sf::Vertex), (void*)sizeof(sf::Vertex::position)));
-    glCheck(glEnableVertexAttribArray(1));
+////////////////////////////////////////////////////////////
+bool VertexBuffer::create(std::size_t vertexCount, VertexBufferArena& arena)
+{
+    releaseStorage();
 
-    glCheck(glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(sf::Vertex), (void*)(sizeof(sf::Vertex::position) + sizeof(sf::Vertex::color))));
-    glCheck(glEnableVertexAttribArray(2));
+    m_arena  = &arena;
+    m_format = arena.getFormat();
 
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
-    glCheck(SFML_GL_EXT_glBindVertexArray(0));
+    if (vertexCount && !arena.allocate(vertexCount, m_vao, m_vbo, m_first))
+    {
+        err() << "Could not create vertex buffer, the arena allocation failed" << std::endl;
+        return false;
+    }
 
     m_size = vertexCount;
 
+    if (m_shadowed)
+        m_shadow.assign(getStride() * vertexCount, 0);
+    m_dirtyRanges.clear();
+    m_reallocate = false;
+
     return true;
 }
 
 
+////////////////////////////////////////////////////////////
+VertexBufferArena* VertexBuffer::getArena() const
+{
+    return m_arena;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::setupAttributes(Format format)
+{
+    if (format == Packed)
+    {
+        // Integer positions are converted to float, texture coordinates are normalized
+        GLsizei stride = sizeof(VertexPacked);
+
+        glCheck(glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, stride, (void*)offsetof(VertexPacked, position)));
+        glCheck(glEnableVertexAttribArray(0));
+
+        glCheck(glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(VertexPacked, color)));
+        glCheck(glEnableVertexAttribArray(1));
+
+        glCheck(glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)offsetof(VertexPacked, texCoords)));
+        glCheck(glEnableVertexAttribArray(2));
+    }
+    else
+    {
+        glCheck(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(sf::Vertex), (void*)0));
+        glCheck(glEnableVertexAttribArray(0));
+
+        glCheck(glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(sf::Vertex), (void*)sizeof(sf::Vertex::position)));
+        glCheck(glEnableVertexAttribArray(1));
+
+        glCheck(glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(sf::Vertex), (void*)(sizeof(sf::Vertex::position) + sizeof(sf::Vertex::color))));
+        glCheck(glEnableVertexAttribArray(2));
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 std::size_t VertexBuffer::getVertexCount() const
 {
@@ -189,33 +317,13 @@ bool VertexBuffer::update(const Vertex* vertices)
 ////////////////////////////////////////////////////////////
 bool VertexBuffer::update(const Vertex* vertices, std::size_t vertexCount, unsigned int offset)
 {
-    // Sanity checks
-    if (!m_vbo)
-        return false;
-
-    if (!vertices)
-        return false;
-
-    if (offset && (offset + vertexCount > m_size))
-        return false;
-
-	glCheck(SFML_GL_EXT_glBindVertexArray(m_vao));
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
-
-    // Check if we need to resize or orphan the buffer
-    if (vertexCount >= m_size)
+    if (m_format != Standard)
     {
-        glCheck(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertexCount, 0, usageToGlEnum(m_usage)));
-
-        m_size = vertexCount;
+        err() << "Cannot update a packed vertex buffer with sf::Vertex" << std::endl;
+        return false;
     }
 
-    glCheck(glBufferSubData(GL_ARRAY_BUFFER, sizeof(Vertex) * offset, sizeof(Vertex) * vertexCount, vertices));
-
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
-	glCheck(SFML_GL_EXT_glBindVertexArray(0));
-
-    return true;
+    return upload(vertices, vertexCount, offset);
 }
 
 
@@ -228,48 +336,74 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
 
 #else
 
-    if (!m_vbo || !vertexBuffer.m_vbo)
+    if (!m_vbo || !vertexBuffer.m_vbo || (m_format != vertexBuffer.m_format))
         return false;
 
+    // A range of an arena can't grow in place, it would overwrite its neighbours
+    if (m_arena && (vertexBuffer.m_size > m_size) && !m_shadowed)
+    {
+        err() << "Cannot copy a vertex buffer to a smaller vertex buffer of an arena" << std::endl;
+        return false;
+    }
+
+    // A shadow can only be filled from another shadow, graphics memory can't be read back
+    if (m_shadowed)
+    {
+        if (!vertexBuffer.m_shadowed)
+        {
+            err() << "Cannot copy a vertex buffer without shadow to a shadowed one" << std::endl;
+            return false;
+        }
+
+        return upload(vertexBuffer.m_shadow.data(), vertexBuffer.m_size, 0);
+    }
+
+    vertexBuffer.flush();
+
     // Make sure that extensions are initialized
     sf::priv::ensureExtensionsInit();
 
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
     if (GLAD_GL_ARB_copy_buffer)
     {
-        glCheck(glBindBuffer(GL_COPY_READ_BUFFER, vertexBuffer.m_vbo));
-        glCheck(glBindBuffer(GL_COPY_WRITE_BUFFER, m_vbo));
+        cache.bindBuffer(GL_COPY_READ_BUFFER, vertexBuffer.m_vbo);
+        cache.bindBuffer(GL_COPY_WRITE_BUFFER, m_vbo);
 
-        glCheck(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, sizeof(Vertex) * vertexBuffer.m_size));
-
-        glCheck(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
-        glCheck(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+        glCheck(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, getStride() * vertexBuffer.m_first, getStride() * m_first,
+                                    getStride() * vertexBuffer.m_size));
 
         return true;
     }
 
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
-    glCheck(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertexBuffer.m_size, 0, usageToGlEnum(m_usage)));
+    // Whole buffers are mapped below, which doesn't work with ranges of arenas
+    if (m_arena || vertexBuffer.m_arena)
+    {
+        err() << "Cannot copy vertex buffers of an arena without ARB_copy_buffer" << std::endl;
+        return false;
+    }
+
+    cache.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glCheck(glBufferData(GL_ARRAY_BUFFER, getStride() * vertexBuffer.m_size, 0, usageToGlEnum(m_usage)));
 
     void* destination = 0;
     glCheck(destination = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY));
 
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer.m_vbo));
+    cache.bindBuffer(GL_ARRAY_BUFFER, vertexBuffer.m_vbo);
 
     void* source = 0;
     glCheck(source = glMapBuffer(GL_ARRAY_BUFFER, GL_READ_ONLY));
 
-    std::memcpy(destination, source, sizeof(Vertex) * vertexBuffer.m_size);
+    std::memcpy(destination, source, getStride() * vertexBuffer.m_size);
 
     GLboolean sourceResult = GL_FALSE;
     glCheck(sourceResult = glUnmapBuffer(GL_ARRAY_BUFFER));
 
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
+    cache.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
 
     GLboolean destinationResult = GL_FALSE;
     glCheck(destinationResult = glUnmapBuffer(GL_ARRAY_BUFFER));
 
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
-
     if ((sourceResult == GL_FALSE) || (destinationResult == GL_FALSE))
         return false;
 
@@ -279,6 +413,26 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
 }
 
 
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const VertexPacked* vertices)
+{
+    return update(vertices, m_size, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const VertexPacked* vertices, std::size_t vertexCount, unsigned int offset)
+{
+    if (m_format != Packed)
+    {
+        err() << "Cannot update a standard vertex buffer with sf::VertexPacked" << std::endl;
+        return false;
+    }
+
+    return upload(vertices, vertexCount, offset);
+}
+
+
 ////////////////////////////////////////////////////////////
 VertexBuffer& VertexBuffer::operator =(const VertexBuffer& right)
 {
@@ -290,6 +444,15 @@ VertexBuffer& VertexBuffer::operator =(const VertexBuffer& right)
 }
 
 
+////////////////////////////////////////////////////////////
+VertexBuffer& VertexBuffer::operator =(VertexBuffer&& right) noexcept
+{
+    swap(right);
+
+    return *this;
+}
+
+
 ////////////////////////////////////////////////////////////
 void VertexBuffer::swap(VertexBuffer& right)
 {
@@ -298,6 +461,13 @@ void VertexBuffer::swap(VertexBuffer& right)
     std::swap(m_vbo,           right.m_vbo);
     std::swap(m_primitiveType, right.m_primitiveType);
     std::swap(m_usage,         right.m_usage);
+    std::swap(m_format,        right.m_format);
+    std::swap(m_shadowed,      right.m_shadowed);
+    std::swap(m_shadow,        right.m_shadow);
+    std::swap(m_dirtyRanges,   right.m_dirtyRanges);
+    std::swap(m_reallocate,    right.m_reallocate);
+    std::swap(m_arena,         right.m_arena);
+    std::swap(m_first,         right.m_first);
 }
 
 
@@ -315,10 +485,20 @@ unsigned int VertexBuffer::getNativeHandleBuffer() const
 }
 
 
+////////////////////////////////////////////////////////////
+std::size_t VertexBuffer::getNativeOffset() const
+{
+    return m_first;
+}
+
+
 ////////////////////////////////////////////////////////////
 void VertexBuffer::bind(const VertexBuffer* vertexBuffer)
 {
-    glCheck(SFML_GL_EXT_glBindVertexArray(vertexBuffer ? vertexBuffer->m_vao : 0));
+    if (vertexBuffer)
+        vertexBuffer->flush();
+
+    priv::getGLStateCache().bindVertexArray(vertexBuffer ? vertexBuffer->m_vao : 0);
 }
 
 
@@ -350,6 +530,156 @@ VertexBuffer::Usage VertexBuffer::getUsage() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool VertexBuffer::setFormat(VertexBuffer::Format format)
+{
+    if (format == m_format)
+        return true;
+
+    if (m_arena)
+    {
+        err() << "Cannot change the format of a vertex buffer of an arena" << std::endl;
+        return false;
+    }
+
+    if (!m_vbo)
+    {
+        m_format = format;
+        return true;
+    }
+
+    // The attribute layout and the allocation depend on the format,
+    // give the previous allocation back before changing the stride
+    std::size_t size = m_size;
+    priv::trackGpuMemory(GpuMemory::VertexBuffers, getStride() * m_size, 0);
+    m_size = 0;
+
+    m_format = format;
+    return create(size);
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::Format VertexBuffer::getFormat() const
+{
+    return m_format;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::setShadowed(bool shadowed)
+{
+    if (shadowed == m_shadowed)
+        return;
+
+    // Pending ranges must reach graphics memory before the shadow goes
+    flush();
+
+    m_shadowed = shadowed;
+    m_shadow.clear();
+    m_dirtyRanges.clear();
+    m_reallocate = false;
+
+    if (m_shadowed)
+        m_shadow.assign(getStride() * m_size, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::isShadowed() const
+{
+    return m_shadowed;
+}
+
+
+////////////////////////////////////////////////////////////
+Vertex* VertexBuffer::getVertices()
+{
+    if (!m_shadowed || (m_format != Standard) || m_shadow.empty())
+        return NULL;
+
+    return reinterpret_cast<Vertex*>(&m_shadow[0]);
+}
+
+
+////////////////////////////////////////////////////////////
+VertexPacked* VertexBuffer::getPackedVertices()
+{
+    if (!m_shadowed || (m_format != Packed) || m_shadow.empty())
+        return NULL;
+
+    return reinterpret_cast<VertexPacked*>(&m_shadow[0]);
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::markDirty(std::size_t first, std::size_t count)
+{
+    if (!m_shadowed || (first >= m_size) || !count)
+        return;
+
+    std::size_t begin = first;
+    std::size_t end   = first + std::min(count, m_size - first);
+
+    // The ranges are sorted and disjoint: find the first one that could touch the new range,
+    // then absorb all the following ones that do
+    typedef std::vector<std::pair<std::size_t, std::size_t> >::iterator Iterator;
+    Iterator it = std::lower_bound(m_dirtyRanges.begin(), m_dirtyRanges.end(), begin,
+                                   [](const std::pair<std::size_t, std::size_t>& range, std::size_t value)
+                                   {
+                                       return range.second + dirtyMergeGap < value;
+                                   });
+
+    Iterator last = it;
+    while ((last != m_dirtyRanges.end()) && (last->first <= end + dirtyMergeGap))
+    {
+        begin = std::min(begin, last->first);
+        end   = std::max(end, last->second);
+        ++last;
+    }
+
+    it = m_dirtyRanges.erase(it, last);
+    m_dirtyRanges.insert(it, std::make_pair(begin, end));
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::flush() const
+{
+    if (!m_shadowed || !m_vbo || (!m_reallocate && m_dirtyRanges.empty()))
+        return;
+
+    priv::getGLStateCache().bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+    std::size_t stride = getStride();
+    RenderStats& stats = priv::getRenderStats();
+
+    if (m_reallocate)
+    {
+        // The buffer grew: new storage, filled in the same call (the range of an arena is already allocated)
+        if (m_arena)
+            glCheck(glBufferSubData(GL_ARRAY_BUFFER, m_first * stride, m_shadow.size(), m_shadow.data()));
+        else
+            glCheck(glBufferData(GL_ARRAY_BUFFER, m_shadow.size(), m_shadow.data(), usageToGlEnum(m_usage)));
+        stats.bytesUploaded += m_shadow.size();
+    }
+    else
+    {
+        for (std::size_t i = 0; i < m_dirtyRanges.size(); ++i)
+        {
+            std::size_t begin = m_dirtyRanges[i].first;
+            std::size_t size  = (m_dirtyRanges[i].second - begin) * stride;
+
+            glCheck(glBufferSubData(GL_ARRAY_BUFFER, (m_first + begin) * stride, size, &m_shadow[begin * stride]));
+            stats.bytesUploaded += size;
+        }
+    }
+
+    m_dirtyRanges.clear();
+    m_reallocate = false;
+}
+
+
 ////////////////////////////////////////////////////////////
 void VertexBuffer::draw(RenderTarget& target, RenderStates states) const
 {
@@ -357,4 +687,239 @@ void VertexBuffer::draw(RenderTarget& target, RenderStates states) const
         target.draw(*this, 0, m_size, states);
 }
 
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::upload(const void* vertices, std::size_t vertexCount, unsigned int offset)
+{
+    // Sanity checks (empty buffers of an arena have no range yet)
+    if (!m_vbo && !m_arena)
+        return false;
+
+    if (!vertices)
+        return false;
+
+    if (offset && (offset + vertexCount > m_size))
+        return false;
+
+    std::size_t stride = getStride();
+
+    // Shadowed buffers only record the update, it is uploaded before the next draw
+    if (m_shadowed)
+    {
+        if (vertexCount > m_size)
+        {
+            if (m_arena)
+            {
+                if (!growInArena(vertexCount))
+                    return false;
+            }
+            else
+            {
+                priv::trackGpuMemory(GpuMemory::VertexBuffers, stride * m_size, stride * vertexCount);
+            }
+
+            m_size = vertexCount;
+            m_shadow.resize(stride * vertexCount);
+            m_reallocate = true;
+        }
+
+        if (vertexCount)
+        {
+            std::memcpy(&m_shadow[stride * offset], vertices, stride * vertexCount);
+            markDirty(offset, vertexCount);
+        }
+
+        return true;
+    }
+
+    // A growing range of an arena moves to another range, maybe of another buffer
+    if (m_arena && (vertexCount > m_size))
+    {
+        if (!growInArena(vertexCount))
+            return false;
+
+        m_size = vertexCount;
+    }
+
+    // Nothing to upload to an empty range
+    if (!m_vbo)
+        return true;
+
+    // The vertex array doesn't need to be bound to upload data, and
+    // redundant binds are skipped by the state shadow
+    priv::getGLStateCache().bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+    // Only growing needs new storage, which is filled in the same call
+    if (vertexCount > m_size)
+    {
+        glCheck(glBufferData(GL_ARRAY_BUFFER, stride * vertexCount, vertices, usageToGlEnum(m_usage)));
+
+        priv::trackGpuMemory(GpuMemory::VertexBuffers, stride * m_size, stride * vertexCount);
+        m_size = vertexCount;
+    }
+    else
+    {
+        glCheck(glBufferSubData(GL_ARRAY_BUFFER, stride * (m_first + offset), stride * vertexCount, vertices));
+    }
+
+    priv::getRenderStats().bytesUploaded += stride * vertexCount;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexBuffer::getStride() const
+{
+    return (m_format == Packed) ? sizeof(VertexPacked) : sizeof(Vertex);
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::releaseStorage()
+{
+    if (m_arena)
+    {
+        if (m_vbo)
+            m_arena->release(m_vbo, m_first, m_size);
+    }
+    else
+    {
+        priv::GLStateCache& cache = priv::getGLStateCache();
+
+        if (m_vbo)
+        {
+            cache.deleteBuffer(m_vbo);
+            priv::trackGpuMemory(GpuMemory::VertexBuffers, getStride() * m_size, 0);
+        }
+
+        if (m_vao)
+            cache.deleteVertexArray(m_vao);
+    }
+
+    m_vao   = 0;
+    m_vbo   = 0;
+    m_size  = 0;
+    m_first = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::retainVertices(std::vector<Uint8>& data) const
+{
+    if (m_shadowed || !m_vbo || !m_size)
+        return false;
+
+    std::size_t size = getStride() * m_size;
+    const Uint8* source = NULL;
+
+#if !defined(SFML_SYSTEM_EMSCRIPTEN)
+
+    if (priv::getGraphicsCaps().mapBufferRange)
+    {
+        priv::getGLStateCache().bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        glCheck(source = static_cast<const Uint8*>(glMapBufferRange(GL_ARRAY_BUFFER, getStride() * m_first, size, GL_MAP_READ_BIT)));
+    }
+
+#endif
+
+    if (!source)
+        return false;
+
+    data.assign(source, source + size);
+
+#if !defined(SFML_SYSTEM_EMSCRIPTEN)
+
+    glCheck(glUnmapBuffer(GL_ARRAY_BUFFER));
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::restoreStorage(const std::vector<Uint8>* data)
+{
+    // The names belong to the lost context: forget them, the new one may already reuse them
+    unsigned int previousVbo = m_vbo;
+    m_vao = 0;
+    m_vbo = 0;
+
+    if (!previousVbo)
+        return true;
+
+    std::size_t size = getStride() * m_size;
+    const void* vertices = m_shadowed ? static_cast<const void*>(m_shadow.data()) : NULL;
+    if (!m_shadowed && data && (data->size() == size))
+        vertices = data->data();
+
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
+    if (m_arena)
+    {
+        if (!m_arena->findRestoredBlock(previousVbo, m_vao, m_vbo))
+        {
+            err() << "Failed to restore vertex buffer, its arena block was not recreated" << std::endl;
+            return false;
+        }
+
+        if (vertices && size)
+        {
+            cache.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+            glCheck(glBufferSubData(GL_ARRAY_BUFFER, getStride() * m_first, size, vertices));
+        }
+    }
+    else
+    {
+        glCheck(SFML_GL_EXT_glGenVertexArrays(1, &m_vao));
+        glCheck(glGenBuffers(1, &m_vbo));
+
+        if (!m_vao || !m_vbo)
+        {
+            err() << "Failed to restore vertex buffer, generation failed" << std::endl;
+            return false;
+        }
+
+        cache.bindVertexArray(m_vao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        glCheck(glBufferData(GL_ARRAY_BUFFER, size, vertices, usageToGlEnum(m_usage)));
+        setupAttributes(m_format);
+        cache.bindVertexArray(0);
+    }
+
+    m_dirtyRanges.clear();
+    m_reallocate = false;
+
+    if (!vertices && size)
+    {
+        err() << "Failed to restore vertex buffer, its vertices were not kept" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::growInArena(std::size_t vertexCount)
+{
+    if (m_vbo)
+        m_arena->release(m_vbo, m_first, m_size);
+    m_vao   = 0;
+    m_vbo   = 0;
+    m_first = 0;
+
+    if (!m_arena->allocate(vertexCount, m_vao, m_vbo, m_first))
+    {
+        m_size = 0;
+        m_shadow.clear();
+        m_dirtyRanges.clear();
+        m_reallocate = false;
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace sf
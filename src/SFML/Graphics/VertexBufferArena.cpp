@@ -0,0 +1,306 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/VertexBufferArena.hpp>
+#include <SFML/Graphics/ContextRestore.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Allocations start at multiples of 4 vertices, so that quads
+    // can be drawn with the quad indices of the render pipeline
+    const std::size_t allocationAlignment = 4;
+
+    GLenum usageToGlEnum(sf::VertexBuffer::Usage usage)
+    {
+        switch (usage)
+        {
+            case sf::VertexBuffer::Static:  return GL_STATIC_DRAW;
+            case sf::VertexBuffer::Dynamic: return GL_DYNAMIC_DRAW;
+            default:                        return GL_STREAM_DRAW;
+        }
+    }
+
+    std::size_t getStride(sf::VertexBuffer::Format format)
+    {
+        return (format == sf::VertexBuffer::Packed) ? sizeof(sf::VertexPacked) : sizeof(sf::Vertex);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+VertexBufferArena::VertexBufferArena(VertexBuffer::Format format, std::size_t blockSize, VertexBuffer::Usage usage) :
+m_format   (format),
+m_usage    (usage),
+m_blockSize(std::max<std::size_t>(blockSize, allocationAlignment)),
+m_blocks   ()
+{
+    priv::registerRestorable(priv::RestorableVertexBufferArena, this);
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBufferArena::~VertexBufferArena()
+{
+    priv::unregisterRestorable(priv::RestorableVertexBufferArena, this);
+
+    for (std::size_t i = 0; i < m_blocks.size(); ++i)
+    {
+        if (m_blocks[i].used)
+            err() << "Vertex buffer arena destroyed while " << m_blocks[i].used << " of its vertices are still in use" << std::endl;
+
+        destroyBlock(m_blocks[i]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::Format VertexBufferArena::getFormat() const
+{
+    return m_format;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexBufferArena::getBlockSize() const
+{
+    return m_blockSize;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexBufferArena::getBlockCount() const
+{
+    return m_blocks.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexBufferArena::getUsedVertexCount() const
+{
+    std::size_t used = 0;
+    for (std::size_t i = 0; i < m_blocks.size(); ++i)
+        used += m_blocks[i].used;
+
+    return used;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBufferArena::allocate(std::size_t vertexCount, unsigned int& vao, unsigned int& vbo, std::size_t& first)
+{
+    std::size_t count = (vertexCount + allocationAlignment - 1) / allocationAlignment * allocationAlignment;
+
+    // First fit in the existing blocks
+    for (std::size_t i = 0; i < m_blocks.size(); ++i)
+    {
+        Block& block = m_blocks[i];
+        if (block.size - block.used < count)
+            continue;
+
+        for (std::size_t j = 0; j < block.freeRanges.size(); ++j)
+        {
+            std::pair<std::size_t, std::size_t>& range = block.freeRanges[j];
+            if (range.second - range.first < count)
+                continue;
+
+            first = range.first;
+            range.first += count;
+            if (range.first == range.second)
+                block.freeRanges.erase(block.freeRanges.begin() + j);
+
+            block.used += count;
+            vao = block.vao;
+            vbo = block.vbo;
+            return true;
+        }
+    }
+
+    // No room left: create a block, big enough for oversized ranges
+    Block block;
+    block.vao         = 0;
+    block.vbo         = 0;
+    block.previousVbo = 0;
+    block.size        = std::max(count, m_blockSize);
+    block.used        = count;
+
+    glCheck(SFML_GL_EXT_glGenVertexArrays(1, &block.vao));
+    glCheck(glGenBuffers(1, &block.vbo));
+
+    if (!block.vao || !block.vbo)
+    {
+        err() << "Could not create vertex buffer arena block, generation failed" << std::endl;
+        block.size = 0;
+        destroyBlock(block);
+        return false;
+    }
+
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
+    cache.bindVertexArray(block.vao);
+    cache.bindBuffer(GL_ARRAY_BUFFER, block.vbo);
+    glCheck(glBufferData(GL_ARRAY_BUFFER, getStride(m_format) * block.size, 0, usageToGlEnum(m_usage)));
+    VertexBuffer::setupAttributes(m_format);
+    cache.bindVertexArray(0);
+
+    priv::trackGpuMemory(GpuMemory::VertexBuffers, 0, getStride(m_format) * block.size);
+
+    if (count < block.size)
+        block.freeRanges.push_back(std::make_pair(count, block.size));
+
+    m_blocks.push_back(block);
+
+    first = 0;
+    vao   = block.vao;
+    vbo   = block.vbo;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBufferArena::release(unsigned int vbo, std::size_t first, std::size_t vertexCount)
+{
+    std::size_t count = (vertexCount + allocationAlignment - 1) / allocationAlignment * allocationAlignment;
+
+    for (std::size_t i = 0; i < m_blocks.size(); ++i)
+    {
+        Block& block = m_blocks[i];
+        if (block.vbo != vbo)
+            continue;
+
+        block.used -= count;
+        if (!block.used)
+        {
+            destroyBlock(block);
+            m_blocks.erase(m_blocks.begin() + i);
+            return;
+        }
+
+        // Insert the range, merged with its free neighbours
+        typedef std::vector<std::pair<std::size_t, std::size_t> >::iterator Iterator;
+        Iterator it = std::lower_bound(block.freeRanges.begin(), block.freeRanges.end(), std::make_pair(first, first));
+
+        std::size_t begin = first;
+        std::size_t end   = first + count;
+        if ((it != block.freeRanges.begin()) && ((it - 1)->second == begin))
+        {
+            --it;
+            begin = it->first;
+            it = block.freeRanges.erase(it);
+        }
+        if ((it != block.freeRanges.end()) && (it->first == end))
+        {
+            end = it->second;
+            it = block.freeRanges.erase(it);
+        }
+
+        block.freeRanges.insert(it, std::make_pair(begin, end));
+        return;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBufferArena::destroyBlock(Block& block)
+{
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
+    if (block.vbo)
+    {
+        cache.deleteBuffer(block.vbo);
+        priv::trackGpuMemory(GpuMemory::VertexBuffers, getStride(m_format) * block.size, 0);
+    }
+
+    if (block.vao)
+        cache.deleteVertexArray(block.vao);
+
+    block.vao = 0;
+    block.vbo = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBufferArena::restoreBlocks()
+{
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
+    bool restored = true;
+    for (std::size_t i = 0; i < m_blocks.size(); ++i)
+    {
+        Block& block = m_blocks[i];
+        block.previousVbo = block.vbo;
+        block.vao         = 0;
+        block.vbo         = 0;
+
+        glCheck(SFML_GL_EXT_glGenVertexArrays(1, &block.vao));
+        glCheck(glGenBuffers(1, &block.vbo));
+
+        if (!block.vao || !block.vbo)
+        {
+            err() << "Could not restore vertex buffer arena block, generation failed" << std::endl;
+            restored = false;
+            continue;
+        }
+
+        cache.bindVertexArray(block.vao);
+        cache.bindBuffer(GL_ARRAY_BUFFER, block.vbo);
+        glCheck(glBufferData(GL_ARRAY_BUFFER, getStride(m_format) * block.size, 0, usageToGlEnum(m_usage)));
+        VertexBuffer::setupAttributes(m_format);
+        cache.bindVertexArray(0);
+    }
+
+    return restored;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBufferArena::findRestoredBlock(unsigned int previousVbo, unsigned int& vao, unsigned int& vbo) const
+{
+    for (std::size_t i = 0; i < m_blocks.size(); ++i)
+    {
+        const Block& block = m_blocks[i];
+        if ((block.previousVbo == previousVbo) && block.vao && block.vbo)
+        {
+            vao = block.vao;
+            vbo = block.vbo;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace sf
@@ -26,9 +26,22 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/View.hpp>
+#include <atomic>
 #include <cmath>
 
 
+namespace
+{
+    // Start at 1, zero is "no view" in the caches of the render targets
+    std::atomic<sf::Uint64> nextGeneration(1);
+
+    sf::Uint64 getNewGeneration()
+    {
+        return nextGeneration.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -38,7 +51,8 @@ m_size               (),
 m_rotation           (0),
 m_viewport           (0, 0, 1, 1),
 m_transformUpdated   (false),
-m_invTransformUpdated(false)
+m_invTransformUpdated(false),
+m_generation         (getNewGeneration())
 {
     reset(FloatRect(0, 0, 1000, 1000));
 }
@@ -51,7 +65,8 @@ m_size               (),
 m_rotation           (0),
 m_viewport           (0, 0, 1, 1),
 m_transformUpdated   (false),
-m_invTransformUpdated(false)
+m_invTransformUpdated(false),
+m_generation         (getNewGeneration())
 {
     reset(rectangle);
 }
@@ -64,7 +79,8 @@ m_size               (size),
 m_rotation           (0),
 m_viewport           (0, 0, 1, 1),
 m_transformUpdated   (false),
-m_invTransformUpdated(false)
+m_invTransformUpdated(false),
+m_generation         (getNewGeneration())
 {
 
 }
@@ -77,6 +93,7 @@ void View::setCenter(float x, float y)
 
     m_transformUpdated    = false;
     m_invTransformUpdated = false;
+    m_generation          = getNewGeneration();
 }
 
 
@@ -95,6 +112,7 @@ void View::setSize(float width, float height)
 
     m_transformUpdated    = false;
     m_invTransformUpdated = false;
+    m_generation          = getNewGeneration();
 }
 
 
@@ -114,13 +132,15 @@ void View::setRotation(float angle)
 
     m_transformUpdated    = false;
     m_invTransformUpdated = false;
+    m_generation          = getNewGeneration();
 }
 
 
 ////////////////////////////////////////////////////////////
 void View::setViewport(const FloatRect& viewport)
 {
-    m_viewport = viewport;
+    m_viewport   = viewport;
+    m_generation = getNewGeneration();
 }
 
 
@@ -135,6 +155,7 @@ void View::reset(const FloatRect& rectangle)
 
     m_transformUpdated    = false;
     m_invTransformUpdated = false;
+    m_generation          = getNewGeneration();
 }
 
 
@@ -194,6 +215,24 @@ void View::zoom(float factor)
 }
 
 
+////////////////////////////////////////////////////////////
+View View::withParallax(const Vector2f& factor, const Vector2f& anchor) const
+{
+    View view(*this);
+    view.setCenter(anchor.x + (m_center.x - anchor.x) * factor.x,
+                   anchor.y + (m_center.y - anchor.y) * factor.y);
+
+    return view;
+}
+
+
+////////////////////////////////////////////////////////////
+View View::withParallax(float factor, const Vector2f& anchor) const
+{
+    return withParallax(Vector2f(factor, factor), anchor);
+}
+
+
 ////////////////////////////////////////////////////////////
 const Transform& View::getTransform() const
 {
@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/YuvSprite.hpp>
+#include <SFML/Graphics/YuvTexture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <cstdlib>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+YuvSprite::YuvSprite() :
+m_texture    (NULL),
+m_textureRect()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+YuvSprite::YuvSprite(const YuvTexture& texture) :
+m_texture    (NULL),
+m_textureRect()
+{
+    setTexture(texture);
+}
+
+
+////////////////////////////////////////////////////////////
+void YuvSprite::setTexture(const YuvTexture& texture, bool resetRect)
+{
+    // Recompute the texture area if requested, or if there was no valid texture & rect before
+    if (resetRect || (!m_texture && (m_textureRect == IntRect())))
+        setTextureRect(IntRect(0, 0, texture.getSize().x, texture.getSize().y));
+
+    m_texture = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void YuvSprite::setTextureRect(const IntRect& rectangle)
+{
+    if (rectangle != m_textureRect)
+    {
+        m_textureRect = rectangle;
+        updateVertices();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void YuvSprite::setColor(const Color& color)
+{
+    for (std::size_t i = 0; i < 4; ++i)
+        m_vertices[i].color = color;
+}
+
+
+////////////////////////////////////////////////////////////
+const YuvTexture* YuvSprite::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& YuvSprite::getTextureRect() const
+{
+    return m_textureRect;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& YuvSprite::getColor() const
+{
+    return m_vertices[0].color;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect YuvSprite::getLocalBounds() const
+{
+    float width = static_cast<float>(std::abs(m_textureRect.width));
+    float height = static_cast<float>(std::abs(m_textureRect.height));
+
+    return FloatRect(0.f, 0.f, width, height);
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect YuvSprite::getGlobalBounds() const
+{
+    return getTransformedBounds(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void YuvSprite::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_texture)
+    {
+        states.transform *= getTransform();
+        target.draw(m_vertices, 4, TriangleStrip, *m_texture, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool YuvSprite::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void YuvSprite::updateVertices()
+{
+    FloatRect bounds = getLocalBounds();
+
+    m_vertices[0].position = Vector2f(0, 0);
+    m_vertices[1].position = Vector2f(0, bounds.height);
+    m_vertices[2].position = Vector2f(bounds.width, 0);
+    m_vertices[3].position = Vector2f(bounds.width, bounds.height);
+
+    // Texture coordinates are in pixels of the luma plane
+    float left   = static_cast<float>(m_textureRect.left);
+    float right  = left + m_textureRect.width;
+    float top    = static_cast<float>(m_textureRect.top);
+    float bottom = top + m_textureRect.height;
+
+    m_vertices[0].texCoords = Vector2f(left, top);
+    m_vertices[1].texCoords = Vector2f(left, bottom);
+    m_vertices[2].texCoords = Vector2f(right, top);
+    m_vertices[3].texCoords = Vector2f(right, bottom);
+}
+
+} // namespace sf
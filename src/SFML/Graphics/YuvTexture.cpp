@@ -0,0 +1,358 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/YuvTexture.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GpuMemory.hpp>
+#include <SFML/Graphics/RenderPipeline.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    // Red and red-green textures come together (ARB_texture_rg, EXT_texture_rg),
+    // the luminance formats of OpenGL ES 2 replace them otherwise
+    bool areRedTexturesAvailable()
+    {
+        return sf::Texture::isFormatAvailable(sf::Texture::R8);
+    }
+
+    GLint getInternalFormat(unsigned int channels)
+    {
+        if (!areRedTexturesAvailable())
+            return (channels == 1) ? GL_LUMINANCE : GL_LUMINANCE_ALPHA;
+
+#if defined(SFML_OPENGL_ES)
+        // EXT_texture_rg only has the unsized formats
+        if (!GLAD_GL_ES_VERSION_3_0)
+            return (channels == 1) ? GL_RED : GL_RG;
+#endif
+
+        return (channels == 1) ? GL_R8 : GL_RG8;
+    }
+
+    GLenum getPixelFormat(unsigned int channels)
+    {
+        if (!areRedTexturesAvailable())
+            return (channels == 1) ? GL_LUMINANCE : GL_LUMINANCE_ALPHA;
+
+        return (channels == 1) ? GL_RED : GL_RG;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void getYuvConversion(const YuvTexture& texture, float matrix[9], float offset[3])
+{
+    // Weights of red and blue in the luma
+    float kr = 0.299f;
+    float kb = 0.114f;
+    if (texture.getColorSpace() == YuvTexture::Bt709)
+    {
+        kr = 0.2126f;
+        kb = 0.0722f;
+    }
+    float kg = 1.f - kr - kb;
+
+    // The limited range maps luma to 16-235 and chroma to 16-240
+    float lumaScale   = texture.isFullRange() ? 1.f : 255.f / 219.f;
+    float chromaScale = texture.isFullRange() ? 1.f : 255.f / 224.f;
+
+    offset[0] = texture.isFullRange() ? 0.f : 16.f / 255.f;
+    offset[1] = 128.f / 255.f;
+    offset[2] = 128.f / 255.f;
+
+    // Column of Y
+    matrix[0] = lumaScale;
+    matrix[1] = lumaScale;
+    matrix[2] = lumaScale;
+
+    // Column of U
+    matrix[3] = 0.f;
+    matrix[4] = -chromaScale * 2.f * kb * (1.f - kb) / kg;
+    matrix[5] = chromaScale * 2.f * (1.f - kb);
+
+    // Column of V
+    matrix[6] = chromaScale * 2.f * (1.f - kr);
+    matrix[7] = -chromaScale * 2.f * kr * (1.f - kr) / kg;
+    matrix[8] = 0.f;
+}
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+YuvTexture::YuvTexture() :
+m_size       (0, 0),
+m_layout     (I420),
+m_colorSpace (Bt601),
+m_fullRange  (false),
+m_isSmooth   (true),
+m_memoryUsage(0)
+{
+    m_planes[0] = 0;
+    m_planes[1] = 0;
+    m_planes[2] = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+YuvTexture::~YuvTexture()
+{
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        if (m_planes[i])
+            priv::getGLStateCache().deleteTexture(static_cast<GLuint>(m_planes[i]));
+    }
+
+    priv::trackGpuMemory(GpuMemory::Textures, m_memoryUsage, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool YuvTexture::create(unsigned int width, unsigned int height, Layout layout)
+{
+    if ((width == 0) || (height == 0))
+    {
+        err() << "Failed to create YUV texture, invalid size (" << width << "x" << height << ")" << std::endl;
+        return false;
+    }
+
+    unsigned int maxSize = Texture::getMaximumSize();
+    if ((width > maxSize) || (height > maxSize))
+    {
+        err() << "Failed to create YUV texture, its size is too high "
+              << "(" << width << "x" << height << ", "
+              << "maximum is " << maxSize << "x" << maxSize << ")"
+              << std::endl;
+        return false;
+    }
+
+    m_size   = Vector2u(width, height);
+    m_layout = layout;
+
+    priv::GLStateCache& cache = priv::getGLStateCache();
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    unsigned int planeCount = getPlaneCount();
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        if (i >= planeCount)
+        {
+            // NV12 has no third plane
+            if (m_planes[i])
+                cache.deleteTexture(static_cast<GLuint>(m_planes[i]));
+            m_planes[i] = 0;
+            continue;
+        }
+
+        if (!m_planes[i])
+        {
+            GLuint texture;
+            glCheck(glGenTextures(1, &texture));
+            m_planes[i] = static_cast<unsigned int>(texture);
+        }
+
+        unsigned int channels = ((layout == NV12) && (i == 1)) ? 2 : 1;
+        GLsizei planeWidth  = static_cast<GLsizei>((i == 0) ? width : (width + 1) / 2);
+        GLsizei planeHeight = static_cast<GLsizei>((i == 0) ? height : (height + 1) / 2);
+
+        cache.bindTexture(static_cast<GLuint>(m_planes[i]));
+        glCheck(glTexImage2D(GL_TEXTURE_2D, 0, getInternalFormat(channels), planeWidth, planeHeight, 0, getPixelFormat(channels), GL_UNSIGNED_BYTE, NULL));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+        applyFilter();
+    }
+
+    // Both layouts store 1.5 bytes per pixel
+    Uint64 chromaSize = static_cast<Uint64>((width + 1) / 2) * ((height + 1) / 2);
+    Uint64 memoryUsage = static_cast<Uint64>(width) * height + chromaSize * 2;
+
+    priv::trackGpuMemory(GpuMemory::Textures, m_memoryUsage, memoryUsage);
+    m_memoryUsage = memoryUsage;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool YuvTexture::update(const Uint8* y, const Uint8* u, const Uint8* v)
+{
+    if (!m_planes[0] || (m_layout != I420) || !y || !u || !v)
+    {
+        err() << "Failed to update YUV texture, it isn't an I420 texture or a plane is missing" << std::endl;
+        return false;
+    }
+
+    updatePlane(0, y, 1);
+    updatePlane(1, u, 1);
+    updatePlane(2, v, 1);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool YuvTexture::update(const Uint8* y, const Uint8* uv)
+{
+    if (!m_planes[0] || (m_layout != NV12) || !y || !uv)
+    {
+        err() << "Failed to update YUV texture, it isn't an NV12 texture or a plane is missing" << std::endl;
+        return false;
+    }
+
+    updatePlane(0, y, 1);
+    updatePlane(1, uv, 2);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u YuvTexture::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+YuvTexture::Layout YuvTexture::getLayout() const
+{
+    return m_layout;
+}
+
+
+////////////////////////////////////////////////////////////
+void YuvTexture::setColorSpace(ColorSpace colorSpace)
+{
+    m_colorSpace = colorSpace;
+}
+
+
+////////////////////////////////////////////////////////////
+YuvTexture::ColorSpace YuvTexture::getColorSpace() const
+{
+    return m_colorSpace;
+}
+
+
+////////////////////////////////////////////////////////////
+void YuvTexture::setFullRange(bool fullRange)
+{
+    m_fullRange = fullRange;
+}
+
+
+////////////////////////////////////////////////////////////
+bool YuvTexture::isFullRange() const
+{
+    return m_fullRange;
+}
+
+
+////////////////////////////////////////////////////////////
+void YuvTexture::setSmooth(bool smooth)
+{
+    if (smooth == m_isSmooth)
+        return;
+
+    m_isSmooth = smooth;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        if (m_planes[i])
+        {
+            priv::getGLStateCache().bindTexture(static_cast<GLuint>(m_planes[i]));
+            applyFilter();
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool YuvTexture::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int YuvTexture::getPlaneCount() const
+{
+    if (m_size.x == 0)
+        return 0;
+
+    return (m_layout == NV12) ? 2 : 3;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int YuvTexture::getNativeHandle(unsigned int plane) const
+{
+    return (plane < 3) ? m_planes[plane] : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void YuvTexture::updatePlane(unsigned int plane, const Uint8* pixels, unsigned int channels)
+{
+    GLsizei width  = static_cast<GLsizei>((plane == 0) ? m_size.x : (m_size.x + 1) / 2);
+    GLsizei height = static_cast<GLsizei>((plane == 0) ? m_size.y : (m_size.y + 1) / 2);
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // Rows of one or two bytes per sample are not aligned to 4 bytes
+    priv::getGLStateCache().bindTexture(static_cast<GLuint>(m_planes[plane]));
+    glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, getPixelFormat(channels), GL_UNSIGNED_BYTE, pixels));
+    glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+
+    priv::getRenderStats().bytesUploaded += static_cast<Uint64>(width) * height * channels;
+}
+
+
+////////////////////////////////////////////////////////////
+void YuvTexture::applyFilter()
+{
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+}
+
+} // namespace sf
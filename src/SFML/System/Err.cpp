@@ -26,12 +26,204 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <set>
 #include <streambuf>
+#include <string>
+#include <thread>
 #include <cstdio>
 
+#if !defined(SFML_SYSTEM_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    #define SFML_ASYNC_ERR
+#endif
+
 
 namespace
 {
+// Dispatches the messages of the default streambuf: rate
+// limiting, deduplication, then stderr or the callback,
+// immediately or from a background thread
+class ErrLogger
+{
+public:
+
+    ErrLogger() :
+    callback        (NULL),
+    userData        (NULL),
+    maxPerSecond    (0),
+    deduplicate     (false),
+    windowCount     (0),
+    droppedCount    (0),
+    async           (false),
+    stop            (false)
+    {
+    }
+
+    ~ErrLogger()
+    {
+        setAsync(false);
+    }
+
+    void setCallback(sf::ErrCallback newCallback, void* newUserData)
+    {
+        sf::Lock lock(mutex);
+        callback = newCallback;
+        userData = newUserData;
+    }
+
+    void setRateLimit(unsigned int newMaxPerSecond, bool newDeduplicate)
+    {
+        sf::Lock lock(mutex);
+        maxPerSecond = newMaxPerSecond;
+        deduplicate = newDeduplicate;
+        seen.clear();
+    }
+
+    void setAsync(bool enable)
+    {
+#if defined(SFML_ASYNC_ERR)
+
+        if (enable && !thread.joinable())
+        {
+            sf::Lock lock(mutex);
+            async = true;
+            stop = false;
+            thread = std::thread(&ErrLogger::run, this);
+        }
+        else if (!enable && thread.joinable())
+        {
+            // The thread drains the queue before exiting
+            {
+                sf::Lock lock(mutex);
+                stop = true;
+            }
+            condition.notify_all();
+            thread.join();
+            async = false;
+        }
+
+#else
+
+        // Without threads, the messages are always written immediately
+        static_cast<void>(enable);
+
+#endif
+    }
+
+    void dispatch(std::string& message)
+    {
+        sf::Lock lock(mutex);
+
+        // Report the dropped messages once per second
+        if (window.getElapsedTime() >= sf::seconds(1))
+        {
+            if (droppedCount > 0)
+            {
+                char report[96];
+                std::snprintf(report, sizeof(report), "(%lu repeated or excess error messages dropped)\n", static_cast<unsigned long>(droppedCount));
+                output(report);
+            }
+
+            window.restart();
+            windowCount = 0;
+            droppedCount = 0;
+            seen.clear();
+        }
+
+        if (deduplicate && !seen.insert(std::hash<std::string>()(message)).second)
+        {
+            ++droppedCount;
+            return;
+        }
+
+        if ((maxPerSecond > 0) && (windowCount >= maxPerSecond))
+        {
+            ++droppedCount;
+            return;
+        }
+
+        ++windowCount;
+        output(message);
+    }
+
+private:
+
+    // The mutex must be locked
+    void output(std::string message)
+    {
+        if (async)
+        {
+            queue.push_back(std::string());
+            queue.back().swap(message);
+            condition.notify_all();
+        }
+        else
+        {
+            write(message, callback, userData);
+        }
+    }
+
+    static void write(const std::string& message, sf::ErrCallback messageCallback, void* messageUserData)
+    {
+        if (messageCallback)
+            messageCallback(message.c_str(), message.size(), messageUserData);
+        else
+            std::fwrite(message.data(), 1, message.size(), stderr);
+    }
+
+    void run()
+    {
+        sf::Lock lock(mutex);
+
+        for (;;)
+        {
+            while (!stop && queue.empty())
+                condition.wait(mutex);
+
+            if (queue.empty())
+                return;
+
+            // Write the message without blocking the threads that report new ones
+            std::string message;
+            message.swap(queue.front());
+            queue.pop_front();
+
+            sf::ErrCallback messageCallback = callback;
+            void* messageUserData = userData;
+
+            mutex.unlock();
+            write(message, messageCallback, messageUserData);
+            mutex.lock();
+        }
+    }
+
+    sf::Mutex                   mutex;
+    std::condition_variable_any condition;
+    sf::ErrCallback             callback;
+    void*                       userData;
+    unsigned int                maxPerSecond;
+    bool                        deduplicate;
+    sf::Clock                   window;
+    unsigned int                windowCount;
+    std::size_t                 droppedCount;
+    std::set<std::size_t>       seen;
+    std::deque<std::string>     queue;
+    std::thread                 thread;
+    bool                        async;
+    bool                        stop;
+};
+
+ErrLogger& getLogger()
+{
+    static ErrLogger logger;
+    return logger;
+}
+
 // This class will be used as the default streambuf of sf::Err,
 // it outputs to stderr by default (to keep the default behavior)
 class DefaultErrStreamBuf : public std::streambuf
@@ -40,8 +232,11 @@ public:
 
     DefaultErrStreamBuf()
     {
-        // Allocate the write buffer
-        static const int size = 64;
+        // Create the logger first, so that it outlives the buffer
+        getLogger();
+
+        // Allocate the write buffer, a message is sent to the logger when it is full
+        static const int size = 1024;
         char* buffer = new char[size];
         setp(buffer, buffer + size);
     }
@@ -82,9 +277,9 @@ private:
         // Check if there is something into the write buffer
         if (pbase() != pptr())
         {
-            // Print the contents of the write buffer into the standard error output
-            std::size_t size = static_cast<int>(pptr() - pbase());
-            fwrite(pbase(), 1, size, stderr);
+            // Send the contents of the write buffer to the logger, as one message
+            std::string message(pbase(), pptr());
+            getLogger().dispatch(message);
 
             // Reset the pointer position to the beginning of the write buffer
             setp(pbase(), epptr());
@@ -107,4 +302,25 @@ std::ostream& err()
 }
 
 
+////////////////////////////////////////////////////////////
+void setErrCallback(ErrCallback callback, void* userData)
+{
+    getLogger().setCallback(callback, userData);
+}
+
+
+////////////////////////////////////////////////////////////
+void setErrRateLimit(unsigned int maxMessagesPerSecond, bool deduplicate)
+{
+    getLogger().setRateLimit(maxMessagesPerSecond, deduplicate);
+}
+
+
+////////////////////////////////////////////////////////////
+void setErrAsync(bool async)
+{
+    getLogger().setAsync(async);
+}
+
+
 } // namespace sf
@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/JobSystem.hpp>
+#include <algorithm>
+#include <deque>
+
+
+namespace
+{
+    // Scheduler installed by the application, if any
+    std::atomic<sf::JobScheduler*> customScheduler(NULL);
+
+    // Pool and queue of the calling thread, if it is a worker
+    thread_local const sf::JobSystem* currentSystem = NULL;
+    thread_local std::size_t          currentQueue  = 0;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct JobSystem::Job
+{
+    const RangeFunction*      work;      ///< Function processing the range
+    std::size_t               begin;     ///< First index of the range
+    std::size_t               end;       ///< Index past the last one of the range
+    std::size_t               grain;     ///< Minimum number of indices of a range
+    std::atomic<std::size_t>* remaining; ///< Number of indices of the loop not processed yet
+};
+
+
+////////////////////////////////////////////////////////////
+struct JobSystem::Queue
+{
+    std::mutex      mutex; ///< Protects the jobs
+    std::deque<Job> jobs;  ///< Jobs, the most recent (and smallest) at the back
+};
+
+
+////////////////////////////////////////////////////////////
+JobSystem::JobSystem(unsigned int concurrency) :
+m_queues   (),
+m_threads  (),
+m_mutex    (),
+m_condition(),
+m_jobCount (0),
+m_stop     (false)
+{
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+
+    // No threads without pthreads support, the jobs run serially
+    concurrency = 1;
+
+#else
+
+    if (concurrency == 0)
+        concurrency = std::max(std::thread::hardware_concurrency(), 1u);
+
+#endif
+
+    // One queue per worker, and the last one for the threads outside of the pool
+    for (unsigned int i = 0; i < concurrency; ++i)
+        m_queues.push_back(new Queue);
+
+    // If no more threads can be created, the pool just has fewer workers
+    for (unsigned int i = 0; i + 1 < concurrency; ++i)
+    {
+        try
+        {
+            m_threads.push_back(std::thread(&JobSystem::runWorker, this, static_cast<std::size_t>(i)));
+        }
+        catch (...)
+        {
+            break;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+
+    for (std::size_t i = 0; i < m_threads.size(); ++i)
+        m_threads[i].join();
+
+    for (std::size_t i = 0; i < m_queues.size(); ++i)
+        delete m_queues[i];
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int JobSystem::getConcurrency() const
+{
+    return static_cast<unsigned int>(m_threads.size()) + 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void JobSystem::parallelFor(std::size_t count, std::size_t grain, const RangeFunction& work)
+{
+    if (count == 0)
+        return;
+
+    grain = std::max<std::size_t>(grain, 1);
+
+    // Nothing to share: run the loop right away
+    if (m_threads.empty() || (count < 2 * grain))
+    {
+        work(0, count);
+        return;
+    }
+
+    std::atomic<std::size_t> remaining(count);
+    Job job = {&work, 0, count, grain, &remaining};
+
+    std::size_t index = (currentSystem == this) ? currentQueue : m_queues.size() - 1;
+    runJob(index, job);
+
+    // Help with the jobs of the pool until the other threads have processed their ranges
+    while (remaining.load(std::memory_order_acquire) > 0)
+    {
+        Job other;
+        if (takeJob(index, other))
+            runJob(index, other);
+        else
+            std::this_thread::yield();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void JobSystem::setScheduler(JobScheduler* scheduler)
+{
+    customScheduler.store(scheduler);
+}
+
+
+////////////////////////////////////////////////////////////
+JobScheduler& JobSystem::getScheduler()
+{
+    JobScheduler* scheduler = customScheduler.load();
+    if (scheduler)
+        return *scheduler;
+
+    static JobSystem defaultSystem;
+    return defaultSystem;
+}
+
+
+////////////////////////////////////////////////////////////
+void JobSystem::runWorker(std::size_t index)
+{
+    currentSystem = this;
+    currentQueue  = index;
+
+    for (;;)
+    {
+        Job job;
+        if (takeJob(index, job))
+        {
+            runJob(index, job);
+            continue;
+        }
+
+        // Sleep until a job is pushed
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]() {return m_stop || (m_jobCount.load() > 0);});
+        if (m_stop)
+            return;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool JobSystem::takeJob(std::size_t index, Job& job)
+{
+    if (m_jobCount.load() == 0)
+        return false;
+
+    // The most recent job of the own queue first, it is the smallest and its data is still in the cache
+    {
+        Queue& queue = *m_queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            job = queue.jobs.back();
+            queue.jobs.pop_back();
+            --m_jobCount;
+            return true;
+        }
+    }
+
+    // Then the oldest (and largest) job of another queue
+    for (std::size_t i = 1; i < m_queues.size(); ++i)
+    {
+        Queue& queue = *m_queues[(index + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            job = queue.jobs.front();
+            queue.jobs.pop_front();
+            --m_jobCount;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void JobSystem::runJob(std::size_t index, Job job)
+{
+    // Keep the first half of the range and leave the second one to the idle threads,
+    // until the range can't be split into two ranges of the minimum size
+    while (job.end - job.begin >= 2 * job.grain)
+    {
+        Job second = job;
+        second.begin = job.begin + (job.end - job.begin) / 2;
+        job.end = second.begin;
+
+        {
+            Queue& queue = *m_queues[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back(second);
+            ++m_jobCount;
+        }
+
+        // Taking the lock makes sure that a worker about to sleep sees the new job
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+        }
+        m_condition.notify_one();
+    }
+
+    (*job.work)(job.begin, job.end);
+    job.remaining->fetch_sub(job.end - job.begin, std::memory_order_release);
+}
+
+} // namespace sf
@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/MappedFileInputStream.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID) || defined(SFML_SYSTEM_MACOS) || \
+    defined(SFML_SYSTEM_IOS) || defined(SFML_SYSTEM_FREEBSD) || defined(SFML_SYSTEM_OPENBSD)
+    #define SFML_MAPPED_FILES
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+MappedFileInputStream::MappedFileInputStream() :
+m_data    (NULL),
+m_size    (0),
+m_offset  (0),
+m_isOpen  (false),
+m_isMapped(false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+MappedFileInputStream::~MappedFileInputStream()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFileInputStream::open(const std::string& filename)
+{
+    close();
+
+#if defined(SFML_MAPPED_FILES)
+
+    int file = ::open(filename.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat status;
+    if (fstat(file, &status) != 0)
+    {
+        ::close(file);
+        return false;
+    }
+
+    // Empty files can't be mapped, but they are valid streams
+    if (status.st_size > 0)
+    {
+        void* data = mmap(NULL, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        if (data == MAP_FAILED)
+        {
+            ::close(file);
+            return false;
+        }
+
+        m_data = static_cast<const char*>(data);
+        m_isMapped = true;
+    }
+
+    // The mapping stays valid after the file is closed
+    ::close(file);
+    m_size = status.st_size;
+
+#else
+
+    // No mapping on this system: read the whole file up front
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file)
+        return false;
+
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+
+    if (size < 0)
+    {
+        std::fclose(file);
+        return false;
+    }
+
+    m_buffer.resize(static_cast<std::size_t>(size));
+    if ((size > 0) && (std::fread(&m_buffer[0], 1, m_buffer.size(), file) != m_buffer.size()))
+    {
+        std::fclose(file);
+        std::vector<char>().swap(m_buffer);
+        return false;
+    }
+
+    std::fclose(file);
+    m_data = m_buffer.empty() ? NULL : &m_buffer[0];
+    m_size = size;
+
+#endif
+
+    m_offset = 0;
+    m_isOpen = true;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* MappedFileInputStream::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::read(void* data, Int64 size)
+{
+    if (!m_isOpen)
+        return -1;
+
+    Int64 count = std::min(size, m_size - m_offset);
+    if (count > 0)
+    {
+        std::memcpy(data, m_data + m_offset, static_cast<std::size_t>(count));
+        m_offset += count;
+        return count;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::seek(Int64 position)
+{
+    if (!m_isOpen)
+        return -1;
+
+    m_offset = position < m_size ? position : m_size;
+    return m_offset;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::tell()
+{
+    if (!m_isOpen)
+        return -1;
+
+    return m_offset;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::getSize()
+{
+    if (!m_isOpen)
+        return -1;
+
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* MappedFileInputStream::getContiguousData(std::size_t& size)
+{
+    if (!m_isOpen)
+    {
+        size = 0;
+        return NULL;
+    }
+
+    size = static_cast<std::size_t>(m_size);
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+void MappedFileInputStream::close()
+{
+#if defined(SFML_MAPPED_FILES)
+    if (m_isMapped)
+        munmap(const_cast<char*>(m_data), static_cast<std::size_t>(m_size));
+#endif
+
+    std::vector<char>().swap(m_buffer);
+    m_data     = NULL;
+    m_size     = 0;
+    m_offset   = 0;
+    m_isOpen   = false;
+    m_isMapped = false;
+}
+
+} // namespace sf
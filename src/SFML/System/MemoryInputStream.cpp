@@ -98,4 +98,18 @@ Int64 MemoryInputStream::getSize()
     return m_size;
 }
 
+
+////////////////////////////////////////////////////////////
+const void* MemoryInputStream::getContiguousData(std::size_t& size)
+{
+    if (!m_data)
+    {
+        size = 0;
+        return NULL;
+    }
+
+    size = static_cast<std::size_t>(m_size);
+    return m_data;
+}
+
 } // namespace sf
@@ -27,10 +27,23 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/System/String.hpp>
 #include <SFML/System/Utf.hpp>
+#include <algorithm>
 #include <iterator>
+#include <utility>
 #include <cstring>
 
 
+namespace
+{
+    // Narrow a character that is known to fit in the output type
+    template <typename T>
+    T narrow(sf::Uint32 character)
+    {
+        return static_cast<T>(character);
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -132,6 +145,14 @@ m_string(copy.m_string)
 }
 
 
+////////////////////////////////////////////////////////////
+String::String(String&& other) noexcept :
+m_string(std::move(other.m_string))
+{
+    other.m_string.clear();
+}
+
+
 ////////////////////////////////////////////////////////////
 String::operator std::string() const
 {
@@ -177,12 +198,23 @@ std::wstring String::toWideString() const
 ////////////////////////////////////////////////////////////
 std::basic_string<Uint8> String::toUtf8() const
 {
-    // Prepare the output string
-    std::basic_string<Uint8> output;
-    output.reserve(m_string.length());
+    // Compute the size of the output string
+    std::size_t size = 0;
+    for (std::basic_string<Uint32>::const_iterator it = m_string.begin(); it != m_string.end(); ++it)
+        size += (*it < 0x80) ? 1 : (*it < 0x800) ? 2 : (*it < 0x10000) ? 3 : 4;
 
-    // Convert
-    Utf32::toUtf8(m_string.begin(), m_string.end(), std::back_inserter(output));
+    std::basic_string<Uint8> output(size, 0);
+    if (size == m_string.length())
+    {
+        // Pure ASCII: the characters are narrowed as is
+        std::transform(m_string.begin(), m_string.end(), output.begin(), narrow<Uint8>);
+    }
+    else
+    {
+        // Convert; invalid characters are dropped, so the output may end up shorter
+        Uint8* end = Utf32::toUtf8(m_string.begin(), m_string.end(), &output[0]);
+        output.resize(static_cast<std::size_t>(end - &output[0]));
+    }
 
     return output;
 }
@@ -191,12 +223,18 @@ std::basic_string<Uint8> String::toUtf8() const
 ////////////////////////////////////////////////////////////
 std::basic_string<Uint16> String::toUtf16() const
 {
-    // Prepare the output string
-    std::basic_string<Uint16> output;
-    output.reserve(m_string.length());
+    // Compute the size of the output string
+    std::size_t size = 0;
+    for (std::basic_string<Uint32>::const_iterator it = m_string.begin(); it != m_string.end(); ++it)
+        size += (*it < 0x10000) ? 1 : 2;
 
-    // Convert
-    Utf32::toUtf16(m_string.begin(), m_string.end(), std::back_inserter(output));
+    std::basic_string<Uint16> output(size, 0);
+    if (size == 0)
+        return output;
+
+    // Convert; invalid characters are dropped, so the output may end up shorter
+    Uint16* end = Utf32::toUtf16(m_string.begin(), m_string.end(), &output[0]);
+    output.resize(static_cast<std::size_t>(end - &output[0]));
 
     return output;
 }
@@ -217,6 +255,19 @@ String& String::operator =(const String& right)
 }
 
 
+////////////////////////////////////////////////////////////
+String& String::operator =(String&& right) noexcept
+{
+    if (&right != this)
+    {
+        m_string = std::move(right.m_string);
+        right.m_string.clear();
+    }
+
+    return *this;
+}
+
+
 ////////////////////////////////////////////////////////////
 String& String::operator +=(const String& right)
 {
@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Trace.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <vector>
+
+
+namespace
+{
+    // Number of events kept per thread
+    const std::size_t EventCapacity = 16384;
+
+    struct Event
+    {
+        const char* name;
+        sf::Int64   start;
+        sf::Int64   duration;
+    };
+
+    // Ring buffer written by a single thread
+    struct ThreadBuffer
+    {
+        Event                    events[EventCapacity];
+        std::atomic<std::size_t> head;
+        unsigned int             threadId;
+    };
+
+    // Buffers of all the threads that recorded events, only locked when a thread records its first event
+    sf::Mutex                  registryMutex;
+    std::vector<ThreadBuffer*> registry;
+
+    // Reference point of the trace clock
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+
+    ThreadBuffer& getThreadBuffer()
+    {
+        // Buffers are never freed, so that the events of finished threads can still be written
+        static thread_local ThreadBuffer* buffer = nullptr;
+
+        if (!buffer)
+        {
+            buffer = new ThreadBuffer;
+            buffer->head.store(0, std::memory_order_relaxed);
+
+            sf::Lock lock(registryMutex);
+            buffer->threadId = static_cast<unsigned int>(registry.size() + 1);
+            registry.push_back(buffer);
+        }
+
+        return *buffer;
+    }
+
+
+    // Write a string as a JSON literal
+    void writeJsonString(std::ostream& stream, const char* string)
+    {
+        stream << '"';
+
+        for (; *string; ++string)
+        {
+            if ((*string == '"') || (*string == '\\'))
+                stream << '\\';
+
+            stream << *string;
+        }
+
+        stream << '"';
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TraceScope::TraceScope(const char* name) :
+m_name (name),
+m_start(Trace::now())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TraceScope::~TraceScope()
+{
+    Trace::record(m_name, m_start, Trace::now() - m_start);
+}
+
+
+////////////////////////////////////////////////////////////
+void Trace::record(const char* name, Int64 start, Int64 duration)
+{
+    ThreadBuffer& buffer = getThreadBuffer();
+
+    std::size_t head = buffer.head.load(std::memory_order_relaxed);
+
+    Event& event = buffer.events[head % EventCapacity];
+    event.name     = name;
+    event.start    = start;
+    event.duration = duration;
+
+    // Publish the event to the reader
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 Trace::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Trace::writeChromeTrace(const std::string& filename)
+{
+    std::ofstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to write trace to \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    std::vector<ThreadBuffer*> buffers;
+    {
+        Lock lock(registryMutex);
+        buffers = registry;
+    }
+
+    file << "{\"traceEvents\":[";
+
+    bool first = true;
+
+    for (std::size_t i = 0; i < buffers.size(); ++i)
+    {
+        const ThreadBuffer& buffer = *buffers[i];
+
+        std::size_t head = buffer.head.load(std::memory_order_acquire);
+        std::size_t count = (head < EventCapacity) ? head : EventCapacity;
+
+        for (std::size_t j = head - count; j < head; ++j)
+        {
+            const Event& event = buffer.events[j % EventCapacity];
+
+            file << (first ? "\n" : ",\n") << "{\"name\":";
+            writeJsonString(file, event.name);
+            file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.threadId
+                 << ",\"ts\":" << event.start << ",\"dur\":" << event.duration << "}";
+
+            first = false;
+        }
+    }
+
+    file << "\n]}\n";
+
+    return file.good();
+}
+
+
+////////////////////////////////////////////////////////////
+void Trace::clear()
+{
+    Lock lock(registryMutex);
+
+    for (std::size_t i = 0; i < registry.size(); ++i)
+        registry[i]->head.store(0, std::memory_order_release);
+}
+
+} // namespace sf
@@ -25,7 +25,7 @@
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-inline Vector3<T>::Vector3() :
+constexpr Vector3<T>::Vector3() :
 x(0),
 y(0),
 z(0)
@@ -36,7 +36,7 @@ z(0)
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-inline Vector3<T>::Vector3(T X, T Y, T Z) :
+constexpr Vector3<T>::Vector3(T X, T Y, T Z) :
 x(X),
 y(Y),
 z(Z)
@@ -48,7 +48,7 @@ z(Z)
 ////////////////////////////////////////////////////////////
 template <typename T>
 template <typename U>
-inline Vector3<T>::Vector3(const Vector3<U>& vector) :
+constexpr Vector3<T>::Vector3(const Vector3<U>& vector) :
 x(static_cast<T>(vector.x)),
 y(static_cast<T>(vector.y)),
 z(static_cast<T>(vector.z))
@@ -58,7 +58,7 @@ z(static_cast<T>(vector.z))
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-inline Vector3<T> operator -(const Vector3<T>& left)
+constexpr Vector3<T> operator -(const Vector3<T>& left)
 {
     return Vector3<T>(-left.x, -left.y, -left.z);
 }
@@ -90,7 +90,7 @@ inline Vector3<T>& operator -=(Vector3<T>& left, const Vector3<T>& right)
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-inline Vector3<T> operator +(const Vector3<T>& left, const Vector3<T>& right)
+constexpr Vector3<T> operator +(const Vector3<T>& left, const Vector3<T>& right)
 {
     return Vector3<T>(left.x + right.x, left.y + right.y, left.z + right.z);
 }
@@ -98,7 +98,7 @@ inline Vector3<T> operator +(const Vector3<T>& left, const Vector3<T>& right)
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-inline Vector3<T> operator -(const Vector3<T>& left, const Vector3<T>& right)
+constexpr Vector3<T> operator -(const Vector3<T>& left, const Vector3<T>& right)
 {
     return Vector3<T>(left.x - right.x, left.y - right.y, left.z - right.z);
 }
@@ -106,7 +106,7 @@ inline Vector3<T> operator -(const Vector3<T>& left, const Vector3<T>& right)
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-inline Vector3<T> operator *(const Vector3<T>& left, T right)
+constexpr Vector3<T> operator *(const Vector3<T>& left, T right)
 {
     return Vector3<T>(left.x * right, left.y * right, left.z * right);
 }
@@ -114,7 +114,7 @@ inline Vector3<T> operator *(const Vector3<T>& left, T right)
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-inline Vector3<T> operator *(T left, const Vector3<T>& right)
+constexpr Vector3<T> operator *(T left, const Vector3<T>& right)
 {
     return Vector3<T>(right.x * left, right.y * left, right.z * left);
 }
@@ -134,7 +134,7 @@ inline Vector3<T>& operator *=(Vector3<T>& left, T right)
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-inline Vector3<T> operator /(const Vector3<T>& left, T right)
+constexpr Vector3<T> operator /(const Vector3<T>& left, T right)
 {
     return Vector3<T>(left.x / right, left.y / right, left.z / right);
 }
@@ -154,7 +154,7 @@ inline Vector3<T>& operator /=(Vector3<T>& left, T right)
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-inline bool operator ==(const Vector3<T>& left, const Vector3<T>& right)
+constexpr bool operator ==(const Vector3<T>& left, const Vector3<T>& right)
 {
     return (left.x == right.x) && (left.y == right.y) && (left.z == right.z);
 }
@@ -162,7 +162,7 @@ inline bool operator ==(const Vector3<T>& left, const Vector3<T>& right)
 
 ////////////////////////////////////////////////////////////
 template <typename T>
-inline bool operator !=(const Vector3<T>& left, const Vector3<T>& right)
+constexpr bool operator !=(const Vector3<T>& left, const Vector3<T>& right)
 {
     return (left.x != right.x) || (left.y != right.y) || (left.z != right.z);
 }